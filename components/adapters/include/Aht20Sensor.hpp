@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "SensorTypes.hpp"
+
+namespace common {
+class IClock;
+}  // namespace common
+
+namespace adapters {
+
+class II2cBus;
+
+// AHT20 temperature/humidity sensor driven as a state machine. Every call to poll() issues
+// at most one short I2C transaction and returns how long the caller may sleep, so the bus
+// is free for OLED flushes during the ~80 ms conversion.
+class Aht20Sensor {
+   public:
+    static constexpr uint8_t I2C_ADDR = 0x38;
+    static constexpr uint32_t DEFAULT_PERIOD_MS = 10000U;  // FR-06
+
+    enum class State : uint8_t { PowerUp, Calibrating, Idle, Converting };
+
+    Aht20Sensor(II2cBus &i2cBus, const common::IClock &clock,
+                const uint32_t &periodMs = DEFAULT_PERIOD_MS);
+
+    // Runs the step that is due, if any, and returns the milliseconds until the next one
+    uint32_t poll();
+
+    // Returns true once for each new CRC-checked reading
+    bool takeReading(common::ClimateReading &reading);
+
+    State getState() const;
+
+   private:
+    void stepPowerUp();
+    void stepCalibrating();
+    void stepIdle();
+    void stepConverting();
+
+    void scheduleInMs(const uint32_t &delayMs);
+    void retryLater();
+
+    static uint8_t crc8(const uint8_t *data, const size_t &len);
+
+    II2cBus &mI2cBus;
+    const common::IClock &mClock;
+    uint32_t mPeriodMs;
+
+    State mState;
+    uint64_t mDeadlineUs;
+    uint8_t mBusyPolls;
+
+    common::ClimateReading mReading;
+    bool mHasNewReading;
+};
+
+}  // namespace adapters
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "IClock.hpp"
+
+namespace adapters {
+class EspClock final : public common::IClock {
+   public:
+    uint64_t nowUs() const override;
+};
+
+}  // namespace adapters
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+
+#include "IConsole.hpp"
+
+// IDF
+#include <esp_console.h>
+
+namespace adapters {
+// Serial console REPL (UART or USB Serial/JTAG, whatever the console is routed to)
+class EspConsole final : public IConsole {
+   public:
+    EspConsole();
+    ~EspConsole() override;
+
+    bool init() override;
+    bool registerCommand(const char *name, const char *help, CommandHandler handler) override;
+
+   private:
+    static constexpr size_t MAX_COMMANDS = 8U;
+
+    struct Command {
+        const char *name;
+        CommandHandler handler;
+    };
+
+    // esp_console callbacks carry no context, commands are looked up by argv[0]
+    static int dispatch(int argc, char **argv);
+
+    static EspConsole *sInstance;
+
+    esp_console_repl_t *mRepl;
+    std::array<Command, MAX_COMMANDS> mCommands;
+    size_t mCommandCount;
+};
+
+}  // namespace adapters
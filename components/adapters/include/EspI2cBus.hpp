@@ -2,7 +2,7 @@
 
 #include <driver/i2c_master.h>
 
-#include <map>
+#include <array>
 
 #include "II2cBus.hpp"
 
@@ -10,6 +10,8 @@ namespace adapters {
 
 class EspI2cBus final : public II2cBus {
    public:
+    static constexpr size_t ADDRESS_COUNT = 128U;  // 7-bit addressing
+
     explicit EspI2cBus(const int& port);
     ~EspI2cBus() override;
 
@@ -26,7 +28,8 @@ class EspI2cBus final : public II2cBus {
     i2c_master_bus_handle_t mBusHandle;
     bool mInitialized;
     uint32_t mFreqHz;
-    std::map<uint8_t, i2c_master_dev_handle_t> mDeviceHandles;
+    // Indexed by address: the lookup runs on every transaction
+    std::array<i2c_master_dev_handle_t, ADDRESS_COUNT> mDeviceHandles;
 };
 
 }  // namespace adapters
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include "InputTypes.hpp"
+#include "SpscQueue.hpp"
+
+// IDF
+#include <esp_attr.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace adapters {
+// Buttons and encoder on GPIO interrupts. The ISR only timestamps the edge, pushes it to a
+// lock-free queue and wakes the consumer task; all decoding happens on that task.
+class GpioInputDriver {
+   public:
+    static constexpr size_t EDGE_QUEUE_SIZE = 64U;
+
+    GpioInputDriver();
+    ~GpioInputDriver();
+
+    bool init(TaskHandle_t consumerTask);
+    bool popEdge(common::RawEdge &edge);
+    uint32_t getDroppedEdges() const;
+
+   private:
+    struct PinContext {
+        GpioInputDriver *driver;
+        common::InputPin pin;
+        int gpio;
+    };
+
+    static void IRAM_ATTR isrHandler(void *arg);
+
+    common::SpscQueue<common::RawEdge, EDGE_QUEUE_SIZE> mEdges;
+    std::array<PinContext, static_cast<size_t>(common::InputPin::COUNT)> mPins;
+    TaskHandle_t mConsumerTask;
+    std::atomic<uint32_t> mDroppedEdges;
+    bool mInitialized;
+};
+
+}  // namespace adapters
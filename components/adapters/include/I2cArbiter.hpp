@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace adapters {
+
+enum class I2cPriority : uint8_t {
+    High = 0,    // display updates triggered by user input
+    Normal = 1,  // background display updates
+    Low = 2,     // sensors
+    COUNT
+};
+
+// Grant policy of the I2C scheduler, kept free of locking so it can be simulated on the
+// host. A free bus goes to a request of the highest waiting priority; a running
+// transaction is never preempted.
+class I2cArbiter {
+   public:
+    static constexpr size_t PRIORITY_COUNT = static_cast<size_t>(I2cPriority::COUNT);
+
+    I2cArbiter();
+
+    void enqueue(const I2cPriority &priority);
+    // Drops a queued request that gave up waiting
+    void withdraw(const I2cPriority &priority);
+    bool canStart(const I2cPriority &priority) const;
+    void start(const I2cPriority &priority);
+    void finish();
+
+    bool isBusy() const;
+    uint32_t getWaiting(const I2cPriority &priority) const;
+
+   private:
+    std::array<uint32_t, PRIORITY_COUNT> mWaiting;
+    bool mBusy;
+};
+
+}  // namespace adapters
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "I2cArbiter.hpp"
+#include "II2cBus.hpp"
+
+namespace adapters {
+
+// Serialises transactions from several tasks onto one bus by priority. Drivers keep
+// talking to an II2cBus: each one is handed the client of its priority. Large transfers
+// must be split by the driver (see OledDisplay) so others can interleave.
+class I2cScheduler {
+   public:
+    class Client final : public II2cBus {
+       public:
+        Client(I2cScheduler &scheduler, const I2cPriority &priority);
+
+        // The scheduler owns the bus, its init() is done by whoever owns the scheduler
+        bool init() override;
+        bool writeBytes(const uint8_t &deviceAddr, const uint8_t *data, const size_t &len,
+                        const uint32_t &timeoutMs) override;
+        bool readBytes(const uint8_t &deviceAddr, uint8_t *data, const size_t &len,
+                       const uint32_t &timeoutMs) override;
+
+       private:
+        I2cScheduler &mScheduler;
+        I2cPriority mPriority;
+    };
+
+    explicit I2cScheduler(II2cBus &bus);
+
+    bool init();
+    II2cBus &client(const I2cPriority &priority);
+
+   private:
+    // Waits for the bus at most timeoutMs, like the transaction itself
+    bool acquire(const I2cPriority &priority, const uint32_t &timeoutMs);
+    void release();
+
+    II2cBus &mBus;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    I2cArbiter mArbiter;
+    std::array<Client, I2cArbiter::PRIORITY_COUNT> mClients;
+};
+
+}  // namespace adapters
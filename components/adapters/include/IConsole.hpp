@@ -0,0 +1,16 @@
+#pragma once
+
+#include <functional>
+
+namespace adapters {
+class IConsole {
+   public:
+    using CommandHandler = std::function<int(int argc, char **argv)>;
+
+    virtual ~IConsole() = default;
+
+    virtual bool init() = 0;
+    virtual bool registerCommand(const char *name, const char *help, CommandHandler handler) = 0;
+};
+
+}  // namespace adapters
@@ -4,12 +4,27 @@
 #include <cstdint>
 
 namespace adapters {
+// Rectangle in controller terms: inclusive columns and 8-pixel pages
+struct DisplayRegion {
+    uint8_t colStart;
+    uint8_t colEnd;
+    uint8_t pageStart;
+    uint8_t pageEnd;
+};
+
 class IDisplay {
    public:
     virtual ~IDisplay() = default;
 
     virtual bool init() = 0;
     virtual void showFramebuffer(const uint8_t* framebuffer, const size_t& len) = 0;
+    // Sends only the given regions of a full framebuffer
+    virtual void showRegions(const uint8_t* framebuffer, const size_t& len,
+                             const DisplayRegion* regions, const size_t& count) = 0;
+    // Rotates the whole panel up by the given number of pages (down when negative) without
+    // resending pixels. Page numbers passed in afterwards stay as seen on screen, so only
+    // the pages whose content actually changed need to follow
+    virtual void scrollPages(const int8_t& pages) = 0;
 };
 
 }  // namespace adapters
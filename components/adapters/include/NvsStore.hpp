@@ -0,0 +1,29 @@
+#pragma once
+
+#include <nvs.h>
+
+#include "IKeyValueStore.hpp"
+
+namespace adapters {
+// One NVS namespace. init() brings up the default NVS partition, erasing it when its layout
+// is from another IDF version or full; until then every call fails quietly.
+class NvsStore final : public common::IKeyValueStore {
+   public:
+    // The name must outlive the store, e.g. a string literal
+    explicit NvsStore(const char *nameSpace);
+    ~NvsStore() override;
+
+    bool init();
+
+    // IKeyValueStore
+    size_t load(const char *key, void *data, const size_t &capacity) override;
+    bool save(const char *key, const void *data, const size_t &len) override;
+    bool erase(const char *key) override;
+
+   private:
+    const char *mNamespace;
+    nvs_handle_t mHandle;
+    bool mOpen;
+};
+
+}  // namespace adapters
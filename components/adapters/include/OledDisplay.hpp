@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "BoardConfig.hpp"
+#include "IDisplay.hpp"
+#include "OledPanel.hpp"
+#include "Ssd1306Encoder.hpp"
+
+namespace adapters {
+
+class II2cBus;
+
+// I2C driver for a page-organised OLED, specialised at compile time on a panel descriptor
+// (see OledPanel.hpp). Instantiated in OledDisplay.cpp for the panels listed there.
+template <typename Panel>
+class OledDisplay final : public IDisplay {
+   public:
+    // Start line command with its control byte
+    static constexpr size_t START_LINE_SIZE = 2U;
+    // Addressing commands one transaction needs for its first page
+    static constexpr size_t ADDRESS_SIZE =
+        (Panel::CONTROLLER == common::OledController::Sh1106) ? Ssd1306Encoder::PAGE_ADDRESS_SIZE
+                                                              : Ssd1306Encoder::WINDOW_SIZE;
+    // Start line and addressing commands plus one page row of data: the largest transaction
+    static constexpr size_t MAX_TRANSACTION_SIZE =
+        START_LINE_SIZE + ADDRESS_SIZE + 1U + Panel::WIDTH;
+
+    explicit OledDisplay(II2cBus &i2cBus);
+    ~OledDisplay() override;
+
+    // IDisplay
+    bool init() override;
+    void showFramebuffer(const uint8_t *framebuffer, const size_t &len) override;
+    void showRegions(const uint8_t *framebuffer, const size_t &len, const DisplayRegion *regions,
+                     const size_t &count) override;
+    void scrollPages(const int8_t &pages) override;
+
+    // RAM row currently shown on the top line of the panel
+    uint8_t getStartLine() const;
+
+   private:
+    void sendInitSequence();
+    void appendStartLine();
+    uint8_t toRamPage(const uint8_t &page) const;
+    void sendRegion(const uint8_t *framebuffer, const DisplayRegion &region);
+    bool flush();
+
+    II2cBus &mI2cBus;
+    uint8_t mI2cAddr;
+    bool mReady;
+
+    // Pages the start line is rotated by; the command goes out with the next upload
+    uint8_t mStartPage;
+    bool mStartLinePending;
+
+    std::array<uint8_t, MAX_TRANSACTION_SIZE> mTxBuffer;
+    Ssd1306Encoder mEncoder;
+};
+
+extern template class OledDisplay<common::Ssd1306Panel128x64>;
+extern template class OledDisplay<common::Ssd1306Panel128x32>;
+extern template class OledDisplay<common::Sh1106Panel128x64>;
+
+// The panel this board is built with
+using BoardOledDisplay = OledDisplay<common::BoardOledPanel>;
+
+}  // namespace adapters
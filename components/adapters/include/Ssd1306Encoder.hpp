@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace adapters {
+// Builds one SSD1306 I2C transaction in a caller-owned buffer. Commands are prefixed with
+// a Co=1 control byte so they can be followed by more control bytes, and the transaction
+// ends with a single data stream. This folds the addressing window and its pixels into one
+// START/address/STOP instead of three. The SH1106 speaks the same framing.
+class Ssd1306Encoder {
+   public:
+    static constexpr uint8_t CTRL_COMMAND_STREAM = 0x00;  // Co=0, D/C#=0: commands till STOP
+    static constexpr uint8_t CTRL_DATA_STREAM = 0x40;     // Co=0, D/C#=1: data till STOP
+    static constexpr uint8_t CTRL_COMMAND = 0x80;         // Co=1, D/C#=0: one command byte
+
+    static constexpr uint8_t CMD_SET_COLUMN_ADDR = 0x21;
+    static constexpr uint8_t CMD_SET_PAGE_ADDR = 0x22;
+    static constexpr uint8_t CMD_SET_START_LINE = 0x40;  // | line 0-63: RAM row shown on top
+    // Page addressing, the only mode the SH1106 has
+    static constexpr uint8_t CMD_SET_LOW_COLUMN = 0x00;   // | column bits 0-3
+    static constexpr uint8_t CMD_SET_HIGH_COLUMN = 0x10;  // | column bits 4-7
+    static constexpr uint8_t CMD_SET_PAGE_START = 0xB0;   // | page 0-7
+
+    // Bytes setWindow() appends
+    static constexpr size_t WINDOW_SIZE = 12U;
+    // Bytes setPageAddress() appends
+    static constexpr size_t PAGE_ADDRESS_SIZE = 6U;
+
+    Ssd1306Encoder(uint8_t *buffer, const size_t &capacity);
+
+    void reset();
+
+    // Each returns false and leaves the buffer untouched if it does not fit or the stream
+    // is already closed by a data or command stream
+    bool command(const uint8_t &cmd);
+    bool commandStream(const uint8_t *cmds, const size_t &len);
+    // Inclusive column and page ranges, as the controller takes them
+    bool setWindow(const uint8_t &colStart, const uint8_t &colEnd, const uint8_t &pageStart,
+                   const uint8_t &pageEnd);
+    // Page and first column for page addressing; data runs along that page only
+    bool setPageAddress(const uint8_t &page, const uint8_t &column);
+    bool dataStream(const uint8_t *data, const size_t &len);
+
+    const uint8_t *data() const;
+    size_t size() const;
+
+   private:
+    bool fits(const size_t &len) const;
+
+    uint8_t *mBuffer;
+    size_t mCapacity;
+    size_t mSize;
+    bool mClosed;
+};
+
+}  // namespace adapters
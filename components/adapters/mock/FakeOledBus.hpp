@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "II2cBus.hpp"
+#include "OledPanel.hpp"
+
+namespace adapters {
+// Decodes the SSD1306/SH1106 I2C protocol into display RAM, so tests can compare what the
+// panel shows with what was rendered and count what it cost on the wire. Horizontal and
+// page addressing.
+template <typename Panel>
+class FakeOledBus : public II2cBus {
+   public:
+    static constexpr uint8_t RAM_WIDTH = Panel::RAM_WIDTH;
+    static constexpr uint8_t RAM_PAGES = Panel::RAM_PAGES;
+    static constexpr uint8_t RAM_ROWS = RAM_PAGES * 8U;
+
+    bool init() override {
+        return true;
+    }
+
+    bool writeBytes(const uint8_t& deviceAddr, const uint8_t* data, const size_t& len,
+                    const uint32_t& timeoutMs) override {
+        ++mTransactions;
+        mBytes += len;
+
+        size_t i = 0U;
+        while (i < len) {
+            const uint8_t control = data[i++];
+            const bool single = (control & 0x80U) != 0U;
+            const bool isData = (control & 0x40U) != 0U;
+            const size_t end = single ? std::min(i + 1U, len) : len;
+            for (; i < end; ++i) {
+                if (isData) {
+                    writeData(data[i]);
+                } else {
+                    writeCommand(data[i]);
+                }
+            }
+        }
+        return true;
+    }
+
+    bool readBytes(const uint8_t& deviceAddr, uint8_t* data, const size_t& len,
+                   const uint32_t& timeoutMs) override {
+        return false;
+    }
+
+    // Glass content top to bottom in framebuffer layout, start line and column offset applied
+    std::vector<uint8_t> visibleFrame() const {
+        std::vector<uint8_t> frame(Panel::FRAME_SIZE, 0U);
+        for (uint8_t row = 0U; row < Panel::HEIGHT; ++row) {
+            const uint8_t ramRow = static_cast<uint8_t>((row + mStartLine) % RAM_ROWS);
+            for (uint8_t col = 0U; col < Panel::WIDTH; ++col) {
+                const uint8_t ramCol = static_cast<uint8_t>(col + Panel::COLUMN_OFFSET);
+                if ((mRam[ramRow / 8U][ramCol] >> (ramRow % 8U)) & 0x01U) {
+                    frame[(row / 8U) * Panel::WIDTH + col] |=
+                        static_cast<uint8_t>(1U << (row % 8U));
+                }
+            }
+        }
+        return frame;
+    }
+
+    uint8_t getStartLine() const {
+        return mStartLine;
+    }
+
+    size_t getTransactions() const {
+        return mTransactions;
+    }
+
+    size_t getBytes() const {
+        return mBytes;
+    }
+
+    size_t getDataBytes() const {
+        return mDataBytes;
+    }
+
+    void resetCounters() {
+        mTransactions = 0U;
+        mBytes = 0U;
+        mDataBytes = 0U;
+    }
+
+   private:
+    static size_t argumentCount(const uint8_t& cmd) {
+        switch (cmd) {
+            case 0x21:  // column address
+            case 0x22:  // page address
+            case 0xA3:  // vertical scroll area
+                return 2U;
+            case 0x20:  // addressing mode
+            case 0x81:  // contrast
+            case 0x8D:  // charge pump
+            case 0xA8:  // multiplex ratio
+            case 0xAD:  // SH1106 DC-DC control
+            case 0xD3:  // display offset
+            case 0xD5:  // clock divide
+            case 0xD9:  // pre-charge
+            case 0xDA:  // COM pins
+            case 0xDB:  // VCOMH
+                return 1U;
+            case 0x26:  // horizontal scroll setup
+            case 0x27:
+                return 6U;
+            case 0x29:  // vertical and horizontal scroll setup
+            case 0x2A:
+                return 5U;
+            default:
+                return 0U;
+        }
+    }
+
+    void writeCommand(const uint8_t& byte) {
+        if (mArgsNeeded > 0U) {
+            mArgs[mArgCount++] = byte;
+            if (--mArgsNeeded == 0U) {
+                applyCommand();
+            }
+            return;
+        }
+
+        mCommand = byte;
+        mArgCount = 0U;
+        mArgsNeeded = argumentCount(byte);
+        if (mArgsNeeded == 0U) {
+            applyCommand();
+        }
+    }
+
+    void applyCommand() {
+        if (mCommand >= 0x40U && mCommand <= 0x7FU) {
+            mStartLine = static_cast<uint8_t>(mCommand & 0x3FU);
+        } else if (mCommand <= 0x0FU) {
+            mCol = static_cast<uint8_t>((mCol & 0xF0U) | mCommand);
+        } else if (mCommand <= 0x1FU) {
+            mCol = static_cast<uint8_t>((mCol & 0x0FU) | ((mCommand & 0x0FU) << 4U));
+        } else if (mCommand >= 0xB0U && mCommand <= 0xB7U) {
+            mPage = static_cast<uint8_t>(mCommand & 0x07U);
+        } else if (mCommand == 0x20U) {
+            mHorizontal = mArgs[0] == 0x00U;
+        } else if (mCommand == 0x21U) {
+            mColStart = mArgs[0];
+            mColEnd = mArgs[1];
+            mCol = mColStart;
+        } else if (mCommand == 0x22U) {
+            mPageStart = mArgs[0];
+            mPageEnd = mArgs[1];
+            mPage = mPageStart;
+        }
+    }
+
+    void writeData(const uint8_t& byte) {
+        ++mDataBytes;
+        mRam[mPage % RAM_PAGES][mCol % RAM_WIDTH] = byte;
+        if (!mHorizontal) {
+            // Page addressing stays on the page; the SH1106 stops at the last column
+            mCol = static_cast<uint8_t>(std::min<int>(mCol + 1, RAM_WIDTH - 1));
+            return;
+        }
+        if (++mCol > mColEnd) {
+            mCol = mColStart;
+            if (++mPage > mPageEnd) {
+                mPage = mPageStart;
+            }
+        }
+    }
+
+    std::array<std::array<uint8_t, RAM_WIDTH>, RAM_PAGES> mRam{};
+    uint8_t mStartLine = 0U;
+    bool mHorizontal = false;  // page addressing after reset
+    uint8_t mColStart = 0U;
+    uint8_t mColEnd = RAM_WIDTH - 1U;
+    uint8_t mPageStart = 0U;
+    uint8_t mPageEnd = RAM_PAGES - 1U;
+    uint8_t mCol = 0U;
+    uint8_t mPage = 0U;
+
+    uint8_t mCommand = 0U;
+    std::array<uint8_t, 6> mArgs{};
+    size_t mArgCount = 0U;
+    size_t mArgsNeeded = 0U;
+
+    size_t mTransactions = 0U;
+    size_t mBytes = 0U;
+    size_t mDataBytes = 0U;
+};
+
+}  // namespace adapters
@@ -9,6 +9,10 @@ class MockDisplay : public IDisplay {
    public:
     MOCK_METHOD(bool, init, (), (override));
     MOCK_METHOD(void, showFramebuffer, (const uint8_t*, const size_t&), (override));
+    MOCK_METHOD(void, showRegions,
+                (const uint8_t*, const size_t&, const DisplayRegion*, const size_t&),
+                (override));
+    MOCK_METHOD(void, scrollPages, (const int8_t&), (override));
 };
 
 }  // namespace adapters
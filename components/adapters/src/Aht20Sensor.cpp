@@ -0,0 +1,199 @@
+#include "Aht20Sensor.hpp"
+
+#include "IClock.hpp"
+#include "II2cBus.hpp"
+#include "Metrics.hpp"
+
+// IDF
+#include <esp_log.h>
+
+namespace adapters {
+static const char *TAG = "Aht20Sensor";
+
+static constexpr uint32_t I2C_TIMEOUT_MS = 20U;
+
+// Datasheet timings
+static constexpr uint32_t POWER_UP_MS = 40U;
+static constexpr uint32_t CALIBRATION_MS = 10U;
+static constexpr uint32_t CONVERSION_MS = 80U;
+static constexpr uint32_t BUSY_POLL_MS = 10U;
+static constexpr uint8_t MAX_BUSY_POLLS = 5U;
+static constexpr uint32_t RETRY_MS = 1000U;
+
+static constexpr uint8_t STATUS_BUSY = 0x80;
+static constexpr uint8_t STATUS_CALIBRATED = 0x08;
+
+static constexpr uint8_t CMD_INIT[] = {0xBE, 0x08, 0x00};
+static constexpr uint8_t CMD_TRIGGER[] = {0xAC, 0x33, 0x00};
+
+// Status, 5 bytes of packed 20-bit humidity and temperature, CRC
+static constexpr size_t MEASUREMENT_LEN = 7U;
+
+static metrics::Counter sReadings("aht20.readings");
+static metrics::Counter sBusyPolls("aht20.busy_polls");
+static metrics::Counter sCrcErrors("aht20.crc_errors");
+static metrics::Counter sBusErrors("aht20.bus_errors");
+
+Aht20Sensor::Aht20Sensor(II2cBus &i2cBus, const common::IClock &clock, const uint32_t &periodMs)
+    : mI2cBus(i2cBus),
+      mClock(clock),
+      mPeriodMs(periodMs),
+      mState(State::PowerUp),
+      mDeadlineUs(static_cast<uint64_t>(POWER_UP_MS) * 1000U),
+      mBusyPolls(0U),
+      mReading(),
+      mHasNewReading(false) {}
+
+uint32_t Aht20Sensor::poll() {
+    uint64_t nowUs = mClock.nowUs();
+
+    if (nowUs >= mDeadlineUs) {
+        switch (mState) {
+            case State::PowerUp:
+                stepPowerUp();
+                break;
+            case State::Calibrating:
+                stepCalibrating();
+                break;
+            case State::Idle:
+                stepIdle();
+                break;
+            case State::Converting:
+                stepConverting();
+                break;
+        }
+        nowUs = mClock.nowUs();
+    }
+
+    if (mDeadlineUs <= nowUs) {
+        return 0U;
+    }
+
+    // Round up so the caller never wakes before the deadline
+    return static_cast<uint32_t>((mDeadlineUs - nowUs + 999U) / 1000U);
+}
+
+bool Aht20Sensor::takeReading(common::ClimateReading &reading) {
+    if (!mHasNewReading) {
+        return false;
+    }
+
+    reading = mReading;
+    mHasNewReading = false;
+    return true;
+}
+
+Aht20Sensor::State Aht20Sensor::getState() const {
+    return mState;
+}
+
+void Aht20Sensor::stepPowerUp() {
+    uint8_t status = 0U;
+    if (!mI2cBus.readBytes(I2C_ADDR, &status, sizeof(status), I2C_TIMEOUT_MS)) {
+        ESP_LOGW(TAG, "Sensor not responding");
+        sBusErrors.add();
+        scheduleInMs(RETRY_MS);
+        return;
+    }
+
+    if ((status & STATUS_CALIBRATED) != 0U) {
+        mState = State::Idle;
+        scheduleInMs(0U);
+        return;
+    }
+
+    if (!mI2cBus.writeBytes(I2C_ADDR, CMD_INIT, sizeof(CMD_INIT), I2C_TIMEOUT_MS)) {
+        sBusErrors.add();
+        scheduleInMs(RETRY_MS);
+        return;
+    }
+
+    mState = State::Calibrating;
+    scheduleInMs(CALIBRATION_MS);
+}
+
+void Aht20Sensor::stepCalibrating() {
+    ESP_LOGI(TAG, "Calibration loaded");
+    mState = State::Idle;
+    scheduleInMs(0U);
+}
+
+void Aht20Sensor::stepIdle() {
+    if (!mI2cBus.writeBytes(I2C_ADDR, CMD_TRIGGER, sizeof(CMD_TRIGGER), I2C_TIMEOUT_MS)) {
+        sBusErrors.add();
+        retryLater();
+        return;
+    }
+
+    // The bus is released here; the sensor converts on its own
+    mState = State::Converting;
+    mBusyPolls = 0U;
+    scheduleInMs(CONVERSION_MS);
+}
+
+void Aht20Sensor::stepConverting() {
+    uint8_t data[MEASUREMENT_LEN] = {};
+    if (!mI2cBus.readBytes(I2C_ADDR, data, sizeof(data), I2C_TIMEOUT_MS)) {
+        sBusErrors.add();
+        retryLater();
+        return;
+    }
+
+    if ((data[0] & STATUS_BUSY) != 0U) {
+        sBusyPolls.add();
+        if (++mBusyPolls > MAX_BUSY_POLLS) {
+            ESP_LOGW(TAG, "Conversion did not finish");
+            retryLater();
+            return;
+        }
+        scheduleInMs(BUSY_POLL_MS);
+        return;
+    }
+
+    if (crc8(data, MEASUREMENT_LEN - 1U) != data[MEASUREMENT_LEN - 1U]) {
+        ESP_LOGW(TAG, "CRC mismatch");
+        sCrcErrors.add();
+        retryLater();
+        return;
+    }
+
+    const uint32_t rawHumidity = (static_cast<uint32_t>(data[1]) << 12U) |
+                                 (static_cast<uint32_t>(data[2]) << 4U) | (data[3] >> 4U);
+    const uint32_t rawTemperature = ((static_cast<uint32_t>(data[3]) & 0x0FU) << 16U) |
+                                    (static_cast<uint32_t>(data[4]) << 8U) | data[5];
+
+    // RH = raw / 2^20 * 100 %, T = raw / 2^20 * 200 - 50 C
+    mReading.humidityCentiPct = static_cast<uint16_t>((rawHumidity * 10000ULL) >> 20U);
+    mReading.temperatureCentiC =
+        static_cast<int16_t>(static_cast<int32_t>((rawTemperature * 20000ULL) >> 20U) - 5000);
+    mReading.timestampUs = mClock.nowUs();
+    mHasNewReading = true;
+    sReadings.add();
+
+    mState = State::Idle;
+    scheduleInMs(mPeriodMs);
+}
+
+void Aht20Sensor::scheduleInMs(const uint32_t &delayMs) {
+    mDeadlineUs = mClock.nowUs() + static_cast<uint64_t>(delayMs) * 1000U;
+}
+
+void Aht20Sensor::retryLater() {
+    mState = State::Idle;
+    scheduleInMs(RETRY_MS < mPeriodMs ? RETRY_MS : mPeriodMs);
+}
+
+uint8_t Aht20Sensor::crc8(const uint8_t *data, const size_t &len) {
+    // CRC-8/NRSC-5 as specified by the datasheet: poly 0x31, init 0xFF
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8U; ++bit) {
+            crc = (crc & 0x80U) != 0U ? static_cast<uint8_t>((crc << 1U) ^ 0x31U)
+                                      : static_cast<uint8_t>(crc << 1U);
+        }
+    }
+    return crc;
+}
+
+}  // namespace adapters
@@ -0,0 +1,11 @@
+#include "EspClock.hpp"
+
+// IDF
+#include <esp_timer.h>
+
+namespace adapters {
+uint64_t EspClock::nowUs() const {
+    return static_cast<uint64_t>(esp_timer_get_time());
+}
+
+}  // namespace adapters
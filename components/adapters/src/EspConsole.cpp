@@ -0,0 +1,100 @@
+#include "EspConsole.hpp"
+
+#include <cstring>
+#include <utility>
+
+// IDF
+#include <esp_log.h>
+
+namespace adapters {
+static constexpr const char *PROMPT = "player>";
+
+static const char *TAG = "EspConsole";
+
+EspConsole *EspConsole::sInstance = nullptr;
+
+EspConsole::EspConsole() : mRepl(nullptr), mCommands(), mCommandCount(0U) {
+    sInstance = this;
+}
+
+EspConsole::~EspConsole() {
+    if (mRepl != nullptr) {
+        mRepl->del(mRepl);
+    }
+    sInstance = nullptr;
+}
+
+bool EspConsole::init() {
+    esp_console_repl_config_t replConfig = ESP_CONSOLE_REPL_CONFIG_DEFAULT();
+    replConfig.prompt = PROMPT;
+
+    esp_err_t ret = ESP_FAIL;
+#if defined(CONFIG_ESP_CONSOLE_UART_DEFAULT) || defined(CONFIG_ESP_CONSOLE_UART_CUSTOM)
+    esp_console_dev_uart_config_t hwConfig = ESP_CONSOLE_DEV_UART_CONFIG_DEFAULT();
+    ret = esp_console_new_repl_uart(&hwConfig, &replConfig, &mRepl);
+#elif defined(CONFIG_ESP_CONSOLE_USB_SERIAL_JTAG)
+    esp_console_dev_usb_serial_jtag_config_t hwConfig =
+        ESP_CONSOLE_DEV_USB_SERIAL_JTAG_CONFIG_DEFAULT();
+    ret = esp_console_new_repl_usb_serial_jtag(&hwConfig, &replConfig, &mRepl);
+#elif defined(CONFIG_ESP_CONSOLE_USB_CDC)
+    esp_console_dev_usb_cdc_config_t hwConfig = ESP_CONSOLE_DEV_CDC_CONFIG_DEFAULT();
+    ret = esp_console_new_repl_usb_cdc(&hwConfig, &replConfig, &mRepl);
+#endif
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create console REPL: %s", esp_err_to_name(ret));
+        return false;
+    }
+
+    esp_console_register_help_command();
+
+    // Commands may still be registered after the REPL is running
+    ret = esp_console_start_repl(mRepl);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start console REPL: %s", esp_err_to_name(ret));
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Console ready");
+    return true;
+}
+
+bool EspConsole::registerCommand(const char *name, const char *help, CommandHandler handler) {
+    if (mCommandCount >= MAX_COMMANDS) {
+        ESP_LOGE(TAG, "No room for console command '%s'", name);
+        return false;
+    }
+
+    esp_console_cmd_t cmd = {};
+    cmd.command = name;
+    cmd.help = help;
+    cmd.func = &EspConsole::dispatch;
+
+    const esp_err_t ret = esp_console_cmd_register(&cmd);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register '%s': %s", name, esp_err_to_name(ret));
+        return false;
+    }
+
+    mCommands[mCommandCount] = {name, std::move(handler)};
+    ++mCommandCount;
+
+    return true;
+}
+
+int EspConsole::dispatch(int argc, char **argv) {
+    if (sInstance == nullptr || argc < 1) {
+        return 1;
+    }
+
+    for (size_t i = 0U; i < sInstance->mCommandCount; ++i) {
+        const Command &command = sInstance->mCommands[i];
+        if (std::strcmp(command.name, argv[0]) == 0) {
+            return command.handler(argc, argv);
+        }
+    }
+
+    return 1;
+}
+
+}  // namespace adapters
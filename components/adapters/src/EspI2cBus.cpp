@@ -1,6 +1,8 @@
 #include "EspI2cBus.hpp"
 
 #include "BoardConfig.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
 
 // IDF
 #include <driver/i2c_master.h>
@@ -9,23 +11,31 @@
 
 namespace adapters {
 
+static constexpr uint32_t PROBE_TIMEOUT_MS = 50U;
+
 static const char *TAG = "EspI2cBus";
 
+static metrics::Counter sTxBytes("i2c.tx_bytes");
+static metrics::Counter sRxBytes("i2c.rx_bytes");
+static metrics::Counter sErrors("i2c.errors");
+
 EspI2cBus::EspI2cBus(const int &port)
-    : mPort(port), mBusHandle(nullptr), mInitialized(false), mFreqHz(0U) {
+    : mPort(port), mBusHandle(nullptr), mInitialized(false), mFreqHz(0U), mDeviceHandles{} {
     ESP_LOGI(TAG, "Creating EspI2cBus on port %d", mPort);
 }
 
 EspI2cBus::~EspI2cBus() {
-    ESP_LOGI(TAG, "I2C cleanup: %zu device(s), bus %s", mDeviceHandles.size(),
-             mBusHandle ? "valid" : "null");
-
-    for (auto &[addr, devHandle] : mDeviceHandles) {
+    size_t deviceCount = 0U;
+    for (auto &devHandle : mDeviceHandles) {
         if (devHandle) {
             i2c_master_bus_rm_device(devHandle);
+            devHandle = nullptr;
+            ++deviceCount;
         }
     }
-    mDeviceHandles.clear();
+
+    ESP_LOGI(TAG, "I2C cleanup: %zu device(s), bus %s", deviceCount,
+             mBusHandle ? "valid" : "null");
 
     if (mBusHandle) {
         i2c_del_master_bus(mBusHandle);
@@ -54,9 +64,11 @@ bool EspI2cBus::init() {
         ESP_LOGI(TAG, "I2C master bus configured (SDA=%d, SCL=%d, freq=%lu Hz)",
                  common::I2C_SDA_GPIO, common::I2C_SCL_GPIO, mFreqHz);
 
-        // Probe 0x3C for OLED
-        esp_err_t probe_ret = i2c_master_probe(mBusHandle, 0x3C, pdMS_TO_TICKS(1000));
-        ESP_LOGI(TAG, "I2C probe 0x3C: %s", esp_err_to_name(probe_ret));
+        // Probe the OLED. A present device ACKs within microseconds, so keep the timeout
+        // short to not stall the boot when it is missing
+        esp_err_t probe_ret =
+            i2c_master_probe(mBusHandle, common::OLED_I2C_ADDR, pdMS_TO_TICKS(PROBE_TIMEOUT_MS));
+        ESP_LOGI(TAG, "I2C probe 0x%02X: %s", common::OLED_I2C_ADDR, esp_err_to_name(probe_ret));
     } else {
         ESP_LOGE(TAG, "Failed to configure I2C master bus: %s", esp_err_to_name(ret));
     }
@@ -76,8 +88,12 @@ bool EspI2cBus::writeBytes(const uint8_t &deviceAddr, const uint8_t *data, const
         return false;
     }
 
+    TRACE_SCOPE_ARG(I2C_WRITE, len);
     const esp_err_t ret = i2c_master_transmit(devHandle, data, len, pdMS_TO_TICKS(timeoutMs));
-    if (ret != ESP_OK) {
+    if (ret == ESP_OK) {
+        sTxBytes.add(static_cast<uint32_t>(len));
+    } else {
+        sErrors.add();
         ESP_LOGW(TAG, "I2C write failed to 0x%02X: %s", deviceAddr, esp_err_to_name(ret));
     }
 
@@ -96,8 +112,12 @@ bool EspI2cBus::readBytes(const uint8_t &deviceAddr, uint8_t *data, const size_t
         return false;
     }
 
+    TRACE_SCOPE_ARG(I2C_READ, len);
     const esp_err_t ret = i2c_master_receive(devHandle, data, len, pdMS_TO_TICKS(timeoutMs));
-    if (ret != ESP_OK) {
+    if (ret == ESP_OK) {
+        sRxBytes.add(static_cast<uint32_t>(len));
+    } else {
+        sErrors.add();
         ESP_LOGW(TAG, "I2C read failed from 0x%02X: %s", deviceAddr, esp_err_to_name(ret));
     }
 
@@ -105,9 +125,13 @@ bool EspI2cBus::readBytes(const uint8_t &deviceAddr, uint8_t *data, const size_t
 }
 
 i2c_master_dev_handle_t EspI2cBus::getOrCreateDeviceHandle(const uint8_t &deviceAddr) {
-    auto it = mDeviceHandles.find(deviceAddr);
-    if (it != mDeviceHandles.end()) {
-        return it->second;
+    if (deviceAddr >= ADDRESS_COUNT) {
+        ESP_LOGE(TAG, "Invalid 7-bit address 0x%02X", deviceAddr);
+        return nullptr;
+    }
+
+    if (mDeviceHandles[deviceAddr]) {
+        return mDeviceHandles[deviceAddr];
     }
 
     i2c_device_config_t devConfig = {};
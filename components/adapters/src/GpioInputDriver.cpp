@@ -0,0 +1,113 @@
+#include "GpioInputDriver.hpp"
+
+#include "BoardConfig.hpp"
+
+// IDF
+#include <driver/gpio.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+
+namespace adapters {
+static const char *TAG = "GpioInputDriver";
+
+GpioInputDriver::GpioInputDriver()
+    : mEdges(),
+      mPins({{{this, common::InputPin::Up, common::BTN_UP_GPIO},
+              {this, common::InputPin::Down, common::BTN_DOWN_GPIO},
+              {this, common::InputPin::PlayStop, common::BTN_PLAY_STOP_GPIO},
+              {this, common::InputPin::EncoderA, common::ENC_S1_GPIO},
+              {this, common::InputPin::EncoderB, common::ENC_S2_GPIO}}}),
+      mConsumerTask(nullptr),
+      mDroppedEdges(0U),
+      mInitialized(false) {}
+
+GpioInputDriver::~GpioInputDriver() {
+    if (!mInitialized) {
+        return;
+    }
+
+    for (const auto &ctx : mPins) {
+        gpio_isr_handler_remove(static_cast<gpio_num_t>(ctx.gpio));
+    }
+}
+
+bool GpioInputDriver::init(TaskHandle_t consumerTask) {
+    mConsumerTask = consumerTask;
+
+    uint64_t pinMask = 0U;
+    for (const auto &ctx : mPins) {
+        pinMask |= (1ULL << ctx.gpio);
+    }
+
+    gpio_config_t config = {};
+    config.pin_bit_mask = pinMask;
+    config.mode = GPIO_MODE_INPUT;
+    config.pull_up_en = GPIO_PULLUP_ENABLE;
+    config.pull_down_en = GPIO_PULLDOWN_DISABLE;
+    config.intr_type = GPIO_INTR_ANYEDGE;
+
+    esp_err_t ret = gpio_config(&config);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to configure input GPIOs: %s", esp_err_to_name(ret));
+        return false;
+    }
+
+    // Not ESP_INTR_FLAG_IRAM: the queue code lives in flash, edges during flash writes are
+    // delivered once the cache is back. The service may already be installed.
+    ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "Failed to install GPIO ISR service: %s", esp_err_to_name(ret));
+        return false;
+    }
+
+    for (auto &ctx : mPins) {
+        ret = gpio_isr_handler_add(static_cast<gpio_num_t>(ctx.gpio), &GpioInputDriver::isrHandler,
+                                   &ctx);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to add ISR for GPIO %d: %s", ctx.gpio, esp_err_to_name(ret));
+            return false;
+        }
+    }
+
+    mInitialized = true;
+    ESP_LOGI(TAG, "Input GPIOs ready");
+    return true;
+}
+
+// All handlers run from the one GPIO interrupt, never nested, so the queue has a single
+// producer
+void IRAM_ATTR GpioInputDriver::isrHandler(void *arg) {
+    auto *ctx = static_cast<PinContext *>(arg);
+    GpioInputDriver *driver = ctx->driver;
+
+    common::RawEdge edge{};
+    edge.timestampUs = static_cast<uint64_t>(esp_timer_get_time());
+    edge.pin = ctx->pin;
+
+    if (ctx->pin == common::InputPin::EncoderA || ctx->pin == common::InputPin::EncoderB) {
+        // Sample both lines so a lost edge shows up as a skipped state
+        edge.level = static_cast<uint8_t>(
+            (gpio_get_level(static_cast<gpio_num_t>(common::ENC_S1_GPIO)) << 1) |
+            gpio_get_level(static_cast<gpio_num_t>(common::ENC_S2_GPIO)));
+    } else {
+        edge.level = static_cast<uint8_t>(gpio_get_level(static_cast<gpio_num_t>(ctx->gpio)));
+    }
+
+    if (!driver->mEdges.push(edge)) {
+        driver->mDroppedEdges.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(driver->mConsumerTask, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+bool GpioInputDriver::popEdge(common::RawEdge &edge) {
+    return mEdges.pop(edge);
+}
+
+uint32_t GpioInputDriver::getDroppedEdges() const {
+    return mDroppedEdges.load(std::memory_order_relaxed);
+}
+
+}  // namespace adapters
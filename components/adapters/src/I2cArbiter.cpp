@@ -0,0 +1,45 @@
+#include "I2cArbiter.hpp"
+
+namespace adapters {
+I2cArbiter::I2cArbiter() : mWaiting{}, mBusy(false) {}
+
+void I2cArbiter::enqueue(const I2cPriority &priority) {
+    ++mWaiting[static_cast<size_t>(priority)];
+}
+
+void I2cArbiter::withdraw(const I2cPriority &priority) {
+    --mWaiting[static_cast<size_t>(priority)];
+}
+
+bool I2cArbiter::canStart(const I2cPriority &priority) const {
+    if (mBusy) {
+        return false;
+    }
+
+    for (size_t higher = 0; higher < static_cast<size_t>(priority); ++higher) {
+        if (mWaiting[higher] != 0U) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void I2cArbiter::start(const I2cPriority &priority) {
+    --mWaiting[static_cast<size_t>(priority)];
+    mBusy = true;
+}
+
+void I2cArbiter::finish() {
+    mBusy = false;
+}
+
+bool I2cArbiter::isBusy() const {
+    return mBusy;
+}
+
+uint32_t I2cArbiter::getWaiting(const I2cPriority &priority) const {
+    return mWaiting[static_cast<size_t>(priority)];
+}
+
+}  // namespace adapters
@@ -0,0 +1,97 @@
+#include "I2cScheduler.hpp"
+
+#include <chrono>
+
+#include "Metrics.hpp"
+
+// IDF
+#include <esp_timer.h>
+
+namespace adapters {
+static metrics::Counter sWaitTimeouts("i2c.wait_timeouts");
+static metrics::Histogram sWaitHighUs("i2c.wait_high_us", metrics::LATENCY_BUCKETS_US);
+static metrics::Histogram sWaitNormalUs("i2c.wait_normal_us", metrics::LATENCY_BUCKETS_US);
+static metrics::Histogram sWaitLowUs("i2c.wait_low_us", metrics::LATENCY_BUCKETS_US);
+
+static metrics::Histogram *const WAIT_HISTOGRAMS[I2cArbiter::PRIORITY_COUNT] = {
+    &sWaitHighUs, &sWaitNormalUs, &sWaitLowUs};
+
+I2cScheduler::Client::Client(I2cScheduler &scheduler, const I2cPriority &priority)
+    : mScheduler(scheduler), mPriority(priority) {}
+
+bool I2cScheduler::Client::init() {
+    return true;
+}
+
+bool I2cScheduler::Client::writeBytes(const uint8_t &deviceAddr, const uint8_t *data,
+                                      const size_t &len, const uint32_t &timeoutMs) {
+    if (!mScheduler.acquire(mPriority, timeoutMs)) {
+        return false;
+    }
+    const bool ok = mScheduler.mBus.writeBytes(deviceAddr, data, len, timeoutMs);
+    mScheduler.release();
+
+    return ok;
+}
+
+bool I2cScheduler::Client::readBytes(const uint8_t &deviceAddr, uint8_t *data, const size_t &len,
+                                     const uint32_t &timeoutMs) {
+    if (!mScheduler.acquire(mPriority, timeoutMs)) {
+        return false;
+    }
+    const bool ok = mScheduler.mBus.readBytes(deviceAddr, data, len, timeoutMs);
+    mScheduler.release();
+
+    return ok;
+}
+
+I2cScheduler::I2cScheduler(II2cBus &bus)
+    : mBus(bus),
+      mMutex(),
+      mCondition(),
+      mArbiter(),
+      mClients{{{*this, I2cPriority::High},
+                {*this, I2cPriority::Normal},
+                {*this, I2cPriority::Low}}} {}
+
+bool I2cScheduler::init() {
+    return mBus.init();
+}
+
+II2cBus &I2cScheduler::client(const I2cPriority &priority) {
+    return mClients[static_cast<size_t>(priority)];
+}
+
+bool I2cScheduler::acquire(const I2cPriority &priority, const uint32_t &timeoutMs) {
+    const int64_t requestUs = esp_timer_get_time();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mArbiter.enqueue(priority);
+    if (!mCondition.wait_until(lock, deadline,
+                               [this, &priority] { return mArbiter.canStart(priority); })) {
+        mArbiter.withdraw(priority);
+        lock.unlock();
+        // Our leaving may unblock a lower priority
+        mCondition.notify_all();
+        sWaitTimeouts.add();
+        return false;
+    }
+    mArbiter.start(priority);
+    lock.unlock();
+
+    WAIT_HISTOGRAMS[static_cast<size_t>(priority)]->record(
+        static_cast<uint32_t>(esp_timer_get_time() - requestUs));
+    return true;
+}
+
+void I2cScheduler::release() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mArbiter.finish();
+    }
+    // Every waiter re-checks; there are only a handful of bus users
+    mCondition.notify_all();
+}
+
+}  // namespace adapters
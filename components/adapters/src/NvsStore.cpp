@@ -0,0 +1,88 @@
+#include "NvsStore.hpp"
+
+// IDF
+#include <esp_log.h>
+#include <nvs_flash.h>
+
+namespace adapters {
+static const char *TAG = "NvsStore";
+
+NvsStore::NvsStore(const char *nameSpace) : mNamespace(nameSpace), mHandle(0), mOpen(false) {}
+
+NvsStore::~NvsStore() {
+    if (mOpen) {
+        nvs_close(mHandle);
+    }
+}
+
+bool NvsStore::init() {
+    if (mOpen) {
+        return true;
+    }
+
+    esp_err_t err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        ESP_LOGW(TAG, "NVS partition unusable (%s), erasing", esp_err_to_name(err));
+        nvs_flash_erase();
+        err = nvs_flash_init();
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "NVS init failed: %s", esp_err_to_name(err));
+        return false;
+    }
+
+    err = nvs_open(mNamespace, NVS_READWRITE, &mHandle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Cannot open NVS namespace '%s': %s", mNamespace, esp_err_to_name(err));
+        return false;
+    }
+
+    mOpen = true;
+    return true;
+}
+
+size_t NvsStore::load(const char *key, void *data, const size_t &capacity) {
+    if (!mOpen) {
+        return 0U;
+    }
+
+    size_t len = capacity;
+    const esp_err_t err = nvs_get_blob(mHandle, key, data, &len);
+    if (err != ESP_OK) {
+        if (err != ESP_ERR_NVS_NOT_FOUND) {
+            ESP_LOGW(TAG, "Reading '%s' failed: %s", key, esp_err_to_name(err));
+        }
+        return 0U;
+    }
+    return len;
+}
+
+bool NvsStore::save(const char *key, const void *data, const size_t &len) {
+    if (!mOpen) {
+        return false;
+    }
+
+    esp_err_t err = nvs_set_blob(mHandle, key, data, len);
+    if (err == ESP_OK) {
+        err = nvs_commit(mHandle);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Writing '%s' failed: %s", key, esp_err_to_name(err));
+        return false;
+    }
+    return true;
+}
+
+bool NvsStore::erase(const char *key) {
+    if (!mOpen) {
+        return false;
+    }
+
+    const esp_err_t err = nvs_erase_key(mHandle, key);
+    if (err == ESP_OK) {
+        nvs_commit(mHandle);
+    }
+    return err == ESP_OK;
+}
+
+}  // namespace adapters
@@ -0,0 +1,179 @@
+#include "OledDisplay.hpp"
+
+#include <algorithm>
+
+#include "II2cBus.hpp"
+#include "Trace.hpp"
+
+// IDF
+#include <esp_log.h>
+
+namespace adapters {
+static const char *TAG = "OledDisplay";
+
+template <typename Panel>
+static constexpr bool IS_SH1106 = Panel::CONTROLLER == common::OledController::Sh1106;
+
+// Power-up configuration. Both controllers share the timing and mapping commands; the SH1106
+// has a DC-DC converter instead of the charge pump and no addressing mode to select.
+template <typename Panel>
+static constexpr auto initSequence() {
+    if constexpr (IS_SH1106<Panel>) {
+        return std::array<uint8_t, 23>{0xAE, 0xD5, 0x80, 0xA8, Panel::MULTIPLEX,
+                                       0xD3, 0x00, 0x40, 0xAD, 0x8B,
+                                       0xA1, 0xC8, 0xDA, Panel::COM_PINS, 0x81,
+                                       0x7F, 0xD9, 0x22, 0xDB, 0x35,
+                                       0xA4, 0xA6, 0xAF};
+    } else {
+        return std::array<uint8_t, 25>{0xAE, 0xD5, 0x80, 0xA8, Panel::MULTIPLEX,
+                                       0xD3, 0x00, 0x40, 0x8D, 0x14,
+                                       0x20, 0x00, 0xA1, 0xC8, 0xDA,
+                                       Panel::COM_PINS, 0x81, 0x7F, 0xD9, 0xF1,
+                                       0xDB, 0x20, 0xA4, 0xA6, 0xAF};
+    }
+}
+
+template <typename Panel>
+OledDisplay<Panel>::OledDisplay(II2cBus &i2cBus)
+    : mI2cBus(i2cBus),
+      mI2cAddr(common::OLED_I2C_ADDR),
+      mReady(false),
+      mStartPage(0U),
+      mStartLinePending(false),
+      mTxBuffer{},
+      mEncoder(mTxBuffer.data(), mTxBuffer.size()) {
+    ESP_LOGI(TAG, "Creating OledDisplay %ux%u", Panel::WIDTH, Panel::HEIGHT);
+}
+
+template <typename Panel>
+OledDisplay<Panel>::~OledDisplay() {}
+
+template <typename Panel>
+bool OledDisplay<Panel>::init() {
+    sendInitSequence();
+
+    mReady = true;
+    ESP_LOGI(TAG, "OLED ready");
+
+    return true;
+}
+
+template <typename Panel>
+void OledDisplay<Panel>::showFramebuffer(const uint8_t *framebuffer, const size_t &len) {
+    static constexpr DisplayRegion FULL = {0U, Panel::WIDTH - 1U, 0U, Panel::PAGES - 1U};
+    showRegions(framebuffer, len, &FULL, 1U);
+}
+
+template <typename Panel>
+void OledDisplay<Panel>::showRegions(const uint8_t *framebuffer, const size_t &len,
+                                     const DisplayRegion *regions, const size_t &count) {
+    if (!mReady) {
+        ESP_LOGW(TAG, "Display not ready");
+        return;
+    }
+
+    if (len < Panel::FRAME_SIZE) {
+        ESP_LOGE(TAG, "Framebuffer too small: %zu bytes", len);
+        return;
+    }
+
+    TRACE_SCOPE_ARG(OLED_SHOW_FRAMEBUFFER, count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const DisplayRegion &region = regions[i];
+        if (region.colStart > region.colEnd || region.colEnd >= Panel::WIDTH ||
+            region.pageStart > region.pageEnd || region.pageEnd >= Panel::PAGES) {
+            ESP_LOGW(TAG, "Skipping invalid region cols %u-%u pages %u-%u", region.colStart,
+                     region.colEnd, region.pageStart, region.pageEnd);
+            continue;
+        }
+
+        sendRegion(framebuffer, region);
+    }
+
+    // Nothing to upload, the rotation still has to reach the panel
+    if (mStartLinePending) {
+        mEncoder.reset();
+        appendStartLine();
+        flush();
+    }
+}
+
+template <typename Panel>
+void OledDisplay<Panel>::scrollPages(const int8_t &pages) {
+    const int rotated = (static_cast<int>(mStartPage) + pages) % Panel::RAM_PAGES;
+    mStartPage = static_cast<uint8_t>((rotated < 0) ? rotated + Panel::RAM_PAGES : rotated);
+    mStartLinePending = true;
+}
+
+template <typename Panel>
+uint8_t OledDisplay<Panel>::getStartLine() const {
+    return static_cast<uint8_t>(mStartPage * Panel::PAGE_HEIGHT);
+}
+
+template <typename Panel>
+void OledDisplay<Panel>::sendInitSequence() {
+    static constexpr auto INIT_CMD = initSequence<Panel>();
+
+    mEncoder.reset();
+    mEncoder.commandStream(INIT_CMD.data(), INIT_CMD.size());
+    flush();
+}
+
+template <typename Panel>
+void OledDisplay<Panel>::appendStartLine() {
+    mEncoder.command(static_cast<uint8_t>(Ssd1306Encoder::CMD_SET_START_LINE | getStartLine()));
+    mStartLinePending = false;
+}
+
+template <typename Panel>
+uint8_t OledDisplay<Panel>::toRamPage(const uint8_t &page) const {
+    return static_cast<uint8_t>((page + mStartPage) % Panel::RAM_PAGES);
+}
+
+template <typename Panel>
+void OledDisplay<Panel>::sendRegion(const uint8_t *framebuffer, const DisplayRegion &region) {
+    const size_t width = static_cast<size_t>(region.colEnd - region.colStart) + 1U;
+    const uint8_t ramColStart = static_cast<uint8_t>(region.colStart + Panel::COLUMN_OFFSET);
+    const uint8_t ramColEnd = static_cast<uint8_t>(region.colEnd + Panel::COLUMN_OFFSET);
+
+    // On the SSD1306 the window rides in the first transaction; horizontal addressing wraps
+    // to the next page inside the window, so later pages are bare data. With a rotated
+    // start line the RAM pages wrap past the last one, which needs a second window. The
+    // SH1106 has no window, so every page carries its own address. One page per
+    // transaction keeps the bus free for other devices in between.
+    uint8_t nextRamPage = Panel::RAM_PAGES;
+    for (uint8_t page = region.pageStart; page <= region.pageEnd; ++page) {
+        const uint8_t ramPage = toRamPage(page);
+
+        mEncoder.reset();
+        if (mStartLinePending) {
+            appendStartLine();
+        }
+        if constexpr (IS_SH1106<Panel>) {
+            mEncoder.setPageAddress(ramPage, ramColStart);
+        } else if (ramPage != nextRamPage) {
+            const uint8_t ramPageEnd = static_cast<uint8_t>(
+                std::min<int>(Panel::RAM_PAGES - 1, ramPage + (region.pageEnd - page)));
+            mEncoder.setWindow(ramColStart, ramColEnd, ramPage, ramPageEnd);
+        }
+        nextRamPage = static_cast<uint8_t>(ramPage + 1U);
+
+        mEncoder.dataStream(&framebuffer[page * Panel::WIDTH + region.colStart], width);
+
+        if (!flush()) {
+            return;
+        }
+    }
+}
+
+template <typename Panel>
+bool OledDisplay<Panel>::flush() {
+    return mI2cBus.writeBytes(mI2cAddr, mEncoder.data(), mEncoder.size());
+}
+
+template class OledDisplay<common::Ssd1306Panel128x64>;
+template class OledDisplay<common::Ssd1306Panel128x32>;
+template class OledDisplay<common::Sh1106Panel128x64>;
+
+}  // namespace adapters
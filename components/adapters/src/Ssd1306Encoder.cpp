@@ -0,0 +1,86 @@
+#include "Ssd1306Encoder.hpp"
+
+#include <cstring>
+
+namespace adapters {
+Ssd1306Encoder::Ssd1306Encoder(uint8_t *buffer, const size_t &capacity)
+    : mBuffer(buffer), mCapacity(capacity), mSize(0U), mClosed(false) {}
+
+void Ssd1306Encoder::reset() {
+    mSize = 0U;
+    mClosed = false;
+}
+
+bool Ssd1306Encoder::command(const uint8_t &cmd) {
+    if (!fits(2U)) {
+        return false;
+    }
+
+    mBuffer[mSize++] = CTRL_COMMAND;
+    mBuffer[mSize++] = cmd;
+    return true;
+}
+
+bool Ssd1306Encoder::commandStream(const uint8_t *cmds, const size_t &len) {
+    if (!fits(len + 1U)) {
+        return false;
+    }
+
+    mBuffer[mSize++] = CTRL_COMMAND_STREAM;
+    std::memcpy(&mBuffer[mSize], cmds, len);
+    mSize += len;
+    mClosed = true;
+    return true;
+}
+
+bool Ssd1306Encoder::setWindow(const uint8_t &colStart, const uint8_t &colEnd,
+                               const uint8_t &pageStart, const uint8_t &pageEnd) {
+    if (!fits(WINDOW_SIZE)) {
+        return false;
+    }
+
+    command(CMD_SET_COLUMN_ADDR);
+    command(colStart);
+    command(colEnd);
+    command(CMD_SET_PAGE_ADDR);
+    command(pageStart);
+    command(pageEnd);
+    return true;
+}
+
+bool Ssd1306Encoder::setPageAddress(const uint8_t &page, const uint8_t &column) {
+    if (!fits(PAGE_ADDRESS_SIZE)) {
+        return false;
+    }
+
+    command(static_cast<uint8_t>(CMD_SET_PAGE_START | (page & 0x07U)));
+    command(static_cast<uint8_t>(CMD_SET_LOW_COLUMN | (column & 0x0FU)));
+    command(static_cast<uint8_t>(CMD_SET_HIGH_COLUMN | (column >> 4U)));
+    return true;
+}
+
+bool Ssd1306Encoder::dataStream(const uint8_t *data, const size_t &len) {
+    if (!fits(len + 1U)) {
+        return false;
+    }
+
+    mBuffer[mSize++] = CTRL_DATA_STREAM;
+    std::memcpy(&mBuffer[mSize], data, len);
+    mSize += len;
+    mClosed = true;
+    return true;
+}
+
+const uint8_t *Ssd1306Encoder::data() const {
+    return mBuffer;
+}
+
+size_t Ssd1306Encoder::size() const {
+    return mSize;
+}
+
+bool Ssd1306Encoder::fits(const size_t &len) const {
+    return !mClosed && (mSize + len) <= mCapacity;
+}
+
+}  // namespace adapters
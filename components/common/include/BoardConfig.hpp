@@ -1,6 +1,8 @@
 #pragma once
 #include <cstdint>
 
+#include "OledPanel.hpp"
+
 namespace common {
 // ---- I2C (OLED + AHT20) ----
 static constexpr int I2C_PORT = 0;      // I2C_NUM_0
@@ -10,10 +12,26 @@ static constexpr uint32_t I2C_FREQ_HZ = 400000;
 
 // ---- OLED SSD1306 ----
 static constexpr uint8_t OLED_I2C_ADDR = 0x3C;
-static constexpr int OLED_WIDTH = 128;
-static constexpr int OLED_HEIGHT = 64;
+// Panel the renderer and the driver are built for
+using BoardOledPanel = Ssd1306Panel128x64;
 
 // TBD: Not used with I2C
 static constexpr int OLED_RESET_GPIO = -1;
 
+// ---- Inputs (active low, internal pull-ups) ----
+static constexpr int ENC_S1_GPIO = 3;   // GP3 (A)
+static constexpr int ENC_S2_GPIO = 4;   // GP4 (B)
+static constexpr int ENC_KEY_GPIO = 5;  // GP5, not used yet
+static constexpr int BTN_UP_GPIO = 6;
+static constexpr int BTN_DOWN_GPIO = 7;
+static constexpr int BTN_PLAY_STOP_GPIO = 8;
+
+// ---- I2S DAC ----
+static constexpr int I2S_PORT = 0;  // I2S_NUM_0
+static constexpr int I2S_BCLK_GPIO = 9;
+static constexpr int I2S_WS_GPIO = 10;
+static constexpr int I2S_DOUT_GPIO = 11;
+// Every stream is resampled to this, the I2S clock never changes
+static constexpr uint32_t I2S_SAMPLE_RATE_HZ = 48000;
+
 }  // namespace common
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace common {
+class IClock {
+   public:
+    virtual ~IClock() = default;
+
+    // Monotonic time since boot
+    virtual uint64_t nowUs() const = 0;
+};
+
+}  // namespace common
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace common {
+// Small persistent blobs that survive a reboot. Keys are at most MAX_KEY_LEN characters.
+class IKeyValueStore {
+   public:
+    static constexpr size_t MAX_KEY_LEN = 15U;
+
+    virtual ~IKeyValueStore() = default;
+
+    // Bytes copied into data, 0 when the key is missing or does not fit
+    virtual size_t load(const char *key, void *data, const size_t &capacity) = 0;
+    virtual bool save(const char *key, const void *data, const size_t &len) = 0;
+    virtual bool erase(const char *key) = 0;
+};
+
+}  // namespace common
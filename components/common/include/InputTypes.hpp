@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+namespace common {
+enum class InputPin : uint8_t { Up, Down, PlayStop, EncoderA, EncoderB, COUNT };
+
+// Captured by the GPIO ISR, decoded later on the input task
+struct RawEdge {
+    uint64_t timestampUs;
+    InputPin pin;
+    uint8_t level;
+};
+
+struct InputEvent {
+    enum class Type : uint8_t { Up, Down, PlayStop, Volume };
+
+    Type type;
+    int16_t steps = 0;     // Volume: signed detents after acceleration
+    uint64_t edgeUs = 0U;  // timestamp of the edge that produced the event
+};
+
+}  // namespace common
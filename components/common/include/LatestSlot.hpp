@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace common {
+// Lock-free single-producer/single-consumer slot that only keeps the newest value: a triple
+// buffer. The producer writes into a buffer of its own and swaps it with the shared middle
+// one, the consumer swaps the middle one with its own once a new value is there. Neither
+// side ever waits for the other, and a value overwritten before it was taken is gone.
+template <typename T>
+class LatestSlot {
+   public:
+    // Producer side. True when this overwrote a value the consumer had not taken yet.
+    bool publish(const T& value) {
+        mBuffers[mBack] = value;
+        const uint8_t previous = mMiddle.exchange(mBack | FRESH, std::memory_order_acq_rel);
+        mBack = previous & INDEX_MASK;
+        return (previous & FRESH) != 0U;
+    }
+
+    // Consumer side. False when nothing new was published since the last take.
+    bool take(T& value) {
+        if ((mMiddle.load(std::memory_order_relaxed) & FRESH) == 0U) {
+            return false;
+        }
+        // Only the producer touches the middle in between, and it only ever makes it fresh
+        mFront = mMiddle.exchange(mFront, std::memory_order_acq_rel) & INDEX_MASK;
+        value = mBuffers[mFront];
+        return true;
+    }
+
+   private:
+    static constexpr uint8_t INDEX_MASK = 0x03U;
+    static constexpr uint8_t FRESH = 0x04U;
+
+    std::array<T, 3> mBuffers{};
+    uint8_t mBack = 0U;   // producer
+    uint8_t mFront = 1U;  // consumer
+    std::atomic<uint8_t> mMiddle{2U};
+};
+
+}  // namespace common
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace common {
+// Controller families differ in how pixel data is addressed. The SSD1306 takes a column and
+// page window and wraps inside it; the SH1106 only has page addressing, one page per write.
+enum class OledController : uint8_t { Ssd1306, Sh1106 };
+
+// Compile-time description of a page-organised monochrome OLED. Everything the renderer and
+// the driver need is a constant, so geometry math folds away and one build carries no
+// runtime switches between panels.
+template <OledController CTRL, uint8_t WIDTH_PX, uint8_t HEIGHT_PX, uint8_t COLUMN_OFFSET_PX,
+          uint8_t COM_PINS_CFG>
+struct OledPanel {
+    static constexpr OledController CONTROLLER = CTRL;
+
+    static constexpr uint8_t WIDTH = WIDTH_PX;  // visible pixels
+    static constexpr uint8_t HEIGHT = HEIGHT_PX;
+    static constexpr uint8_t PAGE_HEIGHT = 8U;
+    static constexpr uint8_t PAGES = HEIGHT / PAGE_HEIGHT;
+    static constexpr size_t FRAME_SIZE = static_cast<size_t>(WIDTH) * PAGES;  // bytes
+
+    // Display RAM is 64 rows on both controllers whatever the glass shows; the start line
+    // rotates through all of it
+    static constexpr uint8_t RAM_PAGES = 8U;
+    // First RAM column wired to the glass: the SH1106 drives 132 columns for 128 pixels
+    static constexpr uint8_t COLUMN_OFFSET = COLUMN_OFFSET_PX;
+    static constexpr uint8_t RAM_WIDTH = WIDTH + 2U * COLUMN_OFFSET;
+
+    static constexpr uint8_t MULTIPLEX = HEIGHT - 1U;  // 0xA8 argument
+    static constexpr uint8_t COM_PINS = COM_PINS_CFG;  // 0xDA argument
+
+    static_assert(HEIGHT % PAGE_HEIGHT == 0U, "Panel height must be whole pages");
+    static_assert(PAGES <= RAM_PAGES, "Panel taller than display RAM");
+};
+
+using Ssd1306Panel128x64 = OledPanel<OledController::Ssd1306, 128U, 64U, 0U, 0x12U>;
+using Ssd1306Panel128x32 = OledPanel<OledController::Ssd1306, 128U, 32U, 0U, 0x02U>;
+using Sh1106Panel128x64 = OledPanel<OledController::Sh1106, 128U, 64U, 2U, 0x12U>;
+
+}  // namespace common
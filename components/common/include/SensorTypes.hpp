@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace common {
+
+// Fixed-point so the UI can format it without pulling in float printf
+struct ClimateReading {
+    int16_t temperatureCentiC = 0;  // e.g. 2315 == 23.15 C
+    uint16_t humidityCentiPct = 0;  // e.g. 4512 == 45.12 %RH
+    uint64_t timestampUs = 0U;
+};
+
+}  // namespace common
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace common {
+// Lock-free single-producer/single-consumer ring, safe to push from an ISR.
+// One slot stays empty to tell full from empty.
+template <typename T, size_t N>
+class SpscQueue {
+    static_assert(N >= 2U && (N & (N - 1U)) == 0U, "Queue size must be a power of two");
+
+   public:
+    bool push(const T& item) {
+        const size_t head = mHead.load(std::memory_order_relaxed);
+        const size_t next = (head + 1U) & (N - 1U);
+
+        if (next == mTail.load(std::memory_order_acquire)) {
+            return false;  // full
+        }
+
+        mItems[head] = item;
+        mHead.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        const size_t tail = mTail.load(std::memory_order_relaxed);
+
+        if (tail == mHead.load(std::memory_order_acquire)) {
+            return false;  // empty
+        }
+
+        item = mItems[tail];
+        mTail.store((tail + 1U) & (N - 1U), std::memory_order_release);
+        return true;
+    }
+
+    size_t size() const {
+        const size_t head = mHead.load(std::memory_order_acquire);
+        const size_t tail = mTail.load(std::memory_order_acquire);
+        return (head - tail) & (N - 1U);
+    }
+
+    bool empty() const {
+        return size() == 0U;
+    }
+
+    static constexpr size_t capacity() {
+        return N - 1U;
+    }
+
+   private:
+    std::array<T, N> mItems{};
+    std::atomic<size_t> mHead{0U};
+    std::atomic<size_t> mTail{0U};
+};
+
+}  // namespace common
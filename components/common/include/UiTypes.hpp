@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <string>
 
+#include "SensorTypes.hpp"
+
 // TODO: Split to UI-related types and core application model types
 
 namespace common {
@@ -17,20 +19,6 @@ struct StationData {
     std::string url;   // streaming URL
 };
 
-struct AppModel {
-    int selectedStationIndex;
-    // TODO: Add other runtime state here (playback status, volume, etc.)
-};
-
-struct UiEvent {
-    enum class Type { RENDER_STATIONS, RENDER_STATUS, RENDER_BOOT };
-
-    Type type;
-    int selectedIndex = 0;  // Current selection for RENDER_STATIONS
-
-    // TODO: union? variants? for other event data
-};
-
 // TODO: correct the status kinds
 enum class UiStatusKind : uint8_t {
     Booting,
@@ -42,10 +30,57 @@ enum class UiStatusKind : uint8_t {
     Error
 };
 
+enum class PlaybackState : uint8_t { Stopped, Playing, Paused };
+
+// Everything the status bar shows. Plain data so it can travel in a UiEvent
 struct UiStatus {
+    static constexpr uint8_t NO_BATTERY = 0xFF;
+
     UiStatusKind kind{UiStatusKind::Booting};
-    std::string line1;
-    std::string line2;
+    int8_t rssiDbm = 0;  // of the access point, meaningful while connected
+    PlaybackState playback = PlaybackState::Stopped;
+    uint8_t batteryPct = NO_BATTERY;  // 0..100, NO_BATTERY when mains powered
+};
+
+// Spectrum bars, low to high frequencies, each 0..255
+static constexpr size_t SPECTRUM_BARS = 16U;
+using SpectrumLevels = std::array<uint8_t, SPECTRUM_BARS>;
+
+struct AppModel {
+    int selectedStationIndex = 0;
+    int volume = 50;  // 0..100, FR-07 default
+    bool playing = false;
+    UiStatus status;  // as last posted to the status bar
+    bool hasClimate = false;
+    ClimateReading climate;
+    SpectrumLevels spectrum{};  // as last posted, all zero while stopped
+    // TODO: Add other runtime state here
+};
+
+// One row of text on the 128 px panel plus the terminator
+static constexpr size_t UI_TEXT_SIZE = 22U;
+
+struct UiEvent {
+    enum class Type {
+        RENDER_STATIONS,
+        RENDER_STATUS,
+        RENDER_BOOT,
+        RENDER_VOLUME,
+        RENDER_CLIMATE,
+        SHOW_TOAST,
+        RENDER_SPECTRUM
+    };
+
+    Type type;
+    int selectedIndex = 0;                  // Current selection for RENDER_STATIONS
+    int volume = 0;                         // 0..100 for RENDER_VOLUME
+    UiStatus status;                        // for RENDER_STATUS
+    int16_t temperatureCentiC = 0;          // for RENDER_CLIMATE
+    std::array<char, UI_TEXT_SIZE> text{};  // NUL-terminated, for SHOW_TOAST
+    SpectrumLevels spectrum{};              // for RENDER_SPECTRUM
+    int64_t postedUs = 0;                   // set by the UI queue, 0 when called directly
+
+    // TODO: union? variants? for other event data
 };
 
 // Custom icons (indices 0-31)
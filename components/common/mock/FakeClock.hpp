@@ -0,0 +1,24 @@
+#pragma once
+
+#include "IClock.hpp"
+
+namespace common {
+class FakeClock : public IClock {
+   public:
+    uint64_t nowUs() const override {
+        return mNowUs;
+    }
+
+    void setUs(const uint64_t& nowUs) {
+        mNowUs = nowUs;
+    }
+
+    void advanceUs(const uint64_t& deltaUs) {
+        mNowUs += deltaUs;
+    }
+
+   private:
+    uint64_t mNowUs = 0U;
+};
+
+}  // namespace common
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "IKeyValueStore.hpp"
+
+namespace common {
+class FakeKeyValueStore : public IKeyValueStore {
+   public:
+    size_t load(const char* key, void* data, const size_t& capacity) override {
+        const auto entry = mEntries.find(key);
+        if (entry == mEntries.end() || entry->second.size() > capacity) {
+            return 0U;
+        }
+        std::copy(entry->second.begin(), entry->second.end(), static_cast<uint8_t*>(data));
+        return entry->second.size();
+    }
+
+    bool save(const char* key, const void* data, const size_t& len) override {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        mEntries[key].assign(bytes, bytes + len);
+        ++mWrites;
+        return true;
+    }
+
+    bool erase(const char* key) override {
+        return mEntries.erase(key) > 0U;
+    }
+
+    size_t size() const {
+        return mEntries.size();
+    }
+
+    int writes() const {
+        return mWrites;
+    }
+
+   private:
+    std::map<std::string, std::vector<uint8_t>> mEntries;
+    int mWrites = 0;
+};
+
+}  // namespace common
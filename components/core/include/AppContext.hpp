@@ -2,32 +2,128 @@
 
 // Core
 #include "AppController.hpp"
+#include "AutoplayOrchestrator.hpp"
+#include "AutoplayTask.hpp"
+#include "BootSequencer.hpp"
+#include "ClimateTask.hpp"
+#include "FlushTask.hpp"
+#include "FreeRtosStageExecutor.hpp"
+#include "InputTask.hpp"
+#include "PlayerTasks.hpp"
+#include "SpectrumTask.hpp"
+#include "SystemMonitor.hpp"
 #include "UiTask.hpp"
+#include "WifiTask.hpp"
 
 // Adapters
+#include "Aht20Sensor.hpp"
+#include "EspClock.hpp"
+#include "EspConsole.hpp"
 #include "EspI2cBus.hpp"
-#include "OledSsd1306Display.hpp"
+#include "GpioInputDriver.hpp"
+#include "I2cScheduler.hpp"
+#include "NvsStore.hpp"
+#include "OledDisplay.hpp"
+
+// Memory
+#include "Memory.hpp"
+
+// Net
+#include "DnsCache.hpp"
+#include "EspWifiDriver.hpp"
+#include "SystemDnsResolver.hpp"
+#include "TlsSessionCache.hpp"
+#include "WifiManager.hpp"
+
+// Player
+#include "BufferTuner.hpp"
+#include "ByteRing.hpp"
+#include "EspHttpTransport.hpp"
+#include "HttpSource.hpp"
+#include "I2sSink.hpp"
+#include "PlayerPipeline.hpp"
+#include "RedirectCache.hpp"
+#include "Resampler.hpp"
+#include "SpectrumAnalyzer.hpp"
+#include "SpectrumTap.hpp"
+#include "WavDecoder.hpp"
 
 // Services
+#include "InputService.hpp"
 #include "StationRepository.hpp"
 #include "UiService.hpp"
 
 // Standard
 #include <memory>
 
+// IDF
+#include <sdkconfig.h>
+
 namespace core {
 class AppContext {
    public:
     AppContext();
     bool init();
 
+    // Periodic health report on the serial log
+    void logHealthSummary();
+
    private:
+    bool initConsole();
+    bool initStorage();
+    bool initPlayer();
+    bool watchTasks();
+
+    std::unique_ptr<adapters::EspClock> mClock;
+    std::unique_ptr<adapters::EspConsole> mConsole;
     std::unique_ptr<adapters::EspI2cBus> mI2cBus;
-    std::unique_ptr<adapters::OledSsd1306Display> mOledDisplay;
+    std::unique_ptr<adapters::I2cScheduler> mI2cScheduler;
+    std::unique_ptr<adapters::BoardOledDisplay> mOledDisplay;
     std::unique_ptr<services::StationRepository> mStationRepository;
     std::unique_ptr<services::UiService> mUiService;
+    std::unique_ptr<FlushTask> mFlushTask;
     std::unique_ptr<UiTask> mUiTask;
     std::unique_ptr<AppController> mAppController;
+    std::unique_ptr<adapters::GpioInputDriver> mInputDriver;
+    std::unique_ptr<services::InputService> mInputService;
+    std::unique_ptr<InputTask> mInputTask;
+    std::unique_ptr<adapters::Aht20Sensor> mClimateSensor;
+    std::unique_ptr<ClimateTask> mClimateTask;
+    memory::Buffer<uint8_t, memory::MemoryClass::Psram> mAudioRingStorage;
+    std::unique_ptr<player::ByteRing> mAudioRing;
+    memory::Buffer<uint8_t, memory::MemoryClass::Psram> mStandbyRingStorage;
+    std::unique_ptr<player::ByteRing> mStandbyRing;
+    std::unique_ptr<adapters::NvsStore> mRedirectStore;
+    std::unique_ptr<player::RedirectCache> mRedirectCache;
+    std::unique_ptr<net::SystemDnsResolver> mDnsResolver;
+    std::unique_ptr<net::DnsCache> mDnsCache;
+    std::unique_ptr<net::TlsSessionCache> mTlsSessions;
+    std::unique_ptr<player::EspHttpTransport> mHttpTransport;
+    std::unique_ptr<player::HttpSource> mAudioSource;
+    std::unique_ptr<player::EspHttpTransport> mStandbyTransport;
+    std::unique_ptr<player::HttpSource> mStandbySource;
+    std::unique_ptr<player::WavDecoder> mAudioDecoder;
+    std::unique_ptr<player::I2sSink> mAudioSink;
+    std::unique_ptr<player::Resampler> mResampler;
+    std::unique_ptr<player::BufferTuner> mBufferTuner;
+    std::unique_ptr<player::PlayerPipeline> mPlayerPipeline;
+    std::unique_ptr<PlayerTasks> mPlayerTasks;
+#ifdef CONFIG_PLAYER_SPECTRUM_ENABLE
+    std::unique_ptr<player::SpectrumTap> mSpectrumTap;
+    std::unique_ptr<player::SpectrumAnalyzer> mSpectrumAnalyzer;
+    std::unique_ptr<SpectrumTask> mSpectrumTask;
+#endif
+    std::unique_ptr<adapters::NvsStore> mSettingsStore;
+    std::unique_ptr<AutoplayOrchestrator> mAutoplay;
+    std::unique_ptr<AutoplayTask> mAutoplayTask;
+    std::unique_ptr<adapters::NvsStore> mWifiStore;
+    std::unique_ptr<net::EspWifiDriver> mWifiDriver;
+    std::unique_ptr<net::WifiManager> mWifiManager;
+    std::unique_ptr<WifiTask> mWifiTask;
+
+    std::unique_ptr<FreeRtosStageExecutor> mStageExecutor;
+    std::unique_ptr<BootSequencer> mBootSequencer;
+    std::unique_ptr<SystemMonitor> mSystemMonitor;
 };
 
 }  // namespace core
@@ -1,15 +1,92 @@
 #pragma once
 
+#include <mutex>
+
+#include "IInputSink.hpp"
+#include "IWifiListener.hpp"
+#include "SensorTypes.hpp"
+#include "UiTypes.hpp"
+
+namespace common {
+class IKeyValueStore;
+}  // namespace common
+
+namespace player {
+class IPlayerControl;
+}  // namespace player
+
+namespace services {
+class IStationRepository;
+}  // namespace services
+
 namespace core {
 class IUiSink;
 
-class AppController {
+// Entered from several tasks (input, climate and more), each of which may preempt another.
+// Every public method holds mMutex for its whole run, model update and the posts it makes
+// included, so the model has one writer at a time and the UI and the player receive the
+// changes in the order they were made. Nothing called under the lock calls back in here.
+// Spectrum frames and the settings write are the exceptions: both leave the lock first.
+class AppController final : public IInputSink, public net::IWifiListener {
    public:
-    AppController(IUiSink& uiSink);
+    // Id of the station last started, kept so the next boot can resume it
+    static constexpr const char* LAST_STATION_KEY = "last_station";
+    // How long a started station must stay selected before it is written to flash
+    static constexpr int64_t STATION_SAVE_DELAY_US = 5000000;
+
+    AppController(IUiSink& uiSink, services::IStationRepository& stationRepo);
     bool init();
 
+    // Optional; without a player the controller only drives the UI
+    void setPlayer(player::IPlayerControl* player);
+    // Optional; without settings the last station is not remembered
+    void setSettings(common::IKeyValueStore* settings);
+
+    // Starts the station at index as if the user had selected it and pressed Play. Refused
+    // when something already plays, so a user who was quicker is not overridden; the check
+    // and the start happen under one lock, so a key press cannot slip in between.
+    bool autoplay(const int& index);
+
+    // IInputSink, called from the input task
+    void onInput(const common::InputEvent& e) override;
+
+    // Called from the climate task with each new sensor reading
+    void onClimate(const common::ClimateReading& reading);
+
+    // Called from the spectrum task with each analysed frame; only shown while playing. The
+    // frame is posted after the lock is released, so it may land just behind a stop; the UI
+    // ignores frames that arrive while it shows playback stopped.
+    void onSpectrum(const common::SpectrumLevels& levels);
+
+    // net::IWifiListener, called from the Wi-Fi task
+    void onWifiStatus(const common::UiStatusKind& kind, const int8_t& rssiDbm) override;
+
+    // Called periodically from a low-priority task. Writes the station last started once it
+    // has stayed selected for STATION_SAVE_DELAY_US, so scrolling through the list while
+    // playing costs one flash write rather than one per step. The write happens outside
+    // mMutex; only the handover of the station is locked.
+    void saveSettings(const int64_t& nowUs);
+
+    // A copy, the model keeps changing under other tasks
+    common::AppModel getModel() const;
+
    private:
+    // Called with mMutex held
+    void selectStation(const int& delta);
+    void changeVolume(const int& steps);
+    void togglePlayback();
+    void postStatus();
+    void postStations();
+    void rememberStation();
+
     IUiSink& mUiSink;
+    services::IStationRepository& mStationRepo;
+    player::IPlayerControl* mPlayer;
+    common::IKeyValueStore* mSettings;
+    mutable std::mutex mMutex;
+    common::AppModel mModel;
+    int mStationToSave;  // index, -1 when nothing waits for saveSettings
+    int64_t mStationSaveAtUs;
 };
 
 }  // namespace core
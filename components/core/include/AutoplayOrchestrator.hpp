@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+#include "IWifiListener.hpp"
+#include "UiTypes.hpp"
+
+namespace common {
+class IClock;
+class IKeyValueStore;
+}  // namespace common
+
+namespace player {
+class IPlaybackStatus;
+class IStreamPreopener;
+}  // namespace player
+
+namespace services {
+class IStationRepository;
+}  // namespace services
+
+namespace core {
+class AppController;
+
+// Gets the last station playing as early as boot allows. The Wi-Fi manager is started first
+// and reports through here; meanwhile the station id saved by the controller is matched
+// against the list, and as soon as an IP is assigned the stream is pre-opened so the
+// connection, handshake and redirects overlap the rest of boot. Playback starts once the
+// player is up, through the controller, so the UI sees it like a Play press. Boot stages
+// report progress with the on*() hooks from any task; poll() runs on its own task and
+// never blocks them. Wi-Fi status is held back until the controller can show it.
+class AutoplayOrchestrator final : public net::IWifiListener {
+   public:
+    enum class State : uint8_t {
+        Resolving,          // waiting for settings and the station list
+        WaitingForNetwork,  // station known, no IP yet
+        WaitingForPlayer,   // online, waiting for the player and the controller
+        WaitingForAudio,    // started, waiting for the first sample at the output
+        Done
+    };
+
+    static constexpr uint32_t POLL_MS = 20U;
+    // Past this without a sample the stream is given up on, the user can still press Play
+    static constexpr uint64_t FIRST_AUDIO_TIMEOUT_US = 60000000U;
+
+    AutoplayOrchestrator(AppController &controller, services::IStationRepository &stationRepo,
+                         const common::IClock &clock, common::IKeyValueStore *settings,
+                         player::IStreamPreopener *preopener, net::IWifiListener *next);
+
+    // Boot stage hooks
+    void onSettingsLoaded();
+    void onStationsLoaded();
+    void onControllerReady();
+    void onPlayerReady(const player::IPlaybackStatus &playback);
+
+    // net::IWifiListener, called from the Wi-Fi task
+    void onWifiStatus(const common::UiStatusKind &kind, const int8_t &rssiDbm) override;
+
+    // Runs the step that is due and returns the milliseconds until the next poll
+    uint32_t poll();
+
+    State getState() const;
+    // Microseconds since boot of the first sample played by autoplay, 0 until then
+    uint64_t getFirstAudioUs() const;
+
+   private:
+    void resolveStation();
+    void logTimeline() const;
+
+    AppController &mController;
+    services::IStationRepository &mStationRepo;
+    const common::IClock &mClock;
+    common::IKeyValueStore *mSettings;
+    player::IStreamPreopener *mPreopener;
+    net::IWifiListener *mNext;
+
+    mutable std::mutex mMutex;
+    bool mSettingsLoaded;
+    bool mStationsLoaded;
+    bool mControllerReady;
+    const player::IPlaybackStatus *mPlayback;
+    bool mOnline;
+    bool mHeldStatus;  // a status arrived before the controller could show it
+    common::UiStatusKind mHeldKind;
+    int8_t mHeldRssiDbm;
+
+    State mState;
+    int mStationIndex;
+    std::array<char, 64> mStationId;
+    uint64_t mResolvedUs;
+    uint64_t mOnlineUs;
+    uint64_t mPreopenedUs;
+    uint64_t mStartedUs;
+    uint64_t mFirstAudioUs;
+};
+
+}  // namespace core
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+// IDF
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace core {
+class AutoplayOrchestrator;
+
+// Short-lived task stepping the autoplay orchestrator; it deletes itself once the last
+// station plays or turned out not to be resumable
+class AutoplayTask {
+   public:
+    explicit AutoplayTask(AutoplayOrchestrator &orchestrator);
+    bool init();
+
+    void runLoop();
+    static void taskEntry(void *pvParameters);
+
+   private:
+    AutoplayOrchestrator &mOrchestrator;
+    TaskHandle_t mTaskHandle;
+};
+
+}  // namespace core
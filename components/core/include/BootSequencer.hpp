@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "IStageExecutor.hpp"
+
+namespace common {
+class IClock;
+}  // namespace common
+
+namespace core {
+enum class StageState : uint8_t { Pending, Running, Done, Failed, Skipped };
+
+struct BootStage {
+    const char* name = "";
+    std::function<bool()> action;
+    uint32_t dependsOn = 0U;  // bitmask of StageId, see BootSequencer::after()
+    uint8_t flags = 0U;
+
+    StageState state = StageState::Pending;
+    uint64_t startUs = 0U;
+    uint64_t endUs = 0U;
+};
+
+// Declarative boot: stages are added with their dependencies and run as soon as all of
+// them are done, so independent stages overlap. Every stage is timestamped and the
+// resulting timeline is logged at the end.
+class BootSequencer {
+   public:
+    static constexpr size_t MAX_STAGES = 24U;  // the app declares 16, leave room to grow
+    static constexpr StageId INVALID_STAGE = 0xFFU;
+
+    static constexpr uint8_t FLAG_FIRST_FRAME = 1U << 0U;  // first frame is on the panel
+    static constexpr uint8_t FLAG_USABLE_UI = 1U << 1U;    // station list is usable
+
+    BootSequencer(IStageExecutor& executor, const common::IClock& clock);
+
+    // Dependencies must be already added stages, which keeps the graph acyclic. Returns
+    // INVALID_STAGE when the stage is rejected; run() then refuses to boot a partial graph.
+    StageId addStage(const char* name, std::function<bool()> action, uint32_t dependsOn = 0U,
+                     uint8_t flags = 0U);
+    bool run();
+    void logTimeline() const;
+
+    // A rejected stage turns into a dependency no stage can satisfy, so its dependants are
+    // rejected as well instead of running without it
+    static constexpr uint32_t after(const StageId& id) {
+        return (id < MAX_STAGES) ? (1U << id) : UNKNOWN_DEPENDENCY;
+    }
+
+    size_t getStageCount() const;
+    const BootStage& getStage(const StageId& id) const;
+    uint64_t getBootStartUs() const;
+    uint64_t getBootEndUs() const;
+    // 0 when no stage with the flag has completed
+    uint64_t getMilestoneUs(const uint8_t& flag) const;
+
+   private:
+    static_assert(MAX_STAGES < 32U, "Stage masks are 32 bits wide, one bit stays reserved");
+    static constexpr uint32_t UNKNOWN_DEPENDENCY = 1U << 31U;
+
+    size_t launchReadyStages();
+    void finishStage(const StageId& id, const bool& ok);
+
+    IStageExecutor& mExecutor;
+    const common::IClock& mClock;
+
+    std::array<BootStage, MAX_STAGES> mStages;
+    size_t mStageCount;
+    size_t mRejectedCount;
+    uint32_t mDoneMask;
+    uint32_t mBrokenMask;  // failed or skipped
+    uint64_t mBootStartUs;
+    uint64_t mBootEndUs;
+};
+
+}  // namespace core
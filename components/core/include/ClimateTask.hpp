@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+// IDF
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace adapters {
+class Aht20Sensor;
+}  // namespace adapters
+
+namespace core {
+class AppController;
+
+// Low-priority task stepping the AHT20 state machine; it sleeps between steps instead of
+// blocking on the conversion. Each step also lets the controller save its settings.
+class ClimateTask {
+   public:
+    ClimateTask(adapters::Aht20Sensor &sensor, AppController &controller);
+    bool init();
+
+    void runLoop();
+    static void taskEntry(void *pvParameters);
+
+    TaskHandle_t getTaskHandle() const;
+
+   private:
+    adapters::Aht20Sensor &mSensor;
+    AppController &mController;
+    TaskHandle_t mTaskHandle;
+};
+
+}  // namespace core
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+#include "IFrameListener.hpp"
+
+// IDF
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace services {
+class UiService;
+}  // namespace services
+
+namespace core {
+// Sends published frames to the display so UiTask can render the next one meanwhile
+class FlushTask final : public services::IFrameListener {
+   public:
+    explicit FlushTask(services::UiService &ui);
+    bool init();
+
+    // IFrameListener, called from UiTask
+    void onFrameReady() override;
+
+    void runLoop();
+    static void taskEntry(void *pvParameters);
+
+    TaskHandle_t getTaskHandle() const;
+
+   private:
+    services::UiService &mUiService;
+    TaskHandle_t mTaskHandle;
+};
+
+}  // namespace core
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+
+#include "BootSequencer.hpp"
+#include "IStageExecutor.hpp"
+
+// IDF
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+namespace core {
+// Runs each boot stage in its own short-lived FreeRTOS task
+class FreeRtosStageExecutor final : public IStageExecutor {
+   public:
+    FreeRtosStageExecutor();
+    ~FreeRtosStageExecutor() override;
+
+    bool init();
+
+    // IStageExecutor
+    bool launch(const StageId &id, BootStage &stage) override;
+    bool waitForCompletion(StageId &id, bool &ok) override;
+
+   private:
+    struct StageContext {
+        FreeRtosStageExecutor *executor;
+        BootStage *stage;
+        StageId id;
+    };
+
+    struct Completion {
+        StageId id;
+        bool ok;
+    };
+
+    static void stageEntry(void *pvParameters);
+
+    QueueHandle_t mCompletionQueue;
+    std::array<StageContext, BootSequencer::MAX_STAGES> mContexts;
+};
+
+}  // namespace core
@@ -0,0 +1,15 @@
+#pragma once
+
+namespace common {
+struct InputEvent;
+}  // namespace common
+
+namespace core {
+class IInputSink {
+   public:
+    virtual ~IInputSink() = default;
+
+    virtual void onInput(const common::InputEvent &e) = 0;
+};
+
+}  // namespace core
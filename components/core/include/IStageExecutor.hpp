@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+namespace core {
+struct BootStage;
+
+using StageId = uint8_t;
+
+// Runs boot stages, possibly concurrently. BootSequencer drives it from a single task:
+// it launches every stage whose dependencies are met and then waits for completions.
+class IStageExecutor {
+   public:
+    virtual ~IStageExecutor() = default;
+
+    virtual bool launch(const StageId& id, BootStage& stage) = 0;
+    // Blocks until any launched stage finishes
+    virtual bool waitForCompletion(StageId& id, bool& ok) = 0;
+};
+
+}  // namespace core
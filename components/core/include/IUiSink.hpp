@@ -10,6 +10,9 @@ class IUiSink {
     virtual ~IUiSink() = default;
 
     virtual void post(const common::UiEvent &e) = 0;
+    // For events the next one replaces anyway, such as spectrum frames: never blocks, and
+    // returns false when the event was dropped because the queue is full
+    virtual bool tryPost(const common::UiEvent &e) = 0;
 };
 
 }  // namespace core
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+// IDF
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace adapters {
+class GpioInputDriver;
+}  // namespace adapters
+
+namespace services {
+class InputService;
+}  // namespace services
+
+namespace core {
+// Sleeps until the GPIO ISR notifies it, then drains and decodes the captured edges
+class InputTask {
+   public:
+    InputTask(adapters::GpioInputDriver &driver, services::InputService &input);
+    bool init();
+
+    void runLoop();
+    static void taskEntry(void *pvParameters);
+
+    TaskHandle_t getTaskHandle() const;
+
+   private:
+    adapters::GpioInputDriver &mDriver;
+    services::InputService &mInputService;
+    TaskHandle_t mTaskHandle;
+};
+
+}  // namespace core
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+#include "IPipelineListener.hpp"
+
+// IDF
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace player {
+class PlayerPipeline;
+}  // namespace player
+
+namespace core {
+// Steps the two sides of the player pipeline on their own cores: the source next to the
+// Wi-Fi and lwIP tasks on core 0, the decoder and I2S on core 1, away from network bursts.
+// With a standby stream a third task, below the source one, opens switch targets.
+class PlayerTasks final : public player::IPipelineListener {
+   public:
+    explicit PlayerTasks(player::PlayerPipeline &pipeline, const bool &standby = false);
+    bool init();
+
+    // IPipelineListener, called from either side and from the controller
+    void onCommandPosted() override;
+    void onDataAvailable() override;
+    void onSpaceAvailable() override;
+    void onStandbyRequested() override;
+
+    TaskHandle_t getSourceTaskHandle() const;
+    TaskHandle_t getDecodeTaskHandle() const;
+
+   private:
+    static void sourceTaskEntry(void *pvParameters);
+    static void decodeTaskEntry(void *pvParameters);
+    static void standbyTaskEntry(void *pvParameters);
+    void runSourceLoop();
+    void runDecodeLoop();
+    void runStandbyLoop();
+
+    player::PlayerPipeline &mPipeline;
+    bool mStandby;
+    TaskHandle_t mSourceTask;
+    TaskHandle_t mDecodeTask;
+    TaskHandle_t mStandbyTask;
+};
+
+}  // namespace core
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+// IDF
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace player {
+class SpectrumAnalyzer;
+}  // namespace player
+
+namespace core {
+class AppController;
+
+// Low-priority task analysing one spectrum frame per period, at most
+// CONFIG_PLAYER_SPECTRUM_FPS a second. It only preempts the idle work, never the decoder,
+// and backs off to a slow poll while nothing plays.
+class SpectrumTask {
+   public:
+    SpectrumTask(player::SpectrumAnalyzer &analyzer, AppController &controller);
+    bool init();
+
+    void runLoop();
+    static void taskEntry(void *pvParameters);
+
+    TaskHandle_t getTaskHandle() const;
+
+   private:
+    player::SpectrumAnalyzer &mAnalyzer;
+    AppController &mController;
+    TaskHandle_t mTaskHandle;
+};
+
+}  // namespace core
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Metrics.hpp"
+
+// IDF
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace common {
+class IClock;
+}  // namespace common
+
+namespace core {
+// Samples system-wide health (heap and memory classes, task stacks and CPU load, I2C
+// throughput) into metrics gauges. CPU load needs CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS; wakeups are counted by
+// the tasks themselves ("<task>.wakeups")
+class SystemMonitor {
+   public:
+    static constexpr size_t MAX_TASKS = 8U;
+
+    explicit SystemMonitor(const common::IClock &clock);
+
+    // Gauge names must outlive the monitor, e.g. string literals. CPU load is in permille
+    // of one core over the last sample period. False when either gauge could not register.
+    bool watchTask(const char *stackGauge, const char *cpuGauge, TaskHandle_t handle);
+    void sample();
+
+   private:
+    struct WatchedTask {
+        TaskHandle_t handle = nullptr;
+        metrics::Gauge stackFree;
+        metrics::Gauge cpuPermille;
+        uint32_t lastRunTimeUs = 0U;
+    };
+
+    const common::IClock &mClock;
+    std::array<WatchedTask, MAX_TASKS> mTasks;
+    size_t mTaskCount;
+
+    uint64_t mLastSampleUs;
+    uint32_t mLastI2cBytes;
+};
+
+}  // namespace core
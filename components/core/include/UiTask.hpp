@@ -25,12 +25,21 @@ class UiTask final : public IUiSink {
 
     // IUiSink
     void post(const common::UiEvent &e) override;
+    bool tryPost(const common::UiEvent &e) override;
 
     void runLoop();
+    // One pass of the loop: wait up to `wait` for an event, render it, then run timed work
+    // that is due. Returns whether an event was handled.
+    bool processNext(const TickType_t &wait);
     static void taskEntry(void *pvParameters);
 
+    TaskHandle_t getTaskHandle() const;
+
    private:
+    bool send(const common::UiEvent &e, const TickType_t &wait);
+
     QueueHandle_t mUiQueue;
+    TaskHandle_t mTaskHandle;
     services::UiService &mUiService;
 };
 
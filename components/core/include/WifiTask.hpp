@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+// IDF
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace net {
+class WifiManager;
+}  // namespace net
+
+namespace core {
+// Low-priority task stepping the Wi-Fi state machine; it sleeps for whatever the manager
+// asks, so a backoff costs nothing
+class WifiTask {
+   public:
+    explicit WifiTask(net::WifiManager &manager);
+    bool init();
+
+    void runLoop();
+    static void taskEntry(void *pvParameters);
+
+    TaskHandle_t getTaskHandle() const;
+
+   private:
+    net::WifiManager &mManager;
+    TaskHandle_t mTaskHandle;
+};
+
+}  // namespace core
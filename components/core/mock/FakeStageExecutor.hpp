@@ -0,0 +1,71 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "BootSequencer.hpp"
+#include "FakeClock.hpp"
+#include "IStageExecutor.hpp"
+
+namespace core {
+// Simulates concurrent stages on a fake clock: every launched stage runs its action right
+// away and completes after its configured duration
+class FakeStageExecutor : public IStageExecutor {
+   public:
+    explicit FakeStageExecutor(common::FakeClock &clock) : mClock(clock) {}
+
+    void setDurationUs(const std::string &name, const uint64_t &durationUs) {
+        mDurationsUs[name] = durationUs;
+    }
+
+    bool launch(const StageId &id, BootStage &stage) override {
+        const bool ok = stage.action ? stage.action() : true;
+        const uint64_t durationUs = mDurationsUs.count(stage.name) ? mDurationsUs[stage.name] : 0U;
+
+        mRunning.push_back({id, ok, mClock.nowUs() + durationUs});
+        if (mRunning.size() > mMaxConcurrent) {
+            mMaxConcurrent = mRunning.size();
+        }
+
+        return true;
+    }
+
+    bool waitForCompletion(StageId &id, bool &ok) override {
+        if (mRunning.empty()) {
+            return false;
+        }
+
+        auto first = mRunning.begin();
+        for (auto it = mRunning.begin(); it != mRunning.end(); ++it) {
+            if (it->finishUs < first->finishUs) {
+                first = it;
+            }
+        }
+
+        mClock.setUs(first->finishUs);
+        id = first->id;
+        ok = first->ok;
+        mRunning.erase(first);
+
+        return true;
+    }
+
+    size_t getMaxConcurrent() const {
+        return mMaxConcurrent;
+    }
+
+   private:
+    struct Running {
+        StageId id;
+        bool ok;
+        uint64_t finishUs;
+    };
+
+    common::FakeClock &mClock;
+    std::map<std::string, uint64_t> mDurationsUs;
+    std::vector<Running> mRunning;
+    size_t mMaxConcurrent = 0U;
+};
+
+}  // namespace core
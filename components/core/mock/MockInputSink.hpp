@@ -0,0 +1,14 @@
+#pragma once
+
+#include <gmock/gmock.h>
+
+#include "IInputSink.hpp"
+#include "InputTypes.hpp"
+
+namespace core {
+class MockInputSink : public IInputSink {
+   public:
+    MOCK_METHOD(void, onInput, (const common::InputEvent &), (override));
+};
+
+}  // namespace core
@@ -9,6 +9,7 @@ namespace core {
 class MockUiTask : public IUiSink {
    public:
     MOCK_METHOD(void, post, (const common::UiEvent &), (override));
+    MOCK_METHOD(bool, tryPost, (const common::UiEvent &), (override));
 };
 
 }  // namespace core
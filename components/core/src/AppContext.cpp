@@ -3,22 +3,257 @@
 // Common
 #include "BoardConfig.hpp"
 
+// Memory, Metrics & Trace
+#include "Memory.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+
+// IDF
+#include <esp_log.h>
+#include <sdkconfig.h>
+
 namespace core {
+static const char *TAG = "AppContext";
+
+// About 0.2 s of 44.1 kHz stereo PCM, more for compressed streams. It is touched a chunk at
+// a time, so it goes to PSRAM; everything created with make_unique below stays on the
+// default heap, which is internal RAM (CONFIG_SPIRAM_USE_CAPS_ALLOC), hot buffers included.
+static constexpr size_t AUDIO_RING_SIZE = 32768U;
+
 AppContext::AppContext()
-    : mI2cBus(std::make_unique<adapters::EspI2cBus>(common::I2C_PORT)),
-      mOledDisplay(std::make_unique<adapters::OledSsd1306Display>(*mI2cBus)),
+    : mClock(std::make_unique<adapters::EspClock>()),
+      mConsole(std::make_unique<adapters::EspConsole>()),
+      mI2cBus(std::make_unique<adapters::EspI2cBus>(common::I2C_PORT)),
+      mI2cScheduler(std::make_unique<adapters::I2cScheduler>(*mI2cBus)),
+      // The display outranks the sensor so redraws after input never queue behind it
+      mOledDisplay(std::make_unique<adapters::BoardOledDisplay>(
+          mI2cScheduler->client(adapters::I2cPriority::High))),
       mStationRepository(std::make_unique<services::StationRepository>()),
       mUiService(std::make_unique<services::UiService>(*mOledDisplay, *mStationRepository)),
+      mFlushTask(std::make_unique<FlushTask>(*mUiService)),
       mUiTask(std::make_unique<UiTask>(*mUiService)),
-      mAppController(std::make_unique<AppController>(*mUiTask)) {}
+      mAppController(std::make_unique<AppController>(*mUiTask, *mStationRepository)),
+      mInputDriver(std::make_unique<adapters::GpioInputDriver>()),
+      mInputService(std::make_unique<services::InputService>(*mAppController, *mClock)),
+      mInputTask(std::make_unique<InputTask>(*mInputDriver, *mInputService)),
+      mClimateSensor(std::make_unique<adapters::Aht20Sensor>(
+          mI2cScheduler->client(adapters::I2cPriority::Low), *mClock)),
+      mClimateTask(std::make_unique<ClimateTask>(*mClimateSensor, *mAppController)),
+      mAudioRingStorage(
+          memory::makeBuffer<uint8_t, memory::MemoryClass::Psram>(AUDIO_RING_SIZE)),
+      mAudioRing(std::make_unique<player::ByteRing>(mAudioRingStorage.get(), AUDIO_RING_SIZE)),
+      // Switches buffer the next station here while the current one keeps playing
+      mStandbyRingStorage(
+          memory::makeBuffer<uint8_t, memory::MemoryClass::Psram>(AUDIO_RING_SIZE)),
+      mStandbyRing(
+          std::make_unique<player::ByteRing>(mStandbyRingStorage.get(), AUDIO_RING_SIZE)),
+      mRedirectStore(std::make_unique<adapters::NvsStore>("redirects")),
+      mRedirectCache(std::make_unique<player::RedirectCache>(
+          player::RedirectCache::DEFAULT_TTL_US, mRedirectStore.get())),
+      mDnsResolver(std::make_unique<net::SystemDnsResolver>()),
+      mDnsCache(std::make_unique<net::DnsCache>(*mDnsResolver)),
+      // Shared by every HTTPS client of the device, keyed by origin
+      mTlsSessions(
+          std::make_unique<net::TlsSessionCache>(player::EspHttpTransport::releaseSession)),
+      mHttpTransport(std::make_unique<player::EspHttpTransport>(*mDnsCache, *mTlsSessions)),
+      mAudioSource(std::make_unique<player::HttpSource>(*mHttpTransport, mRedirectCache.get())),
+      // A transport holds one active response, so the standby source gets its own
+      mStandbyTransport(std::make_unique<player::EspHttpTransport>(*mDnsCache, *mTlsSessions)),
+      mStandbySource(
+          std::make_unique<player::HttpSource>(*mStandbyTransport, mRedirectCache.get())),
+      mAudioDecoder(std::make_unique<player::WavDecoder>()),
+      mAudioSink(std::make_unique<player::I2sSink>(common::I2S_PORT, common::I2S_BCLK_GPIO,
+                                                   common::I2S_WS_GPIO, common::I2S_DOUT_GPIO)),
+      mResampler(std::make_unique<player::Resampler>(common::I2S_SAMPLE_RATE_HZ)),
+      mBufferTuner(std::make_unique<player::BufferTuner>(player::BufferTuner::DEFAULT_BOUNDS,
+                                                         player::BufferTuner::DEFAULT_SETTINGS)),
+      mPlayerPipeline(std::make_unique<player::PlayerPipeline>(*mAudioSource, *mAudioDecoder,
+                                                               *mAudioSink, *mAudioRing)),
+      mPlayerTasks(std::make_unique<PlayerTasks>(*mPlayerPipeline,
+                                                 static_cast<bool>(mStandbyRingStorage))),
+#ifdef CONFIG_PLAYER_SPECTRUM_ENABLE
+      mSpectrumTap(std::make_unique<player::SpectrumTap>()),
+      mSpectrumAnalyzer(std::make_unique<player::SpectrumAnalyzer>(*mSpectrumTap)),
+      mSpectrumTask(std::make_unique<SpectrumTask>(*mSpectrumAnalyzer, *mAppController)),
+#endif
+      mSettingsStore(std::make_unique<adapters::NvsStore>("settings")),
+      // Wi-Fi status reaches the controller through autoplay, which holds it until the
+      // controller is up and pre-opens the last station as soon as there is an IP
+      mAutoplay(std::make_unique<AutoplayOrchestrator>(
+          *mAppController, *mStationRepository, *mClock, mSettingsStore.get(),
+          mAudioSource.get(), mAppController.get())),
+      mAutoplayTask(std::make_unique<AutoplayTask>(*mAutoplay)),
+      mWifiStore(std::make_unique<adapters::NvsStore>("wifi")),
+      mWifiDriver(std::make_unique<net::EspWifiDriver>(CONFIG_PLAYER_WIFI_SSID,
+                                                       CONFIG_PLAYER_WIFI_PASSWORD)),
+      mWifiManager(std::make_unique<net::WifiManager>(*mWifiDriver, *mClock, mWifiStore.get(),
+                                                      mAutoplay.get())),
+      mWifiTask(std::make_unique<WifiTask>(*mWifiManager)),
+      mStageExecutor(std::make_unique<FreeRtosStageExecutor>()),
+      mBootSequencer(std::make_unique<BootSequencer>(*mStageExecutor, *mClock)),
+      mSystemMonitor(std::make_unique<SystemMonitor>(*mClock)) {}
 
 bool AppContext::init() {
-    mI2cBus->init();
-    mOledDisplay->init();
-    mStationRepository->init();
-    mUiService->init();
-    mUiTask->init();
-    mAppController->init();
+    if (!mStageExecutor->init()) {
+        ESP_LOGE(TAG, "Failed to initialize boot stage executor");
+        return false;
+    }
+
+    // Display bring-up and station loading do not depend on each other and run in parallel
+    const StageId i2c = mBootSequencer->addStage("i2c", [this] { return mI2cBus->init(); });
+    const StageId display = mBootSequencer->addStage(
+        "display", [this] { return mOledDisplay->init(); }, BootSequencer::after(i2c));
+    const StageId stations = mBootSequencer->addStage("stations", [this] {
+        const bool ok = mStationRepository->init();
+        mAutoplay->onStationsLoaded();
+        return ok;
+    });
+    const StageId ui = mBootSequencer->addStage(
+        "ui", [this] { return mUiService->init(); }, BootSequencer::after(display),
+        BootSequencer::FLAG_FIRST_FRAME);
+    const StageId flushTask = mBootSequencer->addStage(
+        "flush_task", [this] { return mFlushTask->init(); }, BootSequencer::after(ui));
+    const StageId uiTask = mBootSequencer->addStage(
+        "ui_task", [this] { return mUiTask->init(); }, BootSequencer::after(flushTask));
+    const StageId controller = mBootSequencer->addStage(
+        "controller",
+        [this] {
+            const bool ok = mAppController->init();
+            mAutoplay->onControllerReady();
+            return ok;
+        },
+        BootSequencer::after(uiTask) | BootSequencer::after(stations),
+        BootSequencer::FLAG_USABLE_UI);
+    mBootSequencer->addStage(
+        "input", [this] { return mInputTask->init(); }, BootSequencer::after(controller));
+    mBootSequencer->addStage(
+        "climate", [this] { return mClimateTask->init(); }, BootSequencer::after(controller));
+    const StageId audio = mBootSequencer->addStage("audio", [this] { return mAudioSink->init(); });
+    const StageId nvs = mBootSequencer->addStage("nvs", [this] { return initStorage(); });
+    // The radio is the slowest thing to come up, so it starts as soon as NVS holds the last
+    // AP; autoplay works alongside the other stages and shows nothing before the controller
+    mBootSequencer->addStage(
+        "wifi", [this] { return mWifiManager->init() && mWifiTask->init(); },
+        BootSequencer::after(nvs));
+    mBootSequencer->addStage(
+        "autoplay", [this] { return mAutoplayTask->init(); }, BootSequencer::after(nvs));
+    const StageId player = mBootSequencer->addStage(
+        "player", [this] { return initPlayer(); },
+        BootSequencer::after(audio) | BootSequencer::after(nvs) |
+            BootSequencer::after(controller));
+#ifdef CONFIG_PLAYER_SPECTRUM_ENABLE
+    mBootSequencer->addStage(
+        "spectrum", [this] { return mSpectrumTask->init(); }, BootSequencer::after(player));
+#endif
+    mBootSequencer->addStage("console", [this] { return initConsole(); });
+
+    const bool ok = mBootSequencer->run();
+    mBootSequencer->logTimeline();
+
+    // A build whose metrics outgrow the registry must not boot looking healthy
+    if (!watchTasks()) {
+        ESP_LOGE(TAG, "Task metrics did not fit, raise metrics::Registry::MAX_GAUGES");
+        return false;
+    }
+
+    return ok;
+}
+
+bool AppContext::watchTasks() {
+    bool watched = true;
+    watched &= mSystemMonitor->watchTask("stack.main_free", "cpu.main_permille",
+                                         xTaskGetCurrentTaskHandle());
+    watched &= mSystemMonitor->watchTask("stack.ui_task_free", "cpu.ui_task_permille",
+                                         mUiTask->getTaskHandle());
+    watched &= mSystemMonitor->watchTask("stack.flush_free", "cpu.flush_permille",
+                                         mFlushTask->getTaskHandle());
+    watched &= mSystemMonitor->watchTask("stack.input_free", "cpu.input_permille",
+                                         mInputTask->getTaskHandle());
+    watched &= mSystemMonitor->watchTask("stack.climate_free", "cpu.climate_permille",
+                                         mClimateTask->getTaskHandle());
+    watched &= mSystemMonitor->watchTask("stack.wifi_free", "cpu.wifi_permille",
+                                         mWifiTask->getTaskHandle());
+    watched &= mSystemMonitor->watchTask("stack.player_source_free", "cpu.player_source_permille",
+                                         mPlayerTasks->getSourceTaskHandle());
+    watched &= mSystemMonitor->watchTask("stack.player_decode_free", "cpu.player_decode_permille",
+                                         mPlayerTasks->getDecodeTaskHandle());
+    return watched;
+}
+
+void AppContext::logHealthSummary() {
+    mSystemMonitor->sample();
+    metrics::Registry::instance().logSummary();
+    memory::logSummary();
+}
+
+bool AppContext::initStorage() {
+    // Only caches live in NVS so far; without it they just start empty after every boot
+    if (!mRedirectStore->init()) {
+        ESP_LOGW(TAG, "NVS unavailable, redirects are cached in RAM only");
+    }
+    if (!mWifiStore->init()) {
+        ESP_LOGW(TAG, "NVS unavailable, every boot scans for the access point");
+    }
+    if (!mSettingsStore->init()) {
+        ESP_LOGW(TAG, "NVS unavailable, the last station is not resumed");
+    }
+    mAutoplay->onSettingsLoaded();
+    return true;
+}
+
+bool AppContext::initPlayer() {
+    if (!mAudioRingStorage) {
+        ESP_LOGE(TAG, "No memory for the audio ring");
+        return false;
+    }
+    if (!mRedirectCache->init()) {
+        ESP_LOGW(TAG, "Redirect cache unavailable, every play resolves its URL");
+    }
+
+    mPlayerPipeline->setBufferTuning(mBufferTuner.get(), mAudioSink.get());
+    if (mStandbyRingStorage) {
+        mPlayerPipeline->setStandby(*mStandbySource, *mStandbyRing);
+    } else {
+        ESP_LOGW(TAG, "No memory for the standby ring, switches cut the audio");
+    }
+    if (!mPlayerPipeline->addPcmStage(*mResampler)) {
+        return false;
+    }
+#ifdef CONFIG_PLAYER_SPECTRUM_ENABLE
+    // After the resampler, so the bars see one rate; before the volume, so they do not
+    // shrink with it
+    if (!mPlayerPipeline->addPcmStage(*mSpectrumTap)) {
+        return false;
+    }
+#endif
+    if (!mPlayerTasks->init()) {
+        return false;
+    }
+
+    mAppController->setSettings(mSettingsStore.get());
+    mAppController->setPlayer(mPlayerPipeline.get());
+    mAutoplay->onPlayerReady(*mPlayerPipeline);
+    return true;
+}
+
+bool AppContext::initConsole() {
+    // The console is a debugging aid, a board without it still boots
+    if (!mConsole->init()) {
+        ESP_LOGW(TAG, "Console unavailable, continuing without it");
+        return true;
+    }
+
+    mConsole->registerCommand("metrics", "Metrics snapshot: metrics [reset]",
+                              [](int argc, char **argv) {
+                                  return metrics::Registry::instance().runCommand(argc, argv);
+                              });
+
+#ifdef CONFIG_PLAYER_TRACE_ENABLE
+    mConsole->registerCommand("trace", "Trace recorder: trace [dump|clear|on|off]",
+                              [](int argc, char **argv) {
+                                  return trace::TraceRecorder::instance().runCommand(argc, argv);
+                              });
+#endif
 
     return true;
 }
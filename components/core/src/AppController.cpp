@@ -1,25 +1,266 @@
 #include "AppController.hpp"
 
+#include <array>
+#include <cstdlib>
+#include <cstring>
+
+#include "IKeyValueStore.hpp"
+#include "IPlayerControl.hpp"
+#include "IStationRepository.hpp"
 #include "IUiSink.hpp"
-#include "UiTypes.hpp"
+#include "InputTypes.hpp"
 
 // IDF
 #include <esp_log.h>
+#include <esp_timer.h>
 
 namespace core {
 constexpr const char* TAG = "AppController";
 
-AppController::AppController(IUiSink& uiSink) : mUiSink(uiSink) {}
+static constexpr int VOLUME_STEP = 2;  // FR-05
+static constexpr int VOLUME_MIN = 0;
+static constexpr int VOLUME_MAX = 100;
+
+AppController::AppController(IUiSink& uiSink, services::IStationRepository& stationRepo)
+    : mUiSink(uiSink),
+      mStationRepo(stationRepo),
+      mPlayer(nullptr),
+      mSettings(nullptr),
+      mMutex(),
+      mModel(),
+      mStationToSave(-1),
+      mStationSaveAtUs(0) {}
 
 bool AppController::init() {
     ESP_LOGI(TAG, "Initializing AppController");
+    std::lock_guard<std::mutex> lock(mMutex);
 
     common::UiEvent event;
     event.type = common::UiEvent::Type::RENDER_STATIONS;
-    event.selectedIndex = 0;
+    event.selectedIndex = mModel.selectedStationIndex;
 
     mUiSink.post(event);
 
     return true;
 }
+
+void AppController::onInput(const common::InputEvent& e) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    switch (e.type) {
+        case common::InputEvent::Type::Up:
+            selectStation(-1);
+            break;
+        case common::InputEvent::Type::Down:
+            selectStation(1);
+            break;
+        case common::InputEvent::Type::PlayStop:
+            togglePlayback();
+            break;
+        case common::InputEvent::Type::Volume:
+            changeVolume(e.steps);
+            break;
+        default:
+            ESP_LOGW(TAG, "Unknown input event");
+            break;
+    }
+}
+
+void AppController::onClimate(const common::ClimateReading& reading) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    // The screen shows tenths of a degree, finer changes are not worth a repaint
+    const bool changed = !mModel.hasClimate || (mModel.climate.temperatureCentiC / 10) !=
+                                                   (reading.temperatureCentiC / 10);
+    mModel.climate = reading;
+    mModel.hasClimate = true;
+
+    ESP_LOGD(TAG, "Climate: %d.%02d C, %u.%02u %%RH", reading.temperatureCentiC / 100,
+             std::abs(reading.temperatureCentiC % 100), reading.humidityCentiPct / 100U,
+             reading.humidityCentiPct % 100U);
+
+    if (changed) {
+        common::UiEvent event;
+        event.type = common::UiEvent::Type::RENDER_CLIMATE;
+        event.temperatureCentiC = reading.temperatureCentiC;
+        mUiSink.post(event);
+    }
+}
+
+void AppController::onSpectrum(const common::SpectrumLevels& levels) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        // A frame where no bar moved is not worth a trip through the UI queue
+        if (!mModel.playing || levels == mModel.spectrum) {
+            return;
+        }
+        mModel.spectrum = levels;
+    }
+
+    // Posted outside the lock and without waiting: a full UI queue must not hold up input,
+    // and the next frame replaces a dropped one anyway
+    common::UiEvent event;
+    event.type = common::UiEvent::Type::RENDER_SPECTRUM;
+    event.spectrum = levels;
+    mUiSink.tryPost(event);
+}
+
+void AppController::onWifiStatus(const common::UiStatusKind& kind, const int8_t& rssiDbm) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    ESP_LOGI(TAG, "Wi-Fi status %u, RSSI %d dBm", static_cast<unsigned>(kind), rssiDbm);
+
+    mModel.status.kind = kind;
+    mModel.status.rssiDbm = rssiDbm;
+    postStatus();
+}
+
+void AppController::setPlayer(player::IPlayerControl* player) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPlayer = player;
+    if (mPlayer != nullptr) {
+        mPlayer->setVolume(mModel.volume);
+    }
+}
+
+void AppController::setSettings(common::IKeyValueStore* settings) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSettings = settings;
+}
+
+bool AppController::autoplay(const int& index) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    const int count = static_cast<int>(mStationRepo.getStations().size());
+    if (mModel.playing || mPlayer == nullptr || index < 0 || index >= count) {
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Autoplay station %d", index);
+    mModel.selectedStationIndex = index;
+    postStations();
+    togglePlayback();
+    return true;
+}
+
+common::AppModel AppController::getModel() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mModel;
+}
+
+void AppController::selectStation(const int& delta) {
+    const int count = static_cast<int>(mStationRepo.getStations().size());
+    if (count == 0) {
+        return;
+    }
+
+    // Selection wraps at list boundaries (FR-04)
+    mModel.selectedStationIndex = (mModel.selectedStationIndex + delta + count) % count;
+    postStations();
+
+    // While playing, the selection is what plays; the player keeps the current station on
+    // until the new one is buffered, so scrolling past stations costs no silence
+    if (mModel.playing && mPlayer != nullptr) {
+        const std::string& url = mStationRepo.getStations()[mModel.selectedStationIndex].url;
+        if (mPlayer->switchTo(url.c_str())) {
+            rememberStation();
+        } else {
+            // Better silence than the old station under the new selection
+            ESP_LOGW(TAG, "Player refused station %d", mModel.selectedStationIndex);
+            togglePlayback();
+        }
+    }
+}
+
+void AppController::togglePlayback() {
+    mModel.playing = !mModel.playing;
+    mModel.spectrum = {};
+    ESP_LOGI(TAG, "Play/Stop pressed, playing=%d", mModel.playing);
+
+    if (mPlayer != nullptr) {
+        const auto& stations = mStationRepo.getStations();
+        if (!mModel.playing) {
+            mPlayer->stop();
+        } else if (mModel.selectedStationIndex < static_cast<int>(stations.size())) {
+            if (mPlayer->play(stations[mModel.selectedStationIndex].url.c_str())) {
+                rememberStation();
+            } else {
+                // The screen must not claim a station plays that the player never took
+                ESP_LOGW(TAG, "Player refused station %d", mModel.selectedStationIndex);
+                mModel.playing = false;
+            }
+        }
+    }
+
+    mModel.status.playback =
+        mModel.playing ? common::PlaybackState::Playing : common::PlaybackState::Stopped;
+    postStatus();
+}
+
+void AppController::postStatus() {
+    common::UiEvent event;
+    event.type = common::UiEvent::Type::RENDER_STATUS;
+    event.status = mModel.status;
+    mUiSink.post(event);
+}
+
+void AppController::postStations() {
+    common::UiEvent event;
+    event.type = common::UiEvent::Type::RENDER_STATIONS;
+    event.selectedIndex = mModel.selectedStationIndex;
+    mUiSink.post(event);
+}
+
+void AppController::rememberStation() {
+    // Each newer station pushes the save back, saveSettings writes only the one that stays
+    mStationToSave = mModel.selectedStationIndex;
+    mStationSaveAtUs = esp_timer_get_time() + STATION_SAVE_DELAY_US;
+}
+
+void AppController::saveSettings(const int64_t& nowUs) {
+    common::IKeyValueStore* settings = nullptr;
+    int index = -1;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mStationToSave < 0 || nowUs < mStationSaveAtUs) {
+            return;
+        }
+        settings = mSettings;
+        index = mStationToSave;
+        mStationToSave = -1;
+    }
+    if (settings == nullptr) {
+        return;
+    }
+
+    // The station list is fixed after boot. Flash is only written when the station changed,
+    // not on every Play.
+    const std::string& id = mStationRepo.getStations()[index].id;
+    std::array<char, 64> stored{};
+    const size_t len = settings->load(LAST_STATION_KEY, stored.data(), stored.size() - 1U);
+    if (len == id.size() && std::memcmp(stored.data(), id.data(), len) == 0) {
+        return;
+    }
+    if (!settings->save(LAST_STATION_KEY, id.data(), id.size())) {
+        ESP_LOGW(TAG, "Could not remember station %s", id.c_str());
+    }
+}
+
+void AppController::changeVolume(const int& steps) {
+    int volume = mModel.volume + (steps * VOLUME_STEP);
+    if (volume < VOLUME_MIN) {
+        volume = VOLUME_MIN;
+    } else if (volume > VOLUME_MAX) {
+        volume = VOLUME_MAX;
+    }
+
+    if (volume == mModel.volume) {
+        return;
+    }
+    mModel.volume = volume;
+    if (mPlayer != nullptr) {
+        mPlayer->setVolume(mModel.volume);
+    }
+
+    common::UiEvent event;
+    event.type = common::UiEvent::Type::RENDER_VOLUME;
+    event.volume = mModel.volume;
+    mUiSink.post(event);
+}
 }  // namespace core
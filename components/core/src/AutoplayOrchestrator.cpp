@@ -0,0 +1,206 @@
+#include "AutoplayOrchestrator.hpp"
+
+#include <cstring>
+
+#include "AppController.hpp"
+#include "IClock.hpp"
+#include "IKeyValueStore.hpp"
+#include "IPlaybackStatus.hpp"
+#include "IStationRepository.hpp"
+#include "IStreamPreopener.hpp"
+#include "Metrics.hpp"
+
+// IDF
+#include <esp_log.h>
+
+namespace core {
+static const char *TAG = "Autoplay";
+
+static constexpr double US_PER_MS = 1000.0;
+
+static metrics::Gauge sFirstAudioMs("boot.first_audio_ms");
+static metrics::Counter sPreopens("autoplay.preopens");
+
+AutoplayOrchestrator::AutoplayOrchestrator(AppController &controller,
+                                           services::IStationRepository &stationRepo,
+                                           const common::IClock &clock,
+                                           common::IKeyValueStore *settings,
+                                           player::IStreamPreopener *preopener,
+                                           net::IWifiListener *next)
+    : mController(controller),
+      mStationRepo(stationRepo),
+      mClock(clock),
+      mSettings(settings),
+      mPreopener(preopener),
+      mNext(next),
+      mMutex(),
+      mSettingsLoaded(false),
+      mStationsLoaded(false),
+      mControllerReady(false),
+      mPlayback(nullptr),
+      mOnline(false),
+      mHeldStatus(false),
+      mHeldKind(common::UiStatusKind::Booting),
+      mHeldRssiDbm(0),
+      mState(State::Resolving),
+      mStationIndex(-1),
+      mStationId{},
+      mResolvedUs(0U),
+      mOnlineUs(0U),
+      mPreopenedUs(0U),
+      mStartedUs(0U),
+      mFirstAudioUs(0U) {}
+
+void AutoplayOrchestrator::onSettingsLoaded() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSettingsLoaded = true;
+}
+
+void AutoplayOrchestrator::onStationsLoaded() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStationsLoaded = true;
+}
+
+void AutoplayOrchestrator::onControllerReady() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mControllerReady = true;
+    if (mHeldStatus && mNext != nullptr) {
+        mNext->onWifiStatus(mHeldKind, mHeldRssiDbm);
+    }
+    mHeldStatus = false;
+}
+
+void AutoplayOrchestrator::onPlayerReady(const player::IPlaybackStatus &playback) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPlayback = &playback;
+}
+
+void AutoplayOrchestrator::onWifiStatus(const common::UiStatusKind &kind,
+                                        const int8_t &rssiDbm) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (kind == common::UiStatusKind::WifiConnected && !mOnline) {
+        mOnline = true;
+        mOnlineUs = mClock.nowUs();
+    }
+
+    if (!mControllerReady) {
+        mHeldStatus = true;
+        mHeldKind = kind;
+        mHeldRssiDbm = rssiDbm;
+    } else if (mNext != nullptr) {
+        mNext->onWifiStatus(kind, rssiDbm);
+    }
+}
+
+uint32_t AutoplayOrchestrator::poll() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    const bool resolvable = mSettingsLoaded && mStationsLoaded;
+    const bool online = mOnline;
+    const bool startable = mControllerReady && mPlayback != nullptr;
+    const player::IPlaybackStatus *playback = mPlayback;
+    lock.unlock();
+
+    switch (mState) {
+        case State::Resolving:
+            if (resolvable) {
+                resolveStation();
+            }
+            break;
+
+        case State::WaitingForNetwork:
+            if (!online) {
+                break;
+            }
+            // With the player still coming up, its first open would otherwise start from
+            // scratch; a player that is already up opens right away anyway
+            if (playback == nullptr && mPreopener != nullptr) {
+                const auto &station = mStationRepo.getStations()[mStationIndex];
+                if (mPreopener->preopen(station.url.c_str())) {
+                    mPreopenedUs = mClock.nowUs();
+                    sPreopens.add();
+                } else {
+                    ESP_LOGW(TAG, "Pre-opening %s failed", station.id.c_str());
+                }
+            }
+            mState = State::WaitingForPlayer;
+            break;
+
+        case State::WaitingForPlayer:
+            if (!startable) {
+                break;
+            }
+            if (!mController.autoplay(mStationIndex)) {
+                ESP_LOGI(TAG, "Playback already chosen by the user, not resuming");
+                mState = State::Done;
+                break;
+            }
+            mStartedUs = mClock.nowUs();
+            mState = State::WaitingForAudio;
+            break;
+
+        case State::WaitingForAudio:
+            if (playback->getFirstAudioUs() > 0) {
+                mFirstAudioUs = static_cast<uint64_t>(playback->getFirstAudioUs());
+                sFirstAudioMs.set(static_cast<int32_t>(mFirstAudioUs / 1000U));
+                logTimeline();
+                mState = State::Done;
+            } else if (mClock.nowUs() - mStartedUs >= FIRST_AUDIO_TIMEOUT_US) {
+                ESP_LOGW(TAG, "No audio from %s after %u s, giving up", mStationId.data(),
+                         static_cast<unsigned>(FIRST_AUDIO_TIMEOUT_US / 1000000U));
+                mState = State::Done;
+            }
+            break;
+
+        case State::Done:
+            break;
+    }
+
+    return POLL_MS;
+}
+
+AutoplayOrchestrator::State AutoplayOrchestrator::getState() const {
+    return mState;
+}
+
+uint64_t AutoplayOrchestrator::getFirstAudioUs() const {
+    return mFirstAudioUs;
+}
+
+void AutoplayOrchestrator::resolveStation() {
+    mState = State::Done;
+
+    const size_t len = (mSettings == nullptr)
+                           ? 0U
+                           : mSettings->load(AppController::LAST_STATION_KEY, mStationId.data(),
+                                             mStationId.size() - 1U);
+    if (len == 0U) {
+        ESP_LOGI(TAG, "No last station, nothing to resume");
+        return;
+    }
+    mStationId[len] = '\0';
+
+    const auto &stations = mStationRepo.getStations();
+    for (size_t i = 0; i < stations.size(); ++i) {
+        if (stations[i].id == mStationId.data()) {
+            mStationIndex = static_cast<int>(i);
+            mResolvedUs = mClock.nowUs();
+            mState = State::WaitingForNetwork;
+            ESP_LOGI(TAG, "Resuming %s once online", mStationId.data());
+            return;
+        }
+    }
+    ESP_LOGW(TAG, "Last station %s is no longer listed", mStationId.data());
+}
+
+void AutoplayOrchestrator::logTimeline() const {
+    ESP_LOGI(TAG, "Autoplay timeline (ms since boot):");
+    ESP_LOGI(TAG, "  station resolved %9.3f", mResolvedUs / US_PER_MS);
+    ESP_LOGI(TAG, "  network up       %9.3f", mOnlineUs / US_PER_MS);
+    if (mPreopenedUs > 0U) {
+        ESP_LOGI(TAG, "  stream preopened %9.3f", mPreopenedUs / US_PER_MS);
+    }
+    ESP_LOGI(TAG, "  playback started %9.3f", mStartedUs / US_PER_MS);
+    ESP_LOGI(TAG, "Boot to first audio: %.3f ms", mFirstAudioUs / US_PER_MS);
+}
+
+}  // namespace core
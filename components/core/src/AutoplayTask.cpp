@@ -0,0 +1,47 @@
+#include "AutoplayTask.hpp"
+
+#include "AutoplayOrchestrator.hpp"
+
+// IDF
+#include <esp_log.h>
+
+namespace core {
+// Pre-opening runs the HTTP and TLS client on this stack
+static constexpr uint32_t TASK_STACK_SIZE = 6144;
+static constexpr uint32_t TASK_PRIORITY = 2;  // same as the Wi-Fi task, below the UI
+
+static const char *TAG = "AutoplayTask";
+
+AutoplayTask::AutoplayTask(AutoplayOrchestrator &orchestrator)
+    : mOrchestrator(orchestrator), mTaskHandle(nullptr) {}
+
+bool AutoplayTask::init() {
+    BaseType_t result = xTaskCreate(AutoplayTask::taskEntry, "AutoplayTask", TASK_STACK_SIZE,
+                                    this, TASK_PRIORITY, &mTaskHandle);
+
+    if (result != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create autoplay task");
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Autoplay task initialized");
+    return true;
+}
+
+void AutoplayTask::taskEntry(void *pvParameters) {
+    auto *pThis = static_cast<AutoplayTask *>(pvParameters);
+    pThis->runLoop();
+
+    ESP_LOGI(TAG, "Autoplay finished");
+    pThis->mTaskHandle = nullptr;
+    vTaskDelete(nullptr);
+}
+
+void AutoplayTask::runLoop() {
+    while (mOrchestrator.getState() != AutoplayOrchestrator::State::Done) {
+        const TickType_t ticks = pdMS_TO_TICKS(mOrchestrator.poll());
+        vTaskDelay(ticks > 0 ? ticks : 1);
+    }
+}
+
+}  // namespace core
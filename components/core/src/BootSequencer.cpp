@@ -0,0 +1,204 @@
+#include "BootSequencer.hpp"
+
+#include <utility>
+
+#include "IClock.hpp"
+
+// IDF
+#include <esp_log.h>
+
+namespace core {
+static constexpr double US_PER_MS = 1000.0;
+
+static const char *TAG = "BootSequencer";
+
+static const char *stateName(const StageState &state) {
+    switch (state) {
+        case StageState::Pending:
+            return "pending";
+        case StageState::Running:
+            return "running";
+        case StageState::Done:
+            return "done";
+        case StageState::Failed:
+            return "FAILED";
+        case StageState::Skipped:
+            return "skipped";
+        default:
+            return "?";
+    }
+}
+
+BootSequencer::BootSequencer(IStageExecutor &executor, const common::IClock &clock)
+    : mExecutor(executor),
+      mClock(clock),
+      mStages(),
+      mStageCount(0U),
+      mRejectedCount(0U),
+      mDoneMask(0U),
+      mBrokenMask(0U),
+      mBootStartUs(0U),
+      mBootEndUs(0U) {}
+
+StageId BootSequencer::addStage(const char *name, std::function<bool()> action,
+                                uint32_t dependsOn, uint8_t flags) {
+    if (mStageCount >= MAX_STAGES) {
+        ESP_LOGE(TAG, "Too many boot stages, dropping '%s'", name);
+        ++mRejectedCount;
+        return INVALID_STAGE;
+    }
+
+    const uint32_t knownMask = (1U << mStageCount) - 1U;
+    if ((dependsOn & ~knownMask) != 0U) {
+        ESP_LOGE(TAG, "Stage '%s' depends on a stage that is not declared yet", name);
+        ++mRejectedCount;
+        return INVALID_STAGE;
+    }
+
+    const auto id = static_cast<StageId>(mStageCount);
+    BootStage &stage = mStages[id];
+    stage.name = name;
+    stage.action = std::move(action);
+    stage.dependsOn = dependsOn;
+    stage.flags = flags;
+    ++mStageCount;
+
+    return id;
+}
+
+bool BootSequencer::run() {
+    mBootStartUs = mClock.nowUs();
+
+    if (mRejectedCount > 0U) {
+        ESP_LOGE(TAG, "%zu boot stages were rejected, not booting", mRejectedCount);
+        mBootEndUs = mBootStartUs;
+        return false;
+    }
+
+    size_t running = launchReadyStages();
+    while (running > 0U) {
+        StageId id = INVALID_STAGE;
+        bool ok = false;
+
+        if (!mExecutor.waitForCompletion(id, ok) || id >= mStageCount) {
+            ESP_LOGE(TAG, "Lost track of running boot stages");
+            mBootEndUs = mClock.nowUs();
+            return false;
+        }
+
+        finishStage(id, ok);
+        --running;
+        running += launchReadyStages();
+    }
+
+    mBootEndUs = mClock.nowUs();
+
+    const uint32_t allMask = (1U << mStageCount) - 1U;
+    return (mDoneMask == allMask);
+}
+
+size_t BootSequencer::launchReadyStages() {
+    size_t launched = 0U;
+
+    // Dependencies always point backwards, so one ordered pass propagates skips
+    for (size_t i = 0U; i < mStageCount; ++i) {
+        BootStage &stage = mStages[i];
+        if (stage.state != StageState::Pending) {
+            continue;
+        }
+
+        const auto id = static_cast<StageId>(i);
+        if ((stage.dependsOn & mBrokenMask) != 0U) {
+            stage.state = StageState::Skipped;
+            stage.startUs = mClock.nowUs();
+            stage.endUs = stage.startUs;
+            mBrokenMask |= after(id);
+            ESP_LOGW(TAG, "Skipping '%s', a dependency failed", stage.name);
+            continue;
+        }
+
+        if ((stage.dependsOn & ~mDoneMask) != 0U) {
+            continue;
+        }
+
+        stage.state = StageState::Running;
+        stage.startUs = mClock.nowUs();
+
+        if (mExecutor.launch(id, stage)) {
+            ++launched;
+        } else {
+            ESP_LOGE(TAG, "Failed to launch '%s'", stage.name);
+            finishStage(id, false);
+        }
+    }
+
+    return launched;
+}
+
+void BootSequencer::finishStage(const StageId &id, const bool &ok) {
+    BootStage &stage = mStages[id];
+    stage.endUs = mClock.nowUs();
+
+    if (ok) {
+        stage.state = StageState::Done;
+        mDoneMask |= after(id);
+    } else {
+        stage.state = StageState::Failed;
+        mBrokenMask |= after(id);
+        ESP_LOGE(TAG, "Boot stage '%s' failed", stage.name);
+    }
+}
+
+void BootSequencer::logTimeline() const {
+    ESP_LOGI(TAG, "Boot timeline (ms since boot):");
+
+    for (size_t i = 0U; i < mStageCount; ++i) {
+        const BootStage &stage = mStages[i];
+        ESP_LOGI(TAG, "  %9.3f -> %9.3f (%8.3f) %-12s %s", stage.startUs / US_PER_MS,
+                 stage.endUs / US_PER_MS, (stage.endUs - stage.startUs) / US_PER_MS, stage.name,
+                 stateName(stage.state));
+    }
+
+    ESP_LOGI(TAG, "Time to first frame: %.3f ms",
+             getMilestoneUs(FLAG_FIRST_FRAME) / US_PER_MS);
+    ESP_LOGI(TAG, "Time to usable UI:   %.3f ms", getMilestoneUs(FLAG_USABLE_UI) / US_PER_MS);
+    ESP_LOGI(TAG, "Boot sequence took:  %.3f ms", (mBootEndUs - mBootStartUs) / US_PER_MS);
+}
+
+size_t BootSequencer::getStageCount() const {
+    return mStageCount;
+}
+
+const BootStage &BootSequencer::getStage(const StageId &id) const {
+    return mStages[id];
+}
+
+uint64_t BootSequencer::getBootStartUs() const {
+    return mBootStartUs;
+}
+
+uint64_t BootSequencer::getBootEndUs() const {
+    return mBootEndUs;
+}
+
+uint64_t BootSequencer::getMilestoneUs(const uint8_t &flag) const {
+    uint64_t milestoneUs = 0U;
+
+    // A milestone is reached once every stage carrying its flag is done
+    for (size_t i = 0U; i < mStageCount; ++i) {
+        const BootStage &stage = mStages[i];
+        if ((stage.flags & flag) == 0U) {
+            continue;
+        }
+        if (stage.state != StageState::Done) {
+            return 0U;
+        }
+        if (stage.endUs > milestoneUs) {
+            milestoneUs = stage.endUs;
+        }
+    }
+
+    return milestoneUs;
+}
+
+}  // namespace core
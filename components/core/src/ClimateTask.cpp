@@ -0,0 +1,65 @@
+#include "ClimateTask.hpp"
+
+#include "Aht20Sensor.hpp"
+#include "AppController.hpp"
+#include "Metrics.hpp"
+
+// IDF
+#include <esp_log.h>
+#include <esp_timer.h>
+
+namespace core {
+static constexpr uint32_t TASK_STACK_SIZE = 2560;
+static constexpr uint32_t TASK_PRIORITY = 2;  // below the UI, readings are not urgent
+
+static const char *TAG = "ClimateTask";
+
+static metrics::Counter sWakeups("climate.wakeups");
+
+ClimateTask::ClimateTask(adapters::Aht20Sensor &sensor, AppController &controller)
+    : mSensor(sensor), mController(controller), mTaskHandle(nullptr) {}
+
+bool ClimateTask::init() {
+    BaseType_t result = xTaskCreate(ClimateTask::taskEntry, "ClimateTask", TASK_STACK_SIZE, this,
+                                    TASK_PRIORITY, &mTaskHandle);
+
+    if (result != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create climate task");
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Climate task initialized");
+    return true;
+}
+
+void ClimateTask::taskEntry(void *pvParameters) {
+    auto *pThis = static_cast<ClimateTask *>(pvParameters);
+    pThis->runLoop();
+
+    vTaskDelete(nullptr);
+}
+
+TaskHandle_t ClimateTask::getTaskHandle() const {
+    return mTaskHandle;
+}
+
+void ClimateTask::runLoop() {
+    common::ClimateReading reading{};
+
+    while (true) {
+        sWakeups.add();
+        const uint32_t waitMs = mSensor.poll();
+
+        if (mSensor.takeReading(reading)) {
+            mController.onClimate(reading);
+        }
+        // The slowest periodic task, where a flash write delays nothing that matters
+        mController.saveSettings(esp_timer_get_time());
+
+        // At least one tick so a zero wait cannot starve lower-priority tasks
+        const TickType_t ticks = pdMS_TO_TICKS(waitMs);
+        vTaskDelay(ticks > 0 ? ticks : 1);
+    }
+}
+
+}  // namespace core
@@ -0,0 +1,60 @@
+#include "FlushTask.hpp"
+
+#include "Metrics.hpp"
+#include "UiService.hpp"
+
+// IDF
+#include <esp_log.h>
+
+namespace core {
+static constexpr uint32_t TASK_STACK_SIZE = 3072;
+static constexpr uint32_t TASK_PRIORITY = 4;  // just below UiTask, rendering comes first
+
+static const char *TAG = "FlushTask";
+
+static metrics::Counter sWakeups("flush.wakeups");
+
+FlushTask::FlushTask(services::UiService &ui) : mUiService(ui), mTaskHandle(nullptr) {}
+
+bool FlushTask::init() {
+    BaseType_t result = xTaskCreate(FlushTask::taskEntry, "FlushTask", TASK_STACK_SIZE, this,
+                                    TASK_PRIORITY, &mTaskHandle);
+
+    if (result != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create flush task");
+        return false;
+    }
+
+    mUiService.setFrameListener(this);
+
+    ESP_LOGI(TAG, "Flush task initialized");
+    return true;
+}
+
+void FlushTask::onFrameReady() {
+    xTaskNotifyGive(mTaskHandle);
+}
+
+void FlushTask::taskEntry(void *pvParameters) {
+    auto *pThis = static_cast<FlushTask *>(pvParameters);
+    pThis->runLoop();
+
+    vTaskDelete(nullptr);
+}
+
+TaskHandle_t FlushTask::getTaskHandle() const {
+    return mTaskHandle;
+}
+
+void FlushTask::runLoop() {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sWakeups.add();
+
+        // Frames published during a flush collapse into the newest one
+        while (mUiService.flushPendingFrame()) {
+        }
+    }
+}
+
+}  // namespace core
@@ -0,0 +1,70 @@
+#include "FreeRtosStageExecutor.hpp"
+
+// IDF
+#include <esp_log.h>
+#include <freertos/task.h>
+
+namespace core {
+static constexpr uint32_t STAGE_STACK_SIZE = 4096;
+static constexpr uint32_t STAGE_PRIORITY = 5;
+static constexpr uint32_t COMPLETION_TIMEOUT_MS = 10000;
+
+static const char *TAG = "FreeRtosStageExecutor";
+
+FreeRtosStageExecutor::FreeRtosStageExecutor() : mCompletionQueue(nullptr), mContexts() {}
+
+FreeRtosStageExecutor::~FreeRtosStageExecutor() {
+    if (mCompletionQueue != nullptr) {
+        vQueueDelete(mCompletionQueue);
+    }
+}
+
+bool FreeRtosStageExecutor::init() {
+    mCompletionQueue = xQueueCreate(BootSequencer::MAX_STAGES, sizeof(Completion));
+
+    if (mCompletionQueue == nullptr) {
+        ESP_LOGE(TAG, "Failed to create completion queue");
+        return false;
+    }
+
+    return true;
+}
+
+bool FreeRtosStageExecutor::launch(const StageId &id, BootStage &stage) {
+    if (mCompletionQueue == nullptr || id >= mContexts.size()) {
+        return false;
+    }
+
+    mContexts[id] = {this, &stage, id};
+
+    const BaseType_t result = xTaskCreate(FreeRtosStageExecutor::stageEntry, stage.name,
+                                          STAGE_STACK_SIZE, &mContexts[id], STAGE_PRIORITY,
+                                          nullptr);
+
+    return (result == pdPASS);
+}
+
+bool FreeRtosStageExecutor::waitForCompletion(StageId &id, bool &ok) {
+    Completion completion{};
+
+    if (xQueueReceive(mCompletionQueue, &completion, pdMS_TO_TICKS(COMPLETION_TIMEOUT_MS)) !=
+        pdTRUE) {
+        ESP_LOGE(TAG, "Timed out waiting for a boot stage");
+        return false;
+    }
+
+    id = completion.id;
+    ok = completion.ok;
+    return true;
+}
+
+void FreeRtosStageExecutor::stageEntry(void *pvParameters) {
+    auto *ctx = static_cast<StageContext *>(pvParameters);
+
+    const Completion completion{ctx->id, ctx->stage->action ? ctx->stage->action() : true};
+    xQueueSend(ctx->executor->mCompletionQueue, &completion, portMAX_DELAY);
+
+    vTaskDelete(nullptr);
+}
+
+}  // namespace core
@@ -0,0 +1,67 @@
+#include "InputTask.hpp"
+
+#include "GpioInputDriver.hpp"
+#include "InputService.hpp"
+#include "Metrics.hpp"
+
+// IDF
+#include <esp_log.h>
+
+namespace core {
+static constexpr uint32_t TASK_STACK_SIZE = 3072;
+static constexpr uint32_t TASK_PRIORITY = 10;  // above the UI, input latency matters most
+
+static const char *TAG = "InputTask";
+
+static metrics::Gauge sDroppedEdges("input.edges_dropped");
+static metrics::Counter sWakeups("input.wakeups");
+
+InputTask::InputTask(adapters::GpioInputDriver &driver, services::InputService &input)
+    : mDriver(driver), mInputService(input), mTaskHandle(nullptr) {}
+
+bool InputTask::init() {
+    BaseType_t result = xTaskCreate(InputTask::taskEntry, "InputTask", TASK_STACK_SIZE, this,
+                                    TASK_PRIORITY, &mTaskHandle);
+
+    if (result != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create input task");
+        return false;
+    }
+
+    if (!mDriver.init(mTaskHandle)) {
+        ESP_LOGE(TAG, "Failed to initialize input driver");
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Input task initialized");
+    return true;
+}
+
+void InputTask::taskEntry(void *pvParameters) {
+    auto *pThis = static_cast<InputTask *>(pvParameters);
+    pThis->runLoop();
+
+    vTaskDelete(nullptr);
+}
+
+TaskHandle_t InputTask::getTaskHandle() const {
+    return mTaskHandle;
+}
+
+void InputTask::runLoop() {
+    common::RawEdge edge{};
+
+    while (true) {
+        // No timeout: the task costs nothing until an edge arrives
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sWakeups.add();
+
+        while (mDriver.popEdge(edge)) {
+            mInputService.onEdge(edge);
+        }
+
+        sDroppedEdges.set(static_cast<int32_t>(mDriver.getDroppedEdges()));
+    }
+}
+
+}  // namespace core
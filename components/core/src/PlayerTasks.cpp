@@ -0,0 +1,148 @@
+#include "PlayerTasks.hpp"
+
+#include "Metrics.hpp"
+#include "PlayerPipeline.hpp"
+
+// IDF
+#include <esp_log.h>
+
+namespace core {
+static constexpr BaseType_t SOURCE_CORE = 0;  // PRO core, where Wi-Fi and lwIP run
+static constexpr BaseType_t DECODE_CORE = 1;  // APP core
+static constexpr uint32_t SOURCE_STACK_SIZE = 4096;  // TLS reads need the room
+static constexpr uint32_t DECODE_STACK_SIZE = 4096;
+static constexpr uint32_t STANDBY_STACK_SIZE = 6144;  // opens run the TLS handshake
+// Audio outranks the UI: a late frame is a glitch, a late repaint is not noticed. Opening
+// the next station must never starve the stream that is still playing.
+static constexpr uint32_t STANDBY_PRIORITY = 5;
+static constexpr uint32_t SOURCE_PRIORITY = 6;
+static constexpr uint32_t DECODE_PRIORITY = 7;
+
+static const char *TAG = "PlayerTasks";
+
+static metrics::Counter sSourceWakeups("player.source_wakeups");
+static metrics::Counter sDecodeWakeups("player.decode_wakeups");
+
+PlayerTasks::PlayerTasks(player::PlayerPipeline &pipeline, const bool &standby)
+    : mPipeline(pipeline),
+      mStandby(standby),
+      mSourceTask(nullptr),
+      mDecodeTask(nullptr),
+      mStandbyTask(nullptr) {}
+
+bool PlayerTasks::init() {
+    // The listener has to be in place before either loop can go to sleep
+    mPipeline.setListener(this);
+
+    BaseType_t result =
+        xTaskCreatePinnedToCore(PlayerTasks::decodeTaskEntry, "PlayerDecode", DECODE_STACK_SIZE,
+                                this, DECODE_PRIORITY, &mDecodeTask, DECODE_CORE);
+    if (result != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create decode task");
+        return false;
+    }
+
+    result = xTaskCreatePinnedToCore(PlayerTasks::sourceTaskEntry, "PlayerSource",
+                                     SOURCE_STACK_SIZE, this, SOURCE_PRIORITY, &mSourceTask,
+                                     SOURCE_CORE);
+    if (result != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create source task");
+        return false;
+    }
+
+    if (mStandby) {
+        result = xTaskCreatePinnedToCore(PlayerTasks::standbyTaskEntry, "PlayerStandby",
+                                         STANDBY_STACK_SIZE, this, STANDBY_PRIORITY,
+                                         &mStandbyTask, SOURCE_CORE);
+        if (result != pdPASS) {
+            ESP_LOGE(TAG, "Failed to create standby task");
+            return false;
+        }
+    }
+
+    ESP_LOGI(TAG, "Player tasks initialized, source on core %d, decode on core %d",
+             static_cast<int>(SOURCE_CORE), static_cast<int>(DECODE_CORE));
+    return true;
+}
+
+void PlayerTasks::onCommandPosted() {
+    if (mSourceTask != nullptr) {
+        xTaskNotifyGive(mSourceTask);
+    }
+}
+
+void PlayerTasks::onDataAvailable() {
+    if (mDecodeTask != nullptr) {
+        xTaskNotifyGive(mDecodeTask);
+    }
+}
+
+void PlayerTasks::onSpaceAvailable() {
+    if (mSourceTask != nullptr) {
+        xTaskNotifyGive(mSourceTask);
+    }
+}
+
+void PlayerTasks::onStandbyRequested() {
+    if (mStandbyTask != nullptr) {
+        xTaskNotifyGive(mStandbyTask);
+    }
+}
+
+TaskHandle_t PlayerTasks::getSourceTaskHandle() const {
+    return mSourceTask;
+}
+
+TaskHandle_t PlayerTasks::getDecodeTaskHandle() const {
+    return mDecodeTask;
+}
+
+void PlayerTasks::sourceTaskEntry(void *pvParameters) {
+    auto *pThis = static_cast<PlayerTasks *>(pvParameters);
+    pThis->runSourceLoop();
+
+    vTaskDelete(nullptr);
+}
+
+void PlayerTasks::decodeTaskEntry(void *pvParameters) {
+    auto *pThis = static_cast<PlayerTasks *>(pvParameters);
+    pThis->runDecodeLoop();
+
+    vTaskDelete(nullptr);
+}
+
+void PlayerTasks::standbyTaskEntry(void *pvParameters) {
+    auto *pThis = static_cast<PlayerTasks *>(pvParameters);
+    pThis->runStandbyLoop();
+
+    vTaskDelete(nullptr);
+}
+
+void PlayerTasks::runSourceLoop() {
+    while (true) {
+        // A notification given while the step ran is kept, so no wakeup is lost
+        while (mPipeline.runSourceStep()) {
+        }
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sSourceWakeups.add();
+    }
+}
+
+void PlayerTasks::runDecodeLoop() {
+    while (true) {
+        while (mPipeline.runDecodeStep()) {
+        }
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sDecodeWakeups.add();
+    }
+}
+
+void PlayerTasks::runStandbyLoop() {
+    while (true) {
+        while (mPipeline.runStandbyStep()) {
+        }
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+}  // namespace core
@@ -0,0 +1,75 @@
+#include "SpectrumTask.hpp"
+
+// IDF
+#include <sdkconfig.h>
+
+#ifdef CONFIG_PLAYER_SPECTRUM_ENABLE
+
+#include "AppController.hpp"
+#include "Metrics.hpp"
+#include "SpectrumAnalyzer.hpp"
+
+// IDF
+#include <esp_log.h>
+
+namespace core {
+static constexpr uint32_t TASK_STACK_SIZE = 3072;
+static constexpr uint32_t TASK_PRIORITY = 1;  // just above idle, below the climate task
+static constexpr uint32_t FRAME_MS = 1000U / CONFIG_PLAYER_SPECTRUM_FPS;
+static constexpr uint32_t IDLE_POLL_MS = 250U;
+
+static const char *TAG = "SpectrumTask";
+
+static metrics::Counter sFrames("spectrum.frames");
+
+SpectrumTask::SpectrumTask(player::SpectrumAnalyzer &analyzer, AppController &controller)
+    : mAnalyzer(analyzer), mController(controller), mTaskHandle(nullptr) {}
+
+bool SpectrumTask::init() {
+    BaseType_t result = xTaskCreate(SpectrumTask::taskEntry, "SpectrumTask", TASK_STACK_SIZE,
+                                    this, TASK_PRIORITY, &mTaskHandle);
+
+    if (result != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create spectrum task");
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Spectrum task initialized, %d fps", CONFIG_PLAYER_SPECTRUM_FPS);
+    return true;
+}
+
+void SpectrumTask::taskEntry(void *pvParameters) {
+    auto *pThis = static_cast<SpectrumTask *>(pvParameters);
+    pThis->runLoop();
+
+    vTaskDelete(nullptr);
+}
+
+TaskHandle_t SpectrumTask::getTaskHandle() const {
+    return mTaskHandle;
+}
+
+void SpectrumTask::runLoop() {
+    player::SpectrumAnalyzer::Levels levels{};
+    TickType_t lastWake = xTaskGetTickCount();
+    const TickType_t frameTicks = pdMS_TO_TICKS(FRAME_MS) > 0 ? pdMS_TO_TICKS(FRAME_MS) : 1;
+
+    while (true) {
+        if (!mAnalyzer.update(levels)) {
+            // Nothing playing and every bar down: poll slowly until audio flows again
+            vTaskDelay(pdMS_TO_TICKS(IDLE_POLL_MS));
+            lastWake = xTaskGetTickCount();
+            continue;
+        }
+
+        sFrames.add();
+        mController.onSpectrum(levels);
+
+        // Paced from the last wake, so a slow frame shortens the sleep instead of adding up
+        vTaskDelayUntil(&lastWake, frameTicks);
+    }
+}
+
+}  // namespace core
+
+#endif  // CONFIG_PLAYER_SPECTRUM_ENABLE
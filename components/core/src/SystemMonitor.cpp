@@ -0,0 +1,81 @@
+#include "SystemMonitor.hpp"
+
+#include "IClock.hpp"
+#include "Memory.hpp"
+
+// IDF
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+
+namespace core {
+static constexpr uint64_t US_PER_S = 1000000U;
+
+static const char *TAG = "SystemMonitor";
+
+static metrics::Gauge sInternalFree("heap.internal_free");
+static metrics::Gauge sInternalMinFree("heap.internal_min");
+static metrics::Gauge sInternalLargest("heap.internal_block");
+static metrics::Gauge sPsramFree("heap.psram_free");
+static metrics::Gauge sI2cBytesPerSec("i2c.bytes_per_s");
+
+SystemMonitor::SystemMonitor(const common::IClock &clock)
+    : mClock(clock), mTasks(), mTaskCount(0U), mLastSampleUs(0U), mLastI2cBytes(0U) {}
+
+bool SystemMonitor::watchTask(const char *stackGauge, const char *cpuGauge, TaskHandle_t handle) {
+    if (mTaskCount >= MAX_TASKS || handle == nullptr) {
+        ESP_LOGW(TAG, "Cannot watch task for '%s'", stackGauge);
+        return false;
+    }
+
+    WatchedTask &task = mTasks[mTaskCount];
+    task.handle = handle;
+    const bool stackBound = task.stackFree.bind(stackGauge);
+    const bool cpuBound = task.cpuPermille.bind(cpuGauge);
+    ++mTaskCount;
+
+    // Still sampled, but a gauge the registry had no room for is missing from every report
+    return stackBound && cpuBound;
+}
+
+void SystemMonitor::sample() {
+    sInternalFree.set(static_cast<int32_t>(heap_caps_get_free_size(MALLOC_CAP_INTERNAL)));
+    sInternalMinFree.set(
+        static_cast<int32_t>(heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL)));
+    sInternalLargest.set(
+        static_cast<int32_t>(heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL)));
+    sPsramFree.set(static_cast<int32_t>(heap_caps_get_free_size(MALLOC_CAP_SPIRAM)));
+    memory::sample();
+
+    const uint64_t nowUs = mClock.nowUs();
+    const bool hasPeriod = mLastSampleUs != 0U && nowUs > mLastSampleUs;
+
+    for (size_t i = 0U; i < mTaskCount; ++i) {
+        WatchedTask &task = mTasks[i];
+        // Bytes of stack never touched so far
+        task.stackFree.set(static_cast<int32_t>(uxTaskGetStackHighWaterMark(task.handle)));
+
+#if configGENERATE_RUN_TIME_STATS == 1
+        // Run time is counted in esp_timer microseconds
+        const uint32_t runTimeUs = static_cast<uint32_t>(ulTaskGetRunTimeCounter(task.handle));
+        if (hasPeriod) {
+            const uint64_t ranUs = runTimeUs - task.lastRunTimeUs;  // unsigned wrap is fine
+            task.cpuPermille.set(static_cast<int32_t>((ranUs * 1000U) / (nowUs - mLastSampleUs)));
+        }
+        task.lastRunTimeUs = runTimeUs;
+#endif
+    }
+
+    const auto &registry = metrics::Registry::instance();
+    const metrics::Counter *txBytes = registry.findCounter("i2c.tx_bytes");
+    const metrics::Counter *rxBytes = registry.findCounter("i2c.rx_bytes");
+    const uint32_t i2cBytes = (txBytes ? txBytes->value() : 0U) + (rxBytes ? rxBytes->value() : 0U);
+
+    if (hasPeriod) {
+        const uint64_t bytes = i2cBytes - mLastI2cBytes;  // unsigned wrap is fine
+        sI2cBytesPerSec.set(static_cast<int32_t>((bytes * US_PER_S) / (nowUs - mLastSampleUs)));
+    }
+    mLastSampleUs = nowUs;
+    mLastI2cBytes = i2cBytes;
+}
+
+}  // namespace core
@@ -1,10 +1,13 @@
 #include "UiTask.hpp"
 
+#include "Metrics.hpp"
+#include "Trace.hpp"
 #include "UiService.hpp"
 #include "UiTypes.hpp"
 
 // IDF
 #include <esp_log.h>
+#include <esp_timer.h>
 
 namespace core {
 static constexpr uint32_t QUEUE_LENGTH = 5;
@@ -14,7 +17,14 @@ static constexpr uint32_t TASK_PRIORITY = 5;
 
 static const char *TAG = "UiTask";
 
-UiTask::UiTask(services::UiService &ui) : mUiQueue(nullptr), mUiService(ui) {
+static metrics::Gauge sQueueDepth("ui.queue_depth");
+static metrics::Counter sPostFailures("ui.post_failures");
+static metrics::Counter sEventsDropped("ui.events_dropped");
+static metrics::Counter sWakeups("ui.wakeups");
+static metrics::Histogram sEventLatency("ui.event_us", metrics::LATENCY_BUCKETS_US);
+
+UiTask::UiTask(services::UiService &ui)
+    : mUiQueue(nullptr), mTaskHandle(nullptr), mUiService(ui) {
     ESP_LOGI(TAG, "UiTask::UiTask created");
 }
 
@@ -35,7 +45,7 @@ bool UiTask::init() {
                                     TASK_STACK_SIZE,    // Stack size in bytes
                                     this,  // Parameter passed to task (our UiTask instance)
                                     TASK_PRIORITY,  // Priority
-                                    nullptr         // Task handle (optional)
+                                    &mTaskHandle    // Task handle (optional)
     );
 
     if (result != pdPASS) {
@@ -56,40 +66,92 @@ void UiTask::taskEntry(void *pvParameters) {
     vTaskDelete(nullptr);
 }
 
+TaskHandle_t UiTask::getTaskHandle() const {
+    return mTaskHandle;
+}
+
 void UiTask::post(const common::UiEvent &e) {
+    // pdMS_TO_TICKS converts milliseconds to FreeRTOS ticks
+    // portMAX_DELAY means wait forever if queue is full
+    // Timeout: 100ms
+    if (!send(e, pdMS_TO_TICKS(100))) {
+        sPostFailures.add();
+        ESP_LOGW(TAG, "Failed to post UI event (queue full?)");
+        // TODO: handle this properly
+    }
+}
+
+bool UiTask::tryPost(const common::UiEvent &e) {
+    // Dropped quietly, a busy UI would otherwise log at the frame rate
+    if (!send(e, 0)) {
+        sEventsDropped.add();
+        return false;
+    }
+    return true;
+}
+
+bool UiTask::send(const common::UiEvent &e, const TickType_t &wait) {
     if (mUiQueue == nullptr) {
         ESP_LOGE(TAG, "Queue not initialized");
-        return;
+        return false;
     }
 
+    TRACE_INSTANT(UI_TASK_POST, e.type);
+
+    common::UiEvent stamped = e;
+    stamped.postedUs = esp_timer_get_time();
+
     // xQueueSend(queue, ptr_to_item, ticks_to_wait)
-    // pdMS_TO_TICKS converts milliseconds to FreeRTOS ticks
-    // portMAX_DELAY means wait forever if queue is full
-    // Timeout: 100ms
-    BaseType_t result = xQueueSend(mUiQueue, &e, pdMS_TO_TICKS(100));
+    const BaseType_t result = xQueueSend(mUiQueue, &stamped, wait);
+    sQueueDepth.set(static_cast<int32_t>(uxQueueMessagesWaiting(mUiQueue)));
 
-    if (result != pdPASS) {
-        ESP_LOGW(TAG, "Failed to post UI event (queue full?)");
-        // TODO: handle this properly
+    return result == pdPASS;
+}
+
+// Ticks to block so the wait ends at or just after deadlineUs, forever without a deadline
+static TickType_t ticksUntil(const int64_t &deadlineUs) {
+    if (deadlineUs == services::UiService::NO_DEADLINE) {
+        return portMAX_DELAY;
     }
+
+    static constexpr int64_t US_PER_TICK = 1000LL * portTICK_PERIOD_MS;
+    const int64_t remainingUs = deadlineUs - esp_timer_get_time();
+    if (remainingUs <= 0) {
+        return 0;
+    }
+    // Round up, waking a tick late is fine, waking early costs a second wakeup
+    return static_cast<TickType_t>((remainingUs + US_PER_TICK - 1) / US_PER_TICK);
 }
 
 void UiTask::runLoop() {
     ESP_LOGI(TAG, "UI task loop started");
 
+    while (true) {
+        // Sleep until an event arrives or the UI has timed work due, nothing in between
+        processNext(ticksUntil(mUiService.nextDeadlineUs()));
+    }
+}
+
+bool UiTask::processNext(const TickType_t &wait) {
     common::UiEvent event;
+    const BaseType_t result = xQueueReceive(mUiQueue, &event, wait);
+    sWakeups.add();
 
-    while (true) {
-        // Wait for event from queue
-        // xQueueReceive blocks until item arrives or timeout
-        BaseType_t result = xQueueReceive(mUiQueue, &event, pdMS_TO_TICKS(1000));
+    if (result == pdTRUE) {
+        ESP_LOGD(TAG, "Received UI event, type=%d", (int)event.type);
 
-        if (result == pdTRUE) {
-            ESP_LOGI(TAG, "Received UI event, type=%d", (int)event.type);
+        TRACE_SCOPE_ARG(UI_TASK_EVENT, event.type);
+        const int64_t startUs = esp_timer_get_time();
+        mUiService.onEvent(event);
+        sEventLatency.record(static_cast<uint32_t>(esp_timer_get_time() - startUs));
+    }
 
-            mUiService.onEvent(event);
-        }
+    // A steady stream of events must not hold a deadline off
+    if (esp_timer_get_time() >= mUiService.nextDeadlineUs()) {
+        mUiService.tick();
     }
+
+    return result == pdTRUE;
 }
 
 }  // namespace core
@@ -0,0 +1,52 @@
+#include "WifiTask.hpp"
+
+#include "WifiManager.hpp"
+
+// IDF
+#include <esp_log.h>
+
+namespace core {
+static constexpr uint32_t TASK_STACK_SIZE = 3072;
+static constexpr uint32_t TASK_PRIORITY = 2;  // same as the climate task, below the UI
+
+static const char *TAG = "WifiTask";
+
+WifiTask::WifiTask(net::WifiManager &manager) : mManager(manager), mTaskHandle(nullptr) {}
+
+bool WifiTask::init() {
+    BaseType_t result = xTaskCreate(WifiTask::taskEntry, "WifiTask", TASK_STACK_SIZE, this,
+                                    TASK_PRIORITY, &mTaskHandle);
+
+    if (result != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create Wi-Fi task");
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Wi-Fi task initialized");
+    return true;
+}
+
+void WifiTask::taskEntry(void *pvParameters) {
+    auto *pThis = static_cast<WifiTask *>(pvParameters);
+    pThis->runLoop();
+
+    vTaskDelete(nullptr);
+}
+
+TaskHandle_t WifiTask::getTaskHandle() const {
+    return mTaskHandle;
+}
+
+void WifiTask::runLoop() {
+    mManager.start();
+
+    while (true) {
+        const uint32_t waitMs = mManager.poll();
+
+        // At least one tick so a zero wait cannot starve lower-priority tasks
+        const TickType_t ticks = pdMS_TO_TICKS(waitMs);
+        vTaskDelay(ticks > 0 ? ticks : 1);
+    }
+}
+
+}  // namespace core
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace memory {
+// Where a buffer lives. The S3 has a few hundred KB of fast internal RAM, only part of it
+// reachable by DMA, and optionally megabytes of PSRAM behind the cache: slower, and never
+// usable for DMA descriptors or buffers touched with the cache off.
+enum class MemoryClass : uint8_t {
+    Dma,       // internal and DMA-capable: peripheral buffers
+    Internal,  // fast internal: buffers on hot paths
+    Psram,     // bulk: stream and cache buffers; falls back to internal without PSRAM
+};
+
+static constexpr size_t CLASS_COUNT = 3U;
+
+struct ClassStats {
+    // Through this layer, by where the bytes landed
+    size_t inUseBytes = 0U;
+    size_t peakBytes = 0U;
+    uint32_t allocations = 0U;
+    uint32_t failures = 0U;
+    uint32_t fallbacks = 0U;  // Psram requests served from internal RAM
+
+    // The whole heap region behind the class
+    size_t freeBytes = 0U;
+    size_t minFreeBytes = 0U;
+    size_t largestFreeBlock = 0U;
+
+    // How much of the free space a single allocation cannot use
+    uint16_t fragmentationPermille() const {
+        return (freeBytes == 0U)
+                   ? 0U
+                   : static_cast<uint16_t>(1000U - (largestFreeBlock * 1000U) / freeBytes);
+    }
+};
+
+const char *className(const MemoryClass &memoryClass);
+
+// nullptr when the class (and for Psram, internal RAM too) cannot serve the request. Zero
+// bytes allocate nothing and return nullptr.
+void *allocate(const MemoryClass &memoryClass, const size_t &bytes);
+// Same class and size as allocated; nullptr is ignored
+void release(void *ptr, const MemoryClass &memoryClass, const size_t &bytes);
+
+ClassStats stats(const MemoryClass &memoryClass);
+// Publishes usage and fragmentation to the "mem.*" gauges
+void sample();
+void logSummary();
+
+// Logs what could not be allocated and aborts, like operator new without exceptions
+[[noreturn]] void outOfMemory(const MemoryClass &memoryClass, const size_t &bytes);
+
+// Stateless STL allocator drawing from one class
+template <typename T, MemoryClass CLASS>
+class Allocator {
+   public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = Allocator<U, CLASS>;
+    };
+
+    Allocator() = default;
+    template <typename U>
+    Allocator(const Allocator<U, CLASS> &) {}
+
+    T *allocate(const size_t n) {
+        void *ptr = memory::allocate(CLASS, n * sizeof(T));
+        if (ptr == nullptr && n > 0U) {
+            outOfMemory(CLASS, n * sizeof(T));
+        }
+        return static_cast<T *>(ptr);
+    }
+
+    void deallocate(T *ptr, const size_t n) {
+        release(ptr, CLASS, n * sizeof(T));
+    }
+};
+
+template <typename T, typename U, MemoryClass CLASS>
+bool operator==(const Allocator<T, CLASS> &, const Allocator<U, CLASS> &) {
+    return true;
+}
+
+template <typename T, typename U, MemoryClass CLASS>
+bool operator!=(const Allocator<T, CLASS> &, const Allocator<U, CLASS> &) {
+    return false;
+}
+
+template <typename T>
+using PsramVector = std::vector<T, Allocator<T, MemoryClass::Psram>>;
+using PsramString =
+    std::basic_string<char, std::char_traits<char>, Allocator<char, MemoryClass::Psram>>;
+
+template <typename T, MemoryClass CLASS>
+struct BufferDeleter {
+    size_t count = 0U;
+
+    void operator()(T *ptr) const {
+        release(ptr, CLASS, count * sizeof(T));
+    }
+};
+
+// Fixed-size, zeroed array of plain data in one class
+template <typename T, MemoryClass CLASS>
+using Buffer = std::unique_ptr<T[], BufferDeleter<T, CLASS>>;
+
+// Empty when the class is exhausted, so callers can fail their init() instead of aborting
+template <typename T, MemoryClass CLASS>
+Buffer<T, CLASS> makeBuffer(const size_t &count) {
+    static_assert(std::is_trivial<T>::value, "Buffers hold plain data");
+
+    T *ptr = static_cast<T *>(allocate(CLASS, count * sizeof(T)));
+    if (ptr == nullptr) {
+        return Buffer<T, CLASS>(nullptr, BufferDeleter<T, CLASS>());
+    }
+    std::fill_n(reinterpret_cast<uint8_t *>(ptr), count * sizeof(T), 0U);
+    return Buffer<T, CLASS>(ptr, BufferDeleter<T, CLASS>{count});
+}
+
+}  // namespace memory
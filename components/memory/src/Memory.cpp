@@ -0,0 +1,153 @@
+#include "Memory.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+
+#include "Metrics.hpp"
+
+// IDF
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+#include <esp_memory_utils.h>
+
+namespace memory {
+static const char *TAG = "Memory";
+
+struct ClassUsage {
+    std::atomic<size_t> inUse{0U};
+    std::atomic<size_t> peak{0U};
+    std::atomic<uint32_t> allocations{0U};
+    std::atomic<uint32_t> failures{0U};
+    std::atomic<uint32_t> fallbacks{0U};
+};
+
+static std::array<ClassUsage, CLASS_COUNT> sUsage;
+
+static metrics::Gauge sUsed[CLASS_COUNT] = {metrics::Gauge("mem.dma_used"),
+                                            metrics::Gauge("mem.internal_used"),
+                                            metrics::Gauge("mem.psram_used")};
+static metrics::Gauge sFragmentation[CLASS_COUNT] = {metrics::Gauge("mem.dma_frag_permille"),
+                                                     metrics::Gauge("mem.internal_frag_permille"),
+                                                     metrics::Gauge("mem.psram_frag_permille")};
+
+static size_t index(const MemoryClass &memoryClass) {
+    return static_cast<size_t>(memoryClass);
+}
+
+static uint32_t capsOf(const MemoryClass &memoryClass) {
+    switch (memoryClass) {
+        case MemoryClass::Dma:
+            return MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+        case MemoryClass::Internal:
+            return MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+        case MemoryClass::Psram:
+            return MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+    }
+    return MALLOC_CAP_DEFAULT;
+}
+
+// A Psram request that fell back is accounted, and released, as internal
+static MemoryClass landedIn(const MemoryClass &requested, const void *ptr) {
+    return (requested == MemoryClass::Psram && !esp_ptr_external_ram(ptr)) ? MemoryClass::Internal
+                                                                           : requested;
+}
+
+const char *className(const MemoryClass &memoryClass) {
+    switch (memoryClass) {
+        case MemoryClass::Dma:
+            return "dma";
+        case MemoryClass::Internal:
+            return "internal";
+        case MemoryClass::Psram:
+            return "psram";
+    }
+    return "?";
+}
+
+void *allocate(const MemoryClass &memoryClass, const size_t &bytes) {
+    if (bytes == 0U) {
+        return nullptr;
+    }
+
+    void *ptr = heap_caps_malloc(bytes, capsOf(memoryClass));
+    if (ptr == nullptr && memoryClass == MemoryClass::Psram) {
+        // Boards without PSRAM, or with it full, still run: bulk buffers just cost more
+        ptr = heap_caps_malloc(bytes, capsOf(MemoryClass::Internal));
+        if (ptr != nullptr) {
+            sUsage[index(memoryClass)].fallbacks.fetch_add(1U, std::memory_order_relaxed);
+        }
+    }
+    if (ptr == nullptr) {
+        sUsage[index(memoryClass)].failures.fetch_add(1U, std::memory_order_relaxed);
+        ESP_LOGE(TAG, "No %zu bytes of %s memory, largest block %zu", bytes,
+                 className(memoryClass), heap_caps_get_largest_free_block(capsOf(memoryClass)));
+        return nullptr;
+    }
+
+    ClassUsage &usage = sUsage[index(landedIn(memoryClass, ptr))];
+    usage.allocations.fetch_add(1U, std::memory_order_relaxed);
+    const size_t inUse = usage.inUse.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t peak = usage.peak.load(std::memory_order_relaxed);
+    while (inUse > peak &&
+           !usage.peak.compare_exchange_weak(peak, inUse, std::memory_order_relaxed)) {
+    }
+
+    return ptr;
+}
+
+void release(void *ptr, const MemoryClass &memoryClass, const size_t &bytes) {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    sUsage[index(landedIn(memoryClass, ptr))].inUse.fetch_sub(bytes, std::memory_order_relaxed);
+    heap_caps_free(ptr);
+}
+
+ClassStats stats(const MemoryClass &memoryClass) {
+    const ClassUsage &usage = sUsage[index(memoryClass)];
+    const uint32_t caps = capsOf(memoryClass);
+
+    ClassStats result;
+    result.inUseBytes = usage.inUse.load(std::memory_order_relaxed);
+    result.peakBytes = usage.peak.load(std::memory_order_relaxed);
+    result.allocations = usage.allocations.load(std::memory_order_relaxed);
+    result.failures = usage.failures.load(std::memory_order_relaxed);
+    result.fallbacks = usage.fallbacks.load(std::memory_order_relaxed);
+    result.freeBytes = heap_caps_get_free_size(caps);
+    result.minFreeBytes = heap_caps_get_minimum_free_size(caps);
+    result.largestFreeBlock = heap_caps_get_largest_free_block(caps);
+    return result;
+}
+
+void sample() {
+    for (size_t i = 0U; i < CLASS_COUNT; ++i) {
+        const ClassStats classStats = stats(static_cast<MemoryClass>(i));
+        sUsed[i].set(static_cast<int32_t>(classStats.inUseBytes));
+        sFragmentation[i].set(classStats.fragmentationPermille());
+    }
+}
+
+void logSummary() {
+    for (size_t i = 0U; i < CLASS_COUNT; ++i) {
+        const MemoryClass memoryClass = static_cast<MemoryClass>(i);
+        const ClassStats classStats = stats(memoryClass);
+        ESP_LOGI(TAG,
+                 "%-8s %7zu B used (peak %zu), %u allocs, %u failed, %u fell back | "
+                 "%zu B free (min %zu), largest %zu, frag %u%%",
+                 className(memoryClass), classStats.inUseBytes, classStats.peakBytes,
+                 static_cast<unsigned>(classStats.allocations),
+                 static_cast<unsigned>(classStats.failures),
+                 static_cast<unsigned>(classStats.fallbacks), classStats.freeBytes,
+                 classStats.minFreeBytes, classStats.largestFreeBlock,
+                 classStats.fragmentationPermille() / 10U);
+    }
+}
+
+void outOfMemory(const MemoryClass &memoryClass, const size_t &bytes) {
+    ESP_LOGE(TAG, "Out of %s memory allocating %zu bytes", className(memoryClass), bytes);
+    abort();
+}
+
+}  // namespace memory
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace metrics {
+// Upper bucket bounds for latencies, in microseconds
+static constexpr std::array<uint32_t, 12> LATENCY_BUCKETS_US = {
+    50U, 100U, 250U, 500U, 1000U, 2500U, 5000U, 10000U, 25000U, 50000U, 100000U, 250000U};
+
+// Metrics are meant to be static objects: they register themselves with Registry::instance()
+// on construction and every update afterwards is a relaxed atomic, without locks or heap.
+// Only 32-bit atomics qualify: 64-bit ones go through libatomic locks on the ESP32-S3.
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Metric updates must be lock-free");
+static_assert(std::atomic<int32_t>::is_always_lock_free, "Metric updates must be lock-free");
+
+class Counter {
+   public:
+    explicit Counter(const char* name);
+
+    void add(const uint32_t& n = 1U) {
+        mValue.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    uint32_t value() const {
+        return mValue.load(std::memory_order_relaxed);
+    }
+
+    const char* name() const {
+        return mName;
+    }
+
+   private:
+    const char* mName;
+    std::atomic<uint32_t> mValue{0U};
+};
+
+// Last value plus its high-water mark
+class Gauge {
+   public:
+    // An unnamed gauge stays unregistered until bind() gives it a name
+    explicit Gauge(const char* name = nullptr);
+
+    // False, with an error logged, when the gauge already has a name or the registry is full
+    bool bind(const char* name);
+
+    void set(const int32_t& value) {
+        mValue.store(value, std::memory_order_relaxed);
+
+        int32_t max = mMax.load(std::memory_order_relaxed);
+        while (value > max &&
+               !mMax.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    int32_t value() const {
+        return mValue.load(std::memory_order_relaxed);
+    }
+
+    int32_t max() const {
+        return mMax.load(std::memory_order_relaxed);
+    }
+
+    const char* name() const {
+        return mName;
+    }
+
+   private:
+    const char* mName;
+    std::atomic<int32_t> mValue{0};
+    std::atomic<int32_t> mMax{0};
+};
+
+class Histogram {
+   public:
+    static constexpr size_t MAX_BUCKETS = 16U;
+
+    struct Snapshot {
+        std::array<uint32_t, MAX_BUCKETS + 1U> counts;  // last one is the overflow bucket
+        const uint32_t* bounds;
+        size_t boundCount;
+        uint32_t count;
+        uint64_t sum;  // a long latency run overflows 32 bits within hours
+        uint32_t max;
+
+        // Linear interpolation inside the bucket holding the percentile
+        uint32_t percentile(const uint32_t& pct) const;
+        uint32_t mean() const;
+    };
+
+    template <size_t N>
+    Histogram(const char* name, const std::array<uint32_t, N>& bounds)
+        : Histogram(name, bounds.data(), N) {
+        static_assert(N > 0U && N <= MAX_BUCKETS, "Unsupported bucket count");
+    }
+
+    void record(const uint32_t& value);
+    Snapshot snapshot() const;
+    void reset();
+
+    const char* name() const {
+        return mName;
+    }
+
+   private:
+    Histogram(const char* name, const uint32_t* bounds, size_t boundCount);
+
+    const char* mName;
+    const uint32_t* mBounds;  // ascending, inclusive upper bounds
+    size_t mBoundCount;
+
+    std::array<std::atomic<uint32_t>, MAX_BUCKETS + 1U> mCounts{};
+    // 64-bit sum as two lock-free words. record() adds to the low word and, when that add
+    // wraps, carries one into the high word. The carry lands a moment after the wrap, so a
+    // snapshot taken in between reads the sum 2^32 short until the next one.
+    std::atomic<uint32_t> mSumLow{0U};
+    std::atomic<uint32_t> mSumHigh{0U};
+    std::atomic<uint32_t> mMax{0U};
+};
+
+// Fixed-capacity index of all metrics, used for the console snapshot and the periodic log
+class Registry {
+   public:
+    static constexpr size_t MAX_COUNTERS = 48U;
+    // 17 static gauges, two for each task SystemMonitor watches, and room to grow
+    static constexpr size_t MAX_GAUGES = 48U;
+    static constexpr size_t MAX_HISTOGRAMS = 12U;
+    static constexpr size_t LINE_LEN = 128U;  // a histogram line with every field at 10 digits
+
+    static Registry& instance();
+
+    // Registration is expected during static init or boot, before metrics are read
+    bool add(Counter& counter);
+    bool add(Gauge& gauge);
+    bool add(Histogram& histogram);
+
+    const Counter* findCounter(const char* name) const;
+    const Gauge* findGauge(const char* name) const;
+    const Histogram* findHistogram(const char* name) const;
+
+    void print(FILE* out) const;
+    void logSummary() const;
+    // "metrics [reset]"
+    int runCommand(int argc, char** argv);
+
+   private:
+    template <typename Fn>
+    void forEachLine(Fn&& fn) const;
+
+    std::array<Counter*, MAX_COUNTERS> mCounters{};
+    std::array<Gauge*, MAX_GAUGES> mGauges{};
+    std::array<Histogram*, MAX_HISTOGRAMS> mHistograms{};
+    std::atomic<size_t> mCounterCount{0U};
+    std::atomic<size_t> mGaugeCount{0U};
+    std::atomic<size_t> mHistogramCount{0U};
+};
+
+}  // namespace metrics
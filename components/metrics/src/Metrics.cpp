@@ -0,0 +1,229 @@
+#include "Metrics.hpp"
+
+#include <cstring>
+
+// IDF
+#include <esp_log.h>
+
+namespace metrics {
+static constexpr uint32_t PERCENT = 100U;
+
+static const char *TAG = "Metrics";
+
+Counter::Counter(const char *name) : mName(name) {
+    Registry::instance().add(*this);
+}
+
+Gauge::Gauge(const char *name) : mName(nullptr) {
+    if (name != nullptr) {
+        bind(name);
+    }
+}
+
+bool Gauge::bind(const char *name) {
+    if (mName != nullptr) {
+        ESP_LOGW(TAG, "Gauge '%s' is already bound", mName);
+        return false;
+    }
+
+    mName = name;
+    return Registry::instance().add(*this);
+}
+
+Histogram::Histogram(const char *name, const uint32_t *bounds, size_t boundCount)
+    : mName(name), mBounds(bounds), mBoundCount(boundCount) {
+    Registry::instance().add(*this);
+}
+
+void Histogram::record(const uint32_t &value) {
+    size_t bucket = 0U;
+    while (bucket < mBoundCount && value > mBounds[bucket]) {
+        ++bucket;
+    }
+
+    mCounts[bucket].fetch_add(1U, std::memory_order_relaxed);
+    const uint32_t low = mSumLow.fetch_add(value, std::memory_order_relaxed);
+    if (low > UINT32_MAX - value) {
+        mSumHigh.fetch_add(1U, std::memory_order_release);
+    }
+
+    uint32_t max = mMax.load(std::memory_order_relaxed);
+    while (value > max && !mMax.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+    Snapshot snap{};
+    snap.bounds = mBounds;
+    snap.boundCount = mBoundCount;
+
+    for (size_t i = 0U; i <= mBoundCount; ++i) {
+        snap.counts[i] = mCounts[i].load(std::memory_order_relaxed);
+        snap.count += snap.counts[i];
+    }
+    // A carry between the two high reads would pair the new high word with the old low one
+    uint32_t high = mSumHigh.load(std::memory_order_acquire);
+    uint32_t low = 0U;
+    uint32_t highAgain = 0U;
+    do {
+        low = mSumLow.load(std::memory_order_relaxed);
+        highAgain = high;
+        high = mSumHigh.load(std::memory_order_acquire);
+    } while (high != highAgain);
+    snap.sum = (static_cast<uint64_t>(high) << 32U) | low;
+    snap.max = mMax.load(std::memory_order_relaxed);
+
+    return snap;
+}
+
+void Histogram::reset() {
+    for (auto &count : mCounts) {
+        count.store(0U, std::memory_order_relaxed);
+    }
+    mSumLow.store(0U, std::memory_order_relaxed);
+    mSumHigh.store(0U, std::memory_order_relaxed);
+    mMax.store(0U, std::memory_order_relaxed);
+}
+
+uint32_t Histogram::Snapshot::percentile(const uint32_t &pct) const {
+    if (count == 0U) {
+        return 0U;
+    }
+
+    const uint64_t target = ((static_cast<uint64_t>(count) * pct) + PERCENT - 1U) / PERCENT;
+    uint64_t cumulative = 0U;
+
+    for (size_t i = 0U; i <= boundCount; ++i) {
+        if (counts[i] == 0U || (cumulative + counts[i]) < target) {
+            cumulative += counts[i];
+            continue;
+        }
+
+        const uint32_t lower = (i == 0U) ? 0U : bounds[i - 1U];
+        const uint32_t upper = (i < boundCount && bounds[i] < max) ? bounds[i] : max;
+        if (upper <= lower) {
+            return upper;
+        }
+
+        const uint64_t position = (target > cumulative) ? (target - cumulative) : 1U;
+        return lower + static_cast<uint32_t>(((upper - lower) * position) / counts[i]);
+    }
+
+    return max;
+}
+
+uint32_t Histogram::Snapshot::mean() const {
+    return (count == 0U) ? 0U : static_cast<uint32_t>(sum / count);
+}
+
+Registry &Registry::instance() {
+    static Registry registry;
+    return registry;
+}
+
+template <typename T, size_t N>
+static bool addMetric(std::array<T *, N> &slots, std::atomic<size_t> &count, T &metric) {
+    const size_t index = count.load(std::memory_order_relaxed);
+    if (index >= N) {
+        ESP_LOGE(TAG, "No room to register '%s'", metric.name());
+        return false;
+    }
+
+    slots[index] = &metric;
+    count.store(index + 1U, std::memory_order_release);
+    return true;
+}
+
+template <typename T, size_t N>
+static const T *findMetric(const std::array<T *, N> &slots, const std::atomic<size_t> &count,
+                           const char *name) {
+    const size_t used = count.load(std::memory_order_acquire);
+    for (size_t i = 0U; i < used; ++i) {
+        if (std::strcmp(slots[i]->name(), name) == 0) {
+            return slots[i];
+        }
+    }
+
+    return nullptr;
+}
+
+bool Registry::add(Counter &counter) {
+    return addMetric(mCounters, mCounterCount, counter);
+}
+
+bool Registry::add(Gauge &gauge) {
+    return addMetric(mGauges, mGaugeCount, gauge);
+}
+
+bool Registry::add(Histogram &histogram) {
+    return addMetric(mHistograms, mHistogramCount, histogram);
+}
+
+const Counter *Registry::findCounter(const char *name) const {
+    return findMetric(mCounters, mCounterCount, name);
+}
+
+const Gauge *Registry::findGauge(const char *name) const {
+    return findMetric(mGauges, mGaugeCount, name);
+}
+
+const Histogram *Registry::findHistogram(const char *name) const {
+    return findMetric(mHistograms, mHistogramCount, name);
+}
+
+template <typename Fn>
+void Registry::forEachLine(Fn &&fn) const {
+    char line[LINE_LEN];
+
+    const size_t counters = mCounterCount.load(std::memory_order_acquire);
+    for (size_t i = 0U; i < counters; ++i) {
+        std::snprintf(line, sizeof(line), "%-22s %lu", mCounters[i]->name(),
+                      static_cast<unsigned long>(mCounters[i]->value()));
+        fn(line);
+    }
+
+    const size_t gauges = mGaugeCount.load(std::memory_order_acquire);
+    for (size_t i = 0U; i < gauges; ++i) {
+        std::snprintf(line, sizeof(line), "%-22s %ld (max %ld)", mGauges[i]->name(),
+                      static_cast<long>(mGauges[i]->value()),
+                      static_cast<long>(mGauges[i]->max()));
+        fn(line);
+    }
+
+    const size_t histograms = mHistogramCount.load(std::memory_order_acquire);
+    for (size_t i = 0U; i < histograms; ++i) {
+        const Histogram::Snapshot snap = mHistograms[i]->snapshot();
+        std::snprintf(line, sizeof(line), "%-22s n=%lu mean=%lu p50=%lu p90=%lu p99=%lu max=%lu",
+                      mHistograms[i]->name(), static_cast<unsigned long>(snap.count),
+                      static_cast<unsigned long>(snap.mean()),
+                      static_cast<unsigned long>(snap.percentile(50U)),
+                      static_cast<unsigned long>(snap.percentile(90U)),
+                      static_cast<unsigned long>(snap.percentile(99U)),
+                      static_cast<unsigned long>(snap.max));
+        fn(line);
+    }
+}
+
+void Registry::print(FILE *out) const {
+    forEachLine([out](const char *line) { std::fprintf(out, "%s\n", line); });
+    std::fflush(out);
+}
+
+void Registry::logSummary() const {
+    forEachLine([](const char *line) { ESP_LOGI(TAG, "%s", line); });
+}
+
+int Registry::runCommand(int argc, char **argv) {
+    if (argc > 1 && std::strcmp(argv[1], "reset") == 0) {
+        const size_t histograms = mHistogramCount.load(std::memory_order_acquire);
+        for (size_t i = 0U; i < histograms; ++i) {
+            mHistograms[i]->reset();
+        }
+        return 0;
+    }
+
+    print(stdout);
+    return 0;
+}
+
+}  // namespace metrics
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "IDnsResolver.hpp"
+
+namespace net {
+// Resolved addresses per host name, shared by everything that opens connections. lwIP keeps
+// only a handful of entries and follows the record TTL, which for stream CDNs is often under
+// a minute; this holds them for our own TTL instead. A connect failure should forget() the
+// host so the next attempt asks again.
+class DnsCache {
+   public:
+    static constexpr size_t MAX_ENTRIES = 8U;
+    static constexpr size_t MAX_HOST_LEN = 63U;
+    static constexpr int64_t DEFAULT_TTL_US = 5LL * 60LL * 1000000LL;
+
+    explicit DnsCache(IDnsResolver &resolver, const int64_t &ttlUs = DEFAULT_TTL_US);
+
+    // Numeric hosts come straight back without a lookup
+    bool resolve(const char *host, const int64_t &nowUs, IpAddress &address);
+    void forget(const char *host);
+
+    size_t size() const;
+
+   private:
+    struct Entry {
+        std::array<char, MAX_HOST_LEN + 1U> host{};
+        IpAddress address{};
+        int64_t expiresUs = 0;
+    };
+
+    Entry *find(const char *host);
+    Entry &claim(const int64_t &nowUs);
+
+    IDnsResolver &mResolver;
+    int64_t mTtlUs;
+    std::array<Entry, MAX_ENTRIES> mEntries;
+    mutable std::mutex mMutex;
+};
+
+}  // namespace net
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+
+#include "IWifiDriver.hpp"
+
+// IDF
+#include <esp_event.h>
+#include <esp_netif.h>
+
+namespace net {
+// esp_wifi in station mode. The IDF keeps no credentials of its own (RAM storage); the
+// SSID and password come from the constructor and the AP details from WifiManager.
+class EspWifiDriver final : public IWifiDriver {
+   public:
+    // Both strings must outlive the driver, e.g. Kconfig literals
+    EspWifiDriver(const char *ssid, const char *password);
+    ~EspWifiDriver() override;
+
+    // IWifiDriver
+    bool init() override;
+    bool connect(const WifiTarget &target) override;
+    void disconnect() override;
+    WifiLinkState getState() const override;
+    bool getLink(WifiLink &link) const override;
+
+   private:
+    static void onEvent(void *arg, esp_event_base_t base, int32_t id, void *data);
+    bool configureAddress(const IpLease &lease);
+
+    const char *mSsid;
+    const char *mPassword;
+    esp_netif_t *mNetif;
+    std::atomic<WifiLinkState> mState;
+};
+
+}  // namespace net
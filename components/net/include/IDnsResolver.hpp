@@ -0,0 +1,17 @@
+#pragma once
+
+#include <array>
+
+namespace net {
+// Dotted IPv4 text, which every connect API down the stack takes in place of a host name
+using IpAddress = std::array<char, 16U>;
+
+class IDnsResolver {
+   public:
+    virtual ~IDnsResolver() = default;
+
+    // Blocks for the lookup; false when the name does not resolve
+    virtual bool resolve(const char *host, IpAddress &address) = 0;
+};
+
+}  // namespace net
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace net {
+using Bssid = std::array<uint8_t, 6U>;
+
+// IPv4 configuration handed out by DHCP, in network byte order
+struct IpLease {
+    uint32_t address = 0U;
+    uint32_t netmask = 0U;
+    uint32_t gateway = 0U;
+    uint32_t dns = 0U;
+
+    bool isValid() const {
+        return address != 0U;
+    }
+};
+
+// What one connection attempt aims at. Without a channel the driver scans every channel for
+// the SSID; with a BSSID and channel it probes just that access point. A valid lease is
+// configured statically instead of waiting for DHCP.
+struct WifiTarget {
+    Bssid bssid{};
+    uint8_t channel = 0U;  // 0 for a full scan
+    IpLease lease;
+};
+
+// The access point and address a connection ended up with
+struct WifiLink {
+    Bssid bssid{};
+    uint8_t channel = 0U;
+    IpLease lease;
+    int8_t rssiDbm = 0;
+};
+
+enum class WifiLinkState : uint8_t { Idle, Connecting, Connected, Failed };
+
+// Station-mode radio. Non-blocking: connect() starts an attempt and the caller polls
+// getState() until it is Connected (associated and addressed) or Failed.
+class IWifiDriver {
+   public:
+    virtual ~IWifiDriver() = default;
+
+    virtual bool init() = 0;
+    virtual bool connect(const WifiTarget &target) = 0;
+    virtual void disconnect() = 0;
+
+    virtual WifiLinkState getState() const = 0;
+    // Valid while Connected
+    virtual bool getLink(WifiLink &link) const = 0;
+};
+
+}  // namespace net
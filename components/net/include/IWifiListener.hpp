@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+#include "UiTypes.hpp"
+
+namespace net {
+// Receives WifiConnecting/WifiConnected/WifiError transitions, on the Wi-Fi task
+class IWifiListener {
+   public:
+    virtual ~IWifiListener() = default;
+
+    virtual void onWifiStatus(const common::UiStatusKind &kind, const int8_t &rssiDbm) = 0;
+};
+
+}  // namespace net
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "IDnsResolver.hpp"
+
+namespace net {
+// getaddrinfo, IPv4 only: lwIP on the target, the libc resolver on the host
+class SystemDnsResolver final : public IDnsResolver {
+   public:
+    // IDnsResolver
+    bool resolve(const char *host, IpAddress &address) override;
+};
+
+}  // namespace net
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace net {
+// TLS session tickets per origin, so the next connection to a stream server or the update
+// host resumes with an abbreviated handshake instead of a full one. Sessions are opaque to
+// the cache: whatever TLS stack created them hands over a release function, and the cache
+// owns a session from put() until take() gives it back or it expires.
+class TlsSessionCache {
+   public:
+    using ReleaseFn = void (*)(void *session);
+
+    static constexpr size_t MAX_ENTRIES = 4U;
+    static constexpr size_t MAX_ORIGIN_LEN = 95U;
+    static constexpr size_t MAX_SESSION_ID_LEN = 32U;
+    // Servers rarely honour a ticket for longer than this
+    static constexpr int64_t DEFAULT_LIFETIME_US = 60LL * 60LL * 1000000LL;
+
+    // Identifies a session across a reconnect: when the server resumes, the new handshake
+    // carries the same id
+    struct SessionId {
+        std::array<uint8_t, MAX_SESSION_ID_LEN> bytes{};
+        size_t len = 0U;
+
+        bool operator==(const SessionId &other) const;
+    };
+
+    explicit TlsSessionCache(ReleaseFn release,
+                             const int64_t &lifetimeUs = DEFAULT_LIFETIME_US);
+    ~TlsSessionCache();
+
+    TlsSessionCache(const TlsSessionCache &) = delete;
+    TlsSessionCache &operator=(const TlsSessionCache &) = delete;
+
+    // The session stored for an origin, ownership passes to the caller; nullptr on a miss.
+    // A ticket is good for one resumption attempt, the caller puts the next one back.
+    void *take(const char *origin, const int64_t &nowUs, SessionId *id = nullptr);
+    void put(const char *origin, void *session, const SessionId &id, const int64_t &nowUs);
+    void forget(const char *origin);
+
+    // How the handshake after take() went, for the resumption metrics
+    void noteHandshake(const bool &resumed);
+
+    size_t size() const;
+
+   private:
+    struct Entry {
+        std::array<char, MAX_ORIGIN_LEN + 1U> origin{};
+        void *session = nullptr;
+        SessionId id{};
+        int64_t expiresUs = 0;
+    };
+
+    Entry *find(const char *origin);
+    Entry &claim(const int64_t &nowUs);
+    void drop(Entry &entry);
+
+    ReleaseFn mRelease;
+    int64_t mLifetimeUs;
+    std::array<Entry, MAX_ENTRIES> mEntries;
+    mutable std::mutex mMutex;
+};
+
+}  // namespace net
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+
+#include "IWifiDriver.hpp"
+#include "UiTypes.hpp"
+
+namespace common {
+class IClock;
+class IKeyValueStore;
+}  // namespace common
+
+namespace net {
+class IWifiListener;
+
+// Timing of connection attempts. The defaults fit FR-08: a failed fast attempt plus a full
+// scan still end well inside 30 s, and a lost link is retried in the background.
+struct WifiBackoffPolicy {
+    uint32_t fastConnectTimeoutMs = 3000U;  // directed probe of the remembered AP
+    uint32_t scanConnectTimeoutMs = 15000U;
+    uint32_t initialBackoffMs = 1000U;      // after the first failed cycle
+    uint32_t maxBackoffMs = 60000U;
+    uint8_t multiplier = 2U;
+    uint8_t failuresBeforeError = 1U;       // failed cycles before WifiError is shown
+    // A remembered lease is configured statically on fast connects; after this many the
+    // next connect asks DHCP again so a changed network cannot stay stale for long
+    uint8_t maxLeaseReuses = 8U;
+};
+
+// Station connection state machine. Every cycle first tries the access point, channel and
+// IP lease of the last good connection, which skips the all-channel scan and DHCP, and
+// falls back to a full scan when that fails. Failed cycles back off exponentially. Like
+// Aht20Sensor it is stepped by poll(), which returns how long the caller may sleep.
+class WifiManager {
+   public:
+    enum class State : uint8_t { Idle, FastConnect, Scan, Connected, Backoff };
+
+    static constexpr uint8_t RECORD_VERSION = 1U;
+    static constexpr const char *RECORD_KEY = "last_ap";
+
+    WifiManager(IWifiDriver &driver, const common::IClock &clock,
+                common::IKeyValueStore *store = nullptr, IWifiListener *listener = nullptr,
+                const WifiBackoffPolicy &policy = WifiBackoffPolicy());
+
+    bool init();
+    // Starts connecting; reconnects happen on their own from then on
+    void start();
+
+    // Runs the step that is due, if any, and returns the milliseconds until the next one
+    uint32_t poll();
+
+    State getState() const;
+    uint8_t getFailedCycles() const;
+    uint32_t getBackoffMs() const;
+
+   private:
+    // What a good connection leaves behind for the next boot
+    struct Record {
+        uint8_t version = 0U;
+        uint8_t channel = 0U;
+        uint8_t leaseReuses = 0U;
+        Bssid bssid{};
+        IpLease lease;
+    };
+
+    void beginCycle(const uint64_t &nowUs);
+    void startAttempt(const State &state, const uint64_t &nowUs);
+    uint32_t stepConnecting(const uint64_t &nowUs);
+    uint32_t stepConnected(const uint64_t &nowUs);
+    void attemptFailed(const uint64_t &nowUs);
+    void onConnected(const uint64_t &nowUs);
+    void remember(const WifiLink &link);
+    void publish(const common::UiStatusKind &kind, const int8_t &rssiDbm);
+
+    bool hasRecord() const;
+    static uint32_t remainingMs(const uint64_t &deadlineUs, const uint64_t &nowUs);
+
+    IWifiDriver &mDriver;
+    const common::IClock &mClock;
+    common::IKeyValueStore *mStore;
+    IWifiListener *mListener;
+    WifiBackoffPolicy mPolicy;
+
+    State mState;
+    uint64_t mDeadlineUs;
+    uint64_t mConnectingSinceUs;  // since the link went down or start()
+    uint64_t mNextLinkCheckUs;
+    uint8_t mFailedCycles;
+    uint32_t mBackoffMs;
+    bool mLeaseOffered;
+
+    Record mRecord;
+
+    common::UiStatusKind mPublishedKind;
+    int8_t mPublishedRssi;
+};
+
+}  // namespace net
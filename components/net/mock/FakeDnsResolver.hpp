@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstring>
+#include <map>
+#include <string>
+
+#include "IDnsResolver.hpp"
+
+namespace net {
+class FakeDnsResolver : public IDnsResolver {
+   public:
+    bool resolve(const char* host, IpAddress& address) override {
+        ++mLookups;
+        const auto entry = mRecords.find(host);
+        if (entry == mRecords.end()) {
+            return false;
+        }
+        address = IpAddress{};
+        std::strncpy(address.data(), entry->second.c_str(), address.size() - 1U);
+        return true;
+    }
+
+    void setRecord(const std::string& host, const std::string& address) {
+        mRecords[host] = address;
+    }
+
+    int lookups() const {
+        return mLookups;
+    }
+
+   private:
+    std::map<std::string, std::string> mRecords;
+    int mLookups = 0;
+};
+
+}  // namespace net
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vector>
+
+#include "IClock.hpp"
+#include "IWifiDriver.hpp"
+
+namespace net {
+// Radio with scripted timing: each kind of attempt ends after its delay on the given clock,
+// either connected, failed, or never (the caller's timeout has to end it)
+class FakeWifiDriver : public IWifiDriver {
+   public:
+    enum class Outcome { Connect, Fail, Hang };
+
+    struct Script {
+        Outcome outcome = Outcome::Connect;
+        uint32_t delayMs = 0U;
+    };
+
+    explicit FakeWifiDriver(const common::IClock& clock) : mClock(clock) {}
+
+    bool init() override {
+        return true;
+    }
+
+    bool connect(const WifiTarget& target) override {
+        mAttempts.push_back(target);
+        mStartedUs = mClock.nowUs();
+        mActive = (target.channel != 0U) ? mFast : mScan;
+        mConnecting = true;
+        mLinkDropped = false;
+        return true;
+    }
+
+    void disconnect() override {
+        mConnecting = false;
+    }
+
+    WifiLinkState getState() const override {
+        if (mLinkDropped) {
+            return WifiLinkState::Failed;
+        }
+        if (!mConnecting) {
+            return WifiLinkState::Idle;
+        }
+        if (mClock.nowUs() < mStartedUs + static_cast<uint64_t>(mActive.delayMs) * 1000U) {
+            return WifiLinkState::Connecting;
+        }
+        switch (mActive.outcome) {
+            case Outcome::Connect:
+                return WifiLinkState::Connected;
+            case Outcome::Fail:
+                return WifiLinkState::Failed;
+            default:
+                return WifiLinkState::Connecting;
+        }
+    }
+
+    bool getLink(WifiLink& link) const override {
+        link = mLink;
+        // A static lease is what the interface ends up with
+        const WifiTarget& last = mAttempts.back();
+        if (last.lease.isValid()) {
+            link.lease = last.lease;
+        }
+        return getState() == WifiLinkState::Connected;
+    }
+
+    void scriptFast(const Outcome& outcome, const uint32_t& delayMs) {
+        mFast = {outcome, delayMs};
+    }
+
+    void scriptScan(const Outcome& outcome, const uint32_t& delayMs) {
+        mScan = {outcome, delayMs};
+    }
+
+    void setLink(const WifiLink& link) {
+        mLink = link;
+    }
+
+    void setRssi(const int8_t& rssiDbm) {
+        mLink.rssiDbm = rssiDbm;
+    }
+
+    // The AP goes away under an established link
+    void dropLink() {
+        mLinkDropped = true;
+        mConnecting = false;
+    }
+
+    const std::vector<WifiTarget>& attempts() const {
+        return mAttempts;
+    }
+
+   private:
+    const common::IClock& mClock;
+    Script mFast;
+    Script mScan;
+    Script mActive;
+    WifiLink mLink;
+    std::vector<WifiTarget> mAttempts;
+    uint64_t mStartedUs = 0U;
+    bool mConnecting = false;
+    bool mLinkDropped = false;
+};
+
+}  // namespace net
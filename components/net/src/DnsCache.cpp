@@ -0,0 +1,95 @@
+#include "DnsCache.hpp"
+
+#include <arpa/inet.h>
+#include <cstring>
+
+#include "Metrics.hpp"
+
+namespace net {
+static metrics::Counter sHits("net.dns_hits");
+static metrics::Counter sMisses("net.dns_misses");
+
+DnsCache::DnsCache(IDnsResolver &resolver, const int64_t &ttlUs)
+    : mResolver(resolver), mTtlUs(ttlUs), mEntries(), mMutex() {}
+
+bool DnsCache::resolve(const char *host, const int64_t &nowUs, IpAddress &address) {
+    in_addr numeric = {};
+    if (inet_pton(AF_INET, host, &numeric) == 1) {
+        address = IpAddress{};
+        std::strncpy(address.data(), host, address.size() - 1U);
+        return true;
+    }
+    if (std::strlen(host) > MAX_HOST_LEN) {
+        return mResolver.resolve(host, address);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const Entry *entry = find(host);
+        if (entry != nullptr && nowUs < entry->expiresUs) {
+            address = entry->address;
+            sHits.add();
+            return true;
+        }
+    }
+    sMisses.add();
+
+    // Not under the lock: a lookup can take seconds and other hosts should not wait on it
+    IpAddress resolved{};
+    if (!mResolver.resolve(host, resolved)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    Entry *entry = find(host);
+    if (entry == nullptr) {
+        entry = &claim(nowUs);
+        std::strncpy(entry->host.data(), host, MAX_HOST_LEN);
+    }
+    entry->address = resolved;
+    entry->expiresUs = nowUs + mTtlUs;
+    address = resolved;
+    return true;
+}
+
+void DnsCache::forget(const char *host) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    Entry *entry = find(host);
+    if (entry != nullptr) {
+        *entry = Entry();
+    }
+}
+
+size_t DnsCache::size() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    size_t count = 0U;
+    for (const Entry &entry : mEntries) {
+        count += (entry.host[0] != '\0') ? 1U : 0U;
+    }
+    return count;
+}
+
+DnsCache::Entry *DnsCache::find(const char *host) {
+    for (Entry &entry : mEntries) {
+        if (entry.host[0] != '\0' && std::strcmp(entry.host.data(), host) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+DnsCache::Entry &DnsCache::claim(const int64_t &nowUs) {
+    // A free or expired slot, else the one closest to expiry
+    Entry *victim = &mEntries[0];
+    for (Entry &entry : mEntries) {
+        if (entry.host[0] == '\0' || entry.expiresUs <= nowUs) {
+            return entry;
+        }
+        if (entry.expiresUs < victim->expiresUs) {
+            victim = &entry;
+        }
+    }
+    return *victim;
+}
+
+}  // namespace net
@@ -0,0 +1,158 @@
+#include "EspWifiDriver.hpp"
+
+#include <cstring>
+
+// IDF
+#include <esp_log.h>
+#include <esp_wifi.h>
+
+namespace net {
+static const char *TAG = "EspWifiDriver";
+
+EspWifiDriver::EspWifiDriver(const char *ssid, const char *password)
+    : mSsid(ssid), mPassword(password), mNetif(nullptr), mState(WifiLinkState::Idle) {}
+
+EspWifiDriver::~EspWifiDriver() {
+    esp_event_handler_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, onEvent);
+    esp_event_handler_unregister(IP_EVENT, IP_EVENT_STA_GOT_IP, onEvent);
+}
+
+bool EspWifiDriver::init() {
+    esp_err_t err = esp_netif_init();
+    if (err == ESP_OK) {
+        // Someone else may have created the default loop already
+        err = esp_event_loop_create_default();
+        err = (err == ESP_ERR_INVALID_STATE) ? ESP_OK : err;
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Network stack init failed: %s", esp_err_to_name(err));
+        return false;
+    }
+
+    mNetif = esp_netif_create_default_wifi_sta();
+    const wifi_init_config_t config = WIFI_INIT_CONFIG_DEFAULT();
+    err = esp_wifi_init(&config);
+    if (err == ESP_OK) {
+        err = esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID, onEvent, this);
+    }
+    if (err == ESP_OK) {
+        err = esp_event_handler_register(IP_EVENT, IP_EVENT_STA_GOT_IP, onEvent, this);
+    }
+    if (err == ESP_OK) {
+        err = esp_wifi_set_storage(WIFI_STORAGE_RAM);
+    }
+    if (err == ESP_OK) {
+        err = esp_wifi_set_mode(WIFI_MODE_STA);
+    }
+    if (err == ESP_OK) {
+        err = esp_wifi_start();
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Wi-Fi init failed: %s", esp_err_to_name(err));
+        return false;
+    }
+    return true;
+}
+
+bool EspWifiDriver::connect(const WifiTarget &target) {
+    wifi_config_t config = {};
+    std::strncpy(reinterpret_cast<char *>(config.sta.ssid), mSsid, sizeof(config.sta.ssid));
+    std::strncpy(reinterpret_cast<char *>(config.sta.password), mPassword,
+                 sizeof(config.sta.password));
+    config.sta.sort_method = WIFI_CONNECT_AP_BY_SIGNAL;
+    if (target.channel != 0U) {
+        // Probe the one AP on its channel instead of sweeping all of them
+        config.sta.channel = target.channel;
+        config.sta.bssid_set = true;
+        std::memcpy(config.sta.bssid, target.bssid.data(), target.bssid.size());
+        config.sta.scan_method = WIFI_FAST_SCAN;
+    } else {
+        config.sta.scan_method = WIFI_ALL_CHANNEL_SCAN;
+    }
+
+    if (!configureAddress(target.lease)) {
+        return false;
+    }
+
+    mState = WifiLinkState::Connecting;
+    esp_err_t err = esp_wifi_set_config(WIFI_IF_STA, &config);
+    if (err == ESP_OK) {
+        err = esp_wifi_connect();
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Connect failed to start: %s", esp_err_to_name(err));
+        mState = WifiLinkState::Failed;
+        return false;
+    }
+    return true;
+}
+
+void EspWifiDriver::disconnect() {
+    mState = WifiLinkState::Idle;
+    esp_wifi_disconnect();
+}
+
+WifiLinkState EspWifiDriver::getState() const {
+    return mState.load();
+}
+
+bool EspWifiDriver::getLink(WifiLink &link) const {
+    wifi_ap_record_t ap = {};
+    esp_netif_ip_info_t ip = {};
+    esp_netif_dns_info_t dns = {};
+    if (mState.load() != WifiLinkState::Connected || esp_wifi_sta_get_ap_info(&ap) != ESP_OK ||
+        esp_netif_get_ip_info(mNetif, &ip) != ESP_OK) {
+        return false;
+    }
+    esp_netif_get_dns_info(mNetif, ESP_NETIF_DNS_MAIN, &dns);
+
+    std::memcpy(link.bssid.data(), ap.bssid, link.bssid.size());
+    link.channel = ap.primary;
+    link.rssiDbm = ap.rssi;
+    link.lease.address = ip.ip.addr;
+    link.lease.netmask = ip.netmask.addr;
+    link.lease.gateway = ip.gw.addr;
+    link.lease.dns = dns.ip.u_addr.ip4.addr;
+    return true;
+}
+
+void EspWifiDriver::onEvent(void *arg, esp_event_base_t base, int32_t id, void *data) {
+    auto *pThis = static_cast<EspWifiDriver *>(arg);
+
+    if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP) {
+        pThis->mState = WifiLinkState::Connected;
+    } else if (base == WIFI_EVENT && id == WIFI_EVENT_STA_DISCONNECTED) {
+        const auto *event = static_cast<const wifi_event_sta_disconnected_t *>(data);
+        // Our own disconnect() is not a failure of the next attempt
+        if (event->reason != WIFI_REASON_ASSOC_LEAVE &&
+            pThis->mState.load() != WifiLinkState::Idle) {
+            ESP_LOGW(TAG, "Disconnected, reason %u", event->reason);
+            pThis->mState = WifiLinkState::Failed;
+        }
+    }
+}
+
+bool EspWifiDriver::configureAddress(const IpLease &lease) {
+    if (!lease.isValid()) {
+        const esp_err_t err = esp_netif_dhcpc_start(mNetif);
+        return err == ESP_OK || err == ESP_ERR_ESP_NETIF_DHCP_ALREADY_STARTED;
+    }
+
+    // A static address is reported with IP_EVENT_STA_GOT_IP as soon as the link is up
+    esp_netif_dhcpc_stop(mNetif);
+    esp_netif_ip_info_t ip = {};
+    ip.ip.addr = lease.address;
+    ip.netmask.addr = lease.netmask;
+    ip.gw.addr = lease.gateway;
+    esp_netif_dns_info_t dns = {};
+    dns.ip.type = ESP_IPADDR_TYPE_V4;
+    dns.ip.u_addr.ip4.addr = lease.dns;
+    if (esp_netif_set_ip_info(mNetif, &ip) != ESP_OK ||
+        esp_netif_set_dns_info(mNetif, ESP_NETIF_DNS_MAIN, &dns) != ESP_OK) {
+        ESP_LOGW(TAG, "Cannot apply the remembered lease");
+        return false;
+    }
+    return true;
+}
+
+}  // namespace net
@@ -0,0 +1,32 @@
+#include "SystemDnsResolver.hpp"
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+
+// IDF
+#include <esp_log.h>
+
+namespace net {
+static const char *TAG = "SystemDnsResolver";
+
+bool SystemDnsResolver::resolve(const char *host, IpAddress &address) {
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo *result = nullptr;
+    const int err = getaddrinfo(host, nullptr, &hints, &result);
+    if (err != 0 || result == nullptr) {
+        ESP_LOGW(TAG, "Cannot resolve %s: %d", host, err);
+        return false;
+    }
+
+    const sockaddr_in *ipv4 = reinterpret_cast<const sockaddr_in *>(result->ai_addr);
+    const bool ok =
+        inet_ntop(AF_INET, &ipv4->sin_addr, address.data(), address.size()) != nullptr;
+    freeaddrinfo(result);
+    return ok;
+}
+
+}  // namespace net
@@ -0,0 +1,120 @@
+#include "TlsSessionCache.hpp"
+
+#include <cstring>
+
+#include "Metrics.hpp"
+
+namespace net {
+static metrics::Counter sHits("net.tls_session_hits");
+static metrics::Counter sMisses("net.tls_session_misses");
+static metrics::Counter sResumed("net.tls_resumed");
+static metrics::Counter sFull("net.tls_full");
+
+bool TlsSessionCache::SessionId::operator==(const SessionId &other) const {
+    return len == other.len && std::memcmp(bytes.data(), other.bytes.data(), len) == 0;
+}
+
+TlsSessionCache::TlsSessionCache(ReleaseFn release, const int64_t &lifetimeUs)
+    : mRelease(release), mLifetimeUs(lifetimeUs), mEntries(), mMutex() {}
+
+TlsSessionCache::~TlsSessionCache() {
+    for (Entry &entry : mEntries) {
+        drop(entry);
+    }
+}
+
+void *TlsSessionCache::take(const char *origin, const int64_t &nowUs, SessionId *id) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    Entry *entry = find(origin);
+    if (entry != nullptr && nowUs >= entry->expiresUs) {
+        drop(*entry);
+        entry = nullptr;
+    }
+    if (entry == nullptr) {
+        sMisses.add();
+        return nullptr;
+    }
+
+    sHits.add();
+    void *session = entry->session;
+    if (id != nullptr) {
+        *id = entry->id;
+    }
+    *entry = Entry();
+    return session;
+}
+
+void TlsSessionCache::put(const char *origin, void *session, const SessionId &id,
+                          const int64_t &nowUs) {
+    if (session == nullptr) {
+        return;
+    }
+    if (std::strlen(origin) > MAX_ORIGIN_LEN) {
+        mRelease(session);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    Entry *entry = find(origin);
+    if (entry == nullptr) {
+        entry = &claim(nowUs);
+    }
+    drop(*entry);
+
+    std::strncpy(entry->origin.data(), origin, MAX_ORIGIN_LEN);
+    entry->session = session;
+    entry->id = id;
+    entry->expiresUs = nowUs + mLifetimeUs;
+}
+
+void TlsSessionCache::forget(const char *origin) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    Entry *entry = find(origin);
+    if (entry != nullptr) {
+        drop(*entry);
+    }
+}
+
+void TlsSessionCache::noteHandshake(const bool &resumed) {
+    (resumed ? sResumed : sFull).add();
+}
+
+size_t TlsSessionCache::size() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    size_t count = 0U;
+    for (const Entry &entry : mEntries) {
+        count += (entry.session != nullptr) ? 1U : 0U;
+    }
+    return count;
+}
+
+TlsSessionCache::Entry *TlsSessionCache::find(const char *origin) {
+    for (Entry &entry : mEntries) {
+        if (entry.session != nullptr && std::strcmp(entry.origin.data(), origin) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+TlsSessionCache::Entry &TlsSessionCache::claim(const int64_t &nowUs) {
+    Entry *victim = &mEntries[0];
+    for (Entry &entry : mEntries) {
+        if (entry.session == nullptr || entry.expiresUs <= nowUs) {
+            return entry;
+        }
+        if (entry.expiresUs < victim->expiresUs) {
+            victim = &entry;
+        }
+    }
+    return *victim;
+}
+
+void TlsSessionCache::drop(Entry &entry) {
+    if (entry.session != nullptr) {
+        mRelease(entry.session);
+    }
+    entry = Entry();
+}
+
+}  // namespace net
@@ -0,0 +1,261 @@
+#include "WifiManager.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "IClock.hpp"
+#include "IKeyValueStore.hpp"
+#include "IWifiListener.hpp"
+#include "Metrics.hpp"
+
+// IDF
+#include <esp_log.h>
+
+namespace net {
+static const char *TAG = "WifiManager";
+
+static constexpr uint32_t IDLE_POLL_MS = 1000U;
+static constexpr uint32_t CONNECTING_POLL_MS = 50U;
+static constexpr uint32_t LINK_CHECK_MS = 2000U;
+// Smaller RSSI changes are not worth a status bar redraw
+static constexpr int RSSI_STEP_DB = 4;
+
+static constexpr std::array<uint32_t, 9> CONNECT_BUCKETS_MS = {
+    250U, 500U, 1000U, 2000U, 3000U, 5000U, 10000U, 20000U, 30000U};
+
+static metrics::Counter sFastConnects("wifi.fast_connects");
+static metrics::Counter sScanConnects("wifi.scan_connects");
+static metrics::Counter sFastFallbacks("wifi.fast_fallbacks");
+static metrics::Counter sFailedCycles("wifi.failed_cycles");
+static metrics::Counter sLinkLosses("wifi.link_losses");
+static metrics::Histogram sConnectMs("wifi.connect_ms", CONNECT_BUCKETS_MS);
+
+static bool sameLease(const IpLease &a, const IpLease &b) {
+    return a.address == b.address && a.netmask == b.netmask && a.gateway == b.gateway &&
+           a.dns == b.dns;
+}
+
+WifiManager::WifiManager(IWifiDriver &driver, const common::IClock &clock,
+                         common::IKeyValueStore *store, IWifiListener *listener,
+                         const WifiBackoffPolicy &policy)
+    : mDriver(driver),
+      mClock(clock),
+      mStore(store),
+      mListener(listener),
+      mPolicy(policy),
+      mState(State::Idle),
+      mDeadlineUs(0U),
+      mConnectingSinceUs(0U),
+      mNextLinkCheckUs(0U),
+      mFailedCycles(0U),
+      mBackoffMs(0U),
+      mLeaseOffered(false),
+      mRecord(),
+      mPublishedKind(common::UiStatusKind::Booting),
+      mPublishedRssi(0) {}
+
+bool WifiManager::init() {
+    if (!mDriver.init()) {
+        ESP_LOGE(TAG, "Wi-Fi driver init failed");
+        return false;
+    }
+
+    Record record;
+    if (mStore != nullptr && mStore->load(RECORD_KEY, &record, sizeof(record)) == sizeof(record) &&
+        record.version == RECORD_VERSION) {
+        mRecord = record;
+        ESP_LOGI(TAG, "Last AP on channel %u, lease %s", mRecord.channel,
+                 mRecord.lease.isValid() ? "kept" : "none");
+    }
+    return true;
+}
+
+void WifiManager::start() {
+    const uint64_t nowUs = mClock.nowUs();
+    mConnectingSinceUs = nowUs;
+    publish(common::UiStatusKind::WifiConnecting, 0);
+    beginCycle(nowUs);
+}
+
+uint32_t WifiManager::poll() {
+    const uint64_t nowUs = mClock.nowUs();
+
+    switch (mState) {
+        case State::FastConnect:
+        case State::Scan:
+            return stepConnecting(nowUs);
+        case State::Connected:
+            return stepConnected(nowUs);
+        case State::Backoff:
+            if (nowUs < mDeadlineUs) {
+                return remainingMs(mDeadlineUs, nowUs);
+            }
+            beginCycle(nowUs);
+            return CONNECTING_POLL_MS;
+        case State::Idle:
+        default:
+            return IDLE_POLL_MS;
+    }
+}
+
+WifiManager::State WifiManager::getState() const {
+    return mState;
+}
+
+uint8_t WifiManager::getFailedCycles() const {
+    return mFailedCycles;
+}
+
+uint32_t WifiManager::getBackoffMs() const {
+    return mBackoffMs;
+}
+
+void WifiManager::beginCycle(const uint64_t &nowUs) {
+    startAttempt(hasRecord() ? State::FastConnect : State::Scan, nowUs);
+}
+
+void WifiManager::startAttempt(const State &state, const uint64_t &nowUs) {
+    WifiTarget target;
+    mLeaseOffered = false;
+    if (state == State::FastConnect) {
+        target.bssid = mRecord.bssid;
+        target.channel = mRecord.channel;
+        if (mRecord.lease.isValid() && mRecord.leaseReuses < mPolicy.maxLeaseReuses) {
+            target.lease = mRecord.lease;
+            mLeaseOffered = true;
+        }
+    }
+
+    const uint32_t timeoutMs = (state == State::FastConnect) ? mPolicy.fastConnectTimeoutMs
+                                                             : mPolicy.scanConnectTimeoutMs;
+    mState = state;
+    mDeadlineUs = nowUs + static_cast<uint64_t>(timeoutMs) * 1000U;
+    ESP_LOGI(TAG, "%s", (state == State::FastConnect) ? "Fast connect to last AP" : "Scanning");
+
+    if (!mDriver.connect(target)) {
+        attemptFailed(nowUs);
+    }
+}
+
+uint32_t WifiManager::stepConnecting(const uint64_t &nowUs) {
+    const WifiLinkState link = mDriver.getState();
+    if (link == WifiLinkState::Connected) {
+        onConnected(nowUs);
+        return LINK_CHECK_MS;
+    }
+    if (link == WifiLinkState::Failed || nowUs >= mDeadlineUs) {
+        attemptFailed(nowUs);
+        return (mState == State::Backoff) ? mBackoffMs : CONNECTING_POLL_MS;
+    }
+    return std::min(CONNECTING_POLL_MS, remainingMs(mDeadlineUs, nowUs));
+}
+
+uint32_t WifiManager::stepConnected(const uint64_t &nowUs) {
+    if (mDriver.getState() != WifiLinkState::Connected) {
+        ESP_LOGW(TAG, "Link lost, reconnecting");
+        sLinkLosses.add();
+        mConnectingSinceUs = nowUs;
+        publish(common::UiStatusKind::WifiConnecting, 0);
+        beginCycle(nowUs);
+        return CONNECTING_POLL_MS;
+    }
+
+    if (nowUs >= mNextLinkCheckUs) {
+        mNextLinkCheckUs = nowUs + LINK_CHECK_MS * 1000U;
+        WifiLink link;
+        if (mDriver.getLink(link) && std::abs(link.rssiDbm - mPublishedRssi) >= RSSI_STEP_DB) {
+            publish(common::UiStatusKind::WifiConnected, link.rssiDbm);
+        }
+    }
+    return LINK_CHECK_MS;
+}
+
+void WifiManager::attemptFailed(const uint64_t &nowUs) {
+    mDriver.disconnect();
+
+    if (mState == State::FastConnect) {
+        // The AP moved channel, went away or the lease is no longer ours: a full scan with
+        // DHCP settles all of it, and a success replaces the record
+        ESP_LOGW(TAG, "Fast connect failed, falling back to a full scan");
+        sFastFallbacks.add();
+        mRecord.lease = IpLease();
+        startAttempt(State::Scan, nowUs);
+        return;
+    }
+
+    sFailedCycles.add();
+    if (mFailedCycles < UINT8_MAX) {
+        ++mFailedCycles;
+    }
+    if (mFailedCycles >= mPolicy.failuresBeforeError) {
+        publish(common::UiStatusKind::WifiError, 0);
+    }
+
+    uint64_t backoffMs = mPolicy.initialBackoffMs;
+    for (uint8_t i = 1U; i < mFailedCycles && backoffMs < mPolicy.maxBackoffMs; ++i) {
+        backoffMs *= mPolicy.multiplier;
+    }
+    mBackoffMs = static_cast<uint32_t>(std::min<uint64_t>(backoffMs, mPolicy.maxBackoffMs));
+    ESP_LOGW(TAG, "Connect failed %u time(s), retrying in %u ms", mFailedCycles, mBackoffMs);
+
+    mState = State::Backoff;
+    mDeadlineUs = nowUs + static_cast<uint64_t>(mBackoffMs) * 1000U;
+}
+
+void WifiManager::onConnected(const uint64_t &nowUs) {
+    WifiLink link;
+    mDriver.getLink(link);
+
+    const uint32_t elapsedMs = static_cast<uint32_t>((nowUs - mConnectingSinceUs) / 1000U);
+    sConnectMs.record(elapsedMs);
+    (mState == State::FastConnect ? sFastConnects : sScanConnects).add();
+    ESP_LOGI(TAG, "Connected after %u ms (%s), channel %u, RSSI %d dBm", elapsedMs,
+             (mState == State::FastConnect) ? "fast" : "scan", link.channel, link.rssiDbm);
+
+    mState = State::Connected;
+    mFailedCycles = 0U;
+    mBackoffMs = 0U;
+    mNextLinkCheckUs = nowUs + LINK_CHECK_MS * 1000U;
+    remember(link);
+    publish(common::UiStatusKind::WifiConnected, link.rssiDbm);
+}
+
+void WifiManager::remember(const WifiLink &link) {
+    Record record;
+    record.version = RECORD_VERSION;
+    record.channel = link.channel;
+    record.bssid = link.bssid;
+    record.lease = link.lease;
+    record.leaseReuses = mLeaseOffered ? static_cast<uint8_t>(mRecord.leaseReuses + 1U) : 0U;
+
+    const bool changed = record.version != mRecord.version ||
+                         record.channel != mRecord.channel || record.bssid != mRecord.bssid ||
+                         !sameLease(record.lease, mRecord.lease) ||
+                         record.leaseReuses != mRecord.leaseReuses;
+    mRecord = record;
+    if (changed && mStore != nullptr && !mStore->save(RECORD_KEY, &mRecord, sizeof(mRecord))) {
+        ESP_LOGW(TAG, "Cannot persist the last AP");
+    }
+}
+
+void WifiManager::publish(const common::UiStatusKind &kind, const int8_t &rssiDbm) {
+    if (kind == mPublishedKind && rssiDbm == mPublishedRssi) {
+        return;
+    }
+    mPublishedKind = kind;
+    mPublishedRssi = rssiDbm;
+    if (mListener != nullptr) {
+        mListener->onWifiStatus(kind, rssiDbm);
+    }
+}
+
+bool WifiManager::hasRecord() const {
+    return mRecord.version == RECORD_VERSION && mRecord.channel != 0U;
+}
+
+uint32_t WifiManager::remainingMs(const uint64_t &deadlineUs, const uint64_t &nowUs) {
+    return (deadlineUs > nowUs) ? static_cast<uint32_t>((deadlineUs - nowUs + 999U) / 1000U)
+                                : 0U;
+}
+
+}  // namespace net
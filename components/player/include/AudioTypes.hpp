@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace player {
+static constexpr uint8_t MAX_CHANNELS = 2U;
+static constexpr size_t MAX_URL_LEN = 255U;
+
+// Interleaved signed 16-bit PCM, the only sample layout between the decoder and the sink
+struct AudioFormat {
+    uint32_t sampleRate = 0U;
+    uint8_t channels = 0U;
+
+    bool isValid() const {
+        return sampleRate != 0U && channels != 0U && channels <= MAX_CHANNELS;
+    }
+    size_t frameBytes() const {
+        return static_cast<size_t>(channels) * sizeof(int16_t);
+    }
+    bool operator==(const AudioFormat &other) const {
+        return sampleRate == other.sampleRate && channels == other.channels;
+    }
+    bool operator!=(const AudioFormat &other) const {
+        return !(*this == other);
+    }
+};
+
+struct PlayerCommand {
+    // Play restarts the sink, Switch replaces the stream under a running sink
+    enum class Type : uint8_t { Play, Stop, Switch };
+
+    Type type = Type::Stop;
+    std::array<char, MAX_URL_LEN + 1U> url{};  // null-terminated
+    int64_t postedUs = 0;                      // for the command latency histogram
+};
+
+enum class PlayerState : uint8_t {
+    Stopped,
+    Playing,  // a stream is open and feeding the ring
+    Ended,    // the source reached its end, what is buffered still plays out
+    Failed,   // the source could not be opened
+};
+
+}  // namespace player
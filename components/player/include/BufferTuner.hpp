@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace player {
+// What the output buffering is made of: the I2S DMA ring and the encoded bytes the decoder
+// waits for before it starts a stream
+struct BufferSettings {
+    uint16_t dmaDescriptors = 0U;
+    uint16_t dmaFrames = 0U;  // per descriptor
+    uint32_t decodeAheadBytes = 0U;
+
+    uint32_t dmaFramesTotal() const {
+        return static_cast<uint32_t>(dmaDescriptors) * dmaFrames;
+    }
+    bool operator==(const BufferSettings &other) const {
+        return dmaDescriptors == other.dmaDescriptors && dmaFrames == other.dmaFrames &&
+               decodeAheadBytes == other.decodeAheadBytes;
+    }
+    bool operator!=(const BufferSettings &other) const {
+        return !(*this == other);
+    }
+};
+
+struct BufferBounds {
+    BufferSettings min;
+    BufferSettings max;
+};
+
+// Output telemetry over one observation window
+struct BufferWindow {
+    uint32_t underruns = 0U;
+    uint16_t minFillPermille = 1000U;  // lowest DMA fill seen
+};
+
+// Keeps underruns near zero at the least buffering that achieves it. An underrun grows the
+// DMA ring by half (descriptors first, then descriptor size) and doubles the decode-ahead; a
+// near miss only raises the decode-ahead; a run of clean windows with the DMA never below
+// half full gives back one step (descriptor size first, then count) and a quarter of the
+// decode-ahead. Every change is kept in a short history for the log.
+class BufferTuner {
+   public:
+    enum class Reason : uint8_t { Initial, Underrun, NearMiss, Headroom };
+
+    struct Change {
+        int64_t atUs;
+        BufferSettings settings;
+        Reason reason;
+        BufferWindow window;
+    };
+
+    static constexpr size_t HISTORY_SIZE = 16U;
+    static constexpr uint16_t NEAR_MISS_PERMILLE = 125U;
+    static constexpr uint16_t HEADROOM_PERMILLE = 500U;
+    static constexpr uint32_t SHRINK_AFTER_WINDOWS = 10U;
+
+    // 48 kHz: 5 to 20 ms per descriptor, the IDF default of 6 x 240 frames to start with
+    static constexpr BufferBounds DEFAULT_BOUNDS = {{4U, 240U, 4096U}, {16U, 960U, 24576U}};
+    static constexpr BufferSettings DEFAULT_SETTINGS = {6U, 240U, 8192U};
+
+    BufferTuner(const BufferBounds &bounds, const BufferSettings &initial);
+
+    // Feeds one window; returns true when the settings changed
+    bool update(const BufferWindow &window, const int64_t &nowUs);
+
+    const BufferSettings &getSettings() const;
+
+    // Oldest first
+    size_t getHistoryCount() const;
+    const Change &getHistory(const size_t &index) const;
+    void logHistory() const;
+
+   private:
+    BufferSettings grow(const BufferSettings &from) const;
+    BufferSettings shrink(const BufferSettings &from) const;
+    void record(const int64_t &nowUs, const Reason &reason, const BufferWindow &window);
+
+    BufferBounds mBounds;
+    BufferSettings mSettings;
+    uint32_t mCleanWindows;
+
+    std::array<Change, HISTORY_SIZE> mHistory;
+    size_t mHistoryCount;  // total recorded, the ring keeps the newest HISTORY_SIZE
+};
+
+}  // namespace player
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace player {
+// Lock-free single-producer/single-consumer byte ring over caller-owned storage, for bulk
+// copies between the source and decode tasks. The capacity must be a power of two; the
+// indices run freely so the whole capacity is usable.
+class ByteRing {
+   public:
+    ByteRing(uint8_t *storage, const size_t &capacity);
+
+    // Producer side; returns the bytes copied, short when the ring fills up
+    size_t write(const uint8_t *data, const size_t &len);
+
+    // Consumer side; returns the bytes copied, short when the ring runs dry
+    size_t read(uint8_t *dst, const size_t &len);
+
+    // Consumer side: drops everything buffered so far
+    void clear();
+
+    size_t size() const;
+    size_t space() const;
+    size_t capacity() const;
+
+   private:
+    uint8_t *mStorage;
+    size_t mCapacity;
+    std::atomic<size_t> mHead{0U};  // written by the producer
+    std::atomic<size_t> mTail{0U};  // written by the consumer
+};
+
+}  // namespace player
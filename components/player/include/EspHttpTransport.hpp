@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+
+#include "AudioTypes.hpp"
+#include "HttpWire.hpp"
+#include "IHttpTransport.hpp"
+#include "TlsSessionCache.hpp"
+
+// IDF
+#include <esp_tls.h>
+
+namespace net {
+class DnsCache;
+}  // namespace net
+
+namespace player {
+// HTTP/1.1 over esp_tls with a small pool of connections, one per origin. A redirector and
+// the stream server it points to each keep their own, so resolving the next station reuses
+// the redirector's connection. When one has to be opened, the address comes from the DNS
+// cache and the handshake resumes the TLS session saved for that origin, which skips the
+// certificate chain and the expensive half of the key exchange.
+class EspHttpTransport final : public IHttpTransport {
+   public:
+    static constexpr size_t POOL_SIZE = 2U;
+    static constexpr size_t MAX_ORIGIN_LEN = 96U;
+    static constexpr size_t RX_BUFFER_SIZE = 2048U;
+
+    EspHttpTransport(net::DnsCache &dns, net::TlsSessionCache &sessions);
+    ~EspHttpTransport() override;
+
+    // For the session cache: the sessions it holds come from here
+    static void releaseSession(void *session);
+
+    // IHttpTransport
+    bool request(const char *url, HttpResponseHead &head) override;
+    int32_t read(uint8_t *dst, const size_t &len) override;
+    void finish(const bool &reuse) override;
+
+   private:
+    using Origin = std::array<char, MAX_ORIGIN_LEN>;
+
+    struct Connection {
+        esp_tls_t *tls = nullptr;
+        int64_t lastUsedUs = 0;
+        Origin origin{};
+        HttpResponseParser parser;
+        std::array<uint8_t, RX_BUFFER_SIZE> rx{};
+        size_t rxStart = 0U;  // body bytes that arrived with the head
+        size_t rxEnd = 0U;
+    };
+
+    Connection &connectionFor(const Origin &origin);
+    bool connect(Connection &connection, const UrlParts &parts);
+    void saveSession(Connection &connection, const net::TlsSessionCache::SessionId *offered);
+    bool exchange(Connection &connection, const UrlParts &parts, HttpResponseHead &head);
+    int32_t receive(Connection &connection, uint8_t *dst, const size_t &len);
+    void close(Connection &connection);
+
+    net::DnsCache &mDns;
+    net::TlsSessionCache &mSessions;
+    std::array<Connection, POOL_SIZE> mPool;
+    Connection *mActive;
+};
+
+}  // namespace player
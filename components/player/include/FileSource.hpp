@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdio>
+
+#include "IAudioSource.hpp"
+
+namespace player {
+// Plays a local file: a host path, or a VFS mount on the board. Takes "file://" URLs too.
+class FileSource final : public IAudioSource {
+   public:
+    FileSource();
+    ~FileSource() override;
+
+    // IAudioSource
+    bool open(const char *url) override;
+    int32_t read(uint8_t *dst, const size_t &len) override;
+    void close() override;
+
+   private:
+    FILE *mFile;
+};
+
+}  // namespace player
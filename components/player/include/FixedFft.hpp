@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace player {
+// In-place radix-2 FFT on Q15 samples, for the spectrum display. Every stage halves its
+// outputs, so nothing can overflow and the result is the DFT divided by N. Instantiated in
+// FixedFft.cpp for 64, 128 and 256 points.
+template <size_t N>
+class FixedFft {
+    static_assert(N >= 64U && N <= 256U && (N & (N - 1U)) == 0U,
+                  "FFT size must be a power of two from 64 to 256");
+
+   public:
+    static constexpr size_t POINTS = N;
+    static constexpr size_t BINS = N / 2U;  // up to, not including, the Nyquist bin
+
+    // Builds the twiddle and bit-reversal tables
+    FixedFft();
+
+    void transform(int16_t *re, int16_t *im) const;
+
+    // Squared magnitude of bins 0..BINS-1 of a transformed block
+    static void power(const int16_t *re, const int16_t *im, uint32_t *out);
+
+   private:
+    std::array<int16_t, N / 2U> mCos;
+    std::array<int16_t, N / 2U> mSin;
+    std::array<uint8_t, N> mReversed;
+};
+
+extern template class FixedFft<64U>;
+extern template class FixedFft<128U>;
+extern template class FixedFft<256U>;
+
+}  // namespace player
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+
+#include "AudioTypes.hpp"
+#include "IAudioSource.hpp"
+#include "IHttpTransport.hpp"
+#include "IStreamPreopener.hpp"
+
+namespace player {
+class RedirectCache;
+
+// HTTP(S) stream reader. Follows redirects itself and, with a cache, remembers where a
+// station URL led so the next open skips the redirector; a remembered target that fails is
+// forgotten and the station URL is tried again.
+class HttpSource final : public IAudioSource, public IStreamPreopener {
+   public:
+    static constexpr int MAX_REDIRECTS = 4;
+    // A pre-opened stream left waiting longer has filled the server's send buffer and may
+    // have been dropped; opening afresh is safer
+    static constexpr int64_t PREOPEN_TTL_US = 5000000;
+
+    explicit HttpSource(IHttpTransport &transport, RedirectCache *cache = nullptr);
+    ~HttpSource() override;
+
+    // IAudioSource
+    bool open(const char *url) override;
+    int32_t read(uint8_t *dst, const size_t &len) override;
+    void close() override;
+
+    // IStreamPreopener, from another task than the player's: opening is serialised, reading
+    // is left to whoever opened last
+    bool preopen(const char *url) override;
+
+    // Where the current stream really comes from
+    const char *getStreamUrl() const;
+
+   private:
+    bool openLocked(const char *url);
+    bool openFollowing(const char *start, const char *stationUrl);
+    void closeLocked();
+
+    IHttpTransport &mTransport;
+    RedirectCache *mCache;
+    bool mOpen;
+    int64_t mOpenedUs;  // 0 once the first byte was timed
+    std::array<char, MAX_URL_LEN + 1U> mUrl;
+    std::array<char, MAX_URL_LEN + 1U> mPreopenedUrl;  // station URL, empty when none
+    int64_t mPreopenedUs;
+    std::mutex mOpenMutex;
+};
+
+}  // namespace player
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "IHttpTransport.hpp"
+
+namespace player {
+struct UrlParts {
+    static constexpr size_t MAX_HOST_LEN = 63U;
+
+    bool secure = false;
+    uint16_t port = 0U;
+    std::array<char, MAX_HOST_LEN + 1U> host{};
+    const char *path = "/";  // points into the parsed URL
+};
+
+// The bits of HTTP/1.1 a stream client needs, independent of the socket underneath
+class HttpWire {
+   public:
+    // http[s]://host[:port][/path]
+    static bool parseUrl(const char *url, UrlParts &parts);
+    // "scheme://host:port", the key connections and TLS sessions are kept under
+    static size_t formatOrigin(const UrlParts &parts, char *dst, const size_t &capacity);
+    // GET with keep-alive; 0 when it does not fit
+    static size_t formatRequest(const UrlParts &parts, char *dst, const size_t &capacity);
+};
+
+// Response reader fed with whatever arrives: first the head, then the body with any chunk
+// framing stripped
+class HttpResponseParser {
+   public:
+    static constexpr size_t MAX_LINE_LEN = 511U;
+
+    HttpResponseParser();
+
+    void reset();
+
+    // Bytes of data used for the head; whatever follows once the head is done is body
+    size_t feedHead(const char *data, const size_t &len);
+    bool isHeadDone() const;
+    bool hasFailed() const;
+    const HttpResponseHead &getHead() const;
+    // Whether the connection can carry another request once the body is read
+    bool isKeepAlive() const;
+
+    // Strips chunk framing in place and returns the payload bytes left at the front
+    size_t decodeBody(uint8_t *data, const size_t &len);
+    bool isBodyComplete() const;
+
+   private:
+    enum class State : uint8_t {
+        StatusLine,
+        Headers,
+        Body,       // Content-Length or until the connection closes
+        ChunkSize,
+        ChunkData,
+        ChunkEnd,   // CRLF after the data
+        Trailers,
+        Done,
+        Failed,
+    };
+
+    bool takeLine(const char &c);
+    void parseStatusLine();
+    void parseHeader();
+    void startBody();
+
+    State mState;
+    HttpResponseHead mHead;
+    bool mKeepAlive;
+    bool mChunked;
+    int64_t mRemaining;  // of the body or the current chunk, -1 when open-ended
+    std::array<char, MAX_LINE_LEN + 1U> mLine;
+    size_t mLineLen;
+};
+
+}  // namespace player
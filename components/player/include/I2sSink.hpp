@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+
+#include "BufferTuner.hpp"
+#include "IAudioSink.hpp"
+#include "IBufferTelemetry.hpp"
+
+// IDF
+#include <driver/i2s_std.h>
+
+namespace player {
+// Standard (Philips) I2S output to an external DAC. Counts underruns and tracks how full the
+// DMA ring runs, and rebuilds the channel when the tuner picks other DMA settings.
+class I2sSink final : public IAudioSink, public IBufferTelemetry {
+   public:
+    I2sSink(const int &port, const int &bclkGpio, const int &wsGpio, const int &doutGpio);
+    ~I2sSink() override;
+
+    bool init();
+
+    // IAudioSink, decode task
+    bool configure(const AudioFormat &format) override;
+    void write(const int16_t *pcm, const size_t &frames) override;
+    void stop() override;
+
+    // IBufferTelemetry, decode task
+    BufferWindow takeWindow() override;
+    void applySettings(const BufferSettings &settings) override;
+
+   private:
+    static bool onDmaSent(i2s_chan_handle_t channel, i2s_event_data_t *event, void *context);
+    static bool onDmaUnderrun(i2s_chan_handle_t channel, i2s_event_data_t *event,
+                              void *context);
+
+    bool createChannel();
+    bool rebuildChannel();
+    uint32_t dmaCapacityBytes() const;
+
+    int mPort;
+    int mBclkGpio;
+    int mWsGpio;
+    int mDoutGpio;
+
+    i2s_chan_handle_t mChannel;
+    AudioFormat mFormat;
+    bool mInitialized;  // std mode set up once, later formats reconfigure it
+    bool mEnabled;
+
+    BufferSettings mDma;         // what the channel was built with
+    BufferSettings mPendingDma;  // smaller settings wait for the next stop
+    bool mShrinkPending;
+
+    // Shared with the DMA interrupt
+    std::atomic<uint32_t> mQueuedBytes;
+    std::atomic<uint32_t> mCapacityBytes;
+    std::atomic<uint32_t> mUnderruns;
+    std::atomic<uint16_t> mMinFillPermille;
+};
+
+}  // namespace player
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "AudioTypes.hpp"
+
+namespace player {
+// Turns encoded bytes into PCM; runs on the decode core
+class IAudioDecoder {
+   public:
+    static constexpr int32_t DECODE_ERROR = -1;
+
+    virtual ~IAudioDecoder() = default;
+
+    // Forget the current stream, the next bytes start a new one
+    virtual void reset() = 0;
+
+    // Decodes from in and sets consumed to the bytes used. Returns the frames written to pcm
+    // (at most maxFrames); 0 with nothing consumed means more input is needed. DECODE_ERROR
+    // when the stream cannot be decoded, until the next reset.
+    virtual int32_t decode(const uint8_t *in, const size_t &len, size_t &consumed, int16_t *pcm,
+                           const size_t &maxFrames) = 0;
+
+    // Format of the frames returned so far
+    virtual AudioFormat getFormat() const = 0;
+};
+
+}  // namespace player
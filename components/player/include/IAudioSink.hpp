@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "AudioTypes.hpp"
+
+namespace player {
+// Where the PCM goes: I2S on the board, a file or nothing on the host
+class IAudioSink {
+   public:
+    virtual ~IAudioSink() = default;
+
+    // Starts the sink, or retunes it if it is already running
+    virtual bool configure(const AudioFormat &format) = 0;
+
+    // Blocks until all frames are queued
+    virtual void write(const int16_t *pcm, const size_t &frames) = 0;
+
+    virtual void stop() = 0;
+};
+
+}  // namespace player
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace player {
+// Byte stream feeding the ring buffer; runs on the network core
+class IAudioSource {
+   public:
+    static constexpr int32_t END_OF_STREAM = -1;
+
+    virtual ~IAudioSource() = default;
+
+    virtual bool open(const char *url) = 0;
+
+    // Bytes copied into dst, 0 if nothing arrived in time, END_OF_STREAM when the stream is
+    // over or broken
+    virtual int32_t read(uint8_t *dst, const size_t &len) = 0;
+
+    virtual void close() = 0;
+};
+
+}  // namespace player
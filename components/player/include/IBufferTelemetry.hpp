@@ -0,0 +1,20 @@
+#pragma once
+
+#include "BufferTuner.hpp"
+
+namespace player {
+// Implemented by sinks with a clock of their own: what the output saw, and the DMA buffering
+// it should use
+class IBufferTelemetry {
+   public:
+    virtual ~IBufferTelemetry() = default;
+
+    // Underruns and lowest fill since the previous call
+    virtual BufferWindow takeWindow() = 0;
+
+    // Growth may apply at once, since an underrun has just been heard anyway; a sink can
+    // leave shrinking for its next restart
+    virtual void applySettings(const BufferSettings &settings) = 0;
+};
+
+}  // namespace player
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "AudioTypes.hpp"
+
+namespace player {
+struct HttpResponseHead {
+    int status = 0;
+    int64_t contentLength = -1;                     // -1 for an open-ended body
+    std::array<char, MAX_URL_LEN + 1U> location{};  // absolute, set on redirects
+};
+
+// Plain GET exchanges, one at a time. Implementations keep connections alive between
+// exchanges and reuse one when the next request goes to the same scheme, host and port.
+class IHttpTransport {
+   public:
+    virtual ~IHttpTransport() = default;
+
+    // Sends the request and reads the response head; false when no response came
+    virtual bool request(const char *url, HttpResponseHead &head) = 0;
+
+    // Body of the current response, same contract as IAudioSource::read
+    virtual int32_t read(uint8_t *dst, const size_t &len) = 0;
+
+    // Done with the current response. With reuse the rest of the body is drained and the
+    // connection stays open; an endless stream body has to be dropped instead.
+    virtual void finish(const bool &reuse) = 0;
+};
+
+}  // namespace player
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "AudioTypes.hpp"
+
+namespace player {
+// In-place PCM post-processing between the decoder and the sink
+class IPcmStage {
+   public:
+    virtual ~IPcmStage() = default;
+
+    // Called on the decode task whenever the stream format changes; returns the format the
+    // stage produces from it
+    virtual AudioFormat configure(const AudioFormat &input) = 0;
+
+    // Processes frames in place. pcm has room for capacity frames of the larger of the input
+    // and output formats. Returns the frames now in pcm.
+    virtual size_t process(int16_t *pcm, const size_t &frames, const size_t &capacity) = 0;
+};
+
+}  // namespace player
@@ -0,0 +1,15 @@
+#pragma once
+
+namespace player {
+// Wakes the stage tasks; every call must return without blocking
+class IPipelineListener {
+   public:
+    virtual ~IPipelineListener() = default;
+
+    virtual void onCommandPosted() = 0;   // source side has a command to apply
+    virtual void onDataAvailable() = 0;   // decoder side has bytes or a stream change to take
+    virtual void onSpaceAvailable() = 0;  // source side can write again
+    virtual void onStandbyRequested() = 0;  // standby side has a stream to open or drop
+};
+
+}  // namespace player
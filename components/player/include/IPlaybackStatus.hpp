@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+namespace player {
+// What the output has done so far; safe to read from any task
+class IPlaybackStatus {
+   public:
+    virtual ~IPlaybackStatus() = default;
+
+    // Microseconds since boot when the first sample reached the sink, 0 until then
+    virtual int64_t getFirstAudioUs() const = 0;
+};
+
+}  // namespace player
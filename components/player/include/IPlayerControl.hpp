@@ -0,0 +1,16 @@
+#pragma once
+
+namespace player {
+// Commands from the application, from one task at a time other than the player's own.
+// A command is only refused when it cannot be carried out at all, never for being too many.
+class IPlayerControl {
+   public:
+    virtual ~IPlayerControl() = default;
+
+    virtual bool play(const char *url) = 0;
+    virtual bool switchTo(const char *url) = 0;
+    virtual bool stop() = 0;
+    virtual void setVolume(const int &percent) = 0;
+};
+
+}  // namespace player
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace player {
+// Opens a station ahead of the player: connection, handshake, redirects and the response
+// head are done, the body waits. The next open of the same URL picks the stream up instead
+// of starting over.
+class IStreamPreopener {
+   public:
+    virtual ~IStreamPreopener() = default;
+
+    virtual bool preopen(const char *url) = 0;
+};
+
+}  // namespace player
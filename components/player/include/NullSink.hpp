@@ -0,0 +1,28 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "IAudioSink.hpp"
+
+namespace player {
+// Swallows PCM as fast as it comes; measures the pipeline without an output clock
+class NullSink final : public IAudioSink {
+   public:
+    NullSink();
+
+    // IAudioSink
+    bool configure(const AudioFormat &format) override;
+    void write(const int16_t *pcm, const size_t &frames) override;
+    void stop() override;
+
+    // Any task
+    uint64_t getFramesWritten() const;
+    bool isRunning() const;
+
+   private:
+    std::atomic<uint64_t> mFramesWritten;
+    std::atomic<bool> mRunning;
+};
+
+}  // namespace player
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "AudioTypes.hpp"
+#include "IPlaybackStatus.hpp"
+#include "IPlayerControl.hpp"
+#include "LatestSlot.hpp"
+#include "SpscQueue.hpp"
+#include "VolumeStage.hpp"
+
+namespace player {
+class BufferTuner;
+class ByteRing;
+class IBufferTelemetry;
+class IAudioDecoder;
+class IAudioSink;
+class IAudioSource;
+class IPcmStage;
+class IPipelineListener;
+
+// Source -> ring -> decoder -> PCM stages -> sink. The pipeline owns no task: the source
+// side (runSourceStep) and the decode side (runDecodeStep) are stepped by one thread each,
+// so the network and the codec can live on different cores. Commands reach the source side
+// through a lock-free slot that every command overwrites, so the newest one always wins
+// however long the source side is stuck in an open; a stream change is handed to the decode side by
+// bumping a generation, which the decoder acknowledges once it has dropped the old stream.
+//
+// With a standby stream, switching is make-before-break: a third side (runStandbyStep)
+// opens the new station into a ring of its own while the current one keeps playing, and
+// the source side cuts over once that ring holds the start watermark. The decoder fades the
+// old stream out and the new one in across one block boundary. A switch superseded by a
+// newer command is dropped as soon as its open returns, before any of its body is read.
+class PlayerPipeline final : public IPlayerControl, public IPlaybackStatus {
+   public:
+    static constexpr size_t STANDBY_QUEUE_SIZE = 8U;
+    static constexpr size_t CHUNK_SIZE = 1024U;          // bytes per source read
+    static constexpr size_t INPUT_SIZE = 2048U;          // encoded bytes handed to the decoder
+    static constexpr size_t MAX_DECODE_FRAMES = 256U;    // frames per decode call
+    static constexpr size_t PCM_CAPACITY_FRAMES = 1024U;  // headroom for upsampling stages
+    static constexpr size_t MAX_PCM_STAGES = 4U;
+    static constexpr int64_t TUNING_WINDOW_US = 1000000;
+    static constexpr size_t FADE_FRAMES = 256U;  // per side of a cutover, ~6 ms at 44.1 kHz
+
+    PlayerPipeline(IAudioSource &source, IAudioDecoder &decoder, IAudioSink &sink,
+                   ByteRing &ring);
+
+    // Before the stage threads start. Stages run in order, volume always comes last.
+    bool addPcmStage(IPcmStage &stage);
+    void setListener(IPipelineListener *listener);
+
+    // Optional, before the stage threads start. The decode side feeds the tuner one window of
+    // output telemetry at a time and applies what it decides: the DMA settings to the sink,
+    // the decode-ahead target to itself.
+    void setBufferTuning(BufferTuner *tuner, IBufferTelemetry *telemetry,
+                         const int64_t &windowUs = TUNING_WINDOW_US);
+
+    // Optional, before the stage threads start: a second source and ring, which switches
+    // open ahead and which trade places with the playing ones at each cutover
+    void setStandby(IAudioSource &source, ByteRing &ring);
+
+    // IPlayerControl, one producer task at a time; only fails on a URL longer than MAX_URL_LEN
+    bool play(const char *url) override;
+    bool switchTo(const char *url) override;
+    bool stop() override;
+    void setVolume(const int &percent) override;
+
+    // IPlaybackStatus
+    int64_t getFirstAudioUs() const override;
+
+    // Source thread: applies commands and moves one chunk into the ring. Returns false when
+    // there was nothing to do; the caller then waits for onCommandPosted/onSpaceAvailable.
+    bool runSourceStep();
+
+    // Decode thread: decodes one buffer and hands it through the stages to the sink.
+    // Returns false when the ring is dry; the caller then waits for onDataAvailable.
+    bool runDecodeStep();
+
+    // Standby thread: opens the newest switch target, or fills its ring up to the start
+    // watermark. Returns false when idle; the caller then waits for onStandbyRequested.
+    bool runStandbyStep();
+
+    PlayerState getState() const;
+    size_t getDecodeAheadBytes() const;
+
+   private:
+    struct Stream {
+        IAudioSource *source;
+        ByteRing *ring;
+    };
+
+    // A switch handed from the source side to the standby side
+    struct StandbyRequest {
+        std::array<char, MAX_URL_LEN + 1U> url{};
+        uint32_t sequence = 0U;
+        uint8_t slot = 0U;
+    };
+
+    bool post(const PlayerCommand::Type &type, const char *url);
+    bool applyCommands();
+    bool fillRing();
+    void publish(const PlayerState &state, const bool &restartSink, const int64_t &postedUs,
+                 const bool &cutover);
+    bool applyStandbyResult();
+    void cancelStandby();
+    bool fillStandby();
+    void fadeOutOldStream();
+    void resync(const uint32_t &generation);
+    bool configureOutput(const AudioFormat &format);
+    bool waitForDecodeAhead();
+    void tuneBuffers();
+    void applyBufferSettings();
+
+    IAudioDecoder &mDecoder;
+    IAudioSink &mSink;
+    std::array<Stream, 2> mStreams;  // [1] only with a standby
+    IPipelineListener *mListener;
+    BufferTuner *mTuner;
+    IBufferTelemetry *mTelemetry;
+    int64_t mTuningWindowUs;
+
+    std::array<IPcmStage *, MAX_PCM_STAGES + 1U> mStages;
+    size_t mStageCount;
+    VolumeStage mVolume;
+
+    // Newest command not yet applied. Commands posted before the source side takes it
+    // collapse into it; any Play or Stop among them leaves mCommandRestartsSink set, so the
+    // sink still restarts.
+    common::LatestSlot<PlayerCommand> mCommands;
+    std::atomic<bool> mCommandRestartsSink;
+
+    common::SpscQueue<StandbyRequest, STANDBY_QUEUE_SIZE> mStandbyRequests;
+
+    // Handshake between the two sides; written by the source side unless noted
+    std::atomic<uint32_t> mGeneration;
+    std::atomic<uint32_t> mDecoderGeneration;  // decode side
+    std::atomic<bool> mRestartSink;
+    std::atomic<bool> mStopRequested;
+    std::atomic<int64_t> mCommandPostedUs;
+    std::atomic<PlayerState> mState;
+    std::atomic<int64_t> mFirstAudioUs;  // decode side
+    std::atomic<uint8_t> mActive;        // stream the source side feeds
+    std::atomic<bool> mCutover;          // the new generation continues on the standby ring
+    std::atomic<size_t> mStartWatermark;  // decode side
+
+    // Handshake with the standby side. Every command bumps the switch sequence, which
+    // cancels whatever the standby side holds unless it is the stream being cut over to.
+    std::atomic<uint32_t> mSwitchSequence;
+    std::atomic<uint32_t> mCutoverSequence;
+    std::atomic<uint32_t> mStandbyReady;   // standby side
+    std::atomic<uint32_t> mStandbyFailed;  // standby side
+    std::atomic<bool> mStandbyEnded;       // standby side, before mStandbyReady
+
+    // Source side
+    bool mSourceOpen;
+    std::array<uint8_t, CHUNK_SIZE> mChunk;
+    size_t mChunkLen;
+    size_t mChunkPos;
+    bool mSwitchPending;   // waits for the decoder to let go of the standby ring
+    bool mSwitchInFlight;  // handed to the standby side, no result yet
+    StandbyRequest mPendingSwitch;
+    int64_t mSwitchPostedUs;
+
+    // Decode side
+    std::array<uint8_t, INPUT_SIZE> mInput;
+    size_t mInputLen;
+    std::array<int16_t, PCM_CAPACITY_FRAMES * MAX_CHANNELS> mPcm;
+    AudioFormat mInputFormat;
+    AudioFormat mOutputFormat;
+    bool mSinkRunning;
+    bool mDecodeFailed;
+    int64_t mLatencyStartUs;  // command waiting for its first frame at the sink
+    size_t mDecodeAheadBytes;
+    bool mPrebuffering;  // holding back until the ring reaches the decode-ahead target
+    int64_t mWindowStartUs;
+    uint8_t mDecoding;  // stream whose ring is read
+    bool mFadeIn;
+
+    // Standby side
+    uint32_t mStandbyJob;  // sequence of the stream held, 0 when none
+    uint8_t mStandbySlot;
+    bool mStandbyOpen;
+    bool mStandbyPublished;
+    std::array<uint8_t, CHUNK_SIZE> mStandbyChunk;
+    size_t mStandbyChunkLen;
+    size_t mStandbyChunkPos;
+};
+
+}  // namespace player
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "AudioTypes.hpp"
+#include "Memory.hpp"
+
+namespace common {
+class IKeyValueStore;
+}  // namespace common
+
+namespace player {
+// Where a station URL finally led, so the next play goes straight there. Entries live in
+// PSRAM and expire after the TTL; with a store they are also written through, keyed by a
+// hash of the station URL. The clock restarts on boot, so a persisted entry counts as fresh
+// from the moment it is read back: it is only a hint, and the caller falls back to the
+// station URL and forgets it when it no longer works. Shared by the playing and the standby
+// source, so every call locks.
+class RedirectCache {
+   public:
+    using Url = std::array<char, MAX_URL_LEN + 1U>;
+
+    static constexpr size_t MAX_ENTRIES = 8U;
+    // Stream servers behind the redirectors stay valid for hours; half an hour keeps the
+    // load balancing they do mostly intact
+    static constexpr int64_t DEFAULT_TTL_US = 30LL * 60LL * 1000000LL;
+
+    explicit RedirectCache(const int64_t &ttlUs = DEFAULT_TTL_US,
+                           common::IKeyValueStore *store = nullptr);
+
+    bool init();
+
+    // Final URL for a station URL if a fresh one is known
+    bool lookup(const char *url, const int64_t &nowUs, Url &target);
+    void remember(const char *url, const char *target, const int64_t &nowUs);
+    void forget(const char *url);
+
+    size_t size() const;
+
+   private:
+    struct Entry {
+        Url url;
+        Url target;
+        int64_t expiresUs;
+    };
+    // What goes to the store: no expiry, see above
+    struct Persisted {
+        Url url;
+        Url target;
+    };
+    using Key = std::array<char, 10U>;
+
+    static Key keyFor(const char *url);
+    Entry *find(const char *url);
+    void forgetLocked(const char *url);
+    Entry &claim(const int64_t &nowUs);
+
+    int64_t mTtlUs;
+    common::IKeyValueStore *mStore;
+    memory::Buffer<Entry, memory::MemoryClass::Psram> mEntries;
+    mutable std::mutex mMutex;
+};
+
+}  // namespace player
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "IPcmStage.hpp"
+
+namespace player {
+// Streaming rational-ratio sample-rate converter to one fixed output rate, so the I2S clock
+// never changes between stations. The ratio reduces to L/M; a windowed-sinc low-pass is
+// split into L phases of TAPS Q15 coefficients, and each output frame takes the phase for
+// its position between two input frames. History carries over between buffers; tables and
+// buffers are sized at compile time and the coefficients are computed once per format.
+class Resampler final : public IPcmStage {
+   public:
+    static constexpr size_t TAPS = 32U;             // coefficients per phase, in input frames
+    static constexpr uint32_t MAX_PHASES = 320U;    // 22.05 kHz -> 48 kHz
+    static constexpr uint32_t MAX_UPSAMPLE = 4U;    // output frames per input frame, at most
+    static constexpr size_t MAX_INPUT_FRAMES = 1024U;  // per process() call
+
+    explicit Resampler(const uint32_t &outputRate);
+
+    // IPcmStage, decode task. A ratio outside the limits above passes through unchanged and
+    // leaves the sink to follow the stream rate.
+    AudioFormat configure(const AudioFormat &input) override;
+    size_t process(int16_t *pcm, const size_t &frames, const size_t &capacity) override;
+
+    bool isBypassed() const;
+    uint32_t getUpFactor() const;
+    uint32_t getDownFactor() const;
+
+   private:
+    void designFilter();
+
+    uint32_t mOutputRate;
+    AudioFormat mInput;
+    bool mBypass;
+    uint32_t mUp;    // L
+    uint32_t mDown;  // M
+    uint32_t mPhase;
+    size_t mHistoryFrames;
+
+    std::array<int16_t, MAX_PHASES * TAPS> mCoefficients;
+    std::array<int16_t, (MAX_INPUT_FRAMES + TAPS) * MAX_CHANNELS> mHistory;
+};
+
+}  // namespace player
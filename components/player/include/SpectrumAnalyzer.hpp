@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "FixedFft.hpp"
+
+namespace player {
+class SpectrumTap;
+
+// Turns the newest tap window into bar levels: Hann window, FFT, bins grouped into
+// log-spaced bands, peak power per band on a dB scale. Bars rise at once and fall at a
+// fixed rate per frame, so the display does not flicker. Runs on its own low-priority
+// task, never on the decoder's.
+class SpectrumAnalyzer {
+   public:
+    static constexpr size_t FFT_POINTS = 128U;
+    static constexpr size_t BARS = 16U;
+    static constexpr uint8_t MAX_LEVEL = 255U;
+    // Level drop per frame once the band went quiet, a full bar falls in about 12 frames
+    static constexpr uint8_t FALL_PER_FRAME = 22U;
+
+    using Fft = FixedFft<FFT_POINTS>;
+    using Levels = std::array<uint8_t, BARS>;
+    // First bin of each band, plus one past the last
+    using BandEdges = std::array<uint16_t, BARS + 1U>;
+
+    explicit SpectrumAnalyzer(const SpectrumTap &tap);
+
+    // One display frame. Returns false when no new audio arrived and every bar is down, so
+    // the caller can stop drawing
+    bool update(Levels &levels);
+
+    const BandEdges &getBandEdges() const;
+
+    // Level of a bin power: full scale sine 255, 48 dB below it and silence 0
+    static uint8_t toLevel(const uint32_t &power);
+    // Peak level of the bins in each band
+    static void mapBars(const uint32_t *power, const BandEdges &edges, Levels &levels);
+
+   private:
+    const SpectrumTap &mTap;
+    Fft mFft;
+    BandEdges mEdges;
+    std::array<int16_t, FFT_POINTS> mWindow;  // Q15 Hann
+    std::array<int16_t, FFT_POINTS> mRe;
+    std::array<int16_t, FFT_POINTS> mIm;
+    std::array<uint32_t, Fft::BINS> mPower;
+    uint32_t mLastWritten;
+    Levels mLevels;
+};
+
+}  // namespace player
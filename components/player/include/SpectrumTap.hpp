@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "IPcmStage.hpp"
+
+namespace player {
+// Read-only PCM stage feeding the spectrum display. The decode task mixes each block to
+// mono, averages DECIMATION frames into one sample and appends it to a ring it overwrites
+// without ever waiting; the analyser copies the newest samples out from its own task and
+// notices when the decoder lapped it meanwhile. The PCM passes through untouched.
+class SpectrumTap final : public IPcmStage {
+   public:
+    // 44.1 kHz output leaves 11 kHz here, bars reach up to 5.5 kHz
+    static constexpr size_t DECIMATION = 4U;
+    static constexpr size_t CAPACITY = 512U;  // samples, a power of two
+
+    SpectrumTap();
+
+    // IPcmStage, decode task
+    AudioFormat configure(const AudioFormat &input) override;
+    size_t process(int16_t *pcm, const size_t &frames, const size_t &capacity) override;
+
+    // Any task. Copies the newest count samples into dst, oldest first; false while fewer
+    // were written or when the decoder overwrote them during the copy
+    bool readLatest(int16_t *dst, const size_t &count) const;
+    // Samples appended since start, wraps
+    uint32_t getWritten() const;
+    // Of the decimated samples, 0 before the first stream
+    uint32_t getSampleRate() const;
+
+   private:
+    static_assert((CAPACITY & (CAPACITY - 1U)) == 0U, "Capacity must be a power of two");
+
+    // Decode task only
+    uint8_t mChannels;
+    int32_t mSum;
+    size_t mSummed;
+
+    std::array<std::atomic<int16_t>, CAPACITY> mRing;
+    std::atomic<uint32_t> mWritten;
+    std::atomic<uint32_t> mSampleRate;
+};
+
+}  // namespace player
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "IPcmStage.hpp"
+
+namespace player {
+// Q15 software volume, the last PCM stage before the sink
+class VolumeStage final : public IPcmStage {
+   public:
+    static constexpr int32_t UNITY_GAIN = 1 << 15;
+
+    VolumeStage();
+
+    // Any task; takes effect with the next buffer
+    void setVolume(const int &percent);
+    int32_t getGain() const;
+
+    // IPcmStage, decode task
+    AudioFormat configure(const AudioFormat &input) override;
+    size_t process(int16_t *pcm, const size_t &frames, const size_t &capacity) override;
+
+   private:
+    AudioFormat mFormat;
+    std::atomic<int32_t> mGain;
+};
+
+}  // namespace player
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "IAudioDecoder.hpp"
+
+namespace player {
+// RIFF/WAVE with 16-bit PCM data. Streams without a codec pass straight through, which is
+// what the host pipeline plays; compressed codecs plug in behind the same interface.
+class WavDecoder final : public IAudioDecoder {
+   public:
+    WavDecoder();
+
+    // IAudioDecoder
+    void reset() override;
+    int32_t decode(const uint8_t *in, const size_t &len, size_t &consumed, int16_t *pcm,
+                   const size_t &maxFrames) override;
+    AudioFormat getFormat() const override;
+
+   private:
+    enum class State : uint8_t { Riff, Chunks, Data, Trailer, Failed };
+
+    // Returns the header bytes used, 0 when more are needed
+    size_t parseHeader(const uint8_t *in, const size_t &len);
+    size_t parseFormat(const uint8_t *body, const uint32_t &size);
+    size_t fail(const char *reason);
+
+    State mState;
+    AudioFormat mFormat;
+    uint32_t mSkip;           // bytes of an ignored chunk still to pass over
+    uint32_t mDataRemaining;  // bytes left in the data chunk
+    bool mDataUnbounded;      // live streams leave the data size open
+};
+
+}  // namespace player
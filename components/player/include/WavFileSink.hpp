@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "IAudioSink.hpp"
+
+namespace player {
+// Records what the pipeline plays into a WAV file, one file per configure()
+class WavFileSink final : public IAudioSink {
+   public:
+    explicit WavFileSink(const std::string &path);
+    ~WavFileSink() override;
+
+    // IAudioSink
+    bool configure(const AudioFormat &format) override;
+    void write(const int16_t *pcm, const size_t &frames) override;
+    void stop() override;
+
+   private:
+    void writeHeader();
+
+    std::string mPath;
+    FILE *mFile;
+    AudioFormat mFormat;
+    uint32_t mDataBytes;
+};
+
+}  // namespace player
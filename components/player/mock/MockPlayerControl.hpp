@@ -0,0 +1,16 @@
+#pragma once
+
+#include <gmock/gmock.h>
+
+#include "IPlayerControl.hpp"
+
+namespace player {
+class MockPlayerControl : public IPlayerControl {
+   public:
+    MOCK_METHOD(bool, play, (const char *), (override));
+    MOCK_METHOD(bool, switchTo, (const char *), (override));
+    MOCK_METHOD(bool, stop, (), (override));
+    MOCK_METHOD(void, setVolume, (const int &), (override));
+};
+
+}  // namespace player
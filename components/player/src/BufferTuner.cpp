@@ -0,0 +1,139 @@
+#include "BufferTuner.hpp"
+
+#include <algorithm>
+
+// IDF
+#include <esp_log.h>
+
+namespace player {
+static const char *TAG = "BufferTuner";
+
+static const char *reasonName(const BufferTuner::Reason &reason) {
+    switch (reason) {
+        case BufferTuner::Reason::Initial:
+            return "initial";
+        case BufferTuner::Reason::Underrun:
+            return "underrun";
+        case BufferTuner::Reason::NearMiss:
+            return "near miss";
+        case BufferTuner::Reason::Headroom:
+            return "headroom";
+    }
+    return "?";
+}
+
+template <typename T>
+static T clampTo(const uint32_t &value, const T &low, const T &high) {
+    return static_cast<T>(std::clamp<uint32_t>(value, low, high));
+}
+
+BufferTuner::BufferTuner(const BufferBounds &bounds, const BufferSettings &initial)
+    : mBounds(bounds), mSettings(), mCleanWindows(0U), mHistory{}, mHistoryCount(0U) {
+    mSettings.dmaDescriptors =
+        clampTo(initial.dmaDescriptors, bounds.min.dmaDescriptors, bounds.max.dmaDescriptors);
+    mSettings.dmaFrames = clampTo(initial.dmaFrames, bounds.min.dmaFrames, bounds.max.dmaFrames);
+    mSettings.decodeAheadBytes = clampTo(initial.decodeAheadBytes, bounds.min.decodeAheadBytes,
+                                         bounds.max.decodeAheadBytes);
+    record(0, Reason::Initial, BufferWindow());
+}
+
+bool BufferTuner::update(const BufferWindow &window, const int64_t &nowUs) {
+    BufferSettings next = mSettings;
+    Reason reason = Reason::Initial;
+
+    if (window.underruns > 0U) {
+        next = grow(mSettings);
+        reason = Reason::Underrun;
+        mCleanWindows = 0U;
+    } else if (window.minFillPermille < NEAR_MISS_PERMILLE) {
+        // The DMA nearly ran dry: more in reserve before the ring has to get bigger
+        next.decodeAheadBytes = clampTo(mSettings.decodeAheadBytes * 2U,
+                                        mBounds.min.decodeAheadBytes,
+                                        mBounds.max.decodeAheadBytes);
+        reason = Reason::NearMiss;
+        mCleanWindows = 0U;
+    } else if (window.minFillPermille >= HEADROOM_PERMILLE &&
+               ++mCleanWindows >= SHRINK_AFTER_WINDOWS) {
+        next = shrink(mSettings);
+        reason = Reason::Headroom;
+        mCleanWindows = 0U;
+    } else if (window.minFillPermille < HEADROOM_PERMILLE) {
+        mCleanWindows = 0U;
+    }
+
+    if (next == mSettings) {
+        return false;
+    }
+
+    mSettings = next;
+    record(nowUs, reason, window);
+    return true;
+}
+
+BufferSettings BufferTuner::grow(const BufferSettings &from) const {
+    BufferSettings next = from;
+    const uint32_t step = std::max<uint32_t>(1U, from.dmaDescriptors / 2U);
+    if (from.dmaDescriptors < mBounds.max.dmaDescriptors) {
+        next.dmaDescriptors = clampTo(from.dmaDescriptors + step, mBounds.min.dmaDescriptors,
+                                      mBounds.max.dmaDescriptors);
+    } else {
+        next.dmaFrames = clampTo(from.dmaFrames + from.dmaFrames / 2U, mBounds.min.dmaFrames,
+                                 mBounds.max.dmaFrames);
+    }
+    next.decodeAheadBytes = clampTo(from.decodeAheadBytes * 2U, mBounds.min.decodeAheadBytes,
+                                    mBounds.max.decodeAheadBytes);
+    return next;
+}
+
+BufferSettings BufferTuner::shrink(const BufferSettings &from) const {
+    // Large descriptors go first: fewer, bigger DMA interrupts are what growth left behind
+    BufferSettings next = from;
+    if (from.dmaFrames > mBounds.min.dmaFrames) {
+        next.dmaFrames = clampTo(from.dmaFrames - from.dmaFrames / 3U, mBounds.min.dmaFrames,
+                                 mBounds.max.dmaFrames);
+    } else {
+        next.dmaDescriptors = clampTo(from.dmaDescriptors - 1U, mBounds.min.dmaDescriptors,
+                                      mBounds.max.dmaDescriptors);
+    }
+    next.decodeAheadBytes =
+        clampTo(from.decodeAheadBytes - from.decodeAheadBytes / 4U, mBounds.min.decodeAheadBytes,
+                mBounds.max.decodeAheadBytes);
+    return next;
+}
+
+void BufferTuner::record(const int64_t &nowUs, const Reason &reason,
+                         const BufferWindow &window) {
+    mHistory[mHistoryCount % HISTORY_SIZE] = {nowUs, mSettings, reason, window};
+    ++mHistoryCount;
+
+    ESP_LOGI(TAG, "DMA %u x %u frames, decode-ahead %u B (%s: %u underruns, min fill %u%%)",
+             mSettings.dmaDescriptors, mSettings.dmaFrames,
+             static_cast<unsigned>(mSettings.decodeAheadBytes), reasonName(reason),
+             static_cast<unsigned>(window.underruns), window.minFillPermille / 10U);
+}
+
+const BufferSettings &BufferTuner::getSettings() const {
+    return mSettings;
+}
+
+size_t BufferTuner::getHistoryCount() const {
+    return std::min(mHistoryCount, HISTORY_SIZE);
+}
+
+const BufferTuner::Change &BufferTuner::getHistory(const size_t &index) const {
+    const size_t oldest = (mHistoryCount > HISTORY_SIZE) ? mHistoryCount - HISTORY_SIZE : 0U;
+    return mHistory[(oldest + index) % HISTORY_SIZE];
+}
+
+void BufferTuner::logHistory() const {
+    ESP_LOGI(TAG, "Buffer history, %zu changes:", mHistoryCount);
+    for (size_t i = 0; i < getHistoryCount(); ++i) {
+        const Change &change = getHistory(i);
+        ESP_LOGI(TAG, "  %10lld us  %2u x %3u frames  ahead %5u B  %s",
+                 static_cast<long long>(change.atUs), change.settings.dmaDescriptors,
+                 change.settings.dmaFrames, static_cast<unsigned>(change.settings.decodeAheadBytes),
+                 reasonName(change.reason));
+    }
+}
+
+}  // namespace player
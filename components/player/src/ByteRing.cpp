@@ -0,0 +1,70 @@
+#include "ByteRing.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+// IDF
+#include <esp_log.h>
+
+namespace player {
+static const char *TAG = "ByteRing";
+
+ByteRing::ByteRing(uint8_t *storage, const size_t &capacity)
+    : mStorage(storage), mCapacity(capacity) {
+    if (mCapacity == 0U || (mCapacity & (mCapacity - 1U)) != 0U) {
+        ESP_LOGE(TAG, "Capacity %zu is not a power of two", mCapacity);
+        mCapacity = 0U;
+    }
+}
+
+size_t ByteRing::write(const uint8_t *data, const size_t &len) {
+    const size_t head = mHead.load(std::memory_order_relaxed);
+    const size_t tail = mTail.load(std::memory_order_acquire);
+    const size_t count = std::min(len, mCapacity - (head - tail));
+    if (count == 0U) {
+        return 0U;
+    }
+
+    const size_t offset = head & (mCapacity - 1U);
+    const size_t first = std::min(count, mCapacity - offset);
+    std::memcpy(&mStorage[offset], data, first);
+    std::memcpy(mStorage, &data[first], count - first);
+
+    mHead.store(head + count, std::memory_order_release);
+    return count;
+}
+
+size_t ByteRing::read(uint8_t *dst, const size_t &len) {
+    const size_t tail = mTail.load(std::memory_order_relaxed);
+    const size_t head = mHead.load(std::memory_order_acquire);
+    const size_t count = std::min(len, head - tail);
+    if (count == 0U) {
+        return 0U;
+    }
+
+    const size_t offset = tail & (mCapacity - 1U);
+    const size_t first = std::min(count, mCapacity - offset);
+    std::memcpy(dst, &mStorage[offset], first);
+    std::memcpy(&dst[first], mStorage, count - first);
+
+    mTail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+void ByteRing::clear() {
+    mTail.store(mHead.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+size_t ByteRing::size() const {
+    return mHead.load(std::memory_order_acquire) - mTail.load(std::memory_order_acquire);
+}
+
+size_t ByteRing::space() const {
+    return mCapacity - size();
+}
+
+size_t ByteRing::capacity() const {
+    return mCapacity;
+}
+
+}  // namespace player
@@ -0,0 +1,295 @@
+#include "EspHttpTransport.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "DnsCache.hpp"
+#include "IAudioSource.hpp"
+#include "Metrics.hpp"
+
+// IDF
+#include <esp_crt_bundle.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <mbedtls/ssl.h>
+
+namespace player {
+static const char *TAG = "EspHttpTransport";
+
+static constexpr int TIMEOUT_MS = 5000;
+// More than this left of a finished response and the connection is not worth keeping
+static constexpr size_t MAX_DRAIN_BYTES = 16U * 1024U;
+
+static metrics::Counter sReused("http.reused_connections");
+
+// Id of the session the handshake settled on. A TLS 1.2 client that offers a ticket also
+// sends a fresh session id, and the server echoes it only when it accepts the ticket.
+static net::TlsSessionCache::SessionId sessionIdOf(esp_tls_t *tls) {
+    net::TlsSessionCache::SessionId id{};
+    auto *ssl = static_cast<mbedtls_ssl_context *>(esp_tls_get_ssl_context(tls));
+    if (ssl == nullptr) {
+        return id;
+    }
+
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    if (mbedtls_ssl_get_session(ssl, &session) == 0) {
+        id.len = std::min(mbedtls_ssl_session_get_id_len(&session), id.bytes.size());
+        std::memcpy(id.bytes.data(), mbedtls_ssl_session_get_id(&session), id.len);
+    }
+    mbedtls_ssl_session_free(&session);
+    return id;
+}
+
+EspHttpTransport::EspHttpTransport(net::DnsCache &dns, net::TlsSessionCache &sessions)
+    : mDns(dns), mSessions(sessions), mPool(), mActive(nullptr) {}
+
+EspHttpTransport::~EspHttpTransport() {
+    for (Connection &connection : mPool) {
+        close(connection);
+    }
+}
+
+void EspHttpTransport::releaseSession(void *session) {
+    esp_tls_free_client_session(static_cast<esp_tls_client_session_t *>(session));
+}
+
+bool EspHttpTransport::request(const char *url, HttpResponseHead &head) {
+    if (mActive != nullptr) {
+        finish(false);
+    }
+
+    UrlParts parts;
+    Origin origin{};
+    if (!HttpWire::parseUrl(url, parts) ||
+        HttpWire::formatOrigin(parts, origin.data(), origin.size()) == 0U) {
+        ESP_LOGE(TAG, "Unsupported URL %s", url);
+        return false;
+    }
+
+    Connection &connection = connectionFor(origin);
+    connection.lastUsedUs = esp_timer_get_time();
+
+    const bool reused = connection.tls != nullptr;
+    if (!reused && !connect(connection, parts)) {
+        return false;
+    }
+    if (exchange(connection, parts, head)) {
+        if (reused) {
+            sReused.add();
+        }
+        mActive = &connection;
+        return true;
+    }
+    close(connection);
+    if (!reused) {
+        return false;
+    }
+
+    // The server timed the idle connection out; one fresh attempt
+    ESP_LOGI(TAG, "Kept connection to %s was closed, reconnecting", connection.origin.data());
+    if (!connect(connection, parts) || !exchange(connection, parts, head)) {
+        close(connection);
+        return false;
+    }
+    mActive = &connection;
+    return true;
+}
+
+int32_t EspHttpTransport::read(uint8_t *dst, const size_t &len) {
+    if (mActive == nullptr || mActive->parser.isBodyComplete()) {
+        return IAudioSource::END_OF_STREAM;
+    }
+
+    Connection &connection = *mActive;
+    int32_t count = 0;
+    if (connection.rxStart < connection.rxEnd) {
+        // dst may be the receive buffer itself while draining
+        count = static_cast<int32_t>(std::min(len, connection.rxEnd - connection.rxStart));
+        std::memmove(dst, &connection.rx[connection.rxStart], static_cast<size_t>(count));
+        connection.rxStart += static_cast<size_t>(count);
+    } else {
+        count = receive(connection, dst, len);
+        if (count <= 0) {
+            return count;
+        }
+    }
+
+    // Only chunk framing in this read: nothing for the caller yet, it polls again
+    return static_cast<int32_t>(connection.parser.decodeBody(dst, static_cast<size_t>(count)));
+}
+
+void EspHttpTransport::finish(const bool &reuse) {
+    if (mActive == nullptr) {
+        return;
+    }
+
+    Connection &connection = *mActive;
+    bool drained = false;
+    if (reuse && connection.parser.isKeepAlive()) {
+        size_t budget = MAX_DRAIN_BYTES;
+        while (!connection.parser.isBodyComplete() && budget > 0U) {
+            const int32_t count = read(connection.rx.data(), connection.rx.size());
+            if (count < 0 || (count == 0 && connection.rxStart == connection.rxEnd)) {
+                break;
+            }
+            budget -= std::min(budget, static_cast<size_t>(count));
+        }
+        drained = connection.parser.isBodyComplete();
+    }
+    mActive = nullptr;
+
+    if (!drained) {
+        close(connection);
+    }
+    connection.rxStart = 0U;
+    connection.rxEnd = 0U;
+}
+
+EspHttpTransport::Connection &EspHttpTransport::connectionFor(const Origin &origin) {
+    Connection *oldest = &mPool[0];
+    for (Connection &connection : mPool) {
+        if (connection.tls != nullptr && connection.origin == origin) {
+            return connection;
+        }
+        if (connection.tls == nullptr || connection.lastUsedUs < oldest->lastUsedUs) {
+            oldest = &connection;
+        }
+    }
+
+    // Least recently used goes
+    close(*oldest);
+    oldest->origin = origin;
+    return *oldest;
+}
+
+bool EspHttpTransport::connect(Connection &connection, const UrlParts &parts) {
+    const int64_t nowUs = esp_timer_get_time();
+    net::IpAddress address{};
+    if (!mDns.resolve(parts.host.data(), nowUs, address)) {
+        ESP_LOGW(TAG, "Cannot resolve %s", parts.host.data());
+        return false;
+    }
+
+    esp_tls_cfg_t config = {};
+    config.timeout_ms = TIMEOUT_MS;
+    net::TlsSessionCache::SessionId offeredId{};
+    esp_tls_client_session_t *offered = nullptr;
+    if (parts.secure) {
+        // Connecting to the address skips the resolver inside esp_tls; the host name still
+        // goes out as SNI and is what the certificate is checked against
+        config.common_name = parts.host.data();
+        config.crt_bundle_attach = esp_crt_bundle_attach;
+        offered = static_cast<esp_tls_client_session_t *>(
+            mSessions.take(connection.origin.data(), nowUs, &offeredId));
+        config.client_session = offered;
+    } else {
+        config.is_plain_tcp = true;
+    }
+
+    connection.tls = esp_tls_init();
+    const bool connected =
+        connection.tls != nullptr &&
+        esp_tls_conn_new_sync(address.data(), static_cast<int>(std::strlen(address.data())),
+                              parts.port, &config, connection.tls) == 1;
+    // The handshake works on its own copy of the offered session
+    if (offered != nullptr) {
+        releaseSession(offered);
+    }
+
+    if (!connected) {
+        ESP_LOGW(TAG, "Cannot connect to %s (%s)", connection.origin.data(), address.data());
+        close(connection);
+        // The host may have moved; ask again next time
+        mDns.forget(parts.host.data());
+        return false;
+    }
+
+    if (parts.secure) {
+        saveSession(connection, (offered != nullptr) ? &offeredId : nullptr);
+    }
+    return true;
+}
+
+void EspHttpTransport::saveSession(Connection &connection,
+                                   const net::TlsSessionCache::SessionId *offered) {
+    const net::TlsSessionCache::SessionId id = sessionIdOf(connection.tls);
+    const bool resumed = offered != nullptr && id.len > 0U && id == *offered;
+    mSessions.noteHandshake(resumed);
+    ESP_LOGD(TAG, "%s handshake with %s", resumed ? "Resumed" : "Full",
+             connection.origin.data());
+
+    mSessions.put(connection.origin.data(), esp_tls_get_client_session(connection.tls), id,
+                  esp_timer_get_time());
+}
+
+bool EspHttpTransport::exchange(Connection &connection, const UrlParts &parts,
+                                HttpResponseHead &head) {
+    connection.parser.reset();
+    connection.rxStart = 0U;
+    connection.rxEnd = 0U;
+
+    char *buffer = reinterpret_cast<char *>(connection.rx.data());
+    const size_t requestLen = HttpWire::formatRequest(parts, buffer, connection.rx.size());
+    if (requestLen == 0U) {
+        ESP_LOGE(TAG, "Request for %s does not fit", parts.host.data());
+        return false;
+    }
+    for (size_t sent = 0U; sent < requestLen;) {
+        const ssize_t count = esp_tls_conn_write(connection.tls, &buffer[sent], requestLen - sent);
+        if (count <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(count);
+    }
+
+    while (!connection.parser.isHeadDone()) {
+        const int32_t count = receive(connection, connection.rx.data(), connection.rx.size());
+        if (count <= 0 || connection.parser.hasFailed()) {
+            return false;
+        }
+        const size_t used = connection.parser.feedHead(buffer, static_cast<size_t>(count));
+        if (connection.parser.hasFailed()) {
+            return false;
+        }
+        connection.rxStart = used;
+        connection.rxEnd = static_cast<size_t>(count);
+    }
+
+    head = connection.parser.getHead();
+    // Relative targets stay on the same origin
+    if (head.location[0] == '/') {
+        const auto relative = head.location;
+        std::snprintf(head.location.data(), head.location.size(), "%s%s",
+                      connection.origin.data(), relative.data());
+    }
+    return true;
+}
+
+int32_t EspHttpTransport::receive(Connection &connection, uint8_t *dst, const size_t &len) {
+    const ssize_t count = esp_tls_conn_read(connection.tls, dst, len);
+    if (count > 0) {
+        return static_cast<int32_t>(count);
+    }
+    // A quiet socket is not the end of a live stream, the caller polls again
+    if (count == ESP_TLS_ERR_SSL_WANT_READ || count == ESP_TLS_ERR_SSL_WANT_WRITE ||
+        (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))) {
+        return 0;
+    }
+    if (count < 0) {
+        ESP_LOGW(TAG, "Read from %s failed: %d", connection.origin.data(),
+                 static_cast<int>(count));
+    }
+    return IAudioSource::END_OF_STREAM;
+}
+
+void EspHttpTransport::close(Connection &connection) {
+    if (connection.tls != nullptr) {
+        esp_tls_conn_destroy(connection.tls);
+        connection.tls = nullptr;
+    }
+}
+
+}  // namespace player
@@ -0,0 +1,49 @@
+#include "FileSource.hpp"
+
+#include <cstring>
+
+// IDF
+#include <esp_log.h>
+
+namespace player {
+static const char *TAG = "FileSource";
+
+static constexpr char FILE_SCHEME[] = "file://";
+
+FileSource::FileSource() : mFile(nullptr) {}
+
+FileSource::~FileSource() {
+    close();
+}
+
+bool FileSource::open(const char *url) {
+    close();
+
+    const size_t schemeLen = sizeof(FILE_SCHEME) - 1U;
+    const char *path = (std::strncmp(url, FILE_SCHEME, schemeLen) == 0) ? url + schemeLen : url;
+
+    mFile = std::fopen(path, "rb");
+    if (mFile == nullptr) {
+        ESP_LOGE(TAG, "Cannot open %s", path);
+        return false;
+    }
+    return true;
+}
+
+int32_t FileSource::read(uint8_t *dst, const size_t &len) {
+    if (mFile == nullptr) {
+        return END_OF_STREAM;
+    }
+
+    const size_t count = std::fread(dst, 1U, len, mFile);
+    return (count > 0U) ? static_cast<int32_t>(count) : END_OF_STREAM;
+}
+
+void FileSource::close() {
+    if (mFile != nullptr) {
+        std::fclose(mFile);
+        mFile = nullptr;
+    }
+}
+
+}  // namespace player
@@ -0,0 +1,79 @@
+#include "FixedFft.hpp"
+
+#include <cmath>
+#include <utility>
+
+namespace player {
+static constexpr double PI = 3.14159265358979323846;
+static constexpr double Q15_ONE = 32767.0;
+
+template <size_t N>
+FixedFft<N>::FixedFft() : mCos{}, mSin{}, mReversed{} {
+    for (size_t k = 0; k < N / 2U; ++k) {
+        const double angle = 2.0 * PI * static_cast<double>(k) / static_cast<double>(N);
+        mCos[k] = static_cast<int16_t>(std::lround(std::cos(angle) * Q15_ONE));
+        mSin[k] = static_cast<int16_t>(std::lround(std::sin(angle) * Q15_ONE));
+    }
+
+    size_t bits = 0U;
+    while ((1U << bits) < N) {
+        ++bits;
+    }
+    for (size_t i = 0; i < N; ++i) {
+        size_t reversed = 0U;
+        for (size_t b = 0; b < bits; ++b) {
+            reversed |= ((i >> b) & 1U) << (bits - 1U - b);
+        }
+        mReversed[i] = static_cast<uint8_t>(reversed);
+    }
+}
+
+template <size_t N>
+void FixedFft<N>::transform(int16_t *re, int16_t *im) const {
+    for (size_t i = 0; i < N; ++i) {
+        const size_t j = mReversed[i];
+        if (j > i) {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+
+    // Decimation in time. The magnitudes entering a butterfly are at most full scale and the
+    // twiddles are below one, so halving both outputs keeps them in int16
+    for (size_t len = 2U; len <= N; len <<= 1U) {
+        const size_t half = len / 2U;
+        const size_t step = N / len;
+        for (size_t start = 0; start < N; start += len) {
+            for (size_t k = 0; k < half; ++k) {
+                const int32_t wr = mCos[k * step];
+                const int32_t wi = -mSin[k * step];
+                const size_t a = start + k;
+                const size_t b = a + half;
+
+                const int32_t tr = (re[b] * wr - im[b] * wi) >> 15;
+                const int32_t ti = (re[b] * wi + im[b] * wr) >> 15;
+                const int32_t ar = re[a];
+                const int32_t ai = im[a];
+                re[a] = static_cast<int16_t>((ar + tr) >> 1);
+                im[a] = static_cast<int16_t>((ai + ti) >> 1);
+                re[b] = static_cast<int16_t>((ar - tr) >> 1);
+                im[b] = static_cast<int16_t>((ai - ti) >> 1);
+            }
+        }
+    }
+}
+
+template <size_t N>
+void FixedFft<N>::power(const int16_t *re, const int16_t *im, uint32_t *out) {
+    for (size_t k = 0; k < BINS; ++k) {
+        const int32_t r = re[k];
+        const int32_t i = im[k];
+        out[k] = static_cast<uint32_t>(r * r) + static_cast<uint32_t>(i * i);
+    }
+}
+
+template class FixedFft<64U>;
+template class FixedFft<128U>;
+template class FixedFft<256U>;
+
+}  // namespace player
@@ -0,0 +1,156 @@
+#include "HttpSource.hpp"
+
+#include <cstring>
+
+#include "Metrics.hpp"
+#include "RedirectCache.hpp"
+
+// IDF
+#include <esp_log.h>
+#include <esp_timer.h>
+
+namespace player {
+static const char *TAG = "HttpSource";
+
+static metrics::Counter sCacheHits("http.redirect_hits");
+static metrics::Counter sCacheMisses("http.redirect_misses");
+static metrics::Counter sFallbacks("http.redirect_fallbacks");
+static metrics::Counter sPreopenHits("http.preopen_hits");
+static metrics::Histogram sFirstByte("http.first_byte_us", metrics::LATENCY_BUCKETS_US);
+
+static bool isRedirect(const int &status) {
+    return status == 301 || status == 302 || status == 303 || status == 307 || status == 308;
+}
+
+HttpSource::HttpSource(IHttpTransport &transport, RedirectCache *cache)
+    : mTransport(transport),
+      mCache(cache),
+      mOpen(false),
+      mOpenedUs(0),
+      mUrl{},
+      mPreopenedUrl{},
+      mPreopenedUs(0),
+      mOpenMutex() {}
+
+HttpSource::~HttpSource() {
+    close();
+}
+
+bool HttpSource::open(const char *url) {
+    std::lock_guard<std::mutex> lock(mOpenMutex);
+
+    const bool preopened = mOpen && std::strcmp(mPreopenedUrl.data(), url) == 0 &&
+                           esp_timer_get_time() - mPreopenedUs < PREOPEN_TTL_US;
+    mPreopenedUrl[0] = '\0';
+    if (preopened) {
+        ESP_LOGI(TAG, "Taking over pre-opened %s", mUrl.data());
+        sPreopenHits.add();
+        return true;
+    }
+    return openLocked(url);
+}
+
+bool HttpSource::preopen(const char *url) {
+    std::lock_guard<std::mutex> lock(mOpenMutex);
+
+    if (!openLocked(url)) {
+        return false;
+    }
+    std::strncpy(mPreopenedUrl.data(), url, mPreopenedUrl.size() - 1U);
+    mPreopenedUs = esp_timer_get_time();
+    return true;
+}
+
+bool HttpSource::openLocked(const char *url) {
+    closeLocked();
+    mOpenedUs = esp_timer_get_time();
+
+    if (mCache != nullptr) {
+        RedirectCache::Url target{};
+        if (mCache->lookup(url, mOpenedUs, target)) {
+            sCacheHits.add();
+            if (openFollowing(target.data(), url)) {
+                return true;
+            }
+            // Stale target: the station URL knows where the stream went
+            ESP_LOGW(TAG, "Cached target failed, resolving %s again", url);
+            sFallbacks.add();
+            mCache->forget(url);
+        } else {
+            sCacheMisses.add();
+        }
+    }
+
+    return openFollowing(url, url);
+}
+
+bool HttpSource::openFollowing(const char *start, const char *stationUrl) {
+    std::strncpy(mUrl.data(), start, mUrl.size() - 1U);
+
+    for (int hop = 0; hop <= MAX_REDIRECTS; ++hop) {
+        HttpResponseHead head;
+        if (!mTransport.request(mUrl.data(), head)) {
+            ESP_LOGE(TAG, "No response from %s", mUrl.data());
+            mTransport.finish(false);
+            return false;
+        }
+
+        if (isRedirect(head.status) && head.location[0] != '\0') {
+            // Redirect bodies are short, the connection is worth keeping
+            mTransport.finish(true);
+            ESP_LOGI(TAG, "HTTP %d -> %s", head.status, head.location.data());
+            mUrl = head.location;
+            continue;
+        }
+
+        if (head.status != 200) {
+            ESP_LOGE(TAG, "HTTP %d from %s", head.status, mUrl.data());
+            mTransport.finish(false);
+            return false;
+        }
+
+        if (mCache != nullptr && std::strcmp(mUrl.data(), stationUrl) != 0) {
+            mCache->remember(stationUrl, mUrl.data(), esp_timer_get_time());
+        }
+        mOpen = true;
+        ESP_LOGI(TAG, "Streaming %s (%lld bytes)", mUrl.data(),
+                 static_cast<long long>(head.contentLength));
+        return true;
+    }
+
+    ESP_LOGE(TAG, "Too many redirects from %s", start);
+    return false;
+}
+
+int32_t HttpSource::read(uint8_t *dst, const size_t &len) {
+    if (!mOpen) {
+        return END_OF_STREAM;
+    }
+
+    const int32_t count = mTransport.read(dst, len);
+    if (count > 0 && mOpenedUs != 0) {
+        sFirstByte.record(static_cast<uint32_t>(esp_timer_get_time() - mOpenedUs));
+        mOpenedUs = 0;
+    }
+    return count;
+}
+
+void HttpSource::close() {
+    std::lock_guard<std::mutex> lock(mOpenMutex);
+    mPreopenedUrl[0] = '\0';
+    closeLocked();
+}
+
+void HttpSource::closeLocked() {
+    if (mOpen) {
+        // A live stream never ends, the rest of it is not worth draining
+        mTransport.finish(false);
+        mOpen = false;
+    }
+}
+
+const char *HttpSource::getStreamUrl() const {
+    return mUrl.data();
+}
+
+}  // namespace player
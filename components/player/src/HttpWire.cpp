@@ -0,0 +1,243 @@
+#include "HttpWire.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+namespace player {
+static constexpr uint16_t HTTP_PORT = 80U;
+static constexpr uint16_t HTTPS_PORT = 443U;
+
+bool HttpWire::parseUrl(const char *url, UrlParts &parts) {
+    parts = UrlParts();
+    if (strncasecmp(url, "https://", 8U) == 0) {
+        parts.secure = true;
+        url += 8U;
+    } else if (strncasecmp(url, "http://", 7U) == 0) {
+        url += 7U;
+    } else {
+        return false;
+    }
+
+    const char *slash = std::strchr(url, '/');
+    const char *end = (slash != nullptr) ? slash : url + std::strlen(url);
+    const char *colon = static_cast<const char *>(std::memchr(url, ':', end - url));
+    const char *hostEnd = (colon != nullptr) ? colon : end;
+
+    const size_t hostLen = static_cast<size_t>(hostEnd - url);
+    if (hostLen == 0U || hostLen > UrlParts::MAX_HOST_LEN) {
+        return false;
+    }
+    std::memcpy(parts.host.data(), url, hostLen);
+
+    parts.port = parts.secure ? HTTPS_PORT : HTTP_PORT;
+    if (colon != nullptr) {
+        const long port = std::strtol(colon + 1, nullptr, 10);
+        if (port <= 0 || port > UINT16_MAX) {
+            return false;
+        }
+        parts.port = static_cast<uint16_t>(port);
+    }
+    if (slash != nullptr) {
+        parts.path = slash;
+    }
+    return true;
+}
+
+size_t HttpWire::formatOrigin(const UrlParts &parts, char *dst, const size_t &capacity) {
+    const int len = std::snprintf(dst, capacity, "%s://%s:%u", parts.secure ? "https" : "http",
+                                  parts.host.data(), static_cast<unsigned>(parts.port));
+    return (len > 0 && static_cast<size_t>(len) < capacity) ? static_cast<size_t>(len) : 0U;
+}
+
+size_t HttpWire::formatRequest(const UrlParts &parts, char *dst, const size_t &capacity) {
+    const int len = std::snprintf(dst, capacity,
+                                  "GET %s HTTP/1.1\r\n"
+                                  "Host: %s\r\n"
+                                  "User-Agent: esp-radio\r\n"
+                                  "Accept: */*\r\n"
+                                  "Connection: keep-alive\r\n"
+                                  "\r\n",
+                                  parts.path, parts.host.data());
+    return (len > 0 && static_cast<size_t>(len) < capacity) ? static_cast<size_t>(len) : 0U;
+}
+
+HttpResponseParser::HttpResponseParser()
+    : mState(State::StatusLine),
+      mHead(),
+      mKeepAlive(true),
+      mChunked(false),
+      mRemaining(-1),
+      mLine{},
+      mLineLen(0U) {}
+
+void HttpResponseParser::reset() {
+    *this = HttpResponseParser();
+}
+
+size_t HttpResponseParser::feedHead(const char *data, const size_t &len) {
+    size_t used = 0U;
+    while (used < len && (mState == State::StatusLine || mState == State::Headers)) {
+        if (!takeLine(data[used++])) {
+            continue;
+        }
+
+        if (mState == State::StatusLine) {
+            parseStatusLine();
+        } else if (mLineLen == 0U) {
+            startBody();
+        } else {
+            parseHeader();
+        }
+        mLineLen = 0U;
+    }
+    return used;
+}
+
+bool HttpResponseParser::isHeadDone() const {
+    return mState != State::StatusLine && mState != State::Headers && mState != State::Failed;
+}
+
+bool HttpResponseParser::hasFailed() const {
+    return mState == State::Failed;
+}
+
+const HttpResponseHead &HttpResponseParser::getHead() const {
+    return mHead;
+}
+
+bool HttpResponseParser::isKeepAlive() const {
+    // A body that only ends with the connection leaves nothing to reuse
+    return mKeepAlive && (mChunked || mHead.contentLength >= 0);
+}
+
+size_t HttpResponseParser::decodeBody(uint8_t *data, const size_t &len) {
+    size_t in = 0U;
+    size_t out = 0U;
+
+    while (in < len) {
+        switch (mState) {
+            case State::Body: {
+                size_t take = len - in;
+                if (mRemaining >= 0) {
+                    take = std::min<size_t>(take, static_cast<size_t>(mRemaining));
+                    mRemaining -= static_cast<int64_t>(take);
+                }
+                std::memmove(&data[out], &data[in], take);
+                in += take;
+                out += take;
+                if (mRemaining == 0) {
+                    mState = State::Done;
+                }
+                break;
+            }
+            case State::ChunkData: {
+                const size_t take =
+                    std::min<size_t>(len - in, static_cast<size_t>(mRemaining));
+                std::memmove(&data[out], &data[in], take);
+                in += take;
+                out += take;
+                mRemaining -= static_cast<int64_t>(take);
+                if (mRemaining == 0) {
+                    mState = State::ChunkEnd;
+                }
+                break;
+            }
+            case State::ChunkSize:
+            case State::ChunkEnd:
+            case State::Trailers:
+                if (takeLine(static_cast<char>(data[in++]))) {
+                    if (mState == State::ChunkSize) {
+                        // Extensions after ';' are ignored
+                        mRemaining = std::strtoll(mLine.data(), nullptr, 16);
+                        mState = (mRemaining > 0) ? State::ChunkData : State::Trailers;
+                    } else if (mState == State::ChunkEnd) {
+                        mState = State::ChunkSize;
+                    } else if (mLineLen == 0U) {
+                        mState = State::Done;
+                    }
+                    mLineLen = 0U;
+                }
+                break;
+            default:
+                // Done or failed: whatever is left is not ours
+                return out;
+        }
+    }
+    return out;
+}
+
+bool HttpResponseParser::isBodyComplete() const {
+    return mState == State::Done;
+}
+
+bool HttpResponseParser::takeLine(const char &c) {
+    if (c == '\n') {
+        if (mLineLen > 0U && mLine[mLineLen - 1U] == '\r') {
+            --mLineLen;
+        }
+        mLine[mLineLen] = '\0';
+        return true;
+    }
+    if (mLineLen < MAX_LINE_LEN) {
+        mLine[mLineLen++] = c;
+    }
+    return false;
+}
+
+void HttpResponseParser::parseStatusLine() {
+    // HTTP/1.x 200 OK, or ICY 200 OK from old Shoutcast servers
+    const char *space = std::strchr(mLine.data(), ' ');
+    mHead.status = (space != nullptr) ? std::atoi(space + 1) : 0;
+    if (mHead.status < 100) {
+        mState = State::Failed;
+        return;
+    }
+    mKeepAlive = std::strncmp(mLine.data(), "HTTP/1.1", 8U) == 0;
+    mState = State::Headers;
+}
+
+void HttpResponseParser::parseHeader() {
+    char *colon = std::strchr(mLine.data(), ':');
+    if (colon == nullptr) {
+        return;
+    }
+    *colon = '\0';
+    const char *value = colon + 1;
+    while (*value == ' ' || *value == '\t') {
+        ++value;
+    }
+
+    const char *name = mLine.data();
+    if (strcasecmp(name, "Content-Length") == 0) {
+        mHead.contentLength = std::strtoll(value, nullptr, 10);
+    } else if (strcasecmp(name, "Location") == 0) {
+        std::strncpy(mHead.location.data(), value, mHead.location.size() - 1U);
+    } else if (strcasecmp(name, "Transfer-Encoding") == 0) {
+        mChunked = strcasecmp(value, "chunked") == 0;
+    } else if (strcasecmp(name, "Connection") == 0) {
+        if (strcasecmp(value, "close") == 0) {
+            mKeepAlive = false;
+        } else if (strcasecmp(value, "keep-alive") == 0) {
+            mKeepAlive = true;
+        }
+    }
+}
+
+void HttpResponseParser::startBody() {
+    const bool empty = mHead.status == 204 || mHead.status == 304 || mHead.status < 200;
+    if (empty || (!mChunked && mHead.contentLength == 0)) {
+        mHead.contentLength = 0;
+        mState = State::Done;
+    } else if (mChunked) {
+        mHead.contentLength = -1;
+        mState = State::ChunkSize;
+    } else {
+        mRemaining = mHead.contentLength;
+        mState = State::Body;
+    }
+}
+
+}  // namespace player
@@ -0,0 +1,240 @@
+#include "I2sSink.hpp"
+
+#include <algorithm>
+
+#include "Metrics.hpp"
+
+// IDF
+#include <esp_attr.h>
+#include <esp_log.h>
+
+namespace player {
+static const char *TAG = "I2sSink";
+
+static constexpr uint16_t FULL_PERMILLE = 1000U;
+
+static metrics::Counter sUnderruns("i2s.underruns");
+static metrics::Gauge sMinFill("i2s.dma_min_fill_permille");
+
+I2sSink::I2sSink(const int &port, const int &bclkGpio, const int &wsGpio, const int &doutGpio)
+    : mPort(port),
+      mBclkGpio(bclkGpio),
+      mWsGpio(wsGpio),
+      mDoutGpio(doutGpio),
+      mChannel(nullptr),
+      mFormat(),
+      mInitialized(false),
+      mEnabled(false),
+      mDma(BufferTuner::DEFAULT_SETTINGS),
+      mPendingDma(BufferTuner::DEFAULT_SETTINGS),
+      mShrinkPending(false),
+      mQueuedBytes(0U),
+      mCapacityBytes(0U),
+      mUnderruns(0U),
+      mMinFillPermille(FULL_PERMILLE) {}
+
+I2sSink::~I2sSink() {
+    stop();
+    if (mChannel != nullptr) {
+        i2s_del_channel(mChannel);
+    }
+}
+
+bool I2sSink::init() {
+    if (!createChannel()) {
+        return false;
+    }
+
+    ESP_LOGI(TAG, "I2S%d ready", mPort);
+    return true;
+}
+
+bool I2sSink::createChannel() {
+    i2s_chan_config_t config =
+        I2S_CHANNEL_DEFAULT_CONFIG(static_cast<i2s_port_t>(mPort), I2S_ROLE_MASTER);
+    config.dma_desc_num = mDma.dmaDescriptors;
+    config.dma_frame_num = mDma.dmaFrames;
+    // An underrun plays silence instead of repeating the last DMA buffer
+    config.auto_clear = true;
+
+    esp_err_t err = i2s_new_channel(&config, &mChannel, nullptr);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Cannot allocate I2S channel: %s", esp_err_to_name(err));
+        mChannel = nullptr;
+        return false;
+    }
+
+    i2s_event_callbacks_t callbacks = {};
+    callbacks.on_sent = I2sSink::onDmaSent;
+    callbacks.on_send_q_ovf = I2sSink::onDmaUnderrun;
+    err = i2s_channel_register_event_callback(mChannel, &callbacks, this);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "No DMA telemetry: %s", esp_err_to_name(err));
+    }
+    return true;
+}
+
+bool I2sSink::configure(const AudioFormat &format) {
+    if (mChannel == nullptr || !format.isValid()) {
+        return false;
+    }
+    if (mEnabled && format == mFormat) {
+        return true;
+    }
+    if (mEnabled) {
+        i2s_channel_disable(mChannel);
+        mEnabled = false;
+    }
+
+    const i2s_slot_mode_t slots =
+        (format.channels == 1U) ? I2S_SLOT_MODE_MONO : I2S_SLOT_MODE_STEREO;
+    i2s_std_config_t config = {};
+    config.clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(format.sampleRate);
+    config.slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, slots);
+    config.gpio_cfg.mclk = I2S_GPIO_UNUSED;
+    config.gpio_cfg.bclk = static_cast<gpio_num_t>(mBclkGpio);
+    config.gpio_cfg.ws = static_cast<gpio_num_t>(mWsGpio);
+    config.gpio_cfg.dout = static_cast<gpio_num_t>(mDoutGpio);
+    config.gpio_cfg.din = I2S_GPIO_UNUSED;
+
+    esp_err_t err = ESP_OK;
+    if (!mInitialized) {
+        err = i2s_channel_init_std_mode(mChannel, &config);
+        mInitialized = (err == ESP_OK);
+    } else {
+        err = i2s_channel_reconfig_std_clock(mChannel, &config.clk_cfg);
+        if (err == ESP_OK) {
+            err = i2s_channel_reconfig_std_slot(mChannel, &config.slot_cfg);
+        }
+    }
+    if (err == ESP_OK) {
+        err = i2s_channel_enable(mChannel);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Cannot start I2S at %u Hz: %s", static_cast<unsigned>(format.sampleRate),
+                 esp_err_to_name(err));
+        return false;
+    }
+
+    mFormat = format;
+    mEnabled = true;
+    mQueuedBytes.store(0U, std::memory_order_relaxed);
+    mCapacityBytes.store(dmaCapacityBytes(), std::memory_order_relaxed);
+    return true;
+}
+
+void I2sSink::write(const int16_t *pcm, const size_t &frames) {
+    if (!mEnabled) {
+        return;
+    }
+
+    size_t written = 0U;
+    i2s_channel_write(mChannel, pcm, frames * mFormat.frameBytes(), &written, portMAX_DELAY);
+    mQueuedBytes.fetch_add(static_cast<uint32_t>(written), std::memory_order_relaxed);
+}
+
+void I2sSink::stop() {
+    if (mEnabled) {
+        i2s_channel_disable(mChannel);
+        mEnabled = false;
+    }
+
+    // Smaller DMA settings are only worth a rebuild while nothing is playing
+    if (mShrinkPending) {
+        mShrinkPending = false;
+        mDma = mPendingDma;
+        rebuildChannel();
+    }
+}
+
+BufferWindow I2sSink::takeWindow() {
+    BufferWindow window;
+    window.underruns = mUnderruns.exchange(0U, std::memory_order_relaxed);
+    window.minFillPermille = mMinFillPermille.exchange(FULL_PERMILLE, std::memory_order_relaxed);
+
+    sUnderruns.add(window.underruns);
+    sMinFill.set(window.minFillPermille);
+    return window;
+}
+
+void I2sSink::applySettings(const BufferSettings &settings) {
+    if (settings.dmaDescriptors == mDma.dmaDescriptors && settings.dmaFrames == mDma.dmaFrames) {
+        mShrinkPending = false;
+        return;
+    }
+    if (mChannel == nullptr) {
+        mDma = settings;  // init() builds with these
+        return;
+    }
+
+    if (settings.dmaFramesTotal() < mDma.dmaFramesTotal() && mEnabled) {
+        mPendingDma = settings;
+        mShrinkPending = true;
+        return;
+    }
+
+    // Growth follows an underrun that was already heard, the short gap costs nothing more
+    mDma = settings;
+    mShrinkPending = false;
+    rebuildChannel();
+}
+
+bool I2sSink::rebuildChannel() {
+    const bool wasEnabled = mEnabled;
+    const AudioFormat format = mFormat;
+
+    if (mEnabled) {
+        i2s_channel_disable(mChannel);
+        mEnabled = false;
+    }
+    if (mChannel != nullptr) {
+        i2s_del_channel(mChannel);
+        mChannel = nullptr;
+    }
+    mInitialized = false;
+
+    if (!createChannel()) {
+        return false;
+    }
+    ESP_LOGI(TAG, "DMA rebuilt: %u x %u frames", mDma.dmaDescriptors, mDma.dmaFrames);
+
+    return !wasEnabled || configure(format);
+}
+
+uint32_t I2sSink::dmaCapacityBytes() const {
+    return mDma.dmaFramesTotal() * static_cast<uint32_t>(mFormat.frameBytes());
+}
+
+bool IRAM_ATTR I2sSink::onDmaSent(i2s_chan_handle_t channel, i2s_event_data_t *event,
+                                  void *context) {
+    (void)channel;
+    auto *self = static_cast<I2sSink *>(context);
+
+    // The decode task adds from the other core, so the subtraction has to be atomic too
+    const uint32_t sent = static_cast<uint32_t>(event->size);
+    uint32_t queued = self->mQueuedBytes.load(std::memory_order_relaxed);
+    uint32_t left = 0U;
+    do {
+        left = (queued > sent) ? queued - sent : 0U;
+    } while (!self->mQueuedBytes.compare_exchange_weak(queued, left, std::memory_order_relaxed));
+
+    const uint32_t capacity = self->mCapacityBytes.load(std::memory_order_relaxed);
+    if (capacity > 0U) {
+        const uint32_t fill = std::min<uint32_t>((left * FULL_PERMILLE) / capacity,
+                                                 FULL_PERMILLE);
+        if (fill < self->mMinFillPermille.load(std::memory_order_relaxed)) {
+            self->mMinFillPermille.store(static_cast<uint16_t>(fill), std::memory_order_relaxed);
+        }
+    }
+    return false;
+}
+
+bool IRAM_ATTR I2sSink::onDmaUnderrun(i2s_chan_handle_t channel, i2s_event_data_t *event,
+                                      void *context) {
+    (void)channel;
+    (void)event;
+    static_cast<I2sSink *>(context)->mUnderruns.fetch_add(1U, std::memory_order_relaxed);
+    return false;
+}
+
+}  // namespace player
@@ -0,0 +1,29 @@
+#include "NullSink.hpp"
+
+namespace player {
+
+NullSink::NullSink() : mFramesWritten(0U), mRunning(false) {}
+
+bool NullSink::configure(const AudioFormat &format) {
+    mRunning.store(format.isValid(), std::memory_order_relaxed);
+    return format.isValid();
+}
+
+void NullSink::write(const int16_t *pcm, const size_t &frames) {
+    (void)pcm;
+    mFramesWritten.fetch_add(frames, std::memory_order_relaxed);
+}
+
+void NullSink::stop() {
+    mRunning.store(false, std::memory_order_relaxed);
+}
+
+uint64_t NullSink::getFramesWritten() const {
+    return mFramesWritten.load(std::memory_order_relaxed);
+}
+
+bool NullSink::isRunning() const {
+    return mRunning.load(std::memory_order_relaxed);
+}
+
+}  // namespace player
@@ -0,0 +1,716 @@
+#include "PlayerPipeline.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "BufferTuner.hpp"
+#include "ByteRing.hpp"
+#include "IAudioDecoder.hpp"
+#include "IAudioSink.hpp"
+#include "IAudioSource.hpp"
+#include "IBufferTelemetry.hpp"
+#include "IPcmStage.hpp"
+#include "IPipelineListener.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+
+// IDF
+#include <esp_log.h>
+#include <esp_timer.h>
+
+namespace player {
+static const char *TAG = "PlayerPipeline";
+
+static metrics::Histogram sCommandLatency("player.command_us", metrics::LATENCY_BUCKETS_US);
+static metrics::Counter sSourceErrors("player.source_errors");
+static metrics::Counter sDecodeErrors("player.decode_errors");
+static metrics::Counter sRebuffers("player.rebuffers");
+static metrics::Counter sCutovers("player.cutovers");
+static metrics::Counter sSwitchesCancelled("player.switches_cancelled");
+static metrics::Counter sCommandsSuperseded("player.commands_superseded");
+static metrics::Gauge sRingFill("player.ring_fill_pct");
+
+static const char *commandName(const PlayerCommand::Type &type) {
+    switch (type) {
+        case PlayerCommand::Type::Play:
+            return "play";
+        case PlayerCommand::Type::Stop:
+            return "stop";
+        case PlayerCommand::Type::Switch:
+            return "switch";
+    }
+    return "?";
+}
+
+// Linear ramp over the first FADE_FRAMES frames, up from silence or down to it; a fade out
+// ends the block where the ramp does
+static size_t fade(int16_t *pcm, const size_t &frames, const uint8_t &channels, const bool &in) {
+    const size_t ramp = std::min(frames, PlayerPipeline::FADE_FRAMES);
+    for (size_t frame = 0; frame < ramp; ++frame) {
+        const int32_t step = static_cast<int32_t>(in ? frame : ramp - frame);
+        for (uint8_t channel = 0; channel < channels; ++channel) {
+            int16_t &sample = pcm[frame * channels + channel];
+            sample = static_cast<int16_t>((sample * step) / static_cast<int32_t>(ramp));
+        }
+    }
+    return in ? frames : ramp;
+}
+
+PlayerPipeline::PlayerPipeline(IAudioSource &source, IAudioDecoder &decoder, IAudioSink &sink,
+                               ByteRing &ring)
+    : mDecoder(decoder),
+      mSink(sink),
+      mStreams{{{&source, &ring}, {nullptr, nullptr}}},
+      mListener(nullptr),
+      mTuner(nullptr),
+      mTelemetry(nullptr),
+      mTuningWindowUs(TUNING_WINDOW_US),
+      mStages{},
+      mStageCount(0U),
+      mVolume(),
+      mCommands(),
+      mCommandRestartsSink(false),
+      mStandbyRequests(),
+      mGeneration(0U),
+      mDecoderGeneration(0U),
+      mRestartSink(false),
+      mStopRequested(false),
+      mCommandPostedUs(0),
+      mState(PlayerState::Stopped),
+      mFirstAudioUs(0),
+      mActive(0U),
+      mCutover(false),
+      mStartWatermark(0U),
+      mSwitchSequence(0U),
+      mCutoverSequence(0U),
+      mStandbyReady(0U),
+      mStandbyFailed(0U),
+      mStandbyEnded(false),
+      mSourceOpen(false),
+      mChunk{},
+      mChunkLen(0U),
+      mChunkPos(0U),
+      mSwitchPending(false),
+      mSwitchInFlight(false),
+      mPendingSwitch(),
+      mSwitchPostedUs(0),
+      mInput{},
+      mInputLen(0U),
+      mPcm{},
+      mInputFormat(),
+      mOutputFormat(),
+      mSinkRunning(false),
+      mDecodeFailed(false),
+      mLatencyStartUs(0),
+      mDecodeAheadBytes(0U),
+      mPrebuffering(false),
+      mWindowStartUs(0),
+      mDecoding(0U),
+      mFadeIn(false),
+      mStandbyJob(0U),
+      mStandbySlot(0U),
+      mStandbyOpen(false),
+      mStandbyPublished(false),
+      mStandbyChunk{},
+      mStandbyChunkLen(0U),
+      mStandbyChunkPos(0U) {
+    mStages[0] = &mVolume;
+    mStageCount = 1U;
+}
+
+bool PlayerPipeline::addPcmStage(IPcmStage &stage) {
+    if (mStageCount > MAX_PCM_STAGES) {
+        ESP_LOGE(TAG, "Too many PCM stages");
+        return false;
+    }
+
+    // Volume stays last so it scales the samples that actually reach the sink
+    mStages[mStageCount] = mStages[mStageCount - 1U];
+    mStages[mStageCount - 1U] = &stage;
+    ++mStageCount;
+    return true;
+}
+
+void PlayerPipeline::setListener(IPipelineListener *listener) {
+    mListener = listener;
+}
+
+void PlayerPipeline::setBufferTuning(BufferTuner *tuner, IBufferTelemetry *telemetry,
+                                     const int64_t &windowUs) {
+    mTuner = tuner;
+    mTelemetry = telemetry;
+    mTuningWindowUs = windowUs;
+    applyBufferSettings();
+}
+
+void PlayerPipeline::setStandby(IAudioSource &source, ByteRing &ring) {
+    mStreams[1] = {&source, &ring};
+}
+
+bool PlayerPipeline::play(const char *url) {
+    return post(PlayerCommand::Type::Play, url);
+}
+
+bool PlayerPipeline::switchTo(const char *url) {
+    return post(PlayerCommand::Type::Switch, url);
+}
+
+bool PlayerPipeline::stop() {
+    return post(PlayerCommand::Type::Stop, "");
+}
+
+void PlayerPipeline::setVolume(const int &percent) {
+    mVolume.setVolume(percent);
+}
+
+PlayerState PlayerPipeline::getState() const {
+    return mState.load(std::memory_order_relaxed);
+}
+
+int64_t PlayerPipeline::getFirstAudioUs() const {
+    return mFirstAudioUs.load(std::memory_order_relaxed);
+}
+
+size_t PlayerPipeline::getDecodeAheadBytes() const {
+    return mDecodeAheadBytes;
+}
+
+bool PlayerPipeline::post(const PlayerCommand::Type &type, const char *url) {
+    PlayerCommand command;
+    command.type = type;
+    command.postedUs = esp_timer_get_time();
+
+    const size_t len = std::strlen(url);
+    if (len > MAX_URL_LEN) {
+        ESP_LOGE(TAG, "URL too long: %zu bytes", len);
+        return false;
+    }
+    std::memcpy(command.url.data(), url, len + 1U);
+
+    // Set before the command is published, so the source side sees it when it takes one
+    if (type != PlayerCommand::Type::Switch) {
+        mCommandRestartsSink.store(true, std::memory_order_relaxed);
+    }
+    if (mCommands.publish(command)) {
+        sCommandsSuperseded.add();
+    }
+
+    if (mListener != nullptr) {
+        mListener->onCommandPosted();
+    }
+    return true;
+}
+
+bool PlayerPipeline::runSourceStep() {
+    const bool applied = applyCommands();
+
+    // Nothing new goes into the ring until the decoder has let go of the old stream
+    if (mDecoderGeneration.load(std::memory_order_acquire) !=
+        mGeneration.load(std::memory_order_relaxed)) {
+        return applied;
+    }
+
+    // The ring the standby side fills was the playing one until the last cutover, so it is
+    // only handed over once the decoder is done with it
+    if (mSwitchPending && mStandbyRequests.push(mPendingSwitch)) {
+        mSwitchPending = false;
+        mSwitchInFlight = true;
+        if (mListener != nullptr) {
+            mListener->onStandbyRequested();
+        }
+    }
+    if (applyStandbyResult()) {
+        return true;
+    }
+
+    return fillRing() || applied;
+}
+
+bool PlayerPipeline::applyCommands() {
+    // Only the newest command is applied, a superseded stream is never opened
+    PlayerCommand command;
+    if (!mCommands.take(command)) {
+        return false;
+    }
+    // The flag may already belong to a newer command; that one restarts the sink anyway
+    const bool restartSink = mCommandRestartsSink.exchange(false, std::memory_order_relaxed) ||
+                             (command.type != PlayerCommand::Type::Switch);
+    const int64_t postedUs = command.postedUs;
+
+    TRACE_INSTANT(PLAYER_COMMAND, static_cast<uint32_t>(command.type));
+    ESP_LOGI(TAG, "Command %s %s", commandName(command.type), command.url.data());
+    cancelStandby();
+
+    // A stream that is playing keeps doing so until the one switched to is buffered
+    const bool makeBeforeBreak = !restartSink && mStreams[1].source != nullptr && mSourceOpen &&
+                                 mState.load(std::memory_order_relaxed) == PlayerState::Playing;
+    if (makeBeforeBreak) {
+        mPendingSwitch.url = command.url;
+        mPendingSwitch.sequence = mSwitchSequence.load(std::memory_order_relaxed);
+        mPendingSwitch.slot = 1U - mActive.load(std::memory_order_relaxed);
+        mSwitchPending = true;
+        mSwitchPostedUs = postedUs;
+        return true;
+    }
+
+    IAudioSource &source = *mStreams[mActive.load(std::memory_order_relaxed)].source;
+    if (mSourceOpen) {
+        source.close();
+        mSourceOpen = false;
+    }
+    mChunkLen = 0U;
+    mChunkPos = 0U;
+
+    PlayerState state = PlayerState::Stopped;
+    if (command.type != PlayerCommand::Type::Stop) {
+        mSourceOpen = source.open(command.url.data());
+        if (mSourceOpen) {
+            state = PlayerState::Playing;
+        } else {
+            sSourceErrors.add();
+            state = PlayerState::Failed;
+        }
+    }
+
+    publish(state, restartSink, postedUs, false);
+    return true;
+}
+
+void PlayerPipeline::publish(const PlayerState &state, const bool &restartSink,
+                             const int64_t &postedUs, const bool &cutover) {
+    // A restart the decoder has not picked up yet still has to happen
+    const bool unacknowledged = mDecoderGeneration.load(std::memory_order_acquire) !=
+                                mGeneration.load(std::memory_order_relaxed);
+    // A stream cut over to may already have ended, what it buffered still plays
+    const bool idle = !mSourceOpen && state != PlayerState::Ended;
+    const bool restart = restartSink || idle ||
+                         (unacknowledged && mRestartSink.load(std::memory_order_relaxed));
+
+    // The stores before the generation bump are what the decode side reads after seeing it
+    mRestartSink.store(restart, std::memory_order_relaxed);
+    mStopRequested.store(idle, std::memory_order_relaxed);
+    mCommandPostedUs.store(postedUs, std::memory_order_relaxed);
+    mState.store(state, std::memory_order_relaxed);
+    mCutover.store(cutover, std::memory_order_relaxed);
+    mGeneration.fetch_add(1U, std::memory_order_release);
+
+    if (mListener != nullptr) {
+        mListener->onDataAvailable();
+    }
+}
+
+void PlayerPipeline::cancelStandby() {
+    mSwitchPending = false;
+    mSwitchInFlight = false;
+    if (mStreams[1].source == nullptr) {
+        return;
+    }
+
+    // Whatever the standby side holds or is opening is stale from here on
+    mSwitchSequence.fetch_add(1U, std::memory_order_release);
+    if (mListener != nullptr) {
+        mListener->onStandbyRequested();
+    }
+}
+
+bool PlayerPipeline::applyStandbyResult() {
+    if (!mSwitchInFlight) {
+        return false;
+    }
+    const uint32_t sequence = mSwitchSequence.load(std::memory_order_relaxed);
+
+    if (mStandbyFailed.load(std::memory_order_acquire) == sequence) {
+        // The station switched to is unreachable: as without a standby, it ends playback
+        mStreams[mActive.load(std::memory_order_relaxed)].source->close();
+        mSourceOpen = false;
+        mChunkLen = 0U;
+        mChunkPos = 0U;
+        cancelStandby();
+        publish(PlayerState::Failed, true, mSwitchPostedUs, false);
+        return true;
+    }
+
+    if (mStandbyReady.load(std::memory_order_acquire) != sequence) {
+        return false;
+    }
+
+    TRACE_INSTANT(PLAYER_CUTOVER, sequence);
+    const uint8_t active = mActive.load(std::memory_order_relaxed);
+    if (mSourceOpen) {
+        mStreams[active].source->close();
+    }
+    mChunkLen = 0U;
+    mChunkPos = 0U;
+
+    // The standby side lets go of the stream once it sees the sequence move past it
+    const bool ended = mStandbyEnded.load(std::memory_order_relaxed);
+    mSourceOpen = !ended;
+    mActive.store(1U - active, std::memory_order_relaxed);
+    mCutoverSequence.store(sequence, std::memory_order_relaxed);
+    cancelStandby();
+    sCutovers.add();
+
+    publish(ended ? PlayerState::Ended : PlayerState::Playing, false, mSwitchPostedUs, true);
+    return true;
+}
+
+bool PlayerPipeline::fillRing() {
+    if (!mSourceOpen) {
+        return false;
+    }
+
+    const Stream &stream = mStreams[mActive.load(std::memory_order_relaxed)];
+
+    if (mChunkPos == mChunkLen) {
+        int32_t count = 0;
+        {
+            TRACE_SCOPE(PLAYER_SOURCE_READ);
+            count = stream.source->read(mChunk.data(), mChunk.size());
+        }
+        if (count == IAudioSource::END_OF_STREAM) {
+            ESP_LOGI(TAG, "End of stream");
+            stream.source->close();
+            mSourceOpen = false;
+            mState.store(PlayerState::Ended, std::memory_order_relaxed);
+            // A decoder holding out for its decode-ahead target has to hear about it
+            if (mListener != nullptr) {
+                mListener->onDataAvailable();
+            }
+            return true;
+        }
+        // A source that timed out still counts as busy, it is polled again right away
+        mChunkLen = static_cast<size_t>(count);
+        mChunkPos = 0U;
+        if (count == 0) {
+            return true;
+        }
+    }
+
+    const size_t written = stream.ring->write(&mChunk[mChunkPos], mChunkLen - mChunkPos);
+    mChunkPos += written;
+    if (written == 0U) {
+        return false;  // ring full
+    }
+
+    if (mListener != nullptr) {
+        mListener->onDataAvailable();
+    }
+    return true;
+}
+
+bool PlayerPipeline::runDecodeStep() {
+    const uint32_t generation = mGeneration.load(std::memory_order_acquire);
+    if (generation != mDecoderGeneration.load(std::memory_order_relaxed)) {
+        if (mCutover.load(std::memory_order_relaxed) && mSinkRunning) {
+            fadeOutOldStream();
+        }
+        resync(generation);
+        return true;
+    }
+
+    if (mPrebuffering && !waitForDecodeAhead()) {
+        return false;
+    }
+
+    ByteRing &ring = *mStreams[mDecoding].ring;
+    const size_t fetched = ring.read(&mInput[mInputLen], mInput.size() - mInputLen);
+    if (fetched > 0U) {
+        mInputLen += fetched;
+        sRingFill.set(static_cast<int32_t>((ring.size() * 100U) / ring.capacity()));
+        if (mListener != nullptr) {
+            mListener->onSpaceAvailable();
+        }
+    }
+    if (mInputLen == 0U) {
+        // Ran dry mid-stream: build the reserve up again rather than stutter on every chunk
+        if (mSinkRunning && mState.load(std::memory_order_relaxed) == PlayerState::Playing) {
+            sRebuffers.add();
+            mPrebuffering = true;
+        }
+        return false;
+    }
+
+    size_t consumed = 0U;
+    int32_t frames = 0;
+    {
+        TRACE_SCOPE(PLAYER_DECODE);
+        frames = mDecoder.decode(mInput.data(), mInputLen, consumed, mPcm.data(),
+                                 MAX_DECODE_FRAMES);
+    }
+    std::memmove(mInput.data(), &mInput[consumed], mInputLen - consumed);
+    mInputLen -= consumed;
+
+    if (frames == IAudioDecoder::DECODE_ERROR) {
+        if (!mDecodeFailed) {
+            sDecodeErrors.add();
+            mDecodeFailed = true;
+        }
+        return true;
+    }
+    if (frames == 0) {
+        if (consumed == 0U && mInputLen == mInput.size()) {
+            ESP_LOGE(TAG, "Decoder stalled on a full input buffer, dropping it");
+            sDecodeErrors.add();
+            mInputLen = 0U;
+        }
+        return consumed > 0U || fetched > 0U;
+    }
+
+    const AudioFormat format = mDecoder.getFormat();
+    if ((format != mInputFormat || !mSinkRunning) && !configureOutput(format)) {
+        return true;
+    }
+
+    size_t count = static_cast<size_t>(frames);
+    for (size_t i = 0; i < mStageCount; ++i) {
+        count = mStages[i]->process(mPcm.data(), count, PCM_CAPACITY_FRAMES);
+    }
+    if (mFadeIn && count > 0U) {
+        fade(mPcm.data(), count, mOutputFormat.channels, true);
+        mFadeIn = false;
+    }
+    mSink.write(mPcm.data(), count);
+    if (count > 0U && mFirstAudioUs.load(std::memory_order_relaxed) == 0) {
+        mFirstAudioUs.store(esp_timer_get_time(), std::memory_order_relaxed);
+    }
+    tuneBuffers();
+
+    if (mLatencyStartUs != 0) {
+        sCommandLatency.record(static_cast<uint32_t>(esp_timer_get_time() - mLatencyStartUs));
+        mLatencyStartUs = 0;
+    }
+    return true;
+}
+
+void PlayerPipeline::resync(const uint32_t &generation) {
+    // The source side writes nothing until it sees the acknowledgement below, so everything
+    // in the ring belongs to the old stream. After a cutover the new stream is already
+    // buffered up to the watermark in the other ring.
+    mStreams[mDecoding].ring->clear();
+    mDecoding = mActive.load(std::memory_order_relaxed);
+    const bool cutover = mCutover.load(std::memory_order_relaxed);
+    mInputLen = 0U;
+    mDecoder.reset();
+    mDecodeFailed = false;
+    mPrebuffering = !cutover;
+    mFadeIn = cutover && mSinkRunning;
+
+    if (mRestartSink.load(std::memory_order_relaxed) && mSinkRunning) {
+        mSink.stop();
+        mSinkRunning = false;
+    }
+
+    const int64_t postedUs = mCommandPostedUs.load(std::memory_order_relaxed);
+    if (mStopRequested.load(std::memory_order_relaxed)) {
+        // Nothing more will play, the command is done once the sink is quiet. The tuner is
+        // only touched from this side, so its history is logged here too.
+        sCommandLatency.record(static_cast<uint32_t>(esp_timer_get_time() - postedUs));
+        mLatencyStartUs = 0;
+        if (mTuner != nullptr) {
+            mTuner->logHistory();
+        }
+    } else {
+        mLatencyStartUs = postedUs;
+    }
+
+    mDecoderGeneration.store(generation, std::memory_order_release);
+    sRingFill.set(0);
+
+    if (mListener != nullptr) {
+        mListener->onSpaceAvailable();
+    }
+}
+
+void PlayerPipeline::fadeOutOldStream() {
+    // One more block of the old stream, ramped down so the cutover does not click
+    ByteRing &ring = *mStreams[mDecoding].ring;
+    mInputLen += ring.read(&mInput[mInputLen], mInput.size() - mInputLen);
+
+    size_t consumed = 0U;
+    const int32_t frames =
+        mDecoder.decode(mInput.data(), mInputLen, consumed, mPcm.data(), FADE_FRAMES);
+    if (frames <= 0 || mDecoder.getFormat() != mInputFormat) {
+        return;
+    }
+
+    size_t count = static_cast<size_t>(frames);
+    for (size_t i = 0; i < mStageCount; ++i) {
+        count = mStages[i]->process(mPcm.data(), count, PCM_CAPACITY_FRAMES);
+    }
+    mSink.write(mPcm.data(), fade(mPcm.data(), count, mOutputFormat.channels, false));
+}
+
+bool PlayerPipeline::runStandbyStep() {
+    const uint32_t sequence = mSwitchSequence.load(std::memory_order_acquire);
+    if (mStandbyJob != 0U && mStandbyJob != sequence) {
+        // Either the source side took the stream over, or a newer command made it stale
+        if (mStandbyOpen && mCutoverSequence.load(std::memory_order_relaxed) != mStandbyJob) {
+            mStreams[mStandbySlot].source->close();
+            sSwitchesCancelled.add();
+        }
+        mStandbyJob = 0U;
+        mStandbyOpen = false;
+    }
+
+    // Targets queued behind each other collapse into the newest, like commands
+    StandbyRequest request;
+    bool requested = false;
+    while (mStandbyRequests.pop(request)) {
+        if (requested) {
+            sSwitchesCancelled.add();
+        }
+        requested = true;
+    }
+    if (requested) {
+        if (request.sequence != sequence) {
+            sSwitchesCancelled.add();  // superseded before it was opened
+            return true;
+        }
+
+        // Nothing reads this ring until the cutover, the producer may drop its contents
+        const Stream &stream = mStreams[request.slot];
+        stream.ring->clear();
+        mStandbyJob = request.sequence;
+        mStandbySlot = request.slot;
+        mStandbyPublished = false;
+        mStandbyChunkLen = 0U;
+        mStandbyChunkPos = 0U;
+        mStandbyEnded.store(false, std::memory_order_relaxed);
+
+        ESP_LOGI(TAG, "Standby opens %s", request.url.data());
+        mStandbyOpen = stream.source->open(request.url.data());
+        if (!mStandbyOpen) {
+            sSourceErrors.add();
+            mStandbyPublished = true;
+            mStandbyFailed.store(request.sequence, std::memory_order_release);
+            if (mListener != nullptr) {
+                mListener->onCommandPosted();
+            }
+        }
+        return true;
+    }
+
+    if (mStandbyJob == 0U || mStandbyPublished) {
+        return false;
+    }
+    return fillStandby();
+}
+
+bool PlayerPipeline::fillStandby() {
+    const Stream &stream = mStreams[mStandbySlot];
+    bool ended = false;
+
+    if (mStandbyChunkPos == mStandbyChunkLen) {
+        const int32_t count = stream.source->read(mStandbyChunk.data(), mStandbyChunk.size());
+        ended = (count == IAudioSource::END_OF_STREAM);
+        mStandbyChunkLen = ended ? 0U : static_cast<size_t>(count);
+        mStandbyChunkPos = 0U;
+    }
+    mStandbyChunkPos += stream.ring->write(&mStandbyChunk[mStandbyChunkPos],
+                                           mStandbyChunkLen - mStandbyChunkPos);
+
+    // The same reserve a fresh play waits for, at least a chunk so the decoder has a start
+    const size_t target = std::max(
+        CHUNK_SIZE, std::min(mStartWatermark.load(std::memory_order_relaxed),
+                             stream.ring->capacity() - CHUNK_SIZE));
+    if (!ended && stream.ring->size() < target) {
+        return true;
+    }
+
+    if (ended) {
+        stream.source->close();
+        mStandbyOpen = false;
+    }
+    // Bytes still in the chunk would be lost at the cutover; a full ring keeps them
+    if (mStandbyChunkPos != mStandbyChunkLen) {
+        return !ended && stream.ring->space() > 0U;
+    }
+
+    mStandbyPublished = true;
+    mStandbyEnded.store(ended, std::memory_order_relaxed);
+    mStandbyReady.store(mStandbyJob, std::memory_order_release);
+    if (mListener != nullptr) {
+        mListener->onCommandPosted();
+    }
+    return true;
+}
+
+bool PlayerPipeline::configureOutput(const AudioFormat &format) {
+    if (!format.isValid()) {
+        ESP_LOGE(TAG, "Decoder reported an invalid format");
+        sDecodeErrors.add();
+        return false;
+    }
+
+    AudioFormat output = format;
+    for (size_t i = 0; i < mStageCount; ++i) {
+        output = mStages[i]->configure(output);
+    }
+
+    mInputFormat = format;
+    if (mSinkRunning && output == mOutputFormat) {
+        return true;  // the stages absorbed the change, the sink keeps its clock
+    }
+
+    mOutputFormat = output;
+    mSinkRunning = mSink.configure(output);
+    if (!mSinkRunning) {
+        ESP_LOGE(TAG, "Sink rejected %u Hz, %u ch", static_cast<unsigned>(output.sampleRate),
+                 output.channels);
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Output %u Hz, %u ch", static_cast<unsigned>(output.sampleRate),
+             output.channels);
+
+    // The first window starts with the output, the silence before it is no underrun
+    if (mTelemetry != nullptr) {
+        mTelemetry->takeWindow();
+    }
+    mWindowStartUs = esp_timer_get_time();
+    return true;
+}
+
+bool PlayerPipeline::waitForDecodeAhead() {
+    // A stream that has ended or failed plays out what it has
+    const bool feeding = mState.load(std::memory_order_relaxed) == PlayerState::Playing;
+    const ByteRing &ring = *mStreams[mDecoding].ring;
+    const size_t target = std::min(mDecodeAheadBytes, ring.capacity() - CHUNK_SIZE);
+    if (feeding && ring.size() + mInputLen < target) {
+        return false;
+    }
+
+    mPrebuffering = false;
+    return true;
+}
+
+void PlayerPipeline::tuneBuffers() {
+    if (mTuner == nullptr || mTelemetry == nullptr) {
+        return;
+    }
+
+    const int64_t nowUs = esp_timer_get_time();
+    if (nowUs - mWindowStartUs < mTuningWindowUs) {
+        return;
+    }
+    mWindowStartUs = nowUs;
+
+    if (mTuner->update(mTelemetry->takeWindow(), nowUs)) {
+        applyBufferSettings();
+    }
+}
+
+void PlayerPipeline::applyBufferSettings() {
+    if (mTuner == nullptr) {
+        return;
+    }
+
+    const BufferSettings &settings = mTuner->getSettings();
+    mDecodeAheadBytes = settings.decodeAheadBytes;
+    mStartWatermark.store(mDecodeAheadBytes, std::memory_order_relaxed);
+    if (mTelemetry != nullptr) {
+        mTelemetry->applySettings(settings);
+    }
+}
+
+}  // namespace player
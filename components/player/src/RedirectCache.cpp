@@ -0,0 +1,156 @@
+#include "RedirectCache.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#include "IKeyValueStore.hpp"
+
+// IDF
+#include <esp_log.h>
+
+namespace player {
+static const char *TAG = "RedirectCache";
+
+static constexpr uint32_t FNV_OFFSET = 2166136261U;
+static constexpr uint32_t FNV_PRIME = 16777619U;
+
+static void copyUrl(RedirectCache::Url &dst, const char *src) {
+    std::strncpy(dst.data(), src, dst.size() - 1U);
+    dst.back() = '\0';
+}
+
+RedirectCache::RedirectCache(const int64_t &ttlUs, common::IKeyValueStore *store)
+    : mTtlUs(ttlUs), mStore(store), mEntries(nullptr) {}
+
+bool RedirectCache::init() {
+    mEntries = memory::makeBuffer<Entry, memory::MemoryClass::Psram>(MAX_ENTRIES);
+    if (!mEntries) {
+        ESP_LOGE(TAG, "No memory for %zu entries", MAX_ENTRIES);
+        return false;
+    }
+    return true;
+}
+
+bool RedirectCache::lookup(const char *url, const int64_t &nowUs, Url &target) {
+    if (!mEntries) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    Entry *entry = find(url);
+    if (entry != nullptr && entry->expiresUs <= nowUs) {
+        // Resolve again; the fresh answer is written back then
+        forgetLocked(url);
+        return false;
+    }
+
+    if (entry == nullptr && mStore != nullptr) {
+        Persisted persisted;
+        if (mStore->load(keyFor(url).data(), &persisted, sizeof(persisted)) ==
+                sizeof(persisted) &&
+            std::strncmp(persisted.url.data(), url, persisted.url.size()) == 0) {
+            entry = &claim(nowUs);
+            entry->url = persisted.url;
+            entry->target = persisted.target;
+            entry->expiresUs = nowUs + mTtlUs;
+            ESP_LOGI(TAG, "Restored %s -> %s", url, entry->target.data());
+        }
+    }
+
+    if (entry == nullptr) {
+        return false;
+    }
+    target = entry->target;
+    return true;
+}
+
+void RedirectCache::remember(const char *url, const char *target, const int64_t &nowUs) {
+    if (!mEntries) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    Entry *entry = find(url);
+    const bool changed =
+        entry == nullptr || std::strncmp(entry->target.data(), target, entry->target.size()) != 0;
+    if (entry == nullptr) {
+        entry = &claim(nowUs);
+    }
+    copyUrl(entry->url, url);
+    copyUrl(entry->target, target);
+    entry->expiresUs = nowUs + mTtlUs;
+
+    // Flash only sees targets that moved
+    if (changed && mStore != nullptr) {
+        const Persisted persisted{entry->url, entry->target};
+        mStore->save(keyFor(url).data(), &persisted, sizeof(persisted));
+    }
+}
+
+void RedirectCache::forget(const char *url) {
+    if (!mEntries) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    forgetLocked(url);
+}
+
+void RedirectCache::forgetLocked(const char *url) {
+    Entry *entry = find(url);
+    if (entry != nullptr) {
+        *entry = Entry{};
+    }
+    if (mStore != nullptr) {
+        mStore->erase(keyFor(url).data());
+    }
+}
+
+size_t RedirectCache::size() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    size_t count = 0U;
+    for (size_t i = 0; mEntries && i < MAX_ENTRIES; ++i) {
+        count += (mEntries[i].url[0] != '\0') ? 1U : 0U;
+    }
+    return count;
+}
+
+RedirectCache::Key RedirectCache::keyFor(const char *url) {
+    // NVS keys are short; a URL hash is unique enough among a handful of stations, and a
+    // collision only costs a miss since the full URL is compared on load
+    uint32_t hash = FNV_OFFSET;
+    for (const char *c = url; *c != '\0'; ++c) {
+        hash = (hash ^ static_cast<uint8_t>(*c)) * FNV_PRIME;
+    }
+
+    Key key{};
+    std::snprintf(key.data(), key.size(), "r%08x", static_cast<unsigned>(hash));
+    return key;
+}
+
+RedirectCache::Entry *RedirectCache::find(const char *url) {
+    for (size_t i = 0; i < MAX_ENTRIES; ++i) {
+        if (mEntries[i].url[0] != '\0' &&
+            std::strncmp(mEntries[i].url.data(), url, mEntries[i].url.size()) == 0) {
+            return &mEntries[i];
+        }
+    }
+    return nullptr;
+}
+
+RedirectCache::Entry &RedirectCache::claim(const int64_t &nowUs) {
+    // A free slot, or else the entry closest to expiring
+    Entry *victim = &mEntries[0];
+    for (size_t i = 0; i < MAX_ENTRIES; ++i) {
+        Entry &entry = mEntries[i];
+        if (entry.url[0] == '\0' || entry.expiresUs <= nowUs) {
+            return entry;
+        }
+        if (entry.expiresUs < victim->expiresUs) {
+            victim = &entry;
+        }
+    }
+    return *victim;
+}
+
+}  // namespace player
@@ -0,0 +1,194 @@
+#include "Resampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+// IDF
+#include <esp_log.h>
+
+namespace player {
+static const char *TAG = "Resampler";
+
+// Kaiser window shape and the low-pass corner as a fraction of the lower Nyquist rate: about
+// 80 dB of image rejection with the transition band just below the corner
+static constexpr float KAISER_BETA = 8.0F;
+static constexpr float CUTOFF = 0.9F;
+static constexpr float PI = 3.14159265358979F;
+
+// Zeroth-order modified Bessel function of the first kind, for the Kaiser window
+static float besselI0(const float &x) {
+    float sum = 1.0F;
+    float term = 1.0F;
+    const float quarterSquare = x * x * 0.25F;
+    for (int k = 1; k < 32 && term > sum * 1e-9F; ++k) {
+        term *= quarterSquare / static_cast<float>(k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+static inline int16_t saturate(const int32_t &acc) {
+    const int32_t value = (acc + (1 << 14)) >> 15;
+    return static_cast<int16_t>(std::clamp<int32_t>(value, INT16_MIN, INT16_MAX));
+}
+
+Resampler::Resampler(const uint32_t &outputRate)
+    : mOutputRate(outputRate),
+      mInput(),
+      mBypass(true),
+      mUp(1U),
+      mDown(1U),
+      mPhase(0U),
+      mHistoryFrames(0U),
+      mCoefficients{},
+      mHistory{} {}
+
+AudioFormat Resampler::configure(const AudioFormat &input) {
+    mInput = input;
+    mBypass = true;
+    mUp = 1U;
+    mDown = 1U;
+
+    if (!input.isValid() || input.sampleRate == mOutputRate) {
+        return input;
+    }
+
+    const uint32_t divisor = std::gcd(input.sampleRate, mOutputRate);
+    const uint32_t up = mOutputRate / divisor;
+    const uint32_t down = input.sampleRate / divisor;
+    if (up > MAX_PHASES || up > down * MAX_UPSAMPLE) {
+        ESP_LOGW(TAG, "No conversion %u -> %u Hz (L/M %u/%u), passing through",
+                 static_cast<unsigned>(input.sampleRate), static_cast<unsigned>(mOutputRate),
+                 static_cast<unsigned>(up), static_cast<unsigned>(down));
+        return input;
+    }
+
+    mBypass = false;
+    mUp = up;
+    mDown = down;
+    designFilter();
+
+    // Half a window of silence ahead of the first frame puts output 0 exactly on input 0
+    mPhase = 0U;
+    mHistoryFrames = TAPS / 2U - 1U;
+    std::fill(mHistory.begin(), mHistory.end(), 0);
+
+    ESP_LOGI(TAG, "%u -> %u Hz, L/M %u/%u", static_cast<unsigned>(input.sampleRate),
+             static_cast<unsigned>(mOutputRate), static_cast<unsigned>(mUp),
+             static_cast<unsigned>(mDown));
+
+    AudioFormat output = input;
+    output.sampleRate = mOutputRate;
+    return output;
+}
+
+void Resampler::designFilter() {
+    // Corner relative to the input Nyquist rate: downsampling has to cut below the output's
+    const float corner =
+        CUTOFF * std::min(1.0F, static_cast<float>(mUp) / static_cast<float>(mDown));
+    const float halfWidth = static_cast<float>(TAPS) / 2.0F;
+    const float windowNorm = besselI0(KAISER_BETA);
+
+    std::array<float, TAPS> taps{};
+    for (uint32_t phase = 0; phase < mUp; ++phase) {
+        // Tap j weighs input frame (start + j) for an output at start + TAPS/2 - 1 + phase/L
+        float sum = 0.0F;
+        for (size_t j = 0; j < TAPS; ++j) {
+            const float t = halfWidth - 1.0F - static_cast<float>(j) +
+                            static_cast<float>(phase) / static_cast<float>(mUp);
+            const float x = corner * t;
+            const float sinc = (std::fabs(x) < 1e-6F) ? 1.0F : std::sin(PI * x) / (PI * x);
+            const float ratio = t / halfWidth;
+            const float window =
+                (std::fabs(ratio) >= 1.0F)
+                    ? 0.0F
+                    : besselI0(KAISER_BETA * std::sqrt(1.0F - ratio * ratio)) / windowNorm;
+            taps[j] = sinc * window;
+            sum += taps[j];
+        }
+
+        // Each phase passes DC at exactly unity; the rounding residue goes to the largest tap
+        int16_t *out = &mCoefficients[phase * TAPS];
+        int32_t total = 0;
+        size_t largest = 0U;
+        for (size_t j = 0; j < TAPS; ++j) {
+            out[j] = static_cast<int16_t>(std::lround(taps[j] / sum * 32768.0F));
+            total += out[j];
+            if (std::abs(out[j]) > std::abs(out[largest])) {
+                largest = j;
+            }
+        }
+        out[largest] = static_cast<int16_t>(out[largest] + (32768 - total));
+    }
+}
+
+size_t Resampler::process(int16_t *pcm, const size_t &frames, const size_t &capacity) {
+    if (mBypass) {
+        return frames;
+    }
+
+    const size_t channels = mInput.channels;
+    const size_t room = MAX_INPUT_FRAMES + TAPS - mHistoryFrames;
+    const size_t taken = std::min(frames, room);
+    if (taken < frames) {
+        ESP_LOGW(TAG, "Input of %zu frames exceeds %zu, dropping the rest", frames, room);
+    }
+
+    // The whole input moves into the history first, so the output can overwrite pcm
+    std::memcpy(&mHistory[mHistoryFrames * channels], pcm, taken * channels * sizeof(int16_t));
+    mHistoryFrames += taken;
+
+    size_t produced = 0U;
+    size_t start = 0U;
+    while (start + TAPS <= mHistoryFrames && produced < capacity) {
+        const int16_t *h = &mCoefficients[mPhase * TAPS];
+        const int16_t *x = &mHistory[start * channels];
+
+        if (channels == 2U) {
+            int32_t left = 0;
+            int32_t right = 0;
+            for (size_t k = 0; k < TAPS; ++k) {
+                left += h[k] * x[2U * k];
+                right += h[k] * x[2U * k + 1U];
+            }
+            pcm[2U * produced] = saturate(left);
+            pcm[2U * produced + 1U] = saturate(right);
+        } else {
+            int32_t acc = 0;
+            for (size_t k = 0; k < TAPS; ++k) {
+                acc += h[k] * x[k];
+            }
+            pcm[produced] = saturate(acc);
+        }
+        ++produced;
+
+        mPhase += mDown;
+        while (mPhase >= mUp) {
+            mPhase -= mUp;
+            ++start;
+        }
+    }
+
+    // Keep the frames the next window still needs at the front
+    const size_t kept = mHistoryFrames - std::min(start, mHistoryFrames);
+    std::memmove(mHistory.data(), &mHistory[(mHistoryFrames - kept) * channels],
+                 kept * channels * sizeof(int16_t));
+    mHistoryFrames = kept;
+    return produced;
+}
+
+bool Resampler::isBypassed() const {
+    return mBypass;
+}
+
+uint32_t Resampler::getUpFactor() const {
+    return mUp;
+}
+
+uint32_t Resampler::getDownFactor() const {
+    return mDown;
+}
+
+}  // namespace player
@@ -0,0 +1,118 @@
+#include "SpectrumAnalyzer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Metrics.hpp"
+#include "SpectrumTap.hpp"
+
+// IDF
+#include <esp_timer.h>
+
+namespace player {
+static constexpr double PI = 3.14159265358979323846;
+static constexpr double Q15_ONE = 32767.0;
+
+// A full scale sine peaks at a quarter of full scale after the Hann window and the FFT's
+// 1/N, which is 2^26 in power. 16 bits of power below that is 48 dB.
+static constexpr uint32_t FULL_SCALE_LOG2_Q8 = 26U << 8U;
+static constexpr uint32_t RANGE_LOG2_Q8 = 16U << 8U;
+static constexpr uint32_t FLOOR_LOG2_Q8 = FULL_SCALE_LOG2_Q8 - RANGE_LOG2_Q8;
+
+static metrics::Gauge sAnalyzeUs("spectrum.analyze_us");
+
+// log2 in Q8, the fraction taken linearly from the bits below the leading one
+static uint32_t log2Q8(const uint32_t &value) {
+    if (value == 0U) {
+        return 0U;
+    }
+
+    const uint32_t msb = 31U - static_cast<uint32_t>(__builtin_clz(value));
+    const uint32_t fraction = (msb >= 8U) ? (value >> (msb - 8U)) : (value << (8U - msb));
+    return (msb << 8U) | (fraction & 0xFFU);
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer(const SpectrumTap &tap)
+    : mTap(tap),
+      mFft(),
+      mEdges{},
+      mWindow{},
+      mRe{},
+      mIm{},
+      mPower{},
+      mLastWritten(0U),
+      mLevels{} {
+    for (size_t i = 0; i < FFT_POINTS; ++i) {
+        const double phase = 2.0 * PI * static_cast<double>(i) / static_cast<double>(FFT_POINTS);
+        mWindow[i] = static_cast<int16_t>(std::lround(0.5 * (1.0 - std::cos(phase)) * Q15_ONE));
+    }
+
+    // Bands grow geometrically from bin 1 (DC is left out) so each covers a similar musical
+    // interval; the low ones get at least one bin each
+    const double ratio = static_cast<double>(Fft::BINS);
+    mEdges[0] = 1U;
+    mEdges[BARS] = static_cast<uint16_t>(Fft::BINS);
+    for (size_t b = 1; b < BARS; ++b) {
+        const double ideal = std::pow(ratio, static_cast<double>(b) / static_cast<double>(BARS));
+        const long rounded = std::lround(ideal);
+        const long lowest = mEdges[b - 1U] + 1L;
+        const long highest = static_cast<long>(Fft::BINS - (BARS - b));
+        mEdges[b] = static_cast<uint16_t>(std::clamp(rounded, lowest, highest));
+    }
+}
+
+bool SpectrumAnalyzer::update(Levels &levels) {
+    const int64_t startUs = esp_timer_get_time();
+
+    Levels target{};
+    const uint32_t written = mTap.getWritten();
+    const bool fresh = (written != mLastWritten) && mTap.readLatest(mRe.data(), FFT_POINTS);
+    if (fresh) {
+        mLastWritten = written;
+        for (size_t i = 0; i < FFT_POINTS; ++i) {
+            mRe[i] = static_cast<int16_t>((mRe[i] * mWindow[i]) >> 15);
+        }
+        mIm.fill(0);
+        mFft.transform(mRe.data(), mIm.data());
+        Fft::power(mRe.data(), mIm.data(), mPower.data());
+        mapBars(mPower.data(), mEdges, target);
+    }
+
+    bool lit = false;
+    for (size_t b = 0; b < BARS; ++b) {
+        const uint8_t fallen = (mLevels[b] > FALL_PER_FRAME) ? mLevels[b] - FALL_PER_FRAME : 0U;
+        mLevels[b] = std::max(target[b], fallen);
+        lit = lit || mLevels[b] != 0U;
+    }
+    levels = mLevels;
+
+    if (fresh) {
+        sAnalyzeUs.set(static_cast<int32_t>(esp_timer_get_time() - startUs));
+    }
+    return fresh || lit;
+}
+
+const SpectrumAnalyzer::BandEdges &SpectrumAnalyzer::getBandEdges() const {
+    return mEdges;
+}
+
+uint8_t SpectrumAnalyzer::toLevel(const uint32_t &power) {
+    const uint32_t log2 = log2Q8(power);
+    if (log2 <= FLOOR_LOG2_Q8) {
+        return 0U;
+    }
+    const uint32_t above = std::min(log2 - FLOOR_LOG2_Q8, RANGE_LOG2_Q8);
+    return static_cast<uint8_t>((above * MAX_LEVEL + RANGE_LOG2_Q8 / 2U) / RANGE_LOG2_Q8);
+}
+
+void SpectrumAnalyzer::mapBars(const uint32_t *power, const BandEdges &edges, Levels &levels) {
+    for (size_t b = 0; b < BARS; ++b) {
+        uint32_t peak = 0U;
+        for (size_t k = edges[b]; k < edges[b + 1U]; ++k) {
+            peak = std::max(peak, power[k]);
+        }
+        levels[b] = toLevel(peak);
+    }
+}
+
+}  // namespace player
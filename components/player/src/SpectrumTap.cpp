@@ -0,0 +1,72 @@
+#include "SpectrumTap.hpp"
+
+namespace player {
+
+SpectrumTap::SpectrumTap()
+    : mChannels(0U), mSum(0), mSummed(0U), mRing{}, mWritten(0U), mSampleRate(0U) {}
+
+AudioFormat SpectrumTap::configure(const AudioFormat &input) {
+    mChannels = input.channels;
+    mSum = 0;
+    mSummed = 0U;
+    mSampleRate.store(input.sampleRate / DECIMATION, std::memory_order_relaxed);
+    return input;
+}
+
+size_t SpectrumTap::process(int16_t *pcm, const size_t &frames, const size_t &capacity) {
+    (void)capacity;
+    if (mChannels == 0U) {
+        return frames;
+    }
+
+    // The box average is a crude low-pass, enough to keep bars from lighting up with aliases
+    const int32_t divisor = static_cast<int32_t>(DECIMATION * mChannels);
+    uint32_t written = mWritten.load(std::memory_order_relaxed);
+    const int16_t *sample = pcm;
+    for (size_t f = 0; f < frames; ++f) {
+        for (uint8_t c = 0; c < mChannels; ++c) {
+            mSum += *sample++;
+        }
+        if (++mSummed < DECIMATION) {
+            continue;
+        }
+
+        mRing[written & (CAPACITY - 1U)].store(static_cast<int16_t>(mSum / divisor),
+                                               std::memory_order_relaxed);
+        ++written;
+        mSum = 0;
+        mSummed = 0U;
+    }
+
+    // One release per block publishes every sample appended by it
+    mWritten.store(written, std::memory_order_release);
+    return frames;
+}
+
+bool SpectrumTap::readLatest(int16_t *dst, const size_t &count) const {
+    const uint32_t end = mWritten.load(std::memory_order_acquire);
+    if (count > CAPACITY || end < count) {
+        return false;
+    }
+
+    const uint32_t start = end - static_cast<uint32_t>(count);
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = mRing[(start + i) & (CAPACITY - 1U)].load(std::memory_order_relaxed);
+    }
+
+    // Anything appended past end reuses slots from start on; the copy is only whole if the
+    // decoder stayed clear of them
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint32_t now = mWritten.load(std::memory_order_relaxed);
+    return (now - end) <= CAPACITY - count;
+}
+
+uint32_t SpectrumTap::getWritten() const {
+    return mWritten.load(std::memory_order_acquire);
+}
+
+uint32_t SpectrumTap::getSampleRate() const {
+    return mSampleRate.load(std::memory_order_relaxed);
+}
+
+}  // namespace player
@@ -0,0 +1,42 @@
+#include "VolumeStage.hpp"
+
+#include <algorithm>
+
+namespace player {
+static constexpr int VOLUME_MAX = 100;
+
+VolumeStage::VolumeStage() : mFormat(), mGain(UNITY_GAIN) {}
+
+void VolumeStage::setVolume(const int &percent) {
+    // Square law: loudness follows the knob closer than a linear gain does
+    const int32_t clamped = std::clamp(percent, 0, VOLUME_MAX);
+    mGain.store((clamped * clamped * UNITY_GAIN) / (VOLUME_MAX * VOLUME_MAX),
+                std::memory_order_relaxed);
+}
+
+int32_t VolumeStage::getGain() const {
+    return mGain.load(std::memory_order_relaxed);
+}
+
+AudioFormat VolumeStage::configure(const AudioFormat &input) {
+    mFormat = input;
+    return input;
+}
+
+size_t VolumeStage::process(int16_t *pcm, const size_t &frames, const size_t &capacity) {
+    (void)capacity;
+
+    const int32_t gain = mGain.load(std::memory_order_relaxed);
+    if (gain == UNITY_GAIN) {
+        return frames;
+    }
+
+    // The gain never exceeds unity, so the product cannot leave the int16 range
+    const size_t samples = frames * mFormat.channels;
+    for (size_t i = 0; i < samples; ++i) {
+        pcm[i] = static_cast<int16_t>((pcm[i] * gain) >> 15);
+    }
+    return frames;
+}
+
+}  // namespace player
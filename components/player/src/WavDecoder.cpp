@@ -0,0 +1,164 @@
+#include "WavDecoder.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+// IDF
+#include <esp_log.h>
+
+namespace player {
+static const char *TAG = "WavDecoder";
+
+static constexpr size_t RIFF_HEADER_SIZE = 12U;
+static constexpr size_t CHUNK_HEADER_SIZE = 8U;
+static constexpr uint32_t MIN_FORMAT_SIZE = 16U;
+static constexpr uint32_t MAX_FORMAT_SIZE = 40U;  // WAVE_FORMAT_EXTENSIBLE
+static constexpr uint16_t FORMAT_PCM = 0x0001U;
+static constexpr uint16_t FORMAT_EXTENSIBLE = 0xFFFEU;
+static constexpr uint16_t BITS_PER_SAMPLE = 16U;
+// Encoders writing a stream of unknown length put either of these in the size fields
+static constexpr uint32_t SIZE_OPEN = 0xFFFFFFFFU;
+static constexpr uint32_t SIZE_UNSET = 0U;
+
+static uint16_t readLe16(const uint8_t *p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t readLe32(const uint8_t *p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+WavDecoder::WavDecoder() {
+    reset();
+}
+
+void WavDecoder::reset() {
+    mState = State::Riff;
+    mFormat = AudioFormat();
+    mSkip = 0U;
+    mDataRemaining = 0U;
+    mDataUnbounded = false;
+}
+
+int32_t WavDecoder::decode(const uint8_t *in, const size_t &len, size_t &consumed, int16_t *pcm,
+                           const size_t &maxFrames) {
+    consumed = 0U;
+    while (mState == State::Riff || mState == State::Chunks) {
+        const size_t used = parseHeader(&in[consumed], len - consumed);
+        if (used == 0U) {
+            return 0;
+        }
+        consumed += used;
+    }
+
+    if (mState == State::Failed) {
+        consumed = len;
+        return DECODE_ERROR;
+    }
+
+    if (mState == State::Trailer) {
+        consumed = len;  // whatever follows the samples is of no interest
+        return 0;
+    }
+
+    const size_t frameBytes = mFormat.frameBytes();
+    size_t available = len - consumed;
+    if (!mDataUnbounded) {
+        available = std::min<size_t>(available, mDataRemaining);
+    }
+    const size_t frames = std::min(available / frameBytes, maxFrames);
+    const size_t bytes = frames * frameBytes;
+
+    // Both the ESP32-S3 and the host are little-endian, like the file
+    std::memcpy(pcm, &in[consumed], bytes);
+    consumed += bytes;
+
+    if (!mDataUnbounded) {
+        mDataRemaining -= static_cast<uint32_t>(bytes);
+        if (mDataRemaining < frameBytes) {
+            mState = State::Trailer;
+        }
+    }
+    return static_cast<int32_t>(frames);
+}
+
+AudioFormat WavDecoder::getFormat() const {
+    return mFormat;
+}
+
+size_t WavDecoder::parseHeader(const uint8_t *in, const size_t &len) {
+    if (mSkip > 0U) {
+        const size_t skipped = std::min<size_t>(mSkip, len);
+        mSkip -= static_cast<uint32_t>(skipped);
+        return skipped;
+    }
+
+    if (mState == State::Riff) {
+        if (len < RIFF_HEADER_SIZE) {
+            return 0U;
+        }
+        if (std::memcmp(in, "RIFF", 4) != 0 || std::memcmp(&in[8], "WAVE", 4) != 0) {
+            return fail("not a RIFF/WAVE stream");
+        }
+        mState = State::Chunks;
+        return RIFF_HEADER_SIZE;
+    }
+
+    if (len < CHUNK_HEADER_SIZE) {
+        return 0U;
+    }
+    const uint32_t size = readLe32(&in[4]);
+
+    if (std::memcmp(in, "fmt ", 4) == 0) {
+        if (size < MIN_FORMAT_SIZE || size > MAX_FORMAT_SIZE) {
+            return fail("unexpected fmt chunk size");
+        }
+        if (len < CHUNK_HEADER_SIZE + size + (size & 1U)) {
+            return 0U;
+        }
+        return parseFormat(&in[CHUNK_HEADER_SIZE], size);
+    }
+
+    if (std::memcmp(in, "data", 4) == 0) {
+        if (!mFormat.isValid()) {
+            return fail("data before fmt");
+        }
+        mDataUnbounded = (size == SIZE_OPEN || size == SIZE_UNSET);
+        mDataRemaining = size;
+        mState = State::Data;
+        ESP_LOGI(TAG, "PCM %u Hz, %u ch", static_cast<unsigned>(mFormat.sampleRate),
+                 mFormat.channels);
+        return CHUNK_HEADER_SIZE;
+    }
+
+    // LIST, fact and the like; chunks are padded to an even size
+    mSkip = size + (size & 1U);
+    return CHUNK_HEADER_SIZE;
+}
+
+size_t WavDecoder::parseFormat(const uint8_t *body, const uint32_t &size) {
+    const uint16_t tag = readLe16(body);
+    const uint16_t channels = readLe16(&body[2]);
+    const uint32_t sampleRate = readLe32(&body[4]);
+    const uint16_t bits = readLe16(&body[14]);
+
+    if ((tag != FORMAT_PCM && tag != FORMAT_EXTENSIBLE) || bits != BITS_PER_SAMPLE) {
+        return fail("only 16-bit PCM is supported");
+    }
+    if (channels == 0U || channels > MAX_CHANNELS || sampleRate == 0U) {
+        return fail("unsupported channel count or rate");
+    }
+
+    mFormat.sampleRate = sampleRate;
+    mFormat.channels = static_cast<uint8_t>(channels);
+    return CHUNK_HEADER_SIZE + size + (size & 1U);
+}
+
+size_t WavDecoder::fail(const char *reason) {
+    ESP_LOGW(TAG, "Cannot decode: %s", reason);
+    mState = State::Failed;
+    return 1U;  // any progress, the caller sees the failed state next
+}
+
+}  // namespace player
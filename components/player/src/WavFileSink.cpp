@@ -0,0 +1,86 @@
+#include "WavFileSink.hpp"
+
+#include <array>
+
+// IDF
+#include <esp_log.h>
+
+namespace player {
+static const char *TAG = "WavFileSink";
+
+static constexpr size_t HEADER_SIZE = 44U;
+
+static void putLe16(uint8_t *p, const uint32_t &value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+}
+
+static void putLe32(uint8_t *p, const uint32_t &value) {
+    putLe16(p, value);
+    putLe16(&p[2], value >> 16);
+}
+
+WavFileSink::WavFileSink(const std::string &path)
+    : mPath(path), mFile(nullptr), mFormat(), mDataBytes(0U) {}
+
+WavFileSink::~WavFileSink() {
+    stop();
+}
+
+bool WavFileSink::configure(const AudioFormat &format) {
+    if (mFile != nullptr && format == mFormat) {
+        return true;
+    }
+    stop();
+
+    mFile = std::fopen(mPath.c_str(), "wb");
+    if (mFile == nullptr) {
+        ESP_LOGE(TAG, "Cannot create %s", mPath.c_str());
+        return false;
+    }
+
+    mFormat = format;
+    mDataBytes = 0U;
+    writeHeader();  // placeholder sizes, patched on stop
+    return true;
+}
+
+void WavFileSink::write(const int16_t *pcm, const size_t &frames) {
+    if (mFile == nullptr) {
+        return;
+    }
+    mDataBytes += static_cast<uint32_t>(
+        std::fwrite(pcm, mFormat.frameBytes(), frames, mFile) * mFormat.frameBytes());
+}
+
+void WavFileSink::stop() {
+    if (mFile == nullptr) {
+        return;
+    }
+    std::fseek(mFile, 0, SEEK_SET);
+    writeHeader();
+    std::fclose(mFile);
+    mFile = nullptr;
+}
+
+void WavFileSink::writeHeader() {
+    const uint32_t byteRate = mFormat.sampleRate * static_cast<uint32_t>(mFormat.frameBytes());
+
+    std::array<uint8_t, HEADER_SIZE> header{'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V',
+                                            'E', 'f', 'm', 't', ' ', 16, 0, 0, 0, 1, 0};
+    putLe32(&header[4], static_cast<uint32_t>(HEADER_SIZE - 8U) + mDataBytes);
+    putLe16(&header[22], mFormat.channels);
+    putLe32(&header[24], mFormat.sampleRate);
+    putLe32(&header[28], byteRate);
+    putLe16(&header[32], static_cast<uint32_t>(mFormat.frameBytes()));
+    putLe16(&header[34], 16U);
+    header[36] = 'd';
+    header[37] = 'a';
+    header[38] = 't';
+    header[39] = 'a';
+    putLe32(&header[40], mDataBytes);
+
+    std::fwrite(header.data(), 1U, header.size(), mFile);
+}
+
+}  // namespace player
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace services {
+// Edge-driven debouncer. A press is reported on the first active edge, so the latency is
+// only the ISR + task wakeup; the release is confirmed lazily once the line has been
+// inactive for the settle time, which makes contact bounce invisible without any timer.
+class ButtonDebouncer {
+   public:
+    static constexpr uint32_t DEFAULT_SETTLE_US = 20000U;
+
+    explicit ButtonDebouncer(const uint32_t &settleUs = DEFAULT_SETTLE_US,
+                             const uint8_t &activeLevel = 0U);
+
+    // Returns true when the edge starts a new press
+    bool onEdge(const uint8_t &level, const uint64_t &timestampUs);
+    bool isPressed() const;
+
+   private:
+    uint32_t mSettleUs;
+    uint8_t mActiveLevel;
+    uint8_t mRawLevel;
+    bool mPressed;
+    bool mHasEdge;
+    uint64_t mLastEdgeUs;
+};
+
+}  // namespace services
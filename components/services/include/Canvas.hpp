@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "BoardConfig.hpp"
+#include "IDisplay.hpp"
+#include "OledPanel.hpp"
+
+namespace services {
+// Drawing on a page-organised monochrome framebuffer with a clip rectangle. Text sits on
+// page rows, x is in pixels. Geometry comes from the panel descriptor at compile time;
+// instantiated in Canvas.cpp for the panels listed there.
+template <typename Panel>
+class BasicCanvas {
+   public:
+    static constexpr uint8_t WIDTH = Panel::WIDTH;              // pixels
+    static constexpr uint8_t PAGE_HEIGHT = Panel::PAGE_HEIGHT;  // pixels
+    static constexpr uint8_t PAGES = Panel::PAGES;
+    static constexpr size_t FRAME_SIZE = Panel::FRAME_SIZE;     // bytes
+    static constexpr uint8_t GLYPH_WIDTH = 5U;                  // pixels
+    static constexpr uint8_t GLYPH_ADVANCE = GLYPH_WIDTH + 1U;  // 5px glyph + 1px spacing
+    static constexpr adapters::DisplayRegion SCREEN = {0U, WIDTH - 1U, 0U, PAGES - 1U};
+
+    using Framebuffer = std::array<uint8_t, FRAME_SIZE>;
+
+    // Byte holding column x of a page row
+    static constexpr size_t offset(const uint8_t &x, const uint8_t &page) {
+        return static_cast<size_t>(page) * WIDTH + x;
+    }
+
+    BasicCanvas();
+
+    // Resets the clip to the whole screen
+    void setTarget(uint8_t *framebuffer);
+    void setClip(const adapters::DisplayRegion &clip);
+    const adapters::DisplayRegion &getClip() const;
+
+    void fill(const adapters::DisplayRegion &area, const uint8_t &pattern);
+    // UTF-8 text; code points without a glyph are drawn as '?'
+    void drawText(const uint8_t &x, const uint8_t &page, const std::string_view &txt,
+                  const bool &inverted);
+    // One byte: ASCII or one of the icons below it
+    void drawChar(const uint8_t &x, const uint8_t &page, const char &c, const bool &inverted);
+    void drawGlyph(const uint8_t &x, const uint8_t &page, const uint32_t &codepoint,
+                   const bool &inverted);
+
+    // Pixels drawText() advances over txt
+    static size_t textWidth(const std::string_view &txt);
+
+    // Moves the pages of a full-width area up by rows (down when negative), ignoring the
+    // clip. The rows left behind keep their old pixels
+    void movePages(const adapters::DisplayRegion &area, const int &rows);
+
+   private:
+    uint8_t *mFramebuffer;
+    adapters::DisplayRegion mClip;
+};
+
+extern template class BasicCanvas<common::Ssd1306Panel128x64>;
+extern template class BasicCanvas<common::Ssd1306Panel128x32>;
+extern template class BasicCanvas<common::Sh1106Panel128x64>;
+
+// The panel this board is built with; widgets and the UI draw on this one
+using Canvas = BasicCanvas<common::BoardOledPanel>;
+
+}  // namespace services
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "IDisplay.hpp"
+
+namespace services {
+// Bounded set of screen rectangles that changed. Overlapping or touching rectangles are
+// merged while that does not grow the area, and once full the closest pair is merged, so
+// the list only ever over-approximates the damage.
+class DamageList {
+   public:
+    static constexpr size_t MAX_REGIONS = 8U;
+
+    void add(const adapters::DisplayRegion &region);
+    void markAll();
+    void clear();
+
+    // Moves the parts inside area by rows pages (up when positive), as a vertical scroll of
+    // that area does. Parts pushed out of the area are dropped
+    void shift(const adapters::DisplayRegion &area, const int &rows);
+
+    bool isEmpty() const;
+    bool coversAll() const;
+    size_t count() const;
+    const adapters::DisplayRegion *data() const;
+
+    static bool intersects(const adapters::DisplayRegion &a, const adapters::DisplayRegion &b);
+    static adapters::DisplayRegion intersection(const adapters::DisplayRegion &a,
+                                                const adapters::DisplayRegion &b);
+
+   private:
+    void insert(const adapters::DisplayRegion &region);
+
+    std::array<adapters::DisplayRegion, MAX_REGIONS> mRegions{};
+    size_t mCount = 0U;
+};
+
+}  // namespace services
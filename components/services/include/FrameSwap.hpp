@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "Canvas.hpp"
+#include "DamageList.hpp"
+
+namespace services {
+// Two framebuffers shared by one renderer and one flusher without locks. The renderer
+// draws into the back buffer while the front one is on the wire. A published frame that
+// the flusher has not picked up yet is reclaimed by the next render, so only the newest
+// frame is ever sent and stale ones are dropped. Buffers are sized for the board panel at
+// compile time.
+class FrameSwap {
+   public:
+    static constexpr uint8_t BUFFER_COUNT = 2U;
+
+    // What the flusher must do to bring the panel from the previous frame to this one
+    struct FrameInfo {
+        uint64_t oldestChangeUs = 0U;
+        DamageList damage;       // areas to upload
+        int8_t scrollPages = 0;  // panel rotation to apply before the upload
+    };
+
+    FrameSwap();
+
+    // Renderer. Returns the back buffer holding the latest content; changeUs stamps the
+    // oldest change that is not on the display yet
+    uint8_t *beginFrame(const uint64_t &changeUs);
+    // Damage of the frame being rendered. A reclaimed frame keeps what it had collected
+    FrameInfo &backInfo();
+    void publishFrame();
+
+    // Flusher. Returns nullptr when nothing new was published
+    const uint8_t *acquireFront(FrameInfo &info);
+    void releaseFront();
+
+    size_t size() const;
+    uint32_t getDroppedFrames() const;
+
+   private:
+    static constexpr uint8_t NONE = 0x03U;
+
+    static uint8_t makeState(const uint8_t &pending, const uint8_t &flushing);
+
+    std::array<Canvas::Framebuffer, BUFFER_COUNT> mBuffers;
+    std::array<FrameInfo, BUFFER_COUNT> mInfo;
+
+    // bits 0-1: published buffer waiting for the flusher, bits 2-3: buffer being flushed
+    std::atomic<uint8_t> mState;
+
+    // Renderer-owned
+    uint8_t mBack;
+    uint8_t mLastPublished;
+    bool mRendering;
+    uint32_t mDroppedFrames;
+};
+
+}  // namespace services
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace services {
+class IFrameListener {
+   public:
+    virtual ~IFrameListener() = default;
+
+    // A new frame was published; must not block the renderer
+    virtual void onFrameReady() = 0;
+};
+
+}  // namespace services
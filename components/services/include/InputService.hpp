@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "ButtonDebouncer.hpp"
+#include "InputTypes.hpp"
+#include "QuadratureDecoder.hpp"
+
+namespace common {
+class IClock;
+}  // namespace common
+
+namespace core {
+class IInputSink;
+}  // namespace core
+
+namespace services {
+// Turns raw GPIO edges into typed input events and measures edge-to-event latency
+class InputService {
+   public:
+    static constexpr uint32_t BUTTON_LATENCY_SLO_US = 50000U;    // FR-04
+    static constexpr uint32_t ENCODER_LATENCY_SLO_US = 100000U;  // FR-05
+
+    InputService(core::IInputSink &sink, const common::IClock &clock);
+
+    void onEdge(const common::RawEdge &edge);
+
+   private:
+    static constexpr size_t BUTTON_COUNT = 3U;
+
+    void emit(const common::InputEvent &event, const uint32_t &sloUs);
+
+    core::IInputSink &mSink;
+    const common::IClock &mClock;
+
+    std::array<ButtonDebouncer, BUTTON_COUNT> mButtons;
+    QuadratureDecoder mEncoder;
+};
+
+}  // namespace services
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+namespace services {
+// Decodes EC11 A/B states (bit1 = A, bit0 = B, sampled together in the ISR) into detents.
+// Transitions are accumulated and a detent is emitted when the encoder returns to its
+// rest state, so contact bounce cancels out. A skipped state (both lines changed) is
+// counted as two steps in the last known direction.
+class QuadratureDecoder {
+   public:
+    static constexpr uint8_t REST_STATE = 0b11;  // both contacts open, pulled up
+
+    struct Acceleration {
+        uint32_t fastUs = 30000U;    // detents closer than this are multiplied by fastFactor
+        uint32_t mediumUs = 80000U;  // ... and closer than this by mediumFactor
+        int16_t fastFactor = 4;
+        int16_t mediumFactor = 2;
+    };
+
+    QuadratureDecoder();
+    explicit QuadratureDecoder(const Acceleration &acceleration);
+
+    // Returns signed, accelerated detents completed by this state change, 0 if none
+    int16_t onState(const uint8_t &state, const uint64_t &timestampUs);
+
+    uint32_t getSkippedStates() const;
+
+   private:
+    int16_t accelerate(const int8_t &direction, const uint64_t &timestampUs);
+
+    Acceleration mAcceleration;
+    uint8_t mState;
+    int8_t mAccumulated;
+    int8_t mLastDirection;
+    int8_t mLastDetentDirection;
+    bool mHasDetent;
+    uint64_t mLastDetentUs;
+    uint32_t mSkippedStates;
+};
+
+}  // namespace services
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <array>
+
+#include "UiTypes.hpp"
+#include "Widget.hpp"
+
+namespace services {
+// Spectrum bars rising from the bottom edge of an opaque strip. Hidden until the
+// first levels arrive; a new frame only invalidates the bars whose pixel height changed,
+// so a steady spectrum costs a few narrow page writes rather than the whole strip.
+class SpectrumWidget final : public Widget {
+   public:
+    static constexpr uint8_t BAR_GAP = 1U;  // pixels between bars
+
+    explicit SpectrumWidget(const adapters::DisplayRegion &bounds);
+
+    void setLevels(const common::SpectrumLevels &levels);
+    void hide();
+
+    void draw(Canvas &canvas) const override;
+
+   private:
+    uint8_t barWidth() const;
+    uint8_t heightPx() const;
+
+    std::array<uint8_t, common::SPECTRUM_BARS> mHeights;  // pixels
+};
+
+}  // namespace services
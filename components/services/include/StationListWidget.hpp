@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Widget.hpp"
+
+namespace services {
+class IStationRepository;
+
+// One station per page row with a mark in front of the selection. The window follows the
+// selection and moves by scrolling, so a step past the edge exposes a single row.
+class StationListWidget final : public Widget {
+   public:
+    StationListWidget(const adapters::DisplayRegion &bounds, IStationRepository &stationRepo);
+
+    void select(const int &index);
+    // Bottom rows hidden under an overlay; the selection is kept above them
+    void setCoveredRows(const int &rows);
+
+    int takeScrollRows() override;
+    void draw(Canvas &canvas) const override;
+
+   private:
+    int rows() const;
+    void invalidateRow(const int &row);
+    void invalidateMark(const int &row);
+
+    IStationRepository &mStationRepo;
+    int mTop;          // station on the first row
+    int mSelected;     // -1 while nothing is shown
+    int mScrollRows;   // since the last paint
+    int mCoveredRows;
+};
+
+}  // namespace services
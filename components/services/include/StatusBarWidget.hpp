@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+
+#include "UiTypes.hpp"
+#include "Widget.hpp"
+
+namespace services {
+// Icon slots on the left of the status row. Each slot remembers the glyph it shows, so a
+// status update repaints only the slots whose icon actually changed; an RSSI tick that
+// stays in the same strength band costs nothing.
+class StatusBarWidget final : public Widget {
+   public:
+    enum class Slot : uint8_t { Wifi, Playback, Battery, Alert, COUNT };
+    static constexpr uint8_t SLOT_COUNT = static_cast<uint8_t>(Slot::COUNT);
+
+    explicit StatusBarWidget(const adapters::DisplayRegion &bounds);
+
+    void setStatus(const common::UiStatus &status);
+
+    void draw(Canvas &canvas) const override;
+
+   private:
+    void setSlot(const Slot &slot, const char &glyph);
+
+    std::array<char, SLOT_COUNT> mGlyphs;
+};
+
+}  // namespace services
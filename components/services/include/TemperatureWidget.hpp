@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Widget.hpp"
+
+namespace services {
+// Temperature in tenths of a degree, right-aligned in its corner. Readings that round to
+// the value on screen do not repaint
+class TemperatureWidget final : public Widget {
+   public:
+    static constexpr uint8_t CHARS = 6U;  // "-12.3C"
+
+    explicit TemperatureWidget(const adapters::DisplayRegion &bounds);
+
+    void setTemperature(const int16_t &centiC);
+
+    void draw(Canvas &canvas) const override;
+
+   private:
+    bool mHasValue;
+    int mDeciC;
+};
+
+}  // namespace services
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+
+#include "UiTypes.hpp"
+#include "Widget.hpp"
+
+namespace services {
+// Short message in an inverted bar over whatever lies below, until it expires
+class ToastWidget final : public Widget {
+   public:
+    explicit ToastWidget(const adapters::DisplayRegion &bounds);
+
+    void show(const std::string_view &text, const int64_t &untilUs);
+    void hide();
+    bool hasExpired(const int64_t &nowUs) const;
+    // When a shown toast is due to go; meaningless while hidden
+    int64_t getExpiryUs() const;
+
+    void draw(Canvas &canvas) const override;
+
+   private:
+    std::array<char, common::UI_TEXT_SIZE> mText;
+    size_t mLength;
+    int64_t mUntilUs;
+};
+
+}  // namespace services
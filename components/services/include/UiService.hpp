@@ -1,8 +1,16 @@
 #pragma once
 
 #include <cstdint>
-#include <string_view>
-#include <vector>
+
+#include "Canvas.hpp"
+#include "FrameSwap.hpp"
+#include "SpectrumWidget.hpp"
+#include "StationListWidget.hpp"
+#include "StatusBarWidget.hpp"
+#include "TemperatureWidget.hpp"
+#include "ToastWidget.hpp"
+#include "VolumeWidget.hpp"
+#include "WidgetTree.hpp"
 
 namespace common {
 struct UiEvent;
@@ -13,36 +21,61 @@ class IDisplay;
 }  // namespace adapters
 
 namespace services {
+class IFrameListener;
 class IStationRepository;
 
 class UiService {
    public:
+    // nextDeadlineUs() when nothing is scheduled
+    static constexpr int64_t NO_DEADLINE = INT64_MAX;
+    static constexpr int64_t TOAST_DURATION_US = 2000000;
+
     explicit UiService(adapters::IDisplay &display, IStationRepository &stationRepo);
     bool init();
     void onEvent(const common::UiEvent &e);
 
+    // Timed housekeeping, e.g. taking down an expired toast. Does nothing before
+    // nextDeadlineUs()
+    void tick();
+    // esp_timer time the next tick() has work, so the UI task can sleep until then
+    int64_t nextDeadlineUs() const;
+
+    // With a listener, frames are handed over to the flush task instead of being sent
+    // from the render path. Set it before events start flowing
+    void setFrameListener(IFrameListener *listener);
+
+    // Sends the newest published frame, returns false if there was none
+    bool flushPendingFrame();
+
 #ifdef UNIT_TESTS
-    const std::vector<uint8_t> &getFramebuffer() {
+    const uint8_t *getFramebuffer() const {
         return mFramebuffer;
     }
 #endif
    private:
     void renderBoot();
-    void renderStatus();
-    void renderStations(int selectedIndex);
 
-    void clearFramebuffer();
+    void beginFrame(const int64_t &changeUs);
     void flushFramebuffer();
 
-    void drawText(uint8_t x, uint8_t y, const std::string_view &txt);
-    void drawChar(uint8_t x, uint8_t y, char c);
-    // DEPRECATED: decide if I need drawing pixel by pixel or Y with page alignment only
-    // void drawPixel(uint8_t x, uint8_t y, bool on);
-
     adapters::IDisplay &mDisplay;
     IStationRepository &mStationRepo;
+    IFrameListener *mFrameListener;
+
+    FrameSwap mFrames;
+    uint8_t *mFramebuffer;  // back buffer of mFrames while rendering
+    Canvas mCanvas;
+
+    // Bottom to top
+    StatusBarWidget mStatusBar;
+    TemperatureWidget mTemperature;
+    VolumeWidget mVolume;
+    StationListWidget mStationList;
+    SpectrumWidget mSpectrum;
+    ToastWidget mToast;
+    WidgetTree mWidgets;
 
-    std::vector<uint8_t> mFramebuffer;
+    bool mPlaying;  // as last shown in the status bar
 };
 
 }  // namespace services
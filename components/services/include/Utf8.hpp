@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace services {
+// Reading UTF-8 text for the display. Malformed input never stops the reader: a bad lead
+// byte, a truncated or overlong sequence and surrogates each come out as one REPLACEMENT.
+class Utf8 {
+   public:
+    static constexpr uint32_t REPLACEMENT = 0xFFFDU;
+
+    // Decodes the code point at pos and moves pos past it. pos must be inside txt
+    static uint32_t next(const std::string_view &txt, size_t &pos);
+
+    // Code points in txt
+    static size_t length(const std::string_view &txt);
+
+    // Longest head of txt with at most maxChars code points and maxBytes bytes, never
+    // splitting a sequence
+    static std::string_view prefix(const std::string_view &txt, const size_t &maxChars,
+                                   const size_t &maxBytes = std::string_view::npos);
+};
+
+}  // namespace services
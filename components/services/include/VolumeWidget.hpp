@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Widget.hpp"
+
+namespace services {
+// Speaker icon and the volume in percent, blank until the first value arrives
+class VolumeWidget final : public Widget {
+   public:
+    static constexpr uint8_t CHARS = 4U;  // icon + 3 digits
+
+    explicit VolumeWidget(const adapters::DisplayRegion &bounds);
+
+    void setVolume(const int &volume);
+
+    void draw(Canvas &canvas) const override;
+
+   private:
+    int mVolume;  // -1 until set
+};
+
+}  // namespace services
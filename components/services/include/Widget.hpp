@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Canvas.hpp"
+#include "DamageList.hpp"
+#include "IDisplay.hpp"
+
+namespace services {
+
+// A retained piece of the screen: owns a rectangle, holds its own state and invalidates
+// only what a state change affects. WidgetTree repaints the invalidated areas.
+class Widget {
+   public:
+    explicit Widget(const adapters::DisplayRegion &bounds);
+    virtual ~Widget() = default;
+
+    const adapters::DisplayRegion &getBounds() const;
+    bool isVisible() const;
+
+    // Areas to repaint since the last paint, in screen coordinates
+    DamageList &getDamage();
+
+    // Rows the content moved up (down when negative) since the last paint. The tree shifts
+    // the pixels already drawn, so the widget only invalidates rows that came into view
+    virtual int takeScrollRows();
+
+    // Paints the whole widget over a cleared background; the canvas clips to the area
+    // being repainted
+    virtual void draw(Canvas &canvas) const = 0;
+
+   protected:
+    void invalidate();
+    void invalidate(const adapters::DisplayRegion &area);
+    void setVisible(const bool &visible);
+
+   private:
+    adapters::DisplayRegion mBounds;
+    bool mVisible;
+    DamageList mDamage;
+};
+
+}  // namespace services
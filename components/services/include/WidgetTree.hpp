@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "Canvas.hpp"
+#include "FrameSwap.hpp"
+
+namespace services {
+class Widget;
+
+// Widgets stacked bottom to top. Rendering repaints only the areas the widgets invalidated,
+// every layer within each area in order, and hands the areas to the frame as damage for a
+// partial flush.
+class WidgetTree {
+   public:
+    static constexpr size_t MAX_WIDGETS = 8U;
+
+    WidgetTree();
+
+    // Widgets are added bottom to top and must outlive the tree
+    bool add(Widget &widget);
+
+    void render(Canvas &canvas, FrameSwap::FrameInfo &frame);
+
+   private:
+    void scroll(Canvas &canvas, FrameSwap::FrameInfo &frame, const size_t &index,
+                const int &rows, DamageList &areas);
+    void repaint(Canvas &canvas, const adapters::DisplayRegion &area);
+
+    std::array<Widget *, MAX_WIDGETS> mWidgets;
+    size_t mCount;
+};
+
+}  // namespace services
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "IStationRepository.hpp"
+#include "UiTypes.hpp"
+
+namespace services {
+// Fixed station list without gmock bookkeeping, for tests that count allocations or time
+class FakeStationRepository : public IStationRepository {
+   public:
+    explicit FakeStationRepository(std::vector<common::StationData> stations)
+        : mStations(std::move(stations)) {
+    }
+
+    bool init() override {
+        return true;
+    }
+
+    const std::vector<common::StationData> &getStations() const override {
+        return mStations;
+    }
+
+   private:
+    std::vector<common::StationData> mStations;
+};
+
+}  // namespace services
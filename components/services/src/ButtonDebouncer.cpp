@@ -0,0 +1,41 @@
+#include "ButtonDebouncer.hpp"
+
+namespace services {
+ButtonDebouncer::ButtonDebouncer(const uint32_t &settleUs, const uint8_t &activeLevel)
+    : mSettleUs(settleUs),
+      mActiveLevel(activeLevel),
+      mRawLevel(activeLevel ^ 1U),
+      mPressed(false),
+      mHasEdge(false),
+      mLastEdgeUs(0U) {}
+
+bool ButtonDebouncer::onEdge(const uint8_t &level, const uint64_t &timestampUs) {
+    const bool settled = !mHasEdge || (timestampUs - mLastEdgeUs) >= mSettleUs;
+
+    if (mPressed && settled && mRawLevel != mActiveLevel) {
+        mPressed = false;
+    }
+
+    bool press = false;
+    if (level == mActiveLevel) {
+        if (!mPressed) {
+            press = true;
+        } else if (settled && mRawLevel == mActiveLevel) {
+            // Two settled active edges in a row: the release edge was lost
+            press = true;
+        }
+        mPressed = true;
+    }
+
+    mRawLevel = level;
+    mLastEdgeUs = timestampUs;
+    mHasEdge = true;
+
+    return press;
+}
+
+bool ButtonDebouncer::isPressed() const {
+    return mPressed;
+}
+
+}  // namespace services
@@ -0,0 +1,148 @@
+#include "Canvas.hpp"
+
+#include <esp_log.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "DamageList.hpp"
+#include "GlyphTable.hpp"
+#include "UiTypes.hpp"
+#include "Utf8.hpp"
+
+namespace services {
+static constexpr uint8_t SPACE_BYTE = 0x00;  // empty byte for spacing
+static constexpr uint8_t MISSING_GLYPH = '?';
+
+static const char *TAG = "Canvas";
+
+// ASCII and the icons index FONT5x7 directly. Everything above is looked up in the sorted
+// generated table (tools/gen_glyphs.py), a binary search over a few hundred entries.
+static const std::array<uint8_t, 5> &glyphFor(const uint32_t &codepoint) {
+    if (codepoint < common::FONT5x7.size()) {
+        return common::FONT5x7[codepoint];
+    }
+
+    const auto &codepoints = common::EXTENDED_CODEPOINTS;
+    const auto it = std::lower_bound(codepoints.begin(), codepoints.end(), codepoint);
+    if (it == codepoints.end() || *it != codepoint) {
+        return common::FONT5x7[MISSING_GLYPH];
+    }
+    return common::EXTENDED_GLYPHS[static_cast<size_t>(it - codepoints.begin())];
+}
+
+template <typename Panel>
+BasicCanvas<Panel>::BasicCanvas() : mFramebuffer(nullptr), mClip(SCREEN) {}
+
+template <typename Panel>
+void BasicCanvas<Panel>::setTarget(uint8_t *framebuffer) {
+    mFramebuffer = framebuffer;
+    mClip = SCREEN;
+}
+
+template <typename Panel>
+void BasicCanvas<Panel>::setClip(const adapters::DisplayRegion &clip) {
+    mClip = DamageList::intersection(clip, SCREEN);
+}
+
+template <typename Panel>
+const adapters::DisplayRegion &BasicCanvas<Panel>::getClip() const {
+    return mClip;
+}
+
+template <typename Panel>
+void BasicCanvas<Panel>::fill(const adapters::DisplayRegion &area, const uint8_t &pattern) {
+    if (!DamageList::intersects(area, mClip)) {
+        return;
+    }
+
+    const adapters::DisplayRegion r = DamageList::intersection(area, mClip);
+    for (uint8_t page = r.pageStart; page <= r.pageEnd; ++page) {
+        uint8_t *row = &mFramebuffer[offset(0U, page)];
+        std::fill(row + r.colStart, row + r.colEnd + 1U, pattern);
+    }
+}
+
+template <typename Panel>
+void BasicCanvas<Panel>::drawText(const uint8_t &x, const uint8_t &page,
+                                  const std::string_view &txt, const bool &inverted) {
+    if (page >= PAGES) {
+        ESP_LOGE(TAG, "drawText: page out of bounds: %u", page);
+        return;
+    }
+
+    uint8_t currX = x;
+
+    for (size_t pos = 0U; pos < txt.size();) {
+        const uint32_t codepoint = Utf8::next(txt, pos);
+        if ((currX + GLYPH_ADVANCE) > WIDTH) {
+            ESP_LOGE(TAG, "drawText: X coordinate out of bounds: %u", currX);
+            break;
+        }
+
+        drawGlyph(currX, page, codepoint, inverted);
+        currX += GLYPH_ADVANCE;
+    }
+}
+
+template <typename Panel>
+void BasicCanvas<Panel>::drawChar(const uint8_t &x, const uint8_t &page, const char &c,
+                                  const bool &inverted) {
+    drawGlyph(x, page, static_cast<uint8_t>(c), inverted);
+}
+
+template <typename Panel>
+void BasicCanvas<Panel>::drawGlyph(const uint8_t &x, const uint8_t &page,
+                                   const uint32_t &codepoint, const bool &inverted) {
+    if (x >= WIDTH || page >= PAGES) {
+        ESP_LOGE(TAG, "drawGlyph: coordinates out of bounds (%u,%u)", x, page);
+        return;
+    }
+
+    if (page < mClip.pageStart || page > mClip.pageEnd) {
+        return;
+    }
+
+    const auto &glyph = glyphFor(codepoint);
+    const uint8_t mask = inverted ? 0xFF : 0x00;
+    uint8_t *row = &mFramebuffer[offset(0U, page)];
+
+    // Glyph plus the 1px spacing column after it
+    for (uint8_t col = 0; col < GLYPH_ADVANCE; ++col) {
+        const int px = x + col;
+        if (px < mClip.colStart || px > mClip.colEnd) {
+            continue;
+        }
+
+        const uint8_t bits = (col < GLYPH_WIDTH) ? glyph[col] : SPACE_BYTE;
+        row[px] = bits ^ mask;
+    }
+}
+
+template <typename Panel>
+size_t BasicCanvas<Panel>::textWidth(const std::string_view &txt) {
+    return Utf8::length(txt) * GLYPH_ADVANCE;
+}
+
+template <typename Panel>
+void BasicCanvas<Panel>::movePages(const adapters::DisplayRegion &area, const int &rows) {
+    const int pages = area.pageEnd - area.pageStart + 1;
+    if (rows == 0 || std::abs(rows) >= pages) {
+        return;
+    }
+
+    uint8_t *top = &mFramebuffer[offset(0U, area.pageStart)];
+    const size_t keptBytes = static_cast<size_t>(pages - std::abs(rows)) * WIDTH;
+    if (rows > 0) {
+        std::memmove(top, top + rows * WIDTH, keptBytes);
+    } else {
+        std::memmove(top - rows * WIDTH, top, keptBytes);
+    }
+}
+
+template class BasicCanvas<common::Ssd1306Panel128x64>;
+template class BasicCanvas<common::Ssd1306Panel128x32>;
+template class BasicCanvas<common::Sh1106Panel128x64>;
+
+}  // namespace services
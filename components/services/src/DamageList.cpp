@@ -0,0 +1,141 @@
+#include "DamageList.hpp"
+
+#include <algorithm>
+
+#include "BoardConfig.hpp"
+
+namespace services {
+static constexpr uint8_t LAST_COL = common::BoardOledPanel::WIDTH - 1U;
+static constexpr uint8_t LAST_PAGE = common::BoardOledPanel::PAGES - 1U;
+
+static uint32_t area(const adapters::DisplayRegion &r) {
+    return static_cast<uint32_t>(r.colEnd - r.colStart + 1U) * (r.pageEnd - r.pageStart + 1U);
+}
+
+static adapters::DisplayRegion bounding(const adapters::DisplayRegion &a,
+                                        const adapters::DisplayRegion &b) {
+    return {std::min(a.colStart, b.colStart), std::max(a.colEnd, b.colEnd),
+            std::min(a.pageStart, b.pageStart), std::max(a.pageEnd, b.pageEnd)};
+}
+
+// Overlapping or edge to edge
+static bool touches(const adapters::DisplayRegion &a, const adapters::DisplayRegion &b) {
+    return a.colStart <= b.colEnd + 1 && b.colStart <= a.colEnd + 1 &&
+           a.pageStart <= b.pageEnd + 1 && b.pageStart <= a.pageEnd + 1;
+}
+
+void DamageList::add(const adapters::DisplayRegion &region) {
+    insert(region);
+}
+
+void DamageList::markAll() {
+    mRegions[0] = {0U, LAST_COL, 0U, LAST_PAGE};
+    mCount = 1U;
+}
+
+void DamageList::clear() {
+    mCount = 0U;
+}
+
+void DamageList::shift(const adapters::DisplayRegion &area, const int &rows) {
+    const std::array<adapters::DisplayRegion, MAX_REGIONS> regions = mRegions;
+    const size_t count = mCount;
+    mCount = 0U;
+
+    for (size_t i = 0; i < count; ++i) {
+        const adapters::DisplayRegion &r = regions[i];
+        if (!intersects(r, area)) {
+            insert(r);
+            continue;
+        }
+
+        // Parts above and below the area stay where they are
+        if (r.pageStart < area.pageStart) {
+            insert({r.colStart, r.colEnd, r.pageStart, static_cast<uint8_t>(area.pageStart - 1U)});
+        }
+        if (r.pageEnd > area.pageEnd) {
+            insert({r.colStart, r.colEnd, static_cast<uint8_t>(area.pageEnd + 1U), r.pageEnd});
+        }
+
+        const adapters::DisplayRegion inside = intersection(r, area);
+        const int start = std::max<int>(inside.pageStart - rows, area.pageStart);
+        const int end = std::min<int>(inside.pageEnd - rows, area.pageEnd);
+        if (start <= end) {
+            insert({inside.colStart, inside.colEnd, static_cast<uint8_t>(start),
+                    static_cast<uint8_t>(end)});
+        }
+    }
+}
+
+bool DamageList::isEmpty() const {
+    return mCount == 0U;
+}
+
+bool DamageList::coversAll() const {
+    for (size_t i = 0; i < mCount; ++i) {
+        const adapters::DisplayRegion &r = mRegions[i];
+        if (r.colStart == 0U && r.colEnd == LAST_COL && r.pageStart == 0U &&
+            r.pageEnd == LAST_PAGE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t DamageList::count() const {
+    return mCount;
+}
+
+const adapters::DisplayRegion *DamageList::data() const {
+    return mRegions.data();
+}
+
+bool DamageList::intersects(const adapters::DisplayRegion &a, const adapters::DisplayRegion &b) {
+    return a.colStart <= b.colEnd && b.colStart <= a.colEnd && a.pageStart <= b.pageEnd &&
+           b.pageStart <= a.pageEnd;
+}
+
+adapters::DisplayRegion DamageList::intersection(const adapters::DisplayRegion &a,
+                                                 const adapters::DisplayRegion &b) {
+    return {std::max(a.colStart, b.colStart), std::min(a.colEnd, b.colEnd),
+            std::max(a.pageStart, b.pageStart), std::min(a.pageEnd, b.pageEnd)};
+}
+
+void DamageList::insert(const adapters::DisplayRegion &region) {
+    adapters::DisplayRegion merged = region;
+
+    // Absorb everything the new rectangle can take for free; a grown rectangle may now
+    // cover ones checked earlier, so start over after each merge
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 0; i < mCount; ++i) {
+            const adapters::DisplayRegion box = bounding(mRegions[i], merged);
+            if (touches(mRegions[i], merged) && area(box) <= area(mRegions[i]) + area(merged)) {
+                merged = box;
+                mRegions[i] = mRegions[--mCount];
+                changed = true;
+                break;
+            }
+        }
+    }
+
+    if (mCount < MAX_REGIONS) {
+        mRegions[mCount++] = merged;
+        return;
+    }
+
+    // Full: fold into the rectangle that grows least
+    size_t best = 0U;
+    uint32_t bestGrowth = UINT32_MAX;
+    for (size_t i = 0; i < mCount; ++i) {
+        const uint32_t growth = area(bounding(mRegions[i], merged)) - area(mRegions[i]);
+        if (growth < bestGrowth) {
+            best = i;
+            bestGrowth = growth;
+        }
+    }
+    mRegions[best] = bounding(mRegions[best], merged);
+}
+
+}  // namespace services
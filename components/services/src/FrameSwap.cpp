@@ -0,0 +1,114 @@
+#include "FrameSwap.hpp"
+
+#include <cstring>
+
+#include "Metrics.hpp"
+
+namespace services {
+static constexpr uint8_t INDEX_MASK = 0x03U;
+static constexpr uint8_t FLUSHING_SHIFT = 2U;
+
+static metrics::Counter sDroppedFrames("ui.frames_dropped");
+
+FrameSwap::FrameSwap()
+    : mBuffers{},
+      mInfo{},
+      mState(makeState(NONE, NONE)),
+      mBack(0U),
+      mLastPublished(0U),
+      mRendering(false),
+      mDroppedFrames(0U) {}
+
+uint8_t *FrameSwap::beginFrame(const uint64_t &changeUs) {
+    if (mRendering) {
+        return mBuffers[mBack].data();
+    }
+
+    uint8_t state = mState.load(std::memory_order_acquire);
+    while (true) {
+        const uint8_t pending = state & INDEX_MASK;
+        const uint8_t flushing = state >> FLUSHING_SHIFT;
+
+        if (pending != NONE) {
+            // Not picked up yet: take it back and draw on top, keeping its stamp and damage
+            if (mState.compare_exchange_weak(state, makeState(NONE, flushing),
+                                             std::memory_order_acq_rel)) {
+                mBack = pending;
+                mRendering = true;
+                ++mDroppedFrames;
+                sDroppedFrames.add();
+                return mBuffers[mBack].data();
+            }
+            continue;
+        }
+
+        // Nothing can start flushing while nothing is pending, so this check is stable
+        if (flushing == mLastPublished) {
+            mBack = mLastPublished ^ 1U;
+            std::memcpy(mBuffers[mBack].data(), mBuffers[mLastPublished].data(),
+                        mBuffers[mBack].size());
+        } else {
+            mBack = mLastPublished;
+        }
+        break;
+    }
+
+    mInfo[mBack] = FrameInfo{changeUs, DamageList(), 0};
+    mRendering = true;
+    return mBuffers[mBack].data();
+}
+
+FrameSwap::FrameInfo &FrameSwap::backInfo() {
+    return mInfo[mBack];
+}
+
+void FrameSwap::publishFrame() {
+    if (!mRendering) {
+        return;
+    }
+
+    uint8_t state = mState.load(std::memory_order_acquire);
+    while (!mState.compare_exchange_weak(state, makeState(mBack, state >> FLUSHING_SHIFT),
+                                         std::memory_order_acq_rel)) {
+    }
+
+    mLastPublished = mBack;
+    mRendering = false;
+}
+
+const uint8_t *FrameSwap::acquireFront(FrameInfo &info) {
+    uint8_t state = mState.load(std::memory_order_acquire);
+    while (true) {
+        const uint8_t pending = state & INDEX_MASK;
+        if (pending == NONE) {
+            return nullptr;
+        }
+
+        if (mState.compare_exchange_weak(state, makeState(NONE, pending),
+                                         std::memory_order_acq_rel)) {
+            info = mInfo[pending];
+            return mBuffers[pending].data();
+        }
+    }
+}
+
+void FrameSwap::releaseFront() {
+    uint8_t state = mState.load(std::memory_order_acquire);
+    while (!mState.compare_exchange_weak(state, makeState(state & INDEX_MASK, NONE),
+                                         std::memory_order_acq_rel)) {
+    }
+}
+
+size_t FrameSwap::size() const {
+    return mBuffers[0].size();
+}
+
+uint32_t FrameSwap::getDroppedFrames() const {
+    return mDroppedFrames;
+}
+
+uint8_t FrameSwap::makeState(const uint8_t &pending, const uint8_t &flushing) {
+    return static_cast<uint8_t>(pending | (flushing << FLUSHING_SHIFT));
+}
+
+}  // namespace services
@@ -0,0 +1,74 @@
+#include "InputService.hpp"
+
+#include "IClock.hpp"
+#include "IInputSink.hpp"
+#include "Metrics.hpp"
+
+// IDF
+#include <esp_log.h>
+
+namespace services {
+static const char *TAG = "InputService";
+
+static metrics::Histogram sButtonLatency("input.button_us", metrics::LATENCY_BUCKETS_US);
+static metrics::Histogram sEncoderLatency("input.encoder_us", metrics::LATENCY_BUCKETS_US);
+static metrics::Counter sSloMisses("input.slo_misses");
+static metrics::Counter sSkippedStates("input.enc_skipped");
+
+static constexpr common::InputEvent::Type BUTTON_EVENTS[] = {
+    common::InputEvent::Type::Up, common::InputEvent::Type::Down,
+    common::InputEvent::Type::PlayStop};
+
+InputService::InputService(core::IInputSink &sink, const common::IClock &clock)
+    : mSink(sink), mClock(clock), mButtons(), mEncoder() {}
+
+void InputService::onEdge(const common::RawEdge &edge) {
+    switch (edge.pin) {
+        case common::InputPin::Up:
+        case common::InputPin::Down:
+        case common::InputPin::PlayStop: {
+            const auto button = static_cast<size_t>(edge.pin);
+            if (mButtons[button].onEdge(edge.level, edge.timestampUs)) {
+                emit({BUTTON_EVENTS[button], 0, edge.timestampUs}, BUTTON_LATENCY_SLO_US);
+            }
+            break;
+        }
+        case common::InputPin::EncoderA:
+        case common::InputPin::EncoderB: {
+            const uint32_t skippedBefore = mEncoder.getSkippedStates();
+            const int16_t steps = mEncoder.onState(edge.level, edge.timestampUs);
+            sSkippedStates.add(mEncoder.getSkippedStates() - skippedBefore);
+
+            if (steps != 0) {
+                emit({common::InputEvent::Type::Volume, steps, edge.timestampUs},
+                     ENCODER_LATENCY_SLO_US);
+            }
+            break;
+        }
+        default:
+            ESP_LOGW(TAG, "Edge on unknown pin %d", static_cast<int>(edge.pin));
+            break;
+    }
+}
+
+void InputService::emit(const common::InputEvent &event, const uint32_t &sloUs) {
+    mSink.onInput(event);
+
+    const uint64_t nowUs = mClock.nowUs();
+    const auto latencyUs =
+        static_cast<uint32_t>((nowUs > event.edgeUs) ? (nowUs - event.edgeUs) : 0U);
+
+    if (event.type == common::InputEvent::Type::Volume) {
+        sEncoderLatency.record(latencyUs);
+    } else {
+        sButtonLatency.record(latencyUs);
+    }
+
+    if (latencyUs > sloUs) {
+        sSloMisses.add();
+        ESP_LOGW(TAG, "Input event %d took %lu us (SLO %lu us)", static_cast<int>(event.type),
+                 static_cast<unsigned long>(latencyUs), static_cast<unsigned long>(sloUs));
+    }
+}
+
+}  // namespace services
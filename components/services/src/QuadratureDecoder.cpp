@@ -0,0 +1,84 @@
+#include "QuadratureDecoder.hpp"
+
+namespace services {
+static constexpr uint8_t STATE_MASK = 0b11;
+static constexpr int8_t MIN_STEPS_PER_DETENT = 2;  // of 4, tolerates a lost transition
+
+// Gray-code position of each AB state along the clockwise sequence 11 -> 10 -> 00 -> 01
+static constexpr uint8_t POSITION[4] = {2U, 3U, 1U, 0U};
+
+QuadratureDecoder::QuadratureDecoder() : QuadratureDecoder(Acceleration{}) {}
+
+QuadratureDecoder::QuadratureDecoder(const Acceleration &acceleration)
+    : mAcceleration(acceleration),
+      mState(REST_STATE),
+      mAccumulated(0),
+      mLastDirection(0),
+      mLastDetentDirection(0),
+      mHasDetent(false),
+      mLastDetentUs(0U),
+      mSkippedStates(0U) {}
+
+int16_t QuadratureDecoder::onState(const uint8_t &state, const uint64_t &timestampUs) {
+    const uint8_t newState = state & STATE_MASK;
+    const uint8_t move = (POSITION[newState] - POSITION[mState]) & STATE_MASK;
+    mState = newState;
+
+    switch (move) {
+        case 1U:
+            mLastDirection = 1;
+            mAccumulated += 1;
+            break;
+        case 3U:
+            mLastDirection = -1;
+            mAccumulated -= 1;
+            break;
+        case 2U:
+            ++mSkippedStates;
+            mAccumulated += static_cast<int8_t>(2 * mLastDirection);
+            break;
+        default:
+            break;
+    }
+
+    if (mState != REST_STATE) {
+        return 0;
+    }
+
+    const int8_t accumulated = mAccumulated;
+    mAccumulated = 0;
+
+    if (accumulated >= MIN_STEPS_PER_DETENT) {
+        return accelerate(1, timestampUs);
+    }
+    if (accumulated <= -MIN_STEPS_PER_DETENT) {
+        return accelerate(-1, timestampUs);
+    }
+
+    return 0;
+}
+
+int16_t QuadratureDecoder::accelerate(const int8_t &direction, const uint64_t &timestampUs) {
+    int16_t factor = 1;
+
+    if (mHasDetent && direction == mLastDetentDirection) {
+        const uint64_t sinceLastUs = timestampUs - mLastDetentUs;
+        if (sinceLastUs < mAcceleration.fastUs) {
+            factor = mAcceleration.fastFactor;
+        } else if (sinceLastUs < mAcceleration.mediumUs) {
+            factor = mAcceleration.mediumFactor;
+        }
+    }
+
+    mHasDetent = true;
+    mLastDetentDirection = direction;
+    mLastDetentUs = timestampUs;
+
+    return static_cast<int16_t>(direction * factor);
+}
+
+uint32_t QuadratureDecoder::getSkippedStates() const {
+    return mSkippedStates;
+}
+
+}  // namespace services
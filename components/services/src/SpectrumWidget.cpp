@@ -0,0 +1,73 @@
+#include "SpectrumWidget.hpp"
+
+#include <algorithm>
+
+#include "Canvas.hpp"
+
+namespace services {
+static constexpr uint32_t MAX_LEVEL = 255U;
+
+SpectrumWidget::SpectrumWidget(const adapters::DisplayRegion &bounds)
+    : Widget(bounds), mHeights{} {
+    setVisible(false);
+    getDamage().clear();
+}
+
+void SpectrumWidget::setLevels(const common::SpectrumLevels &levels) {
+    const bool shown = isVisible();
+    const uint8_t width = barWidth();
+    for (size_t b = 0; b < levels.size(); ++b) {
+        const auto height =
+            static_cast<uint8_t>((levels[b] * heightPx() + MAX_LEVEL / 2U) / MAX_LEVEL);
+        if (height == mHeights[b]) {
+            continue;
+        }
+
+        mHeights[b] = height;
+        if (shown) {
+            const auto x = static_cast<uint8_t>(getBounds().colStart + b * width);
+            invalidate({x, static_cast<uint8_t>(x + width - 1U), getBounds().pageStart,
+                        getBounds().pageEnd});
+        }
+    }
+
+    // Appearing repaints the whole strip anyway
+    setVisible(true);
+}
+
+void SpectrumWidget::hide() {
+    setVisible(false);
+}
+
+void SpectrumWidget::draw(Canvas &canvas) const {
+    const adapters::DisplayRegion &bounds = getBounds();
+    const uint8_t width = barWidth();
+    canvas.fill(bounds, 0x00);  // opaque, the list rows below stay out of the strip
+
+    for (size_t b = 0; b < mHeights.size(); ++b) {
+        const auto x = static_cast<uint8_t>(bounds.colStart + b * width);
+        const auto xEnd = static_cast<uint8_t>(x + width - 1U - BAR_GAP);
+
+        // Bit 0 is the top row of a page, so a bar fills each page from its high bits down
+        int remaining = mHeights[b];
+        for (int page = bounds.pageEnd; page >= bounds.pageStart && remaining > 0; --page) {
+            const int rows = std::min<int>(remaining, Canvas::PAGE_HEIGHT);
+            const auto pattern = static_cast<uint8_t>(0xFFU << (Canvas::PAGE_HEIGHT - rows));
+            canvas.fill({x, xEnd, static_cast<uint8_t>(page), static_cast<uint8_t>(page)},
+                        pattern);
+            remaining -= rows;
+        }
+    }
+}
+
+uint8_t SpectrumWidget::barWidth() const {
+    const size_t width = getBounds().colEnd - getBounds().colStart + 1U;
+    return static_cast<uint8_t>(width / common::SPECTRUM_BARS);
+}
+
+uint8_t SpectrumWidget::heightPx() const {
+    return static_cast<uint8_t>((getBounds().pageEnd - getBounds().pageStart + 1U) *
+                                Canvas::PAGE_HEIGHT);
+}
+
+}  // namespace services
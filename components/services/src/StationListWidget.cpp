@@ -0,0 +1,121 @@
+#include "StationListWidget.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string_view>
+
+#include "Canvas.hpp"
+#include "IStationRepository.hpp"
+#include "UiTypes.hpp"
+#include "Utf8.hpp"
+
+namespace services {
+static constexpr uint8_t NAME_X = Canvas::GLYPH_ADVANCE;  // pixels, after the mark
+static constexpr size_t MAX_NAME = (Canvas::WIDTH - NAME_X) / Canvas::GLYPH_ADVANCE;
+static constexpr char SELECTION_MARK = '>';
+
+StationListWidget::StationListWidget(const adapters::DisplayRegion &bounds,
+                                     IStationRepository &stationRepo)
+    : Widget(bounds),
+      mStationRepo(stationRepo),
+      mTop(0),
+      mSelected(-1),
+      mScrollRows(0),
+      mCoveredRows(0) {}
+
+void StationListWidget::select(const int &index) {
+    const int count = static_cast<int>(mStationRepo.getStations().size());
+    const int selected = std::clamp(index, 0, std::max(count - 1, 0));
+    const int visible = rows();
+
+    // Keep the selection in view, moving the window as little as possible
+    int top = mTop;
+    if (selected < top) {
+        top = selected;
+    } else if (selected >= top + visible - mCoveredRows) {
+        top = selected - (visible - mCoveredRows) + 1;
+    }
+    const int moved = top - mTop;
+    const bool shown = (mSelected >= 0);
+    mTop = top;
+
+    if (!shown || std::abs(moved) >= visible) {
+        invalidate();
+    } else if (moved != 0) {
+        // Rows still in view are already drawn; only the ones scrolled in are new
+        getDamage().shift(getBounds(), moved);
+        mScrollRows += moved;
+        const int first = (moved > 0) ? (visible - moved) : 0;
+        for (int row = first; row < first + std::abs(moved); ++row) {
+            invalidateRow(row);
+        }
+    }
+
+    const int selectedNow = (count > 0) ? selected : -1;
+    if (shown && mSelected != selectedNow) {
+        invalidateMark(mSelected - mTop);
+    }
+    if (selectedNow >= 0 && (!shown || moved != 0 || mSelected != selectedNow)) {
+        invalidateMark(selectedNow - mTop);
+    }
+    mSelected = selectedNow;
+}
+
+void StationListWidget::setCoveredRows(const int &rows) {
+    const int covered = std::clamp(rows, 0, this->rows() - 1);
+    if (covered == mCoveredRows) {
+        return;
+    }
+
+    mCoveredRows = covered;
+    if (mSelected >= 0) {
+        select(mSelected);
+    }
+}
+
+int StationListWidget::takeScrollRows() {
+    const int moved = mScrollRows;
+    mScrollRows = 0;
+    return moved;
+}
+
+void StationListWidget::draw(Canvas &canvas) const {
+    const auto &stations = mStationRepo.getStations();
+    const adapters::DisplayRegion &clip = canvas.getClip();
+
+    for (int row = 0; row < rows(); ++row) {
+        const uint8_t page = static_cast<uint8_t>(getBounds().pageStart + row);
+        const size_t index = static_cast<size_t>(mTop + row);
+        if (page < clip.pageStart || page > clip.pageEnd || index >= stations.size()) {
+            continue;
+        }
+
+        const std::string_view name = Utf8::prefix(stations[index].name, MAX_NAME);
+        canvas.drawText(getBounds().colStart + NAME_X, page, name, false);
+
+        if (static_cast<int>(index) == mSelected) {
+            canvas.drawChar(getBounds().colStart, page, SELECTION_MARK, false);
+        }
+    }
+}
+
+int StationListWidget::rows() const {
+    return getBounds().pageEnd - getBounds().pageStart + 1;
+}
+
+void StationListWidget::invalidateRow(const int &row) {
+    const uint8_t page = static_cast<uint8_t>(getBounds().pageStart + row);
+    invalidate({getBounds().colStart, getBounds().colEnd, page, page});
+}
+
+void StationListWidget::invalidateMark(const int &row) {
+    if (row < 0 || row >= rows()) {
+        return;
+    }
+
+    const uint8_t page = static_cast<uint8_t>(getBounds().pageStart + row);
+    const uint8_t markEnd = static_cast<uint8_t>(getBounds().colStart + Canvas::GLYPH_ADVANCE - 1U);
+    invalidate({getBounds().colStart, markEnd, page, page});
+}
+
+}  // namespace services
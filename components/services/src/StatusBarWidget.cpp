@@ -0,0 +1,101 @@
+#include "StatusBarWidget.hpp"
+
+#include "Canvas.hpp"
+
+namespace services {
+static constexpr char BLANK = ' ';
+static constexpr char ALERT = '!';
+static constexpr int8_t RSSI_GOOD_DBM = -60;
+static constexpr int8_t RSSI_FAIR_DBM = -70;
+static constexpr uint8_t BATTERY_FULL_PCT = 75U;
+static constexpr uint8_t BATTERY_MID_PCT = 40U;
+static constexpr uint8_t BATTERY_LOW_PCT = 10U;
+
+static char icon(const common::Icon &icon) {
+    return static_cast<char>(icon);
+}
+
+static char wifiGlyph(const common::UiStatus &status) {
+    switch (status.kind) {
+        case common::UiStatusKind::WifiConnecting:
+            return icon(common::Icon::WIFI_1);
+        case common::UiStatusKind::Booting:
+        case common::UiStatusKind::WifiError:
+            return icon(common::Icon::WIFI_OFF);
+        default:
+            break;
+    }
+
+    // Connected, possibly playing: show the signal
+    if (status.rssiDbm >= RSSI_GOOD_DBM) {
+        return icon(common::Icon::WIFI_3);
+    }
+    if (status.rssiDbm >= RSSI_FAIR_DBM) {
+        return icon(common::Icon::WIFI_2);
+    }
+    return icon(common::Icon::WIFI_1);
+}
+
+static char playbackGlyph(const common::UiStatus &status) {
+    switch (status.playback) {
+        case common::PlaybackState::Playing:
+            return icon(common::Icon::PLAY);
+        case common::PlaybackState::Paused:
+            return icon(common::Icon::PAUSE);
+        case common::PlaybackState::Stopped:
+        default:
+            return icon(common::Icon::STOP);
+    }
+}
+
+static char batteryGlyph(const common::UiStatus &status) {
+    if (status.batteryPct == common::UiStatus::NO_BATTERY) {
+        return BLANK;
+    }
+    if (status.batteryPct >= BATTERY_FULL_PCT) {
+        return icon(common::Icon::BATTERY_FULL);
+    }
+    if (status.batteryPct >= BATTERY_MID_PCT) {
+        return icon(common::Icon::BATTERY_MID);
+    }
+    if (status.batteryPct >= BATTERY_LOW_PCT) {
+        return icon(common::Icon::BATTERY_LOW);
+    }
+    return icon(common::Icon::BATTERY_EMPTY);
+}
+
+static char alertGlyph(const common::UiStatus &status) {
+    return (status.kind == common::UiStatusKind::Error) ? ALERT : BLANK;
+}
+
+StatusBarWidget::StatusBarWidget(const adapters::DisplayRegion &bounds) : Widget(bounds) {
+    mGlyphs.fill(BLANK);
+}
+
+void StatusBarWidget::setStatus(const common::UiStatus &status) {
+    setSlot(Slot::Wifi, wifiGlyph(status));
+    setSlot(Slot::Playback, playbackGlyph(status));
+    setSlot(Slot::Battery, batteryGlyph(status));
+    setSlot(Slot::Alert, alertGlyph(status));
+}
+
+void StatusBarWidget::draw(Canvas &canvas) const {
+    for (uint8_t i = 0; i < SLOT_COUNT; ++i) {
+        const uint8_t x = static_cast<uint8_t>(getBounds().colStart + i * Canvas::GLYPH_ADVANCE);
+        canvas.drawChar(x, getBounds().pageStart, mGlyphs[i], false);
+    }
+}
+
+void StatusBarWidget::setSlot(const Slot &slot, const char &glyph) {
+    const uint8_t index = static_cast<uint8_t>(slot);
+    if (mGlyphs[index] == glyph) {
+        return;
+    }
+
+    mGlyphs[index] = glyph;
+    const uint8_t x = static_cast<uint8_t>(getBounds().colStart + index * Canvas::GLYPH_ADVANCE);
+    invalidate({x, static_cast<uint8_t>(x + Canvas::GLYPH_ADVANCE - 1U), getBounds().pageStart,
+                getBounds().pageEnd});
+}
+
+}  // namespace services
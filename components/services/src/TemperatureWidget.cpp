@@ -0,0 +1,38 @@
+#include "TemperatureWidget.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "Canvas.hpp"
+
+namespace services {
+
+TemperatureWidget::TemperatureWidget(const adapters::DisplayRegion &bounds)
+    : Widget(bounds), mHasValue(false), mDeciC(0) {}
+
+void TemperatureWidget::setTemperature(const int16_t &centiC) {
+    const int deciC = centiC / 10;
+    if (mHasValue && deciC == mDeciC) {
+        return;
+    }
+
+    mHasValue = true;
+    mDeciC = deciC;
+    invalidate();
+}
+
+void TemperatureWidget::draw(Canvas &canvas) const {
+    if (!mHasValue) {
+        return;
+    }
+
+    char text[CHARS + 2U];
+    const int len = std::snprintf(text, sizeof(text), "%s%d.%dC", (mDeciC < 0) ? "-" : "",
+                                  std::abs(mDeciC) / 10, std::abs(mDeciC) % 10);
+    const uint8_t chars = static_cast<uint8_t>((len > CHARS) ? CHARS : len);
+
+    const uint8_t x = static_cast<uint8_t>(getBounds().colEnd + 1U - chars * Canvas::GLYPH_ADVANCE);
+    canvas.drawText(x, getBounds().pageStart, std::string_view(text, chars), false);
+}
+
+}  // namespace services
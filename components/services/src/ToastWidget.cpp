@@ -0,0 +1,51 @@
+#include "ToastWidget.hpp"
+
+#include <algorithm>
+
+#include "Canvas.hpp"
+#include "Utf8.hpp"
+
+namespace services {
+
+ToastWidget::ToastWidget(const adapters::DisplayRegion &bounds)
+    : Widget(bounds), mText{}, mLength(0U), mUntilUs(0) {
+    setVisible(false);
+    getDamage().clear();
+}
+
+void ToastWidget::show(const std::string_view &text, const int64_t &untilUs) {
+    const size_t width = getBounds().colEnd - getBounds().colStart + 1U;
+    const size_t maxChars = width / Canvas::GLYPH_ADVANCE;
+    const std::string_view shown = Utf8::prefix(text, maxChars, mText.size());
+    mLength = shown.size();
+    std::copy_n(shown.begin(), mLength, mText.begin());
+    mUntilUs = untilUs;
+
+    setVisible(true);
+    invalidate();
+}
+
+void ToastWidget::hide() {
+    setVisible(false);
+}
+
+bool ToastWidget::hasExpired(const int64_t &nowUs) const {
+    return isVisible() && nowUs >= mUntilUs;
+}
+
+int64_t ToastWidget::getExpiryUs() const {
+    return mUntilUs;
+}
+
+void ToastWidget::draw(Canvas &canvas) const {
+    const adapters::DisplayRegion &bounds = getBounds();
+    canvas.fill(bounds, 0xFF);
+
+    const size_t width = bounds.colEnd - bounds.colStart + 1U;
+    const std::string_view text(mText.data(), mLength);
+    const uint8_t x =
+        static_cast<uint8_t>(bounds.colStart + (width - Canvas::textWidth(text)) / 2U);
+    canvas.drawText(x, bounds.pageStart, text, true);
+}
+
+}  // namespace services
@@ -1,155 +1,206 @@
 #include "UiService.hpp"
 
 #include <esp_log.h>
+#include <esp_timer.h>
 
-#include <algorithm>
-#include <array>
+#include <cstring>
 
 #include "IDisplay.hpp"
+#include "IFrameListener.hpp"
+#include "Metrics.hpp"
 #include "StationRepository.hpp"
+#include "Trace.hpp"
 #include "UiTypes.hpp"
 
 namespace services {
-static constexpr uint8_t WIDTH = 128U;      // pixels
-static constexpr uint8_t HEIGHT = 64U;      // pixels
-static constexpr uint8_t PAGE_HEIGHT = 8U;  // pixels
-// Only works when PAGE_HEIGHT is a power of 2 (2, 4, 8, 16, etc.).
-// used as modulo but faster
-static constexpr uint8_t PAGE_BIT_MASK = PAGE_HEIGHT - 1U;              // 0x07
-static constexpr uint8_t PAGES = HEIGHT / PAGE_HEIGHT;                  // number of pages
-static constexpr uint8_t GLYPH_WIDTH = 5U;                              // pixels
-static constexpr uint8_t GLYPH_HEIGHT = 7U;                             // pixels
-static constexpr uint8_t CHAR_WIDTH = GLYPH_WIDTH + 1U;                 // 5px glyph + 1px spacing
-static constexpr uint8_t CHAR_HEIGHT = GLYPH_HEIGHT + 1U;               // 7px glyph + 1px spacing
-static constexpr uint8_t STATUS_BAR_AREA_END = 8U;                      // pixels
-static constexpr uint8_t STATION_NAME_START_X = 6U;                     // pixels
-static constexpr uint8_t MAX_STATIONS = 6U;                             // max stations to show
-static constexpr uint8_t MAX_STATION_NAME = (WIDTH / CHAR_WIDTH) - 1U;  // -1 because of icon
-static constexpr uint8_t SPACE_BYTE = 0x00;                             // empty byte for spacing
+static constexpr uint8_t LAST_COL = Canvas::WIDTH - 1U;
+static constexpr uint8_t LAST_PAGE = Canvas::PAGES - 1U;
+static constexpr uint8_t CW = Canvas::GLYPH_ADVANCE;
+
+// Layout. The status row holds the icon slots, the temperature corner and the volume at the
+// right end; the list fills every page below it so the panel can scroll it in hardware,
+// the spectrum covers its bottom rows while playing and the toast the bottom row when shown.
+static constexpr uint8_t STATUS_PAGE = 0U;
+static constexpr adapters::DisplayRegion STATUS_BAR = {
+    0U, StatusBarWidget::SLOT_COUNT * CW - 1U, STATUS_PAGE, STATUS_PAGE};
+static constexpr adapters::DisplayRegion VOLUME = {
+    Canvas::WIDTH - VolumeWidget::CHARS * CW, LAST_COL, STATUS_PAGE, STATUS_PAGE};
+static constexpr adapters::DisplayRegion TEMPERATURE = {
+    VOLUME.colStart - CW - TemperatureWidget::CHARS * CW, VOLUME.colStart - CW - 1U, STATUS_PAGE,
+    STATUS_PAGE};
+static constexpr adapters::DisplayRegion STATION_LIST = {0U, LAST_COL, STATUS_PAGE + 1U,
+                                                         LAST_PAGE};
+// While a station plays the spectrum strip covers the bottom quarter of the list
+static constexpr uint8_t SPECTRUM_PAGES = Canvas::PAGES / 4U;
+static constexpr adapters::DisplayRegion SPECTRUM = {0U, LAST_COL, LAST_PAGE + 1U - SPECTRUM_PAGES,
+                                                     LAST_PAGE};
+static constexpr adapters::DisplayRegion TOAST = {0U, LAST_COL, LAST_PAGE, LAST_PAGE};
 
 static const char *TAG = "UiService";
 
+static metrics::Histogram sRenderLatency("ui.render_us", metrics::LATENCY_BUCKETS_US);
+static metrics::Histogram sFlushLatency("ui.flush_us", metrics::LATENCY_BUCKETS_US);
+static metrics::Histogram sChangeToFlushLatency("ui.change_to_flush_us",
+                                                metrics::LATENCY_BUCKETS_US);
+
 UiService::UiService(adapters::IDisplay &display, IStationRepository &stationRepo)
-    : mDisplay(display), mStationRepo(stationRepo), mFramebuffer(WIDTH * PAGES, 0) {
+    : mDisplay(display),
+      mStationRepo(stationRepo),
+      mFrameListener(nullptr),
+      mFrames(),
+      mFramebuffer(nullptr),
+      mCanvas(),
+      mStatusBar(STATUS_BAR),
+      mTemperature(TEMPERATURE),
+      mVolume(VOLUME),
+      mStationList(STATION_LIST, stationRepo),
+      mSpectrum(SPECTRUM),
+      mToast(TOAST),
+      mWidgets(),
+      mPlaying(false) {
     ESP_LOGI(TAG, "Creating UiService");
+
+    mWidgets.add(mStatusBar);
+    mWidgets.add(mTemperature);
+    mWidgets.add(mVolume);
+    mWidgets.add(mStationList);
+    mWidgets.add(mSpectrum);
+    mWidgets.add(mToast);
 }
 
 bool UiService::init() {
     ESP_LOGI(TAG, "Initializing UiService");
 
-    clearFramebuffer();
+    beginFrame(esp_timer_get_time());
+    mCanvas.fill(Canvas::SCREEN, 0x00);
+    mFrames.backInfo().damage.markAll();
+    mWidgets.render(mCanvas, mFrames.backInfo());
     flushFramebuffer();
 
     return true;
 }
 
 void UiService::onEvent(const common::UiEvent &e) {
+    const int64_t startUs = esp_timer_get_time();
+
+    // Posted events carry their enqueue time so the flush latency includes queueing
+    const int64_t changeUs = (e.postedUs != 0) ? e.postedUs : startUs;
+    beginFrame(changeUs);
+
     switch (e.type) {
         case common::UiEvent::Type::RENDER_BOOT:
             ESP_LOGI(TAG, "Rendering boot screen");
             renderBoot();
             break;
-        case common::UiEvent::Type::RENDER_STATIONS:
-            ESP_LOGI(TAG, "Rendering stations");
-            renderStations(e.selectedIndex);
+        case common::UiEvent::Type::RENDER_STATIONS: {
+            TRACE_SCOPE(UI_RENDER_STATIONS);
+            ESP_LOGI(TAG, "Rendering stations, selected index: %d", e.selectedIndex);
+            mStationList.select(e.selectedIndex);
             break;
-        case common::UiEvent::Type::RENDER_STATUS:
+        }
+        case common::UiEvent::Type::RENDER_STATUS: {
+            TRACE_SCOPE(UI_RENDER_STATUS);
             ESP_LOGI(TAG, "Rendering UI status");
-            renderStatus();
+            mStatusBar.setStatus(e.status);
+            // Frames are posted without the controller lock, one may still follow the stop
+            mPlaying = (e.status.playback == common::PlaybackState::Playing);
+            if (!mPlaying) {
+                mSpectrum.hide();
+                mStationList.setCoveredRows(0);
+            }
+            break;
+        }
+        case common::UiEvent::Type::RENDER_VOLUME:
+            mVolume.setVolume(e.volume);
+            break;
+        case common::UiEvent::Type::RENDER_CLIMATE:
+            mTemperature.setTemperature(e.temperatureCentiC);
+            break;
+        case common::UiEvent::Type::SHOW_TOAST:
+            mToast.show(std::string_view(e.text.data(), strnlen(e.text.data(), e.text.size())),
+                        changeUs + TOAST_DURATION_US);
+            break;
+        case common::UiEvent::Type::RENDER_SPECTRUM:
+            if (mPlaying) {
+                mStationList.setCoveredRows(SPECTRUM_PAGES);
+                mSpectrum.setLevels(e.spectrum);
+            }
             break;
         default:
             ESP_LOGW(TAG, "Unknown UI event type");
             break;
     }
-}
 
-void UiService::renderBoot() {
-    // TODO: implement
-}
+    mWidgets.render(mCanvas, mFrames.backInfo());
+    flushFramebuffer();
 
-void UiService::renderStatus() {
-    // TODO: implement
-    // TODO: come up with status bar areas for each icon
-    // switch case for each icon to draw at correct position? and argument only
-    // the icon type?
-    // drawChar(x, y, static_cast<char>(icon));
-    // playback status - play stop near the active station
+    sRenderLatency.record(static_cast<uint32_t>(esp_timer_get_time() - startUs));
 }
 
-void UiService::renderStations(int selectedIndex) {
-    ESP_LOGI(TAG, "Rendering stations, selected index: %d", selectedIndex);
-
-    const auto &stations = mStationRepo.getStations();
-    for (int i = 0; i < static_cast<int>(stations.size()) && i < MAX_STATIONS; ++i) {
-        const uint8_t startY = (STATUS_BAR_AREA_END + (i * 8));
-
-        std::string name = stations[i].name;
-        if (name.size() > MAX_STATION_NAME) {
-            name.resize(MAX_STATION_NAME);
-        }
-
-        drawText(STATION_NAME_START_X, startY, name);
+void UiService::tick() {
+    const int64_t nowUs = esp_timer_get_time();
+    if (!mToast.hasExpired(nowUs)) {
+        return;
     }
 
+    beginFrame(nowUs);
+    mToast.hide();
+    mWidgets.render(mCanvas, mFrames.backInfo());
     flushFramebuffer();
 }
 
-void UiService::clearFramebuffer() {
-    std::fill(mFramebuffer.begin(), mFramebuffer.end(), 0x00);
+int64_t UiService::nextDeadlineUs() const {
+    return mToast.isVisible() ? mToast.getExpiryUs() : NO_DEADLINE;
 }
 
-void UiService::flushFramebuffer() {
-    mDisplay.showFramebuffer(mFramebuffer.data(), mFramebuffer.size());
+void UiService::setFrameListener(IFrameListener *listener) {
+    mFrameListener = listener;
 }
 
-void UiService::drawText(uint8_t x, uint8_t y, const std::string_view &txt) {
-    if ((y + CHAR_HEIGHT) > HEIGHT) {
-        ESP_LOGE(TAG, "drawText: Y coordinate out of bounds: %u", y);
-        return;
+bool UiService::flushPendingFrame() {
+    FrameSwap::FrameInfo info;
+    const uint8_t *front = mFrames.acquireFront(info);
+    if (front == nullptr) {
+        return false;
     }
 
-    uint8_t currX = x;
-
-    for (char ch : txt) {
-        if ((currX + CHAR_WIDTH) > WIDTH) {
-            ESP_LOGE(TAG, "drawText: X coordinate out of bounds: %u", currX);
-            break;
-        }
+    TRACE_SCOPE(UI_FLUSH);
+    const int64_t startUs = esp_timer_get_time();
+    sChangeToFlushLatency.record(static_cast<uint32_t>(startUs - info.oldestChangeUs));
 
-        drawChar(currX, y, ch);
-        currX += CHAR_WIDTH;
+    if (info.scrollPages != 0) {
+        mDisplay.scrollPages(info.scrollPages);
     }
-}
 
-void UiService::drawChar(uint8_t x, uint8_t y, char c) {
-    if (x >= WIDTH || y >= HEIGHT) {
-        ESP_LOGE(TAG, "drawChar: coordinates out of bounds (%u,%u)", x, y);
-        return;
+    if (info.damage.coversAll()) {
+        mDisplay.showFramebuffer(front, mFrames.size());
+    } else if (!info.damage.isEmpty() || info.scrollPages != 0) {
+        mDisplay.showRegions(front, mFrames.size(), info.damage.data(), info.damage.count());
     }
+    mFrames.releaseFront();
 
-    if ((y & PAGE_BIT_MASK) != 0) {
-        ESP_LOGW(TAG, "drawChar: Y coordinate not page-aligned: %u", y);
-        return;
-    }
+    sFlushLatency.record(static_cast<uint32_t>(esp_timer_get_time() - startUs));
+    return true;
+}
 
-    uint8_t idx = static_cast<uint8_t>(c);
-    if (idx >= common::FONT5x7.size()) {
-        ESP_LOGE(TAG, "Character out of range: %c", c);
-        idx = static_cast<uint8_t>('?');
-    }
+void UiService::renderBoot() {
+    TRACE_SCOPE(UI_RENDER_BOOT);
+
+    // TODO: implement
+}
 
-    const auto &glyph = common::FONT5x7[idx];
-    const uint16_t pageStartIdx = (y / PAGE_HEIGHT) * WIDTH;
-    for (uint8_t col = 0; col < GLYPH_WIDTH; ++col) {
-        const uint16_t byteIdx = pageStartIdx + (x + col);
+void UiService::beginFrame(const int64_t &changeUs) {
+    mFramebuffer = mFrames.beginFrame(static_cast<uint64_t>(changeUs));
+    mCanvas.setTarget(mFramebuffer);
+}
 
-        mFramebuffer[byteIdx] = glyph[col];
-    }
+void UiService::flushFramebuffer() {
+    mFrames.publishFrame();
 
-    // 1px spacing column after glyph
-    const uint16_t spaceByteIdx = pageStartIdx + (x + GLYPH_WIDTH);
-    if (spaceByteIdx < mFramebuffer.size()) {
-        mFramebuffer[spaceByteIdx] = SPACE_BYTE;
+    if (mFrameListener != nullptr) {
+        mFrameListener->onFrameReady();
+    } else {
+        flushPendingFrame();
     }
 }
 
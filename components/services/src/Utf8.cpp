@@ -0,0 +1,70 @@
+#include "Utf8.hpp"
+
+namespace services {
+static bool isContinuation(const uint8_t &byte) {
+    return (byte & 0xC0U) == 0x80U;
+}
+
+uint32_t Utf8::next(const std::string_view &txt, size_t &pos) {
+    const uint8_t lead = static_cast<uint8_t>(txt[pos++]);
+    if (lead < 0x80U) {
+        return lead;
+    }
+
+    size_t extra = 0U;
+    uint32_t codepoint = 0U;
+    uint32_t minimum = 0U;
+    if ((lead & 0xE0U) == 0xC0U) {
+        extra = 1U;
+        codepoint = lead & 0x1FU;
+        minimum = 0x80U;
+    } else if ((lead & 0xF0U) == 0xE0U) {
+        extra = 2U;
+        codepoint = lead & 0x0FU;
+        minimum = 0x800U;
+    } else if ((lead & 0xF8U) == 0xF0U) {
+        extra = 3U;
+        codepoint = lead & 0x07U;
+        minimum = 0x10000U;
+    } else {
+        return REPLACEMENT;  // stray continuation or invalid lead byte
+    }
+
+    for (size_t i = 0U; i < extra; ++i) {
+        // Leave a byte that does not continue the sequence for the next call
+        if (pos >= txt.size() || !isContinuation(static_cast<uint8_t>(txt[pos]))) {
+            return REPLACEMENT;
+        }
+        codepoint = (codepoint << 6U) | (static_cast<uint8_t>(txt[pos++]) & 0x3FU);
+    }
+
+    if (codepoint < minimum || codepoint > 0x10FFFFU ||
+        (codepoint >= 0xD800U && codepoint <= 0xDFFFU)) {
+        return REPLACEMENT;
+    }
+    return codepoint;
+}
+
+size_t Utf8::length(const std::string_view &txt) {
+    size_t count = 0U;
+    for (size_t pos = 0U; pos < txt.size(); ++count) {
+        next(txt, pos);
+    }
+    return count;
+}
+
+std::string_view Utf8::prefix(const std::string_view &txt, const size_t &maxChars,
+                              const size_t &maxBytes) {
+    size_t end = 0U;
+    for (size_t chars = 0U; chars < maxChars && end < txt.size(); ++chars) {
+        size_t pos = end;
+        next(txt, pos);
+        if (pos > maxBytes) {
+            break;
+        }
+        end = pos;
+    }
+    return txt.substr(0, end);
+}
+
+}  // namespace services
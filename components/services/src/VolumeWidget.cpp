@@ -0,0 +1,33 @@
+#include "VolumeWidget.hpp"
+
+#include <cstdio>
+
+#include "Canvas.hpp"
+#include "UiTypes.hpp"
+
+namespace services {
+
+VolumeWidget::VolumeWidget(const adapters::DisplayRegion &bounds) : Widget(bounds), mVolume(-1) {}
+
+void VolumeWidget::setVolume(const int &volume) {
+    if (volume == mVolume) {
+        return;
+    }
+
+    mVolume = volume;
+    invalidate();
+}
+
+void VolumeWidget::draw(Canvas &canvas) const {
+    if (mVolume < 0) {
+        return;
+    }
+
+    char text[CHARS + 1U];
+    std::snprintf(text, sizeof(text), "%c%3d", static_cast<char>(common::Icon::SPEAKER), mVolume);
+
+    canvas.drawText(getBounds().colStart, getBounds().pageStart, std::string_view(text, CHARS),
+                    false);
+}
+
+}  // namespace services
@@ -0,0 +1,43 @@
+#include "Widget.hpp"
+
+namespace services {
+
+Widget::Widget(const adapters::DisplayRegion &bounds) : mBounds(bounds), mVisible(true) {}
+
+const adapters::DisplayRegion &Widget::getBounds() const {
+    return mBounds;
+}
+
+bool Widget::isVisible() const {
+    return mVisible;
+}
+
+DamageList &Widget::getDamage() {
+    return mDamage;
+}
+
+int Widget::takeScrollRows() {
+    return 0;
+}
+
+void Widget::invalidate() {
+    mDamage.add(mBounds);
+}
+
+void Widget::invalidate(const adapters::DisplayRegion &area) {
+    if (DamageList::intersects(area, mBounds)) {
+        mDamage.add(DamageList::intersection(area, mBounds));
+    }
+}
+
+void Widget::setVisible(const bool &visible) {
+    if (visible == mVisible) {
+        return;
+    }
+
+    // Hiding uncovers whatever lies below, which the tree repaints with this area
+    mVisible = visible;
+    invalidate();
+}
+
+}  // namespace services
@@ -0,0 +1,107 @@
+#include "WidgetTree.hpp"
+
+#include <esp_log.h>
+
+#include <algorithm>
+
+#include "Canvas.hpp"
+#include "Trace.hpp"
+#include "Widget.hpp"
+
+namespace services {
+static const char *TAG = "WidgetTree";
+
+WidgetTree::WidgetTree() : mWidgets{}, mCount(0U) {}
+
+bool WidgetTree::add(Widget &widget) {
+    if (mCount >= MAX_WIDGETS) {
+        ESP_LOGE(TAG, "Too many widgets");
+        return false;
+    }
+
+    mWidgets[mCount++] = &widget;
+    return true;
+}
+
+void WidgetTree::render(Canvas &canvas, FrameSwap::FrameInfo &frame) {
+    TRACE_SCOPE(UI_PAINT);
+
+    DamageList areas;
+    for (size_t i = 0; i < mCount; ++i) {
+        const int rows = mWidgets[i]->takeScrollRows();
+        if (rows != 0) {
+            scroll(canvas, frame, i, rows, areas);
+        }
+    }
+
+    for (size_t i = 0; i < mCount; ++i) {
+        DamageList &damage = mWidgets[i]->getDamage();
+        for (size_t r = 0; r < damage.count(); ++r) {
+            areas.add(damage.data()[r]);
+        }
+        damage.clear();
+    }
+
+    for (size_t i = 0; i < areas.count(); ++i) {
+        repaint(canvas, areas.data()[i]);
+        frame.damage.add(areas.data()[i]);
+    }
+    canvas.setClip(Canvas::SCREEN);
+}
+
+void WidgetTree::scroll(Canvas &canvas, FrameSwap::FrameInfo &frame, const size_t &index,
+                        const int &rows, DamageList &areas) {
+    const adapters::DisplayRegion &bounds = mWidgets[index]->getBounds();
+
+    // The panel can only rotate whole rows; anything narrower is simply redrawn
+    if (bounds.colStart != 0U || bounds.colEnd != Canvas::WIDTH - 1U) {
+        areas.add(bounds);
+        return;
+    }
+
+    canvas.movePages(bounds, rows);
+
+    // The panel rotates as a whole: damage not sent yet moves with its pixels, and rows
+    // outside the widget land on RAM pages that held something else
+    frame.damage.shift(bounds, rows);
+    if (bounds.pageStart > 0U) {
+        frame.damage.add({0U, Canvas::WIDTH - 1U, 0U, static_cast<uint8_t>(bounds.pageStart - 1U)});
+    }
+    if (bounds.pageEnd < Canvas::PAGES - 1U) {
+        frame.damage.add({0U, Canvas::WIDTH - 1U, static_cast<uint8_t>(bounds.pageEnd + 1U),
+                          Canvas::PAGES - 1U});
+    }
+    frame.scrollPages = static_cast<int8_t>((frame.scrollPages + rows) % Canvas::PAGES);
+
+    // Widgets on top were dragged along with the pixels: repaint both where they ended up
+    // and where they belong
+    for (size_t i = index + 1U; i < mCount; ++i) {
+        const Widget &above = *mWidgets[i];
+        if (!above.isVisible() || !DamageList::intersects(above.getBounds(), bounds)) {
+            continue;
+        }
+
+        const adapters::DisplayRegion inside = DamageList::intersection(above.getBounds(), bounds);
+        const int start = std::max<int>(inside.pageStart - rows, bounds.pageStart);
+        const int end = std::min<int>(inside.pageEnd - rows, bounds.pageEnd);
+        if (start <= end) {
+            areas.add({inside.colStart, inside.colEnd, static_cast<uint8_t>(start),
+                       static_cast<uint8_t>(end)});
+        }
+        areas.add(above.getBounds());
+    }
+}
+
+void WidgetTree::repaint(Canvas &canvas, const adapters::DisplayRegion &area) {
+    canvas.setClip(area);
+    canvas.fill(area, 0x00);
+
+    for (size_t i = 0; i < mCount; ++i) {
+        const Widget &widget = *mWidgets[i];
+        if (widget.isVisible() && DamageList::intersects(widget.getBounds(), area)) {
+            widget.draw(canvas);
+        }
+    }
+}
+
+}  // namespace services
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "TraceEvents.hpp"
+
+#if __has_include(<sdkconfig.h>)
+#include <sdkconfig.h>
+#endif
+
+#ifdef CONFIG_PLAYER_TRACE_ENABLE
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// IDF
+#include <esp_cpu.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace trace {
+enum class Phase : uint8_t { Begin = 'B', End = 'E', Instant = 'i' };
+
+struct Record {
+    uint32_t timestampUs;  // wraps after ~71 min, the export tool unwraps it
+    uint32_t arg;
+    uint16_t id;
+    uint8_t phase;
+    uint8_t task;  // TraceRecorder task index, NO_TASK for ISRs
+};
+
+// Multi-producer ring: a writer reserves its slot with a single atomic add, so tasks and
+// ISRs running on the same core never take a lock. The oldest records are overwritten.
+template <size_t N>
+class TraceRing {
+    static_assert(N > 0U && (N & (N - 1U)) == 0U, "Ring size must be a power of two");
+
+   public:
+    void push(const Record& record) {
+        const uint32_t seq = mHead.fetch_add(1U, std::memory_order_relaxed);
+        mRecords[seq & (N - 1U)] = record;
+    }
+
+    // Records pushed since the last clear, may exceed the capacity
+    uint32_t written() const {
+        return mHead.load(std::memory_order_acquire);
+    }
+
+    const Record& at(const uint32_t& seq) const {
+        return mRecords[seq & (N - 1U)];
+    }
+
+    void clear() {
+        mHead.store(0U, std::memory_order_release);
+    }
+
+    static constexpr size_t capacity() {
+        return N;
+    }
+
+   private:
+    std::array<Record, N> mRecords{};
+    std::atomic<uint32_t> mHead{0U};
+};
+
+class TraceRecorder {
+   public:
+    static constexpr size_t MAX_CORES = 2U;
+    static constexpr size_t RING_SIZE = CONFIG_PLAYER_TRACE_RING_SIZE;
+    using Ring = TraceRing<RING_SIZE>;
+    // Tasks get an index the first time they record, which the export uses as the thread:
+    // scopes only nest within a task, not within a core the tasks preempt each other on
+    static constexpr size_t MAX_TASKS = 32U;
+    static constexpr uint8_t NO_TASK = 0U;  // ISRs, and tasks beyond MAX_TASKS
+    static constexpr size_t TASK_NAME_SIZE = 16U;
+
+    static TraceRecorder& instance() {
+        return sInstance;
+    }
+
+    void record(const EventId& id, const Phase& phase, const uint32_t& arg = 0U) {
+        if (!mEnabled.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        const Record record{static_cast<uint32_t>(esp_timer_get_time()), arg,
+                            static_cast<uint16_t>(id), static_cast<uint8_t>(phase),
+                            taskIndex()};
+        mRings[coreIndex()].push(record);
+    }
+
+    void setEnabled(const bool& enabled);
+    bool isEnabled() const;
+    void clear();
+
+    // Streams all rings as text lines, recording is paused while dumping
+    void dump(FILE* out);
+    // Console entry point: trace [dump|clear|on|off]
+    int runCommand(int argc, char** argv);
+
+    const Ring& getRing(const size_t& core) const;
+    // Empty for NO_TASK and indices no task has claimed yet
+    const char* getTaskName(const uint8_t& task) const;
+
+   private:
+    struct TaskSlot {
+        std::atomic<TaskHandle_t> handle{nullptr};
+        std::atomic<bool> named{false};
+        std::array<char, TASK_NAME_SIZE> name{};
+    };
+
+    static size_t coreIndex() {
+        const auto core = static_cast<size_t>(esp_cpu_get_core_id());
+        return (core < MAX_CORES) ? core : 0U;
+    }
+
+    // A scan over the claimed slots; a task only ever claims a slot for itself, so there
+    // is no lock and a slot never changes hands
+    uint8_t taskIndex() {
+        if (xPortInIsrContext()) {
+            return NO_TASK;
+        }
+
+        const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+        for (size_t i = 0U; i < MAX_TASKS; ++i) {
+            TaskSlot& slot = mTasks[i];
+            TaskHandle_t owner = slot.handle.load(std::memory_order_acquire);
+            if (owner == nullptr && slot.handle.compare_exchange_strong(owner, self)) {
+                claim(slot, self);
+                return static_cast<uint8_t>(i + 1U);
+            }
+            if (owner == self) {
+                return static_cast<uint8_t>(i + 1U);
+            }
+        }
+        return NO_TASK;
+    }
+
+    static void claim(TaskSlot& slot, const TaskHandle_t& self);
+
+    static TraceRecorder sInstance;
+
+    std::array<Ring, MAX_CORES> mRings;
+    std::array<TaskSlot, MAX_TASKS> mTasks;
+    std::atomic<bool> mEnabled{true};
+};
+
+class TraceScope {
+   public:
+    explicit TraceScope(const EventId& id, const uint32_t& arg = 0U) : mId(id) {
+        TraceRecorder::instance().record(mId, Phase::Begin, arg);
+    }
+
+    ~TraceScope() {
+        TraceRecorder::instance().record(mId, Phase::End);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+   private:
+    EventId mId;
+};
+
+}  // namespace trace
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#define TRACE_BEGIN(id) \
+    ::trace::TraceRecorder::instance().record(::trace::EventId::id, ::trace::Phase::Begin)
+#define TRACE_END(id) \
+    ::trace::TraceRecorder::instance().record(::trace::EventId::id, ::trace::Phase::End)
+#define TRACE_INSTANT(id, arg)                                                              \
+    ::trace::TraceRecorder::instance().record(::trace::EventId::id, ::trace::Phase::Instant, \
+                                              static_cast<uint32_t>(arg))
+#define TRACE_SCOPE(id) ::trace::TraceScope TRACE_CONCAT(traceScope_, __LINE__)(::trace::EventId::id)
+#define TRACE_SCOPE_ARG(id, arg)                                            \
+    ::trace::TraceScope TRACE_CONCAT(traceScope_, __LINE__)(::trace::EventId::id, \
+                                                            static_cast<uint32_t>(arg))
+
+#else  // CONFIG_PLAYER_TRACE_ENABLE
+
+#define TRACE_BEGIN(id) ((void)0)
+#define TRACE_END(id) ((void)0)
+#define TRACE_INSTANT(id, arg) ((void)0)
+#define TRACE_SCOPE(id) ((void)0)
+#define TRACE_SCOPE_ARG(id, arg) ((void)0)
+
+#endif  // CONFIG_PLAYER_TRACE_ENABLE
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace trace {
+// Compile-time registry of trace events: X(ID, "name").
+// New events are appended here, the dump carries the id -> name table.
+#define PLAYER_TRACE_EVENTS(X)                        \
+    X(UI_TASK_POST, "ui_task.post")                   \
+    X(UI_TASK_EVENT, "ui_task.event")                 \
+    X(UI_RENDER_BOOT, "ui.render_boot")               \
+    X(UI_RENDER_STATUS, "ui.render_status")           \
+    X(UI_RENDER_STATIONS, "ui.render_stations")       \
+    X(UI_FLUSH, "ui.flush")                           \
+    X(OLED_SHOW_FRAMEBUFFER, "oled.show_framebuffer") \
+    X(I2C_WRITE, "i2c.write")                         \
+    X(I2C_READ, "i2c.read")                           \
+    X(UI_PAINT, "ui.paint")                           \
+    X(PLAYER_COMMAND, "player.command")               \
+    X(PLAYER_SOURCE_READ, "player.source_read")       \
+    X(PLAYER_DECODE, "player.decode")                 \
+    X(PLAYER_CUTOVER, "player.cutover")
+
+enum class EventId : uint16_t {
+#define PLAYER_TRACE_ENUM(id, name) id,
+    PLAYER_TRACE_EVENTS(PLAYER_TRACE_ENUM)
+#undef PLAYER_TRACE_ENUM
+        COUNT
+};
+
+static constexpr const char* EVENT_NAMES[] = {
+#define PLAYER_TRACE_NAME(id, name) name,
+    PLAYER_TRACE_EVENTS(PLAYER_TRACE_NAME)
+#undef PLAYER_TRACE_NAME
+};
+
+static_assert(sizeof(EVENT_NAMES) / sizeof(EVENT_NAMES[0]) ==
+                  static_cast<size_t>(EventId::COUNT),
+              "Every trace event needs a name");
+
+}  // namespace trace
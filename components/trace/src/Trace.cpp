@@ -0,0 +1,106 @@
+#include "Trace.hpp"
+
+#ifdef CONFIG_PLAYER_TRACE_ENABLE
+
+#include <cstring>
+
+// IDF
+#include <esp_log.h>
+
+namespace trace {
+static constexpr int DUMP_FORMAT_VERSION = 2;
+
+static const char *TAG = "Trace";
+
+TraceRecorder TraceRecorder::sInstance;
+
+void TraceRecorder::setEnabled(const bool &enabled) {
+    mEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool TraceRecorder::isEnabled() const {
+    return mEnabled.load(std::memory_order_relaxed);
+}
+
+void TraceRecorder::clear() {
+    for (auto &ring : mRings) {
+        ring.clear();
+    }
+}
+
+void TraceRecorder::dump(FILE *out) {
+    const bool wasEnabled = mEnabled.exchange(false);
+
+    std::fprintf(out, "#TRACE v%d cores=%u\n", DUMP_FORMAT_VERSION,
+                 static_cast<unsigned>(MAX_CORES));
+    for (size_t id = 0U; id < static_cast<size_t>(EventId::COUNT); ++id) {
+        std::fprintf(out, "#EVENT %u %s\n", static_cast<unsigned>(id), EVENT_NAMES[id]);
+    }
+    for (size_t task = 1U; task <= MAX_TASKS; ++task) {
+        const char *name = getTaskName(static_cast<uint8_t>(task));
+        if (name[0] != '\0') {
+            std::fprintf(out, "#TASK %u %s\n", static_cast<unsigned>(task), name);
+        }
+    }
+
+    for (size_t core = 0U; core < MAX_CORES; ++core) {
+        const Ring &ring = mRings[core];
+        const uint32_t written = ring.written();
+        const uint32_t first = (written > Ring::capacity()) ? (written - Ring::capacity()) : 0U;
+
+        for (uint32_t seq = first; seq < written; ++seq) {
+            const Record &record = ring.at(seq);
+            std::fprintf(out, "T,%u,%u,%c,%u,%u,%u\n", static_cast<unsigned>(core),
+                         static_cast<unsigned>(record.timestampUs), record.phase,
+                         static_cast<unsigned>(record.id), static_cast<unsigned>(record.arg),
+                         static_cast<unsigned>(record.task));
+        }
+    }
+
+    std::fprintf(out, "#TRACE END\n");
+    std::fflush(out);
+
+    mEnabled.store(wasEnabled);
+}
+
+int TraceRecorder::runCommand(int argc, char **argv) {
+    const char *action = (argc > 1) ? argv[1] : "dump";
+
+    if (std::strcmp(action, "dump") == 0) {
+        dump(stdout);
+    } else if (std::strcmp(action, "clear") == 0) {
+        clear();
+    } else if (std::strcmp(action, "on") == 0) {
+        setEnabled(true);
+    } else if (std::strcmp(action, "off") == 0) {
+        setEnabled(false);
+    } else {
+        ESP_LOGW(TAG, "Usage: trace [dump|clear|on|off]");
+        return 1;
+    }
+
+    return 0;
+}
+
+const TraceRecorder::Ring &TraceRecorder::getRing(const size_t &core) const {
+    return mRings[core];
+}
+
+const char *TraceRecorder::getTaskName(const uint8_t &task) const {
+    if (task == NO_TASK || task > MAX_TASKS ||
+        !mTasks[task - 1U].named.load(std::memory_order_acquire)) {
+        return "";
+    }
+    return mTasks[task - 1U].name.data();
+}
+
+void TraceRecorder::claim(TaskSlot &slot, const TaskHandle_t &self) {
+    // Copied while the task is alive, the dump must not follow a handle that may be gone
+    const char *name = pcTaskGetName(self);
+    std::strncpy(slot.name.data(), (name != nullptr) ? name : "?", slot.name.size() - 1U);
+    slot.named.store(true, std::memory_order_release);
+}
+
+}  // namespace trace
+
+#endif  // CONFIG_PLAYER_TRACE_ENABLE
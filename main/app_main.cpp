@@ -6,6 +6,8 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 
+static constexpr uint32_t HEALTH_SUMMARY_PERIOD_MS = 30000;
+
 static const char *TAG = "app_main";
 
 extern "C" void app_main(void) {
@@ -23,15 +25,10 @@ extern "C" void app_main(void) {
 
     ESP_LOGI(TAG, "Application initialized successfully");
 
-    // TODO: Create a proper health check mechanism + shutdown handling
-    int loopCount = 0;
+    // TODO: shutdown handling
     while (true) {
-        loopCount++;
-
-        if (loopCount % 10 == 0) {
-            ESP_LOGI(TAG, "App alive (loop %d)", loopCount);
-        }
+        vTaskDelay(pdMS_TO_TICKS(HEALTH_SUMMARY_PERIOD_MS));
 
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        appContext.logHealthSummary();
     }
 }
@@ -0,0 +1,230 @@
+#include "Aht20SensorTest.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include "Metrics.hpp"
+
+using ::testing::_;
+using ::testing::Return;
+
+static constexpr uint8_t AHT20_ADDR = 0x38;
+static constexpr uint8_t STATUS_CALIBRATED = 0x18;
+static constexpr uint8_t STATUS_BUSY = 0x98;
+
+// 50.00 %RH and 25.00 C
+static constexpr uint32_t RAW_HUMIDITY_50 = 0x80000;
+static constexpr uint32_t RAW_TEMPERATURE_25 = 0x60000;
+
+static uint64_t msToUs(const uint32_t &ms) {
+    return static_cast<uint64_t>(ms) * 1000U;
+}
+
+static uint32_t counterValue(const char *name) {
+    const auto *counter = metrics::Registry::instance().findCounter(name);
+    return (counter != nullptr) ? counter->value() : 0U;
+}
+
+void Aht20SensorTest::SetUp() {
+    sensor = std::make_unique<adapters::Aht20Sensor>(mockI2cBus, clock);
+}
+
+void Aht20SensorTest::TearDown() {
+    sensor.reset();
+}
+
+void Aht20SensorTest::powerUpCalibrated() {
+    EXPECT_CALL(mockI2cBus, readBytes(AHT20_ADDR, _, 1U, _))
+        .WillOnce([](const uint8_t &, uint8_t *data, const size_t &, const uint32_t &) {
+            data[0] = STATUS_CALIBRATED;
+            return true;
+        });
+
+    clock.setUs(msToUs(40U));
+    ASSERT_EQ(0U, sensor->poll());
+    ASSERT_EQ(adapters::Aht20Sensor::State::Idle, sensor->getState());
+}
+
+void Aht20SensorTest::expectTrigger() {
+    const std::vector<uint8_t> trigger = {0xAC, 0x33, 0x00};
+
+    EXPECT_CALL(mockI2cBus, writeBytes(AHT20_ADDR, _, trigger.size(), _))
+        .WillOnce([trigger](const uint8_t &, const uint8_t *data, const size_t &len,
+                            const uint32_t &) {
+            EXPECT_EQ(0, std::memcmp(data, trigger.data(), len));
+            return true;
+        })
+        .RetiresOnSaturation();
+}
+
+void Aht20SensorTest::expectRead(const Frame &frame) {
+    EXPECT_CALL(mockI2cBus, readBytes(AHT20_ADDR, _, frame.size(), _))
+        .WillOnce([frame](const uint8_t &, uint8_t *data, const size_t &len, const uint32_t &) {
+            std::memcpy(data, frame.data(), len);
+            return true;
+        })
+        .RetiresOnSaturation();
+}
+
+Aht20SensorTest::Frame Aht20SensorTest::makeFrame(const uint8_t &status,
+                                                  const uint32_t &rawHumidity,
+                                                  const uint32_t &rawTemperature) {
+    Frame frame = {status,
+                   static_cast<uint8_t>(rawHumidity >> 12U),
+                   static_cast<uint8_t>(rawHumidity >> 4U),
+                   static_cast<uint8_t>(((rawHumidity & 0x0FU) << 4U) | (rawTemperature >> 16U)),
+                   static_cast<uint8_t>(rawTemperature >> 8U),
+                   static_cast<uint8_t>(rawTemperature),
+                   0U};
+    frame[6] = crc8(frame.data(), 6U);
+    return frame;
+}
+
+uint8_t Aht20SensorTest::crc8(const uint8_t *data, const size_t &len) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x31) : crc << 1;
+        }
+    }
+    return crc;
+}
+
+TEST_F(Aht20SensorTest, crc8_MatchesCatalogueCheckValue) {
+    // Arrange: CRC-8/NRSC-5 check value over "123456789"
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    // Act & Expect
+    EXPECT_EQ(0xF7, crc8(check, sizeof(check)));
+}
+
+TEST_F(Aht20SensorTest, poll_PowerUp_LoadsCalibrationWithoutBlocking) {
+    // Arrange
+    const std::vector<uint8_t> init = {0xBE, 0x08, 0x00};
+    EXPECT_CALL(mockI2cBus, readBytes(AHT20_ADDR, _, 1U, _))
+        .WillOnce([](const uint8_t &, uint8_t *data, const size_t &, const uint32_t &) {
+            data[0] = 0x00;  // not calibrated
+            return true;
+        });
+    EXPECT_CALL(mockI2cBus, writeBytes(AHT20_ADDR, _, init.size(), _))
+        .WillOnce([init](const uint8_t &, const uint8_t *data, const size_t &len,
+                         const uint32_t &) {
+            EXPECT_EQ(0, std::memcmp(data, init.data(), len));
+            return true;
+        });
+
+    // Act & Expect: nothing touches the bus before the 40 ms power-up time
+    EXPECT_EQ(40U, sensor->poll());
+    clock.setUs(msToUs(40U));
+    EXPECT_EQ(10U, sensor->poll());
+    EXPECT_EQ(adapters::Aht20Sensor::State::Calibrating, sensor->getState());
+    clock.setUs(msToUs(50U));
+    EXPECT_EQ(0U, sensor->poll());
+    EXPECT_EQ(adapters::Aht20Sensor::State::Idle, sensor->getState());
+}
+
+TEST_F(Aht20SensorTest, poll_Measurement_ReleasesBusDuringConversion) {
+    // Arrange
+    powerUpCalibrated();
+    expectTrigger();
+    expectRead(makeFrame(STATUS_CALIBRATED, RAW_HUMIDITY_50, RAW_TEMPERATURE_25));
+    const uint32_t readingsBefore = counterValue("aht20.readings");
+
+    // Act & Expect: trigger, then no bus traffic until the conversion is due
+    EXPECT_EQ(80U, sensor->poll());
+    EXPECT_EQ(adapters::Aht20Sensor::State::Converting, sensor->getState());
+
+    clock.advanceUs(msToUs(30U));
+    EXPECT_EQ(50U, sensor->poll());
+
+    clock.advanceUs(msToUs(50U));
+    EXPECT_EQ(adapters::Aht20Sensor::DEFAULT_PERIOD_MS, sensor->poll());
+
+    common::ClimateReading reading;
+    ASSERT_TRUE(sensor->takeReading(reading));
+    EXPECT_EQ(2500, reading.temperatureCentiC);
+    EXPECT_EQ(5000U, reading.humidityCentiPct);
+    EXPECT_EQ(msToUs(120U), reading.timestampUs);
+    EXPECT_FALSE(sensor->takeReading(reading));
+    EXPECT_EQ(readingsBefore + 1U, counterValue("aht20.readings"));
+}
+
+TEST_F(Aht20SensorTest, poll_BusyBit_PollsAgainShortly) {
+    // Arrange
+    powerUpCalibrated();
+    expectTrigger();
+    const uint32_t busyBefore = counterValue("aht20.busy_polls");
+
+    // Act & Expect
+    sensor->poll();
+    clock.advanceUs(msToUs(80U));
+
+    expectRead(makeFrame(STATUS_BUSY, 0U, 0U));
+    EXPECT_EQ(10U, sensor->poll());
+    EXPECT_EQ(adapters::Aht20Sensor::State::Converting, sensor->getState());
+
+    clock.advanceUs(msToUs(10U));
+    expectRead(makeFrame(STATUS_CALIBRATED, RAW_HUMIDITY_50, RAW_TEMPERATURE_25));
+    sensor->poll();
+
+    common::ClimateReading reading;
+    EXPECT_TRUE(sensor->takeReading(reading));
+    EXPECT_EQ(busyBefore + 1U, counterValue("aht20.busy_polls"));
+}
+
+TEST_F(Aht20SensorTest, poll_StuckBusy_GivesUpAndRetries) {
+    // Arrange
+    powerUpCalibrated();
+    expectTrigger();
+    EXPECT_CALL(mockI2cBus, readBytes(AHT20_ADDR, _, 7U, _))
+        .Times(6)
+        .WillRepeatedly([](const uint8_t &, uint8_t *data, const size_t &, const uint32_t &) {
+            data[0] = STATUS_BUSY;
+            return true;
+        });
+
+    // Act
+    uint32_t waitMs = sensor->poll();
+    while (sensor->getState() == adapters::Aht20Sensor::State::Converting) {
+        clock.advanceUs(msToUs(waitMs));
+        waitMs = sensor->poll();
+    }
+
+    // Expect
+    common::ClimateReading reading;
+    EXPECT_FALSE(sensor->takeReading(reading));
+    EXPECT_EQ(1000U, waitMs);
+}
+
+TEST_F(Aht20SensorTest, poll_CrcMismatch_DropsReadingAndRetries) {
+    // Arrange
+    powerUpCalibrated();
+    expectTrigger();
+    Frame corrupted = makeFrame(STATUS_CALIBRATED, RAW_HUMIDITY_50, RAW_TEMPERATURE_25);
+    corrupted[4] ^= 0x01;
+    expectRead(corrupted);
+    const uint32_t crcErrorsBefore = counterValue("aht20.crc_errors");
+
+    // Act
+    sensor->poll();
+    clock.advanceUs(msToUs(80U));
+    const uint32_t waitMs = sensor->poll();
+
+    // Expect
+    common::ClimateReading reading;
+    EXPECT_FALSE(sensor->takeReading(reading));
+    EXPECT_EQ(1000U, waitMs);
+    EXPECT_EQ(adapters::Aht20Sensor::State::Idle, sensor->getState());
+    EXPECT_EQ(crcErrorsBefore + 1U, counterValue("aht20.crc_errors"));
+}
+
+TEST_F(Aht20SensorTest, poll_BusError_RetriesLater) {
+    // Arrange
+    powerUpCalibrated();
+    EXPECT_CALL(mockI2cBus, writeBytes(AHT20_ADDR, _, 3U, _)).WillOnce(Return(false));
+
+    // Act & Expect
+    EXPECT_EQ(1000U, sensor->poll());
+    EXPECT_EQ(adapters::Aht20Sensor::State::Idle, sensor->getState());
+}
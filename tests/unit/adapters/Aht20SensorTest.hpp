@@ -0,0 +1,31 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+
+#include "Aht20Sensor.hpp"
+#include "FakeClock.hpp"
+#include "MockI2cBus.hpp"
+
+class Aht20SensorTest : public ::testing::Test {
+   protected:
+    using Frame = std::array<uint8_t, 7>;
+
+    void SetUp() override;
+    void TearDown() override;
+
+    // Steps the sensor through power-up with calibration already loaded
+    void powerUpCalibrated();
+    void expectTrigger();
+    void expectRead(const Frame &frame);
+
+    static Frame makeFrame(const uint8_t &status, const uint32_t &rawHumidity,
+                           const uint32_t &rawTemperature);
+    static uint8_t crc8(const uint8_t *data, const size_t &len);
+
+    adapters::MockI2cBus mockI2cBus;
+    common::FakeClock clock;
+    std::unique_ptr<adapters::Aht20Sensor> sensor;
+};
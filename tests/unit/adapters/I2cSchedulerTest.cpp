@@ -0,0 +1,252 @@
+#include "I2cSchedulerTest.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "I2cScheduler.hpp"
+#include "II2cBus.hpp"
+
+using adapters::I2cPriority;
+
+static constexpr uint32_t BUS_FREQ_HZ = 400000U;
+static constexpr uint64_t START_STOP_US = 20U;  // start, stop and driver overhead
+static constexpr uint64_t CPU_GAP_US = 50U;     // task time between two transactions of a burst
+static constexpr uint64_t SIMULATED_US = 10000000U;
+
+static constexpr size_t PAGE_BYTES = 128U;
+static constexpr size_t PAGE_COUNT = 8U;
+
+static size_t index(const I2cPriority &priority) {
+    return static_cast<size_t>(priority);
+}
+
+uint64_t I2cSchedulerTest::transactionUs(const size_t &bytes) {
+    // Address byte plus payload, 9 clocks per byte including ACK
+    return START_STOP_US + ((bytes + 1U) * 9U * 1000000U) / BUS_FREQ_HZ;
+}
+
+std::vector<size_t> I2cSchedulerTest::displayFrame(const bool &chunked) {
+    std::vector<size_t> frame = {4U, 4U};  // page and column address commands
+    if (chunked) {
+        frame.insert(frame.end(), PAGE_COUNT, PAGE_BYTES + 1U);
+    } else {
+        frame.push_back(PAGE_COUNT * PAGE_BYTES + 1U);
+    }
+    return frame;
+}
+
+std::vector<I2cSchedulerTest::Burst> I2cSchedulerTest::periodic(
+    const uint64_t &firstUs, const uint64_t &periodUs, const uint64_t &untilUs,
+    const std::vector<size_t> &transactionBytes) {
+    std::vector<Burst> bursts;
+    for (uint64_t t = firstUs; t < untilUs; t += periodUs) {
+        bursts.push_back({t, transactionBytes});
+    }
+    return bursts;
+}
+
+I2cSchedulerTest::WorstWaitUs I2cSchedulerTest::simulate(const std::vector<SimClient> &clients) {
+    struct State {
+        size_t burst = 0U;
+        size_t transaction = 0U;
+        uint64_t nextArrivalUs = 0U;
+        bool pending = false;
+    };
+
+    adapters::I2cArbiter arbiter;
+    std::vector<State> states(clients.size());
+    WorstWaitUs worstWaitUs{};
+
+    for (size_t i = 0; i < clients.size(); ++i) {
+        states[i].nextArrivalUs =
+            clients[i].bursts.empty() ? UINT64_MAX : clients[i].bursts[0].startUs;
+    }
+
+    uint64_t nowUs = 0U;
+    while (true) {
+        for (size_t i = 0; i < clients.size(); ++i) {
+            if (!states[i].pending && states[i].nextArrivalUs <= nowUs) {
+                arbiter.enqueue(clients[i].priority);
+                states[i].pending = true;
+            }
+        }
+
+        size_t granted = clients.size();
+        for (size_t i = 0; i < clients.size(); ++i) {
+            if (states[i].pending && arbiter.canStart(clients[i].priority)) {
+                granted = i;
+                break;
+            }
+        }
+
+        if (granted == clients.size()) {
+            uint64_t nextUs = UINT64_MAX;
+            for (const auto &state : states) {
+                nextUs = std::min(nextUs, state.nextArrivalUs);
+            }
+            if (nextUs == UINT64_MAX) {
+                break;
+            }
+            nowUs = nextUs;
+            continue;
+        }
+
+        const SimClient &client = clients[granted];
+        State &state = states[granted];
+        const Burst &burst = client.bursts[state.burst];
+
+        auto &worst = worstWaitUs[index(client.priority)];
+        worst = std::max(worst, nowUs - state.nextArrivalUs);
+
+        arbiter.start(client.priority);
+        nowUs += transactionUs(burst.transactionBytes[state.transaction]);
+        arbiter.finish();
+
+        state.pending = false;
+        if (++state.transaction < burst.transactionBytes.size()) {
+            state.nextArrivalUs = nowUs + CPU_GAP_US;
+        } else {
+            state.transaction = 0U;
+            ++state.burst;
+            state.nextArrivalUs = (state.burst < client.bursts.size())
+                                      ? std::max(client.bursts[state.burst].startUs, nowUs)
+                                      : UINT64_MAX;
+        }
+    }
+
+    return worstWaitUs;
+}
+
+TEST_F(I2cSchedulerTest, arbiter_GrantsHighestPriorityFirst) {
+    // Arrange: the bus is taken, low and high priority queue up behind it
+    arbiter.enqueue(I2cPriority::Normal);
+    ASSERT_TRUE(arbiter.canStart(I2cPriority::Normal));
+    arbiter.start(I2cPriority::Normal);
+
+    arbiter.enqueue(I2cPriority::Low);
+    arbiter.enqueue(I2cPriority::High);
+
+    // Act & Expect: nobody preempts the running transaction
+    EXPECT_FALSE(arbiter.canStart(I2cPriority::High));
+    arbiter.finish();
+
+    EXPECT_TRUE(arbiter.canStart(I2cPriority::High));
+    EXPECT_FALSE(arbiter.canStart(I2cPriority::Low));
+    arbiter.start(I2cPriority::High);
+    arbiter.finish();
+
+    EXPECT_TRUE(arbiter.canStart(I2cPriority::Low));
+}
+
+TEST_F(I2cSchedulerTest, arbiter_WithdrawnRequestUnblocksLowerPriority) {
+    // Arrange
+    arbiter.enqueue(I2cPriority::High);
+    arbiter.enqueue(I2cPriority::Low);
+    ASSERT_FALSE(arbiter.canStart(I2cPriority::Low));
+
+    // Act
+    arbiter.withdraw(I2cPriority::High);
+
+    // Expect
+    EXPECT_EQ(0U, arbiter.getWaiting(I2cPriority::High));
+    EXPECT_TRUE(arbiter.canStart(I2cPriority::Low));
+}
+
+TEST_F(I2cSchedulerTest, simulation_ChunkingBoundsWorstCaseWaitPerPriority) {
+    // Arrange: input redraws at an awkward period, a background redraw every second and
+    // the AHT20 trigger/read pair every 100 ms (10x FR-06 to get more samples)
+    auto makeClients = [](const bool &chunked) {
+        std::vector<SimClient> clients = {
+            {I2cPriority::High, periodic(1000U, 37000U, SIMULATED_US, displayFrame(chunked))},
+            {I2cPriority::Normal, periodic(5000U, 1000000U, SIMULATED_US, displayFrame(chunked))},
+            {I2cPriority::Low, periodic(2000U, 100000U, SIMULATED_US, {4U})},
+            {I2cPriority::Low, periodic(82000U, 100000U, SIMULATED_US, {7U})},
+        };
+        return clients;
+    };
+
+    // Act
+    const WorstWaitUs whole = simulate(makeClients(false));
+    const WorstWaitUs chunked = simulate(makeClients(true));
+
+    printf("[ SIMULATE ] worst wait us  whole-frame: high=%llu normal=%llu low=%llu\n",
+           static_cast<unsigned long long>(whole[0]), static_cast<unsigned long long>(whole[1]),
+           static_cast<unsigned long long>(whole[2]));
+    printf("[ SIMULATE ] worst wait us  page-chunks: high=%llu normal=%llu low=%llu\n",
+           static_cast<unsigned long long>(chunked[0]), static_cast<unsigned long long>(chunked[1]),
+           static_cast<unsigned long long>(chunked[2]));
+
+    // Expect: without preemption a request waits at most for one transaction of a lower
+    // priority, which chunking shrinks from a frame to a page
+    const uint64_t pageUs = transactionUs(PAGE_BYTES + 1U);
+    const uint64_t frameUs = transactionUs(PAGE_COUNT * PAGE_BYTES + 1U);
+
+    EXPECT_GT(whole[index(I2cPriority::Low)], frameUs / 2U);
+    EXPECT_LE(chunked[index(I2cPriority::High)], pageUs);
+    EXPECT_LE(chunked[index(I2cPriority::Normal)], pageUs + CPU_GAP_US);
+    EXPECT_LT(chunked[index(I2cPriority::Low)], whole[index(I2cPriority::Low)] / 4U);
+}
+
+namespace {
+// Host bus that takes real time and detects overlapping transactions
+class SlowBus : public adapters::II2cBus {
+   public:
+    bool init() override {
+        return true;
+    }
+
+    bool writeBytes(const uint8_t &, const uint8_t *, const size_t &, const uint32_t &) override {
+        return transfer();
+    }
+
+    bool readBytes(const uint8_t &, uint8_t *, const size_t &, const uint32_t &) override {
+        return transfer();
+    }
+
+    std::atomic<int> overlaps{0};
+    std::atomic<int> transactions{0};
+
+   private:
+    bool transfer() {
+        if (mInFlight.fetch_add(1) != 0) {
+            overlaps.fetch_add(1);
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        mInFlight.fetch_sub(1);
+        transactions.fetch_add(1);
+        return true;
+    }
+
+    std::atomic<int> mInFlight{0};
+};
+}  // namespace
+
+TEST_F(I2cSchedulerTest, scheduler_SerialisesConcurrentClients) {
+    // Arrange
+    static constexpr int TRANSACTIONS_PER_CLIENT = 100;
+    SlowBus bus;
+    adapters::I2cScheduler scheduler(bus);
+    const uint8_t payload[4] = {};
+
+    // Act
+    std::vector<std::thread> threads;
+    for (const auto priority : {I2cPriority::High, I2cPriority::Normal, I2cPriority::Low}) {
+        threads.emplace_back([&scheduler, &payload, priority] {
+            uint8_t rx[4] = {};
+            for (int i = 0; i < TRANSACTIONS_PER_CLIENT; ++i) {
+                scheduler.client(priority).writeBytes(0x3C, payload, sizeof(payload), 1000U);
+                scheduler.client(priority).readBytes(0x38, rx, sizeof(rx), 1000U);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // Expect
+    EXPECT_EQ(0, bus.overlaps.load());
+    EXPECT_EQ(3 * 2 * TRANSACTIONS_PER_CLIENT, bus.transactions.load());
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "I2cArbiter.hpp"
+
+class I2cSchedulerTest : public ::testing::Test {
+   protected:
+    // A burst is a sequence of transactions one task issues back to back
+    struct Burst {
+        uint64_t startUs;
+        std::vector<size_t> transactionBytes;
+    };
+
+    struct SimClient {
+        adapters::I2cPriority priority;
+        std::vector<Burst> bursts;
+    };
+
+    using WorstWaitUs = std::array<uint64_t, adapters::I2cArbiter::PRIORITY_COUNT>;
+
+    // Discrete-event run of the arbiter against a 400 kHz bus timing model
+    static WorstWaitUs simulate(const std::vector<SimClient> &clients);
+
+    static uint64_t transactionUs(const size_t &bytes);
+    static std::vector<size_t> displayFrame(const bool &chunked);
+    static std::vector<Burst> periodic(const uint64_t &firstUs, const uint64_t &periodUs,
+                                       const uint64_t &untilUs,
+                                       const std::vector<size_t> &transactionBytes);
+
+    adapters::I2cArbiter arbiter;
+};
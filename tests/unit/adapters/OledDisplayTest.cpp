@@ -1,24 +1,54 @@
 #include "OledDisplayTest.hpp"
 
+#include <algorithm>
 #include <cstring>
 
+#include "AllocationCounter.hpp"
+#include "FakeOledBus.hpp"
+
 using ::testing::_;
 using ::testing::Return;
 
 static constexpr uint8_t OLED_I2C_ADDR = 0x3C;
 static constexpr uint8_t DATA_BYTE = 0xFF;
 static constexpr uint8_t DATA_CTRL_BYTE = 0x40;
-static constexpr uint8_t CMD_CTRL_BYTE = 0x00;
+static constexpr uint8_t CMD_BYTE = 0x80;  // Co=1: a single command, more control bytes follow
 static constexpr size_t FRAMEBUFFER_SIZE = 1024U;  // bytes. 128x64 / 8
+static constexpr size_t PAGE_SIZE = 128U;          // bytes per page row
+
+// Column and page address commands as the encoder emits them for an inclusive window
+static std::vector<uint8_t> windowBytes(const uint8_t colStart, const uint8_t colEnd,
+                                        const uint8_t pageStart, const uint8_t pageEnd) {
+    return {CMD_BYTE, 0x21, CMD_BYTE, colStart, CMD_BYTE, colEnd,
+            CMD_BYTE, 0x22, CMD_BYTE, pageStart, CMD_BYTE, pageEnd};
+}
+
+// Data stream of one page row slice
+static std::vector<uint8_t> dataBytes(const std::vector<uint8_t>& framebuffer, const size_t page,
+                                      const size_t colStart, const size_t colEnd) {
+    const auto first = framebuffer.begin() + page * PAGE_SIZE + colStart;
+    std::vector<uint8_t> bytes(first, first + (colEnd - colStart + 1U));
+    bytes.insert(bytes.begin(), DATA_CTRL_BYTE);
+    return bytes;
+}
 
 void OledDisplayTest::SetUp() {
-    display = std::make_unique<adapters::OledSsd1306Display>(mockI2cBus);
+    display = std::make_unique<adapters::OledDisplay<common::Ssd1306Panel128x64>>(mockI2cBus);
 }
 
 void OledDisplayTest::TearDown() {
     display.reset();
 }
 
+void OledDisplayTest::recordTransactions() {
+    EXPECT_CALL(mockI2cBus, writeBytes(OLED_I2C_ADDR, _, _, _))
+        .WillRepeatedly([this](const uint8_t& addr, const uint8_t* data, const size_t& len,
+                               const uint32_t& timeout) {
+            recorded.emplace_back(data, data + len);
+            return true;
+        });
+}
+
 void OledDisplayTest::initDisplay() {
     const std::vector<uint8_t> expectedBytes = {
         0x00, 0xAE, 0xD5, 0x80, 0xA8, 0x3F, 0xD3, 0x00, 0x40, 0x8D, 0x14, 0x20, 0x00,
@@ -42,36 +72,143 @@ TEST_F(OledDisplayTest, init_Success) {
 TEST_F(OledDisplayTest, showFramebuffer_Success) {
     initDisplay();
 
+    // Preparation: every page row carries its own index so the order can be checked
+    std::vector<uint8_t> framebuffer(FRAMEBUFFER_SIZE);
+    for (size_t i = 0; i < FRAMEBUFFER_SIZE; ++i) {
+        framebuffer[i] = static_cast<uint8_t>(i / PAGE_SIZE);
+    }
+    recordTransactions();
+
+    // Execution
+    display->showFramebuffer(framebuffer.data(), framebuffer.size());
+
+    // Expectations: the window rides in the first page's transaction, one page per
+    // transaction so other devices can use the bus in between
+    ASSERT_EQ(FRAMEBUFFER_SIZE / PAGE_SIZE, recorded.size());
+    for (size_t page = 0; page < recorded.size(); ++page) {
+        std::vector<uint8_t> expected =
+            (page == 0U) ? windowBytes(0U, 127U, 0U, 7U) : std::vector<uint8_t>{};
+        const auto data = dataBytes(framebuffer, page, 0U, PAGE_SIZE - 1U);
+        expected.insert(expected.end(), data.begin(), data.end());
+        EXPECT_EQ(expected, recorded[page]) << "page " << page;
+    }
+}
+
+TEST_F(OledDisplayTest, showRegions_OneTransactionPerRegionPage) {
+    initDisplay();
+
+    // Preparation: volume digits on page 0 and a two-page block further down
+    std::vector<uint8_t> framebuffer(FRAMEBUFFER_SIZE);
+    for (size_t i = 0; i < FRAMEBUFFER_SIZE; ++i) {
+        framebuffer[i] = static_cast<uint8_t>(i);
+    }
+    const adapters::DisplayRegion regions[] = {{104U, 127U, 0U, 0U}, {10U, 12U, 3U, 4U}};
+    recordTransactions();
+
+    // Execution
+    display->showRegions(framebuffer.data(), framebuffer.size(), regions, 2U);
+
+    // Expectations
+    std::vector<uint8_t> volume = windowBytes(104U, 127U, 0U, 0U);
+    const auto volumeData = dataBytes(framebuffer, 0U, 104U, 127U);
+    volume.insert(volume.end(), volumeData.begin(), volumeData.end());
+
+    std::vector<uint8_t> blockPage3 = windowBytes(10U, 12U, 3U, 4U);
+    const auto blockData = dataBytes(framebuffer, 3U, 10U, 12U);
+    blockPage3.insert(blockPage3.end(), blockData.begin(), blockData.end());
+    const auto blockPage4 = dataBytes(framebuffer, 4U, 10U, 12U);
+
+    ASSERT_EQ(3U, recorded.size());
+    EXPECT_EQ(volume, recorded[0]);
+    EXPECT_EQ(blockPage3, recorded[1]);
+    EXPECT_EQ(blockPage4, recorded[2]);
+}
+
+TEST_F(OledDisplayTest, scrollPages_StartLineRidesWithNextUpload) {
+    initDisplay();
+
+    // Preparation: after rotating up by a page, screen page 0 lives in RAM page 1 and
+    // screen page 7 in RAM page 0
+    std::vector<uint8_t> framebuffer(FRAMEBUFFER_SIZE);
+    for (size_t i = 0; i < FRAMEBUFFER_SIZE; ++i) {
+        framebuffer[i] = static_cast<uint8_t>(i / PAGE_SIZE);
+    }
+    const adapters::DisplayRegion regions[] = {{0U, 127U, 0U, 0U}, {0U, 127U, 7U, 7U}};
+    recordTransactions();
+
+    // Execution
+    display->scrollPages(1);
+    display->showRegions(framebuffer.data(), framebuffer.size(), regions, 2U);
+
+    // Expectations
+    std::vector<uint8_t> status = {CMD_BYTE, 0x48};
+    const auto statusWindow = windowBytes(0U, 127U, 1U, 1U);
+    const auto statusData = dataBytes(framebuffer, 0U, 0U, 127U);
+    status.insert(status.end(), statusWindow.begin(), statusWindow.end());
+    status.insert(status.end(), statusData.begin(), statusData.end());
+
+    std::vector<uint8_t> exposed = windowBytes(0U, 127U, 0U, 0U);
+    const auto exposedData = dataBytes(framebuffer, 7U, 0U, 127U);
+    exposed.insert(exposed.end(), exposedData.begin(), exposedData.end());
+
+    ASSERT_EQ(2U, recorded.size());
+    EXPECT_EQ(status, recorded[0]);
+    EXPECT_EQ(exposed, recorded[1]);
+    EXPECT_EQ(8U, display->getStartLine());
+}
+
+TEST_F(OledDisplayTest, scrollPages_RegionWrappingRamEnd_SplitsWindow) {
+    initDisplay();
+
     // Preparation
     const std::vector<uint8_t> framebuffer(FRAMEBUFFER_SIZE, DATA_BYTE);
-    std::vector<uint8_t> expectedFrameBuffer(FRAMEBUFFER_SIZE + 1U);
-    expectedFrameBuffer[0] = DATA_CTRL_BYTE;
-    std::fill(expectedFrameBuffer.begin() + 1U, expectedFrameBuffer.end(), DATA_BYTE);
-    const std::vector<uint8_t> pageCmdBytes = {CMD_CTRL_BYTE, 0x22, 0x00, 0x07};
-    const std::vector<uint8_t> colCmdBytes = {CMD_CTRL_BYTE, 0x21, 0x00, 0x7F};
+    recordTransactions();
+
+    // Execution: rotated down by two pages, screen pages 0-7 are RAM pages 6, 7, 0-5
+    display->scrollPages(-2);
+    display->showFramebuffer(framebuffer.data(), framebuffer.size());
 
     // Expectations
-    EXPECT_CALL(mockI2cBus, writeBytes(OLED_I2C_ADDR, _, _, _))
-        .Times(2)
-        .WillRepeatedly([pageCmdBytes, colCmdBytes](const uint8_t& addr, const uint8_t* data,
-                                                    const size_t& len, const uint32_t& timeout) {
-            EXPECT_TRUE(pageCmdBytes.size() == len || colCmdBytes.size() == len);
-            EXPECT_TRUE(std::memcmp(data, pageCmdBytes.data(), len) == 0 ||
-                        std::memcmp(data, colCmdBytes.data(), len) == 0);
-            return true;
-        });
+    ASSERT_EQ(FRAMEBUFFER_SIZE / PAGE_SIZE, recorded.size());
+    std::vector<uint8_t> first = {CMD_BYTE, 0x70};
+    const auto firstWindow = windowBytes(0U, 127U, 6U, 7U);
+    first.insert(first.end(), firstWindow.begin(), firstWindow.end());
+    const auto wrapWindow = windowBytes(0U, 127U, 0U, 5U);
+    EXPECT_TRUE(std::equal(first.begin(), first.end(), recorded[0].begin()));
+    EXPECT_EQ(DATA_CTRL_BYTE, recorded[1][0]);
+    EXPECT_TRUE(std::equal(wrapWindow.begin(), wrapWindow.end(), recorded[2].begin()));
+    EXPECT_EQ(48U, display->getStartLine());
+}
 
-    EXPECT_CALL(mockI2cBus, writeBytes(OLED_I2C_ADDR, _, expectedFrameBuffer.size(), _))
-        .Times(1)
-        .WillOnce([expectedFrameBuffer](const uint8_t& addr, const uint8_t* data, const size_t& len,
-                                        const uint32_t& timeout) {
-            EXPECT_EQ(expectedFrameBuffer.size(), len);
-            EXPECT_TRUE(std::memcmp(data, expectedFrameBuffer.data(), len) == 0);
-            return true;
-        });
+TEST_F(OledDisplayTest, scrollPages_NothingToUpload_SendsStartLineAlone) {
+    initDisplay();
+
+    // Preparation
+    const std::vector<uint8_t> framebuffer(FRAMEBUFFER_SIZE, DATA_BYTE);
+    recordTransactions();
 
     // Execution
-    display->showFramebuffer(framebuffer.data(), framebuffer.size());
+    display->scrollPages(-1);
+    display->showRegions(framebuffer.data(), framebuffer.size(), nullptr, 0U);
+
+    // Expectations
+    ASSERT_EQ(1U, recorded.size());
+    EXPECT_EQ((std::vector<uint8_t>{CMD_BYTE, 0x78}), recorded[0]);
+}
+
+TEST_F(OledDisplayTest, showRegions_InvalidRegion_IsSkipped) {
+    initDisplay();
+
+    // Preparation
+    const std::vector<uint8_t> framebuffer(FRAMEBUFFER_SIZE, DATA_BYTE);
+    const adapters::DisplayRegion regions[] = {{0U, 128U, 0U, 0U}, {5U, 4U, 0U, 0U},
+                                               {0U, 0U, 0U, 8U}};
+
+    // Expectations
+    EXPECT_CALL(mockI2cBus, writeBytes(_, _, _, _)).Times(0);
+
+    // Execution
+    display->showRegions(framebuffer.data(), framebuffer.size(), regions, 3U);
 }
 
 TEST_F(OledDisplayTest, showFramebuffer_NotReady) {
@@ -80,3 +217,25 @@ TEST_F(OledDisplayTest, showFramebuffer_NotReady) {
     // No expectations on I2C bus since display is not initialized
     display->showFramebuffer(framebuffer.data(), framebuffer.size());
 }
+
+TEST_F(OledDisplayTest, showFramebuffer_SteadyState_NoHeapAllocations) {
+    // Arrange: a bus that does not allocate either, warmed up by a first frame
+    adapters::FakeOledBus<common::Ssd1306Panel128x64> bus;
+    adapters::OledDisplay<common::Ssd1306Panel128x64> oled(bus);
+    ASSERT_TRUE(oled.init());
+    const std::vector<uint8_t> framebuffer(FRAMEBUFFER_SIZE, DATA_BYTE);
+    const adapters::DisplayRegion regions[] = {{104U, 127U, 0U, 0U}, {0U, 127U, 1U, 7U}};
+    oled.showFramebuffer(framebuffer.data(), framebuffer.size());
+
+    // Act
+    AllocationCounter allocations;
+    oled.showFramebuffer(framebuffer.data(), framebuffer.size());
+    oled.scrollPages(1);
+    oled.showRegions(framebuffer.data(), framebuffer.size(), regions, 2U);
+    const size_t count = allocations.count();
+    const size_t bytes = allocations.bytes();
+
+    // Expect: every transaction is built in the driver's own buffer
+    EXPECT_EQ(0U, count) << bytes << " bytes";
+    EXPECT_GT(bus.getTransactions(), FRAMEBUFFER_SIZE / PAGE_SIZE);
+}
@@ -2,8 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <vector>
+
 #include "MockI2cBus.hpp"
-#include "OledSsd1306Display.hpp"
+#include "OledDisplay.hpp"
 
 class OledDisplayTest : public ::testing::Test {
    protected:
@@ -11,7 +14,10 @@ class OledDisplayTest : public ::testing::Test {
     void TearDown() override;
 
     void initDisplay();
+    // Captures every transaction written to the bus into recorded
+    void recordTransactions();
 
     adapters::MockI2cBus mockI2cBus;
-    std::unique_ptr<adapters::OledSsd1306Display> display;
+    std::unique_ptr<adapters::OledDisplay<common::Ssd1306Panel128x64>> display;
+    std::vector<std::vector<uint8_t>> recorded;
 };
@@ -0,0 +1,75 @@
+#include "Ssd1306EncoderTest.hpp"
+
+#include <vector>
+
+void Ssd1306EncoderTest::SetUp() {
+    encoder = std::make_unique<adapters::Ssd1306Encoder>(buffer.data(), buffer.size());
+}
+
+void Ssd1306EncoderTest::TearDown() {
+    encoder.reset();
+}
+
+std::vector<uint8_t> Ssd1306EncoderTest::bytes() const {
+    return std::vector<uint8_t>(encoder->data(), encoder->data() + encoder->size());
+}
+
+TEST_F(Ssd1306EncoderTest, setWindowAndData_SingleTransaction) {
+    // Arrange
+    const uint8_t pixels[] = {0x11, 0x22, 0x33};
+
+    // Act
+    ASSERT_TRUE(encoder->setWindow(10U, 12U, 2U, 2U));
+    ASSERT_TRUE(encoder->dataStream(pixels, sizeof(pixels)));
+
+    // Expect: Co=1 control byte before every command, one data stream at the end
+    const std::vector<uint8_t> expected = {0x80, 0x21, 0x80, 10U,  0x80, 12U,  0x80, 0x22,
+                                           0x80, 0x02, 0x80, 0x02, 0x40, 0x11, 0x22, 0x33};
+    EXPECT_EQ(expected, bytes());
+}
+
+TEST_F(Ssd1306EncoderTest, setPageAddress_SplitsColumnIntoNibbles) {
+    // Act: SH1106 column 130 is the last of its 132
+    ASSERT_TRUE(encoder->setPageAddress(5U, 130U));
+
+    // Expect
+    const std::vector<uint8_t> expected = {0x80, 0xB5, 0x80, 0x02, 0x80, 0x18};
+    EXPECT_EQ(expected, bytes());
+    EXPECT_EQ(adapters::Ssd1306Encoder::PAGE_ADDRESS_SIZE, encoder->size());
+}
+
+TEST_F(Ssd1306EncoderTest, command_AfterDataStream_IsRejected) {
+    // Arrange
+    const uint8_t pixel = 0xFF;
+    ASSERT_TRUE(encoder->dataStream(&pixel, 1U));
+
+    // Act & Expect: everything after a Co=0 control byte is data to the controller
+    EXPECT_FALSE(encoder->command(0xAF));
+    EXPECT_FALSE(encoder->dataStream(&pixel, 1U));
+    EXPECT_EQ((std::vector<uint8_t>{0x40, 0xFF}), bytes());
+}
+
+TEST_F(Ssd1306EncoderTest, commandStream_UsesSingleControlByte) {
+    // Arrange
+    const uint8_t cmds[] = {0xAE, 0xA6, 0xAF};
+
+    // Act
+    ASSERT_TRUE(encoder->commandStream(cmds, sizeof(cmds)));
+
+    // Expect
+    EXPECT_EQ((std::vector<uint8_t>{0x00, 0xAE, 0xA6, 0xAF}), bytes());
+}
+
+TEST_F(Ssd1306EncoderTest, dataStream_Overflow_LeavesBufferUntouched) {
+    // Arrange
+    const std::array<uint8_t, CAPACITY> pixels{};
+    ASSERT_TRUE(encoder->setWindow(0U, 127U, 0U, 0U));
+
+    // Act & Expect
+    EXPECT_FALSE(encoder->dataStream(pixels.data(), pixels.size()));
+    EXPECT_EQ(adapters::Ssd1306Encoder::WINDOW_SIZE, encoder->size());
+
+    encoder->reset();
+    EXPECT_EQ(0U, encoder->size());
+    EXPECT_TRUE(encoder->dataStream(pixels.data(), CAPACITY - 1U));
+}
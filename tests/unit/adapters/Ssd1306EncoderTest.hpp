@@ -0,0 +1,21 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+
+#include "Ssd1306Encoder.hpp"
+
+class Ssd1306EncoderTest : public ::testing::Test {
+   protected:
+    static constexpr size_t CAPACITY = 32U;
+
+    void SetUp() override;
+    void TearDown() override;
+
+    std::vector<uint8_t> bytes() const;
+
+    std::array<uint8_t, CAPACITY> buffer{};
+    std::unique_ptr<adapters::Ssd1306Encoder> encoder;
+};
@@ -1,14 +1,31 @@
 #include "AppControllerTest.hpp"
 
+#include <mutex>
+#include <thread>
+
+#include "FakeKeyValueStore.hpp"
+#include "InputTypes.hpp"
+
+// IDF
+#include <esp_timer.h>
+
 using ::testing::_;
+using ::testing::Return;
+using ::testing::ReturnRef;
+using ::testing::StrEq;
 
 void AppControllerTest::SetUp() {
     mockUiTask = std::make_unique<core::MockUiTask>();
-    appController = std::make_unique<core::AppController>(*mockUiTask);
+    mockRepo = std::make_unique<services::MockStationRepository>();
+    appController = std::make_unique<core::AppController>(*mockUiTask, *mockRepo);
+
+    stations = {{"id1", "S1", "url1"}, {"id2", "S2", "url2"}, {"id3", "S3", "url3"}};
+    ON_CALL(*mockRepo, getStations()).WillByDefault(ReturnRef(stations));
 }
 
 void AppControllerTest::TearDown() {
     appController.reset();
+    mockRepo.reset();
     mockUiTask.reset();
 }
 
@@ -27,3 +44,379 @@ TEST_F(AppControllerTest, init_Success) {
     // Act
     appController->init();
 }
+
+TEST_F(AppControllerTest, onInput_UpDown_WrapsSelection) {
+    // Arrange
+    std::vector<int> selections;
+    EXPECT_CALL(*mockRepo, getStations()).Times(3);
+    EXPECT_CALL(*mockUiTask, post(_))
+        .Times(3)
+        .WillRepeatedly([&selections](const common::UiEvent &e) {
+            EXPECT_EQ(e.type, common::UiEvent::Type::RENDER_STATIONS);
+            selections.push_back(e.selectedIndex);
+        });
+
+    // Act
+    appController->onInput({common::InputEvent::Type::Up});
+    appController->onInput({common::InputEvent::Type::Down});
+    appController->onInput({common::InputEvent::Type::Down});
+
+    // Expect
+    EXPECT_EQ((std::vector<int>{2, 0, 1}), selections);
+    EXPECT_EQ(1, appController->getModel().selectedStationIndex);
+}
+
+TEST_F(AppControllerTest, onInput_Volume_StepsAndClamps) {
+    // Arrange
+    std::vector<int> volumes;
+    EXPECT_CALL(*mockUiTask, post(_)).Times(2).WillRepeatedly([&volumes](const common::UiEvent &e) {
+        EXPECT_EQ(e.type, common::UiEvent::Type::RENDER_VOLUME);
+        volumes.push_back(e.volume);
+    });
+
+    // Act
+    appController->onInput({common::InputEvent::Type::Volume, 3});   // 50 -> 56
+    appController->onInput({common::InputEvent::Type::Volume, 40});  // clamped to 100
+    appController->onInput({common::InputEvent::Type::Volume, 1});   // no change, no post
+
+    // Expect
+    EXPECT_EQ((std::vector<int>{56, 100}), volumes);
+}
+
+TEST_F(AppControllerTest, onClimate_PostsOnlyWhenShownValueChanges) {
+    // Arrange
+    std::vector<int16_t> temperatures;
+    EXPECT_CALL(*mockUiTask, post(_))
+        .Times(2)
+        .WillRepeatedly([&temperatures](const common::UiEvent &e) {
+            EXPECT_EQ(e.type, common::UiEvent::Type::RENDER_CLIMATE);
+            temperatures.push_back(e.temperatureCentiC);
+        });
+
+    // Act
+    appController->onClimate({2351, 4000U, 0U});  // first reading
+    appController->onClimate({2358, 4100U, 1U});  // still 23.5 C
+    appController->onClimate({2361, 4100U, 2U});  // 23.6 C
+
+    // Expect
+    EXPECT_EQ((std::vector<int16_t>{2351, 2361}), temperatures);
+    EXPECT_EQ(2361, appController->getModel().climate.temperatureCentiC);
+}
+
+TEST_F(AppControllerTest, onSpectrum_PostsOnlyChangedFramesWhilePlaying) {
+    // Arrange
+    std::vector<common::UiEvent::Type> events;
+    const auto record = [&events](const common::UiEvent &e) {
+        events.push_back(e.type);
+        return true;
+    };
+    EXPECT_CALL(*mockUiTask, post(_)).WillRepeatedly(record);
+    // Frames never wait for room in the UI queue
+    EXPECT_CALL(*mockUiTask, tryPost(_)).WillRepeatedly(record);
+    common::SpectrumLevels levels{};
+    levels[2] = 90U;
+
+    // Act
+    appController->onSpectrum(levels);  // stopped
+    appController->onInput({common::InputEvent::Type::PlayStop});
+    appController->onSpectrum(levels);
+    appController->onSpectrum(levels);  // same frame
+    levels[3] = 40U;
+    appController->onSpectrum(levels);
+    appController->onInput({common::InputEvent::Type::PlayStop});
+    appController->onSpectrum(levels);  // stopped again
+
+    // Expect
+    using Type = common::UiEvent::Type;
+    EXPECT_EQ((std::vector<Type>{Type::RENDER_STATUS, Type::RENDER_SPECTRUM, Type::RENDER_SPECTRUM,
+                                 Type::RENDER_STATUS}),
+              events);
+    EXPECT_EQ(common::SpectrumLevels{}, appController->getModel().spectrum);
+}
+
+TEST_F(AppControllerTest, onSpectrum_WhileTogglingPlayback_LeavesNoFrameInStoppedModel) {
+    // Arrange
+    EXPECT_CALL(*mockUiTask, post(_)).Times(::testing::AnyNumber());
+    EXPECT_CALL(*mockUiTask, tryPost(_)).WillRepeatedly(Return(true));
+
+    // Act: the spectrum task keeps sending frames while the input task plays and stops
+    std::thread input([this] {
+        for (int i = 0; i < 2000; ++i) {
+            appController->onInput({common::InputEvent::Type::PlayStop});
+        }
+    });
+    common::SpectrumLevels levels{};
+    for (int i = 0; i < 20000; ++i) {
+        levels[0] = static_cast<uint8_t>(i + 1);
+        appController->onSpectrum(levels);
+    }
+    input.join();
+
+    // Expect: an even number of presses ends stopped, and no frame outlived the last stop
+    const common::AppModel model = appController->getModel();
+    EXPECT_FALSE(model.playing);
+    EXPECT_EQ(common::SpectrumLevels{}, model.spectrum);
+}
+
+TEST_F(AppControllerTest, onInput_PlayStop_PostsPlaybackStatus) {
+    // Arrange
+    std::vector<common::PlaybackState> states;
+    EXPECT_CALL(*mockUiTask, post(_)).Times(2).WillRepeatedly([&states](const common::UiEvent &e) {
+        EXPECT_EQ(e.type, common::UiEvent::Type::RENDER_STATUS);
+        states.push_back(e.status.playback);
+    });
+
+    // Act
+    appController->onInput({common::InputEvent::Type::PlayStop});
+    appController->onInput({common::InputEvent::Type::PlayStop});
+
+    // Expect
+    EXPECT_EQ((std::vector<common::PlaybackState>{common::PlaybackState::Playing,
+                                                  common::PlaybackState::Stopped}),
+              states);
+}
+
+TEST_F(AppControllerTest, onWifiStatus_PostsStatusKeepingPlayback) {
+    // Arrange
+    std::vector<common::UiStatus> statuses;
+    EXPECT_CALL(*mockUiTask, post(_))
+        .Times(3)
+        .WillRepeatedly([&statuses](const common::UiEvent &e) {
+            EXPECT_EQ(e.type, common::UiEvent::Type::RENDER_STATUS);
+            statuses.push_back(e.status);
+        });
+
+    // Act
+    appController->onInput({common::InputEvent::Type::PlayStop});
+    appController->onWifiStatus(common::UiStatusKind::WifiConnecting, 0);
+    appController->onWifiStatus(common::UiStatusKind::WifiConnected, -61);
+
+    // Expect
+    ASSERT_EQ(3U, statuses.size());
+    EXPECT_EQ(common::UiStatusKind::WifiConnecting, statuses[1].kind);
+    EXPECT_EQ(common::UiStatusKind::WifiConnected, statuses[2].kind);
+    EXPECT_EQ(-61, statuses[2].rssiDbm);
+    EXPECT_EQ(common::PlaybackState::Playing, statuses[2].playback);
+}
+
+TEST_F(AppControllerTest, onWifiStatus_WhileTogglingPlayback_LastPostShowsLatestStatus) {
+    // Arrange
+    std::mutex postMutex;
+    std::vector<common::UiStatus> statuses;
+    EXPECT_CALL(*mockUiTask, post(_)).WillRepeatedly([&](const common::UiEvent &e) {
+        std::lock_guard<std::mutex> lock(postMutex);
+        statuses.push_back(e.status);
+    });
+
+    // Act: the Wi-Fi task reports while the input task keeps posting its own statuses
+    std::thread input([this] {
+        for (int i = 0; i < 2000; ++i) {
+            appController->onInput({common::InputEvent::Type::PlayStop});
+        }
+    });
+    for (int i = 0; i < 200; ++i) {
+        appController->onWifiStatus(common::UiStatusKind::WifiConnecting, 0);
+        appController->onWifiStatus(common::UiStatusKind::WifiConnected, -61);
+    }
+    input.join();
+
+    // Expect: no post carries a Wi-Fi status older than one already shown
+    ASSERT_FALSE(statuses.empty());
+    EXPECT_EQ(common::UiStatusKind::WifiConnected, statuses.back().kind);
+    EXPECT_EQ(-61, statuses.back().rssiDbm);
+}
+
+TEST_F(AppControllerTest, onInput_PlayStop_DrivesPlayerWithSelectedStation) {
+    // Arrange
+    ::testing::NiceMock<player::MockPlayerControl> player;
+    EXPECT_CALL(player, setVolume(50));
+    appController->setPlayer(&player);
+    EXPECT_CALL(*mockUiTask, post(_)).Times(3);
+    appController->onInput({common::InputEvent::Type::Down});
+
+    // Expect
+    ::testing::InSequence order;
+    EXPECT_CALL(player, play(StrEq("url2"))).WillOnce(Return(true));
+    EXPECT_CALL(player, stop()).WillOnce(Return(true));
+
+    // Act
+    appController->onInput({common::InputEvent::Type::PlayStop});
+    appController->onInput({common::InputEvent::Type::PlayStop});
+}
+
+TEST_F(AppControllerTest, onInput_UpDownWhilePlaying_SwitchesStation) {
+    // Arrange
+    ::testing::NiceMock<player::MockPlayerControl> player;
+    appController->setPlayer(&player);
+    EXPECT_CALL(*mockUiTask, post(_)).Times(::testing::AnyNumber());
+    EXPECT_CALL(player, play(StrEq("url1"))).WillOnce(Return(true));
+    appController->onInput({common::InputEvent::Type::PlayStop});
+
+    // Expect: the stream changes under the running player, it is never stopped
+    ::testing::InSequence order;
+    EXPECT_CALL(player, switchTo(StrEq("url2"))).WillOnce(Return(true));
+    EXPECT_CALL(player, switchTo(StrEq("url3"))).WillOnce(Return(true));
+    EXPECT_CALL(player, stop()).Times(0);
+
+    // Act
+    appController->onInput({common::InputEvent::Type::Down});
+    appController->onInput({common::InputEvent::Type::Down});
+}
+
+TEST_F(AppControllerTest, onInput_PlayStopRefusedByPlayer_StaysStopped) {
+    // Arrange
+    ::testing::NiceMock<player::MockPlayerControl> player;
+    appController->setPlayer(&player);
+    std::vector<common::PlaybackState> states;
+    EXPECT_CALL(*mockUiTask, post(_)).WillRepeatedly([&states](const common::UiEvent &e) {
+        if (e.type == common::UiEvent::Type::RENDER_STATUS) {
+            states.push_back(e.status.playback);
+        }
+    });
+    EXPECT_CALL(player, play(StrEq("url1"))).WillOnce(Return(false));
+
+    // Act
+    appController->onInput({common::InputEvent::Type::PlayStop});
+
+    // Expect
+    EXPECT_FALSE(appController->getModel().playing);
+    ASSERT_FALSE(states.empty());
+    EXPECT_EQ(common::PlaybackState::Stopped, states.back());
+}
+
+TEST_F(AppControllerTest, onInput_Volume_ForwardsToPlayer) {
+    // Arrange
+    ::testing::NiceMock<player::MockPlayerControl> player;
+    appController->setPlayer(&player);
+    EXPECT_CALL(*mockUiTask, post(_)).Times(1);
+
+    // Expect
+    EXPECT_CALL(player, setVolume(54));
+
+    // Act
+    appController->onInput({common::InputEvent::Type::Volume, 2});
+}
+
+TEST_F(AppControllerTest, onInput_PlayStop_RemembersStationOnlyWhenItChanged) {
+    // Arrange
+    common::FakeKeyValueStore settings;
+    ::testing::NiceMock<player::MockPlayerControl> player;
+    appController->setPlayer(&player);
+    appController->setSettings(&settings);
+    ON_CALL(player, play(_)).WillByDefault(Return(true));
+    EXPECT_CALL(*mockUiTask, post(_)).Times(::testing::AnyNumber());
+
+    const auto settle = [this] {
+        appController->saveSettings(esp_timer_get_time() +
+                                    core::AppController::STATION_SAVE_DELAY_US);
+    };
+
+    // Act: play, stop, play the same station again, then another one, each left to settle
+    appController->onInput({common::InputEvent::Type::PlayStop});
+    settle();
+    appController->onInput({common::InputEvent::Type::PlayStop});
+    appController->onInput({common::InputEvent::Type::PlayStop});
+    settle();
+    appController->onInput({common::InputEvent::Type::PlayStop});
+    appController->onInput({common::InputEvent::Type::Down});
+    appController->onInput({common::InputEvent::Type::PlayStop});
+    settle();
+
+    // Expect
+    char id[8] = {};
+    EXPECT_EQ(3U, settings.load(core::AppController::LAST_STATION_KEY, id, sizeof(id) - 1U));
+    EXPECT_STREQ("id2", id);
+    EXPECT_EQ(2, settings.writes());
+}
+
+TEST_F(AppControllerTest, saveSettings_ScrollingWhilePlaying_WritesOnlyTheStationThatStays) {
+    // Arrange
+    common::FakeKeyValueStore settings;
+    ::testing::NiceMock<player::MockPlayerControl> player;
+    appController->setPlayer(&player);
+    appController->setSettings(&settings);
+    ON_CALL(player, play(_)).WillByDefault(Return(true));
+    ON_CALL(player, switchTo(_)).WillByDefault(Return(true));
+    EXPECT_CALL(*mockUiTask, post(_)).Times(::testing::AnyNumber());
+
+    // Act: start playing, scroll two stations down and check before and after the delay
+    appController->onInput({common::InputEvent::Type::PlayStop});
+    appController->onInput({common::InputEvent::Type::Down});
+    appController->onInput({common::InputEvent::Type::Down});
+    appController->saveSettings(esp_timer_get_time());
+    const int writesWhileScrolling = settings.writes();
+    appController->saveSettings(esp_timer_get_time() + core::AppController::STATION_SAVE_DELAY_US);
+
+    // Expect
+    EXPECT_EQ(0, writesWhileScrolling);
+    char id[8] = {};
+    EXPECT_EQ(3U, settings.load(core::AppController::LAST_STATION_KEY, id, sizeof(id) - 1U));
+    EXPECT_STREQ("id3", id);
+    EXPECT_EQ(1, settings.writes());
+}
+
+TEST_F(AppControllerTest, autoplay_Stopped_SelectsAndPlaysStation) {
+    // Arrange
+    ::testing::NiceMock<player::MockPlayerControl> player;
+    appController->setPlayer(&player);
+    std::vector<common::UiEvent::Type> events;
+    EXPECT_CALL(*mockUiTask, post(_)).WillRepeatedly([&events](const common::UiEvent &e) {
+        events.push_back(e.type);
+    });
+
+    // Expect
+    EXPECT_CALL(player, play(StrEq("url3"))).WillOnce(Return(true));
+
+    // Act
+    const bool started = appController->autoplay(2);
+
+    // Expect
+    EXPECT_TRUE(started);
+    EXPECT_EQ(2, appController->getModel().selectedStationIndex);
+    EXPECT_TRUE(appController->getModel().playing);
+    EXPECT_EQ((std::vector<common::UiEvent::Type>{common::UiEvent::Type::RENDER_STATIONS,
+                                                  common::UiEvent::Type::RENDER_STATUS}),
+              events);
+}
+
+TEST_F(AppControllerTest, autoplay_AlreadyPlayingOrNoPlayer_Refused) {
+    // Arrange
+    ::testing::NiceMock<player::MockPlayerControl> player;
+    ON_CALL(player, play(_)).WillByDefault(Return(true));
+    EXPECT_CALL(*mockUiTask, post(_)).Times(::testing::AnyNumber());
+
+    // Act
+    const bool withoutPlayer = appController->autoplay(1);
+    appController->setPlayer(&player);
+    const bool outOfRange = appController->autoplay(3);
+    appController->onInput({common::InputEvent::Type::PlayStop});
+    const bool whilePlaying = appController->autoplay(1);
+
+    // Expect
+    EXPECT_FALSE(withoutPlayer);
+    EXPECT_FALSE(outOfRange);
+    EXPECT_FALSE(whilePlaying);
+    EXPECT_EQ(0, appController->getModel().selectedStationIndex);
+}
+
+TEST_F(AppControllerTest, autoplay_RacingPlayStop_StartsThePlayerOnce) {
+    // Arrange
+    EXPECT_CALL(*mockUiTask, post(_)).Times(::testing::AnyNumber());
+
+    for (int round = 0; round < 200; ++round) {
+        ::testing::NiceMock<player::MockPlayerControl> player;
+        core::AppController controller(*mockUiTask, *mockRepo);
+        controller.setPlayer(&player);
+
+        // Expect: whichever comes first, the other sees it and the player starts once
+        EXPECT_CALL(player, play(_)).WillOnce(Return(true));
+
+        // Act
+        std::thread input([&controller] {
+            controller.onInput({common::InputEvent::Type::PlayStop});
+        });
+        controller.autoplay(2);
+        input.join();
+        ::testing::Mock::VerifyAndClearExpectations(&player);
+    }
+}
@@ -3,9 +3,13 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <vector>
 
 #include "AppController.hpp"
+#include "MockPlayerControl.hpp"
+#include "MockStationRepository.hpp"
 #include "MockUiTask.hpp"
+#include "UiTypes.hpp"
 
 class AppControllerTest : public ::testing::Test {
    protected:
@@ -13,5 +17,8 @@ class AppControllerTest : public ::testing::Test {
     void TearDown() override;
 
     std::unique_ptr<core::MockUiTask> mockUiTask;
+    std::unique_ptr<services::MockStationRepository> mockRepo;
     std::unique_ptr<core::AppController> appController;
+
+    std::vector<common::StationData> stations;
 };
@@ -0,0 +1,235 @@
+#include "AutoplayOrchestratorTest.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "InputTypes.hpp"
+
+using core::AutoplayOrchestrator;
+using ::testing::_;
+using ::testing::ReturnRef;
+
+static constexpr uint64_t US_PER_MS = 1000U;
+// Hooks fire and steps run on poll boundaries, so a result may be off by a couple of polls
+static constexpr uint32_t TOLERANCE_MS = 2U * AutoplayOrchestrator::POLL_MS;
+
+void AutoplayOrchestratorTest::SetUp() {
+    mockUiTask = std::make_unique<::testing::NiceMock<core::MockUiTask>>();
+    mockRepo = std::make_unique<::testing::NiceMock<services::MockStationRepository>>();
+    mockPlayer = std::make_unique<::testing::NiceMock<player::MockPlayerControl>>();
+    appController = std::make_unique<core::AppController>(*mockUiTask, *mockRepo);
+    playback = std::make_unique<SimulatedPlayback>(clock);
+
+    stations = {{"id1", "S1", "url1"}, {"id2", "S2", "url2"}, {"id3", "S3", "url3"}};
+    ON_CALL(*mockRepo, getStations()).WillByDefault(ReturnRef(stations));
+    rememberStation("id2");
+}
+
+void AutoplayOrchestratorTest::TearDown() {
+    orchestrator.reset();
+    preopener.reset();
+    appController.reset();
+    mockPlayer.reset();
+    mockRepo.reset();
+    mockUiTask.reset();
+}
+
+void AutoplayOrchestratorTest::rememberStation(const char *id) {
+    settings.save(core::AppController::LAST_STATION_KEY, id, std::strlen(id));
+}
+
+uint32_t AutoplayOrchestratorTest::simulateBoot(const BootTimeline &timeline,
+                                                const bool &preopen) {
+    preopener = std::make_unique<SimulatedPreopener>(clock, timeline.openMs);
+    orchestrator = std::make_unique<AutoplayOrchestrator>(
+        *appController, *mockRepo, clock, &settings, preopen ? preopener.get() : nullptr,
+        appController.get());
+
+    ON_CALL(*mockPlayer, play(_)).WillByDefault([this, timeline](const char *url) {
+        const bool preopened = !preopener->urls.empty() && preopener->urls.back() == url;
+        const uint32_t delayMs = (preopened ? 0U : timeline.openMs) + timeline.prebufferMs;
+        playback->firstAudioUs = clock.nowUs() + delayMs * US_PER_MS;
+        ++plays;
+        return true;
+    });
+
+    const uint32_t wifiStartMs =
+        preopen ? timeline.wifiStartMs : std::max(timeline.wifiStartMs, timeline.controllerMs);
+    const uint64_t wifiUpUs = (wifiStartMs + timeline.wifiConnectMs) * US_PER_MS;
+    bool settingsLoaded = false;
+    bool stationsLoaded = false;
+    bool controllerReady = false;
+    bool playerReady = false;
+    bool online = false;
+
+    while (orchestrator->getState() != AutoplayOrchestrator::State::Done &&
+           clock.nowUs() < LIMIT_MS * US_PER_MS) {
+        const uint64_t nowUs = clock.nowUs();
+        if (!settingsLoaded && nowUs >= timeline.settingsMs * US_PER_MS) {
+            settingsLoaded = true;
+            orchestrator->onSettingsLoaded();
+        }
+        if (!stationsLoaded && nowUs >= timeline.stationsMs * US_PER_MS) {
+            stationsLoaded = true;
+            orchestrator->onStationsLoaded();
+        }
+        if (!controllerReady && nowUs >= timeline.controllerMs * US_PER_MS) {
+            controllerReady = true;
+            orchestrator->onControllerReady();
+        }
+        if (!playerReady && nowUs >= timeline.playerMs * US_PER_MS) {
+            playerReady = true;
+            appController->setPlayer(mockPlayer.get());
+            orchestrator->onPlayerReady(*playback);
+        }
+        if (!online && nowUs >= wifiUpUs) {
+            online = true;
+            orchestrator->onWifiStatus(common::UiStatusKind::WifiConnected, -55);
+        }
+
+        clock.advanceUs(orchestrator->poll() * US_PER_MS);
+    }
+
+    return static_cast<uint32_t>(orchestrator->getFirstAudioUs() / US_PER_MS);
+}
+
+TEST_F(AutoplayOrchestratorTest, poll_NetworkBeforePlayer_PreopenHidesTheOpen) {
+    // Arrange
+    BootTimeline timeline;
+
+    // Act
+    const uint32_t firstAudioMs = simulateBoot(timeline);
+
+    // Expect: the open overlapped the player bring-up, only its tail is left
+    const uint32_t onlineMs = timeline.wifiStartMs + timeline.wifiConnectMs;
+    const uint32_t expectedMs =
+        std::max(timeline.playerMs, onlineMs + timeline.openMs) + timeline.prebufferMs;
+    EXPECT_NEAR(expectedMs, firstAudioMs, TOLERANCE_MS);
+    EXPECT_EQ((std::vector<std::string>{"url2"}), preopener->urls);
+    EXPECT_EQ(1, plays);
+    EXPECT_EQ(1, appController->getModel().selectedStationIndex);
+    EXPECT_TRUE(appController->getModel().playing);
+}
+
+TEST_F(AutoplayOrchestratorTest, poll_PlayerBeforeNetwork_LeavesTheOpenToThePlayer) {
+    // Arrange
+    BootTimeline timeline;
+    timeline.playerMs = 400U;
+    timeline.wifiConnectMs = 2000U;
+
+    // Act
+    const uint32_t firstAudioMs = simulateBoot(timeline);
+
+    // Expect
+    const uint32_t onlineMs = timeline.wifiStartMs + timeline.wifiConnectMs;
+    EXPECT_NEAR(onlineMs + timeline.openMs + timeline.prebufferMs, firstAudioMs, TOLERANCE_MS);
+    EXPECT_TRUE(preopener->urls.empty());
+    EXPECT_EQ(1, plays);
+}
+
+TEST_F(AutoplayOrchestratorTest, poll_NoLastStation_FinishesWithoutPlaying) {
+    // Arrange
+    settings.erase(core::AppController::LAST_STATION_KEY);
+    EXPECT_CALL(*mockPlayer, play(_)).Times(0);
+
+    // Act
+    const uint32_t firstAudioMs = simulateBoot(BootTimeline());
+
+    // Expect: given up as soon as settings and stations were there
+    EXPECT_EQ(0U, firstAudioMs);
+    EXPECT_EQ(AutoplayOrchestrator::State::Done, orchestrator->getState());
+    EXPECT_LT(clock.nowUs(), BootTimeline().controllerMs * US_PER_MS);
+}
+
+TEST_F(AutoplayOrchestratorTest, poll_LastStationNoLongerListed_FinishesWithoutPlaying) {
+    // Arrange
+    rememberStation("gone");
+    EXPECT_CALL(*mockPlayer, play(_)).Times(0);
+
+    // Act
+    const uint32_t firstAudioMs = simulateBoot(BootTimeline());
+
+    // Expect
+    EXPECT_EQ(0U, firstAudioMs);
+    EXPECT_TRUE(preopener->urls.empty());
+}
+
+TEST_F(AutoplayOrchestratorTest, poll_UserPressedPlayFirst_DoesNotOverride) {
+    // Arrange: Play pressed on the first station while the player was still coming up
+    appController->onInput({common::InputEvent::Type::PlayStop});
+    EXPECT_CALL(*mockPlayer, play(_)).Times(0);
+
+    // Act
+    const uint32_t firstAudioMs = simulateBoot(BootTimeline());
+
+    // Expect
+    EXPECT_EQ(0U, firstAudioMs);
+    EXPECT_EQ(AutoplayOrchestrator::State::Done, orchestrator->getState());
+    EXPECT_EQ(0, appController->getModel().selectedStationIndex);
+}
+
+TEST_F(AutoplayOrchestratorTest, poll_NoAudioEver_GivesUpAfterTimeout) {
+    // Arrange
+    BootTimeline timeline;
+    ON_CALL(*mockPlayer, play(_)).WillByDefault([this](const char *) {
+        ++plays;
+        return true;
+    });
+    preopener = std::make_unique<SimulatedPreopener>(clock, timeline.openMs);
+    orchestrator = std::make_unique<AutoplayOrchestrator>(
+        *appController, *mockRepo, clock, &settings, preopener.get(), appController.get());
+    orchestrator->onSettingsLoaded();
+    orchestrator->onStationsLoaded();
+    orchestrator->onControllerReady();
+    appController->setPlayer(mockPlayer.get());
+    orchestrator->onPlayerReady(*playback);
+    orchestrator->onWifiStatus(common::UiStatusKind::WifiConnected, -55);
+
+    // Act
+    while (orchestrator->getState() != AutoplayOrchestrator::State::Done &&
+           clock.nowUs() < LIMIT_MS * US_PER_MS) {
+        clock.advanceUs(orchestrator->poll() * US_PER_MS);
+    }
+
+    // Expect
+    EXPECT_EQ(1, plays);
+    EXPECT_EQ(AutoplayOrchestrator::State::Done, orchestrator->getState());
+    EXPECT_EQ(0U, orchestrator->getFirstAudioUs());
+    EXPECT_GE(clock.nowUs(), AutoplayOrchestrator::FIRST_AUDIO_TIMEOUT_US);
+}
+
+TEST_F(AutoplayOrchestratorTest, onWifiStatus_BeforeController_HeldUntilItIsReady) {
+    // Arrange
+    RecordingWifiListener next;
+    AutoplayOrchestrator autoplay(*appController, *mockRepo, clock, &settings, nullptr, &next);
+    autoplay.onWifiStatus(common::UiStatusKind::WifiConnecting, 0);
+    autoplay.onWifiStatus(common::UiStatusKind::WifiConnected, -48);
+    ASSERT_TRUE(next.kinds.empty());
+
+    // Act
+    autoplay.onControllerReady();
+    autoplay.onWifiStatus(common::UiStatusKind::WifiError, 0);
+
+    // Expect: only the latest held status is replayed, later ones pass straight through
+    EXPECT_EQ((std::vector<common::UiStatusKind>{common::UiStatusKind::WifiConnected,
+                                                 common::UiStatusKind::WifiError}),
+              next.kinds);
+}
+
+TEST_F(AutoplayOrchestratorTest, Benchmark_BootToFirstAudio) {
+    // Arrange
+    const BootTimeline timeline;
+
+    // Act
+    const uint32_t serializedMs = simulateBoot(timeline, false);
+    clock.setUs(0U);
+    appController = std::make_unique<core::AppController>(*mockUiTask, *mockRepo);
+    const uint32_t orchestratedMs = simulateBoot(timeline);
+
+    // Expect
+    std::printf("[ AUTOPLAY ] boot to first audio: %u ms serialized, %u ms orchestrated\n",
+                serializedMs, orchestratedMs);
+    EXPECT_GT(serializedMs, 0U);
+    EXPECT_LT(orchestratedMs + timeline.openMs / 2U, serializedMs);
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AppController.hpp"
+#include "AutoplayOrchestrator.hpp"
+#include "FakeClock.hpp"
+#include "FakeKeyValueStore.hpp"
+#include "IPlaybackStatus.hpp"
+#include "IStreamPreopener.hpp"
+#include "MockPlayerControl.hpp"
+#include "MockStationRepository.hpp"
+#include "MockUiTask.hpp"
+#include "UiTypes.hpp"
+
+// Milliseconds since boot at which each stage finishes, and how long the network side takes.
+// The defaults are rough figures from the board: the radio is the slowest part of boot.
+struct BootTimeline {
+    uint32_t settingsMs = 40U;
+    uint32_t stationsMs = 60U;
+    uint32_t controllerMs = 300U;
+    uint32_t playerMs = 1500U;
+    uint32_t wifiStartMs = 40U;      // after NVS
+    uint32_t wifiConnectMs = 900U;   // association plus IP
+    uint32_t openMs = 700U;          // DNS, TCP, TLS, redirects and the response head
+    uint32_t prebufferMs = 250U;     // to the start watermark and the first sample
+};
+
+// Opening takes the time of the timeline on the calling task
+class SimulatedPreopener : public player::IStreamPreopener {
+   public:
+    SimulatedPreopener(common::FakeClock &clock, const uint32_t &openMs)
+        : mClock(clock), mOpenMs(openMs) {}
+
+    bool preopen(const char *url) override {
+        mClock.advanceUs(mOpenMs * 1000U);
+        urls.push_back(url);
+        return true;
+    }
+
+    std::vector<std::string> urls;
+
+   private:
+    common::FakeClock &mClock;
+    uint32_t mOpenMs;
+};
+
+// First sample lands one open plus prebuffering after play(), or just the prebuffering when
+// the URL was pre-opened
+class SimulatedPlayback : public player::IPlaybackStatus {
+   public:
+    explicit SimulatedPlayback(const common::FakeClock &clock) : mClock(clock) {}
+
+    int64_t getFirstAudioUs() const override {
+        const bool played = firstAudioUs > 0 && mClock.nowUs() >= firstAudioUs;
+        return played ? static_cast<int64_t>(firstAudioUs) : 0;
+    }
+
+    uint64_t firstAudioUs = 0U;
+
+   private:
+    const common::FakeClock &mClock;
+};
+
+class RecordingWifiListener : public net::IWifiListener {
+   public:
+    void onWifiStatus(const common::UiStatusKind &kind, const int8_t &rssiDbm) override {
+        kinds.push_back(kind);
+        lastRssiDbm = rssiDbm;
+    }
+
+    std::vector<common::UiStatusKind> kinds;
+    int8_t lastRssiDbm = 0;
+};
+
+class AutoplayOrchestratorTest : public ::testing::Test {
+   protected:
+    static constexpr uint32_t LIMIT_MS = 120000U;
+
+    void SetUp() override;
+    void TearDown() override;
+
+    // Steps a boot along the timeline the way the autoplay task would, firing each boot
+    // hook when its time comes. Returns the boot-to-first-audio time in ms, 0 when nothing
+    // played. Without preopening the Wi-Fi stage is expected to wait for the controller, as
+    // it did before autoplay existed.
+    uint32_t simulateBoot(const BootTimeline &timeline, const bool &preopen = true);
+    void rememberStation(const char *id);
+
+    common::FakeClock clock;
+    common::FakeKeyValueStore settings;
+    std::unique_ptr<::testing::NiceMock<core::MockUiTask>> mockUiTask;
+    std::unique_ptr<::testing::NiceMock<services::MockStationRepository>> mockRepo;
+    std::unique_ptr<::testing::NiceMock<player::MockPlayerControl>> mockPlayer;
+    std::unique_ptr<core::AppController> appController;
+    std::unique_ptr<SimulatedPreopener> preopener;
+    std::unique_ptr<SimulatedPlayback> playback;
+    std::unique_ptr<core::AutoplayOrchestrator> orchestrator;
+
+    std::vector<common::StationData> stations;
+    int plays = 0;
+};
@@ -0,0 +1,163 @@
+#include "BootSequencerTest.hpp"
+
+#include <vector>
+
+using core::BootSequencer;
+using core::StageId;
+using core::StageState;
+
+static constexpr uint64_t I2C_US = 2000U;
+static constexpr uint64_t DISPLAY_US = 30000U;
+static constexpr uint64_t STATIONS_US = 50000U;
+static constexpr uint64_t UI_US = 25000U;
+static constexpr uint64_t UI_TASK_US = 1000U;
+static constexpr uint64_t CONTROLLER_US = 500U;
+
+void BootSequencerTest::SetUp() {
+    executor = std::make_unique<core::FakeStageExecutor>(clock);
+    sequencer = std::make_unique<core::BootSequencer>(*executor, clock);
+
+    executor->setDurationUs("i2c", I2C_US);
+    executor->setDurationUs("display", DISPLAY_US);
+    executor->setDurationUs("stations", STATIONS_US);
+    executor->setDurationUs("ui", UI_US);
+    executor->setDurationUs("ui_task", UI_TASK_US);
+    executor->setDurationUs("controller", CONTROLLER_US);
+}
+
+void BootSequencerTest::TearDown() {
+    sequencer.reset();
+    executor.reset();
+}
+
+void BootSequencerTest::addAppStages() {
+    const StageId i2c = sequencer->addStage("i2c", [] { return true; });
+    const StageId display =
+        sequencer->addStage("display", [] { return true; }, BootSequencer::after(i2c));
+    const StageId stations = sequencer->addStage("stations", [] { return true; });
+    const StageId ui = sequencer->addStage("ui", [] { return true; }, BootSequencer::after(display),
+                                           BootSequencer::FLAG_FIRST_FRAME);
+    const StageId uiTask =
+        sequencer->addStage("ui_task", [] { return true; }, BootSequencer::after(ui));
+    sequencer->addStage("controller", [] { return true; },
+                        BootSequencer::after(uiTask) | BootSequencer::after(stations),
+                        BootSequencer::FLAG_USABLE_UI);
+}
+
+TEST_F(BootSequencerTest, run_IndependentStagesOverlap) {
+    // Arrange
+    addAppStages();
+
+    // Act
+    ASSERT_TRUE(sequencer->run());
+
+    // Expect
+    // stations (50 ms) is hidden behind i2c + display + ui (57 ms)
+    const uint64_t criticalPathUs = I2C_US + DISPLAY_US + UI_US + UI_TASK_US + CONTROLLER_US;
+    EXPECT_EQ(criticalPathUs, sequencer->getBootEndUs() - sequencer->getBootStartUs());
+    EXPECT_EQ(0U, sequencer->getStage(2).startUs);
+    EXPECT_GE(executor->getMaxConcurrent(), 2U);
+}
+
+TEST_F(BootSequencerTest, run_ReportsMilestones) {
+    // Arrange
+    clock.setUs(100000U);  // boot does not start at t=0 on target either
+    addAppStages();
+
+    // Act
+    ASSERT_TRUE(sequencer->run());
+    sequencer->logTimeline();
+
+    // Expect
+    EXPECT_EQ(100000U + I2C_US + DISPLAY_US + UI_US,
+              sequencer->getMilestoneUs(BootSequencer::FLAG_FIRST_FRAME));
+    EXPECT_EQ(sequencer->getBootEndUs(), sequencer->getMilestoneUs(BootSequencer::FLAG_USABLE_UI));
+}
+
+TEST_F(BootSequencerTest, run_StageStartsOnlyAfterAllDependencies) {
+    // Arrange
+    executor->setDurationUs("stations", 200000U);  // now on the critical path
+    addAppStages();
+
+    // Act
+    ASSERT_TRUE(sequencer->run());
+
+    // Expect
+    const auto& controller = sequencer->getStage(5);
+    EXPECT_EQ(200000U, controller.startUs);
+    EXPECT_EQ(200000U + CONTROLLER_US, controller.endUs);
+}
+
+TEST_F(BootSequencerTest, run_FailedStageSkipsDependents) {
+    // Arrange
+    std::vector<const char*> executed;
+    const StageId i2c = sequencer->addStage("i2c", [&executed] {
+        executed.push_back("i2c");
+        return false;
+    });
+    const StageId display = sequencer->addStage(
+        "display",
+        [&executed] {
+            executed.push_back("display");
+            return true;
+        },
+        BootSequencer::after(i2c));
+    sequencer->addStage("stations", [&executed] {
+        executed.push_back("stations");
+        return true;
+    });
+    sequencer->addStage("ui", [] { return true; }, BootSequencer::after(display),
+                        BootSequencer::FLAG_FIRST_FRAME);
+
+    // Act
+    EXPECT_FALSE(sequencer->run());
+
+    // Expect
+    EXPECT_EQ(2U, executed.size());
+    EXPECT_EQ(StageState::Failed, sequencer->getStage(0).state);
+    EXPECT_EQ(StageState::Skipped, sequencer->getStage(1).state);
+    EXPECT_EQ(StageState::Done, sequencer->getStage(2).state);
+    EXPECT_EQ(StageState::Skipped, sequencer->getStage(3).state);
+    EXPECT_EQ(0U, sequencer->getMilestoneUs(BootSequencer::FLAG_FIRST_FRAME));
+}
+
+TEST_F(BootSequencerTest, addStage_RejectsForwardDependency) {
+    // Act
+    const StageId id = sequencer->addStage("orphan", [] { return true; }, BootSequencer::after(3));
+
+    // Expect
+    EXPECT_EQ(BootSequencer::INVALID_STAGE, id);
+    EXPECT_EQ(0U, sequencer->getStageCount());
+}
+
+TEST_F(BootSequencerTest, addStage_TooManyStages_RejectsDependantsAndRefusesToRun) {
+    // Arrange: fill the table, so the next stage is dropped
+    for (size_t i = 0; i < BootSequencer::MAX_STAGES; ++i) {
+        sequencer->addStage("filler", [] { return true; });
+    }
+
+    // Act
+    const StageId dropped = sequencer->addStage("dropped", [] { return true; });
+    const uint32_t mask = BootSequencer::after(dropped);
+
+    // Expect: nothing depending on the dropped stage is taken, and nothing boots
+    EXPECT_EQ(BootSequencer::INVALID_STAGE, dropped);
+    EXPECT_EQ(0U, mask & ((1U << BootSequencer::MAX_STAGES) - 1U));
+    EXPECT_FALSE(sequencer->run());
+    EXPECT_EQ(StageState::Pending, sequencer->getStage(0).state);
+}
+
+TEST_F(BootSequencerTest, after_InvalidStage_IsNeverSatisfied) {
+    // Arrange
+    const StageId first = sequencer->addStage("first", [] { return true; });
+
+    // Act
+    const StageId orphan = sequencer->addStage("orphan", [] { return true; },
+                                               BootSequencer::after(BootSequencer::INVALID_STAGE));
+
+    // Expect
+    EXPECT_EQ(0U, first);
+    EXPECT_EQ(BootSequencer::INVALID_STAGE, orphan);
+    EXPECT_EQ(1U, sequencer->getStageCount());
+    EXPECT_FALSE(sequencer->run());
+}
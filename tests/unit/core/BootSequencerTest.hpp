@@ -0,0 +1,22 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "BootSequencer.hpp"
+#include "FakeClock.hpp"
+#include "FakeStageExecutor.hpp"
+
+class BootSequencerTest : public ::testing::Test {
+   protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    // Mirrors the stage graph declared in AppContext::init()
+    void addAppStages();
+
+    common::FakeClock clock;
+    std::unique_ptr<core::FakeStageExecutor> executor;
+    std::unique_ptr<core::BootSequencer> sequencer;
+};
@@ -0,0 +1,106 @@
+#include "UiTaskTest.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "AllocationCounter.hpp"
+#include "UiTypes.hpp"
+
+void UiTaskTest::SetUp() {
+    std::vector<common::StationData> stations;
+    for (int i = 0; i < 20; ++i) {
+        const std::string n = std::to_string(i);
+        stations.push_back({"id" + n, "Station " + n, "url" + n});
+    }
+    repo = std::make_unique<services::FakeStationRepository>(std::move(stations));
+    oled = std::make_unique<adapters::BoardOledDisplay>(bus);
+    uiService = std::make_unique<services::UiService>(*oled, *repo);
+    uiTask = std::make_unique<core::UiTask>(*uiService);
+
+    ASSERT_TRUE(oled->init());
+    ASSERT_TRUE(uiService->init());
+    ASSERT_TRUE(uiTask->init());
+}
+
+void UiTaskTest::TearDown() {
+    uiTask.reset();
+    uiService.reset();
+    oled.reset();
+    repo.reset();
+}
+
+TEST_F(UiTaskTest, processNext_PostedEvents_HandledInOrder) {
+    // Arrange
+    common::UiEvent first;
+    first.type = common::UiEvent::Type::RENDER_STATIONS;
+    first.selectedIndex = 3;
+    common::UiEvent second = first;
+    second.selectedIndex = 4;
+    uiTask->post(first);
+    uiTask->post(second);
+    bus.resetCounters();
+
+    // Act & Expect: one event per pass, then nothing left to do
+    EXPECT_TRUE(uiTask->processNext(0));
+    EXPECT_GT(bus.getTransactions(), 0U);
+    EXPECT_TRUE(uiTask->processNext(0));
+    bus.resetCounters();
+    EXPECT_FALSE(uiTask->processNext(0));
+    EXPECT_EQ(0U, bus.getTransactions());
+}
+
+TEST_F(UiTaskTest, tryPost_QueueFull_DropsWithoutWaiting) {
+    // Arrange: the UI task has fallen behind
+    common::UiEvent stations;
+    stations.type = common::UiEvent::Type::RENDER_STATIONS;
+    for (int i = 0; i < 5; ++i) {
+        uiTask->post(stations);
+    }
+    common::UiEvent frame;
+    frame.type = common::UiEvent::Type::RENDER_SPECTRUM;
+
+    // Act
+    const bool whileFull = uiTask->tryPost(frame);
+    ASSERT_TRUE(uiTask->processNext(0));
+    const bool withRoom = uiTask->tryPost(frame);
+
+    // Expect
+    EXPECT_FALSE(whileFull);
+    EXPECT_TRUE(withRoom);
+}
+
+TEST_F(UiTaskTest, processNext_SteadyState_NoHeapAllocations) {
+    // Arrange: what the controller and the sensors post while a station plays
+    std::vector<common::UiEvent> events(5);
+    events[0].type = common::UiEvent::Type::RENDER_STATIONS;
+    events[1].type = common::UiEvent::Type::RENDER_STATUS;
+    events[1].status.playback = common::PlaybackState::Playing;
+    events[2].type = common::UiEvent::Type::RENDER_SPECTRUM;
+    events[3].type = common::UiEvent::Type::RENDER_VOLUME;
+    events[4].type = common::UiEvent::Type::SHOW_TOAST;
+    std::snprintf(events[4].text.data(), events[4].text.size(), "Saved");
+
+    const auto dispatch = [&](const int &rounds) {
+        for (int round = 0; round < rounds; ++round) {
+            events[0].selectedIndex = round % 20;
+            events[2].spectrum.fill(static_cast<uint8_t>(round * 12));
+            events[3].volume = round;
+            for (const common::UiEvent &event : events) {
+                uiTask->post(event);
+            }
+            while (uiTask->processNext(0)) {
+            }
+        }
+    };
+    dispatch(20);
+
+    // Act
+    AllocationCounter allocations;
+    dispatch(40);
+    const size_t count = allocations.count();
+    const size_t bytes = allocations.bytes();
+
+    // Expect
+    EXPECT_EQ(0U, count) << bytes << " bytes";
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "FakeOledBus.hpp"
+#include "FakeStationRepository.hpp"
+#include "OledDisplay.hpp"
+#include "UiService.hpp"
+#include "UiTask.hpp"
+
+// The UI task with its real service, driver and a decoding bus behind it. The host queue
+// never blocks and the task is never started, the tests run the loop with processNext().
+class UiTaskTest : public ::testing::Test {
+   protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    adapters::FakeOledBus<common::BoardOledPanel> bus;
+    std::unique_ptr<adapters::BoardOledDisplay> oled;
+    std::unique_ptr<services::FakeStationRepository> repo;
+    std::unique_ptr<services::UiService> uiService;
+    std::unique_ptr<core::UiTask> uiTask;
+};
@@ -0,0 +1,163 @@
+#include "MemoryTest.hpp"
+
+#include <string>
+
+#include "Metrics.hpp"
+
+// IDF
+#include <esp_heap_caps.h>
+#include <esp_memory_utils.h>
+
+using memory::MemoryClass;
+
+void MemoryTest::SetUp() {
+    fake_heap::reset(INTERNAL_BYTES, PSRAM_BYTES);
+    for (size_t i = 0U; i < memory::CLASS_COUNT; ++i) {
+        mStart[i] = memory::stats(static_cast<MemoryClass>(i));
+    }
+}
+
+void MemoryTest::TearDown() {
+    fake_heap::reset(fake_heap::DEFAULT_INTERNAL, fake_heap::DEFAULT_SPIRAM);
+}
+
+memory::ClassStats MemoryTest::before(const MemoryClass &memoryClass) const {
+    return mStart[static_cast<size_t>(memoryClass)];
+}
+
+TEST_F(MemoryTest, allocate_Psram_LandsInPsramAndIsTracked) {
+    // Act
+    void *ptr = memory::allocate(MemoryClass::Psram, 4096U);
+    const bool external = esp_ptr_external_ram(ptr);
+    const memory::ClassStats during = memory::stats(MemoryClass::Psram);
+    memory::release(ptr, MemoryClass::Psram, 4096U);
+    const memory::ClassStats after = memory::stats(MemoryClass::Psram);
+
+    // Expect
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_TRUE(external);
+    EXPECT_EQ(before(MemoryClass::Psram).inUseBytes + 4096U, during.inUseBytes);
+    EXPECT_EQ(PSRAM_BYTES - 4096U, during.freeBytes);
+    EXPECT_EQ(before(MemoryClass::Psram).allocations + 1U, during.allocations);
+    EXPECT_EQ(before(MemoryClass::Psram).inUseBytes, after.inUseBytes);
+    EXPECT_GE(after.peakBytes, 4096U);
+    EXPECT_EQ(PSRAM_BYTES - 4096U, after.minFreeBytes);
+}
+
+TEST_F(MemoryTest, allocate_NoPsram_FallsBackToInternal) {
+    // Arrange: a board without PSRAM
+    fake_heap::reset(INTERNAL_BYTES, 0U);
+
+    // Act
+    void *ptr = memory::allocate(MemoryClass::Psram, 1024U);
+    const bool external = esp_ptr_external_ram(ptr);
+    const memory::ClassStats internal = memory::stats(MemoryClass::Internal);
+    const memory::ClassStats psram = memory::stats(MemoryClass::Psram);
+    memory::release(ptr, MemoryClass::Psram, 1024U);
+
+    // Expect: counted where the bytes went, and released from there
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_FALSE(external);
+    EXPECT_EQ(before(MemoryClass::Psram).fallbacks + 1U, psram.fallbacks);
+    EXPECT_EQ(before(MemoryClass::Psram).inUseBytes, psram.inUseBytes);
+    EXPECT_EQ(before(MemoryClass::Internal).inUseBytes + 1024U, internal.inUseBytes);
+    EXPECT_EQ(before(MemoryClass::Internal).inUseBytes,
+              memory::stats(MemoryClass::Internal).inUseBytes);
+}
+
+TEST_F(MemoryTest, allocate_DmaExhausted_FailsWithoutTouchingPsram) {
+    // Act
+    void *ptr = memory::allocate(MemoryClass::Dma, INTERNAL_BYTES + 1U);
+
+    // Expect: DMA buffers never land in PSRAM
+    EXPECT_EQ(nullptr, ptr);
+    EXPECT_EQ(before(MemoryClass::Dma).failures + 1U, memory::stats(MemoryClass::Dma).failures);
+    EXPECT_EQ(PSRAM_BYTES, memory::stats(MemoryClass::Psram).freeBytes);
+}
+
+TEST_F(MemoryTest, allocate_ZeroBytes_IsNeitherAnAllocationNorAFailure) {
+    // Act
+    void *ptr = memory::allocate(MemoryClass::Internal, 0U);
+
+    // Expect
+    EXPECT_EQ(nullptr, ptr);
+    EXPECT_EQ(before(MemoryClass::Internal).allocations,
+              memory::stats(MemoryClass::Internal).allocations);
+    EXPECT_EQ(before(MemoryClass::Internal).failures,
+              memory::stats(MemoryClass::Internal).failures);
+}
+
+TEST_F(MemoryTest, PsramVector_GrowsInPsramAndGivesEverythingBack) {
+    {
+        // Act
+        memory::PsramVector<int32_t> values;
+        for (int32_t i = 0; i < 1000; ++i) {
+            values.push_back(i);
+        }
+
+        // Expect
+        EXPECT_TRUE(esp_ptr_external_ram(values.data()));
+        EXPECT_GE(memory::stats(MemoryClass::Psram).inUseBytes,
+                  before(MemoryClass::Psram).inUseBytes + 1000U * sizeof(int32_t));
+        EXPECT_EQ(999, values.back());
+    }
+
+    EXPECT_EQ(before(MemoryClass::Psram).inUseBytes,
+              memory::stats(MemoryClass::Psram).inUseBytes);
+    EXPECT_EQ(0U, fake_heap::spiram().blocks.size());
+}
+
+TEST_F(MemoryTest, PsramString_BeyondSmallBuffer_LivesInPsram) {
+    // Act
+    const memory::PsramString url(
+        "https://playerservices.streamtheworld.com/api/livestream-redirect/RADIO_1AAC_H.aac");
+
+    // Expect
+    EXPECT_TRUE(esp_ptr_external_ram(url.data()));
+    EXPECT_EQ(std::string(url.c_str()), url.c_str());
+}
+
+TEST_F(MemoryTest, makeBuffer_ZeroedAndReleasedWithItsOwner) {
+    {
+        // Act
+        memory::Buffer<int16_t, MemoryClass::Internal> buffer =
+            memory::makeBuffer<int16_t, MemoryClass::Internal>(512U);
+
+        // Expect
+        ASSERT_NE(nullptr, buffer);
+        EXPECT_EQ(0, buffer[0]);
+        EXPECT_EQ(0, buffer[511]);
+        EXPECT_EQ(before(MemoryClass::Internal).inUseBytes + 1024U,
+                  memory::stats(MemoryClass::Internal).inUseBytes);
+    }
+
+    EXPECT_EQ(before(MemoryClass::Internal).inUseBytes,
+              memory::stats(MemoryClass::Internal).inUseBytes);
+}
+
+TEST_F(MemoryTest, makeBuffer_Exhausted_ReturnsEmpty) {
+    // Act
+    const memory::Buffer<uint8_t, MemoryClass::Dma> buffer =
+        memory::makeBuffer<uint8_t, MemoryClass::Dma>(INTERNAL_BYTES * 2U);
+
+    // Expect
+    EXPECT_EQ(nullptr, buffer);
+}
+
+TEST_F(MemoryTest, sample_FragmentedHeap_PublishesLargestBlockShare) {
+    // Arrange: 64 KB free, but no piece bigger than 16 KB
+    fake_heap::internal().largestLimit = 16U * 1024U;
+
+    // Act
+    memory::sample();
+    const memory::ClassStats internal = memory::stats(MemoryClass::Internal);
+
+    // Expect
+    EXPECT_EQ(750U, internal.fragmentationPermille());
+    const metrics::Gauge *gauge =
+        metrics::Registry::instance().findGauge("mem.internal_frag_permille");
+    ASSERT_NE(nullptr, gauge);
+    EXPECT_EQ(750, gauge->value());
+    EXPECT_EQ(nullptr, memory::allocate(MemoryClass::Internal, 20U * 1024U));
+    memory::logSummary();
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Memory.hpp"
+#include "gtest/gtest.h"
+
+class MemoryTest : public ::testing::Test {
+   protected:
+    static constexpr size_t INTERNAL_BYTES = 64U * 1024U;
+    static constexpr size_t PSRAM_BYTES = 256U * 1024U;
+
+    void SetUp() override;
+    void TearDown() override;
+
+    // Counters are process-wide, tests compare against where they started
+    memory::ClassStats before(const memory::MemoryClass &memoryClass) const;
+
+    memory::ClassStats mStart[memory::CLASS_COUNT];
+};
@@ -0,0 +1,185 @@
+#include "MetricsTest.hpp"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+static constexpr std::array<uint32_t, 4> BOUNDS = {10U, 20U, 50U, 100U};
+static constexpr size_t THREADS = 4U;
+static constexpr uint32_t UPDATES_PER_THREAD = 50000U;
+
+void MetricsTest::SetUp() {}
+
+void MetricsTest::TearDown() {}
+
+TEST_F(MetricsTest, histogram_BucketsValuesByInclusiveUpperBound) {
+    // Arrange
+    static metrics::Histogram histogram("test.buckets", BOUNDS);
+
+    // Act
+    for (const uint32_t value : {0U, 10U, 11U, 20U, 21U, 50U, 99U, 100U, 101U, 5000U}) {
+        histogram.record(value);
+    }
+
+    // Expect
+    const auto snap = histogram.snapshot();
+    EXPECT_EQ(10U, snap.count);
+    EXPECT_EQ(2U, snap.counts[0]);  // <= 10
+    EXPECT_EQ(2U, snap.counts[1]);  // <= 20
+    EXPECT_EQ(2U, snap.counts[2]);  // <= 50
+    EXPECT_EQ(2U, snap.counts[3]);  // <= 100
+    EXPECT_EQ(2U, snap.counts[4]);  // overflow
+    EXPECT_EQ(5000U, snap.max);
+    EXPECT_EQ(5412U, snap.sum);
+}
+
+TEST_F(MetricsTest, histogram_PercentilesStayWithinBucketResolution) {
+    // Arrange
+    static metrics::Histogram histogram("test.percentiles", metrics::LATENCY_BUCKETS_US);
+
+    // Act: uniform 1..10000 us
+    for (uint32_t value = 1U; value <= 10000U; ++value) {
+        histogram.record(value);
+    }
+
+    // Expect
+    const auto snap = histogram.snapshot();
+    EXPECT_EQ(5000U, snap.mean());
+    EXPECT_EQ(10000U, snap.max);
+    // p50 falls into the (2500, 5000] bucket, p90/p99 into (5000, 10000]
+    EXPECT_NEAR(5000.0, snap.percentile(50U), 2500.0 * 0.01);
+    EXPECT_NEAR(9000.0, snap.percentile(90U), 5000.0 * 0.01);
+    EXPECT_NEAR(9900.0, snap.percentile(99U), 5000.0 * 0.01);
+    EXPECT_EQ(10000U, snap.percentile(100U));
+}
+
+TEST_F(MetricsTest, histogram_PercentileOfEmptyIsZero) {
+    // Arrange
+    static metrics::Histogram histogram("test.empty", BOUNDS);
+
+    // Expect
+    EXPECT_EQ(0U, histogram.snapshot().percentile(50U));
+}
+
+TEST_F(MetricsTest, histogram_ConcurrentRecordsAreNotLost) {
+    // Arrange
+    static metrics::Histogram histogram("test.concurrent", BOUNDS);
+    std::vector<std::thread> threads;
+
+    // Act
+    for (size_t t = 0U; t < THREADS; ++t) {
+        threads.emplace_back([t] {
+            for (uint32_t i = 0U; i < UPDATES_PER_THREAD; ++i) {
+                histogram.record(static_cast<uint32_t>(t) * 30U);  // 0, 30, 60, 90
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Expect
+    const auto snap = histogram.snapshot();
+    EXPECT_EQ(THREADS * UPDATES_PER_THREAD, snap.count);
+    EXPECT_EQ(UPDATES_PER_THREAD, snap.counts[0]);
+    EXPECT_EQ(0U, snap.counts[1]);
+    EXPECT_EQ(UPDATES_PER_THREAD, snap.counts[2]);
+    EXPECT_EQ(2U * UPDATES_PER_THREAD, snap.counts[3]);
+    EXPECT_EQ((0U + 30U + 60U + 90U) * UPDATES_PER_THREAD, snap.sum);
+    EXPECT_EQ(90U, snap.max);
+}
+
+TEST_F(MetricsTest, counterAndGauge_ConcurrentUpdates) {
+    // Arrange
+    static metrics::Counter counter("test.counter");
+    static metrics::Gauge gauge("test.gauge");
+    std::vector<std::thread> threads;
+
+    // Act
+    for (size_t t = 0U; t < THREADS; ++t) {
+        threads.emplace_back([t] {
+            for (uint32_t i = 0U; i < UPDATES_PER_THREAD; ++i) {
+                counter.add();
+                gauge.set(static_cast<int32_t>((i % 100U) + t));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Expect
+    EXPECT_EQ(THREADS * UPDATES_PER_THREAD, counter.value());
+    EXPECT_EQ(static_cast<int32_t>(99U + THREADS - 1U), gauge.max());
+}
+
+TEST_F(MetricsTest, registry_FindsSelfRegisteredMetrics) {
+    // Arrange
+    static metrics::Counter counter("test.registry.counter");
+    static metrics::Gauge gauge;
+    gauge.bind("test.registry.gauge");
+
+    // Act
+    counter.add(3U);
+    gauge.set(7);
+
+    // Expect
+    ASSERT_NE(nullptr, registry.findCounter("test.registry.counter"));
+    EXPECT_EQ(3U, registry.findCounter("test.registry.counter")->value());
+    ASSERT_NE(nullptr, registry.findGauge("test.registry.gauge"));
+    EXPECT_EQ(7, registry.findGauge("test.registry.gauge")->value());
+    EXPECT_EQ(nullptr, registry.findHistogram("test.registry.counter"));
+}
+
+TEST_F(MetricsTest, bind_AlreadyNamed_IsRefused) {
+    // Arrange
+    static metrics::Gauge gauge("test.bind.first");
+
+    // Act
+    const bool rebound = gauge.bind("test.bind.second");
+
+    // Expect
+    EXPECT_FALSE(rebound);
+    EXPECT_STREQ("test.bind.first", gauge.name());
+    EXPECT_EQ(nullptr, registry.findGauge("test.bind.second"));
+}
+
+TEST_F(MetricsTest, histogram_SumBeyond32Bits_KeepsTheMean) {
+    // Arrange
+    static metrics::Histogram histogram("test.long_run", metrics::LATENCY_BUCKETS_US);
+
+    // Act: 5000 records of 4 s, 20000 s in total
+    for (uint32_t i = 0U; i < 5000U; ++i) {
+        histogram.record(4000000U);
+    }
+
+    // Expect
+    const auto snap = histogram.snapshot();
+    EXPECT_EQ(20000000000ULL, snap.sum);
+    EXPECT_EQ(4000000U, snap.mean());
+}
+
+TEST_F(MetricsTest, print_LargestValues_LineIsNotTruncated) {
+    // Arrange: every field of the histogram line at its widest
+    static metrics::Histogram histogram("test.widest_histogram", BOUNDS);
+    histogram.record(UINT32_MAX);
+    histogram.record(UINT32_MAX);
+    FILE* out = std::tmpfile();
+
+    // Act
+    registry.print(out);
+
+    // Expect
+    std::rewind(out);
+    std::string line;
+    char buffer[256];
+    while (std::fgets(buffer, sizeof(buffer), out) != nullptr) {
+        if (std::string(buffer).rfind("test.widest_histogram", 0) == 0) {
+            line = buffer;
+        }
+    }
+    std::fclose(out);
+    ASSERT_FALSE(line.empty());
+    EXPECT_NE(std::string::npos, line.find("max=4294967295\n")) << line;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "Metrics.hpp"
+
+class MetricsTest : public ::testing::Test {
+   protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    // Metrics register themselves globally: tests use static metrics with unique names
+    metrics::Registry& registry = metrics::Registry::instance();
+};
@@ -0,0 +1,106 @@
+#include "DnsCacheTest.hpp"
+
+#include <string>
+
+#include "Metrics.hpp"
+
+using net::DnsCache;
+
+static uint32_t counterValue(const char *name) {
+    const metrics::Counter *counter = metrics::Registry::instance().findCounter(name);
+    return (counter != nullptr) ? counter->value() : 0U;
+}
+
+void DnsCacheTest::SetUp() {
+    resolver = std::make_unique<net::FakeDnsResolver>();
+    resolver->setRecord(HOST, "10.0.0.7");
+    cache = std::make_unique<DnsCache>(*resolver, TTL_US);
+}
+
+void DnsCacheTest::TearDown() {
+    cache.reset();
+    resolver.reset();
+}
+
+TEST_F(DnsCacheTest, resolve_WithinTtl_AsksResolverOnce) {
+    // Arrange
+    const uint32_t hits = counterValue("net.dns_hits");
+    const uint32_t misses = counterValue("net.dns_misses");
+
+    // Act
+    const bool first = cache->resolve(HOST, 0, address);
+    const bool second = cache->resolve(HOST, TTL_US - 1, address);
+
+    // Expect
+    EXPECT_TRUE(first);
+    EXPECT_TRUE(second);
+    EXPECT_STREQ("10.0.0.7", address.data());
+    EXPECT_EQ(1, resolver->lookups());
+    EXPECT_EQ(hits + 1U, counterValue("net.dns_hits"));
+    EXPECT_EQ(misses + 1U, counterValue("net.dns_misses"));
+}
+
+TEST_F(DnsCacheTest, resolve_Expired_AsksAgainAndTakesNewAddress) {
+    // Arrange
+    cache->resolve(HOST, 0, address);
+    resolver->setRecord(HOST, "10.0.0.8");
+
+    // Act
+    const bool found = cache->resolve(HOST, TTL_US, address);
+
+    // Expect
+    EXPECT_TRUE(found);
+    EXPECT_STREQ("10.0.0.8", address.data());
+    EXPECT_EQ(2, resolver->lookups());
+    EXPECT_EQ(1U, cache->size());
+}
+
+TEST_F(DnsCacheTest, resolve_Numeric_SkipsResolverAndCache) {
+    // Act
+    const bool found = cache->resolve("192.168.1.20", 0, address);
+
+    // Expect
+    EXPECT_TRUE(found);
+    EXPECT_STREQ("192.168.1.20", address.data());
+    EXPECT_EQ(0, resolver->lookups());
+    EXPECT_EQ(0U, cache->size());
+}
+
+TEST_F(DnsCacheTest, resolve_Unknown_FailsAndCachesNothing) {
+    // Act
+    const bool found = cache->resolve("nowhere.example", 0, address);
+
+    // Expect
+    EXPECT_FALSE(found);
+    EXPECT_EQ(0U, cache->size());
+}
+
+TEST_F(DnsCacheTest, forget_AfterConnectFailure_NextResolveAsksAgain) {
+    // Arrange
+    cache->resolve(HOST, 0, address);
+
+    // Act
+    cache->forget(HOST);
+    cache->resolve(HOST, 1000, address);
+
+    // Expect
+    EXPECT_EQ(2, resolver->lookups());
+}
+
+TEST_F(DnsCacheTest, resolve_Full_EvictsTheEntryClosestToExpiry) {
+    // Arrange: one more host than fits, the first one resolved expires first
+    for (size_t i = 0U; i <= DnsCache::MAX_ENTRIES; ++i) {
+        const std::string host = "host" + std::to_string(i) + ".example";
+        resolver->setRecord(host, "10.0.1." + std::to_string(i));
+        cache->resolve(host.c_str(), static_cast<int64_t>(i), address);
+    }
+
+    // Act
+    const int before = resolver->lookups();
+    cache->resolve("host0.example", 100, address);
+    cache->resolve("host8.example", 100, address);
+
+    // Expect
+    EXPECT_EQ(DnsCache::MAX_ENTRIES, cache->size());
+    EXPECT_EQ(before + 1, resolver->lookups());
+}
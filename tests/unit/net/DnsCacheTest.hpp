@@ -0,0 +1,20 @@
+#pragma once
+
+#include <memory>
+
+#include "DnsCache.hpp"
+#include "FakeDnsResolver.hpp"
+#include "gtest/gtest.h"
+
+class DnsCacheTest : public ::testing::Test {
+   protected:
+    static constexpr int64_t TTL_US = 60000000;
+    static constexpr const char *HOST = "stream.example";
+
+    void SetUp() override;
+    void TearDown() override;
+
+    std::unique_ptr<net::FakeDnsResolver> resolver;
+    std::unique_ptr<net::DnsCache> cache;
+    net::IpAddress address{};
+};
@@ -0,0 +1,202 @@
+#include "TlsSessionCacheTest.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+#include "Metrics.hpp"
+
+using net::TlsSessionCache;
+
+static uint32_t counterValue(const char *name) {
+    const metrics::Counter *counter = metrics::Registry::instance().findCounter(name);
+    return (counter != nullptr) ? counter->value() : 0U;
+}
+
+int TlsSessionCacheTest::sReleased = 0;
+
+void TlsSessionCacheTest::SetUp() {
+    sReleased = 0;
+    cache = std::make_unique<TlsSessionCache>(releaseFake, LIFETIME_US);
+}
+
+void TlsSessionCacheTest::TearDown() {
+    cache.reset();
+}
+
+void TlsSessionCacheTest::releaseFake(void *session) {
+    (void)session;
+    ++sReleased;
+}
+
+TlsSessionCache::SessionId TlsSessionCacheTest::idOf(const uint8_t &seed) {
+    TlsSessionCache::SessionId id{};
+    id.len = TlsSessionCache::MAX_SESSION_ID_LEN;
+    id.bytes.fill(seed);
+    return id;
+}
+
+TEST_F(TlsSessionCacheTest, take_Stored_HandsOverSessionAndId) {
+    // Arrange
+    const uint32_t hits = counterValue("net.tls_session_hits");
+    cache->put(ORIGIN, &sessions[0], idOf(7U), 0);
+
+    // Act
+    TlsSessionCache::SessionId id{};
+    void *session = cache->take(ORIGIN, LIFETIME_US - 1, &id);
+
+    // Expect: the caller owns it now, nothing was released
+    EXPECT_EQ(&sessions[0], session);
+    EXPECT_TRUE(id == idOf(7U));
+    EXPECT_EQ(0U, cache->size());
+    EXPECT_EQ(0, sReleased);
+    EXPECT_EQ(hits + 1U, counterValue("net.tls_session_hits"));
+}
+
+TEST_F(TlsSessionCacheTest, take_Expired_ReleasesAndMisses) {
+    // Arrange
+    const uint32_t misses = counterValue("net.tls_session_misses");
+    cache->put(ORIGIN, &sessions[0], idOf(7U), 0);
+
+    // Act
+    void *session = cache->take(ORIGIN, LIFETIME_US, nullptr);
+
+    // Expect
+    EXPECT_EQ(nullptr, session);
+    EXPECT_EQ(1, sReleased);
+    EXPECT_EQ(misses + 1U, counterValue("net.tls_session_misses"));
+}
+
+TEST_F(TlsSessionCacheTest, put_SameOrigin_ReleasesTheOlderSession) {
+    // Act
+    cache->put(ORIGIN, &sessions[0], idOf(1U), 0);
+    cache->put(ORIGIN, &sessions[1], idOf(2U), 1000);
+
+    // Expect
+    EXPECT_EQ(1U, cache->size());
+    EXPECT_EQ(1, sReleased);
+    EXPECT_EQ(&sessions[1], cache->take(ORIGIN, 2000, nullptr));
+}
+
+TEST_F(TlsSessionCacheTest, put_Full_EvictsTheOldest) {
+    // Arrange
+    cache->put("https://a:443", &sessions[0], idOf(1U), 0);
+    cache->put("https://b:443", &sessions[1], idOf(2U), 10);
+    cache->put("https://c:443", &sessions[2], idOf(3U), 20);
+    cache->put("https://d:443", &sessions[3], idOf(4U), 30);
+
+    // Act
+    int extra = 5;
+    cache->put("https://e:443", &extra, idOf(5U), 40);
+
+    // Expect
+    EXPECT_EQ(TlsSessionCache::MAX_ENTRIES, cache->size());
+    EXPECT_EQ(1, sReleased);
+    EXPECT_EQ(nullptr, cache->take("https://a:443", 50, nullptr));
+}
+
+TEST_F(TlsSessionCacheTest, destructor_ReleasesWhatIsLeft) {
+    // Arrange
+    cache->put("https://a:443", &sessions[0], idOf(1U), 0);
+    cache->put("https://b:443", &sessions[1], idOf(2U), 0);
+
+    // Act
+    cache.reset();
+
+    // Expect
+    EXPECT_EQ(2, sReleased);
+}
+
+void TlsResumptionTest::SetUp() {
+    server = std::make_unique<TlsStandIn>();
+    ASSERT_TRUE(server->start());
+    cache = std::make_unique<TlsSessionCache>(TlsSessionClient::releaseSession);
+    client = std::make_unique<TlsSessionClient>(*cache);
+}
+
+void TlsResumptionTest::TearDown() {
+    client.reset();
+    cache.reset();
+    server.reset();
+}
+
+TEST_F(TlsResumptionTest, fetch_SecondConnection_ResumesSession) {
+    // Arrange
+    const uint32_t resumed = counterValue("net.tls_resumed");
+    const uint32_t full = counterValue("net.tls_full");
+    bool firstResumed = true;
+    bool secondResumed = false;
+
+    // Act
+    const bool first = client->fetch(server->port(), 0, firstResumed);
+    const bool second = client->fetch(server->port(), 1000, secondResumed);
+
+    // Expect: the client's verdict from the session id matches what the server did
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_FALSE(firstResumed);
+    EXPECT_TRUE(secondResumed);
+    EXPECT_EQ(1, server->fullHandshakes());
+    EXPECT_EQ(1, server->resumedHandshakes());
+    EXPECT_EQ(resumed + 1U, counterValue("net.tls_resumed"));
+    EXPECT_EQ(full + 1U, counterValue("net.tls_full"));
+    EXPECT_EQ(1U, cache->size());
+}
+
+TEST_F(TlsResumptionTest, fetch_ServerRotatedTicketKeys_FallsBackToFullHandshake) {
+    // Arrange
+    bool resumed = false;
+    ASSERT_TRUE(client->fetch(server->port(), 0, resumed));
+    server->stop();
+    ASSERT_TRUE(server->start());
+
+    // Act
+    const bool ok = client->fetch(server->port(), 1000, resumed);
+
+    // Expect: still connects, and the fresh session is stored for next time
+    ASSERT_TRUE(ok);
+    EXPECT_FALSE(resumed);
+    EXPECT_EQ(2, server->fullHandshakes());
+    EXPECT_EQ(0, server->resumedHandshakes());
+    EXPECT_EQ(1U, cache->size());
+}
+
+TEST_F(TlsResumptionTest, fetch_SessionExpired_DoesFullHandshake) {
+    // Arrange
+    bool resumed = true;
+    ASSERT_TRUE(client->fetch(server->port(), 0, resumed));
+
+    // Act
+    const bool ok =
+        client->fetch(server->port(), TlsSessionCache::DEFAULT_LIFETIME_US, resumed);
+
+    // Expect
+    ASSERT_TRUE(ok);
+    EXPECT_FALSE(resumed);
+    EXPECT_EQ(2, server->fullHandshakes());
+}
+
+TEST_F(TlsResumptionTest, benchmark_FullVersusResumedHandshake) {
+    static constexpr int ROUNDS = 20;
+    using Clock = std::chrono::steady_clock;
+
+    // Full: a cache that never keeps anything past one connection
+    bool resumed = false;
+    const Clock::time_point fullStart = Clock::now();
+    for (int i = 0; i < ROUNDS; ++i) {
+        cache->forget(("https://127.0.0.1:" + std::to_string(server->port())).c_str());
+        ASSERT_TRUE(client->fetch(server->port(), i, resumed));
+    }
+    const double fullUs =
+        std::chrono::duration<double, std::micro>(Clock::now() - fullStart).count() / ROUNDS;
+
+    const Clock::time_point resumedStart = Clock::now();
+    for (int i = 0; i < ROUNDS; ++i) {
+        ASSERT_TRUE(client->fetch(server->port(), ROUNDS + i, resumed));
+        ASSERT_TRUE(resumed);
+    }
+    const double resumedUs =
+        std::chrono::duration<double, std::micro>(Clock::now() - resumedStart).count() / ROUNDS;
+
+    std::printf("[ TLS      ] connect + GET: full %.0f us, resumed %.0f us\n", fullUs, resumedUs);
+    EXPECT_LT(resumedUs, fullUs);
+}
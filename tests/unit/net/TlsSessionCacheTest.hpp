@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+
+#include "TlsSessionCache.hpp"
+#include "TlsStandIn.hpp"
+#include "gtest/gtest.h"
+
+class TlsSessionCacheTest : public ::testing::Test {
+   protected:
+    static constexpr int64_t LIFETIME_US = 60000000;
+    static constexpr const char *ORIGIN = "https://stream.example:443";
+
+    void SetUp() override;
+    void TearDown() override;
+
+    // Fake sessions: ints whose release is counted
+    static void releaseFake(void *session);
+    static net::TlsSessionCache::SessionId idOf(const uint8_t &seed);
+
+    static int sReleased;
+    std::unique_ptr<net::TlsSessionCache> cache;
+    int sessions[4] = {1, 2, 3, 4};
+};
+
+// The same cache in front of a real TLS stack talking to a local server
+class TlsResumptionTest : public ::testing::Test {
+   protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    std::unique_ptr<TlsStandIn> server;
+    std::unique_ptr<net::TlsSessionCache> cache;
+    std::unique_ptr<TlsSessionClient> client;
+};
@@ -0,0 +1,229 @@
+#include "TlsStandIn.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+static constexpr int POLL_MS = 20;
+static constexpr const char *REPLY =
+    "HTTP/1.1 200 Stand-in\r\nContent-Length: 2\r\nConnection: close\r\n\r\nok";
+
+static net::TlsSessionCache::SessionId sessionIdOf(const SSL_SESSION *session) {
+    net::TlsSessionCache::SessionId id{};
+    unsigned int len = 0U;
+    const unsigned char *bytes = SSL_SESSION_get_id(session, &len);
+    id.len = std::min<size_t>(len, id.bytes.size());
+    std::memcpy(id.bytes.data(), bytes, id.len);
+    return id;
+}
+
+// P-256 key and a certificate for it signed by itself, valid for a day
+static bool addSelfSignedCertificate(SSL_CTX *context) {
+    EVP_PKEY *key = EVP_EC_gen("P-256");
+    X509 *certificate = X509_new();
+    bool ok = key != nullptr && certificate != nullptr;
+    if (ok) {
+        X509_set_version(certificate, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+        X509_gmtime_adj(X509_getm_notBefore(certificate), 0);
+        X509_gmtime_adj(X509_getm_notAfter(certificate), 24L * 60L * 60L);
+        X509_set_pubkey(certificate, key);
+        X509_NAME *name = X509_get_subject_name(certificate);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                                   reinterpret_cast<const unsigned char *>("localhost"), -1, -1,
+                                   0);
+        X509_set_issuer_name(certificate, name);
+        ok = X509_sign(certificate, key, EVP_sha256()) > 0 &&
+             SSL_CTX_use_certificate(context, certificate) == 1 &&
+             SSL_CTX_use_PrivateKey(context, key) == 1;
+    }
+    X509_free(certificate);
+    EVP_PKEY_free(key);
+    return ok;
+}
+
+TlsStandIn::TlsStandIn()
+    : mContext(nullptr),
+      mListenFd(-1),
+      mPort(0U),
+      mRunning(false),
+      mFull(0),
+      mResumed(0) {}
+
+TlsStandIn::~TlsStandIn() {
+    stop();
+}
+
+bool TlsStandIn::start() {
+    // A new context each start: new certificate, new ticket keys
+    mContext = SSL_CTX_new(TLS_server_method());
+    if (mContext == nullptr || !addSelfSignedCertificate(mContext)) {
+        return false;
+    }
+    // The ESP32 side resumes TLS 1.2 tickets; 1.3 resumption works differently
+    SSL_CTX_set_max_proto_version(mContext, TLS1_2_VERSION);
+    SSL_CTX_set_session_cache_mode(mContext, SSL_SESS_CACHE_OFF);
+
+    mListenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(mPort);  // the same port again after a restart
+    const int reuse = 1;
+    ::setsockopt(mListenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    socklen_t len = sizeof(address);
+    if (mListenFd < 0 ||
+        ::bind(mListenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        ::listen(mListenFd, 8) != 0 ||
+        ::getsockname(mListenFd, reinterpret_cast<sockaddr *>(&address), &len) != 0) {
+        stop();
+        return false;
+    }
+    mPort = ntohs(address.sin_port);
+
+    mRunning = true;
+    mAcceptThread = std::thread([this] { acceptLoop(); });
+    return true;
+}
+
+void TlsStandIn::stop() {
+    mRunning = false;
+    if (mAcceptThread.joinable()) {
+        mAcceptThread.join();
+    }
+    if (mListenFd >= 0) {
+        ::close(mListenFd);
+        mListenFd = -1;
+    }
+    SSL_CTX_free(mContext);
+    mContext = nullptr;
+}
+
+uint16_t TlsStandIn::port() const {
+    return mPort;
+}
+
+int TlsStandIn::fullHandshakes() const {
+    return mFull.load();
+}
+
+int TlsStandIn::resumedHandshakes() const {
+    return mResumed.load();
+}
+
+void TlsStandIn::acceptLoop() {
+    // One connection at a time is all the tests need
+    while (mRunning) {
+        pollfd listener = {mListenFd, POLLIN, 0};
+        if (::poll(&listener, 1, POLL_MS) <= 0) {
+            continue;
+        }
+        const int fd = ::accept(mListenFd, nullptr, nullptr);
+        if (fd >= 0) {
+            serve(fd);
+            ::close(fd);
+        }
+    }
+}
+
+void TlsStandIn::serve(const int &fd) {
+    const int noDelay = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    SSL *ssl = SSL_new(mContext);
+    SSL_set_fd(ssl, fd);
+    if (SSL_accept(ssl) == 1) {
+        (SSL_session_reused(ssl) == 1 ? mResumed : mFull)++;
+
+        // Up to the end of the request head, then a short answer
+        std::string request;
+        char buffer[256];
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            const int n = SSL_read(ssl, buffer, sizeof(buffer));
+            if (n <= 0) {
+                break;
+            }
+            request.append(buffer, static_cast<size_t>(n));
+        }
+        SSL_write(ssl, REPLY, static_cast<int>(std::strlen(REPLY)));
+        SSL_shutdown(ssl);
+    }
+    SSL_free(ssl);
+}
+
+TlsSessionClient::TlsSessionClient(net::TlsSessionCache &sessions)
+    : mSessions(sessions), mContext(SSL_CTX_new(TLS_client_method())) {
+    // The certificate is self-signed; what is under test is the handshake, not the chain
+    SSL_CTX_set_verify(mContext, SSL_VERIFY_NONE, nullptr);
+}
+
+TlsSessionClient::~TlsSessionClient() {
+    SSL_CTX_free(mContext);
+}
+
+void TlsSessionClient::releaseSession(void *session) {
+    SSL_SESSION_free(static_cast<SSL_SESSION *>(session));
+}
+
+bool TlsSessionClient::fetch(const uint16_t &port, const int64_t &nowUs, bool &resumed) {
+    const std::string origin = "https://127.0.0.1:" + std::to_string(port);
+
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+    const int noDelay = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    SSL *ssl = SSL_new(mContext);
+    SSL_set_fd(ssl, fd);
+    SSL_set_tlsext_host_name(ssl, "localhost");
+
+    net::TlsSessionCache::SessionId offeredId{};
+    SSL_SESSION *offered =
+        static_cast<SSL_SESSION *>(mSessions.take(origin.c_str(), nowUs, &offeredId));
+    if (offered != nullptr) {
+        SSL_set_session(ssl, offered);
+        // The handshake holds its own reference
+        SSL_SESSION_free(offered);
+    }
+
+    bool ok = SSL_connect(ssl) == 1;
+    if (ok) {
+        SSL_SESSION *session = SSL_get1_session(ssl);
+        const net::TlsSessionCache::SessionId id = sessionIdOf(session);
+        resumed = offered != nullptr && id.len > 0U && id == offeredId;
+        mSessions.noteHandshake(resumed);
+        mSessions.put(origin.c_str(), session, id, nowUs);
+
+        const std::string request = "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        ok = SSL_write(ssl, request.data(), static_cast<int>(request.size())) > 0;
+        char buffer[256];
+        std::string reply;
+        int n = 0;
+        while (ok && (n = SSL_read(ssl, buffer, sizeof(buffer))) > 0) {
+            reply.append(buffer, static_cast<size_t>(n));
+        }
+        ok = ok && reply.size() >= 2U && reply.compare(reply.size() - 2U, 2U, "ok") == 0;
+        SSL_shutdown(ssl);
+    }
+    SSL_free(ssl);
+    ::close(fd);
+    return ok;
+}
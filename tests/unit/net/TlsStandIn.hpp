@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include <openssl/ssl.h>
+
+#include "TlsSessionCache.hpp"
+
+// TLS 1.2 server on 127.0.0.1 with a self-signed certificate made at start, standing in for
+// a stream server. It issues session tickets and counts which handshakes resumed one. Each
+// restart brings new ticket keys, like a server that rotated them.
+class TlsStandIn {
+   public:
+    TlsStandIn();
+    ~TlsStandIn();
+
+    bool start();
+    void stop();
+
+    uint16_t port() const;
+    int fullHandshakes() const;
+    int resumedHandshakes() const;
+
+   private:
+    void acceptLoop();
+    void serve(const int &fd);
+
+    SSL_CTX *mContext;
+    int mListenFd;
+    uint16_t mPort;
+    std::atomic<bool> mRunning;
+    std::atomic<int> mFull;
+    std::atomic<int> mResumed;
+    std::thread mAcceptThread;
+};
+
+// Client side the way EspHttpTransport does it: take the session stored for the origin,
+// offer it, tell resumption from the session id, and put the new session back
+class TlsSessionClient {
+   public:
+    explicit TlsSessionClient(net::TlsSessionCache &sessions);
+    ~TlsSessionClient();
+
+    // For the cache: the sessions it holds come from here
+    static void releaseSession(void *session);
+
+    // One GET over a fresh connection; false when it failed
+    bool fetch(const uint16_t &port, const int64_t &nowUs, bool &resumed);
+
+   private:
+    net::TlsSessionCache &mSessions;
+    SSL_CTX *mContext;
+};
@@ -0,0 +1,247 @@
+#include "WifiManagerTest.hpp"
+
+#include <cstdio>
+
+using common::UiStatusKind;
+using net::FakeWifiDriver;
+using net::WifiManager;
+
+void WifiManagerTest::SetUp() {
+    link.bssid = {0x24U, 0x0AU, 0xC4U, 0x01U, 0x02U, 0x03U};
+    link.channel = 6U;
+    link.rssiDbm = -55;
+    link.lease.address = 0x0A01A8C0U;  // 192.168.1.10
+    link.lease.netmask = 0x00FFFFFFU;
+    link.lease.gateway = 0x0101A8C0U;
+    link.lease.dns = 0x0101A8C0U;
+    boot();
+}
+
+void WifiManagerTest::TearDown() {
+    manager.reset();
+    driver.reset();
+}
+
+void WifiManagerTest::boot(const net::WifiBackoffPolicy &policy) {
+    manager.reset();
+    driver = std::make_unique<FakeWifiDriver>(clock);
+    driver->setLink(link);
+    manager = std::make_unique<WifiManager>(*driver, clock, &store, &listener, policy);
+    listener.kinds.clear();
+    ASSERT_TRUE(manager->init());
+}
+
+uint32_t WifiManagerTest::runUntil(const WifiManager::State &state, const uint32_t &limitMs) {
+    const uint64_t startUs = clock.nowUs();
+    while (manager->getState() != state) {
+        const uint64_t elapsedUs = clock.nowUs() - startUs;
+        if (elapsedUs > static_cast<uint64_t>(limitMs) * 1000U) {
+            return UINT32_MAX;
+        }
+        const uint32_t waitMs = manager->poll();
+        if (manager->getState() != state) {
+            clock.advanceUs(static_cast<uint64_t>(waitMs > 0U ? waitMs : 1U) * 1000U);
+        }
+    }
+    return static_cast<uint32_t>((clock.nowUs() - startUs) / 1000U);
+}
+
+void WifiManagerTest::connectOnce() {
+    driver->scriptScan(FakeWifiDriver::Outcome::Connect, 4000U);
+    manager->start();
+    ASSERT_NE(UINT32_MAX, runUntil(WifiManager::State::Connected));
+}
+
+TEST_F(WifiManagerTest, start_NoRecord_ScansAndRemembersAp) {
+    // Arrange
+    driver->scriptScan(FakeWifiDriver::Outcome::Connect, 4000U);
+
+    // Act
+    manager->start();
+    const uint32_t elapsedMs = runUntil(WifiManager::State::Connected);
+
+    // Expect
+    ASSERT_EQ(1U, driver->attempts().size());
+    EXPECT_EQ(0U, driver->attempts()[0].channel);
+    EXPECT_FALSE(driver->attempts()[0].lease.isValid());
+    EXPECT_GE(elapsedMs, 4000U);
+    EXPECT_EQ(1U, store.size());
+    EXPECT_EQ((std::vector<UiStatusKind>{UiStatusKind::WifiConnecting,
+                                         UiStatusKind::WifiConnected}),
+              listener.kinds);
+    EXPECT_EQ(-55, listener.lastRssi);
+}
+
+TEST_F(WifiManagerTest, start_AfterReboot_FastConnectsToRememberedAp) {
+    // Arrange
+    connectOnce();
+    boot();
+    driver->scriptFast(FakeWifiDriver::Outcome::Connect, 300U);
+
+    // Act
+    manager->start();
+    const uint32_t elapsedMs = runUntil(WifiManager::State::Connected);
+
+    // Expect: directed at the last AP with its lease, no scan, no DHCP
+    ASSERT_EQ(1U, driver->attempts().size());
+    const net::WifiTarget &target = driver->attempts()[0];
+    EXPECT_EQ(link.bssid, target.bssid);
+    EXPECT_EQ(6U, target.channel);
+    EXPECT_EQ(link.lease.address, target.lease.address);
+    EXPECT_LT(elapsedMs, 400U);
+    std::printf("[ WIFI     ] time to connected: scan 4000 ms, fast %u ms\n", elapsedMs);
+}
+
+TEST_F(WifiManagerTest, fastConnect_Fails_FallsBackToScanWithDhcp) {
+    // Arrange
+    connectOnce();
+    boot();
+    driver->scriptFast(FakeWifiDriver::Outcome::Fail, 200U);
+    driver->scriptScan(FakeWifiDriver::Outcome::Connect, 4000U);
+
+    // Act
+    manager->start();
+    runUntil(WifiManager::State::Connected);
+
+    // Expect
+    ASSERT_EQ(2U, driver->attempts().size());
+    EXPECT_EQ(0U, driver->attempts()[1].channel);
+    EXPECT_FALSE(driver->attempts()[1].lease.isValid());
+    EXPECT_EQ((std::vector<UiStatusKind>{UiStatusKind::WifiConnecting,
+                                         UiStatusKind::WifiConnected}),
+              listener.kinds);
+}
+
+TEST_F(WifiManagerTest, fastConnect_Hangs_ScanStartsAtPolicyTimeout) {
+    // Arrange
+    net::WifiBackoffPolicy policy;
+    policy.fastConnectTimeoutMs = 1500U;
+    connectOnce();
+    boot(policy);
+    driver->scriptFast(FakeWifiDriver::Outcome::Hang, 0U);
+    driver->scriptScan(FakeWifiDriver::Outcome::Connect, 100U);
+
+    // Act
+    manager->start();
+    const uint32_t elapsedMs = runUntil(WifiManager::State::Connected);
+
+    // Expect
+    EXPECT_EQ(2U, driver->attempts().size());
+    EXPECT_GE(elapsedMs, 1600U);
+    EXPECT_LT(elapsedMs, 1700U);
+}
+
+TEST_F(WifiManagerTest, start_WorstCaseFirstCycle_ConnectedWithinFr08) {
+    // Arrange: the remembered AP is gone and the scan takes almost its whole timeout
+    connectOnce();
+    boot();
+    driver->scriptFast(FakeWifiDriver::Outcome::Hang, 0U);
+    driver->scriptScan(FakeWifiDriver::Outcome::Connect, 14000U);
+
+    // Act
+    manager->start();
+    const uint32_t elapsedMs = runUntil(WifiManager::State::Connected);
+
+    // Expect
+    EXPECT_LT(elapsedMs, FR08_LIMIT_MS);
+}
+
+TEST_F(WifiManagerTest, scan_KeepsFailing_BacksOffExponentiallyAndShowsError) {
+    // Arrange
+    net::WifiBackoffPolicy policy;
+    policy.initialBackoffMs = 1000U;
+    policy.maxBackoffMs = 4000U;
+    boot(policy);
+    driver->scriptScan(FakeWifiDriver::Outcome::Fail, 100U);
+
+    // Act
+    manager->start();
+    std::vector<uint32_t> backoffs;
+    for (int i = 0; i < 4; ++i) {
+        runUntil(WifiManager::State::Backoff);
+        backoffs.push_back(manager->getBackoffMs());
+        runUntil(WifiManager::State::Scan);
+    }
+
+    // Expect: the error shows once and stays while retrying
+    EXPECT_EQ((std::vector<uint32_t>{1000U, 2000U, 4000U, 4000U}), backoffs);
+    EXPECT_EQ(4U, manager->getFailedCycles());
+    EXPECT_EQ((std::vector<UiStatusKind>{UiStatusKind::WifiConnecting, UiStatusKind::WifiError}),
+              listener.kinds);
+}
+
+TEST_F(WifiManagerTest, scan_SucceedsAfterFailures_ResetsBackoff) {
+    // Arrange
+    driver->scriptScan(FakeWifiDriver::Outcome::Fail, 100U);
+    manager->start();
+    runUntil(WifiManager::State::Backoff);
+    driver->scriptScan(FakeWifiDriver::Outcome::Connect, 100U);
+
+    // Act
+    runUntil(WifiManager::State::Connected);
+
+    // Expect
+    EXPECT_EQ(0U, manager->getFailedCycles());
+    EXPECT_EQ(UiStatusKind::WifiConnected, listener.kinds.back());
+}
+
+TEST_F(WifiManagerTest, poll_LinkLost_ReconnectsInBackgroundViaFastPath) {
+    // Arrange
+    connectOnce();
+    driver->scriptFast(FakeWifiDriver::Outcome::Connect, 200U);
+
+    // Act
+    driver->dropLink();
+    manager->poll();
+    const WifiManager::State afterLoss = manager->getState();
+    runUntil(WifiManager::State::Connected);
+
+    // Expect
+    EXPECT_EQ(WifiManager::State::FastConnect, afterLoss);
+    EXPECT_EQ(6U, driver->attempts().back().channel);
+    EXPECT_EQ((std::vector<UiStatusKind>{UiStatusKind::WifiConnecting,
+                                         UiStatusKind::WifiConnected,
+                                         UiStatusKind::WifiConnecting,
+                                         UiStatusKind::WifiConnected}),
+              listener.kinds);
+}
+
+TEST_F(WifiManagerTest, fastConnect_LeaseReusedTooOften_AsksDhcpAgain) {
+    // Arrange
+    net::WifiBackoffPolicy policy;
+    policy.maxLeaseReuses = 2U;
+    connectOnce();
+
+    // Act: three reboots in a row
+    std::vector<bool> leaseOffered;
+    for (int i = 0; i < 3; ++i) {
+        boot(policy);
+        driver->scriptFast(FakeWifiDriver::Outcome::Connect, 200U);
+        manager->start();
+        runUntil(WifiManager::State::Connected);
+        leaseOffered.push_back(driver->attempts()[0].lease.isValid());
+    }
+
+    // Expect
+    EXPECT_EQ((std::vector<bool>{true, true, false}), leaseOffered);
+}
+
+TEST_F(WifiManagerTest, poll_RssiMoves_RepublishesConnected) {
+    // Arrange
+    connectOnce();
+    const size_t published = listener.kinds.size();
+
+    // Act
+    driver->setRssi(-54);
+    clock.advanceUs(2000000U);
+    manager->poll();
+    const size_t afterSmallChange = listener.kinds.size();
+    driver->setRssi(-70);
+    clock.advanceUs(2000000U);
+    manager->poll();
+
+    // Expect
+    EXPECT_EQ(published, afterSmallChange);
+    EXPECT_EQ(published + 1U, listener.kinds.size());
+    EXPECT_EQ(-70, listener.lastRssi);
+}
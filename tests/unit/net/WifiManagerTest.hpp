@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "FakeClock.hpp"
+#include "FakeKeyValueStore.hpp"
+#include "FakeWifiDriver.hpp"
+#include "IWifiListener.hpp"
+#include "WifiManager.hpp"
+#include "gtest/gtest.h"
+
+class RecordingWifiListener : public net::IWifiListener {
+   public:
+    void onWifiStatus(const common::UiStatusKind &kind, const int8_t &rssiDbm) override {
+        kinds.push_back(kind);
+        lastRssi = rssiDbm;
+    }
+
+    std::vector<common::UiStatusKind> kinds;
+    int8_t lastRssi = 0;
+};
+
+class WifiManagerTest : public ::testing::Test {
+   protected:
+    static constexpr uint32_t FR08_LIMIT_MS = 30000U;
+
+    void SetUp() override;
+    void TearDown() override;
+
+    // A fresh manager on the shared store, as after a reboot
+    void boot(const net::WifiBackoffPolicy &policy = net::WifiBackoffPolicy());
+    // Steps the manager the way WifiTask does, sleeping what poll() asks for, until the
+    // state is reached; returns the milliseconds that took, or UINT32_MAX at the limit
+    uint32_t runUntil(const net::WifiManager::State &state, const uint32_t &limitMs = 120000U);
+    // Connects once through a full scan so the store holds a record
+    void connectOnce();
+
+    common::FakeClock clock;
+    common::FakeKeyValueStore store;
+    RecordingWifiListener listener;
+    std::unique_ptr<net::FakeWifiDriver> driver;
+    std::unique_ptr<net::WifiManager> manager;
+    net::WifiLink link;
+};
@@ -0,0 +1,233 @@
+#include "BufferTunerTest.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+using player::BufferSettings;
+using player::BufferTuner;
+using player::BufferWindow;
+
+static constexpr uint32_t FRAMES_PER_MS = PlaybackSimulation::RATE / 1000U;
+static constexpr double FRAMES_PER_BYTE =
+    static_cast<double>(PlaybackSimulation::RATE) / PlaybackSimulation::STREAM_BYTES_PER_S;
+// A live stream arrives in real time; after a stall the server's backlog comes in at up to
+// half again that rate
+static constexpr uint32_t STREAM_BYTES_PER_MS = PlaybackSimulation::STREAM_BYTES_PER_S / 1000U;
+static constexpr uint32_t CATCH_UP_BYTES_PER_MS = STREAM_BYTES_PER_MS * 3U / 2U;
+
+// Stalls close each period, so playback has started before the first one
+static bool stalled(const uint64_t &tick, const uint32_t &stallMs, const uint32_t &periodMs) {
+    return periodMs > 0U && (tick % periodMs) >= periodMs - stallMs;
+}
+
+BufferWindow PlaybackSimulation::run(const uint32_t &ms) {
+    BufferWindow window;
+
+    for (uint32_t i = 0; i < ms; ++i, ++tick) {
+        owedBytes += STREAM_BYTES_PER_MS;
+        if (!stalled(tick, networkStallMs, networkPeriodMs)) {
+            const uint32_t bytes =
+                std::min({owedBytes, CATCH_UP_BYTES_PER_MS, RING_BYTES - ringBytes});
+            owedBytes -= bytes;
+            ringBytes += bytes;
+        }
+
+        // Decode side, like PlayerPipeline: hold back until the decode-ahead is there, and
+        // again whenever the ring runs dry
+        if (prebuffering && ringBytes >= std::min(settings.decodeAheadBytes, RING_BYTES / 2U)) {
+            prebuffering = false;
+        }
+        if (!prebuffering && !stalled(tick, decoderStallMs, decoderPeriodMs)) {
+            const uint32_t space = settings.dmaFramesTotal() - dmaFrames;
+            frameCredit += ringBytes * FRAMES_PER_BYTE;
+            const uint32_t frames = std::min(space, static_cast<uint32_t>(frameCredit));
+            const double used = (frames + FRAMES_PER_BYTE - 1.0) / FRAMES_PER_BYTE;
+            const uint32_t bytes = std::min(ringBytes, static_cast<uint32_t>(used));
+            frameCredit = 0.0;
+            ringBytes -= bytes;
+            dmaFrames += frames;
+            started = started || frames > 0U;
+            if (ringBytes == 0U) {
+                prebuffering = true;
+            }
+        }
+
+        // The I2S clock never waits
+        if (!started) {
+            continue;
+        }
+        if (dmaFrames < FRAMES_PER_MS) {
+            ++window.underruns;
+            dmaFrames = 0U;
+        } else {
+            dmaFrames -= FRAMES_PER_MS;
+        }
+        const uint32_t fill = (dmaFrames * 1000U) / settings.dmaFramesTotal();
+        window.minFillPermille = std::min<uint16_t>(window.minFillPermille, fill);
+    }
+    return window;
+}
+
+void BufferTunerTest::SetUp() {
+    tuner = std::make_unique<BufferTuner>(BufferTuner::DEFAULT_BOUNDS,
+                                          BufferTuner::DEFAULT_SETTINGS);
+}
+
+void BufferTunerTest::TearDown() {
+    tuner.reset();
+}
+
+uint32_t BufferTunerTest::simulate(PlaybackSimulation &simulation, const uint32_t &seconds,
+                                   const uint32_t &tailSeconds) {
+    simulation.settings = tuner->getSettings();
+    uint32_t tailUnderruns = 0U;
+
+    for (uint32_t second = 0; second < seconds; ++second) {
+        const BufferWindow window = simulation.run(1000U);
+        if (second >= seconds - tailSeconds) {
+            tailUnderruns += window.underruns;
+        }
+
+        if (tuner->update(window, static_cast<int64_t>(second + 1U) * 1000000)) {
+            simulation.settings = tuner->getSettings();
+            simulation.dmaFrames = std::min(simulation.dmaFrames,
+                                            simulation.settings.dmaFramesTotal());
+        }
+    }
+
+    const BufferSettings &settings = tuner->getSettings();
+    printf("[ BUFFERS  ] after %us: DMA %u x %u frames (%.1f ms), decode-ahead %u B, "
+           "%zu changes, %u underruns in the last %us\n",
+           seconds, settings.dmaDescriptors, settings.dmaFrames,
+           settings.dmaFramesTotal() * 1000.0 / PlaybackSimulation::RATE,
+           static_cast<unsigned>(settings.decodeAheadBytes), tuner->getHistoryCount(),
+           tailUnderruns, tailSeconds);
+    return tailUnderruns;
+}
+
+TEST_F(BufferTunerTest, update_Underruns_GrowDescriptorsThenTheirSizeUpToTheBounds) {
+    // Arrange
+    const BufferWindow glitch{3U, 0U};
+    const BufferSettings &max = BufferTuner::DEFAULT_BOUNDS.max;
+
+    // Act
+    ASSERT_TRUE(tuner->update(glitch, 1));
+    const BufferSettings first = tuner->getSettings();
+    while (tuner->update(glitch, 2)) {
+    }
+
+    // Expect
+    EXPECT_EQ(9U, first.dmaDescriptors);
+    EXPECT_EQ(240U, first.dmaFrames);
+    EXPECT_EQ(16384U, first.decodeAheadBytes);
+    EXPECT_EQ(max, tuner->getSettings());
+}
+
+TEST_F(BufferTunerTest, update_NearMiss_RaisesOnlyDecodeAhead) {
+    // Act
+    const bool changed = tuner->update({0U, 50U}, 1);
+
+    // Expect
+    EXPECT_TRUE(changed);
+    EXPECT_EQ(6U, tuner->getSettings().dmaDescriptors);
+    EXPECT_EQ(240U, tuner->getSettings().dmaFrames);
+    EXPECT_EQ(16384U, tuner->getSettings().decodeAheadBytes);
+    EXPECT_EQ(BufferTuner::Reason::NearMiss, tuner->getHistory(1U).reason);
+}
+
+TEST_F(BufferTunerTest, update_CleanWindows_ShrinkOnlyAfterAFullStreak) {
+    // Arrange
+    const BufferWindow clean{0U, 800U};
+    for (uint32_t i = 0; i + 1U < BufferTuner::SHRINK_AFTER_WINDOWS; ++i) {
+        ASSERT_FALSE(tuner->update(clean, i));
+    }
+
+    // Act: a window that dipped below half resets the streak
+    EXPECT_FALSE(tuner->update({0U, 300U}, 100));
+    EXPECT_FALSE(tuner->update(clean, 101));
+    for (uint32_t i = 1; i + 1U < BufferTuner::SHRINK_AFTER_WINDOWS; ++i) {
+        ASSERT_FALSE(tuner->update(clean, 200 + i));
+    }
+    const bool changed = tuner->update(clean, 300);
+
+    // Expect
+    EXPECT_TRUE(changed);
+    EXPECT_EQ(5U, tuner->getSettings().dmaDescriptors);
+    EXPECT_EQ(6144U, tuner->getSettings().decodeAheadBytes);
+}
+
+TEST_F(BufferTunerTest, constructor_InitialOutsideBounds_IsClamped) {
+    // Act
+    BufferTuner clamped(BufferTuner::DEFAULT_BOUNDS, {100U, 10U, 1U});
+
+    // Expect
+    EXPECT_EQ(16U, clamped.getSettings().dmaDescriptors);
+    EXPECT_EQ(240U, clamped.getSettings().dmaFrames);
+    EXPECT_EQ(4096U, clamped.getSettings().decodeAheadBytes);
+}
+
+TEST_F(BufferTunerTest, getHistory_KeepsTheNewestChangesInOrder) {
+    // Arrange: grow and shrink again, well past the history size
+    int64_t nowUs = 0;
+    for (uint32_t cycle = 0; cycle < BufferTuner::HISTORY_SIZE; ++cycle) {
+        tuner->update({1U, 0U}, ++nowUs);
+        for (uint32_t i = 0; i < BufferTuner::SHRINK_AFTER_WINDOWS; ++i) {
+            tuner->update({0U, 1000U}, ++nowUs);
+        }
+    }
+
+    // Act
+    const size_t count = tuner->getHistoryCount();
+
+    // Expect
+    ASSERT_EQ(BufferTuner::HISTORY_SIZE, count);
+    for (size_t i = 1; i < count; ++i) {
+        EXPECT_LT(tuner->getHistory(i - 1U).atUs, tuner->getHistory(i).atUs);
+    }
+    EXPECT_EQ(tuner->getSettings(), tuner->getHistory(count - 1U).settings);
+    tuner->logHistory();
+}
+
+TEST_F(BufferTunerTest, Simulation_DecoderHiccups_GrowDmaUntilUnderrunsStop) {
+    // Arrange: the decoder misses 45 ms twice a second, more than the default 30 ms of DMA
+    PlaybackSimulation simulation;
+    simulation.decoderStallMs = 45U;
+    simulation.decoderPeriodMs = 500U;
+
+    // Act
+    const uint32_t underruns = simulate(simulation, 60U, 20U);
+
+    // Expect
+    EXPECT_EQ(0U, underruns);
+    EXPECT_GT(tuner->getSettings().dmaFramesTotal() * 1000U / PlaybackSimulation::RATE, 45U);
+}
+
+TEST_F(BufferTunerTest, Simulation_NetworkStalls_RaiseDecodeAhead) {
+    // Arrange: Wi-Fi drops out for 900 ms every 10 s. A live stream only keeps what was
+    // decoded ahead in reserve, and the default 0.5 s does not cover it.
+    PlaybackSimulation simulation;
+    simulation.networkStallMs = 900U;
+    simulation.networkPeriodMs = 10000U;
+
+    // Act
+    const uint32_t underruns = simulate(simulation, 120U, 100U);
+
+    // Expect: the reserve built after the first rebuffer carries every later stall
+    ASSERT_GE(tuner->getHistoryCount(), 2U);
+    EXPECT_EQ(BufferTuner::Reason::Underrun, tuner->getHistory(1U).reason);
+    EXPECT_GT(tuner->getHistory(1U).settings.decodeAheadBytes,
+              BufferTuner::DEFAULT_SETTINGS.decodeAheadBytes);
+    EXPECT_EQ(0U, underruns);
+}
+
+TEST_F(BufferTunerTest, Simulation_SteadyFeed_SettlesAtMinimumLatency) {
+    // Arrange
+    PlaybackSimulation simulation;
+
+    // Act
+    const uint32_t underruns = simulate(simulation, 120U, 120U);
+
+    // Expect
+    EXPECT_EQ(0U, underruns);
+    EXPECT_EQ(BufferTuner::DEFAULT_BOUNDS.min, tuner->getSettings());
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+
+#include "BufferTuner.hpp"
+#include "gtest/gtest.h"
+
+// Output buffering on a simulated 1 ms consumer clock: a network feeding encoded bytes into
+// the ring, a decoder moving them into the DMA ring, and the I2S clock draining it
+struct PlaybackSimulation {
+    static constexpr uint32_t RATE = 48000U;
+    static constexpr uint32_t STREAM_BYTES_PER_S = 16000U;  // 128 kbit/s
+    static constexpr uint32_t RING_BYTES = 32768U;
+
+    // Disturbances, repeating every period; 0 disables them
+    uint32_t networkStallMs = 0U;
+    uint32_t networkPeriodMs = 0U;
+    uint32_t decoderStallMs = 0U;
+    uint32_t decoderPeriodMs = 0U;
+
+    player::BufferSettings settings;
+    uint32_t owedBytes = 0U;  // sent by the server, not yet received
+    uint32_t ringBytes = 0U;
+    uint32_t dmaFrames = 0U;
+    double frameCredit = 0.0;  // decoded fractions of a frame
+    bool prebuffering = true;
+    bool started = false;
+    uint64_t tick = 0U;
+
+    // Runs one window of `ms` ticks and reports what the sink would have seen
+    player::BufferWindow run(const uint32_t &ms);
+};
+
+class BufferTunerTest : public ::testing::Test {
+   protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    // Windows of one second, applying every decision, until `seconds` have passed. Returns
+    // the underruns over the last `tailSeconds`.
+    uint32_t simulate(PlaybackSimulation &simulation, const uint32_t &seconds,
+                      const uint32_t &tailSeconds);
+
+    std::unique_ptr<player::BufferTuner> tuner;
+};
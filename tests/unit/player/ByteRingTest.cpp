@@ -0,0 +1,103 @@
+#include "ByteRingTest.hpp"
+
+#include <numeric>
+#include <thread>
+#include <vector>
+
+void ByteRingTest::SetUp() {
+    ring = std::make_unique<player::ByteRing>(storage.data(), storage.size());
+}
+
+void ByteRingTest::TearDown() {
+    ring.reset();
+}
+
+TEST_F(ByteRingTest, write_MoreThanSpace_CopiesWhatFits) {
+    // Arrange
+    std::vector<uint8_t> data(CAPACITY + 4U);
+    std::iota(data.begin(), data.end(), 0U);
+
+    // Act
+    const size_t written = ring->write(data.data(), data.size());
+
+    // Expect
+    EXPECT_EQ(CAPACITY, written);
+    EXPECT_EQ(CAPACITY, ring->size());
+    EXPECT_EQ(0U, ring->space());
+    EXPECT_EQ(0U, ring->write(data.data(), 1U));
+}
+
+TEST_F(ByteRingTest, read_AcrossTheWrap_ReturnsBytesInOrder) {
+    // Arrange: move the indices close to the end of the storage
+    std::array<uint8_t, 12> scratch{};
+    ring->write(scratch.data(), scratch.size());
+    ring->read(scratch.data(), scratch.size());
+
+    std::vector<uint8_t> data(10U);
+    std::iota(data.begin(), data.end(), 1U);
+
+    // Act
+    ASSERT_EQ(data.size(), ring->write(data.data(), data.size()));
+    std::vector<uint8_t> out(data.size() + 5U);
+    const size_t count = ring->read(out.data(), out.size());
+
+    // Expect
+    ASSERT_EQ(data.size(), count);
+    out.resize(count);
+    EXPECT_EQ(data, out);
+    EXPECT_EQ(0U, ring->size());
+}
+
+TEST_F(ByteRingTest, clear_DropsBufferedBytes) {
+    // Arrange
+    std::array<uint8_t, 6> data{1, 2, 3, 4, 5, 6};
+    ring->write(data.data(), data.size());
+
+    // Act
+    ring->clear();
+
+    // Expect
+    EXPECT_EQ(0U, ring->size());
+    EXPECT_EQ(CAPACITY, ring->space());
+    EXPECT_EQ(0U, ring->read(data.data(), data.size()));
+}
+
+TEST_F(ByteRingTest, writeAndRead_OnTwoThreads_DeliverEveryByteInOrder) {
+    // Arrange
+    static constexpr size_t TOTAL = 1U << 18;
+    bool inOrder = true;
+
+    // Act
+    std::thread consumer([this, &inOrder] {
+        std::array<uint8_t, 7> chunk{};  // odd size so reads straddle the wrap
+        size_t received = 0U;
+        while (received < TOTAL) {
+            const size_t count = ring->read(chunk.data(), chunk.size());
+            for (size_t i = 0; i < count; ++i) {
+                inOrder = inOrder && (chunk[i] == static_cast<uint8_t>(received + i));
+            }
+            received += count;
+            if (count == 0U) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::array<uint8_t, 5> chunk{};
+    size_t sent = 0U;
+    while (sent < TOTAL) {
+        for (size_t i = 0; i < chunk.size(); ++i) {
+            chunk[i] = static_cast<uint8_t>(sent + i);
+        }
+        const size_t count = ring->write(chunk.data(), std::min(chunk.size(), TOTAL - sent));
+        sent += count;
+        if (count == 0U) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    // Expect
+    EXPECT_TRUE(inOrder);
+    EXPECT_EQ(0U, ring->size());
+}
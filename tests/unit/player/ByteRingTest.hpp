@@ -0,0 +1,18 @@
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include "ByteRing.hpp"
+#include "gtest/gtest.h"
+
+class ByteRingTest : public ::testing::Test {
+   protected:
+    static constexpr size_t CAPACITY = 16U;
+
+    void SetUp() override;
+    void TearDown() override;
+
+    std::array<uint8_t, CAPACITY> storage{};
+    std::unique_ptr<player::ByteRing> ring;
+};
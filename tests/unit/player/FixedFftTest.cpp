@@ -0,0 +1,79 @@
+#include "FixedFftTest.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static constexpr double PI = 3.14159265358979323846;
+
+TYPED_TEST(FixedFftTest, transform_Impulse_GivesFlatSpectrum) {
+    // Arrange
+    const size_t n = TestFixture::N;
+    this->re[0] = 32767;
+
+    // Act
+    this->fft->transform(this->re.data(), this->im.data());
+
+    // Expect: every bin holds the impulse divided by N
+    const int expected = 32767 / static_cast<int>(n);
+    for (size_t k = 0; k < n; ++k) {
+        EXPECT_NEAR(expected, this->re[k], 1) << "bin " << k;
+        EXPECT_NEAR(0, this->im[k], 1) << "bin " << k;
+    }
+}
+
+TYPED_TEST(FixedFftTest, transform_FullScaleSine_PeaksAtItsBinWithoutOverflow) {
+    // Arrange: a cosine exactly on bin 5
+    const size_t n = TestFixture::N;
+    const size_t bin = 5U;
+    for (size_t i = 0; i < n; ++i) {
+        this->re[i] = static_cast<int16_t>(std::lround(32767.0 * std::cos(2.0 * PI * bin * i / n)));
+    }
+
+    // Act
+    this->fft->transform(this->re.data(), this->im.data());
+    std::vector<uint32_t> power(TypeParam::BINS);
+    TypeParam::power(this->re.data(), this->im.data(), power.data());
+
+    // Expect: half the amplitude lands on the bin, the mirror holds the other half
+    EXPECT_NEAR(16384, this->re[bin], 64);
+    EXPECT_NEAR(16384, this->re[n - bin], 64);
+    for (size_t k = 0; k < TypeParam::BINS; ++k) {
+        if (k != bin) {
+            EXPECT_LT(power[k], 64U * 64U) << "bin " << k;
+        }
+    }
+}
+
+TYPED_TEST(FixedFftTest, Benchmark_TransformsPerSecond) {
+    // Arrange: noise-like input so the butterflies do real work
+    const size_t n = TestFixture::N;
+    std::array<int16_t, TestFixture::N> input{};
+    uint32_t seed = 1U;
+    for (size_t i = 0; i < n; ++i) {
+        seed = seed * 1664525U + 1013904223U;
+        input[i] = static_cast<int16_t>(seed >> 16U);
+    }
+    std::vector<uint32_t> power(TypeParam::BINS);
+    static constexpr int ROUNDS = 20000;
+
+    // Act
+    const auto start = std::chrono::steady_clock::now();
+    uint32_t sink = 0U;
+    for (int r = 0; r < ROUNDS; ++r) {
+        this->re = input;
+        this->im.fill(0);
+        this->fft->transform(this->re.data(), this->im.data());
+        TypeParam::power(this->re.data(), this->im.data(), power.data());
+        sink += power[1];
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Expect: far more than the display could ever ask for
+    const double perTransformUs = seconds * 1e6 / ROUNDS;
+    printf("[ FFT      ] %3zu points: %.2f us per transform and power (checksum %u)\n", n,
+           perTransformUs, sink);
+    EXPECT_LT(perTransformUs, 1000.0);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include "FixedFft.hpp"
+#include "gtest/gtest.h"
+
+template <typename Fft>
+class FixedFftTest : public ::testing::Test {
+   protected:
+    static constexpr size_t N = Fft::POINTS;
+
+    void SetUp() override {
+        fft = std::make_unique<Fft>();
+        re.fill(0);
+        im.fill(0);
+    }
+
+    void TearDown() override {
+        fft.reset();
+    }
+
+    std::unique_ptr<Fft> fft;
+    std::array<int16_t, N> re;
+    std::array<int16_t, N> im;
+};
+
+using FftSizes = ::testing::Types<player::FixedFft<64U>, player::FixedFft<128U>,
+                                  player::FixedFft<256U>>;
+TYPED_TEST_SUITE(FixedFftTest, FftSizes);
@@ -0,0 +1,214 @@
+#include "HttpSourceTest.hpp"
+
+#include <cstdio>
+
+// IDF
+#include <esp_timer.h>
+
+void HttpSourceTest::SetUp() {
+    redirector = std::make_unique<HttpStandIn>(HANDSHAKE_MS, REQUEST_MS);
+    streams = std::make_unique<HttpStandIn>(HANDSHAKE_MS, REQUEST_MS);
+    ASSERT_TRUE(redirector->start());
+    ASSERT_TRUE(streams->start());
+
+    streams->route("/a.aac", {200, "", std::string(BODY_SIZE, 'a')});
+    redirector->route("/redirect/a", {302, streams->url("/a.aac"), ""});
+    stationUrl = redirector->url("/redirect/a");
+
+    transport = std::make_unique<SocketHttpTransport>();
+    store = std::make_unique<common::FakeKeyValueStore>();
+    cache = std::make_unique<player::RedirectCache>(player::RedirectCache::DEFAULT_TTL_US,
+                                                    store.get());
+    ASSERT_TRUE(cache->init());
+}
+
+void HttpSourceTest::TearDown() {
+    cache.reset();
+    transport.reset();
+    streams->stop();
+    redirector->stop();
+}
+
+int64_t HttpSourceTest::timeToFirstByte(player::HttpSource &source) {
+    const int64_t startUs = esp_timer_get_time();
+    if (!source.open(stationUrl.c_str())) {
+        return -1;
+    }
+
+    uint8_t byte = 0U;
+    int32_t count = 0;
+    while ((count = source.read(&byte, 1U)) == 0) {
+    }
+    const int64_t firstByteUs = esp_timer_get_time() - startUs;
+    source.close();
+
+    return (count > 0) ? firstByteUs : -1;
+}
+
+std::string HttpSourceTest::readAll(player::HttpSource &source) {
+    std::string data;
+    uint8_t buffer[1024];
+    int32_t count = 0;
+    while ((count = source.read(buffer, sizeof(buffer))) >= 0) {
+        data.append(reinterpret_cast<const char *>(buffer), static_cast<size_t>(count));
+    }
+    return data;
+}
+
+TEST_F(HttpSourceTest, open_RedirectedStation_StreamsFromTargetAndRemembersIt) {
+    // Arrange
+    player::HttpSource source(*transport, cache.get());
+    player::RedirectCache::Url target{};
+
+    // Act
+    ASSERT_TRUE(source.open(stationUrl.c_str()));
+    const std::string body = readAll(source);
+    source.close();
+
+    // Expect
+    EXPECT_EQ(std::string(BODY_SIZE, 'a'), body);
+    EXPECT_EQ(streams->url("/a.aac"), source.getStreamUrl());
+    ASSERT_TRUE(cache->lookup(stationUrl.c_str(), esp_timer_get_time(), target));
+    EXPECT_EQ(streams->url("/a.aac"), target.data());
+    EXPECT_EQ(1U, store->size());
+}
+
+TEST_F(HttpSourceTest, open_RememberedStation_SkipsTheRedirector) {
+    // Arrange
+    player::HttpSource source(*transport, cache.get());
+    ASSERT_GT(timeToFirstByte(source), 0);
+
+    // Act
+    ASSERT_GT(timeToFirstByte(source), 0);
+
+    // Expect
+    EXPECT_EQ(1, redirector->requests("/redirect/a"));
+    EXPECT_EQ(2, streams->requests("/a.aac"));
+}
+
+TEST_F(HttpSourceTest, open_RememberedTargetGone_FallsBackToStationUrl) {
+    // Arrange: the stream moved after it was remembered
+    player::HttpSource source(*transport, cache.get());
+    ASSERT_GT(timeToFirstByte(source), 0);
+    streams->route("/a.aac", {404, "", ""});
+    streams->route("/a2.aac", {200, "", std::string(BODY_SIZE, 'b')});
+    redirector->route("/redirect/a", {302, streams->url("/a2.aac"), ""});
+
+    // Act
+    ASSERT_TRUE(source.open(stationUrl.c_str()));
+    const std::string body = readAll(source);
+    source.close();
+
+    // Expect
+    EXPECT_EQ(std::string(BODY_SIZE, 'b'), body);
+    EXPECT_EQ(2, redirector->requests("/redirect/a"));
+    player::RedirectCache::Url target{};
+    ASSERT_TRUE(cache->lookup(stationUrl.c_str(), esp_timer_get_time(), target));
+    EXPECT_EQ(streams->url("/a2.aac"), target.data());
+}
+
+TEST_F(HttpSourceTest, open_WithoutCache_ReusesTheKeptRedirectorConnection) {
+    // Arrange
+    player::HttpSource source(*transport);
+
+    // Act
+    ASSERT_GT(timeToFirstByte(source), 0);
+    ASSERT_GT(timeToFirstByte(source), 0);
+
+    // Expect: the redirector was asked twice over one connection; each stream was dropped
+    EXPECT_EQ(2, redirector->requests("/redirect/a"));
+    EXPECT_EQ(1, redirector->connections());
+    EXPECT_EQ(2, streams->connections());
+    EXPECT_EQ(1, transport->connectionsReused);
+}
+
+TEST_F(HttpSourceTest, open_RedirectLoop_GivesUp) {
+    // Arrange
+    redirector->route("/loop", {302, redirector->url("/loop"), ""});
+    player::HttpSource source(*transport, cache.get());
+
+    // Act
+    const bool opened = source.open(redirector->url("/loop").c_str());
+
+    // Expect
+    EXPECT_FALSE(opened);
+    EXPECT_EQ(player::HttpSource::MAX_REDIRECTS + 1, redirector->requests("/loop"));
+    EXPECT_EQ(0U, cache->size());
+}
+
+TEST_F(HttpSourceTest, open_AfterPreopen_TakesOverTheWaitingStream) {
+    // Arrange
+    player::HttpSource source(*transport, cache.get());
+    ASSERT_TRUE(source.preopen(stationUrl.c_str()));
+
+    // Act
+    ASSERT_TRUE(source.open(stationUrl.c_str()));
+    const std::string body = readAll(source);
+    source.close();
+
+    // Expect
+    EXPECT_EQ(std::string(BODY_SIZE, 'a'), body);
+    EXPECT_EQ(1, redirector->requests("/redirect/a"));
+    EXPECT_EQ(1, streams->requests("/a.aac"));
+}
+
+TEST_F(HttpSourceTest, open_OtherStationThanPreopened_OpensAfresh) {
+    // Arrange
+    streams->route("/b.aac", {200, "", std::string(BODY_SIZE, 'b')});
+    player::HttpSource source(*transport, cache.get());
+    ASSERT_TRUE(source.preopen(stationUrl.c_str()));
+
+    // Act
+    ASSERT_TRUE(source.open(streams->url("/b.aac").c_str()));
+    const std::string body = readAll(source);
+    source.close();
+
+    // Expect
+    EXPECT_EQ(std::string(BODY_SIZE, 'b'), body);
+    EXPECT_EQ(1, streams->requests("/b.aac"));
+}
+
+TEST_F(HttpSourceTest, open_AfterPreopenWasClosed_OpensAfresh) {
+    // Arrange
+    player::HttpSource source(*transport, cache.get());
+    ASSERT_TRUE(source.preopen(stationUrl.c_str()));
+    source.close();
+
+    // Act
+    ASSERT_TRUE(source.open(stationUrl.c_str()));
+    source.close();
+
+    // Expect
+    EXPECT_EQ(2, streams->requests("/a.aac"));
+}
+
+TEST_F(HttpSourceTest, Benchmark_TimeToFirstByte) {
+    // Arrange
+    player::HttpSource uncached(*transport);
+    SocketHttpTransport cachedTransport;
+    player::HttpSource cached(cachedTransport, cache.get());
+
+    // Act: first play ever, a later play with only keep-alive, a later play with the cache
+    const int64_t coldUs = timeToFirstByte(uncached);
+    const int coldConnections = redirector->connections();
+    const int64_t keptUs = timeToFirstByte(uncached);
+    const int keptConnections = redirector->connections();
+    const int keptRequests = redirector->requests("/redirect/a");
+    ASSERT_GT(timeToFirstByte(cached), 0);
+    const int warmRequests = redirector->requests("/redirect/a");
+    const int64_t cachedUs = timeToFirstByte(cached);
+
+    printf("[ RESOLVE  ] first byte after %.1f ms cold, %.1f ms with keep-alive, "
+           "%.1f ms cached (handshake %d ms, request %d ms)\n",
+           coldUs / 1000.0, keptUs / 1000.0, cachedUs / 1000.0, HANDSHAKE_MS, REQUEST_MS);
+
+    // Expect: keep-alive saves the redirector handshake, the cache the whole redirect. Counted
+    // on the stand-in rather than timed, so a loaded machine cannot fail it.
+    ASSERT_GT(coldUs, 0);
+    ASSERT_GT(keptUs, 0);
+    EXPECT_EQ(1, coldConnections);
+    EXPECT_EQ(coldConnections, keptConnections);
+    EXPECT_EQ(2, keptRequests);
+    EXPECT_GT(cachedUs, 0);
+    EXPECT_EQ(warmRequests, redirector->requests("/redirect/a"));
+}
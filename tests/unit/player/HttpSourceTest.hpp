@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "FakeKeyValueStore.hpp"
+#include "HttpSource.hpp"
+#include "HttpStandIn.hpp"
+#include "RedirectCache.hpp"
+#include "gtest/gtest.h"
+
+// A station URL on a redirector pointing at a stream on a second server, both local
+class HttpSourceTest : public ::testing::Test {
+   protected:
+    static constexpr int HANDSHAKE_MS = 30;
+    static constexpr int REQUEST_MS = 10;
+    static constexpr size_t BODY_SIZE = 4096U;
+
+    void SetUp() override;
+    void TearDown() override;
+
+    // Opens, reads until the first byte arrives and closes again. Microseconds from open to
+    // that byte, or -1 when nothing came.
+    int64_t timeToFirstByte(player::HttpSource &source);
+    std::string readAll(player::HttpSource &source);
+
+    std::unique_ptr<HttpStandIn> redirector;
+    std::unique_ptr<HttpStandIn> streams;
+    std::unique_ptr<SocketHttpTransport> transport;
+    std::unique_ptr<common::FakeKeyValueStore> store;
+    std::unique_ptr<player::RedirectCache> cache;
+    std::string stationUrl;
+};
@@ -0,0 +1,343 @@
+#include "HttpStandIn.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <strings.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "IAudioSource.hpp"
+
+static bool sendAll(const int &fd, const std::string &data) {
+    size_t sent = 0U;
+    while (sent < data.size()) {
+        const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Reads until the blank line ending a head; whatever came after it stays in `rest`
+static bool readHead(const int &fd, std::string &head, std::string &rest) {
+    std::string data = rest;
+    while (data.find("\r\n\r\n") == std::string::npos) {
+        char buffer[512];
+        const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            return false;
+        }
+        data.append(buffer, static_cast<size_t>(n));
+    }
+    const size_t end = data.find("\r\n\r\n") + 4U;
+    head = data.substr(0, end);
+    rest = data.substr(end);
+    return true;
+}
+
+static std::string headerValue(const std::string &head, const std::string &name) {
+    size_t line = head.find("\r\n");
+    while (line != std::string::npos && line + 2U < head.size()) {
+        const size_t start = line + 2U;
+        const size_t next = head.find("\r\n", start);
+        const std::string field = head.substr(start, next - start);
+        const size_t colon = field.find(':');
+        if (colon != std::string::npos && strncasecmp(field.c_str(), name.c_str(), colon) == 0 &&
+            colon == name.size()) {
+            const size_t value = field.find_first_not_of(' ', colon + 1U);
+            return (value == std::string::npos) ? std::string() : field.substr(value);
+        }
+        line = next;
+    }
+    return std::string();
+}
+
+static void sleepMs(const int &ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+HttpStandIn::HttpStandIn(const int &handshakeMs, const int &requestMs)
+    : mHandshakeMs(handshakeMs),
+      mRequestMs(requestMs),
+      mListenFd(-1),
+      mPort(0U),
+      mRunning(false),
+      mConnections(0) {}
+
+HttpStandIn::~HttpStandIn() {
+    stop();
+}
+
+bool HttpStandIn::start() {
+    mListenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (mListenFd < 0) {
+        return false;
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;  // any free port
+    socklen_t len = sizeof(address);
+    if (::bind(mListenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        ::listen(mListenFd, 8) != 0 ||
+        ::getsockname(mListenFd, reinterpret_cast<sockaddr *>(&address), &len) != 0) {
+        ::close(mListenFd);
+        mListenFd = -1;
+        return false;
+    }
+    mPort = ntohs(address.sin_port);
+
+    mRunning = true;
+    mAcceptThread = std::thread([this] { acceptLoop(); });
+    return true;
+}
+
+void HttpStandIn::stop() {
+    if (!mRunning.exchange(false)) {
+        return;
+    }
+
+    ::shutdown(mListenFd, SHUT_RDWR);
+    ::close(mListenFd);
+    mAcceptThread.join();
+
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (const int fd : mClientFds) {
+            ::shutdown(fd, SHUT_RDWR);
+        }
+        threads.swap(mClientThreads);
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+std::string HttpStandIn::url(const std::string &path) const {
+    return "http://127.0.0.1:" + std::to_string(mPort) + path;
+}
+
+void HttpStandIn::route(const std::string &path, const Route &response) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRoutes[path] = response;
+}
+
+int HttpStandIn::requests(const std::string &path) const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto count = mRequests.find(path);
+    return (count == mRequests.end()) ? 0 : count->second;
+}
+
+int HttpStandIn::connections() const {
+    return mConnections.load();
+}
+
+void HttpStandIn::acceptLoop() {
+    while (mRunning) {
+        const int fd = ::accept(mListenFd, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mRunning) {
+            ::close(fd);
+            break;
+        }
+        ++mConnections;
+        mClientFds.push_back(fd);
+        mClientThreads.emplace_back([this, fd] { serve(fd); });
+    }
+}
+
+void HttpStandIn::serve(const int &fd) {
+    const int noDelay = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    sleepMs(mHandshakeMs);
+
+    std::string head;
+    std::string rest;
+    while (mRunning && readHead(fd, head, rest)) {
+        const size_t pathStart = head.find(' ') + 1U;
+        const std::string path = head.substr(pathStart, head.find(' ', pathStart) - pathStart);
+
+        Route response;
+        response.status = 404;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ++mRequests[path];
+            const auto route = mRoutes.find(path);
+            if (route != mRoutes.end()) {
+                response = route->second;
+            }
+        }
+        sleepMs(mRequestMs);
+
+        std::string reply = "HTTP/1.1 " + std::to_string(response.status) + " Stand-in\r\n";
+        if (!response.location.empty()) {
+            reply += "Location: " + response.location + "\r\n";
+        }
+        reply += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+        reply += "Connection: keep-alive\r\n\r\n" + response.body;
+        if (!sendAll(fd, reply)) {
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mClientFds.erase(std::find(mClientFds.begin(), mClientFds.end(), fd));
+    ::close(fd);
+}
+
+SocketHttpTransport::~SocketHttpTransport() {
+    for (Connection &connection : mPool) {
+        drop(connection);
+    }
+}
+
+bool SocketHttpTransport::request(const char *url, player::HttpResponseHead &head) {
+    if (mActive != nullptr) {
+        finish(false);
+    }
+
+    // http://host:port/path
+    const std::string text(url);
+    const size_t hostStart = text.find("://") + 3U;
+    const size_t pathStart = text.find('/', hostStart);
+    const std::string origin = text.substr(0, pathStart);
+    const std::string hostPort = text.substr(hostStart, pathStart - hostStart);
+    const size_t colon = hostPort.find(':');
+    const std::string host = hostPort.substr(0, colon);
+    const uint16_t port = static_cast<uint16_t>(std::stoi(hostPort.substr(colon + 1U)));
+    const std::string path = text.substr(pathStart);
+
+    Connection &connection = connectionFor(origin);
+    connection.lastUsed = ++mUses;
+    mActive = &connection;
+
+    const bool reused = connection.fd >= 0;
+    if (exchange(connection, host, port, path, head)) {
+        connectionsReused += reused ? 1 : 0;
+        return true;
+    }
+    if (!reused) {
+        return false;
+    }
+    drop(connection);
+    connection.origin = origin;
+    return exchange(connection, host, port, path, head);
+}
+
+int32_t SocketHttpTransport::read(uint8_t *dst, const size_t &len) {
+    if (mActive == nullptr || mActive->remaining == 0) {
+        return player::IAudioSource::END_OF_STREAM;
+    }
+
+    Connection &connection = *mActive;
+    size_t count = 0U;
+    if (!connection.pending.empty()) {
+        count = std::min(len, connection.pending.size());
+        std::memcpy(dst, connection.pending.data(), count);
+        connection.pending.erase(0, count);
+    } else {
+        const ssize_t n = ::recv(connection.fd, dst, len, 0);
+        if (n <= 0) {
+            return player::IAudioSource::END_OF_STREAM;
+        }
+        count = static_cast<size_t>(n);
+    }
+
+    if (connection.remaining > 0) {
+        connection.remaining -= static_cast<int64_t>(count);
+    }
+    return static_cast<int32_t>(count);
+}
+
+void SocketHttpTransport::finish(const bool &reuse) {
+    if (mActive == nullptr) {
+        return;
+    }
+
+    Connection &connection = *mActive;
+    std::array<uint8_t, 512> sink;
+    while (reuse && connection.remaining > 0 && read(sink.data(), sink.size()) > 0) {
+    }
+    mActive = nullptr;
+
+    if (!reuse || connection.remaining != 0) {
+        const std::string origin = connection.origin;
+        drop(connection);
+        connection.origin = origin;
+    }
+}
+
+SocketHttpTransport::Connection &SocketHttpTransport::connectionFor(const std::string &origin) {
+    Connection *oldest = &mPool[0];
+    for (Connection &connection : mPool) {
+        if (connection.origin == origin) {
+            return connection;
+        }
+        if (connection.lastUsed < oldest->lastUsed) {
+            oldest = &connection;
+        }
+    }
+    drop(*oldest);
+    oldest->origin = origin;
+    return *oldest;
+}
+
+bool SocketHttpTransport::exchange(Connection &connection, const std::string &host,
+                                   const uint16_t &port, const std::string &path,
+                                   player::HttpResponseHead &head) {
+    if (connection.fd < 0) {
+        connection.fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        ::inet_pton(AF_INET, host.c_str(), &address.sin_addr);
+        if (::connect(connection.fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) !=
+            0) {
+            drop(connection);
+            return false;
+        }
+        const int noDelay = 1;
+        ::setsockopt(connection.fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        ++connectionsOpened;
+    }
+
+    const std::string request = "GET " + path + " HTTP/1.1\r\nHost: " + host +
+                                "\r\nConnection: keep-alive\r\n\r\n";
+    std::string response;
+    connection.pending.clear();
+    if (!sendAll(connection.fd, request) ||
+        !readHead(connection.fd, response, connection.pending)) {
+        return false;
+    }
+
+    head = player::HttpResponseHead();
+    head.status = std::atoi(response.c_str() + response.find(' ') + 1U);
+    const std::string length = headerValue(response, "Content-Length");
+    head.contentLength = length.empty() ? -1 : std::stoll(length);
+    const std::string location = headerValue(response, "Location");
+    std::strncpy(head.location.data(), location.c_str(), head.location.size() - 1U);
+
+    connection.remaining = head.contentLength;
+    return true;
+}
+
+void SocketHttpTransport::drop(Connection &connection) {
+    if (connection.fd >= 0) {
+        ::close(connection.fd);
+    }
+    connection = Connection();
+}
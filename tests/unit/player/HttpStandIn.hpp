@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "IHttpTransport.hpp"
+
+// Plain-HTTP server on 127.0.0.1 standing in for a redirector or a stream server. Every new
+// connection waits handshakeMs first, like TCP plus TLS would, and every request requestMs,
+// like a round trip. Connections are kept alive.
+class HttpStandIn {
+   public:
+    struct Route {
+        int status = 200;
+        std::string location;  // for redirects
+        std::string body;
+    };
+
+    HttpStandIn(const int &handshakeMs, const int &requestMs);
+    ~HttpStandIn();
+
+    bool start();
+    void stop();
+
+    std::string url(const std::string &path) const;
+    // Unknown paths answer 404
+    void route(const std::string &path, const Route &response);
+
+    int requests(const std::string &path) const;
+    int connections() const;
+
+   private:
+    void acceptLoop();
+    void serve(const int &fd);
+
+    int mHandshakeMs;
+    int mRequestMs;
+    int mListenFd;
+    uint16_t mPort;
+    std::atomic<bool> mRunning;
+    std::atomic<int> mConnections;
+    std::thread mAcceptThread;
+
+    mutable std::mutex mMutex;
+    std::map<std::string, Route> mRoutes;
+    std::map<std::string, int> mRequests;
+    std::vector<int> mClientFds;
+    std::vector<std::thread> mClientThreads;
+};
+
+// The host side of IHttpTransport: blocking sockets, plain HTTP, one kept connection per
+// origin like EspHttpTransport
+class SocketHttpTransport final : public player::IHttpTransport {
+   public:
+    static constexpr size_t POOL_SIZE = 2U;
+
+    ~SocketHttpTransport() override;
+
+    bool request(const char *url, player::HttpResponseHead &head) override;
+    int32_t read(uint8_t *dst, const size_t &len) override;
+    void finish(const bool &reuse) override;
+
+    int connectionsOpened = 0;
+    int connectionsReused = 0;
+
+   private:
+    struct Connection {
+        int fd = -1;
+        std::string origin;
+        uint64_t lastUsed = 0U;
+        std::string pending;      // body bytes read along with the head
+        int64_t remaining = -1;   // body bytes not yet read, -1 until the connection closes
+    };
+
+    Connection &connectionFor(const std::string &origin);
+    bool exchange(Connection &connection, const std::string &host, const uint16_t &port,
+                  const std::string &path, player::HttpResponseHead &head);
+    static void drop(Connection &connection);
+
+    std::array<Connection, POOL_SIZE> mPool;
+    Connection *mActive = nullptr;
+    uint64_t mUses = 0U;
+};
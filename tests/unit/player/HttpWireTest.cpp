@@ -0,0 +1,144 @@
+#include "HttpWireTest.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using player::HttpWire;
+
+std::string HttpWireTest::parse(const std::string &response, const size_t &step) {
+    std::string body;
+    size_t offset = 0U;
+    while (offset < response.size()) {
+        const size_t len = std::min(step, response.size() - offset);
+        std::vector<uint8_t> piece(response.begin() + offset, response.begin() + offset + len);
+        offset += len;
+
+        size_t used = 0U;
+        if (!parser.isHeadDone()) {
+            used = parser.feedHead(reinterpret_cast<const char *>(piece.data()), piece.size());
+        }
+        if (parser.isHeadDone() && used < piece.size()) {
+            const size_t decoded = parser.decodeBody(&piece[used], piece.size() - used);
+            body.append(reinterpret_cast<const char *>(&piece[used]), decoded);
+        }
+    }
+    return body;
+}
+
+TEST_F(HttpWireTest, parseUrl_HttpsWithoutPort_DefaultsTo443) {
+    // Act
+    const bool ok = HttpWire::parseUrl("https://ice.example/live/a.aac", parts);
+
+    // Expect
+    ASSERT_TRUE(ok);
+    EXPECT_TRUE(parts.secure);
+    EXPECT_STREQ("ice.example", parts.host.data());
+    EXPECT_EQ(443U, parts.port);
+    EXPECT_STREQ("/live/a.aac", parts.path);
+}
+
+TEST_F(HttpWireTest, parseUrl_HttpWithPortNoPath_RootPath) {
+    // Act
+    const bool ok = HttpWire::parseUrl("http://10.0.0.2:8000", parts);
+
+    // Expect
+    ASSERT_TRUE(ok);
+    EXPECT_FALSE(parts.secure);
+    EXPECT_STREQ("10.0.0.2", parts.host.data());
+    EXPECT_EQ(8000U, parts.port);
+    EXPECT_STREQ("/", parts.path);
+}
+
+TEST_F(HttpWireTest, parseUrl_OtherScheme_Fails) {
+    // Expect
+    EXPECT_FALSE(HttpWire::parseUrl("ftp://host/file", parts));
+    EXPECT_FALSE(HttpWire::parseUrl("http://:80/", parts));
+}
+
+TEST_F(HttpWireTest, formatOrigin_IncludesDefaultPort) {
+    // Arrange
+    ASSERT_TRUE(HttpWire::parseUrl("https://ice.example/live", parts));
+    char origin[64];
+
+    // Act
+    const size_t len = HttpWire::formatOrigin(parts, origin, sizeof(origin));
+
+    // Expect
+    EXPECT_STREQ("https://ice.example:443", origin);
+    EXPECT_EQ(23U, len);
+}
+
+TEST_F(HttpWireTest, formatRequest_TooSmall_ReturnsZero) {
+    // Arrange
+    ASSERT_TRUE(HttpWire::parseUrl("https://ice.example/live", parts));
+    char request[16];
+
+    // Expect
+    EXPECT_EQ(0U, HttpWire::formatRequest(parts, request, sizeof(request)));
+}
+
+TEST_F(HttpWireTest, parser_ContentLength_BodyCompleteAndKeepAlive) {
+    // Act
+    const std::string body =
+        parse("HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello", 3U);
+
+    // Expect
+    EXPECT_EQ("hello", body);
+    EXPECT_EQ(200, parser.getHead().status);
+    EXPECT_EQ(5, parser.getHead().contentLength);
+    EXPECT_TRUE(parser.isBodyComplete());
+    EXPECT_TRUE(parser.isKeepAlive());
+}
+
+TEST_F(HttpWireTest, parser_Chunked_StripsFramingAcrossPieces) {
+    // Act
+    const std::string body = parse(
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+        "4;ext=1\r\nWiki\r\n6\r\npedia \r\nE\r\nin \r\n\r\nchunks.\r\n0\r\n\r\n",
+        5U);
+
+    // Expect
+    EXPECT_EQ("Wikipedia in \r\n\r\nchunks.", body);
+    EXPECT_TRUE(parser.isBodyComplete());
+    EXPECT_TRUE(parser.isKeepAlive());
+}
+
+TEST_F(HttpWireTest, parser_Redirect_KeepsLocation) {
+    // Act
+    parse("HTTP/1.1 302 Found\r\nlocation: https://s1.example/a\r\nContent-Length: 0\r\n\r\n",
+          64U);
+
+    // Expect
+    EXPECT_EQ(302, parser.getHead().status);
+    EXPECT_STREQ("https://s1.example/a", parser.getHead().location.data());
+    EXPECT_TRUE(parser.isBodyComplete());
+}
+
+TEST_F(HttpWireTest, parser_NoLength_OpenEndedAndNotReusable) {
+    // Act
+    const std::string body = parse("ICY 200 OK\r\nicy-name: Radio\r\n\r\nabcdef", 4U);
+
+    // Expect: a stream body runs until the connection closes
+    EXPECT_EQ("abcdef", body);
+    EXPECT_EQ(-1, parser.getHead().contentLength);
+    EXPECT_FALSE(parser.isBodyComplete());
+    EXPECT_FALSE(parser.isKeepAlive());
+}
+
+TEST_F(HttpWireTest, parser_ConnectionClose_NotReusable) {
+    // Act
+    parse("HTTP/1.1 200 OK\r\nContent-Length: 2\r\nConnection: close\r\n\r\nok", 64U);
+
+    // Expect
+    EXPECT_TRUE(parser.isBodyComplete());
+    EXPECT_FALSE(parser.isKeepAlive());
+}
+
+TEST_F(HttpWireTest, parser_Garbage_Fails) {
+    // Act
+    parse("SSH-2.0-OpenSSH\r\n\r\n", 64U);
+
+    // Expect
+    EXPECT_TRUE(parser.hasFailed());
+    EXPECT_FALSE(parser.isHeadDone());
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+
+#include "HttpWire.hpp"
+#include "gtest/gtest.h"
+
+class HttpWireTest : public ::testing::Test {
+   protected:
+    // Feeds the head, then the rest in pieces of `step` bytes; returns the decoded body
+    std::string parse(const std::string &response, const size_t &step);
+
+    player::UrlParts parts;
+    player::HttpResponseParser parser;
+};
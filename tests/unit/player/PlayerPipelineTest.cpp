@@ -0,0 +1,675 @@
+#include "PlayerPipelineTest.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "NullSink.hpp"
+#include "Resampler.hpp"
+#include "TestWav.hpp"
+
+// IDF
+#include <esp_timer.h>
+
+bool RecordingSink::configure(const player::AudioFormat &newFormat) {
+    format = newFormat;
+    ++configures;
+    return true;
+}
+
+void RecordingSink::write(const int16_t *pcm, const size_t &count) {
+    const int64_t nowUs = esp_timer_get_time();
+    if (lastWriteUs != 0 && nowUs - lastWriteUs > maxGapUs) {
+        maxGapUs = nowUs - lastWriteUs;
+    }
+    lastWriteUs = nowUs;
+    if (paced && format.sampleRate > 0U) {
+        std::this_thread::sleep_for(std::chrono::microseconds(count * 1000000U /
+                                                              format.sampleRate));
+    }
+
+    const size_t sampleCount = count * format.channels;
+    if (keepSamples) {
+        samples.insert(samples.end(), pcm, pcm + sampleCount);
+    }
+    frames += count;
+
+    if (sampleCount > 0U && pcm[0] != lastValue.load()) {
+        changedUs = esp_timer_get_time();
+        lastValue = pcm[0];
+    }
+}
+
+void RecordingSink::stop() {
+    ++stops;
+}
+
+bool CountingSource::open(const char *url) {
+    opened.emplace_back(url);
+    reads.push_back(0);
+    if (openDelayMs > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(openDelayMs));
+    }
+    if (onOpen) {
+        onOpen();
+    }
+    return file.open(url);
+}
+
+int32_t CountingSource::read(uint8_t *dst, const size_t &len) {
+    ++reads.back();
+    if (readDelayUs > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(readDelayUs));
+    }
+    return file.read(dst, len);
+}
+
+void CountingSource::close() {
+    file.close();
+}
+
+player::BufferWindow ScriptedTelemetry::takeWindow() {
+    const player::BufferWindow window = next;
+    next = player::BufferWindow();
+    ++windowsTaken;
+    return window;
+}
+
+void ScriptedTelemetry::applySettings(const player::BufferSettings &settings) {
+    applied = settings;
+}
+
+void PlayerPipelineTest::SetUp() {
+    ringStorage.resize(RING_SIZE);
+    ring = std::make_unique<player::ByteRing>(ringStorage.data(), ringStorage.size());
+    source = std::make_unique<CountingSource>();
+    standbyRingStorage.resize(RING_SIZE);
+    standbyRing =
+        std::make_unique<player::ByteRing>(standbyRingStorage.data(), standbyRingStorage.size());
+    standbySource = std::make_unique<CountingSource>();
+    decoder = std::make_unique<player::WavDecoder>();
+    sink = std::make_unique<RecordingSink>();
+    pipeline = std::make_unique<player::PlayerPipeline>(*source, *decoder, *sink, *ring);
+}
+
+void PlayerPipelineTest::TearDown() {
+    stopThreads();
+    pipeline.reset();
+    sink.reset();
+    decoder.reset();
+    standbySource.reset();
+    standbyRing.reset();
+    source.reset();
+    ring.reset();
+    for (const std::string &path : files) {
+        std::remove(path.c_str());
+    }
+}
+
+std::string PlayerPipelineTest::writeWav(const std::string &name, const uint32_t &rate,
+                                         const uint16_t &channels, const size_t &frames,
+                                         const int16_t &value) {
+    const std::string path =
+        ::testing::TempDir() +
+        ::testing::UnitTest::GetInstance()->current_test_info()->name() + "_" +
+        std::to_string(getpid()) + "_" + name;
+    test_wav::write(path, test_wav::build(rate, channels,
+                                          std::vector<int16_t>(frames * channels, value)));
+    files.push_back(path);
+    return path;
+}
+
+void PlayerPipelineTest::runUntilIdle() {
+    bool busy = true;
+    while (busy) {
+        busy = pipeline->runSourceStep();
+        busy = pipeline->runDecodeStep() || busy;
+        busy = pipeline->runStandbyStep() || busy;
+    }
+}
+
+void PlayerPipelineTest::runWithoutStandby(const int &steps) {
+    for (int i = 0; i < steps; ++i) {
+        pipeline->runSourceStep();
+        pipeline->runDecodeStep();
+    }
+}
+
+void PlayerPipelineTest::playWithStandby(const std::string &path) {
+    pipeline->setStandby(*standbySource, *standbyRing);
+    ASSERT_TRUE(pipeline->play(path.c_str()));
+    runWithoutStandby(20);
+    ASSERT_EQ(player::PlayerState::Playing, pipeline->getState());
+    ASSERT_GT(sink->samples.size(), 0U);
+}
+
+void PlayerPipelineTest::startThreads(player::PlayerPipeline &target) {
+    running = true;
+    sourceThread = std::thread([this, &target] {
+        while (running) {
+            if (!target.runSourceStep()) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    decodeThread = std::thread([this, &target] {
+        while (running) {
+            if (!target.runDecodeStep()) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    standbyThread = std::thread([this, &target] {
+        while (running) {
+            if (!target.runStandbyStep()) {
+                std::this_thread::yield();
+            }
+        }
+    });
+}
+
+void PlayerPipelineTest::stopThreads() {
+    running = false;
+    if (sourceThread.joinable()) {
+        sourceThread.join();
+    }
+    if (decodeThread.joinable()) {
+        decodeThread.join();
+    }
+    if (standbyThread.joinable()) {
+        standbyThread.join();
+    }
+}
+
+bool PlayerPipelineTest::waitUntil(const std::function<bool()> &done) {
+    const int64_t deadlineUs = esp_timer_get_time() + WAIT_TIMEOUT_US;
+    while (!done()) {
+        if (esp_timer_get_time() > deadlineUs) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+TEST_F(PlayerPipelineTest, play_WavFile_ReachesSinkUnchanged) {
+    // Arrange
+    const std::string path = writeWav("pipeline_a.wav", 44100U, 2U, 10000U, VALUE_A);
+
+    // Act
+    ASSERT_TRUE(pipeline->play(path.c_str()));
+    runUntilIdle();
+
+    // Expect
+    EXPECT_EQ(player::PlayerState::Ended, pipeline->getState());
+    EXPECT_EQ(44100U, sink->format.sampleRate);
+    EXPECT_EQ(2U, sink->format.channels);
+    EXPECT_EQ(1, sink->configures.load());
+    EXPECT_EQ(20000U, sink->samples.size());
+    EXPECT_TRUE(std::all_of(sink->samples.begin(), sink->samples.end(),
+                            [](const int16_t sample) { return sample == VALUE_A; }));
+}
+
+TEST_F(PlayerPipelineTest, stop_WhilePlaying_StopsSinkAndDropsBufferedAudio) {
+    // Arrange: fill the ring without letting the decoder drain it
+    const std::string path = writeWav("pipeline_a.wav", 44100U, 2U, 50000U, VALUE_A);
+    pipeline->play(path.c_str());
+    pipeline->runSourceStep();
+    pipeline->runDecodeStep();  // picks up the new stream
+    while (pipeline->runSourceStep()) {
+    }
+    pipeline->runDecodeStep();  // first audio, the sink starts
+    const uint64_t framesBefore = sink->frames;
+
+    // Act
+    ASSERT_TRUE(pipeline->stop());
+    runUntilIdle();
+
+    // Expect
+    EXPECT_GT(framesBefore, 0U);
+    EXPECT_EQ(framesBefore, sink->frames.load());
+    EXPECT_EQ(1, sink->stops.load());
+    EXPECT_EQ(0U, ring->size());
+    EXPECT_EQ(player::PlayerState::Stopped, pipeline->getState());
+}
+
+TEST_F(PlayerPipelineTest, switchTo_KeepsSinkRunningAndPlaysOnlyTheNewStream) {
+    // Arrange
+    const std::string pathA = writeWav("pipeline_a.wav", 44100U, 2U, 50000U, VALUE_A);
+    const std::string pathB = writeWav("pipeline_b.wav", 44100U, 2U, 3000U, VALUE_B);
+    pipeline->play(pathA.c_str());
+    for (int i = 0; i < 20; ++i) {
+        pipeline->runSourceStep();
+        pipeline->runDecodeStep();
+    }
+    const size_t samplesOfA = sink->samples.size();
+
+    // Act
+    ASSERT_TRUE(pipeline->switchTo(pathB.c_str()));
+    runUntilIdle();
+
+    // Expect: the same sink session carries on with B and nothing of A after it
+    ASSERT_GT(samplesOfA, 0U);
+    EXPECT_EQ(0, sink->stops.load());
+    EXPECT_EQ(1, sink->configures.load());
+    ASSERT_EQ(samplesOfA + 6000U, sink->samples.size());
+    EXPECT_TRUE(std::all_of(sink->samples.begin() + samplesOfA, sink->samples.end(),
+                            [](const int16_t sample) { return sample == VALUE_B; }));
+}
+
+TEST_F(PlayerPipelineTest, play_CommandsQueuedTogether_OnlyNewestStreamIsOpened) {
+    // Arrange
+    const std::string pathA = writeWav("pipeline_a.wav", 44100U, 2U, 100U, VALUE_A);
+    const std::string pathB = writeWav("pipeline_b.wav", 22050U, 1U, 100U, VALUE_B);
+
+    // Act
+    pipeline->play(pathA.c_str());
+    pipeline->switchTo(pathA.c_str());
+    pipeline->play(pathB.c_str());
+    runUntilIdle();
+
+    // Expect
+    EXPECT_EQ(std::vector<std::string>{pathB}, source->opened);
+    EXPECT_EQ(22050U, sink->format.sampleRate);
+    EXPECT_EQ(100U, sink->samples.size());
+}
+
+TEST_F(PlayerPipelineTest, play_ManyCommandsWhileSourceIsBusy_NewestWins) {
+    // Arrange: far more presses than the source side could queue while it is stuck opening
+    const std::string pathA = writeWav("pipeline_a.wav", 44100U, 2U, 100U, VALUE_A);
+    const std::string pathB = writeWav("pipeline_b.wav", 22050U, 1U, 100U, VALUE_B);
+
+    // Act
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_TRUE(pipeline->switchTo(pathA.c_str()));
+        ASSERT_TRUE(pipeline->stop());
+    }
+    ASSERT_TRUE(pipeline->switchTo(pathB.c_str()));
+    runUntilIdle();
+
+    // Expect: only the last target opened, and the stops in between still restarted the sink
+    EXPECT_EQ(std::vector<std::string>{pathB}, source->opened);
+    EXPECT_EQ(22050U, sink->format.sampleRate);
+    EXPECT_EQ(100U, sink->samples.size());
+}
+
+TEST_F(PlayerPipelineTest, play_MissingFile_FailsWithoutStartingSink) {
+    // Act
+    pipeline->play("/nonexistent/stream.wav");
+    runUntilIdle();
+
+    // Expect
+    EXPECT_EQ(player::PlayerState::Failed, pipeline->getState());
+    EXPECT_EQ(0, sink->configures.load());
+}
+
+TEST_F(PlayerPipelineTest, setVolume_Half_ScalesByTheSquareLaw) {
+    // Arrange
+    const std::string path = writeWav("pipeline_a.wav", 48000U, 1U, 64U, VALUE_A);
+
+    // Act
+    pipeline->setVolume(50);
+    pipeline->play(path.c_str());
+    runUntilIdle();
+
+    // Expect
+    ASSERT_EQ(64U, sink->samples.size());
+    EXPECT_EQ(VALUE_A / 4, sink->samples.front());
+}
+
+TEST_F(PlayerPipelineTest, addPcmStage_Resampler_KeepsSinkAtOneRateAcrossStations) {
+    // Arrange
+    player::Resampler resampler(48000U);
+    ASSERT_TRUE(pipeline->addPcmStage(resampler));
+    const std::string pathA = writeWav("pipeline_a.wav", 44100U, 2U, 4410U, VALUE_A);
+    const std::string pathB = writeWav("pipeline_b.wav", 22050U, 2U, 2205U, VALUE_B);
+
+    // Act
+    pipeline->play(pathA.c_str());
+    runUntilIdle();
+    pipeline->switchTo(pathB.c_str());
+    runUntilIdle();
+
+    // Expect: the sink never retunes, and B came out at B's level
+    EXPECT_EQ(48000U, sink->format.sampleRate);
+    EXPECT_EQ(1, sink->configures.load());
+    ASSERT_FALSE(sink->samples.empty());
+    EXPECT_EQ(VALUE_B, sink->samples.back());
+}
+
+TEST_F(PlayerPipelineTest, setBufferTuning_DecodeAhead_HoldsFirstFrameUntilReserveIsBuffered) {
+    // Arrange
+    player::BufferTuner tuner(player::BufferTuner::DEFAULT_BOUNDS, {6U, 240U, 8192U});
+    ScriptedTelemetry telemetry;
+    pipeline->setBufferTuning(&tuner, &telemetry);
+    const std::string path = writeWav("pipeline_a.wav", 44100U, 2U, 10000U, VALUE_A);
+
+    // Act: one chunk in, one decode attempt, until audio comes out
+    pipeline->play(path.c_str());
+    size_t bufferedAtStart = 0U;
+    for (int i = 0; i < 64 && sink->frames.load() == 0U; ++i) {
+        pipeline->runSourceStep();
+        bufferedAtStart = ring->size();
+        pipeline->runDecodeStep();
+    }
+
+    // Expect
+    EXPECT_EQ(8192U, pipeline->getDecodeAheadBytes());
+    EXPECT_EQ(tuner.getSettings(), telemetry.applied);
+    EXPECT_GT(sink->frames.load(), 0U);
+    EXPECT_GE(bufferedAtStart, 8192U);
+}
+
+TEST_F(PlayerPipelineTest, setBufferTuning_UnderrunWindow_AppliesGrownSettings) {
+    // Arrange: a window per write, the first one after the sink starts is discarded
+    player::BufferTuner tuner(player::BufferTuner::DEFAULT_BOUNDS,
+                              player::BufferTuner::DEFAULT_SETTINGS);
+    ScriptedTelemetry telemetry;
+    pipeline->setBufferTuning(&tuner, &telemetry, 0);
+    const std::string path = writeWav("pipeline_a.wav", 44100U, 2U, 10000U, VALUE_A);
+    pipeline->play(path.c_str());
+    for (int i = 0; i < 64 && telemetry.windowsTaken < 2; ++i) {
+        pipeline->runSourceStep();
+        pipeline->runDecodeStep();
+    }
+    ASSERT_EQ(2, telemetry.windowsTaken);
+
+    // Act
+    telemetry.next = {2U, 0U};
+    runUntilIdle();
+
+    // Expect: grown at once; the clean windows after it give some back, and the sink always
+    // runs on what the tuner last decided
+    ASSERT_GE(tuner.getHistoryCount(), 2U);
+    EXPECT_EQ(player::BufferTuner::Reason::Underrun, tuner.getHistory(1U).reason);
+    EXPECT_EQ(9U, tuner.getHistory(1U).settings.dmaDescriptors);
+    EXPECT_EQ(16384U, tuner.getHistory(1U).settings.decodeAheadBytes);
+    EXPECT_EQ(tuner.getSettings(), telemetry.applied);
+    EXPECT_EQ(tuner.getSettings().decodeAheadBytes, pipeline->getDecodeAheadBytes());
+    EXPECT_EQ(20000U, sink->samples.size());
+}
+
+TEST_F(PlayerPipelineTest, switchTo_WithStandby_KeepsPlayingUntilNewStreamIsBuffered) {
+    // Arrange
+    const std::string pathA = writeWav("pipeline_a.wav", 44100U, 2U, 50000U, VALUE_A);
+    const std::string pathB = writeWav("pipeline_b.wav", 44100U, 2U, 3000U, VALUE_B);
+    playWithStandby(pathA);
+    const size_t samplesBefore = sink->samples.size();
+
+    // Act: the standby side is still connecting
+    ASSERT_TRUE(pipeline->switchTo(pathB.c_str()));
+    runWithoutStandby(20);
+
+    // Expect: A carried on, B was handed over but nothing of it played yet
+    EXPECT_GT(sink->samples.size(), samplesBefore);
+    ASSERT_FALSE(sink->samples.empty());
+    EXPECT_EQ(VALUE_A, sink->samples.back());
+    EXPECT_EQ(player::PlayerState::Playing, pipeline->getState());
+    EXPECT_TRUE(standbySource->opened.empty());
+
+    // Act: now it connects and buffers
+    runUntilIdle();
+
+    // Expect: one sink session, A then B, and all of B
+    EXPECT_EQ((std::vector<std::string>{pathB}), standbySource->opened);
+    EXPECT_EQ(0, sink->stops.load());
+    EXPECT_EQ(1, sink->configures.load());
+    ASSERT_FALSE(sink->samples.empty());
+    EXPECT_EQ(VALUE_B, sink->samples.back());
+    EXPECT_EQ(6000, std::count_if(sink->samples.begin(), sink->samples.end(),
+                                  [](const int16_t sample) { return sample <= 0; }));
+    EXPECT_EQ(player::PlayerState::Ended, pipeline->getState());
+}
+
+TEST_F(PlayerPipelineTest, switchTo_WithStandby_FadesAcrossTheCutover) {
+    // Arrange
+    const std::string pathA = writeWav("pipeline_a.wav", 44100U, 2U, 50000U, VALUE_A);
+    const std::string pathB = writeWav("pipeline_b.wav", 44100U, 2U, 3000U, VALUE_B);
+    playWithStandby(pathA);
+    const size_t start = sink->samples.size();
+
+    // Act: A has a full ring behind it when B is ready, as it would while streaming
+    ASSERT_TRUE(pipeline->switchTo(pathB.c_str()));
+    while (pipeline->runSourceStep()) {
+    }
+    while (pipeline->runStandbyStep()) {
+    }
+    runUntilIdle();
+
+    // Expect: A ramps down to silence and B up from it, no step between samples is larger
+    // than one step of the ramp
+    const auto &samples = sink->samples;
+    const int rampStep = VALUE_A / static_cast<int>(player::PlayerPipeline::FADE_FRAMES) + 1;
+    int largestStep = 0;
+    for (size_t i = start + 2U; i < samples.size(); ++i) {
+        largestStep = std::max(largestStep, std::abs(samples[i] - samples[i - 2U]));
+    }
+    EXPECT_LE(largestStep, rampStep);
+    EXPECT_TRUE(std::any_of(samples.begin() + start, samples.end(), [](const int16_t sample) {
+        return sample > 0 && sample < VALUE_A / 2;
+    }));
+    EXPECT_TRUE(std::any_of(samples.begin() + start, samples.end(), [](const int16_t sample) {
+        return sample < 0 && sample > VALUE_B / 2;
+    }));
+}
+
+TEST_F(PlayerPipelineTest, switchTo_SupersededWhileConnecting_DropsItUnread) {
+    // Arrange: the user presses again while B is being connected
+    const std::string pathA = writeWav("pipeline_a.wav", 44100U, 2U, 50000U, VALUE_A);
+    const std::string pathB = writeWav("pipeline_b.wav", 44100U, 2U, 3000U, VALUE_B);
+    const std::string pathC = writeWav("pipeline_c.wav", 44100U, 2U, 3000U, VALUE_B);
+    playWithStandby(pathA);
+    standbySource->onOpen = [this, &pathC] {
+        standbySource->onOpen = nullptr;
+        pipeline->switchTo(pathC.c_str());
+    };
+
+    // Act
+    ASSERT_TRUE(pipeline->switchTo(pathB.c_str()));
+    runUntilIdle();
+
+    // Expect: B was dropped as soon as its open returned, C played
+    EXPECT_EQ((std::vector<std::string>{pathB, pathC}), standbySource->opened);
+    ASSERT_FALSE(standbySource->reads.empty());
+    EXPECT_EQ(0, standbySource->reads[0]);
+    ASSERT_FALSE(sink->samples.empty());
+    EXPECT_EQ(VALUE_B, sink->samples.back());
+    EXPECT_EQ(0, sink->stops.load());
+}
+
+TEST_F(PlayerPipelineTest, switchTo_RapidPresses_OnlyNewestStreamIsOpened) {
+    // Arrange
+    const std::string pathA = writeWav("pipeline_a.wav", 44100U, 2U, 50000U, VALUE_A);
+    const std::string pathB = writeWav("pipeline_b.wav", 44100U, 2U, 3000U, VALUE_B);
+    const std::string pathC = writeWav("pipeline_c.wav", 44100U, 2U, 3000U, VALUE_B);
+    playWithStandby(pathA);
+
+    // Act: each press is applied before the standby side gets to run
+    ASSERT_TRUE(pipeline->switchTo(pathB.c_str()));
+    runWithoutStandby(2);
+    ASSERT_TRUE(pipeline->switchTo(pathC.c_str()));
+    runWithoutStandby(2);
+    ASSERT_TRUE(pipeline->switchTo(pathB.c_str()));
+    runUntilIdle();
+
+    // Expect
+    EXPECT_EQ((std::vector<std::string>{pathB}), standbySource->opened);
+    EXPECT_EQ(std::vector<std::string>{pathA}, source->opened);
+}
+
+TEST_F(PlayerPipelineTest, switchTo_NewStreamUnreachable_EndsPlaybackAsWithoutStandby) {
+    // Arrange
+    const std::string pathA = writeWav("pipeline_a.wav", 44100U, 2U, 50000U, VALUE_A);
+    playWithStandby(pathA);
+
+    // Act
+    ASSERT_TRUE(pipeline->switchTo("/nonexistent/pipeline.wav"));
+    runUntilIdle();
+
+    // Expect
+    EXPECT_EQ(player::PlayerState::Failed, pipeline->getState());
+    EXPECT_EQ(1, sink->stops.load());
+}
+
+TEST_F(PlayerPipelineTest, stop_WhileSwitching_CancelsTheStandbyStream) {
+    // Arrange: B is open and buffered on the standby side, the cutover has not happened
+    const std::string pathA = writeWav("pipeline_a.wav", 44100U, 2U, 50000U, VALUE_A);
+    const std::string pathB = writeWav("pipeline_b.wav", 44100U, 2U, 50000U, VALUE_B);
+    playWithStandby(pathA);
+    ASSERT_TRUE(pipeline->switchTo(pathB.c_str()));
+    runWithoutStandby(1);
+    while (pipeline->runStandbyStep()) {
+    }
+    ASSERT_GT(standbyRing->size(), 0U);
+
+    // Act
+    ASSERT_TRUE(pipeline->stop());
+    runUntilIdle();
+
+    // Expect: nothing of B reached the sink
+    EXPECT_EQ(player::PlayerState::Stopped, pipeline->getState());
+    EXPECT_TRUE(std::none_of(sink->samples.begin(), sink->samples.end(),
+                             [](const int16_t sample) { return sample < 0; }));
+}
+
+TEST_F(PlayerPipelineTest, play_AfterCutover_UsesTheStreamThatTookOver) {
+    // Arrange
+    const std::string pathA = writeWav("pipeline_a.wav", 44100U, 2U, 50000U, VALUE_A);
+    const std::string pathB = writeWav("pipeline_b.wav", 44100U, 2U, 50000U, VALUE_B);
+    const std::string pathC = writeWav("pipeline_c.wav", 44100U, 2U, 100U, VALUE_A);
+    playWithStandby(pathA);
+    ASSERT_TRUE(pipeline->switchTo(pathB.c_str()));
+    for (int i = 0; i < 40; ++i) {
+        pipeline->runSourceStep();
+        pipeline->runDecodeStep();
+        pipeline->runStandbyStep();
+    }
+    ASSERT_FALSE(sink->samples.empty());
+    ASSERT_EQ(VALUE_B, sink->samples.back());
+
+    // Act: a switch back goes the other way round, a play restarts on the playing stream
+    ASSERT_TRUE(pipeline->switchTo(pathA.c_str()));
+    for (int i = 0; i < 40; ++i) {
+        pipeline->runSourceStep();
+        pipeline->runDecodeStep();
+        pipeline->runStandbyStep();
+    }
+    ASSERT_TRUE(pipeline->play(pathC.c_str()));
+    runUntilIdle();
+
+    // Expect
+    EXPECT_EQ((std::vector<std::string>{pathA, pathA, pathC}), source->opened);
+    EXPECT_EQ((std::vector<std::string>{pathB}), standbySource->opened);
+    ASSERT_FALSE(sink->samples.empty());
+    EXPECT_EQ(VALUE_A, sink->samples.back());
+}
+
+TEST_F(PlayerPipelineTest, Benchmark_ThroughputAcrossTwoThreads) {
+    // Arrange: one minute of CD audio into a sink with no clock of its own
+    static constexpr uint32_t RATE = 44100U;
+    static constexpr size_t FRAMES = RATE * 60U;
+    const std::string path = writeWav("pipeline_long.wav", RATE, 2U, FRAMES, VALUE_A);
+    player::NullSink nullSink;
+    player::PlayerPipeline timed(*source, *decoder, nullSink, *ring);
+
+    // Act
+    const auto start = std::chrono::steady_clock::now();
+    startThreads(timed);
+    timed.play(path.c_str());
+    const bool drained = waitUntil([&nullSink] { return nullSink.getFramesWritten() >= FRAMES; });
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    stopThreads();
+    ASSERT_TRUE(drained) << nullSink.getFramesWritten() << " of " << FRAMES << " frames";
+
+    // Expect
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    const double megabytes = static_cast<double>(FRAMES * 4U) / 1e6;
+    printf("[ PLAYER   ] %zu frames in %.1f ms: %.0f MB/s, %.0fx realtime\n", FRAMES,
+           seconds * 1e3, megabytes / seconds, static_cast<double>(FRAMES) / RATE / seconds);
+    EXPECT_EQ(FRAMES, nullSink.getFramesWritten());
+}
+
+TEST_F(PlayerPipelineTest, Benchmark_SwitchLatencyAcrossTwoThreads) {
+    // Arrange: long streams so neither ends during the run
+    static constexpr int SWITCHES = 20;
+    const std::string pathA = writeWav("pipeline_a.wav", 44100U, 2U, 441000U, VALUE_A);
+    const std::string pathB = writeWav("pipeline_b.wav", 44100U, 2U, 441000U, VALUE_B);
+    sink->keepSamples = false;
+    std::vector<int64_t> latencies;
+
+    // Act
+    startThreads(*pipeline);
+    pipeline->play(pathA.c_str());
+    if (!waitUntil([this] { return sink->lastValue == VALUE_A; })) {
+        FAIL() << "first stream never reached the sink";
+    }
+    for (int i = 0; i < SWITCHES; ++i) {
+        const bool toB = (i % 2) == 0;
+        const int16_t expected = toB ? VALUE_B : VALUE_A;
+        const int64_t postedUs = esp_timer_get_time();
+        ASSERT_TRUE(pipeline->switchTo(toB ? pathB.c_str() : pathA.c_str()));
+        if (!waitUntil([this, expected] { return sink->lastValue == expected; })) {
+            FAIL() << "switch " << i << " never reached the sink";
+        }
+        latencies.push_back(sink->changedUs - postedUs);
+    }
+    stopThreads();
+
+    // Expect: timings are only reported, a loaded machine stretches them without a fault
+    ASSERT_EQ(static_cast<size_t>(SWITCHES), latencies.size());
+    std::sort(latencies.begin(), latencies.end());
+    printf("[ PLAYER   ] switch to first new frame: p50 %lld us, max %lld us over %d switches\n",
+           static_cast<long long>(latencies[latencies.size() / 2]),
+           static_cast<long long>(latencies.back()), SWITCHES);
+    EXPECT_EQ(0, sink->stops.load());
+}
+
+TEST_F(PlayerPipelineTest, Benchmark_SilenceWhileSwitchingStations) {
+    // Arrange: real-time output, a connect that outlasts what the ring holds and a network
+    // about three times faster than the audio
+    static constexpr int SWITCHES = 4;
+    static constexpr int OPEN_MS = 150;
+    const std::string pathA = writeWav("pipeline_a.wav", 44100U, 2U, 441000U, VALUE_A);
+    const std::string pathB = writeWav("pipeline_b.wav", 44100U, 2U, 441000U, VALUE_B);
+    sink->keepSamples = false;
+    sink->paced = true;
+    for (CountingSource *stream : {source.get(), standbySource.get()}) {
+        stream->openDelayMs = OPEN_MS;
+        stream->readDelayUs = 2000;
+    }
+
+    const auto measure = [&](player::PlayerPipeline &target) {
+        startThreads(target);
+        target.play(pathA.c_str());
+        bool reached = waitUntil([this] { return sink->lastValue == VALUE_A; });
+        sink->maxGapUs = 0;
+        for (int i = 0; reached && i < SWITCHES; ++i) {
+            const int16_t expected = (i % 2) == 0 ? VALUE_B : VALUE_A;
+            target.switchTo((i % 2) == 0 ? pathB.c_str() : pathA.c_str());
+            reached = waitUntil([this, expected] { return sink->lastValue == expected; });
+        }
+        // Stopped before any failure returns, the threads step a pipeline local to the test
+        stopThreads();
+        return reached ? sink->maxGapUs.load() : int64_t{-1};
+    };
+
+    // Act
+    const int64_t breakGapUs = measure(*pipeline);
+    ASSERT_GE(breakGapUs, 0) << "a switch never reached the sink";
+    ring->clear();
+    sink->lastWriteUs = 0;
+    player::PlayerPipeline standbyPipeline(*source, *decoder, *sink, *ring);
+    standbyPipeline.setStandby(*standbySource, *standbyRing);
+    const int64_t makeGapUs = measure(standbyPipeline);
+    ASSERT_GE(makeGapUs, 0) << "a switch never reached the sink";
+
+    // Expect: only the gap the connect forces is checked, it can grow under load but not
+    // shrink; how much make-before-break saves is reported, not gated
+    printf("[ PLAYER   ] longest silence while switching: %lld us break-before-make, "
+           "%lld us make-before-break\n",
+           static_cast<long long>(breakGapUs), static_cast<long long>(makeGapUs));
+    EXPECT_GT(breakGapUs, 20000);
+}
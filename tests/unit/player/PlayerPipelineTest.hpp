@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BufferTuner.hpp"
+#include "ByteRing.hpp"
+#include "FileSource.hpp"
+#include "IAudioSink.hpp"
+#include "IBufferTelemetry.hpp"
+#include "PlayerPipeline.hpp"
+#include "WavDecoder.hpp"
+#include "gtest/gtest.h"
+
+// Keeps what reaches it and stamps the moment the sample value last changed, which is when
+// a switched stream became audible. Paced, it takes as long as the audio would play and
+// tracks the longest wait between two writes, the silence a listener would hear.
+class RecordingSink final : public player::IAudioSink {
+   public:
+    bool configure(const player::AudioFormat &format) override;
+    void write(const int16_t *pcm, const size_t &frames) override;
+    void stop() override;
+
+    player::AudioFormat format;
+    std::vector<int16_t> samples;
+    bool keepSamples = true;
+    std::atomic<int> configures{0};
+    std::atomic<int> stops{0};
+    std::atomic<uint64_t> frames{0U};
+    std::atomic<int16_t> lastValue{0};
+    std::atomic<int64_t> changedUs{0};
+    bool paced = false;
+    int64_t lastWriteUs = 0;  // writer thread only
+    std::atomic<int64_t> maxGapUs{0};
+};
+
+// Counts opens, and reads per open, so tests see which streams a side really connected to
+// and which it dropped unread. Opening and reading can take a while, and opening can run a
+// hook, standing in for a user who presses again while the connection is made.
+class CountingSource final : public player::IAudioSource {
+   public:
+    bool open(const char *url) override;
+    int32_t read(uint8_t *dst, const size_t &len) override;
+    void close() override;
+
+    player::FileSource file;
+    std::vector<std::string> opened;
+    std::vector<int> reads;
+    int openDelayMs = 0;
+    int readDelayUs = 0;  // per read, a network that is only a few times faster than audio
+    std::function<void()> onOpen;
+};
+
+// Hands the pipeline a scripted window and keeps the settings it was told to use
+class ScriptedTelemetry final : public player::IBufferTelemetry {
+   public:
+    player::BufferWindow takeWindow() override;
+    void applySettings(const player::BufferSettings &settings) override;
+
+    player::BufferWindow next;
+    player::BufferSettings applied;
+    int windowsTaken = 0;
+};
+
+class PlayerPipelineTest : public ::testing::Test {
+   protected:
+    static constexpr size_t RING_SIZE = 16384U;
+    static constexpr int16_t VALUE_A = 1000;
+    static constexpr int16_t VALUE_B = -1000;
+    // How long a threaded test waits for the sink before it gives up; far beyond any switch,
+    // so only a stalled pipeline runs into it
+    static constexpr int64_t WAIT_TIMEOUT_US = 10000000;
+
+    void SetUp() override;
+    void TearDown() override;
+
+    // Constant-valued WAV in the test temp dir, removed on teardown. The file name carries
+    // the test and the process, ctest -j runs every test as its own process side by side.
+    std::string writeWav(const std::string &name, const uint32_t &rate, const uint16_t &channels,
+                         const size_t &frames, const int16_t &value);
+
+    // Steps every side on the test thread until none has work left
+    void runUntilIdle();
+    // Steps only the playing side, as if the standby side were still connecting
+    void runWithoutStandby(const int &steps);
+    // Plays a long constant stream until it reaches the sink, with the standby in place
+    void playWithStandby(const std::string &path);
+
+    // Steps each side on its own thread, like the pinned tasks on the board
+    void startThreads(player::PlayerPipeline &target);
+    void stopThreads();
+    // Yields while the threads work until done() holds. False once WAIT_TIMEOUT_US has passed,
+    // so a stalled pipeline fails the test instead of hanging it.
+    bool waitUntil(const std::function<bool()> &done);
+
+    std::vector<uint8_t> ringStorage;
+    std::unique_ptr<player::ByteRing> ring;
+    std::unique_ptr<CountingSource> source;
+    std::vector<uint8_t> standbyRingStorage;
+    std::unique_ptr<player::ByteRing> standbyRing;
+    std::unique_ptr<CountingSource> standbySource;
+    std::unique_ptr<player::WavDecoder> decoder;
+    std::unique_ptr<RecordingSink> sink;
+    std::unique_ptr<player::PlayerPipeline> pipeline;
+
+    std::vector<std::string> files;
+    std::atomic<bool> running{false};
+    std::thread sourceThread;
+    std::thread decodeThread;
+    std::thread standbyThread;
+};
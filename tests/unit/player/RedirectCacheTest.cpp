@@ -0,0 +1,109 @@
+#include "RedirectCacheTest.hpp"
+
+#include <string>
+
+using player::RedirectCache;
+
+void RedirectCacheTest::SetUp() {
+    store = std::make_unique<common::FakeKeyValueStore>();
+    cache = std::make_unique<RedirectCache>(TTL_US, store.get());
+    ASSERT_TRUE(cache->init());
+}
+
+void RedirectCacheTest::TearDown() {
+    cache.reset();
+    store.reset();
+}
+
+TEST_F(RedirectCacheTest, lookup_WithinTtl_ReturnsTarget) {
+    // Arrange
+    cache->remember(STATION, TARGET, 1000);
+
+    // Act
+    const bool found = cache->lookup(STATION, 1000 + TTL_US - 1, target);
+
+    // Expect
+    ASSERT_TRUE(found);
+    EXPECT_STREQ(TARGET, target.data());
+}
+
+TEST_F(RedirectCacheTest, lookup_Expired_MissesAndForgetsPersistedCopy) {
+    // Arrange
+    cache->remember(STATION, TARGET, 1000);
+
+    // Act
+    const bool found = cache->lookup(STATION, 1000 + TTL_US, target);
+
+    // Expect
+    EXPECT_FALSE(found);
+    EXPECT_EQ(0U, cache->size());
+    EXPECT_EQ(0U, store->size());
+}
+
+TEST_F(RedirectCacheTest, remember_SameTarget_WritesFlashOnce) {
+    // Act
+    cache->remember(STATION, TARGET, 0);
+    cache->remember(STATION, TARGET, 1000);
+    cache->remember(STATION, "https://stream2.example/a.aac", 2000);
+
+    // Expect
+    EXPECT_EQ(2, store->writes());
+    EXPECT_EQ(1U, cache->size());
+}
+
+TEST_F(RedirectCacheTest, lookup_AfterReboot_RestoresFromStore) {
+    // Arrange
+    cache->remember(STATION, TARGET, 5000000000LL);
+    RedirectCache rebooted(TTL_US, store.get());
+    ASSERT_TRUE(rebooted.init());
+
+    // Act: the clock starts over
+    const bool found = rebooted.lookup(STATION, 1000, target);
+
+    // Expect
+    ASSERT_TRUE(found);
+    EXPECT_STREQ(TARGET, target.data());
+    EXPECT_EQ(1U, rebooted.size());
+    EXPECT_FALSE(rebooted.lookup("https://redirector.example/live/b", 1000, target));
+}
+
+TEST_F(RedirectCacheTest, forget_DropsRamAndStore) {
+    // Arrange
+    cache->remember(STATION, TARGET, 0);
+
+    // Act
+    cache->forget(STATION);
+
+    // Expect
+    EXPECT_FALSE(cache->lookup(STATION, 1, target));
+    EXPECT_EQ(0U, store->size());
+}
+
+TEST_F(RedirectCacheTest, remember_Full_EvictsTheEntryClosestToExpiring) {
+    // Arrange
+    for (size_t i = 0; i < RedirectCache::MAX_ENTRIES; ++i) {
+        const std::string station = "https://r.example/" + std::to_string(i);
+        cache->remember(station.c_str(), TARGET, static_cast<int64_t>(i) * 1000);
+    }
+
+    // Act
+    cache->remember("https://r.example/new", TARGET, 100000);
+
+    // Expect: the RAM copy of the oldest is gone, the store still has it as a hint
+    EXPECT_EQ(RedirectCache::MAX_ENTRIES, cache->size());
+    EXPECT_TRUE(cache->lookup("https://r.example/new", 100001, target));
+    EXPECT_TRUE(cache->lookup("https://r.example/1", 100001, target));
+    EXPECT_EQ(RedirectCache::MAX_ENTRIES + 1U, store->size());
+}
+
+TEST_F(RedirectCacheTest, lookup_WithoutInit_AlwaysMisses) {
+    // Arrange
+    RedirectCache unallocated(TTL_US, store.get());
+
+    // Act
+    unallocated.remember(STATION, TARGET, 0);
+
+    // Expect
+    EXPECT_FALSE(unallocated.lookup(STATION, 1, target));
+    EXPECT_EQ(0U, unallocated.size());
+}
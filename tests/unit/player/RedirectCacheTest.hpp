@@ -0,0 +1,21 @@
+#pragma once
+
+#include <memory>
+
+#include "FakeKeyValueStore.hpp"
+#include "RedirectCache.hpp"
+#include "gtest/gtest.h"
+
+class RedirectCacheTest : public ::testing::Test {
+   protected:
+    static constexpr int64_t TTL_US = 60000000;
+    static constexpr const char *STATION = "https://redirector.example/live/a";
+    static constexpr const char *TARGET = "https://stream1.example/a.aac";
+
+    void SetUp() override;
+    void TearDown() override;
+
+    std::unique_ptr<common::FakeKeyValueStore> store;
+    std::unique_ptr<player::RedirectCache> cache;
+    player::RedirectCache::Url target{};
+};
@@ -0,0 +1,206 @@
+#include "ResamplerTest.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+static constexpr double PI = 3.14159265358979323846;
+
+void ResamplerTest::SetUp() {
+    resampler = std::make_unique<player::Resampler>(OUTPUT_RATE);
+}
+
+void ResamplerTest::TearDown() {
+    resampler.reset();
+}
+
+std::vector<int16_t> ResamplerTest::resample(const std::vector<int16_t> &input,
+                                             const uint8_t &channels, const size_t &block) {
+    static constexpr size_t CAPACITY = 1024U;
+
+    std::vector<int16_t> buffer(CAPACITY * channels);
+    std::vector<int16_t> out;
+    const size_t frames = input.size() / channels;
+    for (size_t offset = 0; offset < frames; offset += block) {
+        const size_t count = std::min(block, frames - offset);
+        std::copy_n(&input[offset * channels], count * channels, buffer.begin());
+        const size_t produced = resampler->process(buffer.data(), count, CAPACITY);
+        out.insert(out.end(), buffer.begin(), buffer.begin() + produced * channels);
+    }
+    return out;
+}
+
+// Tone at `frequency`, half of full scale
+static std::vector<int16_t> sine(const uint32_t &rate, const double &frequency,
+                                 const size_t &frames, const uint8_t &channels) {
+    std::vector<int16_t> out(frames * channels);
+    for (size_t i = 0; i < frames; ++i) {
+        const double value = 16384.0 * std::sin(2.0 * PI * frequency * i / rate);
+        for (size_t c = 0; c < channels; ++c) {
+            out[i * channels + c] = static_cast<int16_t>(std::lround(value));
+        }
+    }
+    return out;
+}
+
+// Output n sits exactly on input position n * M / L, so the ideal is the same tone sampled
+// at the output rate. The warm-up, where the window still reaches into silence, is skipped.
+static double snrDb(const std::vector<int16_t> &out, const uint8_t &channels,
+                    const uint32_t &rate, const double &frequency) {
+    const size_t skip = player::Resampler::TAPS * 8U;
+    double signal = 0.0;
+    double noise = 0.0;
+    for (size_t i = skip; i < out.size() / channels; ++i) {
+        const double ideal = 16384.0 * std::sin(2.0 * PI * frequency * i / rate);
+        for (size_t c = 0; c < channels; ++c) {
+            const double error = out[i * channels + c] - ideal;
+            signal += ideal * ideal;
+            noise += error * error;
+        }
+    }
+    return 10.0 * std::log10(signal / std::max(noise, 1e-9));
+}
+
+TEST_F(ResamplerTest, configure_SameRate_Bypasses) {
+    // Act
+    const player::AudioFormat out = resampler->configure({OUTPUT_RATE, 2U});
+    std::vector<int16_t> pcm{1, 2, 3, 4};
+    const size_t frames = resampler->process(pcm.data(), 2U, 2U);
+
+    // Expect
+    EXPECT_TRUE(resampler->isBypassed());
+    EXPECT_EQ(OUTPUT_RATE, out.sampleRate);
+    EXPECT_EQ(2U, frames);
+    EXPECT_EQ((std::vector<int16_t>{1, 2, 3, 4}), pcm);
+}
+
+TEST_F(ResamplerTest, configure_RatioBeyondLimits_PassesThroughAtInputRate) {
+    // Act: 8 kHz would need six output frames per input frame
+    const player::AudioFormat out = resampler->configure({8000U, 1U});
+
+    // Expect
+    EXPECT_TRUE(resampler->isBypassed());
+    EXPECT_EQ(8000U, out.sampleRate);
+}
+
+TEST_F(ResamplerTest, process_ConstantInput_StaysConstant) {
+    // Arrange
+    resampler->configure({44100U, 2U});
+    const std::vector<int16_t> input(2U * 4410U, -12345);
+
+    // Act
+    const std::vector<int16_t> out = resample(input, 2U, 256U);
+
+    // Expect: every phase has unity DC gain
+    ASSERT_GT(out.size(), 2U * player::Resampler::TAPS);
+    EXPECT_TRUE(std::all_of(out.begin() + 2U * player::Resampler::TAPS, out.end(),
+                            [](const int16_t sample) { return sample == -12345; }));
+}
+
+TEST_F(ResamplerTest, process_AnyBufferSplit_GivesTheSameOutput) {
+    // Arrange
+    const std::vector<int16_t> input = sine(22050U, 1000.0, 3000U, 2U);
+    resampler->configure({22050U, 2U});
+    const std::vector<int16_t> whole = resample(input, 2U, 256U);
+
+    // Act
+    resampler->configure({22050U, 2U});
+    const std::vector<int16_t> pieces = resample(input, 2U, 7U);
+
+    // Expect
+    EXPECT_EQ(whole, pieces);
+}
+
+TEST_F(ResamplerTest, process_FullScale_SaturatesInsteadOfWrapping) {
+    // Arrange: a full-scale square wave rings above the rails at each edge
+    resampler->configure({44100U, 1U});
+    std::vector<int16_t> input(4410U);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = ((i / 50U) % 2U == 0U) ? INT16_MAX : INT16_MIN;
+    }
+
+    // Act
+    const std::vector<int16_t> out = resample(input, 1U, 256U);
+
+    // Expect: no overshoot flips sign
+    for (size_t i = player::Resampler::TAPS; i + 60U < out.size(); i += 109U) {
+        const size_t source = i * 147U / 160U;
+        if (source % 50U > 5U && source % 50U < 45U) {
+            EXPECT_EQ((input[source] > 0), (out[i] > 0)) << "at " << i;
+        }
+    }
+}
+
+TEST_P(ResamplerRateTest, configure_CommonRate_ConvertsToOutputRate) {
+    // Act
+    const player::AudioFormat out = resampler->configure({GetParam().inputRate, 2U});
+
+    // Expect
+    EXPECT_FALSE(resampler->isBypassed());
+    EXPECT_EQ(OUTPUT_RATE, out.sampleRate);
+    EXPECT_EQ(2U, out.channels);
+    EXPECT_EQ(GetParam().up, resampler->getUpFactor());
+    EXPECT_EQ(GetParam().down, resampler->getDownFactor());
+}
+
+TEST_P(ResamplerRateTest, process_OneSecond_ProducesOneOutputSecond) {
+    // Arrange
+    const uint32_t rate = GetParam().inputRate;
+    resampler->configure({rate, 1U});
+
+    // Act
+    const std::vector<int16_t> out = resample(std::vector<int16_t>(rate, 0), 1U, 256U);
+
+    // Expect: only the frames waiting for the second half of their window are missing
+    EXPECT_LE(out.size(), OUTPUT_RATE);
+    EXPECT_GE(out.size() + (player::Resampler::TAPS * OUTPUT_RATE) / rate, OUTPUT_RATE);
+}
+
+TEST_P(ResamplerRateTest, process_Tones_KeepHighSnr) {
+    // Arrange
+    const uint32_t rate = GetParam().inputRate;
+    const double highTone = std::min(rate, OUTPUT_RATE) * 0.3;  // well inside the passband
+
+    for (const double frequency : {1000.0, highTone}) {
+        resampler->configure({rate, 2U});
+
+        // Act
+        const std::vector<int16_t> out = resample(sine(rate, frequency, rate / 2U, 2U), 2U, 256U);
+        const double snr = snrDb(out, 2U, OUTPUT_RATE, frequency);
+
+        // Expect
+        printf("[ RESAMPLE ] %5u -> %u Hz, %5.0f Hz tone: SNR %.1f dB\n", rate, OUTPUT_RATE,
+               frequency, snr);
+        EXPECT_GT(snr, 70.0) << frequency << " Hz";
+    }
+}
+
+TEST_P(ResamplerRateTest, Benchmark_SamplesPerSecond) {
+    // Arrange: ten seconds of stereo in decoder-sized buffers
+    const uint32_t rate = GetParam().inputRate;
+    resampler->configure({rate, 2U});
+    const std::vector<int16_t> input = sine(rate, 1000.0, rate * 10U, 2U);
+
+    // Act
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<int16_t> out = resample(input, 2U, 256U);
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Expect
+    const double samplesPerSecond = static_cast<double>(out.size()) / seconds;
+    printf("[ RESAMPLE ] %5u -> %u Hz: %.1f Msamples/s out, %.0fx realtime\n", rate,
+           OUTPUT_RATE, samplesPerSecond / 1e6, samplesPerSecond / (2.0 * OUTPUT_RATE));
+    EXPECT_GT(samplesPerSecond, 2.0 * OUTPUT_RATE);
+}
+
+INSTANTIATE_TEST_SUITE_P(CommonRates, ResamplerRateTest,
+                         ::testing::Values(RateCase{44100U, 160U, 147U},
+                                           RateCase{22050U, 320U, 147U},
+                                           RateCase{24000U, 2U, 1U},
+                                           RateCase{32000U, 3U, 2U}),
+                         [](const ::testing::TestParamInfo<RateCase> &info) {
+                             return "From" + std::to_string(info.param.inputRate) + "Hz";
+                         });
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Resampler.hpp"
+#include "gtest/gtest.h"
+
+class ResamplerTest : public ::testing::Test {
+   protected:
+    static constexpr uint32_t OUTPUT_RATE = 48000U;
+
+    void SetUp() override;
+    void TearDown() override;
+
+    // Runs the interleaved input through in buffers of `block` frames, the way the pipeline
+    // hands over decoder output, and returns everything produced
+    std::vector<int16_t> resample(const std::vector<int16_t> &input, const uint8_t &channels,
+                                  const size_t &block);
+
+    std::unique_ptr<player::Resampler> resampler;
+};
+
+struct RateCase {
+    uint32_t inputRate;
+    uint32_t up;
+    uint32_t down;
+};
+
+class ResamplerRateTest : public ResamplerTest, public ::testing::WithParamInterface<RateCase> {};
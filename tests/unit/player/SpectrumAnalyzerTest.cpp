@@ -0,0 +1,197 @@
+#include "SpectrumAnalyzerTest.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr double PI = 3.14159265358979323846;
+static constexpr size_t BLOCK = 256U;
+
+void SpectrumAnalyzerTest::SetUp() {
+    tap = std::make_unique<player::SpectrumTap>();
+    analyzer = std::make_unique<player::SpectrumAnalyzer>(*tap);
+    tap->configure({RATE, 2U});
+}
+
+void SpectrumAnalyzerTest::TearDown() {
+    analyzer.reset();
+    tap.reset();
+}
+
+void SpectrumAnalyzerTest::feedTone(const double &frequency, const double &amplitude,
+                                    const size_t &frames) {
+    std::vector<int16_t> block(BLOCK * 2U);
+    for (size_t done = 0; done < frames; done += BLOCK) {
+        const size_t count = std::min(BLOCK, frames - done);
+        for (size_t i = 0; i < count; ++i) {
+            const double t = static_cast<double>(fed + i) / RATE;
+            const auto value =
+                static_cast<int16_t>(std::lround(amplitude * std::sin(2.0 * PI * frequency * t)));
+            block[2U * i] = value;
+            block[2U * i + 1U] = value;
+        }
+        tap->process(block.data(), count, BLOCK);
+        fed += count;
+    }
+}
+
+double SpectrumAnalyzerTest::binFrequency(const size_t &bin) {
+    const double rate = static_cast<double>(RATE) / player::SpectrumTap::DECIMATION;
+    return rate * static_cast<double>(bin) / player::SpectrumAnalyzer::FFT_POINTS;
+}
+
+TEST_F(SpectrumAnalyzerTest, process_StereoBlock_PassesThroughAndDecimatesToMono) {
+    // Arrange: left and right differ, so the mono mix is their mean
+    std::vector<int16_t> block(16U * 2U);
+    for (size_t i = 0; i < 16U; ++i) {
+        block[2U * i] = static_cast<int16_t>(100 * i);
+        block[2U * i + 1U] = static_cast<int16_t>(-50 * i);
+    }
+    const std::vector<int16_t> original = block;
+
+    // Act
+    const size_t frames = tap->process(block.data(), 16U, 16U);
+    std::array<int16_t, 4> samples{};
+    const bool read = tap->readLatest(samples.data(), samples.size());
+
+    // Expect: four frames per sample, averaged over both channels
+    EXPECT_EQ(16U, frames);
+    EXPECT_EQ(original, block);
+    ASSERT_TRUE(read);
+    EXPECT_EQ(4U, tap->getWritten());
+    EXPECT_EQ(RATE / player::SpectrumTap::DECIMATION, tap->getSampleRate());
+    for (size_t s = 0; s < samples.size(); ++s) {
+        const int32_t first = static_cast<int32_t>(4U * s);
+        const int32_t sum = 50 * (4 * first + 6);  // (100 - 50) * (f + f+1 + f+2 + f+3)
+        EXPECT_EQ(sum / 8, samples[s]) << "sample " << s;
+    }
+}
+
+TEST_F(SpectrumAnalyzerTest, readLatest_NotEnoughSamples_Refused) {
+    // Arrange
+    feedTone(1000.0, 8000.0, 8U * player::SpectrumTap::DECIMATION);
+    std::array<int16_t, 16> samples{};
+
+    // Act & Expect
+    EXPECT_TRUE(tap->readLatest(samples.data(), 8U));
+    EXPECT_FALSE(tap->readLatest(samples.data(), 16U));
+}
+
+TEST_F(SpectrumAnalyzerTest, getBandEdges_CoverEveryBinOnceWideningUpwards) {
+    // Act
+    const auto &edges = analyzer->getBandEdges();
+
+    // Expect: contiguous from the first bin above DC to the last, no band wider than the next
+    EXPECT_EQ(1U, edges.front());
+    EXPECT_EQ(player::SpectrumAnalyzer::Fft::BINS, edges.back());
+    for (size_t b = 0; b < player::SpectrumAnalyzer::BARS; ++b) {
+        EXPECT_LT(edges[b], edges[b + 1U]) << "band " << b;
+        if (b + 2U <= player::SpectrumAnalyzer::BARS) {
+            EXPECT_LE(edges[b + 1U] - edges[b], edges[b + 2U] - edges[b + 1U]) << "band " << b;
+        }
+    }
+}
+
+TEST_F(SpectrumAnalyzerTest, toLevel_MapsDecibelsLinearlyOntoTheBar) {
+    // Expect: full scale tops out, 48 dB below is the floor, half way is half a bar
+    EXPECT_EQ(0U, player::SpectrumAnalyzer::toLevel(0U));
+    EXPECT_EQ(0U, player::SpectrumAnalyzer::toLevel(1U << 10U));
+    EXPECT_EQ(128U, player::SpectrumAnalyzer::toLevel(1U << 18U));
+    EXPECT_EQ(255U, player::SpectrumAnalyzer::toLevel(1U << 26U));
+    EXPECT_EQ(255U, player::SpectrumAnalyzer::toLevel(UINT32_MAX));
+    EXPECT_LT(player::SpectrumAnalyzer::toLevel(1U << 20U),
+              player::SpectrumAnalyzer::toLevel(3U << 20U));
+}
+
+TEST_F(SpectrumAnalyzerTest, mapBars_TakesThePeakOfEachBand) {
+    // Arrange: one loud bin in the last band, a quieter one in the first
+    std::array<uint32_t, player::SpectrumAnalyzer::Fft::BINS> power{};
+    const auto &edges = analyzer->getBandEdges();
+    power[edges[0]] = 1U << 18U;
+    power[edges[player::SpectrumAnalyzer::BARS] - 1U] = 1U << 26U;
+    player::SpectrumAnalyzer::Levels levels{};
+
+    // Act
+    player::SpectrumAnalyzer::mapBars(power.data(), edges, levels);
+
+    // Expect
+    EXPECT_EQ(128U, levels.front());
+    EXPECT_EQ(255U, levels.back());
+    for (size_t b = 1; b + 1U < levels.size(); ++b) {
+        EXPECT_EQ(0U, levels[b]) << "bar " << b;
+    }
+}
+
+TEST_F(SpectrumAnalyzerTest, update_Tone_LightsOnlyItsBar) {
+    // Arrange: a loud tone on bin 20, which falls inside one of the wider bands
+    const size_t bin = 20U;
+    feedTone(binFrequency(bin), 30000.0, player::SpectrumAnalyzer::FFT_POINTS * 4U * 2U);
+    const auto &edges = analyzer->getBandEdges();
+    const size_t bar = static_cast<size_t>(
+        std::upper_bound(edges.begin(), edges.end(), bin) - edges.begin() - 1);
+    player::SpectrumAnalyzer::Levels levels{};
+
+    // Act
+    const bool drawn = analyzer->update(levels);
+
+    // Expect: near the top where the tone is, the Hann skirt reaches at most the neighbours
+    EXPECT_TRUE(drawn);
+    const auto tallest = std::max_element(levels.begin(), levels.end());
+    EXPECT_EQ(bar, static_cast<size_t>(tallest - levels.begin()));
+    EXPECT_GT(*tallest, 230U);
+    for (size_t b = 0; b < levels.size(); ++b) {
+        if (b + 1U < bar || b > bar + 1U) {
+            EXPECT_LT(levels[b], 64U) << "bar " << b;
+        }
+    }
+}
+
+TEST_F(SpectrumAnalyzerTest, update_QuietHalfwayTone_ReachesAboutHalfTheBar) {
+    // Arrange: 24 dB below full scale
+    feedTone(binFrequency(8U), 32767.0 / 16.0, player::SpectrumAnalyzer::FFT_POINTS * 8U);
+    player::SpectrumAnalyzer::Levels levels{};
+
+    // Act
+    analyzer->update(levels);
+
+    // Expect
+    const uint8_t tallest = *std::max_element(levels.begin(), levels.end());
+    EXPECT_NEAR(128, tallest, 12);
+}
+
+TEST_F(SpectrumAnalyzerTest, update_AudioStops_BarsFallAtTheFixedRateThenStop) {
+    // Arrange
+    feedTone(binFrequency(4U), 30000.0, player::SpectrumAnalyzer::FFT_POINTS * 8U);
+    player::SpectrumAnalyzer::Levels levels{};
+    analyzer->update(levels);
+    const uint8_t peak = *std::max_element(levels.begin(), levels.end());
+
+    // Act: no new samples from here on
+    player::SpectrumAnalyzer::Levels fallen{};
+    const bool stillDrawn = analyzer->update(fallen);
+    int frames = 1;
+    while (analyzer->update(fallen)) {
+        ++frames;
+    }
+
+    // Expect: one step down per frame, the frame the last bar goes out is not drawn
+    const int steps = (peak + player::SpectrumAnalyzer::FALL_PER_FRAME - 1) /
+                      player::SpectrumAnalyzer::FALL_PER_FRAME;
+    EXPECT_TRUE(stillDrawn);
+    EXPECT_EQ(steps - 1, frames);
+    EXPECT_EQ(player::SpectrumAnalyzer::Levels{}, fallen);
+}
+
+TEST_F(SpectrumAnalyzerTest, update_Silence_DrawsNothing) {
+    // Arrange
+    feedTone(1000.0, 0.0, player::SpectrumAnalyzer::FFT_POINTS * 8U);
+    player::SpectrumAnalyzer::Levels levels{};
+
+    // Act
+    const bool first = analyzer->update(levels);
+    const bool second = analyzer->update(levels);
+
+    // Expect: the fresh window still counts as a frame, the next one has nothing to show
+    EXPECT_TRUE(first);
+    EXPECT_FALSE(second);
+    EXPECT_EQ(player::SpectrumAnalyzer::Levels{}, levels);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "SpectrumAnalyzer.hpp"
+#include "SpectrumTap.hpp"
+#include "gtest/gtest.h"
+
+class SpectrumAnalyzerTest : public ::testing::Test {
+   protected:
+    static constexpr uint32_t RATE = 44100U;
+
+    void SetUp() override;
+    void TearDown() override;
+
+    // Stereo tone through the tap in decoder-sized blocks, amplitude in Q15
+    void feedTone(const double &frequency, const double &amplitude, const size_t &frames);
+    // Frequency sitting on the centre of an analyser bin
+    static double binFrequency(const size_t &bin);
+
+    std::unique_ptr<player::SpectrumTap> tap;
+    std::unique_ptr<player::SpectrumAnalyzer> analyzer;
+    size_t fed = 0U;  // frames, so consecutive tones stay continuous
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Builds 16-bit PCM WAV images for the player tests
+namespace test_wav {
+
+inline void putLe(std::vector<uint8_t> &out, const uint32_t &value, const size_t &bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8U * i)));
+    }
+}
+
+inline void putTag(std::vector<uint8_t> &out, const char *tag) {
+    for (size_t i = 0; i < 4U; ++i) {
+        out.push_back(static_cast<uint8_t>(tag[i]));
+    }
+}
+
+// An optional odd-sized LIST chunk sits between fmt and data, as some encoders write it
+inline std::vector<uint8_t> build(const uint32_t &rate, const uint16_t &channels,
+                                  const std::vector<int16_t> &samples,
+                                  const bool &withList = false) {
+    const uint32_t dataBytes = static_cast<uint32_t>(samples.size() * sizeof(int16_t));
+
+    std::vector<uint8_t> out;
+    putTag(out, "RIFF");
+    putLe(out, 0U, 4U);  // patched below
+    putTag(out, "WAVE");
+    putTag(out, "fmt ");
+    putLe(out, 16U, 4U);
+    putLe(out, 1U, 2U);
+    putLe(out, channels, 2U);
+    putLe(out, rate, 4U);
+    putLe(out, rate * channels * 2U, 4U);
+    putLe(out, channels * 2U, 2U);
+    putLe(out, 16U, 2U);
+    if (withList) {
+        putTag(out, "LIST");
+        putLe(out, 3U, 4U);
+        out.insert(out.end(), {'a', 'b', 'c', 0U});  // padded to even
+    }
+    putTag(out, "data");
+    putLe(out, dataBytes, 4U);
+    for (const int16_t sample : samples) {
+        putLe(out, static_cast<uint16_t>(sample), 2U);
+    }
+
+    const uint32_t riffSize = static_cast<uint32_t>(out.size() - 8U);
+    for (size_t i = 0; i < 4U; ++i) {
+        out[4U + i] = static_cast<uint8_t>(riffSize >> (8U * i));
+    }
+    return out;
+}
+
+inline void write(const std::string &path, const std::vector<uint8_t> &image) {
+    FILE *file = std::fopen(path.c_str(), "wb");
+    if (file != nullptr) {
+        std::fwrite(image.data(), 1U, image.size(), file);
+        std::fclose(file);
+    }
+}
+
+}  // namespace test_wav
@@ -0,0 +1,118 @@
+#include "WavDecoderTest.hpp"
+
+#include <cstring>
+
+#include "TestWav.hpp"
+
+void WavDecoderTest::SetUp() {
+    decoder = std::make_unique<player::WavDecoder>();
+}
+
+void WavDecoderTest::TearDown() {
+    decoder.reset();
+}
+
+std::vector<int16_t> WavDecoderTest::decodeAll(const std::vector<uint8_t> &image,
+                                               const size_t &step) {
+    std::vector<int16_t> out;
+    std::vector<uint8_t> pending;
+    size_t offset = 0U;
+
+    while (offset < image.size() || !pending.empty()) {
+        const size_t take = std::min(step, image.size() - offset);
+        pending.insert(pending.end(), image.begin() + offset, image.begin() + offset + take);
+        offset += take;
+
+        size_t consumed = 0U;
+        const int32_t frames =
+            decoder->decode(pending.data(), pending.size(), consumed, pcm.data(), MAX_FRAMES);
+        if (frames < 0) {
+            break;
+        }
+        out.insert(out.end(), pcm.begin(), pcm.begin() + frames * decoder->getFormat().channels);
+        pending.erase(pending.begin(), pending.begin() + consumed);
+
+        if (take == 0U && consumed == 0U) {
+            break;  // input exhausted
+        }
+    }
+    return out;
+}
+
+TEST_F(WavDecoderTest, decode_StereoFile_ReportsFormatAndSamples) {
+    // Arrange
+    const std::vector<int16_t> samples{1, -1, 1000, -1000, 32767, -32768};
+    const std::vector<uint8_t> image = test_wav::build(48000U, 2U, samples);
+
+    // Act
+    const std::vector<int16_t> out = decodeAll(image, image.size());
+
+    // Expect
+    EXPECT_EQ(48000U, decoder->getFormat().sampleRate);
+    EXPECT_EQ(2U, decoder->getFormat().channels);
+    EXPECT_EQ(samples, out);
+}
+
+TEST_F(WavDecoderTest, decode_OneByteAtATime_SkipsExtraChunksAndKeepsFramesWhole) {
+    // Arrange
+    std::vector<int16_t> samples(301);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<int16_t>(i * 97);
+    }
+    const std::vector<uint8_t> image = test_wav::build(22050U, 1U, samples, true);
+
+    // Act
+    const std::vector<int16_t> out = decodeAll(image, 1U);
+
+    // Expect
+    EXPECT_EQ(22050U, decoder->getFormat().sampleRate);
+    EXPECT_EQ(samples, out);
+}
+
+TEST_F(WavDecoderTest, decode_BytesAfterTheDataChunk_AreDropped) {
+    // Arrange
+    const std::vector<int16_t> samples{7, 8, 9, 10};
+    std::vector<uint8_t> image = test_wav::build(44100U, 2U, samples);
+    image.insert(image.end(), {'I', 'D', '3', 0U, 1U, 2U});
+
+    // Act
+    const std::vector<int16_t> out = decodeAll(image, 5U);
+
+    // Expect
+    EXPECT_EQ(samples, out);
+}
+
+TEST_F(WavDecoderTest, decode_NotPcm_FailsUntilReset) {
+    // Arrange: 8-bit samples are not supported
+    std::vector<uint8_t> image = test_wav::build(8000U, 1U, {0, 0});
+    image[34] = 8U;
+    size_t consumed = 0U;
+
+    // Act
+    const int32_t first =
+        decoder->decode(image.data(), image.size(), consumed, pcm.data(), MAX_FRAMES);
+    const int32_t again =
+        decoder->decode(image.data(), image.size(), consumed, pcm.data(), MAX_FRAMES);
+    decoder->reset();
+    const std::vector<uint8_t> good = test_wav::build(8000U, 1U, {5, 6});
+    const std::vector<int16_t> out = decodeAll(good, good.size());
+
+    // Expect
+    EXPECT_EQ(player::IAudioDecoder::DECODE_ERROR, first);
+    EXPECT_EQ(player::IAudioDecoder::DECODE_ERROR, again);
+    EXPECT_EQ(image.size(), consumed);
+    EXPECT_EQ((std::vector<int16_t>{5, 6}), out);
+}
+
+TEST_F(WavDecoderTest, decode_NoRiffHeader_Fails) {
+    // Arrange
+    const std::vector<uint8_t> image(64U, 0xFFU);
+    size_t consumed = 0U;
+
+    // Act
+    const int32_t frames =
+        decoder->decode(image.data(), image.size(), consumed, pcm.data(), MAX_FRAMES);
+
+    // Expect
+    EXPECT_EQ(player::IAudioDecoder::DECODE_ERROR, frames);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "WavDecoder.hpp"
+#include "gtest/gtest.h"
+
+class WavDecoderTest : public ::testing::Test {
+   protected:
+    static constexpr size_t MAX_FRAMES = 64U;
+
+    void SetUp() override;
+    void TearDown() override;
+
+    // Feeds the image in pieces of at most `step` bytes, the way the pipeline hands it over
+    std::vector<int16_t> decodeAll(const std::vector<uint8_t> &image, const size_t &step);
+
+    std::unique_ptr<player::WavDecoder> decoder;
+    std::array<int16_t, MAX_FRAMES * player::MAX_CHANNELS> pcm{};
+};
@@ -0,0 +1,69 @@
+#include "ButtonDebouncerTest.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+struct Edge {
+    uint64_t timestampUs;
+    uint8_t level;
+};
+
+// Replays a recorded edge timeline and returns the timestamps of reported presses
+std::vector<uint64_t> replay(services::ButtonDebouncer &debouncer,
+                             const std::vector<Edge> &timeline) {
+    std::vector<uint64_t> presses;
+    for (const auto &edge : timeline) {
+        if (debouncer.onEdge(edge.level, edge.timestampUs)) {
+            presses.push_back(edge.timestampUs);
+        }
+    }
+    return presses;
+}
+}  // namespace
+
+void ButtonDebouncerTest::SetUp() {
+    debouncer = std::make_unique<services::ButtonDebouncer>();
+}
+
+void ButtonDebouncerTest::TearDown() {
+    debouncer.reset();
+}
+
+TEST_F(ButtonDebouncerTest, onEdge_BouncyPress_ReportsOnFirstEdge) {
+    // Arrange: press bounce, hold, release bounce, second press 100 ms later
+    const std::vector<Edge> timeline = {
+        {1000U, 0U},   {1150U, 1U},   {1300U, 0U},   {1420U, 1U},   {1500U, 0U},
+        {60000U, 1U},  {60200U, 0U},  {60350U, 1U},  {160000U, 0U}, {160300U, 1U},
+        {160400U, 0U}, {240000U, 1U},
+    };
+
+    // Act
+    const auto presses = replay(*debouncer, timeline);
+
+    // Expect
+    EXPECT_EQ((std::vector<uint64_t>{1000U, 160000U}), presses);
+}
+
+TEST_F(ButtonDebouncerTest, onEdge_MissedReleaseEdge_ReportsSecondPress) {
+    // Arrange: the ISR lost the release edge between two presses
+    const std::vector<Edge> timeline = {{1000U, 0U}, {300000U, 0U}, {380000U, 1U}};
+
+    // Act
+    const auto presses = replay(*debouncer, timeline);
+
+    // Expect
+    EXPECT_EQ((std::vector<uint64_t>{1000U, 300000U}), presses);
+}
+
+TEST_F(ButtonDebouncerTest, onEdge_ReleaseWithinSettleTime_IgnoresRepress) {
+    // Arrange
+    const std::vector<Edge> timeline = {{0U, 0U}, {5000U, 1U}, {15000U, 0U}};
+
+    // Act
+    const auto presses = replay(*debouncer, timeline);
+
+    // Expect
+    EXPECT_EQ((std::vector<uint64_t>{0U}), presses);
+    EXPECT_TRUE(debouncer->isPressed());
+}
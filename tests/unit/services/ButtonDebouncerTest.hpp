@@ -0,0 +1,14 @@
+#pragma once
+
+#include <memory>
+
+#include "ButtonDebouncer.hpp"
+#include "gtest/gtest.h"
+
+class ButtonDebouncerTest : public ::testing::Test {
+   protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    std::unique_ptr<services::ButtonDebouncer> debouncer;
+};
@@ -0,0 +1,104 @@
+#include "CanvasTextTest.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include "GlyphTable.hpp"
+#include "UiTypes.hpp"
+
+using services::Canvas;
+
+using Cell = std::array<uint8_t, Canvas::GLYPH_WIDTH>;
+
+void CanvasTextTest::SetUp() {
+    canvas.setTarget(framebuffer.data());
+}
+
+Cell CanvasTextTest::cellAt(const uint8_t &x) const {
+    Cell cell{};
+    std::copy_n(&framebuffer[Canvas::offset(x, 0U)], cell.size(), cell.begin());
+    return cell;
+}
+
+Cell CanvasTextTest::render(const std::string_view &txt) {
+    framebuffer.fill(0U);
+    canvas.drawText(0U, 0U, txt, false);
+    return cellAt(0U);
+}
+
+TEST_F(CanvasTextTest, glyphTable_IsSortedAboveAscii) {
+    // Expect: binary search needs strictly ascending code points
+    const auto &codepoints = common::EXTENDED_CODEPOINTS;
+    EXPECT_TRUE(std::is_sorted(codepoints.begin(), codepoints.end()));
+    EXPECT_EQ(codepoints.end(), std::adjacent_find(codepoints.begin(), codepoints.end()));
+    EXPECT_GE(codepoints.front(), common::FONT5x7.size());
+}
+
+TEST_F(CanvasTextTest, drawText_Utf8_OneCellPerCodePoint) {
+    // Arrange
+    const Cell missing = render("?");
+    framebuffer.fill(0U);
+
+    // Act
+    canvas.drawText(0U, 0U, "éЖ€", false);
+
+    // Expect: three cells, none of them the fallback
+    for (uint8_t i = 0U; i < 3U; ++i) {
+        EXPECT_NE(missing, cellAt(static_cast<uint8_t>(i * Canvas::GLYPH_ADVANCE)));
+    }
+    EXPECT_EQ(Cell{}, cellAt(3U * Canvas::GLYPH_ADVANCE));
+    EXPECT_EQ(3U * Canvas::GLYPH_ADVANCE, Canvas::textWidth("éЖ€"));
+}
+
+TEST_F(CanvasTextTest, drawText_SharedShapes_MatchBaseFont) {
+    // Expect: Cyrillic look-alikes reuse the Latin glyph, accents keep the base letter body
+    EXPECT_EQ(render("A"), render("А"));
+    EXPECT_EQ(render("o"), render("о"));
+    EXPECT_NE(render("e"), render("é"));
+    const Cell e = render("e");
+    const Cell eAcute = render("é");
+    for (size_t col = 0U; col < e.size(); ++col) {
+        // Body rows 2-6 are identical, the acute sits on rows 0-1
+        EXPECT_EQ(e[col] & 0x7CU, eAcute[col] & 0x7CU);
+    }
+}
+
+TEST_F(CanvasTextTest, drawText_NoGlyph_DrawsQuestionMark) {
+    // Expect: unknown scripts and malformed bytes are visible but harmless
+    const Cell missing = render("?");
+    EXPECT_EQ(missing, render("\xE4\xB8\xAD"));  // CJK
+    EXPECT_EQ(missing, render("\xFF"));
+}
+
+TEST_F(CanvasTextTest, drawText_MixedScripts_Throughput) {
+    // Arrange: one list row per script
+    struct Sample {
+        const char *name;
+        std::string_view text;
+    };
+    const Sample samples[] = {
+        {"ascii", "Radio Paradise Main "},
+        {"latin", "Café Örebro Łódź Ñü"},
+        {"cyrillic", "Русское Радио Ёлка  "},
+        {"mixed", "FIP Žižkov Эхо €ÆØ…"},
+    };
+    static constexpr int ITERATIONS = 20000;
+
+    for (const Sample &sample : samples) {
+        // Act
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            canvas.drawText(0U, static_cast<uint8_t>(i % Canvas::PAGES), sample.text, false);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        // Expect
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+        const double glyphs = static_cast<double>(ITERATIONS) * Canvas::textWidth(sample.text) /
+                              Canvas::GLYPH_ADVANCE;
+        std::printf("[ TEXT     ] %-8s %5.1f Mglyph/s, %4zu bytes/row\n", sample.name,
+                    glyphs / seconds / 1e6, sample.text.size());
+        EXPECT_GT(seconds, 0.0);
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <string_view>
+
+#include "Canvas.hpp"
+
+class CanvasTextTest : public ::testing::Test {
+   protected:
+    void SetUp() override;
+
+    // Columns of the glyph cell at x on page 0
+    std::array<uint8_t, services::Canvas::GLYPH_WIDTH> cellAt(const uint8_t &x) const;
+    // Glyph cell drawText() leaves for txt on a blank page
+    std::array<uint8_t, services::Canvas::GLYPH_WIDTH> render(const std::string_view &txt);
+
+    services::Canvas::Framebuffer framebuffer{};
+    services::Canvas canvas;
+};
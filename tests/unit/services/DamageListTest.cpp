@@ -0,0 +1,82 @@
+#include "DamageListTest.hpp"
+
+static bool covers(const services::DamageList &damage, const adapters::DisplayRegion &r) {
+    // Every pixel of r lies in some region of the list
+    for (int page = r.pageStart; page <= r.pageEnd; ++page) {
+        for (int col = r.colStart; col <= r.colEnd; ++col) {
+            const uint8_t c = static_cast<uint8_t>(col);
+            const uint8_t p = static_cast<uint8_t>(page);
+            const adapters::DisplayRegion px = {c, c, p, p};
+            bool found = false;
+            for (size_t i = 0; i < damage.count() && !found; ++i) {
+                found = services::DamageList::intersects(damage.data()[i], px);
+            }
+            if (!found) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+TEST_F(DamageListTest, add_TouchingRegions_MergeWhenAreaDoesNotGrow) {
+    // Act: two halves of a row and a far away cell
+    damage.add({0U, 9U, 2U, 2U});
+    damage.add({10U, 19U, 2U, 2U});
+    damage.add({100U, 105U, 6U, 6U});
+
+    // Expect
+    ASSERT_EQ(2U, damage.count());
+    EXPECT_EQ(0U, damage.data()[0].colStart);
+    EXPECT_EQ(19U, damage.data()[0].colEnd);
+    EXPECT_FALSE(damage.coversAll());
+}
+
+TEST_F(DamageListTest, add_BeyondCapacity_StillCoversEverything) {
+    // Arrange
+    std::vector<adapters::DisplayRegion> added;
+    for (uint8_t i = 0; i < 20U; ++i) {
+        added.push_back({static_cast<uint8_t>(i * 6U), static_cast<uint8_t>(i * 6U + 2U),
+                         static_cast<uint8_t>(i % 8U), static_cast<uint8_t>(i % 8U)});
+    }
+
+    // Act
+    for (const auto &r : added) {
+        damage.add(r);
+    }
+
+    // Expect
+    EXPECT_LE(damage.count(), services::DamageList::MAX_REGIONS);
+    for (const auto &r : added) {
+        EXPECT_TRUE(covers(damage, r));
+    }
+}
+
+TEST_F(DamageListTest, shift_MovesPartsInsideAreaAndDropsWhatLeaves) {
+    // Arrange: the area is the list under the status row
+    const adapters::DisplayRegion list = {0U, 127U, 1U, 7U};
+    damage.add({0U, 5U, 1U, 1U});       // scrolls out of view
+    damage.add({20U, 30U, 4U, 4U});     // moves up two rows
+    damage.add({104U, 127U, 0U, 0U});   // outside, stays
+
+    // Act
+    damage.shift(list, 2);
+
+    // Expect
+    ASSERT_EQ(2U, damage.count());
+    EXPECT_TRUE(covers(damage, {20U, 30U, 2U, 2U}));
+    EXPECT_TRUE(covers(damage, {104U, 127U, 0U, 0U}));
+    EXPECT_FALSE(covers(damage, {0U, 5U, 1U, 1U}));
+}
+
+TEST_F(DamageListTest, markAll_CoversAll) {
+    // Act
+    damage.add({0U, 5U, 1U, 1U});
+    damage.markAll();
+
+    // Expect
+    EXPECT_EQ(1U, damage.count());
+    EXPECT_TRUE(damage.coversAll());
+    damage.clear();
+    EXPECT_TRUE(damage.isEmpty());
+}
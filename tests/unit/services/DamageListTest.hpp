@@ -0,0 +1,9 @@
+#pragma once
+
+#include "DamageList.hpp"
+#include "gtest/gtest.h"
+
+class DamageListTest : public ::testing::Test {
+   protected:
+    services::DamageList damage;
+};
@@ -0,0 +1,140 @@
+#include "FrameSwapTest.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+static constexpr size_t FRAME_SIZE = services::Canvas::FRAME_SIZE;
+static constexpr adapters::DisplayRegion PAGE_0 = {0U, 127U, 0U, 0U};
+static constexpr adapters::DisplayRegion PAGE_7 = {0U, 127U, 7U, 7U};
+
+void FrameSwapTest::SetUp() {
+    frames = std::make_unique<services::FrameSwap>();
+}
+
+void FrameSwapTest::TearDown() {
+    frames.reset();
+}
+
+TEST_F(FrameSwapTest, acquireFront_NothingPublished_ReturnsNull) {
+    // Arrange
+    services::FrameSwap::FrameInfo info;
+
+    // Act & Expect
+    EXPECT_EQ(nullptr, frames->acquireFront(info));
+    frames->beginFrame(10U);
+    EXPECT_EQ(nullptr, frames->acquireFront(info));
+}
+
+TEST_F(FrameSwapTest, beginFrame_WhileFlushing_RendersIntoOtherBufferWithLatestContent) {
+    // Arrange
+    uint8_t *first = frames->beginFrame(10U);
+    first[0] = 0xAA;
+    frames->backInfo().damage.add(PAGE_0);
+    frames->publishFrame();
+
+    services::FrameSwap::FrameInfo info;
+    const uint8_t *front = frames->acquireFront(info);
+    ASSERT_EQ(first, front);
+    EXPECT_EQ(10U, info.oldestChangeUs);
+    EXPECT_EQ(1U, info.damage.count());
+
+    // Act
+    uint8_t *back = frames->beginFrame(20U);
+
+    // Expect: damage is counted from the frame on the wire, so it starts clean
+    EXPECT_NE(front, back);
+    EXPECT_EQ(0xAA, back[0]);
+    EXPECT_TRUE(frames->backInfo().damage.isEmpty());
+    EXPECT_EQ(0, frames->backInfo().scrollPages);
+    EXPECT_EQ(0U, frames->getDroppedFrames());
+}
+
+TEST_F(FrameSwapTest, beginFrame_UnsentFrame_IsReclaimedWithStampAndDamage) {
+    // Arrange: the flusher is busy, a frame is published behind it
+    frames->beginFrame(10U);
+    frames->publishFrame();
+    services::FrameSwap::FrameInfo info;
+    ASSERT_NE(nullptr, frames->acquireFront(info));
+
+    uint8_t *pending = frames->beginFrame(20U);
+    pending[1] = 0x01;
+    frames->backInfo().damage.add(PAGE_0);
+    frames->backInfo().scrollPages += 1;
+    frames->publishFrame();
+
+    // Act: a newer change arrives before the flusher picks the frame up
+    uint8_t *back = frames->beginFrame(30U);
+    back[1] = 0x02;
+    frames->backInfo().damage.add(PAGE_7);
+    frames->backInfo().scrollPages += 1;
+    frames->publishFrame();
+    frames->releaseFront();
+
+    // Expect: only the newest frame goes out, stamped with the oldest unsent change and
+    // carrying the damage of both
+    const uint8_t *front = frames->acquireFront(info);
+    EXPECT_EQ(pending, back);
+    ASSERT_EQ(back, front);
+    EXPECT_EQ(0x02, front[1]);
+    EXPECT_EQ(20U, info.oldestChangeUs);
+    EXPECT_EQ(2U, info.damage.count());
+    EXPECT_EQ(2, info.scrollPages);
+    EXPECT_EQ(1U, frames->getDroppedFrames());
+    frames->releaseFront();
+    EXPECT_EQ(nullptr, frames->acquireFront(info));
+}
+
+TEST_F(FrameSwapTest, concurrentRenderAndFlush_NeverShareABuffer) {
+    // Arrange: the renderer fills whole frames with a counter, the flusher checks that every
+    // frame it sends is uniform and that frames never go backwards
+    static constexpr uint32_t FRAMES = 20000U;
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> torn{0U};
+    std::atomic<uint32_t> reordered{0U};
+    uint32_t flushed = 0U;
+
+    // Act
+    std::thread flusher([&] {
+        uint64_t lastChangeUs = 0U;
+        services::FrameSwap::FrameInfo info;
+        while (true) {
+            const bool finished = done.load();
+            const uint8_t *front = frames->acquireFront(info);
+            if (front == nullptr) {
+                if (finished) {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+
+            for (size_t i = 1; i < FRAME_SIZE; ++i) {
+                if (front[i] != front[0]) {
+                    torn.fetch_add(1U);
+                    break;
+                }
+            }
+            if (info.oldestChangeUs <= lastChangeUs) {
+                reordered.fetch_add(1U);
+            }
+            lastChangeUs = info.oldestChangeUs;
+            ++flushed;
+            frames->releaseFront();
+        }
+    });
+
+    for (uint32_t i = 1; i <= FRAMES; ++i) {
+        uint8_t *back = frames->beginFrame(i);
+        std::memset(back, static_cast<int>(i & 0xFFU), FRAME_SIZE);
+        frames->publishFrame();
+    }
+    done.store(true);
+    flusher.join();
+
+    // Expect
+    EXPECT_EQ(0U, torn.load());
+    EXPECT_EQ(0U, reordered.load());
+    EXPECT_GT(flushed, 0U);
+    EXPECT_EQ(FRAMES, flushed + frames->getDroppedFrames());
+}
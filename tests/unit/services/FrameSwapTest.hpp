@@ -0,0 +1,14 @@
+#pragma once
+
+#include <memory>
+
+#include "FrameSwap.hpp"
+#include "gtest/gtest.h"
+
+class FrameSwapTest : public ::testing::Test {
+   protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    std::unique_ptr<services::FrameSwap> frames;
+};
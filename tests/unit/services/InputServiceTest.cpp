@@ -0,0 +1,77 @@
+#include "InputServiceTest.hpp"
+
+#include "Metrics.hpp"
+
+using ::testing::_;
+using ::testing::AllOf;
+using ::testing::Field;
+
+void InputServiceTest::SetUp() {
+    clock = std::make_unique<common::FakeClock>();
+    mockSink = std::make_unique<core::MockInputSink>();
+    inputService = std::make_unique<services::InputService>(*mockSink, *clock);
+}
+
+void InputServiceTest::TearDown() {
+    inputService.reset();
+    mockSink.reset();
+    clock.reset();
+}
+
+TEST_F(InputServiceTest, onEdge_ButtonPress_EmitsEventAndRecordsLatency) {
+    // Arrange
+    const auto *latency = metrics::Registry::instance().findHistogram("input.button_us");
+    ASSERT_NE(nullptr, latency);
+    const uint32_t countBefore = latency->snapshot().count;
+    clock->setUs(1800U);
+
+    // Expect
+    EXPECT_CALL(*mockSink, onInput(AllOf(Field(&common::InputEvent::type,
+                                               common::InputEvent::Type::Down),
+                                         Field(&common::InputEvent::edgeUs, 1000U))))
+        .Times(1);
+
+    // Act
+    inputService->onEdge({1000U, common::InputPin::Down, 0U});
+    inputService->onEdge({1100U, common::InputPin::Down, 1U});
+    inputService->onEdge({1200U, common::InputPin::Down, 0U});
+
+    // Expect
+    const auto snapshot = latency->snapshot();
+    EXPECT_EQ(countBefore + 1U, snapshot.count);
+    EXPECT_GE(snapshot.max, 800U);
+}
+
+TEST_F(InputServiceTest, onEdge_LateDispatch_CountsSloMiss) {
+    // Arrange
+    const auto *misses = metrics::Registry::instance().findCounter("input.slo_misses");
+    ASSERT_NE(nullptr, misses);
+    const uint32_t missesBefore = misses->value();
+    clock->setUs(services::InputService::BUTTON_LATENCY_SLO_US + 2000U);
+
+    // Expect
+    EXPECT_CALL(*mockSink, onInput(_)).Times(1);
+
+    // Act
+    inputService->onEdge({1000U, common::InputPin::PlayStop, 0U});
+
+    // Expect
+    EXPECT_EQ(missesBefore + 1U, misses->value());
+}
+
+TEST_F(InputServiceTest, onEdge_EncoderDetent_EmitsVolumeSteps) {
+    // Arrange
+    clock->setUs(5000U);
+
+    // Expect
+    EXPECT_CALL(*mockSink, onInput(AllOf(Field(&common::InputEvent::type,
+                                               common::InputEvent::Type::Volume),
+                                         Field(&common::InputEvent::steps, -1))))
+        .Times(1);
+
+    // Act: A and B edges interleave, each sampling both lines
+    inputService->onEdge({1000U, common::InputPin::EncoderB, 0b01});
+    inputService->onEdge({1500U, common::InputPin::EncoderA, 0b00});
+    inputService->onEdge({2000U, common::InputPin::EncoderB, 0b10});
+    inputService->onEdge({2500U, common::InputPin::EncoderA, 0b11});
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <memory>
+
+#include "FakeClock.hpp"
+#include "InputService.hpp"
+#include "MockInputSink.hpp"
+#include "gtest/gtest.h"
+
+class InputServiceTest : public ::testing::Test {
+   protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    std::unique_ptr<common::FakeClock> clock;
+    std::unique_ptr<core::MockInputSink> mockSink;
+    std::unique_ptr<services::InputService> inputService;
+};
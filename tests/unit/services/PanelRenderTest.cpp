@@ -0,0 +1,107 @@
+#include "PanelRenderTest.hpp"
+
+#include <cstdio>
+#include <type_traits>
+#include <vector>
+
+using Reference = common::Ssd1306Panel128x64;
+
+template <typename Panel>
+void PanelRenderTest<Panel>::SetUp() {
+    canvas.setTarget(framebuffer.data());
+    ASSERT_TRUE(display.init());
+}
+
+template <typename Panel>
+void PanelRenderTest<Panel>::drawScene(Canvas &canvas) {
+    canvas.drawText(0U, 0U, "W > 21.5C", false);
+    canvas.drawText(6U, 1U, "Radio Paradise", true);
+    canvas.fill({120U, 127U, Canvas::PAGES - 1U, Canvas::PAGES - 1U}, 0x3CU);
+}
+
+TYPED_TEST(PanelRenderTest, showFramebuffer_GlassShowsFramebuffer) {
+    // Arrange
+    TestFixture::drawScene(this->canvas);
+
+    // Act
+    this->display.showFramebuffer(this->framebuffer.data(), this->framebuffer.size());
+
+    // Expect: column offset and addressing mode are the driver's business only
+    const std::vector<uint8_t> expected(this->framebuffer.begin(), this->framebuffer.end());
+    EXPECT_EQ(expected, this->bus.visibleFrame());
+}
+
+TYPED_TEST(PanelRenderTest, scrollPages_GlassShowsMovedFramebuffer) {
+    // Arrange
+    using Canvas = typename TestFixture::Canvas;
+    TestFixture::drawScene(this->canvas);
+    this->display.showFramebuffer(this->framebuffer.data(), this->framebuffer.size());
+
+    // Act: rotate everything up a page and send only the exposed bottom page
+    const adapters::DisplayRegion bottom = {0U, Canvas::WIDTH - 1U, Canvas::PAGES - 1U,
+                                            Canvas::PAGES - 1U};
+    this->canvas.movePages(Canvas::SCREEN, 1);
+    this->canvas.fill(bottom, 0x81U);
+    this->display.scrollPages(1);
+    this->display.showRegions(this->framebuffer.data(), this->framebuffer.size(), &bottom, 1U);
+
+    // Expect
+    const std::vector<uint8_t> expected(this->framebuffer.begin(), this->framebuffer.end());
+    EXPECT_EQ(expected, this->bus.visibleFrame());
+}
+
+TYPED_TEST(PanelRenderTest, drawScene_MatchesReferencePanelPixels) {
+    // Arrange
+    using Canvas = typename TestFixture::Canvas;
+    services::BasicCanvas<Reference>::Framebuffer referenceFb{};
+    services::BasicCanvas<Reference> reference;
+    reference.setTarget(referenceFb.data());
+
+    // Act
+    reference.drawText(0U, 0U, "W > 21.5C", false);
+    reference.drawText(6U, 1U, "Radio Paradise", true);
+    TestFixture::drawScene(this->canvas);
+
+    // Expect: the pages above the marker are byte for byte what the 128x64 build draws
+    for (uint8_t page = 0U; page + 1U < Canvas::PAGES; ++page) {
+        for (uint8_t x = 0U; x < Canvas::WIDTH; ++x) {
+            ASSERT_EQ(referenceFb[Canvas::offset(x, page)],
+                      this->framebuffer[Canvas::offset(x, page)])
+                << "x " << int(x) << " page " << int(page);
+        }
+    }
+}
+
+TYPED_TEST(PanelRenderTest, geometry_IsResolvedAtCompileTime) {
+    using Panel = TypeParam;
+    using Canvas = typename TestFixture::Canvas;
+    using Display = adapters::OledDisplay<Panel>;
+    using ReferenceDisplay = adapters::OledDisplay<Reference>;
+
+    // Descriptors are types only, index math folds to constants
+    static_assert(std::is_empty_v<Panel>);
+    static_assert(Canvas::offset(5U, 3U) == 3U * Panel::WIDTH + 5U);
+    static_assert(sizeof(typename Canvas::Framebuffer) == Panel::FRAME_SIZE);
+
+    // No geometry is stored per instance: objects differ by the sized buffer and its padding
+    constexpr size_t overhead = sizeof(Display) - Display::MAX_TRANSACTION_SIZE;
+    constexpr size_t referenceOverhead =
+        sizeof(ReferenceDisplay) - ReferenceDisplay::MAX_TRANSACTION_SIZE;
+    static_assert(sizeof(Canvas) == sizeof(services::BasicCanvas<Reference>));
+    static_assert(overhead < referenceOverhead + alignof(Display) &&
+                  referenceOverhead < overhead + alignof(Display));
+
+    // Arrange
+    TestFixture::drawScene(this->canvas);
+    this->bus.resetCounters();
+
+    // Act
+    this->display.showFramebuffer(this->framebuffer.data(), this->framebuffer.size());
+
+    // Expect: one transaction per page, addressing plus a page row of data each
+    const size_t addressBytes = this->bus.getBytes() - this->bus.getDataBytes();
+    std::printf("[ PANEL    ] %ux%u col offset %u: %zu bytes, %zu address\n", Panel::WIDTH,
+                Panel::HEIGHT, Panel::COLUMN_OFFSET, this->bus.getBytes(), addressBytes);
+    EXPECT_EQ(Panel::PAGES, this->bus.getTransactions());
+    EXPECT_EQ(Panel::FRAME_SIZE, this->bus.getDataBytes());
+}
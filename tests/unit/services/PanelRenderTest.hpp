@@ -0,0 +1,29 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "Canvas.hpp"
+#include "FakeOledBus.hpp"
+#include "OledDisplay.hpp"
+#include "OledPanel.hpp"
+
+// Renderer and driver instantiated for one panel, wired to an emulated controller
+template <typename Panel>
+class PanelRenderTest : public ::testing::Test {
+   protected:
+    using Canvas = services::BasicCanvas<Panel>;
+
+    void SetUp() override;
+
+    // The same scene on every panel: status text on top, a marker on the last page
+    static void drawScene(Canvas &canvas);
+
+    adapters::FakeOledBus<Panel> bus;
+    adapters::OledDisplay<Panel> display{bus};
+    typename Canvas::Framebuffer framebuffer{};
+    Canvas canvas;
+};
+
+using Panels = ::testing::Types<common::Ssd1306Panel128x64, common::Ssd1306Panel128x32,
+                                common::Sh1106Panel128x64>;
+TYPED_TEST_SUITE(PanelRenderTest, Panels);
@@ -0,0 +1,82 @@
+#include "QuadratureDecoderTest.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+// One clockwise / counter-clockwise detent, starting from the rest state 0b11
+const std::vector<uint8_t> CW_DETENT = {0b10, 0b00, 0b01, 0b11};
+const std::vector<uint8_t> CCW_DETENT = {0b01, 0b00, 0b10, 0b11};
+
+int sumSteps(services::QuadratureDecoder &decoder, const std::vector<uint8_t> &states,
+             const uint64_t &timestampUs) {
+    int steps = 0;
+    for (const auto state : states) {
+        steps += decoder.onState(state, timestampUs);
+    }
+    return steps;
+}
+}  // namespace
+
+void QuadratureDecoderTest::SetUp() {
+    decoder = std::make_unique<services::QuadratureDecoder>();
+}
+
+void QuadratureDecoderTest::TearDown() {
+    decoder.reset();
+}
+
+TEST_F(QuadratureDecoderTest, onState_FullDetents_ReportsDirection) {
+    // Act & Expect
+    EXPECT_EQ(1, sumSteps(*decoder, CW_DETENT, 0U));
+    EXPECT_EQ(-1, sumSteps(*decoder, CCW_DETENT, 1000000U));
+}
+
+TEST_F(QuadratureDecoderTest, onState_ContactBounce_ReportsSingleDetent) {
+    // Arrange: A bounces twice before the detent completes
+    const std::vector<uint8_t> states = {0b10, 0b11, 0b10, 0b11, 0b10,
+                                         0b00, 0b01, 0b00, 0b01, 0b11};
+
+    // Act
+    const int steps = sumSteps(*decoder, states, 0U);
+
+    // Expect
+    EXPECT_EQ(1, steps);
+    EXPECT_EQ(0U, decoder->getSkippedStates());
+}
+
+TEST_F(QuadratureDecoderTest, onState_SkippedState_KeepsDirection) {
+    // Arrange: the 0b00 state was never sampled
+    const std::vector<uint8_t> states = {0b10, 0b01, 0b11};
+
+    // Act
+    const int steps = sumSteps(*decoder, states, 0U);
+
+    // Expect
+    EXPECT_EQ(1, steps);
+    EXPECT_EQ(1U, decoder->getSkippedStates());
+}
+
+TEST_F(QuadratureDecoderTest, onState_ReturnToRestWithoutDetent_ReportsNothing) {
+    // Arrange: the knob is nudged and springs back
+    const std::vector<uint8_t> states = {0b10, 0b11};
+
+    // Act & Expect
+    EXPECT_EQ(0, sumSteps(*decoder, states, 0U));
+}
+
+TEST_F(QuadratureDecoderTest, onState_FastRotation_Accelerates) {
+    // Act
+    const int first = sumSteps(*decoder, CW_DETENT, 0U);
+    const int medium = sumSteps(*decoder, CW_DETENT, 50000U);
+    const int fast = sumSteps(*decoder, CW_DETENT, 70000U);
+    const int slow = sumSteps(*decoder, CW_DETENT, 400000U);
+    const int reversed = sumSteps(*decoder, CCW_DETENT, 410000U);
+
+    // Expect
+    EXPECT_EQ(1, first);
+    EXPECT_EQ(2, medium);
+    EXPECT_EQ(4, fast);
+    EXPECT_EQ(1, slow);
+    EXPECT_EQ(-1, reversed);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <memory>
+
+#include "QuadratureDecoder.hpp"
+#include "gtest/gtest.h"
+
+class QuadratureDecoderTest : public ::testing::Test {
+   protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    std::unique_ptr<services::QuadratureDecoder> decoder;
+};
@@ -1,7 +1,21 @@
 #include "UiServiceTest.hpp"
 
+#include <esp_timer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
+#include <string>
+#include <thread>
 
+#include "AllocationCounter.hpp"
+#include "FakeOledBus.hpp"
+#include "FakeStationRepository.hpp"
+#include "IFrameListener.hpp"
+#include "Metrics.hpp"
+#include "OledDisplay.hpp"
 #include "UiTypes.hpp"
 
 using ::testing::_;
@@ -58,20 +72,560 @@ TEST_F(UiServiceTest, OnEvent_RenderStations_FetchesFromRepoAndDisplays) {
     expectedFrameBuffer[page2base + 9] = common::FONT5x7[static_cast<uint8_t>('2')][3];
     expectedFrameBuffer[page2base + 10] = common::FONT5x7[static_cast<uint8_t>('2')][4];
     expectedFrameBuffer[page2base + 11] = 0x00;  // 1px spacing
+    // selection mark in front of station 2
+    for (uint8_t col = 0; col < 5U; ++col) {
+        expectedFrameBuffer[page2base - 6U + col] = common::FONT5x7[static_cast<uint8_t>('>')][col];
+    }
 
     common::UiEvent event;
     event.type = common::UiEvent::Type::RENDER_STATIONS;
     event.selectedIndex = 1;
 
-    // Expectations
-    EXPECT_CALL(*mockRepo, getStations()).WillOnce(::testing::ReturnRef(stations));
-    EXPECT_CALL(*mockDisplay, showFramebuffer(_, expectedFrameBuffer.size()))
+    // Expectations: only the list pages under the status bar go out
+    EXPECT_CALL(*mockRepo, getStations()).WillRepeatedly(::testing::ReturnRef(stations));
+    EXPECT_CALL(*mockDisplay, showRegions(_, expectedFrameBuffer.size(), _, 1U))
         .Times(1)
-        .WillOnce([expectedFrameBuffer](const uint8_t* framebuffer, const size_t& len) {
+        .WillOnce([expectedFrameBuffer](const uint8_t* framebuffer, const size_t& len,
+                                        const adapters::DisplayRegion* regions,
+                                        const size_t& count) {
             EXPECT_EQ(expectedFrameBuffer.size(), len);
             EXPECT_TRUE(std::memcmp(framebuffer, expectedFrameBuffer.data(), len) == 0);
+            EXPECT_EQ(0U, regions[0].colStart);
+            EXPECT_EQ(127U, regions[0].colEnd);
+            EXPECT_EQ(1U, regions[0].pageStart);
+            EXPECT_EQ(7U, regions[0].pageEnd);
+        });
+
+    // Act
+    uiService->onEvent(event);
+}
+
+namespace {
+common::UiEvent stationsEvent(const int selectedIndex) {
+    common::UiEvent event;
+    event.type = common::UiEvent::Type::RENDER_STATIONS;
+    event.selectedIndex = selectedIndex;
+    return event;
+}
+}  // namespace
+
+TEST_F(UiServiceTest, RenderStations_ScrollByOneRow_UploadsOnlyChangedPages) {
+    // Arrange: a real driver on a bus that decodes into panel RAM
+    std::vector<common::StationData> stations;
+    for (int i = 0; i < 20; ++i) {
+        const std::string n = std::to_string(i);
+        stations.push_back({"id" + n, "Station " + n, "url" + n});
+    }
+    EXPECT_CALL(*mockRepo, getStations()).WillRepeatedly(::testing::ReturnRef(stations));
+
+    adapters::FakeOledBus<common::BoardOledPanel> bus;
+    adapters::BoardOledDisplay oled(bus);
+    services::UiService ui(oled, *mockRepo);
+    ASSERT_TRUE(oled.init());
+    ASSERT_TRUE(ui.init());
+    ui.onEvent(stationsEvent(0));
+
+    // A full redraw of the same screen, for reference
+    bus.resetCounters();
+    oled.showFramebuffer(ui.getFramebuffer(), FRAMEBUFFER_SIZE);
+    const size_t fullBytes = bus.getBytes();
+    const size_t fullTransactions = bus.getTransactions();
+
+    // Act & Expect: walk down past the last visible row and back up, the panel must always
+    // show the rendered frame
+    size_t scrollBytes = 0U;
+    size_t scrollTransactions = 0U;
+    size_t scrollDataBytes = 0U;
+    int scrolls = 0;
+    for (int selected = 1; selected < static_cast<int>(stations.size()); ++selected) {
+        bus.resetCounters();
+        const uint8_t startLine = bus.getStartLine();
+        ui.onEvent(stationsEvent(selected));
+
+        EXPECT_EQ(std::vector<uint8_t>(ui.getFramebuffer(), ui.getFramebuffer() + 1024U),
+                  bus.visibleFrame())
+            << "selected " << selected;
+        if (bus.getStartLine() != startLine) {
+            ++scrolls;
+            scrollBytes = std::max(scrollBytes, bus.getBytes());
+            scrollTransactions = std::max(scrollTransactions, bus.getTransactions());
+            scrollDataBytes = std::max(scrollDataBytes, bus.getDataBytes());
+        }
+    }
+    for (int selected = static_cast<int>(stations.size()) - 2; selected >= 0; --selected) {
+        ui.onEvent(stationsEvent(selected));
+        EXPECT_EQ(std::vector<uint8_t>(ui.getFramebuffer(), ui.getFramebuffer() + 1024U),
+                  bus.visibleFrame())
+            << "selected " << selected;
+    }
+
+    // Wrapping around jumps further than a screen and falls back to redrawing the list
+    ui.onEvent(stationsEvent(19));
+    EXPECT_EQ(std::vector<uint8_t>(ui.getFramebuffer(), ui.getFramebuffer() + 1024U),
+              bus.visibleFrame());
+
+    printf("[ SCROLL   ] full redraw: %zu bytes in %zu transactions\n", fullBytes,
+           fullTransactions);
+    printf("[ SCROLL   ] one-row scroll: %zu bytes (%zu pixel bytes) in %zu transactions\n",
+           scrollBytes, scrollDataBytes, scrollTransactions);
+
+    // Status row and the exposed row, plus the cell the selection mark left
+    EXPECT_EQ(13, scrolls);
+    EXPECT_EQ(2U * 128U + 6U, scrollDataBytes);
+    EXPECT_EQ(3U, scrollTransactions);
+    EXPECT_LT(scrollBytes * 2U, fullBytes);
+}
+
+TEST_F(UiServiceTest, OnEvent_RenderStatus_SendsOnlyChangedSlots) {
+    // Arrange
+    std::vector<common::StationData> stations = {{"id1", "S1", "url1"}};
+    EXPECT_CALL(*mockRepo, getStations()).WillRepeatedly(::testing::ReturnRef(stations));
+
+    adapters::FakeOledBus<common::BoardOledPanel> bus;
+    adapters::BoardOledDisplay oled(bus);
+    services::UiService ui(oled, *mockRepo);
+    ASSERT_TRUE(oled.init());
+    ASSERT_TRUE(ui.init());
+    ui.onEvent(stationsEvent(0));
+
+    common::UiEvent event;
+    event.type = common::UiEvent::Type::RENDER_STATUS;
+    event.status.kind = common::UiStatusKind::WifiConnected;
+    event.status.rssiDbm = -55;
+    event.status.playback = common::PlaybackState::Playing;
+    event.status.batteryPct = 80U;
+    ui.onEvent(event);
+
+    bus.resetCounters();
+    oled.showFramebuffer(ui.getFramebuffer(), FRAMEBUFFER_SIZE);
+    const size_t fullBytes = bus.getBytes();
+
+    // Act & Expect: RSSI drifts within its band, then drops a band
+    bus.resetCounters();
+    event.status.rssiDbm = -58;
+    ui.onEvent(event);
+    EXPECT_EQ(0U, bus.getBytes());
+
+    event.status.rssiDbm = -66;
+    ui.onEvent(event);
+    const size_t rssiBytes = bus.getBytes();
+    EXPECT_EQ(1U, bus.getTransactions());
+    EXPECT_EQ(6U, bus.getDataBytes());
+
+    // Pausing rewrites the playback slot only
+    bus.resetCounters();
+    event.status.playback = common::PlaybackState::Paused;
+    ui.onEvent(event);
+    EXPECT_EQ(1U, bus.getTransactions());
+    EXPECT_EQ(6U, bus.getDataBytes());
+
+    EXPECT_EQ(std::vector<uint8_t>(ui.getFramebuffer(), ui.getFramebuffer() + FRAMEBUFFER_SIZE),
+              bus.visibleFrame());
+    printf("[ STATUS   ] RSSI band change: %zu bytes, full frame: %zu bytes\n", rssiBytes,
+           fullBytes);
+    EXPECT_LT(rssiBytes * 40U, fullBytes);
+}
+
+TEST_F(UiServiceTest, OnEvent_RenderVolume_TouchesOnlyVolumePixels) {
+    // Arrange: every widget has something on screen
+    std::vector<common::StationData> stations = {{"id1", "S1", "url1"}, {"id2", "S2", "url2"}};
+    std::vector<adapters::DisplayRegion> sent;
+    EXPECT_CALL(*mockRepo, getStations()).WillRepeatedly(::testing::ReturnRef(stations));
+    EXPECT_CALL(*mockDisplay, showFramebuffer(_, _)).Times(::testing::AnyNumber());
+    EXPECT_CALL(*mockDisplay, showRegions(_, _, _, _))
+        .WillRepeatedly([&sent](const uint8_t *, const size_t &,
+                                const adapters::DisplayRegion *regions, const size_t &count) {
+            sent.assign(regions, regions + count);
         });
 
+    ASSERT_TRUE(uiService->init());
+    common::UiEvent event;
+    event.type = common::UiEvent::Type::RENDER_STATUS;
+    event.status.kind = common::UiStatusKind::Playing;
+    event.status.playback = common::PlaybackState::Playing;
+    uiService->onEvent(event);
+    event.type = common::UiEvent::Type::RENDER_CLIMATE;
+    event.temperatureCentiC = 2351;
+    uiService->onEvent(event);
+    uiService->onEvent(stationsEvent(1));
+    event.type = common::UiEvent::Type::SHOW_TOAST;
+    std::snprintf(event.text.data(), event.text.size(), "Connected");
+    uiService->onEvent(event);
+    event.type = common::UiEvent::Type::RENDER_VOLUME;
+    event.volume = 40;
+    uiService->onEvent(event);
+    const std::vector<uint8_t> before(uiService->getFramebuffer(),
+                                      uiService->getFramebuffer() + FRAMEBUFFER_SIZE);
+
     // Act
+    event.volume = 42;
+    uiService->onEvent(event);
+
+    // Expect: the volume widget's rectangle is all that is repainted and sent
+    ASSERT_EQ(1U, sent.size());
+    EXPECT_EQ(104U, sent[0].colStart);
+    EXPECT_EQ(127U, sent[0].colEnd);
+    EXPECT_EQ(0U, sent[0].pageStart);
+    EXPECT_EQ(0U, sent[0].pageEnd);
+
+    const uint8_t *after = uiService->getFramebuffer();
+    size_t changed = 0U;
+    for (size_t i = 0; i < FRAMEBUFFER_SIZE; ++i) {
+        const bool inVolume = (i / 128U == 0U) && (i % 128U >= 104U);
+        if (!inVolume) {
+            EXPECT_EQ(before[i], after[i]) << "byte " << i;
+        } else if (before[i] != after[i]) {
+            ++changed;
+        }
+    }
+    EXPECT_GT(changed, 0U);
+}
+
+namespace {
+common::UiEvent playbackEvent(const common::PlaybackState &playback) {
+    common::UiEvent event;
+    event.type = common::UiEvent::Type::RENDER_STATUS;
+    event.status.playback = playback;
+    return event;
+}
+
+common::UiEvent spectrumEvent(const uint8_t &level) {
+    common::UiEvent event;
+    event.type = common::UiEvent::Type::RENDER_SPECTRUM;
+    event.spectrum.fill(level);
+    return event;
+}
+}  // namespace
+
+TEST_F(UiServiceTest, OnEvent_RenderSpectrum_SendsOnlyTheBarsThatMoved) {
+    // Arrange: playing, with the strip already up
+    std::vector<common::StationData> stations = {{"id1", "S1", "url1"}, {"id2", "S2", "url2"}};
+    std::vector<adapters::DisplayRegion> sent;
+    EXPECT_CALL(*mockRepo, getStations()).WillRepeatedly(::testing::ReturnRef(stations));
+    EXPECT_CALL(*mockDisplay, showFramebuffer(_, _)).Times(::testing::AnyNumber());
+    EXPECT_CALL(*mockDisplay, showRegions(_, _, _, _))
+        .WillRepeatedly([&sent](const uint8_t *, const size_t &,
+                                const adapters::DisplayRegion *regions, const size_t &count) {
+            sent.assign(regions, regions + count);
+        });
+    ASSERT_TRUE(uiService->init());
+    uiService->onEvent(stationsEvent(0));
+    uiService->onEvent(playbackEvent(common::PlaybackState::Playing));
+    uiService->onEvent(spectrumEvent(128U));
+    sent.clear();
+
+    // Act: bar 3 jumps, bar 9 moves by less than a pixel
+    common::UiEvent event = spectrumEvent(128U);
+    event.spectrum[3] = 255U;
+    event.spectrum[9] = 130U;
     uiService->onEvent(event);
+
+    // Expect: one bar wide, the strip's two pages high, full height bar drawn
+    ASSERT_EQ(1U, sent.size());
+    EXPECT_EQ(24U, sent[0].colStart);
+    EXPECT_EQ(31U, sent[0].colEnd);
+    EXPECT_EQ(6U, sent[0].pageStart);
+    EXPECT_EQ(7U, sent[0].pageEnd);
+    const uint8_t *frame = uiService->getFramebuffer();
+    EXPECT_EQ(0xFF, frame[6U * 128U + 24U]);
+    EXPECT_EQ(0x00, frame[6U * 128U + 31U]);  // gap
+    EXPECT_EQ(0x00, frame[6U * 128U + 16U]);  // half height stays on the bottom page
+    EXPECT_EQ(0xFF, frame[7U * 128U + 16U]);
+}
+
+TEST_F(UiServiceTest, OnEvent_RenderSpectrum_KeepsSelectionAboveStripUntilStopped) {
+    // Arrange: a real driver, so the scrolls the strip causes are checked on panel RAM
+    std::vector<common::StationData> stations;
+    for (int i = 0; i < 20; ++i) {
+        const std::string n = std::to_string(i);
+        stations.push_back({"id" + n, "Station " + n, "url" + n});
+    }
+    EXPECT_CALL(*mockRepo, getStations()).WillRepeatedly(::testing::ReturnRef(stations));
+
+    adapters::FakeOledBus<common::BoardOledPanel> bus;
+    adapters::BoardOledDisplay oled(bus);
+    services::UiService ui(oled, *mockRepo);
+    ASSERT_TRUE(oled.init());
+    ASSERT_TRUE(ui.init());
+    ui.onEvent(stationsEvent(6));  // bottom row, where the strip goes
+    ui.onEvent(playbackEvent(common::PlaybackState::Playing));
+
+    const uint8_t mark = common::FONT5x7[static_cast<uint8_t>('>')][2];
+    const auto markPage = [&ui, mark]() {
+        for (uint8_t page = 1U; page < 8U; ++page) {
+            if (ui.getFramebuffer()[page * 128U + 2U] == mark) {
+                return static_cast<int>(page);
+            }
+        }
+        return -1;
+    };
+
+    // Act & Expect: the first frame lifts the selection out of the strip, and walking the
+    // list with frames in between keeps it above
+    for (int selected = 6; selected < static_cast<int>(stations.size()); ++selected) {
+        ui.onEvent(stationsEvent(selected));
+        ui.onEvent(spectrumEvent(static_cast<uint8_t>(selected * 12)));
+        EXPECT_EQ(5, markPage()) << "selected " << selected;
+        EXPECT_EQ(std::vector<uint8_t>(ui.getFramebuffer(), ui.getFramebuffer() + 1024U),
+                  bus.visibleFrame())
+            << "selected " << selected;
+    }
+
+    // Act: stop, then a frame the spectrum task had in flight
+    ui.onEvent(playbackEvent(common::PlaybackState::Stopped));
+    const std::vector<uint8_t> stopped(ui.getFramebuffer(), ui.getFramebuffer() + 1024U);
+    ui.onEvent(spectrumEvent(200U));
+
+    // Expect: the late frame changes nothing, and the whole list height is usable again
+    EXPECT_EQ(stopped, std::vector<uint8_t>(ui.getFramebuffer(), ui.getFramebuffer() + 1024U));
+    ui.onEvent(stationsEvent(13));
+    const uint8_t s = common::FONT5x7[static_cast<uint8_t>('S')][0];
+    EXPECT_EQ(s, ui.getFramebuffer()[6U * 128U + 6U]);
+    EXPECT_EQ(s, ui.getFramebuffer()[7U * 128U + 6U]);
+    EXPECT_EQ(std::vector<uint8_t>(ui.getFramebuffer(), ui.getFramebuffer() + 1024U),
+              bus.visibleFrame());
+}
+
+TEST_F(UiServiceTest, tick_ExpiredToast_UncoversList) {
+    // Arrange
+    std::vector<common::StationData> stations;
+    for (int i = 0; i < 10; ++i) {
+        stations.push_back({"id", "Station " + std::to_string(i), "url"});
+    }
+    EXPECT_CALL(*mockRepo, getStations()).WillRepeatedly(::testing::ReturnRef(stations));
+    EXPECT_CALL(*mockDisplay, showFramebuffer(_, _)).Times(::testing::AnyNumber());
+    EXPECT_CALL(*mockDisplay, showRegions(_, _, _, _)).Times(::testing::AnyNumber());
+
+    ASSERT_TRUE(uiService->init());
+    uiService->onEvent(stationsEvent(0));
+    const std::vector<uint8_t> list(uiService->getFramebuffer(),
+                                    uiService->getFramebuffer() + FRAMEBUFFER_SIZE);
+
+    common::UiEvent event;
+    event.type = common::UiEvent::Type::SHOW_TOAST;
+    std::snprintf(event.text.data(), event.text.size(), "Saved");
+    event.postedUs = esp_timer_get_time() - 10000000;  // long enough ago to have expired
+    uiService->onEvent(event);
+    EXPECT_EQ(0xFF, uiService->getFramebuffer()[7U * 128U]);
+
+    // Act
+    uiService->tick();
+
+    // Expect
+    EXPECT_EQ(list, std::vector<uint8_t>(uiService->getFramebuffer(),
+                                         uiService->getFramebuffer() + FRAMEBUFFER_SIZE));
+}
+
+TEST_F(UiServiceTest, nextDeadlineUs_OnlyWhileToastIsShown) {
+    // Arrange
+    std::vector<common::StationData> stations;
+    EXPECT_CALL(*mockRepo, getStations()).WillRepeatedly(::testing::ReturnRef(stations));
+    EXPECT_CALL(*mockDisplay, showFramebuffer(_, _)).Times(::testing::AnyNumber());
+    EXPECT_CALL(*mockDisplay, showRegions(_, _, _, _)).Times(::testing::AnyNumber());
+    ASSERT_TRUE(uiService->init());
+
+    // Expect: an idle UI gives its task nothing to wake up for
+    EXPECT_EQ(services::UiService::NO_DEADLINE, uiService->nextDeadlineUs());
+
+    // Act
+    common::UiEvent event;
+    event.type = common::UiEvent::Type::SHOW_TOAST;
+    std::snprintf(event.text.data(), event.text.size(), "Saved");
+    event.postedUs = esp_timer_get_time();
+    uiService->onEvent(event);
+
+    // Expect: the toast expiry is the only deadline, early ticks leave it in place
+    const int64_t deadlineUs = uiService->nextDeadlineUs();
+    EXPECT_EQ(event.postedUs + services::UiService::TOAST_DURATION_US, deadlineUs);
+    uiService->tick();
+    EXPECT_EQ(deadlineUs, uiService->nextDeadlineUs());
+
+    event.postedUs -= services::UiService::TOAST_DURATION_US;
+    uiService->onEvent(event);
+    uiService->tick();
+    EXPECT_EQ(services::UiService::NO_DEADLINE, uiService->nextDeadlineUs());
+}
+
+TEST_F(UiServiceTest, onEvent_SteadyState_NoHeapAllocations) {
+    // Arrange: a real driver and a repository without gmock bookkeeping, so every allocation
+    // counted below is the render path's own
+    std::vector<common::StationData> stations;
+    for (int i = 0; i < 20; ++i) {
+        const std::string n = std::to_string(i);
+        stations.push_back({"id" + n, "Station number " + n, "url" + n});
+    }
+    services::FakeStationRepository repo(std::move(stations));
+    adapters::FakeOledBus<common::BoardOledPanel> bus;
+    adapters::BoardOledDisplay oled(bus);
+    services::UiService ui(oled, repo);
+    ASSERT_TRUE(oled.init());
+    ASSERT_TRUE(ui.init());
+
+    common::UiEvent toast;
+    toast.type = common::UiEvent::Type::SHOW_TOAST;
+    std::snprintf(toast.text.data(), toast.text.size(), "Saved");
+    common::UiEvent volume;
+    volume.type = common::UiEvent::Type::RENDER_VOLUME;
+    common::UiEvent climate;
+    climate.type = common::UiEvent::Type::RENDER_CLIMATE;
+
+    // Every event type, scrolling the list both ways and a toast coming and going
+    const auto session = [&]() {
+        for (int step = 0; step < 40; ++step) {
+            const int selected = (step < 20) ? step : 39 - step;
+            ui.onEvent(stationsEvent(selected));
+            volume.volume = step * 2;
+            ui.onEvent(volume);
+            climate.temperatureCentiC = static_cast<int16_t>(2000 + step * 10);
+            ui.onEvent(climate);
+            ui.onEvent(playbackEvent((step % 10 < 5) ? common::PlaybackState::Playing
+                                                     : common::PlaybackState::Stopped));
+            ui.onEvent(spectrumEvent(static_cast<uint8_t>(step * 6)));
+            toast.postedUs = esp_timer_get_time() - services::UiService::TOAST_DURATION_US;
+            ui.onEvent(toast);
+            ui.tick();
+        }
+    };
+    session();
+
+    // Act
+    AllocationCounter allocations;
+    session();
+    const size_t count = allocations.count();
+    const size_t bytes = allocations.bytes();
+
+    // Expect
+    EXPECT_EQ(0U, count) << bytes << " bytes";
+    EXPECT_EQ(std::vector<uint8_t>(ui.getFramebuffer(), ui.getFramebuffer() + FRAMEBUFFER_SIZE),
+              bus.visibleFrame());
+}
+
+namespace {
+// Display that takes as long as a full frame over a loaded bus
+class SlowDisplay : public adapters::IDisplay {
+   public:
+    explicit SlowDisplay(const std::chrono::microseconds &flushTime) : mFlushTime(flushTime) {}
+
+    bool init() override {
+        return true;
+    }
+
+    void showFramebuffer(const uint8_t *framebuffer, const size_t &len) override {
+        std::this_thread::sleep_for(mFlushTime);
+        lastFrame.assign(framebuffer, framebuffer + len);
+        ++flushes;
+    }
+
+    void showRegions(const uint8_t *framebuffer, const size_t &len,
+                     const adapters::DisplayRegion *, const size_t &) override {
+        showFramebuffer(framebuffer, len);
+    }
+
+    void scrollPages(const int8_t &) override {}
+
+    std::vector<uint8_t> lastFrame;
+    std::atomic<uint32_t> flushes{0U};
+
+   private:
+    std::chrono::microseconds mFlushTime;
+};
+
+// Stands in for FlushTask
+class ThreadFlusher : public services::IFrameListener {
+   public:
+    explicit ThreadFlusher(services::UiService &ui) : mUi(ui), mThread([this] { run(); }) {}
+
+    ~ThreadFlusher() override {
+        mStop.store(true);
+        mThread.join();
+    }
+
+    void onFrameReady() override {
+        mReady.store(true);
+    }
+
+   private:
+    void run() {
+        while (!mStop.load()) {
+            if (!mReady.exchange(false)) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                continue;
+            }
+            while (mUi.flushPendingFrame()) {
+            }
+        }
+        while (mUi.flushPendingFrame()) {
+        }
+    }
+
+    services::UiService &mUi;
+    std::atomic<bool> mStop{false};
+    std::atomic<bool> mReady{false};
+    std::thread mThread;
+};
+
+struct PipelineResult {
+    int64_t renderWallUs;
+    uint32_t flushes;
+    uint32_t maxChangeToFlushUs;
+};
+
+// Volume changes arrive every 2 ms, as from a fast encoder spin, against a 10 ms display
+PipelineResult runVolumeSpin(services::UiService &ui, SlowDisplay &display) {
+    static constexpr int EVENTS = 50;
+    static constexpr int64_t ARRIVAL_PERIOD_US = 2000;
+
+    char command[] = "metrics";
+    char reset[] = "reset";
+    char *argv[] = {command, reset};
+    metrics::Registry::instance().runCommand(2, argv);
+    const auto *latency = metrics::Registry::instance().findHistogram("ui.change_to_flush_us");
+
+    const int64_t startUs = esp_timer_get_time();
+    for (int i = 0; i < EVENTS; ++i) {
+        const int64_t arrivalUs = startUs + i * ARRIVAL_PERIOD_US;
+        std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+            std::chrono::microseconds(std::max(arrivalUs, esp_timer_get_time()))));
+
+        common::UiEvent event;
+        event.type = common::UiEvent::Type::RENDER_VOLUME;
+        event.volume = i;
+        event.postedUs = arrivalUs;
+        ui.onEvent(event);
+    }
+
+    return {esp_timer_get_time() - startUs, display.flushes.load(), latency->snapshot().max};
+}
+}  // namespace
+
+TEST_F(UiServiceTest, pipeline_SlowDisplay_DropsStaleFramesAndBoundsLatency) {
+    // Arrange
+    static constexpr auto FLUSH_TIME = std::chrono::milliseconds(10);
+    SlowDisplay syncDisplay(FLUSH_TIME);
+    SlowDisplay asyncDisplay(FLUSH_TIME);
+    services::UiService syncUi(syncDisplay, *mockRepo);
+    services::UiService asyncUi(asyncDisplay, *mockRepo);
+
+    // Act
+    const PipelineResult sync = runVolumeSpin(syncUi, syncDisplay);
+
+    PipelineResult async{};
+    {
+        ThreadFlusher flusher(asyncUi);
+        asyncUi.setFrameListener(&flusher);
+        async = runVolumeSpin(asyncUi, asyncDisplay);
+    }
+    async.flushes = asyncDisplay.flushes.load();
+
+    printf("[ PIPELINE ] sync : render %lld us, %u flushes, change-to-flush max %u us\n",
+           static_cast<long long>(sync.renderWallUs), sync.flushes, sync.maxChangeToFlushUs);
+    printf("[ PIPELINE ] async: render %lld us, %u flushes, change-to-flush max %u us\n",
+           static_cast<long long>(async.renderWallUs), async.flushes, async.maxChangeToFlushUs);
+
+    // Expect: the renderer keeps pace with input instead of queueing behind the display,
+    // and a change waits for at most the frame on the wire plus its own flush
+    EXPECT_LT(async.renderWallUs, sync.renderWallUs / 2);
+    EXPECT_LT(async.flushes, sync.flushes);
+    EXPECT_LT(async.maxChangeToFlushUs, sync.maxChangeToFlushUs / 4U);
+    EXPECT_EQ(syncDisplay.lastFrame, asyncDisplay.lastFrame);
 }
@@ -0,0 +1,40 @@
+#include "Utf8Test.hpp"
+
+using services::Utf8;
+
+std::vector<uint32_t> Utf8Test::decode(const std::string_view &txt) {
+    std::vector<uint32_t> codepoints;
+    for (size_t pos = 0U; pos < txt.size();) {
+        codepoints.push_back(Utf8::next(txt, pos));
+    }
+    return codepoints;
+}
+
+TEST_F(Utf8Test, next_MixedScripts_DecodesEachWidth) {
+    // Act: ASCII, 2-byte Latin and Cyrillic, 3-byte euro, 4-byte emoji
+    const std::vector<uint32_t> codepoints = decode("Aé Ж€\xF0\x9F\x8E\xB5");
+
+    // Expect
+    EXPECT_EQ((std::vector<uint32_t>{'A', 0xE9U, ' ', 0x416U, 0x20ACU, 0x1F3B5U}), codepoints);
+}
+
+TEST_F(Utf8Test, next_MalformedInput_ReplacesAndResyncs) {
+    // Act: stray continuation, truncated sequence before ASCII, overlong '/', surrogate
+    const std::vector<uint32_t> codepoints = decode("\x80" "a\xC3" "b\xC0\xAF\xED\xA0\x80" "c");
+
+    // Expect: one replacement per bad sequence, the following character survives
+    EXPECT_EQ((std::vector<uint32_t>{Utf8::REPLACEMENT, 'a', Utf8::REPLACEMENT, 'b',
+                                     Utf8::REPLACEMENT, Utf8::REPLACEMENT, 'c'}),
+              codepoints);
+}
+
+TEST_F(Utf8Test, prefix_NeverSplitsASequence) {
+    // Arrange
+    const std::string_view name = "Радио Ёлка";
+
+    // Act & Expect: limits in characters, then in bytes
+    EXPECT_EQ(10U, Utf8::length(name));
+    EXPECT_EQ("Радио", Utf8::prefix(name, 5U));
+    EXPECT_EQ("Ра", Utf8::prefix(name, 5U, 5U));
+    EXPECT_EQ(name, Utf8::prefix(name, 100U));
+}
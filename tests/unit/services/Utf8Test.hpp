@@ -0,0 +1,12 @@
+#pragma once
+
+#include <vector>
+
+#include "Utf8.hpp"
+#include "gtest/gtest.h"
+
+class Utf8Test : public ::testing::Test {
+   protected:
+    // Every code point next() returns for txt
+    static std::vector<uint32_t> decode(const std::string_view &txt);
+};
@@ -0,0 +1,177 @@
+#include "WidgetTreeTest.hpp"
+
+#include <algorithm>
+
+#include "Widget.hpp"
+
+namespace {
+// Fills its bounds with one byte
+class PatternWidget : public services::Widget {
+   public:
+    PatternWidget(const adapters::DisplayRegion &bounds, const uint8_t pattern)
+        : Widget(bounds), mPattern(pattern) {
+        invalidate();
+    }
+
+    void setPattern(const uint8_t pattern) {
+        mPattern = pattern;
+        invalidate();
+    }
+
+    void show(const bool visible) {
+        setVisible(visible);
+    }
+
+    void touch() {
+        invalidate();
+    }
+
+    void draw(services::Canvas &canvas) const override {
+        canvas.fill(getBounds(), mPattern);
+    }
+
+   private:
+    uint8_t mPattern;
+};
+
+// Each page row shows the number of the item on it, like a list moving under a window
+class ScrollingWidget : public services::Widget {
+   public:
+    explicit ScrollingWidget(const adapters::DisplayRegion &bounds) : Widget(bounds) {
+        invalidate();
+    }
+
+    void scrollBy(const int rows) {
+        mTop += rows;
+        mPending += rows;
+        const int visible = getBounds().pageEnd - getBounds().pageStart + 1;
+        const int first = (rows > 0) ? visible - rows : 0;
+        for (int row = first; row < first + std::abs(rows); ++row) {
+            const uint8_t page = static_cast<uint8_t>(getBounds().pageStart + row);
+            invalidate({getBounds().colStart, getBounds().colEnd, page, page});
+        }
+    }
+
+    void touch() {
+        invalidate();
+    }
+
+    int takeScrollRows() override {
+        const int rows = mPending;
+        mPending = 0;
+        return rows;
+    }
+
+    void draw(services::Canvas &canvas) const override {
+        for (uint8_t page = getBounds().pageStart; page <= getBounds().pageEnd; ++page) {
+            const uint8_t item = static_cast<uint8_t>(mTop + page - getBounds().pageStart);
+            canvas.fill({getBounds().colStart, getBounds().colEnd, page, page}, item);
+        }
+    }
+
+   private:
+    int mTop = 0;
+    int mPending = 0;
+};
+
+uint8_t pixelByte(const std::vector<uint8_t> &fb, const uint8_t col, const uint8_t page) {
+    return fb[page * services::Canvas::WIDTH + col];
+}
+}  // namespace
+
+void WidgetTreeTest::SetUp() {
+    framebuffer.assign(services::Canvas::FRAME_SIZE, 0U);
+    canvas.setTarget(framebuffer.data());
+}
+
+void WidgetTreeTest::render() {
+    frame = services::FrameSwap::FrameInfo{};
+    tree.render(canvas, frame);
+}
+
+TEST_F(WidgetTreeTest, render_LowerWidgetChange_KeepsOverlayOnTop) {
+    // Arrange
+    PatternWidget below({0U, 63U, 1U, 3U}, 0x11);
+    PatternWidget overlay({10U, 20U, 2U, 2U}, 0x22);
+    tree.add(below);
+    tree.add(overlay);
+    render();
+
+    // Act
+    below.setPattern(0x33);
+    render();
+
+    // Expect: only the lower widget's rectangle is damaged, the overlay still wins inside it
+    ASSERT_EQ(1U, frame.damage.count());
+    EXPECT_EQ(63U, frame.damage.data()[0].colEnd);
+    EXPECT_EQ(3U, frame.damage.data()[0].pageEnd);
+    EXPECT_EQ(0x33, pixelByte(framebuffer, 0U, 2U));
+    EXPECT_EQ(0x22, pixelByte(framebuffer, 15U, 2U));
+    EXPECT_EQ(0x00, pixelByte(framebuffer, 64U, 2U));
+}
+
+TEST_F(WidgetTreeTest, render_HiddenOverlay_UncoversWidgetBelow) {
+    // Arrange
+    PatternWidget below({0U, 63U, 1U, 3U}, 0x11);
+    PatternWidget overlay({10U, 20U, 2U, 2U}, 0x22);
+    tree.add(below);
+    tree.add(overlay);
+    render();
+
+    // Act
+    overlay.show(false);
+    render();
+
+    // Expect
+    ASSERT_EQ(1U, frame.damage.count());
+    EXPECT_EQ(10U, frame.damage.data()[0].colStart);
+    EXPECT_EQ(20U, frame.damage.data()[0].colEnd);
+    EXPECT_EQ(0x11, pixelByte(framebuffer, 15U, 2U));
+}
+
+TEST_F(WidgetTreeTest, render_ScrollUnderOverlay_MatchesFullRepaint) {
+    // Arrange: a list under the status row with a bar over its bottom row
+    PatternWidget status({0U, 127U, 0U, 0U}, 0x5A);
+    ScrollingWidget list({0U, 127U, 1U, 7U});
+    PatternWidget bar({0U, 127U, 7U, 7U}, 0xFF);
+    tree.add(status);
+    tree.add(list);
+    tree.add(bar);
+    render();
+
+    // Act
+    list.scrollBy(2);
+    render();
+    const std::vector<uint8_t> incremental = framebuffer;
+    const services::FrameSwap::FrameInfo scrolled = frame;
+
+    std::fill(framebuffer.begin(), framebuffer.end(), 0U);
+    status.touch();
+    list.touch();
+    bar.touch();
+    render();
+
+    // Expect: the panel was rotated instead of redrawn, and the result is the same
+    EXPECT_EQ(framebuffer, incremental);
+    EXPECT_EQ(2, scrolled.scrollPages);
+    EXPECT_FALSE(scrolled.damage.coversAll());
+    EXPECT_EQ(0x03, pixelByte(incremental, 0U, 2U));
+}
+
+TEST_F(WidgetTreeTest, render_NarrowScrollingWidget_IsRedrawnInstead) {
+    // Arrange
+    ScrollingWidget list({0U, 63U, 1U, 7U});
+    tree.add(list);
+    render();
+
+    // Act
+    list.scrollBy(1);
+    render();
+
+    // Expect
+    EXPECT_EQ(0, frame.scrollPages);
+    ASSERT_EQ(1U, frame.damage.count());
+    EXPECT_EQ(1U, frame.damage.data()[0].pageStart);
+    EXPECT_EQ(7U, frame.damage.data()[0].pageEnd);
+    EXPECT_EQ(0x01, pixelByte(framebuffer, 0U, 1U));
+}
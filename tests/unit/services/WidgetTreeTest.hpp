@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+
+#include "Canvas.hpp"
+#include "FrameSwap.hpp"
+#include "WidgetTree.hpp"
+#include "gtest/gtest.h"
+
+class WidgetTreeTest : public ::testing::Test {
+   protected:
+    void SetUp() override;
+
+    // Renders into the framebuffer with fresh frame damage
+    void render();
+
+    std::vector<uint8_t> framebuffer;
+    services::Canvas canvas;
+    services::WidgetTree tree;
+    services::FrameSwap::FrameInfo frame;
+};
@@ -0,0 +1,3 @@
+#pragma once
+
+static inline int esp_cpu_get_core_id() { return 0; }
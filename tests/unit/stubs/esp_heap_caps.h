@@ -0,0 +1,103 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+
+#define MALLOC_CAP_EXEC (1 << 0)
+#define MALLOC_CAP_32BIT (1 << 1)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+// Host fake of the capability heap: internal RAM and PSRAM as two budgets on top of malloc.
+// Tests size them with fake_heap::reset() and can pretend the free space is fragmented;
+// until then they look like an S3 module with 2 MB of PSRAM.
+namespace fake_heap {
+static constexpr size_t DEFAULT_INTERNAL = 320 * 1024;
+static constexpr size_t DEFAULT_SPIRAM = 2 * 1024 * 1024;
+
+struct Region {
+  size_t capacity = 0;
+  size_t used = 0;
+  size_t minFree = 0;
+  size_t largestLimit = SIZE_MAX;  // caps the largest free block, as fragmentation would
+  std::map<void *, size_t> blocks;
+
+  size_t freeBytes() const { return capacity - used; }
+};
+
+inline Region makeRegion(const size_t capacity) {
+  Region region;
+  region.capacity = capacity;
+  region.minFree = capacity;
+  return region;
+}
+
+inline Region &internal() {
+  static Region region = makeRegion(DEFAULT_INTERNAL);
+  return region;
+}
+
+inline Region &spiram() {
+  static Region region = makeRegion(DEFAULT_SPIRAM);
+  return region;
+}
+
+inline Region &regionFor(const uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? spiram() : internal();
+}
+
+inline void resetRegion(Region &region, const size_t capacity) {
+  for (auto &block : region.blocks) {
+    std::free(block.first);
+  }
+  region = makeRegion(capacity);
+}
+
+// Leaks nothing that was still allocated; 0 bytes of PSRAM is a board without it
+inline void reset(const size_t internalBytes, const size_t spiramBytes) {
+  resetRegion(internal(), internalBytes);
+  resetRegion(spiram(), spiramBytes);
+}
+}  // namespace fake_heap
+
+static inline void *heap_caps_malloc(size_t size, uint32_t caps) {
+  fake_heap::Region &region = fake_heap::regionFor(caps);
+  if (size == 0 || size > std::min(region.freeBytes(), region.largestLimit)) {
+    return nullptr;
+  }
+  void *ptr = std::malloc(size);
+  region.blocks[ptr] = size;
+  region.used += size;
+  region.minFree = std::min(region.minFree, region.freeBytes());
+  return ptr;
+}
+
+static inline void heap_caps_free(void *ptr) {
+  for (fake_heap::Region *region : {&fake_heap::internal(), &fake_heap::spiram()}) {
+    auto block = region->blocks.find(ptr);
+    if (block != region->blocks.end()) {
+      region->used -= block->second;
+      region->blocks.erase(block);
+      std::free(ptr);
+      return;
+    }
+  }
+}
+
+static inline size_t heap_caps_get_free_size(uint32_t caps) {
+  return fake_heap::regionFor(caps).freeBytes();
+}
+
+static inline size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+  return fake_heap::regionFor(caps).minFree;
+}
+
+static inline size_t heap_caps_get_largest_free_block(uint32_t caps) {
+  const fake_heap::Region &region = fake_heap::regionFor(caps);
+  return std::min(region.freeBytes(), region.largestLimit);
+}
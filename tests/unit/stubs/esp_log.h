@@ -7,3 +7,5 @@
   printf("[E][%s] " format "\n", tag, ##__VA_ARGS__)
 #define ESP_LOGW(tag, format, ...)                                             \
   printf("[W][%s] " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...)                                             \
+  printf("[D][%s] " format "\n", tag, ##__VA_ARGS__)
@@ -0,0 +1,6 @@
+#pragma once
+#include "esp_heap_caps.h"
+
+static inline bool esp_ptr_external_ram(const void *p) {
+  return fake_heap::spiram().blocks.count(const_cast<void *>(p)) > 0;
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+static inline int64_t esp_timer_get_time() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+
+// Host stand-in for the kernel types and macros. Nothing here blocks or schedules: tasks are
+// never started and a wait on an empty queue returns at once, so tests drive the loops
+// themselves one iteration at a time.
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS ((TickType_t)1)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms) / portTICK_PERIOD_MS)
+
+// Host code never runs in an interrupt
+inline BaseType_t xPortInIsrContext() { return pdFALSE; }
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "FreeRTOS.h"
+
+// Fixed ring of copied items, allocated once by xQueueCreate like the real queue storage
+struct QueueDefinition {
+  UBaseType_t length;
+  UBaseType_t itemSize;
+  UBaseType_t head;
+  UBaseType_t waiting;
+  uint8_t storage[1];
+};
+typedef QueueDefinition *QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(const UBaseType_t length,
+                                  const UBaseType_t itemSize) {
+  auto *queue = static_cast<QueueHandle_t>(
+      std::calloc(1, sizeof(QueueDefinition) + length * itemSize));
+  if (queue != nullptr) {
+    queue->length = length;
+    queue->itemSize = itemSize;
+  }
+  return queue;
+}
+
+inline void vQueueDelete(QueueHandle_t queue) { std::free(queue); }
+
+inline BaseType_t xQueueSend(QueueHandle_t queue, const void *item,
+                             TickType_t) {
+  if (queue->waiting == queue->length) {
+    return pdFALSE;
+  }
+  const UBaseType_t tail = (queue->head + queue->waiting) % queue->length;
+  std::memcpy(queue->storage + tail * queue->itemSize, item, queue->itemSize);
+  ++queue->waiting;
+  return pdTRUE;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t) {
+  if (queue->waiting == 0) {
+    return pdFALSE;
+  }
+  std::memcpy(item, queue->storage + queue->head * queue->itemSize,
+              queue->itemSize);
+  queue->head = (queue->head + 1) % queue->length;
+  --queue->waiting;
+  return pdTRUE;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+  return queue->waiting;
+}
@@ -0,0 +1,114 @@
+#include "AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+struct ThreadAllocations {
+    size_t scopes = 0U;
+    size_t count = 0U;
+    size_t bytes = 0U;
+};
+
+// Trivially constructible, so using it from operator new cannot recurse into it
+thread_local ThreadAllocations tAllocations;
+
+void *allocate(const std::size_t size) {
+    if (tAllocations.scopes > 0U) {
+        ++tAllocations.count;
+        tAllocations.bytes += size;
+    }
+    return std::malloc(size == 0U ? 1U : size);
+}
+
+void *allocate(const std::size_t size, const std::align_val_t align) {
+    if (tAllocations.scopes > 0U) {
+        ++tAllocations.count;
+        tAllocations.bytes += size;
+    }
+    const auto alignment = static_cast<std::size_t>(align);
+    const std::size_t rounded = ((size == 0U ? 1U : size) + alignment - 1U) / alignment * alignment;
+    return std::aligned_alloc(alignment, rounded);
+}
+}  // namespace
+
+AllocationCounter::AllocationCounter()
+    : mStartCount(tAllocations.count), mStartBytes(tAllocations.bytes) {
+    ++tAllocations.scopes;
+}
+
+AllocationCounter::~AllocationCounter() {
+    --tAllocations.scopes;
+}
+
+size_t AllocationCounter::count() const {
+    return tAllocations.count - mStartCount;
+}
+
+size_t AllocationCounter::bytes() const {
+    return tAllocations.bytes - mStartBytes;
+}
+
+void *operator new(std::size_t size) {
+    void *p = allocate(size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+    void *p = allocate(size, align);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](std::size_t size, std::align_val_t align) {
+    return operator new(size, align);
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+// Counts the heap allocations the current thread makes while an instance is alive. The
+// global operator new and delete are replaced in AllocationCounter.cpp, so the count is only
+// real in test binaries that link it; other threads are never counted, which keeps gtest's
+// and stand-in servers' bookkeeping out of the numbers.
+//
+//     AllocationCounter allocations;
+//     ui.onEvent(event);
+//     EXPECT_EQ(0U, allocations.count());
+class AllocationCounter {
+   public:
+    AllocationCounter();
+    ~AllocationCounter();
+
+    AllocationCounter(const AllocationCounter &) = delete;
+    AllocationCounter &operator=(const AllocationCounter &) = delete;
+
+    // Since construction, including those of nested counters
+    size_t count() const;
+    size_t bytes() const;
+
+   private:
+    size_t mStartCount;
+    size_t mStartBytes;
+};
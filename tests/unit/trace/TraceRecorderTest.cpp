@@ -0,0 +1,159 @@
+#include "TraceRecorderTest.hpp"
+
+#include <cstdio>
+#include <thread>
+
+using trace::EventId;
+using trace::Phase;
+
+static constexpr size_t PRODUCERS = 4U;
+static constexpr uint32_t RECORDS_PER_PRODUCER = 2048U;
+
+void TraceRecorderTest::SetUp() {
+    recorder.clear();
+    recorder.setEnabled(true);
+}
+
+void TraceRecorderTest::TearDown() {
+    recorder.clear();
+}
+
+std::vector<std::string> TraceRecorderTest::dumpLines() {
+    FILE* out = std::tmpfile();
+    recorder.dump(out);
+    std::rewind(out);
+
+    std::vector<std::string> lines;
+    char line[128];
+    while (std::fgets(line, sizeof(line), out) != nullptr) {
+        std::string text(line);
+        text.pop_back();  // '\n'
+        lines.push_back(text);
+    }
+    std::fclose(out);
+
+    return lines;
+}
+
+TEST_F(TraceRecorderTest, scope_RecordsBeginAndEnd) {
+    // Act
+    {
+        TRACE_SCOPE_ARG(OLED_SHOW_FRAMEBUFFER, 1024);
+        TRACE_INSTANT(UI_TASK_POST, 7);
+    }
+
+    // Expect
+    const auto& ring = recorder.getRing(0);
+    ASSERT_EQ(3U, ring.written());
+
+    EXPECT_EQ(static_cast<uint16_t>(EventId::OLED_SHOW_FRAMEBUFFER), ring.at(0).id);
+    EXPECT_EQ(static_cast<uint8_t>(Phase::Begin), ring.at(0).phase);
+    EXPECT_EQ(1024U, ring.at(0).arg);
+
+    EXPECT_EQ(static_cast<uint16_t>(EventId::UI_TASK_POST), ring.at(1).id);
+    EXPECT_EQ(static_cast<uint8_t>(Phase::Instant), ring.at(1).phase);
+    EXPECT_EQ(7U, ring.at(1).arg);
+
+    EXPECT_EQ(static_cast<uint16_t>(EventId::OLED_SHOW_FRAMEBUFFER), ring.at(2).id);
+    EXPECT_EQ(static_cast<uint8_t>(Phase::End), ring.at(2).phase);
+    EXPECT_LE(ring.at(0).timestampUs, ring.at(2).timestampUs);
+}
+
+TEST_F(TraceRecorderTest, record_Disabled_RecordsNothing) {
+    // Arrange
+    recorder.setEnabled(false);
+
+    // Act
+    TRACE_BEGIN(I2C_WRITE);
+    TRACE_END(I2C_WRITE);
+
+    // Expect
+    EXPECT_EQ(0U, recorder.getRing(0).written());
+}
+
+TEST_F(TraceRecorderTest, ring_Overflow_KeepsNewestRecords) {
+    // Arrange
+    trace::TraceRing<8> ring;
+
+    // Act
+    for (uint32_t i = 0U; i < 20U; ++i) {
+        ring.push({i, i, 0U, 'i', 0U});
+    }
+
+    // Expect
+    ASSERT_EQ(20U, ring.written());
+    for (uint32_t seq = 12U; seq < 20U; ++seq) {
+        EXPECT_EQ(seq, ring.at(seq).arg);
+    }
+}
+
+TEST_F(TraceRecorderTest, ring_ConcurrentProducers_LoseNothing) {
+    // Arrange
+    trace::TraceRing<PRODUCERS * RECORDS_PER_PRODUCER> ring;
+    std::vector<std::thread> producers;
+
+    // Act
+    for (size_t p = 0U; p < PRODUCERS; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (uint32_t i = 0U; i < RECORDS_PER_PRODUCER; ++i) {
+                ring.push({i, i, static_cast<uint16_t>(p), 'i', 0U});
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    // Expect
+    ASSERT_EQ(PRODUCERS * RECORDS_PER_PRODUCER, ring.written());
+    std::vector<uint32_t> perProducer(PRODUCERS, 0U);
+    for (uint32_t seq = 0U; seq < ring.written(); ++seq) {
+        ++perProducer[ring.at(seq).id];
+    }
+    for (const uint32_t count : perProducer) {
+        EXPECT_EQ(RECORDS_PER_PRODUCER, count);
+    }
+}
+
+TEST_F(TraceRecorderTest, dump_WritesHeaderEventTableAndRecords) {
+    // Arrange
+    TRACE_BEGIN(UI_RENDER_STATIONS);
+    TRACE_END(UI_RENDER_STATIONS);
+
+    // Act
+    const auto lines = dumpLines();
+
+    // Expect: the recording thread is the only task
+    const size_t eventCount = static_cast<size_t>(EventId::COUNT);
+    ASSERT_EQ(1U + eventCount + 1U + 2U + 1U, lines.size());
+    EXPECT_EQ("#TRACE v2 cores=2", lines.front());
+    EXPECT_EQ("#EVENT 0 ui_task.post", lines[1]);
+    EXPECT_EQ("#TASK 1 host", lines[1U + eventCount]);
+    EXPECT_EQ(0U, lines[2U + eventCount].rfind("T,0,", 0));
+    EXPECT_NE(std::string::npos, lines[2U + eventCount].find(",B,4,0,1"));
+    EXPECT_NE(std::string::npos, lines[3U + eventCount].find(",E,4,0,1"));
+    EXPECT_EQ("#TRACE END", lines.back());
+    EXPECT_TRUE(recorder.isEnabled());
+}
+
+TEST_F(TraceRecorderTest, record_TasksOnOneCore_KeepTheirOwnIndex) {
+    // Act: the host runs everything on "core 0", like tasks preempting each other
+    TRACE_BEGIN(UI_RENDER_STATIONS);
+    std::thread other([] {
+        TRACE_INSTANT(UI_TASK_POST, 1);
+        TRACE_INSTANT(UI_TASK_POST, 2);
+    });
+    other.join();
+    TRACE_END(UI_RENDER_STATIONS);
+
+    // Expect: the scope's begin and end share a task, the preempting one has its own
+    const auto& ring = recorder.getRing(0);
+    ASSERT_EQ(4U, ring.written());
+    const uint8_t otherTask = ring.at(1).task;
+    EXPECT_NE(trace::TraceRecorder::NO_TASK, ring.at(0).task);
+    EXPECT_EQ(ring.at(0).task, ring.at(3).task);
+    EXPECT_NE(ring.at(0).task, otherTask);
+    EXPECT_EQ(otherTask, ring.at(2).task);
+    EXPECT_STREQ("host", recorder.getTaskName(otherTask));
+    EXPECT_STREQ("", recorder.getTaskName(trace::TraceRecorder::NO_TASK));
+}
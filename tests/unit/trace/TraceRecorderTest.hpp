@@ -0,0 +1,18 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "Trace.hpp"
+
+class TraceRecorderTest : public ::testing::Test {
+   protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    std::vector<std::string> dumpLines();
+
+    trace::TraceRecorder& recorder = trace::TraceRecorder::instance();
+};
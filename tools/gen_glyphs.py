@@ -0,0 +1,319 @@
+#!/usr/bin/env python3
+"""Generate the sparse 5x7 glyph table for code points above ASCII.
+
+Usage:
+    tools/gen_glyphs.py -o build/generated/GlyphTable.hpp
+    tools/gen_glyphs.py --preview             # print every glyph as ASCII art
+
+The ASCII glyphs come from FONT5x7 in components/common/include/UiTypes.hpp, so accented
+letters follow the base font. Letters with a canonical decomposition (Latin-1, Latin
+Extended-A, Cyrillic Ё/Й/Ї/Ў) are composed from the base glyph and a mark; the rest are
+drawn below. The output is two sorted arrays the renderer binary-searches, no heap and
+7 bytes of flash per glyph.
+"""
+
+import argparse
+import os
+import re
+import sys
+import unicodedata
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+FONT_HEADER = os.path.join(ROOT, "components", "common", "include", "UiTypes.hpp")
+
+GLYPH_RE = re.compile(r"\{\{\s*" + r",\s*".join([r"(0x[0-9A-Fa-f]{2})"] * 5) + r"\s*\}\}")
+
+# Marks are drawn on rows 0-1 above a 5-row body (rows 2-6), or on row 7 below the baseline
+TOP_MARKS = {
+    0x0300: [".#...", "..#.."],  # grave
+    0x0301: ["...#.", "..#.."],  # acute
+    0x0302: ["..#..", ".#.#."],  # circumflex
+    0x0303: [".##.#", "#..#."],  # tilde
+    0x0304: [".###.", "....."],  # macron
+    0x0306: ["#...#", ".###."],  # breve
+    0x0307: ["..#..", "....."],  # dot above
+    0x0308: [".#.#.", "....."],  # diaeresis
+    0x030A: ["..#..", ".#.#."],  # ring above, closed by the body
+    0x030B: ["..#.#", ".#.#."],  # double acute
+    0x030C: [".#.#.", "..#.."],  # caron
+}
+BOTTOM_MARKS = {
+    0x0326: "..#..",  # comma below
+    0x0327: "..##.",  # cedilla
+    0x0328: "...##",  # ogonek
+}
+
+# Glyphs without a usable decomposition, 7 rows of 5 columns
+DRAWN = {
+    0x00A1: ["..#..", ".....", "..#..", "..#..", "..#..", "..#..", "..#.."],  # ¡
+    0x00A3: ["..##.", ".#...", ".#...", "###..", ".#...", ".#..#", "####."],  # £
+    0x00A7: [".###.", "#....", ".##..", "#..#.", ".##..", "...#.", "###.."],  # §
+    0x00A9: [".###.", "#...#", "#.###", "#.#.#", "#.###", "#...#", ".###."],  # ©
+    0x00AB: [".....", "..#.#", ".#.#.", "#.#..", ".#.#.", "..#.#", "....."],  # «
+    0x00AE: [".###.", "#...#", "###.#", "##.##", "###.#", "##.##", ".###."],  # ®
+    0x00B0: [".##..", "#..#.", ".##..", ".....", ".....", ".....", "....."],  # °
+    0x00B7: [".....", ".....", ".....", "..#..", ".....", ".....", "....."],  # ·
+    0x00BB: [".....", "#.#..", ".#.#.", "..#.#", ".#.#.", "#.#..", "....."],  # »
+    0x00BF: ["..#..", ".....", "..#..", "..#..", ".#...", "#...#", ".###."],  # ¿
+    0x00C6: [".####", "#.#..", "#.#..", "#####", "#.#..", "#.#..", "#.###"],  # Æ
+    0x00D0: ["###..", "#..#.", "#...#", "###.#", "#...#", "#..#.", "###.."],  # Ð
+    0x00D7: [".....", "#...#", ".#.#.", "..#..", ".#.#.", "#...#", "....."],  # ×
+    0x00D8: [".###.", "#..##", "#.#.#", "#.#.#", "#.#.#", "##..#", ".###."],  # Ø
+    0x00DE: ["#....", "####.", "#...#", "#...#", "####.", "#....", "#...."],  # Þ
+    0x00DF: [".##..", "#..#.", "#..#.", "###..", "#..#.", "#..#.", "#.##."],  # ß
+    0x00E6: [".....", ".....", "##.#.", "..#.#", ".####", "#.#..", ".#.##"],  # æ
+    0x00F0: [".#.#.", "..#..", ".#.#.", "....#", ".####", "#...#", ".###."],  # ð
+    0x00F7: [".....", "..#..", ".....", "#####", ".....", "..#..", "....."],  # ÷
+    0x00F8: [".....", ".....", ".###.", "#..##", "#.#.#", "##..#", ".###."],  # ø
+    0x00FE: [".....", "#....", "####.", "#...#", "####.", "#....", "#...."],  # þ
+    0x0110: ["###..", "#..#.", "#...#", "###.#", "#...#", "#..#.", "###.."],  # Đ
+    0x0111: ["...#.", "..###", ".##.#", "#..##", "#...#", "#...#", ".####"],  # đ
+    0x0131: [".....", ".....", ".##..", "..#..", "..#..", "..#..", ".###."],  # ı
+    0x0141: ["#....", "#....", "#.#..", "##...", "#....", "#....", "#####"],  # Ł
+    0x0142: [".##..", "..#..", "..##.", ".##..", "..#..", "..#..", ".###."],  # ł
+    0x0152: [".####", "#.#..", "#.#..", "#.###", "#.#..", "#.#..", ".####"],  # Œ
+    0x0153: [".....", ".....", ".#.#.", "#.#.#", "#.###", "#.#..", ".#.##"],  # œ
+    0x0237: [".....", ".....", "..##.", "...#.", "...#.", "#..#.", ".##.."],  # ȷ
+    # Cyrillic capitals that do not look like a Latin one
+    0x0404: [".###.", "#...#", "#....", "###..", "#....", "#...#", ".###."],  # Є
+    0x0411: ["#####", "#....", "#....", "####.", "#...#", "#...#", "####."],  # Б
+    0x0413: ["#####", "#....", "#....", "#....", "#....", "#....", "#...."],  # Г
+    0x0414: [".###.", ".#.#.", ".#.#.", ".#.#.", ".#.#.", "#####", "#...#"],  # Д
+    0x0416: ["#.#.#", "#.#.#", ".###.", "..#..", ".###.", "#.#.#", "#.#.#"],  # Ж
+    0x0417: [".###.", "#...#", "....#", "..##.", "....#", "#...#", ".###."],  # З
+    0x0418: ["#...#", "#...#", "#..##", "#.#.#", "##..#", "#...#", "#...#"],  # И
+    0x041B: [".####", ".#..#", ".#..#", ".#..#", ".#..#", ".#..#", "##..#"],  # Л
+    0x041F: ["#####", "#...#", "#...#", "#...#", "#...#", "#...#", "#...#"],  # П
+    0x0423: ["#...#", "#...#", "#...#", ".####", "....#", "#...#", ".###."],  # У
+    0x0424: ["..#..", ".###.", "#.#.#", "#.#.#", "#.#.#", ".###.", "..#.."],  # Ф
+    0x0426: ["#..#.", "#..#.", "#..#.", "#..#.", "#..#.", "#####", "....#"],  # Ц
+    0x0427: ["#...#", "#...#", "#...#", ".####", "....#", "....#", "....#"],  # Ч
+    0x0428: ["#.#.#", "#.#.#", "#.#.#", "#.#.#", "#.#.#", "#.#.#", "#####"],  # Ш
+    0x0429: ["#.#.#", "#.#.#", "#.#.#", "#.#.#", "#.#.#", "#####", "....#"],  # Щ
+    0x042A: ["##...", ".#...", ".#...", ".###.", ".#..#", ".#..#", ".###."],  # Ъ
+    0x042B: ["#...#", "#...#", "#...#", "##..#", "#.#.#", "#.#.#", "##..#"],  # Ы
+    0x042C: ["#....", "#....", "#....", "####.", "#...#", "#...#", "####."],  # Ь
+    0x042D: [".###.", "#...#", "....#", "..###", "....#", "#...#", ".###."],  # Э
+    0x042E: ["#..#.", "#.#.#", "#.#.#", "###.#", "#.#.#", "#.#.#", "#..#."],  # Ю
+    0x042F: [".####", "#...#", "#...#", ".####", "..#.#", ".#..#", "#...#"],  # Я
+    0x0490: ["....#", "#####", "#....", "#....", "#....", "#....", "#...."],  # Ґ
+    # Cyrillic small letters that are not a small Cyrillic capital
+    0x0431: ["...##", ".##..", "#....", "####.", "#...#", "#...#", ".###."],  # б
+    0x0432: [".....", ".....", "####.", "#...#", "####.", "#...#", "####."],  # в
+    0x0434: [".....", ".....", ".###.", ".#.#.", ".#.#.", "#####", "#...#"],  # д
+    0x0437: [".....", ".....", "####.", "....#", "..##.", "....#", "####."],  # з
+    0x0438: [".....", ".....", "#...#", "#..##", "#.#.#", "##..#", "#...#"],  # и
+    0x043B: [".....", ".....", ".####", ".#..#", ".#..#", ".#..#", "##..#"],  # л
+    0x0443: [".....", ".....", "#...#", "#...#", ".####", "....#", ".###."],  # у
+    0x0444: [".....", "..#..", ".###.", "#.#.#", "#.#.#", ".###.", "..#.."],  # ф
+    0x0446: [".....", ".....", "#..#.", "#..#.", "#..#.", "#####", "....#"],  # ц
+    0x0449: [".....", ".....", "#.#.#", "#.#.#", "#.#.#", "#####", "....#"],  # щ
+    0x044A: [".....", ".....", "##...", ".#...", ".###.", ".#..#", ".###."],  # ъ
+    0x044C: [".....", ".....", "#....", "#....", "####.", "#...#", "####."],  # ь
+    0x044F: [".....", ".....", ".####", "#...#", ".####", ".#..#", "#...#"],  # я
+    0x0454: [".....", ".....", ".###.", "#....", "###..", "#....", ".###."],  # є
+    0x0491: [".....", "....#", "#####", "#....", "#....", "#....", "#...."],  # ґ
+    # Punctuation common in station names
+    0x2013: [".....", ".....", ".....", "#####", ".....", ".....", "....."],  # –
+    0x2014: [".....", ".....", ".....", "#####", ".....", ".....", "....."],  # —
+    0x2018: ["..#..", ".#...", ".##..", ".....", ".....", ".....", "....."],  # ‘
+    0x2019: ["..##.", "...#.", "..#..", ".....", ".....", ".....", "....."],  # ’
+    0x201C: [".#.#.", "#.#..", "##.##", ".....", ".....", ".....", "....."],  # “
+    0x201D: ["##.##", ".#..#", "#..#.", ".....", ".....", ".....", "....."],  # ”
+    0x2026: [".....", ".....", ".....", ".....", ".....", ".....", "#.#.#"],  # …
+    0x20AC: ["..###", ".#...", "####.", ".#...", "####.", ".#...", "..###"],  # €
+}
+
+# Same shape as another glyph
+ALIASES = {
+    0x00A0: ord(" "),
+    # Cyrillic letters sharing a Latin shape
+    0x0405: ord("S"), 0x0406: ord("I"), 0x0408: ord("J"),
+    0x0410: ord("A"), 0x0412: ord("B"), 0x0415: ord("E"), 0x041A: ord("K"),
+    0x041C: ord("M"), 0x041D: ord("H"), 0x041E: ord("O"), 0x0420: ord("P"),
+    0x0421: ord("C"), 0x0422: ord("T"), 0x0425: ord("X"),
+    0x0430: ord("a"), 0x0435: ord("e"), 0x043E: ord("o"), 0x0440: ord("p"),
+    0x0441: ord("c"), 0x0445: ord("x"), 0x0455: ord("s"), 0x0456: ord("i"),
+    0x0458: ord("j"),
+}
+
+# Small Cyrillic letters drawn as their capital squeezed to x-height
+SMALL_CAPS = {cp: cp - 0x20 for cp in range(0x0430, 0x0450)}
+
+# Code points to generate
+RANGES = [
+    (0x00A0, 0x00FF),  # Latin-1 Supplement
+    (0x0100, 0x017F),  # Latin Extended-A
+    (0x0218, 0x021B),  # Romanian comma-below letters
+    (0x0400, 0x045F),  # Cyrillic
+    (0x0490, 0x0491),  # Ґ ґ
+]
+EXTRA = [0x0131, 0x0237, 0x2013, 0x2014, 0x2018, 0x2019, 0x201C, 0x201D, 0x2026, 0x20AC]
+
+
+def load_ascii_font(path):
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    body = text[text.index("FONT5x7"):]
+    glyphs = [[int(b, 16) for b in m.groups()] for m in GLYPH_RE.finditer(body)][:128]
+    if len(glyphs) != 128:
+        sys.exit(f"expected 128 glyphs in {path}, found {len(glyphs)}")
+    return [to_rows(columns) for columns in glyphs]
+
+
+def to_rows(columns):
+    return [[(columns[x] >> y) & 1 for x in range(5)] for y in range(8)]
+
+
+def from_art(art):
+    rows = [[1 if ch == "#" else 0 for ch in line] for line in art]
+    return rows + [[0] * 5] * (8 - len(rows))
+
+
+def to_columns(rows):
+    return [sum(rows[y][x] << y for y in range(8)) for x in range(5)]
+
+
+def squeeze(rows, height):
+    """Drop repeated rows, then merge the closest neighbours, until the body fits."""
+    body = [row[:] for row in rows[:7]]
+    while len(body) > height:
+        repeats = [i for i in range(1, len(body)) if body[i] == body[i - 1]]
+        if repeats:
+            # Prefer the middle of the glyph so the outline stays intact
+            i = min(repeats, key=lambda i: abs(i - len(body) / 2))
+            del body[i]
+            continue
+        i = min(range(1, len(body) - 1),
+                key=lambda i: sum(a != b for a, b in zip(body[i], body[i + 1])))
+        body[i] = [a | b for a, b in zip(body[i], body[i + 1])]
+        del body[i + 1]
+    return body
+
+
+def is_lower(rows):
+    return not any(rows[0]) and not any(rows[1])
+
+
+def compose(base, mark):
+    if mark in BOTTOM_MARKS:
+        rows = [row[:] for row in base]
+        rows[7] = [1 if ch == "#" else 0 for ch in BOTTOM_MARKS[mark]]
+        return rows
+    if mark not in TOP_MARKS:
+        return None
+    body = base[2:7] if is_lower(base) else squeeze(base, 5)
+    top = [[1 if ch == "#" else 0 for ch in line] for line in TOP_MARKS[mark]]
+    return top + [row[:] for row in body] + [base[7][:]]
+
+
+def build_glyph(cp, ascii_font, cache):
+    if cp in cache:
+        return cache[cp]
+
+    glyph = None
+    if cp < 128:
+        glyph = ascii_font[cp]
+    elif cp in DRAWN:
+        glyph = from_art(DRAWN[cp])
+    elif ALIASES.get(cp) is not None:
+        glyph = build_glyph(ALIASES[cp], ascii_font, cache)
+    else:
+        decomposition = unicodedata.decomposition(chr(cp))
+        parts = decomposition.split()
+        if parts and not parts[0].startswith("<") and len(parts) == 2:
+            base_cp, mark = int(parts[0], 16), int(parts[1], 16)
+            # Dotless forms take the accent where the dot was
+            base_cp = {ord("i"): 0x0131, ord("j"): 0x0237}.get(base_cp, base_cp)
+            base = build_glyph(base_cp, ascii_font, cache)
+            if base is not None:
+                glyph = compose(base, mark)
+        elif cp in SMALL_CAPS:
+            capital = build_glyph(SMALL_CAPS[cp], ascii_font, cache)
+            if capital is not None:
+                glyph = [[0] * 5, [0] * 5] + squeeze(capital, 5) + [[0] * 5]
+
+    cache[cp] = glyph
+    return glyph
+
+
+def build_table():
+    ascii_font = load_ascii_font(FONT_HEADER)
+    cache = {}
+    codepoints = sorted({cp for lo, hi in RANGES for cp in range(lo, hi + 1)} | set(EXTRA))
+    table = []
+    for cp in codepoints:
+        glyph = build_glyph(cp, ascii_font, cache)
+        if glyph is not None:
+            table.append((cp, to_columns(glyph)))
+    return table
+
+
+def render_header(table):
+    lines = [
+        "#pragma once",
+        "",
+        "// Generated by tools/gen_glyphs.py from FONT5x7 in UiTypes.hpp, do not edit.",
+        "",
+        "#include <array>",
+        "#include <cstddef>",
+        "#include <cstdint>",
+        "",
+        "namespace common {",
+        f"static constexpr size_t EXTENDED_GLYPH_COUNT = {len(table)}U;",
+        "",
+        "// Code points above ASCII that have a glyph, ascending for binary search",
+        "static constexpr std::array<uint16_t, EXTENDED_GLYPH_COUNT> EXTENDED_CODEPOINTS = {{",
+    ]
+    for i in range(0, len(table), 8):
+        lines.append("    " + ", ".join(f"0x{cp:04X}" for cp, _ in table[i:i + 8]) + ",")
+    lines += [
+        "}};",
+        "",
+        "// 5x7 columns, same layout as FONT5x7, in EXTENDED_CODEPOINTS order",
+        "static constexpr std::array<std::array<uint8_t, 5>, EXTENDED_GLYPH_COUNT> "
+        "EXTENDED_GLYPHS = {{",
+    ]
+    for cp, columns in table:
+        name = chr(cp) if cp != 0x00A0 else "NBSP"
+        body = ", ".join(f"0x{c:02X}" for c in columns)
+        lines.append(f"    {{{{{body}}}}},  // {name} U+{cp:04X}")
+    lines += ["}};", "", "}  // namespace common", ""]
+    return "\n".join(lines)
+
+
+def preview(table):
+    for cp, columns in table:
+        rows = to_rows(columns)
+        print(f"U+{cp:04X} {chr(cp)}")
+        for row in rows:
+            print("    " + "".join("#" if bit else "." for bit in row))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-o", "--output", help="header to write")
+    parser.add_argument("--preview", action="store_true", help="print glyphs as ASCII art")
+    args = parser.parse_args()
+
+    table = build_table()
+    if args.preview:
+        preview(table)
+        return 0
+    if not args.output:
+        parser.error("--output or --preview is required")
+
+    text = render_header(table)
+    # Leave the file alone when nothing changed so dependents do not rebuild
+    if os.path.exists(args.output):
+        with open(args.output, encoding="utf-8") as f:
+            if f.read() == text:
+                return 0
+    os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Convert a `trace dump` capture from the serial console to Chrome trace_event JSON.
+
+Usage:
+    idf.py monitor | tee monitor.log      # then type `trace dump` in the console
+    tools/trace_to_chrome.py monitor.log -o trace.json
+
+Open the result in chrome://tracing or https://ui.perfetto.dev.
+Lines that are not part of a dump (regular logs) are ignored. When the log holds
+several dumps the last one is converted.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+ANSI_RE = re.compile(r"\x1b\[[0-9;]*m")
+WRAP_US = 1 << 32
+CORE_TID_BASE = 1000  # above any task index
+
+
+def parse_dump(lines):
+    dumps = []
+    events = {}
+    tasks = {}
+    records = None
+
+    for raw in lines:
+        line = ANSI_RE.sub("", raw).strip()
+        if line.startswith("#TRACE v"):
+            events = {}
+            tasks = {}
+            records = []
+        elif records is None:
+            continue
+        elif line.startswith("#EVENT "):
+            _, event_id, name = line.split(" ", 2)
+            events[int(event_id)] = name
+        elif line.startswith("#TASK "):
+            _, task, name = line.split(" ", 2)
+            tasks[int(task)] = name
+        elif line.startswith("T,"):
+            fields = line.split(",")
+            # v1 dumps have no task column, their core is the best thread there is
+            core, ts, phase, event_id, arg = fields[1:6]
+            task = int(fields[6]) if len(fields) > 6 else None
+            records.append((int(core), task, int(ts), phase, int(event_id), int(arg)))
+        elif line == "#TRACE END":
+            dumps.append((events, tasks, records))
+            records = None
+
+    if not dumps:
+        raise ValueError("no complete '#TRACE ... #TRACE END' block found")
+    return dumps[-1]
+
+
+def unwrap(records):
+    """Timestamps are 32-bit microseconds, rings are written roughly in order per core.
+
+    A record's timestamp is taken before its slot is reserved, so a preempting task or an
+    ISR lands slightly out of order; only a drop of more than half the range is a wrap, and
+    a jump forward by as much is a straggler from before the last wrap.
+    """
+    out = []
+    last = {}
+    offset = {}
+    for core, task, ts, phase, event_id, arg in records:
+        base = offset.get(core, 0)
+        if core in last:
+            if last[core] - ts > WRAP_US // 2:
+                base += WRAP_US
+                offset[core] = base
+            elif ts - last[core] > WRAP_US // 2:
+                out.append((core, task, ts + base - WRAP_US, phase, event_id, arg))
+                continue
+        last[core] = ts
+        out.append((core, task, ts + base, phase, event_id, arg))
+    return out
+
+
+def thread_of(core, task):
+    """Chrome nests B/E per tid, which only holds per task: tasks preempt each other and
+    move between cores. ISRs (task 0) and v1 dumps fall back to one thread per core."""
+    return task if task else CORE_TID_BASE + core
+
+
+def to_chrome(events, tasks, records):
+    trace_events = []
+    threads = {}
+    for core, task, ts, phase, event_id, arg in unwrap(records):
+        tid = thread_of(core, task)
+        if tid not in threads:
+            threads[tid] = tasks.get(task, "task %d" % task) if task else ("core %d" % core if task is None else "core %d ISRs" % core)
+        event = {
+            "name": events.get(event_id, "event_%d" % event_id),
+            "ph": phase,
+            "ts": ts,
+            "pid": 0,
+            "tid": tid,
+        }
+        if phase == "i":
+            event["s"] = "t"
+        if arg:
+            event["args"] = {"arg": arg}
+        trace_events.append(event)
+
+    trace_events.sort(key=lambda e: e["ts"])
+    for tid in sorted(threads):
+        trace_events.append(
+            {"name": "thread_name", "ph": "M", "pid": 0, "tid": tid, "args": {"name": threads[tid]}}
+        )
+    return {"traceEvents": trace_events, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("log", nargs="?", help="captured console output (default: stdin)")
+    parser.add_argument("-o", "--output", help="output JSON file (default: stdout)")
+    args = parser.parse_args()
+
+    if args.log:
+        with open(args.log, encoding="utf-8", errors="replace") as f:
+            events, tasks, records = parse_dump(f)
+    else:
+        events, tasks, records = parse_dump(sys.stdin)
+
+    result = json.dumps(to_chrome(events, tasks, records), indent=1)
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            f.write(result)
+    else:
+        print(result)
+
+
+if __name__ == "__main__":
+    main()